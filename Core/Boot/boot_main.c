@@ -0,0 +1,118 @@
+/**
+ * @file    boot_main.c
+ * @brief   串口升级引导程序入口（stm32Boot 目标，STM32F103XX_BOOT.ld）
+ * @date    2026-10-18
+ *
+ * @note    - 只初始化升级需要的部分：时钟、W25Q32 片选与 SPI1、USART1 引脚、
+ *            DMA 管理器；USART1 的波特率和 RX DMA 由 boot_init 设置；
+ *          - 不开外设中断，只有 SysTick 给 HAL_GetTick 计时；
+ *          - 时钟配置与应用的 SystemClock_Config 相同，应用重新配置时
+ *            HAL 接受正在运行的 PLL；
+ *          - 复位后等待 BOOT_WAIT_MS 内开始的会话，然后跳转应用；应用
+ *            无效时留在引导程序里反复等待升级。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "boot.h"
+#include "dma_manager.h"
+#include "gpio.h"
+#include "main.h"
+#include "spi.h"
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** 复位后等待上位机发起会话的时间 */
+#define BOOT_WAIT_MS 500U
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void boot_clock_config(void);
+static void boot_usart1_pins(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  HSE 8 MHz -> PLL x9 = 72 MHz，APB1 36 MHz，APB2 72 MHz
+ */
+static void boot_clock_config(void) {
+    RCC_OscInitTypeDef osc = {0};
+    RCC_ClkInitTypeDef clk = {0};
+
+    osc.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+    osc.HSEState = RCC_HSE_ON;
+    osc.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+    osc.HSIState = RCC_HSI_ON;
+    osc.PLL.PLLState = RCC_PLL_ON;
+    osc.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+    osc.PLL.PLLMUL = RCC_PLL_MUL9;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+        Error_Handler();
+    }
+
+    clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 |
+                    RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    clk.APB1CLKDivider = RCC_HCLK_DIV2;
+    clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_2) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief  USART1 时钟与引脚（PA9 TX 复用推挽，PA10 RX 浮空输入）
+ */
+static void boot_usart1_pins(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_USART1_CLK_ENABLE();
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    gpio.Pin = GPIO_PIN_9;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &gpio);
+
+    gpio.Pin = GPIO_PIN_10;
+    gpio.Mode = GPIO_MODE_INPUT;
+    gpio.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(GPIOA, &gpio);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  引导程序入口
+ */
+int main(void) {
+    HAL_Init();
+    boot_clock_config();
+    MX_GPIO_Init();
+    MX_SPI1_Init();
+    boot_usart1_pins();
+    DMA_Manager_Init();
+
+    while (1) {
+        /* 跳转成功不会返回 */
+        boot_run(BOOT_WAIT_MS);
+    }
+}
+
+/**
+ * @brief  HAL 时基
+ */
+void SysTick_Handler(void) {
+    HAL_IncTick();
+}
+
+/**
+ * @brief  HAL 初始化失败：停在这里等调试器或看门狗
+ */
+void Error_Handler(void) {
+    __disable_irq();
+    while (1) {
+    }
+}
+
+/************************ END OF FILE *****************************************/
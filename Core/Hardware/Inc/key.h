@@ -1,3 +1,23 @@
+/**
+ * @file    key.h
+ * @brief   按键驱动：EXTI 边沿时间戳 + TIM6 采样消抖 + 事件队列
+ * @date    2026-10-18
+ *
+ * @note    - EXTI 中断只记录每个按键本轮抖动的第一个边沿时刻，并在采样器
+ *            停止时启动它，不做任何业务处理；
+ *          - 采样器是时间轮（TIM6）上的周期定时器，每 KEY_SCAN_MS 按端口
+ *            读一次 IDR，所有按键用按位并行的 2 位垂直计数器消抖：连续
+ *            KEY_DEBOUNCE_SAMPLES 次与当前状态不同才翻转；
+ *          - 翻转后分类成按下 / 松开 / 长按 / 连发 / 双击事件，事件时间取
+ *            EXTI 记录的第一个边沿（没有 EXTI 的按键取采样时刻）；
+ *          - 事件放进单生产者（采样器）单消费者（主循环）的无锁环形队列，
+ *            可选地用 ev_post 通知事件循环；
+ *          - 全部按键消抖完毕且松开时采样器自动停止，下一个 EXTI 边沿再
+ *            启动；表中有不带 EXTI 的按键时采样器一直运行；
+ *          - 按键在 KEY_TABLE 中列出，最多 32 个，同一端口的按键共用一次
+ *            IDR 读取；不同端口的按键不能使用同一条 EXTI 线。
+ */
+
 #ifndef __KEY_H
 #define __KEY_H
 
@@ -5,34 +25,126 @@
 extern "C" {
 #endif
 
-#if defined(USE_HAL_DRIVER) || defined(STM32F1xx_HAL_H)
-#include "stm32f1xx_hal.h"
-#define KEY_USE_HAL 1
-#else
-#include "stm32f10x.h"
-#define KEY_USE_HAL 0
+#include "main.h"
+#include "event_loop.h"
+#include <stdint.h>
+
+//======================================================================
+//                          按键表与参数
+//======================================================================
+
+/**
+ * X(名称, 端口, 引脚号, 高电平有效, 使用 EXTI)
+ * 默认只有 PF10 上的 KEY0：按下为高电平，下拉输入
+ */
+#ifndef KEY_TABLE
+#define KEY_TABLE(X) X(KEY0, GPIOF, 10, 1, 1)
 #endif
 
-#include "led.h"
+#define KEY_ENUM(name, port, pin, active_high, exti) name,
+typedef enum {
+  KEY_TABLE(KEY_ENUM)
+  KEY_COUNT
+} Key_Id_t;
+#undef KEY_ENUM
 
-// 定义 KEY 引脚 (PF10)
-#define KEY_GPIO_PORT GPIOF
+#define KEY_SCAN_MS 5U           // 采样周期
+#define KEY_DEBOUNCE_SAMPLES 4U  // 状态翻转所需的连续采样数（由 2 位垂直计数器决定）
+#define KEY_LONG_MS 800U         // 按住超过该时间产生长按事件
+#define KEY_REPEAT_MS 200U       // 长按后每隔该时间产生一次连发事件
+#define KEY_DCLICK_MS 300U       // 松开后在该时间内再次按下产生双击事件
 
-#if KEY_USE_HAL
-#define KEY_PIN GPIO_PIN_10
-#else
-#define KEY_PIN GPIO_IDR_IDR10
+#ifndef KEY_QUEUE_LEN
+#define KEY_QUEUE_LEN 16U        // 事件队列长度（2 的幂）
 #endif
 
-// 初始化
+//======================================================================
+//                          类型
+//======================================================================
+
+/**
+ * @brief  事件类型
+ */
+typedef enum {
+  KEY_EVT_PRESS = 1,  // 按下（消抖后）
+  KEY_EVT_RELEASE,    // 松开
+  KEY_EVT_LONG,       // 长按（按下后 KEY_LONG_MS，只产生一次）
+  KEY_EVT_REPEAT,     // 连发（长按后每 KEY_REPEAT_MS 一次）
+  KEY_EVT_DOUBLE      // 双击（紧随第二次按下的 KEY_EVT_PRESS 之后）
+} Key_EventType_t;
+
+/**
+ * @brief  事件
+ */
+typedef struct {
+  uint8_t key;    // Key_Id_t
+  uint8_t type;   // Key_EventType_t
+  uint16_t count; // 连发为第几次，其余为 0
+  uint32_t time;  // 发生时刻（HAL_GetTick，ms）
+} Key_Event_t;
+
+//======================================================================
+//                          接口
+//======================================================================
+
+/**
+ * @brief  配置按键引脚和 EXTI，清空队列
+ * @note   需在 tw_init 之后调用
+ */
 void Key_Init(void);
 
-// 获取按键状态 (1=按下, 0=释放, 假设低有效则反之，需根据电路确认)
-// 原代码: (GPIOF->IDR & GPIO_IDR_IDR10) != 0 可能意味着高电平有效？
-// 通常按键接地是低有效。原代码判断 != 0 执行 LED_Toggle，意味着高电平触发？
-// 待会在implementation里处理。
+/**
+ * @brief  停止采样器，关闭 EXTI 线
+ */
+void Key_DeInit(void);
+
+/**
+ * @brief  KEY0 消抖后的状态
+ * @return 1:按下, 0:松开
+ */
 uint8_t Key_GetState(void);
 
+/**
+ * @brief  所有按键消抖后的状态，第 n 位对应 Key_Id_t n
+ */
+uint32_t Key_GetStates(void);
+
+/**
+ * @brief  取出一个事件（主循环调用）
+ * @return 1:取到, 0:队列为空
+ */
+uint8_t Key_GetEvent(Key_Event_t *evt);
+
+/**
+ * @brief  队列满而丢弃的事件数
+ */
+uint32_t Key_GetDropped(void);
+
+/**
+ * @brief  每产生一个事件向 task 投递 sig（task 为 NULL 时不通知）
+ */
+void Key_SetEvent(ev_task_t *task, uint16_t sig);
+
+/**
+ * @brief  采样器是否在运行
+ */
+uint8_t Key_IsScanning(void);
+
+/**
+ * @brief  处理一次采样
+ * @param  raw: 各按键的原始电平（已按有效电平换算，1 为按下）
+ * @param  now: 采样时刻（ms）
+ * @note   由采样器在 TIM6 中断中调用；测试可直接用合成的抖动序列调用，
+ *         此时不要同时运行采样器
+ */
+void Key_Process(uint32_t raw, uint32_t now);
+
+/**
+ * @brief  EXTI 中断处理：记录边沿时刻并清除挂起位
+ * @note   在按键所用线的 EXTIx_IRQHandler 中调用
+ */
+void Key_EXTI_IRQHandler(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+/**
+ * @file    led_pwm.h
+ * @brief   LED PWM 驱动：TIM2 输出 PWM，DMA 按周期从 RAM 序列更新占空比
+ * @date    2026-10-18
+ *
+ * @note    - LED1（PA0）、LED2（PA1）分别接 TIM2_CH1 / TIM2_CH2，配置为复用
+ *            推挽输出，极性为低电平有效（与 led.c 一致）；LED3（PA8）只能
+ *            接 TIM1_CH1，仍由 led.h 的 GPIO 接口控制；
+ *          - PWM 频率 LED_PWM_FREQ_HZ，每周期 LED_PWM_PERIOD 个计数，比较值
+ *            带预装载，只在更新事件生效，不会出现半个周期的毛刺；
+ *          - 动画是一张 uint16_t 占空比序列，每个 PWM 周期一项：CR2.CCDS = 1
+ *            时 CCxDE 在每个更新事件发出 DMA 请求（TIM2_CH1 -> DMA1 通道 5，
+ *            TIM2_CH2 -> DMA1 通道 7），DMA 把下一项写入 CCRx；循环播放时
+ *            不开任何中断，CPU 完全不参与；单次播放只在结束时进一次 TC 中断，
+ *            最后一项保持输出；
+ *          - 序列由调用者提供且在播放期间保持有效，LED_PWM_Breathe /
+ *            LED_PWM_Fade / LED_PWM_Blink 按感知亮度（0~255）经伽马校正
+ *            生成序列；
+ *          - 一个序列项持续 1000 / LED_PWM_FREQ_HZ ms，n 项的动画时长为
+ *            n * 1000 / LED_PWM_FREQ_HZ ms。
+ */
+
+#ifndef __LED_PWM_H
+#define __LED_PWM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+//======================================================================
+//                          参数
+//======================================================================
+
+#ifndef LED_PWM_FREQ_HZ
+#define LED_PWM_FREQ_HZ 200U    // PWM 频率，也是序列的播放速率
+#endif
+
+#define LED_PWM_PERIOD 1000U     // 每周期计数（占空比满量程）
+#define LED_PWM_TIM_CLK 72000000U // TIM2 计数时钟（APB1 x2）
+
+//======================================================================
+//                          类型与返回值
+//======================================================================
+
+/**
+ * @brief  PWM 通道
+ */
+typedef enum {
+  LED_PWM_LED1 = 0, // PA0 / TIM2_CH1
+  LED_PWM_LED2,     // PA1 / TIM2_CH2
+  LED_PWM_COUNT
+} LED_PWM_Channel_t;
+
+#define LED_PWM_OK 0           // 成功
+#define LED_PWM_BUSY -1        // DMA 通道已被其他驱动占用
+#define LED_PWM_PARAM_ERROR -2 // 参数错误或未初始化
+
+//======================================================================
+//                          接口
+//======================================================================
+
+/**
+ * @brief  配置 PA0 / PA1、TIM2 和 DMA 通道，LED 全灭
+ * @retval LED_PWM_OK / LED_PWM_BUSY
+ * @note   需在 DMA_Manager_Init() 之后调用
+ */
+int LED_PWM_Init(void);
+
+/**
+ * @brief  停止动画和 TIM2，释放 DMA 通道
+ */
+void LED_PWM_DeInit(void);
+
+/**
+ * @brief  停止动画，输出固定占空比
+ * @param  duty: 0 ~ LED_PWM_PERIOD
+ */
+int LED_PWM_SetDuty(LED_PWM_Channel_t ch, uint16_t duty);
+
+/**
+ * @brief  停止动画，输出固定亮度（经伽马校正）
+ * @param  level: 感知亮度 0~255
+ */
+int LED_PWM_SetLevel(LED_PWM_Channel_t ch, uint8_t level);
+
+/**
+ * @brief  播放占空比序列
+ * @param  seq: 序列，每项 0 ~ LED_PWM_PERIOD，播放期间保持有效
+ * @param  len: 项数（非 0）
+ * @param  loop: 1 循环播放，0 播放一次后保持最后一项
+ * @retval LED_PWM_OK / LED_PWM_PARAM_ERROR
+ * @note   正在播放的动画先被停止；新序列从下一个更新事件开始写入，
+ *         再下一个 PWM 周期生效
+ */
+int LED_PWM_Play(LED_PWM_Channel_t ch, const uint16_t *seq, uint16_t len, uint8_t loop);
+
+/**
+ * @brief  停止动画并熄灭
+ */
+void LED_PWM_Stop(LED_PWM_Channel_t ch);
+
+/**
+ * @brief  是否正在播放（循环播放一直为 1）
+ */
+uint8_t LED_PWM_IsPlaying(LED_PWM_Channel_t ch);
+
+/**
+ * @brief  感知亮度转占空比（伽马约 2.2：x^2 * (4 + x) / 5）
+ * @param  level: 0~255
+ * @retval 0 ~ LED_PWM_PERIOD
+ */
+uint16_t LED_PWM_Gamma(uint8_t level);
+
+/**
+ * @brief  生成呼吸序列：亮度在前半段从 0 线性升到 255，后半段降回
+ */
+void LED_PWM_Breathe(uint16_t *seq, uint16_t len);
+
+/**
+ * @brief  生成渐变序列：亮度从 from 线性变到 to（最后一项为 to）
+ */
+void LED_PWM_Fade(uint16_t *seq, uint16_t len, uint8_t from, uint8_t to);
+
+/**
+ * @brief  生成闪烁序列：前 on 项为 level，其余熄灭
+ */
+void LED_PWM_Blink(uint16_t *seq, uint16_t len, uint16_t on, uint8_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
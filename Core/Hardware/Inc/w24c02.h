@@ -25,6 +25,7 @@
 #define __INF_W24C02_H
 
 #include "i2c.h"
+#include "pt.h"
 #include "string.h"
 
 /* ========================== 宏定义 ========================== */
@@ -38,6 +39,36 @@
  */
 #define ADDR 0xA0
 
+/**
+ * @brief 非阻塞写操作状态
+ */
+#define W24C02_OP_OK 0       /*!< 写入完成（写周期已结束） */
+#define W24C02_OP_BUSY 1     /*!< 进行中 */
+#define W24C02_OP_TIMEOUT -1 /*!< 超时（器件一直不应答或总线无响应） */
+#define W24C02_OP_NACK -2    /*!< 数据字节未被应答 */
+
+/**
+ * @brief 非阻塞写操作的总超时（ms），包含等待总线和写周期
+ */
+#define W24C02_OP_TIMEOUT_MS 20
+
+/* ========================== 类型定义 ========================== */
+
+/**
+ * @brief  非阻塞写操作上下文（成员由驱动维护，每个进行中的操作一个）
+ */
+typedef struct {
+  pt_t pt;              /*!< 协程状态，deadline 为整个操作的截止时间 */
+  pt_t child;           /*!< 寻址子协程 */
+  int8_t status;        /*!< W24C02_OP_xxx */
+  uint8_t acked;        /*!< 最近一次寻址是否被应答 */
+  uint8_t innerAddr;    /*!< EEPROM内部起始地址 */
+  uint8_t len;          /*!< 数据长度 */
+  uint8_t index;        /*!< 已发送的数据字节数 */
+  uint8_t byte;         /*!< 单字节写入时的数据 */
+  const uint8_t *bytes; /*!< 数据，操作结束前必须保持有效 */
+} W24C02_Op_t;
+
 /* ========================== HAL库版本函数声明 ========================== */
 
 /**
@@ -94,9 +125,10 @@ void register_W24C02_Init(void);
  * @brief  向W24C02写入单个字节 (寄存器版本)
  * @param  innerAddr: EEPROM内部地址 (0-255)
  * @param  byte: 要写入的数据字节
- * @retval 无
+ * @retval W24C02_OP_xxx 写入结果
+ * @note   按非阻塞操作执行到结束，会排在进行中的操作之后
  */
-void register_W24C02_WriteByte(uint8_t innerAddr, uint8_t byte);
+int8_t register_W24C02_WriteByte(uint8_t innerAddr, uint8_t byte);
 
 /**
  * @brief  从W24C02读取单个字节 (寄存器版本)
@@ -110,10 +142,11 @@ uint8_t register_W24C02_ReadByte(uint8_t innerAddr);
  * @param  innerAddr: EEPROM内部起始地址 (0-255)
  * @param  bytes: 指向要写入数据的指针
  * @param  len: 要写入的字节数
- * @retval 无
- * @note   注意页边界限制，W24C02页大小为8字节
+ * @retval W24C02_OP_xxx 写入结果
+ * @note   注意页边界限制，W24C02页大小为8字节；
+ *         按非阻塞操作执行到结束，会排在进行中的操作之后
  */
-void register_W24C02_WriteBytes(uint8_t innerAddr, uint8_t *bytes, uint8_t len);
+int8_t register_W24C02_WriteBytes(uint8_t innerAddr, uint8_t *bytes, uint8_t len);
 
 /**
  * @brief  从W24C02读取多个字节 (寄存器版本)
@@ -124,4 +157,37 @@ void register_W24C02_WriteBytes(uint8_t innerAddr, uint8_t *bytes, uint8_t len);
  */
 void register_W24C02_ReadBytes(uint8_t innerAddr, uint8_t *bytes, uint8_t len);
 
+/* ========================== 非阻塞版本函数声明 ========================== */
+
+/**
+ * @brief  启动非阻塞的单字节写入 (寄存器版本)
+ * @param  op: 操作上下文
+ * @param  innerAddr: EEPROM内部地址 (0-255)
+ * @param  byte: 要写入的数据字节
+ * @retval 无
+ */
+void register_W24C02_WriteByte_Start(W24C02_Op_t *op, uint8_t innerAddr,
+                                     uint8_t byte);
+
+/**
+ * @brief  启动非阻塞的页写入 (寄存器版本)
+ * @param  op: 操作上下文
+ * @param  innerAddr: EEPROM内部起始地址 (0-255)
+ * @param  bytes: 要写入的数据，操作结束前必须保持有效
+ * @param  len: 要写入的字节数
+ * @retval 无
+ * @note   页边界限制与 register_W24C02_WriteBytes 相同
+ */
+void register_W24C02_WriteBytes_Start(W24C02_Op_t *op, uint8_t innerAddr,
+                                      const uint8_t *bytes, uint8_t len);
+
+/**
+ * @brief  推进一个已启动的写操作
+ * @param  op: 操作上下文
+ * @retval PT_WAITING 表示进行中，其余值表示已结束，结果在 op->status
+ * @note   多个操作可在同一个循环里轮询，一个操作从寻址到写周期结束独占 I2C2；
+ *         写周期用应答轮询等待，操作结束时数据已写入
+ */
+int register_W24C02_Op_Poll(W24C02_Op_t *op);
+
 #endif /* __INF_W24C02_H */
\ No newline at end of file
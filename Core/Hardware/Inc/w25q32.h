@@ -2,6 +2,7 @@
 #define __W25Q32_H
 
 #include <stdint.h>
+#include "pt.h"
 
 //======================================================================
 //                          Typedefs and Enums
@@ -34,6 +35,22 @@ typedef struct {
     uint32_t block_64k_count;
 } W25Q32_State_t;
 
+/**
+ * @brief  Context of a non-blocking erase / program operation.
+ * @note   Members are managed by the driver; allocate one per operation in flight.
+ *         The blocking erase / program calls run one of these to completion, so they
+ *         queue behind operations already in flight: finish your own before calling them.
+ */
+typedef struct {
+    pt_t pt;                  // Protothread state
+    W25Q32_Status_t status;   // Result, valid once W25Q32_Op_Poll() stops returning PT_WAITING
+    uint8_t cmd;              // Erase / program opcode
+    uint32_t address;         // 24-bit target address
+    const uint8_t *data;      // Page program payload
+    uint32_t size;            // Payload length
+    uint32_t timeout_ms;      // Budget for the internal write cycle
+} W25Q32_Op_t;
+
 
 //======================================================================
 //                         Constant Definitions
@@ -62,6 +79,18 @@ typedef struct {
 // --- Status Register 1 Bits ---
 #define W25Q32_SR1_BUSY_BIT              0x01 // Erase/Write In Progress
 
+// --- Non-blocking operation timeouts (ms, datasheet maximum plus margin) ---
+#define W25Q32_IDLE_TIMEOUT_MS           2000
+#define W25Q32_PP_TIMEOUT_MS             5
+#define W25Q32_SE_TIMEOUT_MS             400
+#define W25Q32_BE64_TIMEOUT_MS           2000
+
+// --- Chunk size of W25Q32_ReadCRC (one word-aligned buffer of this size) ---
+#define W25Q32_CRC_CHUNK_SIZE            256
+
+// --- Attempts of a W25Q32_ReadCRC chunk that loses bytes to an SPI overrun ---
+#define W25Q32_SPI_RETRIES               3
+
 // --- Expected JEDEC ID ---
 #define W25Q32_EXPECTED_MANUFACTURER_ID  0xEF
 #define W25Q32_EXPECTED_JEDEC_ID_PART    0x4016 // Memory Type + Capacity
@@ -118,6 +147,62 @@ W25Q32_Status_t W25Q32_PageProgram(uint32_t page_num, uint16_t offset_in_page, u
  */
 W25Q32_Status_t W25Q32_ReadData(uint32_t address, uint8_t *data, uint32_t size);
 
+/**
+ * @brief  Computes the CRC-32 (crc32.h) of a flash region without a full copy in RAM.
+ * @param  address: The 24-bit starting address.
+ * @param  size: Number of bytes.
+ * @param  crc: Receives the CRC, equal to crc32_compute() over the same bytes.
+ * @return W25Q32_OK, W25Q32_INVALID_PARAM, W25Q32_TIMEOUT, W25Q32_BUSY if the
+ *         CRC unit is in use, or W25Q32_ERROR if one chunk kept failing on SPI.
+ * @note   The region is read through one W25Q32_CRC_CHUNK_SIZE buffer. Each chunk
+ *         is fed to the CRC unit by DMA (crc32_init; otherwise by the CPU) and the
+ *         feed completes before the next chunk is read, so its interrupt never
+ *         lands inside an SPI block read. A chunk that overruns the SPI receiver
+ *         is re-read with a new read command, up to W25Q32_SPI_RETRIES times.
+ */
+W25Q32_Status_t W25Q32_ReadCRC(uint32_t address, uint32_t size, uint32_t *crc);
+
+/**
+ * @brief  Starts a non-blocking 4KB sector erase.
+ * @param  op: Operation context.
+ * @param  sector_num: The sector number to erase (0 to 1023).
+ * @return W25Q32_OK, or W25Q32_INVALID_PARAM (the operation is not started).
+ * @note   Drive the operation with W25Q32_Op_Poll() until it stops returning PT_WAITING.
+ */
+W25Q32_Status_t W25Q32_SectorErase_4KB_Start(W25Q32_Op_t *op, uint32_t sector_num);
+
+/**
+ * @brief  Starts a non-blocking 64KB block erase.
+ * @param  op: Operation context.
+ * @param  block_num: The block number to erase (0 to 63).
+ * @return W25Q32_OK, or W25Q32_INVALID_PARAM (the operation is not started).
+ */
+W25Q32_Status_t W25Q32_BlockErase_64KB_Start(W25Q32_Op_t *op, uint32_t block_num);
+
+/**
+ * @brief  Starts a non-blocking page program.
+ * @param  op: Operation context.
+ * @param  page_num: The page number to write to (0 to 16383).
+ * @param  offset_in_page: Start offset within the page (0-255).
+ * @param  data: Data to write, must stay valid until the operation ends.
+ * @param  size: Number of bytes to write (truncated at the page end).
+ * @return W25Q32_OK, or W25Q32_INVALID_PARAM (the operation is not started).
+ */
+W25Q32_Status_t W25Q32_PageProgram_Start(W25Q32_Op_t *op, uint32_t page_num, uint16_t offset_in_page,
+                                         const uint8_t *data, uint32_t size);
+
+/**
+ * @brief  Runs a started operation until it has to wait for the chip.
+ * @param  op: Operation context.
+ * @return PT_WAITING while in progress, PT_EXITED / PT_ENDED when done;
+ *         the result is in op->status.
+ * @note   Several operations may be polled from the same loop, in any order: an
+ *         operation owns the chip from write-enable until BUSY clears, so they
+ *         execute in turn and each timeout only covers its own write cycle.
+ *         A started operation must be polled until it ends.
+ */
+int W25Q32_Op_Poll(W25Q32_Op_t *op);
+
 /**
  * @brief  Puts the device in power-down mode.
  */
@@ -1,128 +1,409 @@
-/*
- * @Author: wushengran
- * @Date: 2024-05-27 14:19:39
- * @Description: KEY Driver Implementation
- *
- * Copyright (c) 2024 by atguigu, All Rights Reserved.
+/**
+ * @file    key.c
+ * @brief   按键驱动：EXTI 边沿时间戳 + TIM6 采样消抖 + 事件队列
+ * @date    2026-10-18
  */
 #include "key.h"
-#include "led.h"
+#include "timer_wheel.h"
+
+// =================== 私有类型与变量 ===================
+
+/**
+ * @brief 按键静态配置
+ */
+typedef struct {
+  GPIO_TypeDef *port;
+  uint8_t pin;
+  uint8_t active_high;
+  uint8_t exti;
+} Key_Def_t;
+
+/**
+ * @brief 按键分类状态（只在采样器中访问）
+ */
+typedef struct {
+  uint32_t next_time;    // 下一次长按 / 连发的时刻
+  uint32_t release_time; // 上一次单击松开的时刻
+  uint16_t repeats;      // 本次按下已产生的连发次数
+  uint8_t long_sent;     // 本次按下已产生长按
+  uint8_t clicked;       // 上一次是单击，等待可能的第二次按下
+} Key_Ctx_t;
+
+#define KEY_DEF(name, port, pin, active_high, exti) {port, pin, active_high, exti},
+static const Key_Def_t s_keys[KEY_COUNT] = {KEY_TABLE(KEY_DEF)};
+#undef KEY_DEF
+
+#define KEY_MASK ((uint32_t)(0xFFFFFFFFUL >> (32U - KEY_COUNT)))
+#define KEY_NO_KEY 0xFFU
+
+// 端口分组：同一端口的按键共用一次 IDR 读取
+static GPIO_TypeDef *s_ports[KEY_COUNT];
+static uint8_t s_key_port[KEY_COUNT];
+static uint8_t s_port_count = 0;
+
+static uint32_t s_invert;                // 低电平有效的按键
+static uint32_t s_polled;                // 不带 EXTI 的按键
+static uint16_t s_exti_lines;            // 使用的 EXTI 线
+static uint8_t s_line_key[16];           // EXTI 线 -> 按键
+
+// 消抖：2 位垂直计数器，每一位对应一个按键
+static volatile uint32_t s_state;        // 消抖后的状态
+static uint32_t s_ct0, s_ct1;
+
+// EXTI 记录的边沿
+static volatile uint32_t s_edge_pending; // 本轮已记录第一个边沿的按键
+static volatile uint32_t s_edge_time[KEY_COUNT];
+
+static Key_Ctx_t s_ctx[KEY_COUNT];
+
+// 单生产者单消费者队列：s_q_head 只由采样器写，s_q_tail 只由主循环写
+static Key_Event_t s_queue[KEY_QUEUE_LEN];
+static volatile uint8_t s_q_head = 0;
+static volatile uint8_t s_q_tail = 0;
+static volatile uint32_t s_dropped = 0;
+
+static ev_task_t *s_evt_task = NULL;
+static uint16_t s_evt_sig = 0;
+
+static tw_timer_t s_scan_timer;
+static volatile uint8_t s_scanning = 0;
+static uint8_t s_ready = 0;
+
+// =================== 私有函数 ===================
+
+/**
+ * @brief 按键所在 EXTI 线的中断号
+ */
+static IRQn_Type Key_LineIRQ(uint8_t line) {
+  if (line <= 4) {
+    return (IRQn_Type)(EXTI0_IRQn + line);
+  }
+  return (line <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+/**
+ * @brief 读取所有按键的原始状态（1 为按下）
+ */
+static uint32_t Key_ReadRaw(void) {
+  uint32_t idr[KEY_COUNT];
+  uint32_t raw = 0;
+
+  for (uint8_t p = 0; p < s_port_count; p++) {
+    idr[p] = s_ports[p]->IDR;
+  }
+  for (uint8_t k = 0; k < KEY_COUNT; k++) {
+    raw |= ((idr[s_key_port[k]] >> s_keys[k].pin) & 1U) << k;
+  }
+  return raw ^ s_invert;
+}
+
+/**
+ * @brief 事件入队（采样器上下文）
+ */
+static void Key_Push(uint8_t key, uint8_t type, uint16_t count, uint32_t time) {
+  uint8_t head = s_q_head;
+
+  if ((uint8_t)(head - s_q_tail) >= KEY_QUEUE_LEN) {
+    s_dropped++;
+    return;
+  }
+  s_queue[head & (KEY_QUEUE_LEN - 1U)].key = key;
+  s_queue[head & (KEY_QUEUE_LEN - 1U)].type = type;
+  s_queue[head & (KEY_QUEUE_LEN - 1U)].count = count;
+  s_queue[head & (KEY_QUEUE_LEN - 1U)].time = time;
+  __DMB(); // 先写内容再发布
+  s_q_head = (uint8_t)(head + 1U);
+
+  if (s_evt_task != NULL) {
+    ev_post(s_evt_task, s_evt_sig, key, NULL);
+  }
+}
+
+/**
+ * @brief 单个按键的事件分类
+ * @param toggled 本次采样状态是否翻转
+ * @param t       翻转对应的边沿时刻
+ * @param now     采样时刻
+ */
+static void Key_Classify(uint8_t k, uint8_t toggled, uint32_t t, uint32_t now) {
+  Key_Ctx_t *c = &s_ctx[k];
+  uint8_t pressed = (s_state >> k) & 1U;
+
+  if (toggled && pressed) {
+    Key_Push(k, KEY_EVT_PRESS, 0, t);
+    if (c->clicked && t - c->release_time <= KEY_DCLICK_MS) {
+      Key_Push(k, KEY_EVT_DOUBLE, 0, t);
+      c->clicked = 2; // 第二次按下，松开后不再作为第一次单击
+    } else {
+      c->clicked = 0;
+    }
+    c->next_time = t + KEY_LONG_MS;
+    c->repeats = 0;
+    c->long_sent = 0;
+  } else if (toggled) {
+    Key_Push(k, KEY_EVT_RELEASE, 0, t);
+    if (!c->long_sent && c->clicked == 0) {
+      c->clicked = 1;
+      c->release_time = t;
+    } else {
+      c->clicked = 0;
+    }
+  } else if (pressed && (int32_t)(now - c->next_time) >= 0) {
+    if (!c->long_sent) {
+      c->long_sent = 1;
+      Key_Push(k, KEY_EVT_LONG, 0, c->next_time);
+    } else {
+      c->repeats++;
+      Key_Push(k, KEY_EVT_REPEAT, c->repeats, c->next_time);
+    }
+    c->next_time += KEY_REPEAT_MS;
+  }
+}
+
+/**
+ * @brief 消抖并分类
+ * @param pend 读取 raw 之前的 s_edge_pending 快照
+ */
+static void Key_Update(uint32_t raw, uint32_t pend, uint32_t now) {
+  uint32_t delta = (s_state ^ raw) & KEY_MASK;
+  uint32_t toggled, scan, primask;
+
+  // 垂直计数器：delta 为 0 的位复位为 3，否则减 1，从 0 再减时翻转
+  s_ct0 = ~(s_ct0 & delta);
+  s_ct1 = s_ct0 ^ (s_ct1 & delta);
+  toggled = delta & s_ct0 & s_ct1;
+  s_state ^= toggled;
+
+  // 已翻转（时间已使用）和又回到原状态（抖动未形成翻转）的按键清除边沿记录
+  primask = __get_PRIMASK();
+  __disable_irq();
+  s_edge_pending &= ~(pend & (toggled | ~delta));
+  if (primask == 0) {
+    __enable_irq();
+  }
+
+  scan = toggled | s_state;
+  while (scan != 0) {
+    uint8_t k = (uint8_t)(31U - __CLZ(scan));
+    uint32_t bit = 1UL << k;
+    scan &= ~bit;
+    Key_Classify(k, (toggled & bit) != 0, (pend & bit) ? s_edge_time[k] : now, now);
+  }
+}
+
+/**
+ * @brief 采样器（时间轮回调，TIM6 中断）
+ */
+static void Key_ScanCallback(tw_timer_t *timer, void *ctx) {
+  uint32_t pend = s_edge_pending;
+  uint32_t primask;
+
+  (void)timer;
+  (void)ctx;
+
+  Key_Update(Key_ReadRaw(), pend, HAL_GetTick());
+
+  // 全部松开、计数器静止且没有新边沿时停止，等下一个 EXTI 边沿
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (s_polled == 0 && s_state == 0 && s_edge_pending == 0 &&
+      (~(s_ct0 & s_ct1) & KEY_MASK) == 0) {
+    tw_stop(&s_scan_timer);
+    s_scanning = 0;
+  }
+  if (primask == 0) {
+    __enable_irq();
+  }
+}
+
+/**
+ * @brief 启动采样器
+ */
+static void Key_StartScan(void) {
+  uint32_t ticks = tw_ms_to_ticks(KEY_SCAN_MS);
+
+  if (tw_start(&s_scan_timer, ticks, ticks) == TW_OK) {
+    s_scanning = 1;
+  }
+}
+
+// =================== 公开函数 ===================
 
 /**
  * @brief 按键初始化
- *        KEY -> PF10
- *        HAL模式: 配置为中断上升沿模式
- *        寄存器模式: 配置为中断模式
+ *        KEY0 -> PF10，上升沿和下降沿都触发 EXTI10
  */
 void Key_Init(void) {
-#if KEY_USE_HAL
   GPIO_InitTypeDef GPIO_InitStruct = {0};
 
-  /* GPIO Ports Clock Enable */
-  // PF 端口时钟
-  if (KEY_GPIO_PORT == GPIOA)
-    __HAL_RCC_GPIOA_CLK_ENABLE();
-  else if (KEY_GPIO_PORT == GPIOB)
-    __HAL_RCC_GPIOB_CLK_ENABLE();
-  else if (KEY_GPIO_PORT == GPIOC)
-    __HAL_RCC_GPIOC_CLK_ENABLE();
-  else if (KEY_GPIO_PORT == GPIOD)
-    __HAL_RCC_GPIOD_CLK_ENABLE();
-  else if (KEY_GPIO_PORT == GPIOE)
-    __HAL_RCC_GPIOE_CLK_ENABLE();
-  else if (KEY_GPIO_PORT == GPIOF)
-    __HAL_RCC_GPIOF_CLK_ENABLE();
-
-  /* Configure GPIO pin */
-  GPIO_InitStruct.Pin = KEY_PIN;
-  // 假设按下为高电平，配置为上升沿中断 + 下拉
-  // 如果实际是按下接地，请改为 GPIO_MODE_IT_FALLING + GPIO_PULLUP
-  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
-  GPIO_InitStruct.Pull = GPIO_PULLDOWN;
-  HAL_GPIO_Init(KEY_GPIO_PORT, &GPIO_InitStruct);
-
-  /* EXTI interrupt init */
-  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 2, 0); // 优先级可根据需要调整
-  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
-
-#else
-  // 寄存器初始化 (STM32F103)
-  // 1. 配置时钟 (GPIOF + AFIO)
-  RCC->APB2ENR |= RCC_APB2ENR_IOPFEN | RCC_APB2ENR_AFIOEN;
-
-  // 2. GPIO工作模式 configuration PF10 -> Input
-  // CRH [11:8] corresponds to Pin 10
-  // Input Mode (00) + Floating (01) or Pull-up/down (10)
-  // 假设用 Pull-up/down (10) -> Mode=00, CNF=10 -> 0x8
-  KEY_GPIO_PORT->CRH &= ~(0xF << 8); // Clear
-  KEY_GPIO_PORT->CRH |= (0x8 << 8);  // Input with pull-up/down
-
-  // 下拉 (ODR=0) or 上拉 (ODR=1)
-  // 假设下拉
-  KEY_GPIO_PORT->ODR &= ~KEY_PIN;
-
-  // 3. AFIO EXTI Configuration
-  // EXTI10 maps to PF10. EXTICR[2] controls EXTI8-11.
-  // EXTI10 is in EXTICR[2] bits [11:8]
-  // Value for Port F is usually 0x05 (A=0, B=1, ..., F=5)
-  AFIO->EXTICR[2] &= ~(0xF << 8);
-  AFIO->EXTICR[2] |= (0x5 << 8);
-
-  // 4. EXTI Configuration
-  EXTI->IMR |= (1 << 10);   // Unmask Line 10
-  EXTI->RTSR |= (1 << 10);  // Rising Trigger
-  EXTI->FTSR &= ~(1 << 10); // Clear Falling Trigger
-
-  // 5. NVIC Configuration
-  NVIC_SetPriority(EXTI15_10_IRQn, 2);
-  NVIC_EnableIRQ(EXTI15_10_IRQn);
-#endif
-}
-
-/**
- * @brief 获取按键状态
- * @return 1:按下, 0:松开 (假设高有效)
+  Key_DeInit();
+
+  s_port_count = 0;
+  s_invert = 0;
+  s_polled = 0;
+  s_exti_lines = 0;
+  for (uint8_t i = 0; i < 16; i++) {
+    s_line_key[i] = KEY_NO_KEY;
+  }
+
+  for (uint8_t k = 0; k < KEY_COUNT; k++) {
+    const Key_Def_t *d = &s_keys[k];
+    uint8_t p = 0;
+
+    while (p < s_port_count && s_ports[p] != d->port) {
+      p++;
+    }
+    if (p == s_port_count) {
+      s_ports[s_port_count++] = d->port;
+    }
+    s_key_port[k] = p;
+
+    // 端口时钟：IOPAEN 起按端口顺序排列
+    RCC->APB2ENR |= RCC_APB2ENR_IOPAEN << (((uint32_t)d->port - GPIOA_BASE) / 0x400U);
+
+    // 按下为高电平时下拉，否则上拉
+    GPIO_InitStruct.Pin = 1U << d->pin;
+    GPIO_InitStruct.Mode = d->exti ? GPIO_MODE_IT_RISING_FALLING : GPIO_MODE_INPUT;
+    GPIO_InitStruct.Pull = d->active_high ? GPIO_PULLDOWN : GPIO_PULLUP;
+    HAL_GPIO_Init(d->port, &GPIO_InitStruct);
+
+    if (!d->active_high) {
+      s_invert |= 1UL << k;
+    }
+    if (d->exti) {
+      s_exti_lines |= (uint16_t)(1U << d->pin);
+      s_line_key[d->pin] = k;
+    } else {
+      s_polled |= 1UL << k;
+    }
+  }
+
+  // 启动时已按住的按键不产生按下事件
+  s_state = Key_ReadRaw();
+  s_ct0 = 0xFFFFFFFFUL;
+  s_ct1 = 0xFFFFFFFFUL;
+  s_edge_pending = 0;
+  for (uint8_t k = 0; k < KEY_COUNT; k++) {
+    s_ctx[k].clicked = 0;
+    s_ctx[k].long_sent = 0;
+    s_ctx[k].repeats = 0;
+    s_ctx[k].next_time = 0;
+    s_ctx[k].release_time = 0;
+  }
+  s_q_head = 0;
+  s_q_tail = 0;
+  s_dropped = 0;
+  tw_timer_init(&s_scan_timer, Key_ScanCallback, NULL);
+  s_ready = 1;
+
+  EXTI->PR = s_exti_lines;
+  for (uint8_t line = 0; line < 16; line++) {
+    if (s_exti_lines & (1U << line)) {
+      HAL_NVIC_SetPriority(Key_LineIRQ(line), 2, 0); // 优先级可根据需要调整
+      HAL_NVIC_EnableIRQ(Key_LineIRQ(line));
+    }
+  }
+
+  if (s_polled != 0 || s_state != 0) {
+    Key_StartScan();
+  }
+}
+
+/**
+ * @brief 停止采样器，关闭 EXTI 线
  */
-uint8_t Key_GetState(void) {
-#if KEY_USE_HAL
-  return (HAL_GPIO_ReadPin(KEY_GPIO_PORT, KEY_PIN) == GPIO_PIN_SET) ? 1 : 0;
-#else
-  return ((KEY_GPIO_PORT->IDR & KEY_PIN) != 0) ? 1 : 0; // Mask check
-#endif
+void Key_DeInit(void) {
+  if (!s_ready) {
+    return;
+  }
+  EXTI->IMR &= ~(uint32_t)s_exti_lines;
+  EXTI->PR = s_exti_lines;
+  tw_stop(&s_scan_timer);
+  s_scanning = 0;
+  s_ready = 0;
 }
 
-// =================== 中断处理 ===================
+/**
+ * @brief 获取 KEY0 消抖后的状态
+ * @return 1:按下, 0:松开
+ */
+uint8_t Key_GetState(void) {
+  return (uint8_t)(s_state & 1U);
+}
 
 /**
- * @brief 按键按下处理函数(核心业务逻辑)
+ * @brief 获取所有按键消抖后的状态
  */
-static void Key_OnPress(void) { LED_Toggle(LED1); }
+uint32_t Key_GetStates(void) {
+  return s_state;
+}
 
-#if KEY_USE_HAL
 /**
- * @brief HAL EXTI Callback
- *        使用 weak 定义，允许用户在 main.c 中覆盖
+ * @brief 取出一个事件（主循环）
  */
-__weak void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
-  if (GPIO_Pin == KEY_PIN) {
-    Key_OnPress();
+uint8_t Key_GetEvent(Key_Event_t *evt) {
+  uint8_t tail = s_q_tail;
+
+  if (tail == s_q_head) {
+    return 0;
   }
+  __DMB(); // 看到 head 之后再读内容
+  *evt = s_queue[tail & (KEY_QUEUE_LEN - 1U)];
+  s_q_tail = (uint8_t)(tail + 1U);
+  return 1;
+}
+
+/**
+ * @brief 队列满而丢弃的事件数
+ */
+uint32_t Key_GetDropped(void) {
+  return s_dropped;
 }
-#else
+
 /**
- * @brief EXTI15_10 中断服务函数 (Register Mode)
+ * @brief 设置事件通知
  */
-void EXTI15_10_IRQHandler(void) {
-  // 判断是否是 EXTI10 (PF10)
-  if (EXTI->PR & (1 << 10)) {
-    // 简单的去抖 (可选，这里仅做状态判断)
-    // 再次确认电平状态
-    if ((KEY_GPIO_PORT->IDR & KEY_PIN) != 0) {
-      Key_OnPress();
+void Key_SetEvent(ev_task_t *task, uint16_t sig) {
+  s_evt_sig = sig;
+  s_evt_task = task;
+}
+
+/**
+ * @brief 采样器是否在运行
+ */
+uint8_t Key_IsScanning(void) {
+  return s_scanning;
+}
+
+/**
+ * @brief 处理一次采样（合成输入）
+ */
+void Key_Process(uint32_t raw, uint32_t now) {
+  Key_Update(raw & KEY_MASK, s_edge_pending, now);
+}
+
+// =================== 中断处理 ===================
+
+/**
+ * @brief EXTI 中断：只记录每个按键本轮的第一个边沿并启动采样器
+ */
+void Key_EXTI_IRQHandler(void) {
+  uint32_t pr = EXTI->PR & s_exti_lines;
+  uint32_t now = HAL_GetTick();
+
+  EXTI->PR = pr;
+  while (pr != 0) {
+    uint8_t line = (uint8_t)(31U - __CLZ(pr));
+    uint8_t k = s_line_key[line];
+    pr &= ~(1UL << line);
+
+    if (k != KEY_NO_KEY && (s_edge_pending & (1UL << k)) == 0) {
+      s_edge_time[k] = now;
+      s_edge_pending |= 1UL << k;
     }
+  }
 
-    // 清除中断标志
-    EXTI->PR |= (1 << 10);
+  if (s_ready && !s_scanning) {
+    Key_StartScan();
   }
 }
-#endif
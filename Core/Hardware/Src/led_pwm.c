@@ -0,0 +1,243 @@
+/**
+ * @file    led_pwm.c
+ * @brief   LED PWM 驱动：TIM2 输出 PWM，DMA 按周期从 RAM 序列更新占空比
+ * @date    2026-10-18
+ */
+#include "led_pwm.h"
+#include "dma_manager.h"
+
+// =================== 私有类型与变量 ===================
+
+/**
+ * @brief  通道静态配置
+ */
+typedef struct {
+  uint16_t pin;           // GPIOA 引脚
+  volatile uint32_t *ccr; // 比较寄存器
+  uint32_t dier;          // CCxDE
+  DMA_ChannelId_t dma;    // TIM2_CHx 请求所在的 DMA 通道
+} LED_PWM_Def_t;
+
+static const LED_PWM_Def_t s_defs[LED_PWM_COUNT] = {
+    {GPIO_PIN_0, &TIM2->CCR1, TIM_DIER_CC1DE, DMA_CH_DMA1_5},
+    {GPIO_PIN_1, &TIM2->CCR2, TIM_DIER_CC2DE, DMA_CH_DMA1_7},
+};
+
+static volatile uint8_t s_playing[LED_PWM_COUNT];
+static uint8_t s_ready = 0;
+
+// =================== 私有函数 ===================
+
+/**
+ * @brief  关闭 DMA 请求并中止传输，CCRx 保持最后写入的值
+ */
+static void LED_PWM_Halt(LED_PWM_Channel_t ch) {
+  TIM2->DIER &= ~s_defs[ch].dier;
+  DMA_AbortTransfer(s_defs[ch].dma);
+  s_playing[ch] = 0;
+}
+
+/**
+ * @brief  单次播放结束（DMA TC 中断）
+ */
+static void LED_PWM_OnEvent(DMA_ChannelId_t dma, uint32_t events, void *ctx) {
+  (void)ctx;
+
+  if ((events & DMA_EVT_TC) == 0) {
+    return;
+  }
+  for (uint8_t ch = 0; ch < LED_PWM_COUNT; ch++) {
+    if (s_defs[ch].dma == dma) {
+      TIM2->DIER &= ~s_defs[ch].dier;
+      s_playing[ch] = 0;
+    }
+  }
+}
+
+// =================== 公开函数 ===================
+
+/**
+ * @brief  LED PWM 初始化
+ *         LED1 -> PA0 / TIM2_CH1
+ *         LED2 -> PA1 / TIM2_CH2
+ */
+int LED_PWM_Init(void) {
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  if (s_ready) {
+    LED_PWM_DeInit();
+  }
+
+  for (uint8_t ch = 0; ch < LED_PWM_COUNT; ch++) {
+    if (DMA_Claim(s_defs[ch].dma, "led_pwm") != DMA_MGR_OK) {
+      while (ch-- > 0) {
+        DMA_Release(s_defs[ch].dma);
+      }
+      return LED_PWM_BUSY;
+    }
+    s_playing[ch] = 0;
+  }
+
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_TIM2_CLK_ENABLE();
+
+  // 先配置好定时器再切换引脚，切换时输出为无效电平（熄灭）
+  TIM2->CR1 = 0;
+  TIM2->PSC = LED_PWM_TIM_CLK / (LED_PWM_FREQ_HZ * LED_PWM_PERIOD) - 1U;
+  TIM2->ARR = LED_PWM_PERIOD - 1U;
+  TIM2->CCMR1 = (6U << TIM_CCMR1_OC1M_Pos) | TIM_CCMR1_OC1PE |
+                (6U << TIM_CCMR1_OC2M_Pos) | TIM_CCMR1_OC2PE; // PWM 模式 1，预装载
+  TIM2->CCR1 = 0;
+  TIM2->CCR2 = 0;
+  TIM2->CCER = TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC2E | TIM_CCER_CC2P; // 低电平点亮
+  TIM2->CR2 = TIM_CR2_CCDS; // CCx DMA 请求在更新事件发出
+  TIM2->DIER = 0;
+  TIM2->EGR = TIM_EGR_UG;
+  TIM2->SR = 0;
+  TIM2->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+  GPIO_InitStruct.Pin = GPIO_PIN_0 | GPIO_PIN_1;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+  s_ready = 1;
+  return LED_PWM_OK;
+}
+
+/**
+ * @brief  停止动画和 TIM2，释放 DMA 通道
+ */
+void LED_PWM_DeInit(void) {
+  if (!s_ready) {
+    return;
+  }
+  for (uint8_t ch = 0; ch < LED_PWM_COUNT; ch++) {
+    LED_PWM_Halt((LED_PWM_Channel_t)ch);
+    DMA_Release(s_defs[ch].dma);
+  }
+  TIM2->CR1 = 0;
+  TIM2->CCER = 0;
+  s_ready = 0;
+}
+
+/**
+ * @brief  输出固定占空比
+ */
+int LED_PWM_SetDuty(LED_PWM_Channel_t ch, uint16_t duty) {
+  if (!s_ready || ch >= LED_PWM_COUNT || duty > LED_PWM_PERIOD) {
+    return LED_PWM_PARAM_ERROR;
+  }
+  LED_PWM_Halt(ch);
+  *s_defs[ch].ccr = duty;
+  return LED_PWM_OK;
+}
+
+/**
+ * @brief  输出固定亮度
+ */
+int LED_PWM_SetLevel(LED_PWM_Channel_t ch, uint8_t level) {
+  return LED_PWM_SetDuty(ch, LED_PWM_Gamma(level));
+}
+
+/**
+ * @brief  播放占空比序列
+ */
+int LED_PWM_Play(LED_PWM_Channel_t ch, const uint16_t *seq, uint16_t len, uint8_t loop) {
+  const LED_PWM_Def_t *d;
+  DMA_Config_t cfg;
+
+  if (!s_ready || ch >= LED_PWM_COUNT || seq == NULL || len == 0) {
+    return LED_PWM_PARAM_ERROR;
+  }
+  d = &s_defs[ch];
+  LED_PWM_Halt(ch);
+
+  // 循环播放不开中断；单次播放只要结束时的 TC
+  DMA_SetCallback(d->dma, LED_PWM_OnEvent, NULL, loop ? 0U : DMA_EVT_TC);
+
+  cfg.PeriphBaseAddr = (uint32_t)d->ccr;
+  cfg.PeriphInc = DMA_Inc_Disable;
+  cfg.MemBaseAddr = (uint32_t)seq;
+  cfg.MemInc = DMA_Inc_Enable;
+  cfg.PeriphDataSize = DMA_DataSize_HalfWord;
+  cfg.MemDataSize = DMA_DataSize_HalfWord;
+  cfg.Direction = DMA_DIR_PeripheralDST_Mem2Per;
+  cfg.BufferSize = len;
+  cfg.Mode = loop ? DMA_Mode_Circular : DMA_Mode_Normal;
+  cfg.Priority = DMA_Priority_Low;
+  cfg.M2M = false;
+  if (DMA_StartTransfer(d->dma, &cfg) != DMA_MGR_OK) {
+    return LED_PWM_PARAM_ERROR;
+  }
+
+  s_playing[ch] = 1;
+  TIM2->DIER |= d->dier;
+  return LED_PWM_OK;
+}
+
+/**
+ * @brief  停止动画并熄灭
+ */
+void LED_PWM_Stop(LED_PWM_Channel_t ch) {
+  LED_PWM_SetDuty(ch, 0);
+}
+
+/**
+ * @brief  是否正在播放
+ */
+uint8_t LED_PWM_IsPlaying(LED_PWM_Channel_t ch) {
+  return (ch < LED_PWM_COUNT) ? s_playing[ch] : 0;
+}
+
+/**
+ * @brief  感知亮度转占空比
+ *         x^2.2 在 [0, 1] 上近似为 x^2 * (4 + x) / 5，两端精确，中间误差
+ *         小于满量程的 1%；255 * 255 * 1275 / 255 = 325125
+ */
+uint16_t LED_PWM_Gamma(uint8_t level) {
+  uint32_t l = level;
+
+  return (uint16_t)((l * l * (1020U + l) / 255U) * LED_PWM_PERIOD / 325125U);
+}
+
+/**
+ * @brief  呼吸序列
+ */
+void LED_PWM_Breathe(uint16_t *seq, uint16_t len) {
+  uint32_t half = len / 2U;
+
+  for (uint32_t i = 0; i < len; i++) {
+    uint32_t level;
+
+    if (i < half) {
+      level = 255U * i / half;
+    } else {
+      level = 255U * (len - i) / (len - half);
+    }
+    seq[i] = LED_PWM_Gamma((uint8_t)level);
+  }
+}
+
+/**
+ * @brief  渐变序列
+ */
+void LED_PWM_Fade(uint16_t *seq, uint16_t len, uint8_t from, uint8_t to) {
+  int32_t span = (int32_t)to - (int32_t)from;
+
+  for (uint32_t i = 0; i < len; i++) {
+    int32_t level = (len > 1U) ? from + span * (int32_t)i / (int32_t)(len - 1U) : to;
+    seq[i] = LED_PWM_Gamma((uint8_t)level);
+  }
+}
+
+/**
+ * @brief  闪烁序列
+ */
+void LED_PWM_Blink(uint16_t *seq, uint16_t len, uint16_t on, uint8_t level) {
+  uint16_t duty = LED_PWM_Gamma(level);
+
+  for (uint32_t i = 0; i < len; i++) {
+    seq[i] = (i < on) ? duty : 0U;
+  }
+}
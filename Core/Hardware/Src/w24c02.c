@@ -26,6 +26,8 @@
 #include "stdio.h"
 #include "stm32f1xx_hal.h"
 
+static int8_t w24c02_op_run(W24C02_Op_t *op);
+
 /**
  * @brief  W24C02初始化函数
  * @param  无
@@ -230,7 +232,7 @@ void register_W24C02_Init(void) {
  * @brief  使用寄存器方式向W24C02写入单个字节
  * @param  innerAddr: EEPROM内部地址 (0-255)
  * @param  byte: 要写入的数据字节
- * @retval 无
+ * @retval W24C02_OP_xxx 写入结果
  *
  * @description
  * 使用自定义I2C驱动函数向W24C02写入单个字节
@@ -244,29 +246,18 @@ void register_W24C02_Init(void) {
  * 5. STOP：发送停止条件，结束I2C通信
  * 
  * @note
- * - 使用自定义的Driver_I2C2_*系列函数进行底层I2C操作
- * - 每个步骤都会等待相应的应答信号
- * - 写入后必须等待5ms让EEPROM完成内部写周期
+ * - 启动非阻塞写入后原地轮询到结束，时序见 register_W24C02_Op_Poll()
+ * - 与协程中的操作一样先占用总线，写周期用应答轮询等待
  * - 在写周期期间，EEPROM不会响应任何I2C通信
  * 
  * @warning
  * 确保在调用此函数前已正确初始化I2C2接口
  */
-void register_W24C02_WriteByte(uint8_t innerAddr, uint8_t byte) {
-
-  Driver_I2C2_Start(); // 发送起始条件，开始I2C通信
+int8_t register_W24C02_WriteByte(uint8_t innerAddr, uint8_t byte) {
+  W24C02_Op_t op;
 
-  Driver_I2C_SendAddr(ADDR); // 发送设备地址（写模式0xA0）并等待EEPROM应答
-
-  Driver_I2C_SendByte(innerAddr); // 发送EEPROM内部存储地址
-  Driver_I2C2_ACK();              // 等待EEPROM对内部地址的应答
-
-  Driver_I2C_SendByte(byte); // 发送要写入的数据字节
-  Driver_I2C2_ACK();         // 等待EEPROM对数据的应答
-
-  Driver_I2C2_Stop(); // 发送停止条件，结束本次I2C通信
-
-  HAL_Delay(5); // 等待EEPROM完成内部写周期 (典型值5ms，最大可达10ms)
+  register_W24C02_WriteByte_Start(&op, innerAddr, byte);
+  return w24c02_op_run(&op);
 }
 
 /**
@@ -318,7 +309,7 @@ uint8_t register_W24C02_ReadByte(uint8_t innerAddr) {
   Driver_I2C2_ACK();             // 等待EEPROM对读地址的应答
 
   /* 读取数据字节 */
-  uint8_t timeout = 0xFFFF; // 设置超时计数器，防止无限等待
+  uint16_t timeout = 0xFFFF; // 设置超时计数器，防止无限等待
 
   /* 等待数据接收完成 */
   while (!(I2C2->SR1 & I2C_SR1_RXNE) && timeout) {
@@ -345,7 +336,7 @@ uint8_t register_W24C02_ReadByte(uint8_t innerAddr) {
  * @param  innerAddr: EEPROM内部起始地址 (0-255)
  * @param  bytes: 指向要写入数据的指针
  * @param  len: 要写入的字节数
- * @retval 无
+ * @retval W24C02_OP_xxx 写入结果
  *
  * @description
  * 使用自定义I2C驱动函数向W24C02写入多个字节数据
@@ -359,11 +350,10 @@ uint8_t register_W24C02_ReadByte(uint8_t innerAddr) {
  * 5. STOP：发送停止条件，结束I2C通信
  * 
  * @note
- * - 使用自定义的Driver_I2C2_*系列函数进行底层I2C操作
+ * - 启动非阻塞写入后原地轮询到结束，时序见 register_W24C02_Op_Poll()
  * - W24C02的页大小为8字节，超过8字节会回卷到页首
  * - 每个数据字节都会等待EEPROM的应答信号
- * - 写入后必须等待5ms让EEPROM完成内部写周期
- * - 在写周期期间，EEPROM不会响应任何I2C通信
+ * - 写周期用应答轮询等待，返回时数据已写入
  * 
  * @warning
  * - 跨页写入时，地址会自动回卷，可能导致数据覆盖
@@ -373,25 +363,12 @@ uint8_t register_W24C02_ReadByte(uint8_t innerAddr) {
  * @see
  * register_W24C02_WriteByte() - 单字节写入函数
  */
-void register_W24C02_WriteBytes(uint8_t innerAddr, uint8_t *bytes,
-                                uint8_t len) {
-  Driver_I2C2_Start(); // 发送起始条件，开始I2C通信
-
-  Driver_I2C_SendAddr(ADDR); // 发送设备地址（写模式0xA0）
-  Driver_I2C2_ACK();         // 等待EEPROM对设备地址的应答
-
-  Driver_I2C_SendByte(innerAddr); // 发送EEPROM起始地址
-  Driver_I2C2_ACK();              // 等待EEPROM对内部地址的应答
+int8_t register_W24C02_WriteBytes(uint8_t innerAddr, uint8_t *bytes,
+                                  uint8_t len) {
+  W24C02_Op_t op;
 
-  // 循环发送多个数据字节
-  for (uint8_t i = 0; i < len; i++) {
-    Driver_I2C_SendByte(bytes[i]); // 发送第i个数据字节
-    Driver_I2C2_ACK();             // 等待EEPROM对数据的应答
-  }
-
-  Driver_I2C2_Stop(); // 发送停止条件，结束本次I2C通信
-
-  HAL_Delay(5); // 等待EEPROM完成写周期 (典型值5ms，最大可达10ms)
+  register_W24C02_WriteBytes_Start(&op, innerAddr, bytes, len);
+  return w24c02_op_run(&op);
 }
 
 /**
@@ -474,3 +451,178 @@ void register_W24C02_ReadBytes(uint8_t innerAddr, uint8_t *bytes, uint8_t len) {
 
   Driver_I2C2_Stop(); // 发送停止条件，结束本次I2C通信
 }
+
+/* ========================== 非阻塞版本（协程） ========================== */
+
+/** 正在使用 I2C2 的操作，NULL 表示总线空闲 */
+static W24C02_Op_t *s_w24c02_owner = NULL;
+
+/**
+ * @brief  结束一个失败的操作：发送停止条件并释放总线
+ * @param  op: 操作上下文
+ * @param  status: 失败原因
+ * @retval 无
+ */
+static void w24c02_op_abort(W24C02_Op_t *op, int8_t status) {
+  I2C2->SR1 &= ~I2C_SR1_AF; // 清除应答失败标志
+  Driver_I2C2_Stop();
+  op->status = status;
+  s_w24c02_owner = NULL;
+}
+
+/**
+ * @brief  寻址子协程：起始条件 + 设备地址（写），结果在 op->acked
+ * @param  op: 操作上下文
+ * @retval 协程状态
+ *
+ * @details
+ * 与 Driver_I2C2_Start / Driver_I2C_SendAddr 的步骤相同，但等待 SB、ADDR
+ * 时让出CPU；EEPROM 处于写周期时不应答（AF 置位），此时发送停止条件释放总线，
+ * 由调用者决定是否重试（应答轮询）。超时使用整个操作的截止时间 op->pt。
+ */
+static int w24c02_select_pt(W24C02_Op_t *op) {
+  PT_BEGIN(&op->child);
+
+  op->acked = 0;
+  PT_WAIT_UNTIL(&op->child,
+                !(I2C2->CR1 & I2C_CR1_STOP) || pt_expired(&op->pt)); // 上一个停止条件已发出
+  I2C2->CR1 |= I2C_CR1_START; // 发送起始条件
+  PT_WAIT_UNTIL(&op->child, (I2C2->SR1 & I2C_SR1_SB) || pt_expired(&op->pt));
+  if (!(I2C2->SR1 & I2C_SR1_SB)) {
+    PT_EXIT(&op->child);
+  }
+
+  I2C2->DR = ADDR; // 设备地址（写模式0xA0）
+  PT_WAIT_UNTIL(&op->child, (I2C2->SR1 & (I2C_SR1_ADDR | I2C_SR1_AF)) ||
+                                pt_expired(&op->pt));
+  if (I2C2->SR1 & I2C_SR1_ADDR) {
+    volatile uint32_t temp = I2C2->SR2; // 读取SR2清除ADDR标志
+    (void)temp;
+    op->acked = 1;
+  } else {
+    I2C2->SR1 &= ~I2C_SR1_AF; // 未应答：清除AF并释放总线
+    Driver_I2C2_Stop();
+  }
+
+  PT_END(&op->child);
+}
+
+/**
+ * @brief  启动非阻塞的单字节写入 (寄存器版本)
+ * @param  op: 操作上下文
+ * @param  innerAddr: EEPROM内部地址 (0-255)
+ * @param  byte: 要写入的数据字节
+ * @retval 无
+ */
+void register_W24C02_WriteByte_Start(W24C02_Op_t *op, uint8_t innerAddr,
+                                     uint8_t byte) {
+  op->byte = byte;
+  register_W24C02_WriteBytes_Start(op, innerAddr, &op->byte, 1);
+}
+
+/**
+ * @brief  启动非阻塞的页写入 (寄存器版本)
+ * @param  op: 操作上下文
+ * @param  innerAddr: EEPROM内部起始地址 (0-255)
+ * @param  bytes: 要写入的数据，操作结束前必须保持有效
+ * @param  len: 要写入的字节数
+ * @retval 无
+ */
+void register_W24C02_WriteBytes_Start(W24C02_Op_t *op, uint8_t innerAddr,
+                                      const uint8_t *bytes, uint8_t len) {
+  PT_INIT(&op->pt);
+  op->status = W24C02_OP_BUSY;
+  op->acked = 0;
+  op->innerAddr = innerAddr;
+  op->bytes = bytes;
+  op->len = len;
+  op->index = 0;
+}
+
+/**
+ * @brief  推进一个已启动的写操作
+ * @param  op: 操作上下文
+ * @retval PT_WAITING 表示进行中，其余值表示已结束，结果在 op->status
+ *
+ * @details
+ * 时序：
+ * 1. 等待总线空闲并占用
+ * 2. START + 设备地址（器件忙时应答轮询）
+ * 3. 内部地址和数据，每个字节等待 TXE 时让出
+ * 4. 等待最后一个字节发送完成（BTF）后 STOP
+ * 5. 写周期：应答轮询代替固定的 HAL_Delay(5)，器件应答即写入完成
+ */
+int register_W24C02_Op_Poll(W24C02_Op_t *op) {
+  if (op->status != W24C02_OP_BUSY) {
+    return PT_ENDED; // 已结束的操作再调用不会重新执行
+  }
+
+  PT_BEGIN(&op->pt);
+
+  /* 1. 占用总线，整个操作共用一个截止时间 */
+  PT_WAIT_UNTIL(&op->pt, s_w24c02_owner == NULL);
+  s_w24c02_owner = op;
+  PT_DEADLINE(&op->pt, W24C02_OP_TIMEOUT_MS);
+
+  /* 2. 寻址（应答轮询） */
+  for (;;) {
+    PT_SPAWN(&op->pt, &op->child, w24c02_select_pt(op));
+    if (op->acked || pt_expired(&op->pt)) {
+      break;
+    }
+    PT_YIELD(&op->pt);
+  }
+  if (!op->acked) {
+    w24c02_op_abort(op, W24C02_OP_TIMEOUT);
+    PT_EXIT(&op->pt);
+  }
+
+  /* 3. 内部地址和数据 */
+  I2C2->DR = op->innerAddr;
+  for (op->index = 0; op->index < op->len; op->index++) {
+    PT_AWAIT(&op->pt, I2C2->SR1 & (I2C_SR1_TXE | I2C_SR1_AF));
+    if (!(I2C2->SR1 & I2C_SR1_TXE)) {
+      w24c02_op_abort(op, op->pt.timed_out ? W24C02_OP_TIMEOUT : W24C02_OP_NACK);
+      PT_EXIT(&op->pt);
+    }
+    I2C2->DR = op->bytes[op->index];
+  }
+
+  /* 4. 最后一个字节发送完成后发送停止条件，EEPROM 开始写周期 */
+  PT_AWAIT(&op->pt, I2C2->SR1 & (I2C_SR1_BTF | I2C_SR1_AF));
+  if (!(I2C2->SR1 & I2C_SR1_BTF)) {
+    w24c02_op_abort(op, op->pt.timed_out ? W24C02_OP_TIMEOUT : W24C02_OP_NACK);
+    PT_EXIT(&op->pt);
+  }
+  Driver_I2C2_Stop();
+
+  /* 5. 写周期：器件重新应答时写入完成 */
+  for (;;) {
+    PT_YIELD(&op->pt);
+    PT_SPAWN(&op->pt, &op->child, w24c02_select_pt(op));
+    if (op->acked || pt_expired(&op->pt)) {
+      break;
+    }
+  }
+  if (!op->acked) {
+    w24c02_op_abort(op, W24C02_OP_TIMEOUT);
+    PT_EXIT(&op->pt);
+  }
+  Driver_I2C2_Stop();
+  op->status = W24C02_OP_OK;
+  s_w24c02_owner = NULL;
+
+  PT_END(&op->pt);
+}
+
+/**
+ * @brief  把一个已启动的写操作轮询到结束（阻塞版本写入的实现）
+ * @param  op: 操作上下文
+ * @retval op->status
+ * @note   超时按 HAL 节拍计算，调用时 SysTick 必须在运行
+ */
+static int8_t w24c02_op_run(W24C02_Op_t *op) {
+  while (PT_RUNNING(register_W24C02_Op_Poll(op))) {
+  }
+  return op->status;
+}
@@ -14,6 +14,7 @@
 
 #include "w25q32.h"
 #include "spi.h" // 包含项目自定义的SPI头文件
+#include "crc32.h"
 
 //======================================================================
 //        硬件适配层: SPI底层功能实现
@@ -45,6 +46,17 @@ static uint8_t SPI_TransmitReceive(uint8_t byte) {
     return Hal_SPI_SwapByte(byte); // 映射到项目中的 Hal_SPI_SwapByte() 函数。
 }
 
+/**
+ * @brief  连续接收一块数据 (发送 0xFF)。
+ * @param  data 接收缓冲区。
+ * @param  size 字节数。
+ * @return W25Q32_Status_t SPI 接收溢出或超时时返回 W25Q32_ERROR，数据不完整。
+ * @note   这是适配层的一部分，映射到在 RAM 中运行的 Register_SPI_ReadBlock()。
+ */
+static W25Q32_Status_t SPI_ReceiveBlock(uint8_t *data, uint16_t size) {
+    return (Register_SPI_ReadBlock(data, size) == HAL_OK) ? W25Q32_OK : W25Q32_ERROR;
+}
+
 
 //======================================================================
 //                内部辅助函数的声明 (Private Helper Prototypes)
@@ -52,12 +64,14 @@ static uint8_t SPI_TransmitReceive(uint8_t byte) {
 
 // 发送“写使能”指令
 static void W25Q32_WriteEnable(void);
-// 发送“写失能”指令
-static void W25Q32_WriteDisable(void);
 // 读取状态寄存器1
 static uint8_t W25Q32_ReadStatusRegister1(void);
 // 等待Flash内部操作完成，防止在擦写过程中执行新指令
 static W25Q32_Status_t W25Q32_WaitForWriteEnd(void);
+// 读一次状态寄存器，判断芯片是否空闲 (非阻塞版本的等待条件)
+static int W25Q32_IsIdle(void);
+// 把一个已启动的非阻塞操作轮询到结束 (阻塞版本擦写的实现)
+static W25Q32_Status_t W25Q32_Op_Run(W25Q32_Op_t *op);
 
 
 //======================================================================
@@ -140,30 +154,26 @@ W25Q32_Status_t W25Q32_ChipErase(void) {
  * @brief  擦除一个4KB的扇区。
  * @param  sector_num 要擦除的扇区号 (对于W25Q32是 0-1023)。
  * @return W25Q32_Status_t 操作状态码。
+ * @note   启动非阻塞擦除后原地轮询到结束，与协程中的操作一样按占用顺序排队。
  */
 W25Q32_Status_t W25Q32_SectorErase_4KB(uint32_t sector_num) {
-    // 1. 校验扇区号是否在有效范围内。
-    if (sector_num >= (W25Q32_TOTAL_SIZE_BYTES / W25Q32_SECTOR_SIZE)) {
-        return W25Q32_INVALID_PARAM;
-    }
-    // 2. 等待上一个操作完成。
-    if (W25Q32_WaitForWriteEnd() != W25Q32_OK) return W25Q32_TIMEOUT;
-    // 3. 使能写入。
-    W25Q32_WriteEnable();
+    W25Q32_Op_t op;
+    W25Q32_Status_t status = W25Q32_SectorErase_4KB_Start(&op, sector_num);
 
-    // 4. 计算目标地址 (扇区号 * 4096)。
-    uint32_t address = sector_num * W25Q32_SECTOR_SIZE;
-    
-    // 5. 发送指令和地址。
-    SPI_CS_Select();
-    SPI_TransmitReceive(W25Q32_CMD_SECTOR_ERASE_4KB);   // 发送 0x20 扇区擦除指令。
-    SPI_TransmitReceive((address >> 16) & 0xFF);     // 发送地址的高8位。
-    SPI_TransmitReceive((address >> 8) & 0xFF);      // 发送地址的中8位。
-    SPI_TransmitReceive(address & 0xFF);             // 发送地址的低8位。
-    SPI_CS_Deselect();
-    
-    // 6. 等待本次擦除操作完成。
-    return W25Q32_WaitForWriteEnd();
+    return (status != W25Q32_OK) ? status : W25Q32_Op_Run(&op);
+}
+
+/**
+ * @brief  擦除一个64KB的块。
+ * @param  block_num 要擦除的块号 (0-63)。
+ * @return W25Q32_Status_t 操作状态码。
+ * @note   启动非阻塞擦除后原地轮询到结束，与协程中的操作一样按占用顺序排队。
+ */
+W25Q32_Status_t W25Q32_BlockErase_64KB(uint32_t block_num) {
+    W25Q32_Op_t op;
+    W25Q32_Status_t status = W25Q32_BlockErase_64KB_Start(&op, block_num);
+
+    return (status != W25Q32_OK) ? status : W25Q32_Op_Run(&op);
 }
 
 /**
@@ -173,44 +183,14 @@ W25Q32_Status_t W25Q32_SectorErase_4KB(uint32_t sector_num) {
  * @param  data           指向要写入数据的指针。
  * @param  size           要写入的字节数。
  * @return W25Q32_Status_t 操作状态码。
+ * @note   启动非阻塞编程后原地轮询到结束，与协程中的操作一样按占用顺序排队。
  */
 W25Q32_Status_t W25Q32_PageProgram(uint32_t page_num, uint16_t offset_in_page, uint8_t *data, uint32_t size) {
-    // 1. 校验所有参数是否合法。
-    if (page_num >= (W25Q32_TOTAL_SIZE_BYTES / W25Q32_PAGE_SIZE) || offset_in_page >= W25Q32_PAGE_SIZE || data == 0) {
-        return W25Q32_INVALID_PARAM;
-    }
-    // 2. 如果要写入的数据长度超过了当前页的剩余空间，则自动截断，防止写到下一页。
-    if (size > W25Q32_PAGE_SIZE - offset_in_page) {
-        size = W25Q32_PAGE_SIZE - offset_in_page;
-    }
-    // 3. 如果要写入的长度为0，直接返回成功。
-    if (size == 0) {
-        return W25Q32_OK;
-    }
-
-    // 4. 等待空闲并使能写入。
-    if (W25Q32_WaitForWriteEnd() != W25Q32_OK) return W25Q32_TIMEOUT;
-    W25Q32_WriteEnable();
-
-    // 5. 计算绝对物理地址。
-    uint32_t address = (page_num * W25Q32_PAGE_SIZE) + offset_in_page;
-    
-    // 6. 发送指令和地址。
-    SPI_CS_Select();
-    SPI_TransmitReceive(W25Q32_CMD_PAGE_PROGRAM);    // 发送 0x02 页编程指令。
-    SPI_TransmitReceive((address >> 16) & 0xFF);   // 发送地址的高8位。
-    SPI_TransmitReceive((address >> 8) & 0xFF);    // 发送地址的中8位。
-    SPI_TransmitReceive(address & 0xFF);           // 发送地址的低8位。
-
-    // 7. 循环发送要写入的数据。
-    for (uint32_t i = 0; i < size; i++) {
-        SPI_TransmitReceive(data[i]);
-    }
+    // 参数校验、超过页剩余空间时截断、长度为0直接成功，都由非阻塞版本处理。
+    W25Q32_Op_t op;
+    W25Q32_Status_t status = W25Q32_PageProgram_Start(&op, page_num, offset_in_page, data, size);
 
-    SPI_CS_Deselect();
-    
-    // 8. 等待写入操作完成。
-    return W25Q32_WaitForWriteEnd();
+    return (status != W25Q32_OK) ? status : W25Q32_Op_Run(&op);
 }
 
 /**
@@ -249,27 +229,230 @@ W25Q32_Status_t W25Q32_ReadData(uint32_t address, uint8_t *data, uint32_t size)
 }
 
 
+/**
+ * @brief  选中芯片并发送读数据指令和地址。
+ */
+static void W25Q32_ReadCommand(uint32_t address) {
+    SPI_CS_Select();
+    SPI_TransmitReceive(W25Q32_CMD_READ_DATA);
+    SPI_TransmitReceive((address >> 16) & 0xFF);
+    SPI_TransmitReceive((address >> 8) & 0xFF);
+    SPI_TransmitReceive(address & 0xFF);
+}
+
+/**
+ * @brief  计算Flash区域的CRC-32，数据只经过一个分块缓冲区。
+ * @param  address 起始地址。
+ * @param  size    字节数。
+ * @param  crc     输出CRC值，与对同样数据调用 crc32_compute() 的结果相同。
+ * @return W25Q32_Status_t CRC单元正被占用时返回 W25Q32_BUSY；
+ *         同一块连续 W25Q32_SPI_RETRIES 次发生 SPI 错误时返回 W25Q32_ERROR。
+ * @note   按块读取，每块读完后由 DMA 送入CRC单元（没有调用 crc32_init() 时
+ *         改由CPU送数），送数完成后才读下一块：块读取不关中断，送数完成中断
+ *         如果落在块读取期间会造成接收溢出。某一块接收溢出时重新发送读指令，
+ *         从这一块的地址接着读，已送入CRC单元的数据不受影响。
+ *         只有最后一块可能不是4的倍数。
+ */
+W25Q32_Status_t W25Q32_ReadCRC(uint32_t address, uint32_t size, uint32_t *crc) {
+    static uint32_t chunk[W25Q32_CRC_CHUNK_SIZE / 4]; // 按字对齐，供DMA按字读取。
+    uint32_t retries = 0;
+
+    // 1. 参数校验。
+    if (address + size > W25Q32_TOTAL_SIZE_BYTES || crc == 0) {
+        return W25Q32_INVALID_PARAM;
+    }
+    if (crc32_busy()) {
+        return W25Q32_BUSY;
+    }
+
+    // 2. 等待芯片空闲。
+    if (W25Q32_WaitForWriteEnd() != W25Q32_OK) return W25Q32_TIMEOUT;
+
+    // 3. 发送指令和地址。
+    crc32_reset();
+    W25Q32_ReadCommand(address);
+
+    // 4. 分块读取并送入CRC单元，SPI 出错时从出错的块重新发起读指令。
+    while (size > 0) {
+        uint32_t n = (size > W25Q32_CRC_CHUNK_SIZE) ? W25Q32_CRC_CHUNK_SIZE : size;
+
+        if (SPI_ReceiveBlock((uint8_t *)chunk, (uint16_t)n) != W25Q32_OK) {
+            SPI_CS_Deselect();
+            if (++retries >= W25Q32_SPI_RETRIES) {
+                return W25Q32_ERROR;
+            }
+            W25Q32_ReadCommand(address);
+            continue;
+        }
+        retries = 0;
+        if (crc32_feed_dma(chunk, n, 0, 0) != CRC32_OK) {
+            crc32_feed(chunk, n);
+        }
+        while (crc32_busy()) {
+        }
+        address += n;
+        size -= n;
+    }
+    SPI_CS_Deselect();
+
+    *crc = crc32_value();
+    return W25Q32_OK;
+}
+
 //======================================================================
-//                 内部辅助函数的实现 (Private Helper Implementations)
+//              非阻塞擦写 (Protothread Operations)
 //======================================================================
 
+// 从写使能到 BUSY 清除占用芯片的操作，NULL 表示芯片空闲。
+// BUSY 是整片的状态，不属于某个操作：不加锁时后轮询的操作会在别人的
+// 擦写期间等空闲，用自己的预算计时而误判超时。
+static W25Q32_Op_t *s_w25q32_owner = 0;
+
 /**
- * @brief  发送“写使能”指令 (0x06)。
- * @note   在每次擦除或写入操作之前，都必须先发送此指令。
+ * @brief  启动非阻塞的4KB扇区擦除。
+ * @param  op         操作上下文。
+ * @param  sector_num 要擦除的扇区号 (0-1023)。
+ * @return W25Q32_Status_t 参数错误时返回 W25Q32_INVALID_PARAM，操作不会启动。
  */
-static void W25Q32_WriteEnable(void) {
+W25Q32_Status_t W25Q32_SectorErase_4KB_Start(W25Q32_Op_t *op, uint32_t sector_num) {
+    if (op == 0 || sector_num >= (W25Q32_TOTAL_SIZE_BYTES / W25Q32_SECTOR_SIZE)) {
+        return W25Q32_INVALID_PARAM;
+    }
+    PT_INIT(&op->pt);
+    op->status = W25Q32_BUSY;
+    op->cmd = W25Q32_CMD_SECTOR_ERASE_4KB;
+    op->address = sector_num * W25Q32_SECTOR_SIZE;
+    op->data = 0;
+    op->size = 0;
+    op->timeout_ms = W25Q32_SE_TIMEOUT_MS;
+    return W25Q32_OK;
+}
+
+/**
+ * @brief  启动非阻塞的64KB块擦除。
+ * @param  op        操作上下文。
+ * @param  block_num 要擦除的块号 (0-63)。
+ * @return W25Q32_Status_t 参数错误时返回 W25Q32_INVALID_PARAM，操作不会启动。
+ */
+W25Q32_Status_t W25Q32_BlockErase_64KB_Start(W25Q32_Op_t *op, uint32_t block_num) {
+    if (op == 0 || block_num >= (W25Q32_TOTAL_SIZE_BYTES / W25Q32_BLOCK_64K_SIZE)) {
+        return W25Q32_INVALID_PARAM;
+    }
+    PT_INIT(&op->pt);
+    op->status = W25Q32_BUSY;
+    op->cmd = W25Q32_CMD_BLOCK_ERASE_64KB;
+    op->address = block_num * W25Q32_BLOCK_64K_SIZE;
+    op->data = 0;
+    op->size = 0;
+    op->timeout_ms = W25Q32_BE64_TIMEOUT_MS;
+    return W25Q32_OK;
+}
+
+/**
+ * @brief  启动非阻塞的页编程，参数规则与 W25Q32_PageProgram 相同。
+ * @param  op             操作上下文。
+ * @param  page_num       要写入的页号 (0-16383)。
+ * @param  offset_in_page 页内偏移地址 (0-255)。
+ * @param  data           要写入的数据，操作结束前必须保持有效。
+ * @param  size           要写入的字节数，超过页剩余空间时截断。
+ * @return W25Q32_Status_t 参数错误时返回 W25Q32_INVALID_PARAM，操作不会启动。
+ */
+W25Q32_Status_t W25Q32_PageProgram_Start(W25Q32_Op_t *op, uint32_t page_num, uint16_t offset_in_page,
+                                         const uint8_t *data, uint32_t size) {
+    if (op == 0 || page_num >= (W25Q32_TOTAL_SIZE_BYTES / W25Q32_PAGE_SIZE) ||
+        offset_in_page >= W25Q32_PAGE_SIZE || data == 0) {
+        return W25Q32_INVALID_PARAM;
+    }
+    if (size > W25Q32_PAGE_SIZE - offset_in_page) {
+        size = W25Q32_PAGE_SIZE - offset_in_page;
+    }
+    PT_INIT(&op->pt);
+    op->status = W25Q32_BUSY;
+    op->cmd = W25Q32_CMD_PAGE_PROGRAM;
+    op->address = (page_num * W25Q32_PAGE_SIZE) + offset_in_page;
+    op->data = data;
+    op->size = size;
+    op->timeout_ms = W25Q32_PP_TIMEOUT_MS;
+    return W25Q32_OK;
+}
+
+/**
+ * @brief  推进一个已启动的擦写操作 (协程)。
+ * @param  op 操作上下文。
+ * @return PT_WAITING 表示还在等芯片，其余值表示已结束，结果在 op->status。
+ * @note   步骤：等空闲 -> 写使能 -> 指令+地址(+数据) -> 等空闲。
+ *         两次等待都只读一次状态寄存器就返回，不占用CPU；
+ *         先占用芯片再等空闲，直到本操作的 BUSY 清除才释放，多个操作按
+ *         占用顺序轮流执行，超时只计本操作自己的等待时间。
+ *         操作一旦启动必须轮询到结束，否则芯片一直被占用。
+ */
+int W25Q32_Op_Poll(W25Q32_Op_t *op) {
+    // 已结束的操作再调用不会重新执行。
+    if (op->status != W25Q32_BUSY) {
+        return PT_ENDED;
+    }
+
+    PT_BEGIN(&op->pt);
+
+    if (op->size == 0 && op->cmd == W25Q32_CMD_PAGE_PROGRAM) {
+        op->status = W25Q32_OK;
+        PT_EXIT(&op->pt);
+    }
+
+    // 1. 占用芯片 (等其他操作结束)，再等不经过占用的整片擦除完成。
+    PT_WAIT_UNTIL(&op->pt, s_w25q32_owner == 0);
+    s_w25q32_owner = op;
+    PT_AWAIT_TIMEOUT(&op->pt, W25Q32_IsIdle(), W25Q32_IDLE_TIMEOUT_MS);
+    if (op->pt.timed_out) {
+        op->status = W25Q32_TIMEOUT;
+        s_w25q32_owner = 0;
+        PT_EXIT(&op->pt);
+    }
+
+    // 2. 写使能后发送指令和地址，页编程再发送数据。
+    W25Q32_WriteEnable();
     SPI_CS_Select();
-    SPI_TransmitReceive(W25Q32_CMD_WRITE_ENABLE);
+    SPI_TransmitReceive(op->cmd);
+    SPI_TransmitReceive((op->address >> 16) & 0xFF);
+    SPI_TransmitReceive((op->address >> 8) & 0xFF);
+    SPI_TransmitReceive(op->address & 0xFF);
+    for (uint32_t i = 0; i < op->size; i++) {
+        SPI_TransmitReceive(op->data[i]);
+    }
     SPI_CS_Deselect();
+
+    // 3. 等待芯片内部擦写完成。
+    PT_AWAIT_TIMEOUT(&op->pt, W25Q32_IsIdle(), op->timeout_ms);
+    op->status = op->pt.timed_out ? W25Q32_TIMEOUT : W25Q32_OK;
+    s_w25q32_owner = 0;
+
+    PT_END(&op->pt);
+}
+
+/**
+ * @brief  把一个已启动的操作轮询到结束。
+ * @param  op 操作上下文。
+ * @return W25Q32_Status_t 操作结果 (op->status)。
+ * @note   超时按 HAL 节拍计算，调用时 SysTick 必须在运行。
+ */
+static W25Q32_Status_t W25Q32_Op_Run(W25Q32_Op_t *op) {
+    while (PT_RUNNING(W25Q32_Op_Poll(op))) {
+    }
+    return op->status;
 }
 
+
+//======================================================================
+//                 内部辅助函数的实现 (Private Helper Implementations)
+//======================================================================
+
 /**
- * @brief  发送“写失能”指令 (0x04)。
- * @note   通常在写操作完成后调用，以保护Flash数据不被意外改写。
+ * @brief  发送“写使能”指令 (0x06)。
+ * @note   在每次擦除或写入操作之前，都必须先发送此指令。
  */
-static void W25Q32_WriteDisable(void) {
+static void W25Q32_WriteEnable(void) {
     SPI_CS_Select();
-    SPI_TransmitReceive(W25Q32_CMD_WRITE_DISABLE);
+    SPI_TransmitReceive(W25Q32_CMD_WRITE_ENABLE);
     SPI_CS_Deselect();
 }
 
@@ -286,6 +469,14 @@ static uint8_t W25Q32_ReadStatusRegister1(void) {
     return reg_val;
 }
 
+/**
+ * @brief  读一次状态寄存器，判断芯片是否空闲。
+ * @return int: 1 表示空闲 (BUSY位为0)。
+ */
+static int W25Q32_IsIdle(void) {
+    return (W25Q32_ReadStatusRegister1() & W25Q32_SR1_BUSY_BIT) == 0;
+}
+
 /**
  * @brief  等待Flash内部操作完成 (通过轮询状态寄存器的BUSY位)。
  * @return W25Q32_Status_t 操作状态码 (W25Q32_OK 或 W25Q32_TIMEOUT)。
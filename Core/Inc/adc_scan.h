@@ -0,0 +1,159 @@
+/**
+ * @file    adc_scan.h
+ * @brief   ADC 定时触发扫描采集（DMA 循环双缓冲、按块回调、块统计）头文件
+ * @date    2026-10-18
+ *
+ * @note    - TIM3 按 rate_hz 产生更新事件，TRGO 触发 ADC1 对规则序列中的
+ *            通道做一次扫描；每次转换结束由 DMA1 通道 1（ADC1 固定使用）
+ *            以循环模式写入缓冲区，采样按 [扫描][通道] 交错排列；
+ *          - 缓冲区分成两块，每块 block_scans 次扫描：半传输中断交出前一块，
+ *            传输完成中断交出后一块，DMA 同时写另一块，CPU 只在每块结束时
+ *            进一次中断；回调必须在下一块写满之前返回；
+ *          - 双 ADC 规则同步模式：ADC2 与 ADC1 同时转换 channels2 中对应位置
+ *            的通道，ADC1_DR 高 16 位为 ADC2 结果，DMA 按字搬运，缓冲区
+ *            元素为 uint32_t；
+ *          - 一次扫描耗时约 通道数 × (采样时间 + 12.5) / 12 MHz（ADC 时钟
+ *            PCLK2 / 6），必须小于 1 / rate_hz；
+ *          - adc_stats_compute 用整数运算（64 位平方和累加）计算一段采样的
+ *            最小 / 最大 / 均值 / RMS / 交流 RMS，可在块回调里直接使用；
+ *          - DMA1 通道 1 留给 ADC1：dma_mem 默认用 DMA2 通道 2，两者可以
+ *            同时使用；通道被其他驱动占用时 adc_scan_init 返回 ADC_SCAN_BUSY。
+ */
+
+#ifndef __ADC_SCAN_H__
+#define __ADC_SCAN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_manager.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  一块采样（回调期间有效）
+ */
+typedef struct {
+    const void *data;  /*!< uint16_t[scans][channels]，双 ADC 时为 uint32_t */
+    uint16_t scans;    /*!< 扫描次数（= block_scans） */
+    uint8_t channels;  /*!< 每次扫描的通道数 */
+    uint8_t dual;      /*!< 是否双 ADC */
+    uint32_t index;    /*!< 块序号，从 0 开始 */
+} adc_scan_block_t;
+
+/**
+ * @brief  块回调（DMA 中断上下文）
+ */
+typedef void (*adc_scan_callback_t)(const adc_scan_block_t *block, void *ctx);
+
+/**
+ * @brief  采集配置
+ */
+typedef struct {
+    const uint8_t *channels;  /*!< ADC1 规则序列（通道号 0~17） */
+    const uint8_t *channels2; /*!< 双 ADC 时 ADC2 的规则序列，NULL 为单 ADC */
+    uint8_t num_channels;     /*!< 序列长度 1~16 */
+    uint8_t sample_time;      /*!< 采样时间编码 0~7（ADC_SMPR） */
+    uint16_t block_scans;     /*!< 每块扫描次数 */
+    uint32_t rate_hz;         /*!< 扫描频率 */
+    void *buffer;             /*!< 2 × block_scans × num_channels 个元素 */
+    adc_scan_callback_t cb;   /*!< 块回调 */
+    void *ctx;                /*!< 回调上下文 */
+} adc_scan_config_t;
+
+/**
+ * @brief  一段采样的统计结果（ADC 码值）
+ */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean;   /*!< 均值（四舍五入） */
+    uint16_t rms;    /*!< 均方根 */
+    uint16_t ac_rms; /*!< 去掉均值后的均方根（标准差） */
+} adc_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** ADC1 的 DMA 请求固定在 DMA1 通道 1 */
+#define ADC_SCAN_DMA_CHANNEL DMA_CH_DMA1_1
+
+/** TIM3 计数时钟（APB1 x2） */
+#define ADC_SCAN_TIM_CLK 72000000UL
+
+/** 返回值定义 */
+#define ADC_SCAN_OK 0           /*!< 成功 */
+#define ADC_SCAN_BUSY -1        /*!< DMA 通道已被占用或正在采集 */
+#define ADC_SCAN_PARAM_ERROR -2 /*!< 参数错误或未初始化 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  打开 ADC1 / ADC2 / TIM3 时钟，上电并校准，占用 DMA 通道
+ * @retval ADC_SCAN_OK / ADC_SCAN_BUSY
+ * @note   需在 DMA_Manager_Init() 之后调用；模拟输入引脚由调用者配置
+ */
+int adc_scan_init(void);
+
+/**
+ * @brief  停止采集，ADC 断电，释放 DMA 通道
+ */
+void adc_scan_deinit(void);
+
+/**
+ * @brief  按配置开始采集
+ * @param  cfg: 配置，调用后可以释放；buffer 在停止前保持有效
+ * @retval ADC_SCAN_OK / ADC_SCAN_BUSY / ADC_SCAN_PARAM_ERROR
+ */
+int adc_scan_start(const adc_scan_config_t *cfg);
+
+/**
+ * @brief  停止采集（不再回调）
+ */
+void adc_scan_stop(void);
+
+/**
+ * @brief  是否正在采集
+ */
+uint8_t adc_scan_running(void);
+
+/**
+ * @brief  已交出的块数
+ */
+uint32_t adc_scan_blocks(void);
+
+/**
+ * @brief  块丢失次数：半传输与传输完成在同一次中断中出现，说明中断
+ *         被推迟了半个缓冲区以上，前一块已被覆盖
+ */
+uint32_t adc_scan_overruns(void);
+
+/**
+ * @brief  统计一段采样
+ * @param  data: 第一个采样
+ * @param  count: 采样数，为 0 时各项输出 0
+ * @param  stride: 相邻采样的间隔（uint16_t 个数）
+ * @param  st: 输出
+ */
+void adc_stats_compute(const uint16_t *data, uint32_t count, uint32_t stride,
+                       adc_stats_t *st);
+
+/**
+ * @brief  统计块中一个通道
+ * @param  block: 块
+ * @param  index: 通道在序列中的位置
+ * @param  adc: 1 为 ADC1，2 为 ADC2（仅双 ADC）
+ * @param  st: 输出
+ */
+void adc_scan_block_stats(const adc_scan_block_t *block, uint8_t index, uint8_t adc,
+                          adc_stats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ADC_SCAN_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,147 @@
+/**
+ * @file    bench.h
+ * @brief   周期级基准测试框架头文件
+ * @date    2026-10-18
+ *
+ * @note    - 以 DWT->CYCCNT 计时（单位：CPU 周期）；主机构建中 DWT 由
+ *            仿真器提供，按虚拟时钟计数，同一份基准代码可在两端运行；
+ *            主机构建定义 BENCH_HOST_CLOCK 时（CMake 选项
+ *            HOST_BENCH_CLOCK_GETTIME）改用 clock_gettime 计时（单位：ns），
+ *            测量的是代码在主机上的实际耗时；
+ *          - bench_run 先预热若干次，再重复测量，给出最小值 / 中位数 / 最大值；
+ *          - 每个样本都已减去校准得到的测量开销（空函数一次调用的最小耗时）；
+ *          - bench_report 输出一行 CSV，以 "BENCH," 开头，便于主机脚本从
+ *            USART1 日志中筛选：
+ *            BENCH,<name>,<unit>,<reps>,<min>,<median>,<max>,<overhead>,<bytes_per_s>
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 单次 bench_run 最多保存的样本数 */
+#ifndef BENCH_MAX_REPS
+#define BENCH_MAX_REPS 64
+#endif
+
+/** 默认预热次数与重复次数 */
+#define BENCH_DEFAULT_WARMUP 2
+#define BENCH_DEFAULT_REPS 15
+
+/** 配置标志 */
+#define BENCH_FLAG_IRQ_OFF 0x01U /*!< 测量期间关中断（被测代码不能依赖中断） */
+
+/** 返回值定义 */
+#define BENCH_OK 0           /*!< 成功 */
+#define BENCH_PARAM_ERROR -1 /*!< 参数错误 */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  被测函数
+ * @param  arg: bench_run 传入的参数
+ */
+typedef void (*bench_fn_t)(void *arg);
+
+/**
+ * @brief  基准配置
+ */
+typedef struct {
+    const char *name; /*!< 名称（出现在报告中，不要包含逗号） */
+    uint32_t warmup;  /*!< 预热次数（不计入统计） */
+    uint32_t reps;    /*!< 重复次数，1-BENCH_MAX_REPS，0 表示默认值 */
+    uint32_t bytes;   /*!< 每次处理的字节数，用于计算速率（0 表示不计算） */
+    uint32_t flags;   /*!< BENCH_FLAG_xxx */
+} bench_config_t;
+
+/**
+ * @brief  基准结果（单位见 bench_unit()）
+ */
+typedef struct {
+    const char *name;
+    uint32_t reps;
+    uint32_t min;
+    uint32_t median;
+    uint32_t max;
+    uint32_t overhead;    /*!< 已从每个样本中扣除的测量开销 */
+    uint32_t bytes;
+    uint32_t bytes_per_s; /*!< 按中位数计算的速率，bytes 为 0 时为 0 */
+} bench_result_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化计时器并校准测量开销
+ * @note   使能 DWT 周期计数器（BENCH_HOST_CLOCK 时不需要）；可重复调用
+ */
+void bench_init(void);
+
+/**
+ * @brief  读取当前计时值
+ * @retval 周期数（DWT）或纳秒（BENCH_HOST_CLOCK），按 32 位回绕，只用于求差
+ */
+uint32_t bench_now(void);
+
+/**
+ * @brief  计时器频率
+ * @retval 每秒计数值
+ */
+uint32_t bench_freq(void);
+
+/**
+ * @brief  计时单位名称
+ * @retval "cycles" 或 "ns"
+ */
+const char *bench_unit(void);
+
+/**
+ * @brief  校准得到的测量开销
+ */
+uint32_t bench_overhead(void);
+
+/**
+ * @brief  运行一个基准
+ * @param  cfg: 配置
+ * @param  fn: 被测函数
+ * @param  arg: 传给被测函数的参数
+ * @param  result: 输出结果
+ * @retval BENCH_OK / BENCH_PARAM_ERROR
+ */
+int bench_run(const bench_config_t *cfg, bench_fn_t fn, void *arg,
+              bench_result_t *result);
+
+/**
+ * @brief  由一组已测得的样本计算统计值（样本会被排序）
+ * @param  name: 名称
+ * @param  samples: 样本数组
+ * @param  count: 样本数（非 0）
+ * @param  bytes: 每次处理的字节数
+ * @param  result: 输出结果
+ * @note   用于被测代码无法包装成 bench_fn_t 的场景（如中断里打的时间戳）
+ */
+void bench_stats(const char *name, uint32_t *samples, uint32_t count,
+                 uint32_t bytes, bench_result_t *result);
+
+/**
+ * @brief  输出 CSV 表头行
+ */
+void bench_report_header(void);
+
+/**
+ * @brief  输出一行 CSV 结果
+ */
+void bench_report(const bench_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BENCH_H__ */
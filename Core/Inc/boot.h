@@ -0,0 +1,177 @@
+/**
+ * @file    boot.h
+ * @brief   串口升级引导程序（USART1 流式接收、W25Q32 暂存、CRC 校验后写入内部 Flash）头文件
+ * @date    2026-10-18
+ *
+ * @note    - 片内 Flash 前 32 KB 留给引导程序，应用从 BOOT_APP_BASE 开始；
+ *            W25Q32 的最后 512 KB 是暂存区：第一个扇区存放镜像头，镜像
+ *            从 BOOT_STAGE_IMAGE 开始；
+ *          - 接收：USART1 以 BOOT_BAUD 工作，RX 由 DMA1 通道 5 循环写入
+ *            环形缓冲区，boot_poll 按 CNDTR 取出新字节解析，不产生中断；
+ *            应答直接查询 TXE 发送（每帧 6 字节）；
+ *          - 流式传输：上位机每帧一个 256 字节的块（正好一页 W25Q32），
+ *            不等应答连续发送，最多 BOOT_WINDOW 个未确认的块；设备有
+ *            BOOT_WINDOW 个块缓冲区，收到的块排队，同一时刻一块在做非阻塞
+ *            页编程（W25Q32_PageProgram_Start），后面的块继续由 DMA 接收，
+ *            编程完成才释放缓冲区并发累计 ACK，因此窗口等于缓冲区个数；
+ *          - 丢帧 / 校验错：后续块序号不连续时回一次 NAK（带期望的序号），
+ *            上位机从该块起重发（Go-Back-N）；重复的块丢弃；
+ *          - 上位机在复位窗口内反复发送 START：擦除期间的 START 忽略，
+ *            READY 之后、第一块之前相同的 START 只再回一次 READY；
+ *          - 结束：全部块写入后，用 W25Q32_ReadCRC 校验整个暂存镜像，与
+ *            START 帧给出的 CRC-32 一致才写镜像头并安装：逐个 2 KB 页读出
+ *            暂存数据，与片内内容相同的页跳过，不同的页擦除（已是空白则
+ *            不擦）后用 HAL_FLASH_Program 按字写入并回读比较，最后对整个
+ *            应用区再算一次 CRC-32；
+ *          - 镜像头使安装可以重做：安装中途掉电后 boot_resume 发现应用
+ *            CRC 不符，从暂存区重新安装；
+ *          - 帧格式（小端）见 Private macro definitions，CRC-16 为
+ *            CCITT-FALSE，CRC-32 与 crc32_compute 相同（STM32 CRC 单元）；
+ *          - 链接：CMake 选项 STM32_BOOTLOADER（默认关闭，应用仍是从
+ *            0x08000000 开始的单一镜像）打开时才生成 stm32Boot，引导程序用
+ *            STM32F103XX_BOOT.ld（前 32 KB），应用改用 STM32F103XX_APP.ld
+ *            （从 BOOT_APP_BASE 开始）；本文件只编进 stm32Boot 和主机仿真，
+ *            若编进应用，代码段越过 BOOT_APP_BASE，安装会改写正在运行的
+ *            代码，所以拒绝安装（BOOT_ST_LAYOUT）。上位机见 tools/uploader。
+ */
+
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_manager.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  升级会话状态
+ */
+typedef enum {
+    BOOT_STATE_IDLE = 0,  /*!< 等待 START */
+    BOOT_STATE_ERASING,   /*!< 正在擦除暂存区 */
+    BOOT_STATE_RECEIVING, /*!< 正在接收 / 写入暂存区 */
+    BOOT_STATE_DONE,      /*!< 已安装 */
+    BOOT_STATE_FAILED,    /*!< 失败，原因见 boot_status */
+} boot_state_t;
+
+/**
+ * @brief  会话统计
+ */
+typedef struct {
+    uint32_t frames;        /*!< 校验通过的帧 */
+    uint32_t bad_frames;    /*!< 校验失败或格式错误的帧 */
+    uint32_t duplicates;    /*!< 重复收到的块和 START */
+    uint32_t naks;          /*!< 发出的 NAK */
+    uint32_t chunks;        /*!< 收下的块 */
+    uint32_t pages_written; /*!< 安装时写入的片内 Flash 页 */
+    uint32_t pages_skipped; /*!< 安装时内容相同而跳过的页 */
+    uint32_t install_ms;    /*!< 安装耗时 */
+} boot_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 片内 Flash 布局 */
+#define BOOT_APP_BASE 0x08008000UL
+#define BOOT_FLASH_END 0x08080000UL
+#define BOOT_APP_MAX_SIZE (BOOT_FLASH_END - BOOT_APP_BASE)
+
+/** W25Q32 暂存区：镜像头扇区 + 镜像 */
+#define BOOT_STAGE_ADDR 0x380000UL
+#define BOOT_STAGE_IMAGE (BOOT_STAGE_ADDR + 0x1000UL)
+
+/** 串口参数 */
+#define BOOT_BAUD 921600UL
+#define BOOT_USART_CLK 72000000UL /*!< PCLK2 */
+
+/** 每块字节数（一页 W25Q32）、窗口（块缓冲区个数）、接收环形缓冲区 */
+#define BOOT_CHUNK_SIZE 256U
+#define BOOT_WINDOW 4U
+#define BOOT_RX_RING 2048U
+
+/** 会话中超过这么久没有收到任何字节则放弃 */
+#define BOOT_SESSION_TIMEOUT_MS 3000U
+
+/** USART1_RX 固定使用的 DMA 通道 */
+#define BOOT_DMA_CHANNEL DMA_CH_DMA1_5
+
+/** 会话结果（DONE 帧的 status 字段） */
+#define BOOT_ST_OK 0U
+#define BOOT_ST_SIZE 1U     /*!< 镜像大小为 0 或超过 BOOT_APP_MAX_SIZE */
+#define BOOT_ST_FLASH 2U    /*!< W25Q32 或片内 Flash 操作失败 */
+#define BOOT_ST_CRC 3U      /*!< 暂存镜像或安装后的 CRC 不符 */
+#define BOOT_ST_SEQUENCE 4U /*!< 块未收齐就结束 */
+#define BOOT_ST_TIMEOUT 5U  /*!< 会话超时 */
+#define BOOT_ST_LAYOUT 6U   /*!< 本程序不在应用区之前（_etext >= BOOT_APP_BASE） */
+
+/** 返回值定义 */
+#define BOOT_OK 0           /*!< 成功 */
+#define BOOT_BUSY -1        /*!< DMA 通道已被占用 */
+#define BOOT_PARAM_ERROR -2 /*!< 参数错误或未初始化 */
+#define BOOT_ERROR -3       /*!< W25Q32 未就绪、暂存区无有效镜像或安装失败 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化 W25Q32，USART1 切换到 BOOT_BAUD，RX DMA 开始接收
+ * @retval BOOT_OK / BOOT_BUSY / BOOT_ERROR
+ * @note   需在 DMA_Manager_Init() 之后调用；会话期间 USART1 不能用于 printf
+ */
+int boot_init(void);
+
+/**
+ * @brief  停止接收，释放 DMA 通道，恢复 USART1 原来的配置
+ */
+void boot_deinit(void);
+
+/**
+ * @brief  处理收到的字节，推进擦除 / 页编程 / 安装，在主循环中反复调用
+ * @retval 当前状态
+ * @note   安装在 END 帧之后同步进行，这一次调用会持续到安装完成
+ */
+boot_state_t boot_poll(void);
+
+/**
+ * @brief  最近一次会话的结果（BOOT_ST_xxx）
+ */
+uint8_t boot_status(void);
+
+/**
+ * @brief  最近一次会话的统计
+ */
+void boot_get_stats(boot_stats_t *stats);
+
+/**
+ * @brief  暂存区有有效镜像、而应用区内容与之不符时重新安装
+ * @retval BOOT_OK（无需安装或安装成功）/ BOOT_ERROR
+ */
+int boot_resume(void);
+
+/**
+ * @brief  应用区向量表是否合理（栈顶在 SRAM 内，复位向量在应用区内）
+ */
+uint8_t boot_app_valid(void);
+
+/**
+ * @brief  跳转到应用（关中断、停 SysTick、清 NVIC、设置 VTOR 与 MSP）
+ * @note   应用无效时直接返回；主机构建下只做检查
+ */
+void boot_jump(void);
+
+/**
+ * @brief  引导程序主流程：等待 wait_ms 内开始的升级会话，完成后跳转应用
+ * @note   没有会话时先 boot_resume，再跳转
+ */
+void boot_run(uint32_t wait_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include "event_loop.h"
 #include "stm32f103xe.h"
 #include <stdio.h>
 /* Exported types ------------------------------------------------------------*/
@@ -59,8 +60,29 @@ typedef enum {
   CAN_LEC_CRC_ERROR = 6      /**< CRC 错误 */
 } CAN_LastErrorCode_t;
 
+/**
+ * @brief CAN 帧（紧凑格式，16 字节，供批量收发使用）
+ * @note  数据区可按 32 位字访问，与 RDLR/RDHR、TDLR/TDHR 一一对应
+ *        （小端：data.b[0] 即 DATA0）
+ */
+typedef struct {
+  uint32_t id;    /**< 标识符（标准帧 11 位 / 扩展帧 29 位） */
+  uint8_t dlc;    /**< 数据长度 (0-8) */
+  uint8_t flags;  /**< CAN_FRAME_FLAG_xxx */
+  uint16_t time;  /**< TTCM 原始 16 位时间戳（可用 CAN_TimestampExtend 扩展） */
+  union {
+    uint8_t b[8];  /**< 按字节访问 */
+    uint32_t w[2]; /**< 按字访问：w[0]=DATA0-3, w[1]=DATA4-7 */
+  } data;
+} CAN_Frame_t;
+
 /* Exported constants --------------------------------------------------------*/
 
+/** CAN_Frame_t.flags 位定义 */
+#define CAN_FRAME_FLAG_IDE 0x01U   /**< 扩展帧 */
+#define CAN_FRAME_FLAG_RTR 0x02U   /**< 远程帧 */
+#define CAN_FRAME_FLAG_FIFO1 0x04U /**< 接收自 FIFO1（仅接收有效） */
+
 /** 最大过滤器数量（STM32F103） */
 #define CAN_FILTER_COUNT 14
 
@@ -72,6 +94,11 @@ typedef enum {
 #define CAN_INIT_ENTER_TIMEOUT -1 /**< 进入初始化模式超时 */
 #define CAN_INIT_EXIT_TIMEOUT -2  /**< 退出初始化模式超时 */
 
+/** CAN 初始化选项（CAN_InitEx 的 options 参数，可按位或组合） */
+#define CAN_OPT_NONE 0x00U /**< 无附加选项 */
+#define CAN_OPT_TTCM 0x01U /**< 时间触发通信模式：使能收发 SOF 硬件时间戳 */
+#define CAN_OPT_TXFP 0x02U /**< 邮箱按请求顺序发送（默认按 ID 优先级） */
+
 /** CAN 发送返回值定义 */
 #define CAN_TX_NO_MAILBOX -1 /**< 无空闲发送邮箱 */
 
@@ -121,6 +148,21 @@ typedef enum {
  */
 int CAN_Init(uint32_t baudrate, CAN_Mode_t mode);
 
+/**
+ * @brief  初始化 CAN 外设（带附加选项）
+ * @param  baudrate: 波特率（如 500000 表示 500kbps）
+ * @param  mode: 工作模式
+ * @param  options: CAN_OPT_xxx 按位或组合
+ *         - CAN_OPT_TTCM: 使能时间触发通信模式，收发报文带硬件时间戳
+ *         - CAN_OPT_TXFP: 发送邮箱按请求顺序发送（周期调度推荐）
+ * @retval CAN_INIT_OK: 成功
+ *         CAN_INIT_ENTER_TIMEOUT: 进入初始化模式超时
+ *         CAN_INIT_EXIT_TIMEOUT: 退出初始化模式超时
+ * @note   CAN_Init(baudrate, mode) 等价于 CAN_InitEx(baudrate, mode,
+ *         CAN_OPT_NONE)；每次初始化都会复位时间戳基准
+ */
+int CAN_InitEx(uint32_t baudrate, CAN_Mode_t mode, uint32_t options);
+
 /**
  * @brief  发送 CAN 报文（轮询方式）
  * @param  id: 报文标识符
@@ -151,6 +193,17 @@ int CAN_Transmit(uint32_t id, uint8_t ide, uint8_t rtr, uint8_t *data,
  */
 int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout);
 
+/**
+ * @brief  等待发送完成并取回发送时间戳
+ * @param  mailbox: 邮箱号 (0-2)
+ * @param  timeout: 超时计数值
+ * @param  timestamp: [out] 发送成功时报文 SOF 的扩展时间戳（可为 NULL）
+ *         未使能 TTCM 时填入 CAN_TimestampNow() 的毫秒级推算值
+ * @retval 同 CAN_TransmitWait
+ */
+int CAN_TransmitWaitTimestamped(uint8_t mailbox, uint32_t timeout,
+                                uint64_t *timestamp);
+
 /**
  * @brief  接收 CAN 报文（轮询方式）
  * @param  fifo: FIFO 号 (0 或 1)
@@ -165,6 +218,18 @@ int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout);
 int CAN_Receive(uint8_t fifo, uint32_t *id, uint8_t *ide, uint8_t *rtr,
                 uint8_t *data, uint8_t *len);
 
+/**
+ * @brief  接收 CAN 报文并取回接收时间戳（轮询方式）
+ * @param  fifo/id/ide/rtr/data/len: 同 CAN_Receive
+ * @param  timestamp: [out] 报文 SOF 的扩展时间戳（可为 NULL）
+ *         未使能 TTCM 时填入 CAN_TimestampNow() 的毫秒级推算值
+ * @retval CAN_RX_OK: 接收成功
+ *         CAN_RX_EMPTY: FIFO 为空
+ */
+int CAN_ReceiveTimestamped(uint8_t fifo, uint32_t *id, uint8_t *ide,
+                           uint8_t *rtr, uint8_t *data, uint8_t *len,
+                           uint64_t *timestamp);
+
 /**
  * @brief  配置 CAN 过滤器
  * @param  filter_num: 过滤器编号 (0-13)
@@ -203,6 +268,76 @@ uint8_t CAN_GetError(uint8_t *tec, uint8_t *rec, uint8_t *lec);
  */
 uint8_t CAN_GetPendingMessages(uint8_t fifo);
 
+/**
+ * @brief  批量接收：一次调用排空 FIFO0 和 FIFO1
+ * @param  frames: [out] 帧缓冲区
+ * @param  max: 缓冲区可容纳的帧数
+ * @retval 实际读出的帧数（0-6）
+ * @note   数据区以 32 位字从 RDLR/RDHR 直接复制，不做逐字节拆分
+ */
+uint8_t CAN_ReceiveBurst(CAN_Frame_t *frames, uint8_t max);
+
+/**
+ * @brief  批量发送：一次调用填满所有空闲邮箱
+ * @param  frames: 待发送帧数组
+ * @param  count: 帧数
+ * @retval 实际提交的帧数（0-3），未提交的帧由调用者稍后重试
+ * @note   只读取一次 TSR，按数组顺序依次占用空闲邮箱
+ */
+uint8_t CAN_TransmitBurst(const CAN_Frame_t *frames, uint8_t count);
+
+/**
+ * @brief  把 16 位硬件时间戳（TIME[15:0]）扩展为 64 位位时间
+ * @param  raw: RDTR/TDTR 中读出的 16 位时间戳
+ * @retval 扩展后的位时间（单位：CAN 位时间，500kbps 下 1 位 = 2us）
+ * @note   以 HAL_GetTick 辅助判断回绕次数，相邻两次观测的处理延迟之差
+ *         需小于半个回绕周期（32768 位时间）
+ */
+uint64_t CAN_TimestampExtend(uint16_t raw);
+
+/**
+ * @brief  根据 HAL_GetTick 推算当前的 64 位位时间
+ * @retval 推算的位时间（毫秒级分辨率）
+ */
+uint64_t CAN_TimestampNow(void);
+
+/**
+ * @brief  把扩展时间戳换算到 HAL_GetTick 的毫秒时间轴
+ * @param  timestamp: 扩展后的位时间
+ * @retval 对应的 HAL_GetTick 值（ms）
+ */
+uint32_t CAN_TimestampToTick(uint64_t timestamp);
+
+/**
+ * @brief  把扩展时间戳换算为微秒
+ * @param  timestamp: 扩展后的位时间
+ * @retval 微秒数
+ */
+uint64_t CAN_TimestampToUs(uint64_t timestamp);
+
+/**
+ * @brief  设置 FIFO 收到报文时投递事件的目标，打开 FMPIE0/FMPIE1 中断
+ * @param  task: 目标任务，NULL 表示关闭接收中断（回到轮询）
+ * @param  sig: 信号，事件 param 为 FIFO 号 (0 或 1)
+ * @note   在 CAN_Init 之后调用。FMP 非零期间中断一直有效，所以中断里先
+ *         关掉该 FIFO 的 FMPIE 再投递事件；任务读空 FIFO 后调用
+ *         CAN_RxEventRearm 重新打开
+ */
+void CAN_SetRxEvent(ev_task_t *task, uint16_t sig);
+
+/**
+ * @brief  重新打开 FIFO 的报文挂起中断（任务读完 FIFO 后调用）
+ * @param  fifo: FIFO 号 (0 或 1)
+ * @note   FIFO 中仍有报文时会立即再次进入中断并投递事件
+ */
+void CAN_RxEventRearm(uint8_t fifo);
+
+/**
+ * @brief  FIFO 报文挂起中断处理（由 USB_LP_CAN1_RX0 / CAN1_RX1 中断调用）
+ * @param  fifo: FIFO 号 (0 或 1)
+ */
+void CAN_RxIRQHandler(uint8_t fifo);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,102 @@
+/**
+ * @file    can_sched.h
+ * @brief   CAN 周期报文调度器头文件
+ * @date    2026-10-18
+ *
+ * @note    基于 can_driver 的轮询式周期发送表：
+ *          - 每条报文有固定周期和首次发送时刻，截止时间按 next += period
+ *            累加，不随轮询时刻漂移，保证报文间隔确定；
+ *          - 发送邮箱满时保留截止时间，下次轮询立即补发；
+ *          - 错过整周期时跳过并计数，不做突发补发。
+ *          推荐配合 CAN_InitEx(..., CAN_OPT_TXFP) 使用，使邮箱按请求顺序发出。
+ */
+
+#ifndef __CAN_SCHED_H
+#define __CAN_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief 周期报文统计信息
+ */
+typedef struct {
+  uint32_t sent;    /**< 已成功提交到邮箱的次数 */
+  uint32_t retried; /**< 因邮箱满而推迟到下次轮询的次数 */
+  uint32_t skipped; /**< 因轮询过慢而跳过的整周期数 */
+} CAN_SchedStats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 调度表容量 */
+#define CAN_SCHED_MAX_ENTRIES 8
+
+/** 调度器返回值定义 */
+#define CAN_SCHED_OK 0           /**< 成功 */
+#define CAN_SCHED_FULL -1        /**< 调度表已满 */
+#define CAN_SCHED_PARAM_ERROR -2 /**< 参数错误或句柄无效 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  清空调度表
+ */
+void CAN_Sched_Reset(void);
+
+/**
+ * @brief  添加一条周期报文
+ * @param  id: 报文标识符
+ * @param  ide: 帧类型（0=标准帧，1=扩展帧）
+ * @param  data: 数据指针（可为 NULL，表示全 0）
+ * @param  len: 数据长度（0-8）
+ * @param  period_ms: 发送周期（ms，必须大于 0）
+ * @param  first_ms: 首次发送时刻（HAL_GetTick 时间轴），
+ *         通常为 HAL_GetTick() + 偏移，用不同偏移错开多条报文
+ * @retval >=0: 句柄，CAN_SCHED_FULL/CAN_SCHED_PARAM_ERROR: 失败
+ */
+int CAN_Sched_Add(uint32_t id, uint8_t ide, const uint8_t *data, uint8_t len,
+                  uint32_t period_ms, uint32_t first_ms);
+
+/**
+ * @brief  更新周期报文的数据（不影响发送时刻）
+ * @param  handle: CAN_Sched_Add 返回的句柄
+ * @param  data: 新数据
+ * @param  len: 数据长度（0-8）
+ * @retval CAN_SCHED_OK/CAN_SCHED_PARAM_ERROR
+ */
+int CAN_Sched_Update(int handle, const uint8_t *data, uint8_t len);
+
+/**
+ * @brief  删除周期报文
+ * @param  handle: CAN_Sched_Add 返回的句柄
+ * @retval CAN_SCHED_OK/CAN_SCHED_PARAM_ERROR
+ */
+int CAN_Sched_Remove(int handle);
+
+/**
+ * @brief  调度轮询：发送所有已到期的报文
+ * @param  now_ms: 当前时刻（通常为 HAL_GetTick()）
+ * @retval 本次提交到邮箱的报文数
+ * @note   在主循环或 1ms 定时中断中调用，调用间隔决定发送抖动上限
+ */
+uint8_t CAN_Sched_Poll(uint32_t now_ms);
+
+/**
+ * @brief  获取周期报文统计信息
+ * @param  handle: CAN_Sched_Add 返回的句柄
+ * @param  stats: [out] 统计信息
+ * @retval CAN_SCHED_OK/CAN_SCHED_PARAM_ERROR
+ */
+int CAN_Sched_GetStats(int handle, CAN_SchedStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CAN_SCHED_H */
@@ -0,0 +1,240 @@
+/**
+ * @file    can_signal.h
+ * @brief   CAN 信号打包 / PDO 映射层头文件
+ * @date    2026-10-18
+ *
+ * @note    参照 DBC / CANopen / J1939 的信号描述方式：
+ *          - 信号由起始位、位长、字节序、符号和比例（factor/offset）描述；
+ *          - 用 CAN_SIGNAL_DEFINE 在编译期为每个信号生成内联的 pack/unpack
+ *            函数，移位和掩码全部是常量，执行时间与信号位置无关；
+ *          - 报文负载以 64 位整数就地读写 CAN_Frame_t 的数据字，不做中间复制；
+ *          - PDO 把一组信号直接绑定到应用变量，按"变化即发"或"周期"发送。
+ *
+ *          起始位约定与 DBC 相同：
+ *          - Intel（小端）：start 为最低有效位的位号（DATA0 bit0 = 0）；
+ *          - Motorola（大端）：start 为最高有效位的位号（锯齿编号，
+ *            DATA0 bit7 = 7，DATA1 bit0 = 8）。
+ *
+ * @usage   @code
+ *          // 信号表：名称, 起始位, 位长, 字节序, 有符号
+ *          #define ENGINE_SIGNALS(X)                                   \
+ *            X(eng_speed, 0, 16, CAN_SIG_LITTLE_ENDIAN, 0)             \
+ *            X(eng_temp, 23, 8, CAN_SIG_BIG_ENDIAN, 1)
+ *          ENGINE_SIGNALS(CAN_SIGNAL_DEFINE)
+ *
+ *          uint64_t p = CAN_Frame_GetPayload(&frame);
+ *          uint32_t rpm_raw = eng_speed_unpack(p);
+ *          @endcode
+ */
+
+#ifndef __CAN_SIGNAL_H
+#define __CAN_SIGNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "can_driver.h"
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 信号字节序 */
+#define CAN_SIG_LITTLE_ENDIAN 0 /**< Intel 格式 */
+#define CAN_SIG_BIG_ENDIAN 1    /**< Motorola 格式 */
+
+/** 绑定变量类型 */
+#define CAN_VAR_U8 0
+#define CAN_VAR_U16 1
+#define CAN_VAR_U32 2
+#define CAN_VAR_I8 3
+#define CAN_VAR_I16 4
+#define CAN_VAR_I32 5
+
+/** PDO 发送方式（可组合） */
+#define CAN_PDO_ON_CHANGE 0x01U /**< 映射数据变化时立即发送 */
+#define CAN_PDO_PERIODIC 0x02U  /**< 按 period_ms 周期发送 */
+
+/* Exported macro ------------------------------------------------------------*/
+
+/** 位长为 len 的掩码（len = 1..32） */
+#define CAN_SIG_MASK(len) ((uint64_t)0xFFFFFFFFU >> (32 - (len)))
+
+/**
+ * @brief 信号最低位在"负载整数"中的位置
+ * @note  小端信号在原始小端负载中定位；大端信号在字节反转后的负载中定位，
+ *        两种情况下信号都是一段连续位
+ */
+#define CAN_SIG_SHIFT(order, start, len)                                       \
+  ((order) == CAN_SIG_LITTLE_ENDIAN                                            \
+       ? (start)                                                               \
+       : ((7 - (start) / 8) * 8 + (start) % 8 - (len) + 1))
+
+/**
+ * @brief 生成信号的 pack / unpack 内联函数
+ * @param name: 信号名，生成 name##_pack() 和 name##_unpack()
+ * @param start: 起始位（见文件头约定）
+ * @param len: 位长（1-32）
+ * @param order: CAN_SIG_LITTLE_ENDIAN / CAN_SIG_BIG_ENDIAN
+ * @param sign: 非 0 表示有符号，unpack 时做符号扩展
+ * @note  所有参数都是编译期常量，编译后只剩几条移位/掩码指令
+ */
+#define CAN_SIGNAL_DEFINE(name, start, len, order, sign)                       \
+  static inline void name##_pack(uint64_t *payload, uint32_t raw) {            \
+    const unsigned sh = CAN_SIG_SHIFT(order, start, len);                      \
+    const uint64_t m = CAN_SIG_MASK(len) << sh;                                \
+    uint64_t p = ((order) == CAN_SIG_BIG_ENDIAN) ? __builtin_bswap64(*payload) \
+                                                 : *payload;                   \
+    p = (p & ~m) | (((uint64_t)raw << sh) & m);                                \
+    *payload = ((order) == CAN_SIG_BIG_ENDIAN) ? __builtin_bswap64(p) : p;     \
+  }                                                                            \
+  static inline uint32_t name##_unpack(uint64_t payload) {                     \
+    const unsigned sh = CAN_SIG_SHIFT(order, start, len);                      \
+    uint64_t p = ((order) == CAN_SIG_BIG_ENDIAN) ? __builtin_bswap64(payload)  \
+                                                 : payload;                    \
+    uint32_t raw = (uint32_t)((p >> sh) & CAN_SIG_MASK(len));                  \
+    if ((sign) && (len) < 32 && (raw >> ((len) - 1)) != 0) {                   \
+      raw |= ~(uint32_t)CAN_SIG_MASK(len);                                     \
+    }                                                                          \
+    return raw;                                                                \
+  }
+
+/**
+ * @brief 由同一张信号表生成运行时描述符（供通用实现和调试使用）
+ */
+#define CAN_SIGNAL_DESC(name, start, len, order, sign)                         \
+  {#name, (start), (len), (order), (sign)},
+
+/**
+ * @brief 定义一个 PDO 映射项
+ * @param sig: 用 CAN_SIGNAL_DEFINE 生成过的信号名
+ * @param var: 应用变量（左值）
+ * @param type: CAN_VAR_xxx
+ * @param factor: 物理值 = 原始值 × factor + offset（factor 为 0 按 1 处理）
+ * @param offset: 偏移
+ */
+#define CAN_PDO_MAP(sig, var, type, factor, offset)                            \
+  {(void *)&(var), sig##_pack, sig##_unpack, (factor), (offset), (type)}
+
+/* Exported types ------------------------------------------------------------*/
+
+/** 生成的打包/解包函数指针类型 */
+typedef void (*CAN_SigPackFn_t)(uint64_t *payload, uint32_t raw);
+typedef uint32_t (*CAN_SigUnpackFn_t)(uint64_t payload);
+
+/**
+ * @brief 运行时信号描述符
+ */
+typedef struct {
+  const char *name; /**< 信号名 */
+  uint8_t start;    /**< 起始位 */
+  uint8_t len;      /**< 位长 (1-32) */
+  uint8_t order;    /**< 字节序 */
+  uint8_t sign;     /**< 是否有符号 */
+} CAN_SignalDesc_t;
+
+/**
+ * @brief PDO 映射项：信号 <-> 应用变量
+ */
+typedef struct {
+  void *var;                /**< 绑定的应用变量 */
+  CAN_SigPackFn_t pack;     /**< 生成的打包函数 */
+  CAN_SigUnpackFn_t unpack; /**< 生成的解包函数 */
+  int32_t factor;           /**< 比例 */
+  int32_t offset;           /**< 偏移 */
+  uint8_t type;             /**< CAN_VAR_xxx */
+} CAN_PdoMap_t;
+
+/**
+ * @brief PDO 描述（配置 + 运行时状态）
+ */
+typedef struct {
+  /* 配置 */
+  uint32_t id;              /**< 报文标识符 */
+  uint8_t ide;              /**< 帧类型 */
+  uint8_t dlc;              /**< 数据长度 */
+  uint8_t mode;             /**< CAN_PDO_ON_CHANGE | CAN_PDO_PERIODIC */
+  uint32_t period_ms;       /**< 周期（PERIODIC 时有效） */
+  const CAN_PdoMap_t *map;  /**< 映射表 */
+  uint8_t map_count;        /**< 映射项个数 */
+  /* 运行时状态（初始化为 0 即可） */
+  uint8_t valid;            /**< 是否发送/接收过 */
+  uint32_t next_due;        /**< 下一次周期发送时刻 */
+  uint64_t last;            /**< 上次发送/接收的负载 */
+} CAN_Pdo_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  以 64 位整数读取帧负载（DATA0 为最低字节）
+ */
+static inline uint64_t CAN_Frame_GetPayload(const CAN_Frame_t *frame) {
+  return (uint64_t)frame->data.w[0] | ((uint64_t)frame->data.w[1] << 32);
+}
+
+/**
+ * @brief  以 64 位整数写入帧负载
+ */
+static inline void CAN_Frame_SetPayload(CAN_Frame_t *frame, uint64_t payload) {
+  frame->data.w[0] = (uint32_t)payload;
+  frame->data.w[1] = (uint32_t)(payload >> 32);
+}
+
+/**
+ * @brief  通用逐位打包（按运行时描述符，作为参考实现）
+ * @param  data: 8 字节负载
+ * @param  desc: 信号描述符
+ * @param  raw: 原始值
+ */
+void CAN_Signal_PackGeneric(uint8_t *data, const CAN_SignalDesc_t *desc,
+                            uint32_t raw);
+
+/**
+ * @brief  通用逐位解包（按运行时描述符，作为参考实现）
+ * @param  data: 8 字节负载
+ * @param  desc: 信号描述符
+ * @retval 原始值（有符号信号已做符号扩展）
+ */
+uint32_t CAN_Signal_UnpackGeneric(const uint8_t *data,
+                                  const CAN_SignalDesc_t *desc);
+
+/**
+ * @brief  按映射表把应用变量打包为负载
+ * @param  pdo: PDO 描述
+ * @retval 打包后的负载
+ */
+uint64_t CAN_Pdo_Pack(const CAN_Pdo_t *pdo);
+
+/**
+ * @brief  按映射表把负载解包到应用变量
+ * @param  pdo: PDO 描述
+ * @param  payload: 负载
+ */
+void CAN_Pdo_Unpack(const CAN_Pdo_t *pdo, uint64_t payload);
+
+/**
+ * @brief  发送处理：打包所有 TPDO，按变化/周期条件发送
+ * @param  pdos: TPDO 数组
+ * @param  count: PDO 个数
+ * @param  now_ms: 当前时刻（HAL_GetTick）
+ * @retval 本次发送的帧数
+ * @note   邮箱满时不更新状态，下次调用重试
+ */
+uint8_t CAN_Pdo_TxProcess(CAN_Pdo_t *pdos, uint8_t count, uint32_t now_ms);
+
+/**
+ * @brief  接收分发：把收到的帧解包到匹配 RPDO 的绑定变量
+ * @param  pdos: RPDO 数组
+ * @param  count: PDO 个数
+ * @param  frame: 收到的帧
+ * @retval 匹配的 PDO 下标，-1 表示无匹配
+ */
+int CAN_Pdo_RxDispatch(CAN_Pdo_t *pdos, uint8_t count,
+                       const CAN_Frame_t *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CAN_SIGNAL_H */
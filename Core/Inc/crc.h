@@ -0,0 +1,117 @@
+/**
+ * @file    crc.h
+ * @brief   查表法软件 CRC（CRC-8 / CRC-16 / CRC-32，含 slice-by-4/8）头文件
+ * @date    2026-10-18
+ *
+ * @note    - 算法用 crc_algo_t 描述（宽度、多项式、初值、反转、结果异或），
+ *            参数与常见 CRC 目录中的同名算法一致，check 为 "123456789" 的结果；
+ *          - 每个算法的 256 项字节表在编译期由宏从多项式展开生成，放在
+ *            Flash 中，不需要运行时初始化；
+ *          - CRC-32（crc_32）另有 7 张 slice 表，每次处理 4 / 8 字节，
+ *            用于大块数据；
+ *          - 增量接口：crc = crc_init(a); crc = crc_update(a, crc, ...) 可以
+ *            调用任意次、每次任意长度；最后 crc_final(a, crc) 得到结果；
+ *          - CRC 计算单元只支持 crc_32_mpeg2，且按 32 位字从最高位送入，
+ *            与按字节计算的结果关系见 crc32.h / crc_sw_test.c。
+ */
+
+#ifndef __CRC_H__
+#define __CRC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  CRC 算法描述
+ */
+typedef struct {
+    const char *name;             /*!< 名称 */
+    uint8_t width;                /*!< 8 / 16 / 32 */
+    uint8_t reflected;            /*!< 输入输出按位反转（低位先行） */
+    uint32_t poly;                /*!< 多项式（正常形式，仅作说明） */
+    uint32_t init;                /*!< 初值 */
+    uint32_t xorout;              /*!< 结果异或值 */
+    uint32_t check;               /*!< "123456789" 的结果 */
+    const void *table;            /*!< 字节表，元素为 uint8_t / uint16_t / uint32_t */
+    const uint32_t (*slice)[256]; /*!< slice 表 T0..T7，NULL 表示不支持 */
+} crc_algo_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 超过该长度时 crc_update 对支持的算法使用 slice-by-8 */
+#ifndef CRC_SLICE_MIN_BYTES
+#define CRC_SLICE_MIN_BYTES 16U
+#endif
+
+/** 预定义算法 */
+extern const crc_algo_t crc_8_j1850;    /*!< CRC-8/SAE-J1850：0x1D，初值 / 异或 0xFF */
+extern const crc_algo_t crc_16_modbus;  /*!< CRC-16/MODBUS：0x8005 反转，初值 0xFFFF */
+extern const crc_algo_t crc_16_ccitt;   /*!< CRC-16/CCITT-FALSE：0x1021，初值 0xFFFF */
+extern const crc_algo_t crc_32;         /*!< CRC-32（以太网 / zlib）：0x04C11DB7 反转 */
+extern const crc_algo_t crc_32_mpeg2;   /*!< CRC-32/MPEG-2：0x04C11DB7，不反转，同 CRC 单元 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始寄存器值
+ */
+static inline uint32_t crc_init(const crc_algo_t *algo) {
+    return algo->init;
+}
+
+/**
+ * @brief  最终结果
+ */
+static inline uint32_t crc_final(const crc_algo_t *algo, uint32_t crc) {
+    return crc ^ algo->xorout;
+}
+
+/**
+ * @brief  增量计算：自动选择逐字节或 slice-by-8
+ * @param  algo: 算法
+ * @param  crc: 当前寄存器值（crc_init 或上一次的返回值）
+ * @param  data: 数据，可以不对齐
+ * @param  len: 字节数
+ * @retval 新的寄存器值
+ */
+uint32_t crc_update(const crc_algo_t *algo, uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief  逐字节查表
+ */
+uint32_t crc_update_bytewise(const crc_algo_t *algo, uint32_t crc, const void *data,
+                             size_t len);
+
+/**
+ * @brief  slice-by-4：每次 4 字节
+ * @note   algo->slice 为 NULL 时退回逐字节查表
+ */
+uint32_t crc_update_slice4(const crc_algo_t *algo, uint32_t crc, const void *data,
+                           size_t len);
+
+/**
+ * @brief  slice-by-8：每次 8 字节
+ * @note   algo->slice 为 NULL 时退回逐字节查表
+ */
+uint32_t crc_update_slice8(const crc_algo_t *algo, uint32_t crc, const void *data,
+                           size_t len);
+
+/**
+ * @brief  一次计算一块数据（init + update + final）
+ */
+uint32_t crc_calc(const crc_algo_t *algo, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRC_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,138 @@
+/**
+ * @file    crc32.h
+ * @brief   CRC 计算单元驱动（CPU / MEM2MEM DMA 送数）与软件实现头文件
+ * @date    2026-10-18
+ *
+ * @note    - 算法与 CRC 外设一致（CRC-32/MPEG-2）：多项式 0x04C11DB7，
+ *            初值 0xFFFFFFFF，输入输出都不反转，无结果异或；
+ *          - 数据按 32 位字送入，字从内存按小端读出、从最高位开始计算；
+ *            末尾不足 4 字节的部分补零成一个字（高位字节为 0）再送入，
+ *            因此只有最后一次送数的长度可以不是 4 的倍数；
+ *          - DMA 送数：MEM2MEM 通道，源地址递增，目的地址固定为 CRC->DR，
+ *            单段超过 CNDTR 上限时在 TC 中断里接续；CPU 可以同时准备
+ *            下一块数据（如 W25Q32_ReadCRC 的双缓冲）；
+ *          - CRC 单元只有一个，且 F1 不能预置初值，同一时刻只能有一路
+ *            计算；
+ *          - crc32_sw 是软件实现（每个字按高字节在前交给 crc.h 的
+ *            crc_32_mpeg2 查表），结果与硬件逐位一致，用于没有 CRC 单元或
+ *            DMA 通道被占用的场合，也用于校验硬件结果。
+ */
+
+#ifndef __CRC32_H__
+#define __CRC32_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_manager.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  DMA 送数完成回调（中断上下文）
+ * @param  status: CRC32_OK 或 CRC32_ERROR（传输错误）
+ * @param  crc: 到目前为止的 CRC 值
+ * @param  ctx: 启动时传入的上下文
+ */
+typedef void (*crc32_callback_t)(int status, uint32_t crc, void *ctx);
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 使用的 DMA 通道（DMA2 通道 1 没有分配给其他驱动） */
+#ifndef CRC32_DMA_CHANNEL
+#define CRC32_DMA_CHANNEL DMA_CH_DMA2_1
+#endif
+
+/** 少于该字节数时 crc32_compute 直接由 CPU 送数，省掉 DMA 配置开销 */
+#ifndef CRC32_DMA_MIN_BYTES
+#define CRC32_DMA_MIN_BYTES 64U
+#endif
+
+/** 初值 / 多项式 */
+#define CRC32_INIT 0xFFFFFFFFUL
+#define CRC32_POLY 0x04C11DB7UL
+
+/** 返回值定义 */
+#define CRC32_OK 0           /*!< 成功 */
+#define CRC32_BUSY -1        /*!< 上一次 DMA 送数尚未完成 */
+#define CRC32_PARAM_ERROR -2 /*!< 参数错误、地址未按字对齐或未初始化 */
+#define CRC32_ERROR -3       /*!< DMA 传输错误 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  打开 CRC 时钟，占用 CRC32_DMA_CHANNEL 并注册 TC/TE 回调
+ * @retval CRC32_OK / CRC32_PARAM_ERROR（通道已被占用）
+ * @note   需在 DMA_Manager_Init() 之后调用；不调用时仍可使用 CPU 送数
+ */
+int crc32_init(void);
+
+/**
+ * @brief  释放 DMA 通道
+ */
+void crc32_deinit(void);
+
+/**
+ * @brief  复位 CRC 单元（DR = CRC32_INIT），开始新的计算
+ */
+void crc32_reset(void);
+
+/**
+ * @brief  由 CPU 送入数据（接续当前值，不复位）
+ * @param  data: 数据，可以不对齐
+ * @param  len: 字节数，不是 4 的倍数时尾部补零
+ * @retval 送入后的 CRC 值
+ */
+uint32_t crc32_feed(const void *data, size_t len);
+
+/**
+ * @brief  启动 DMA 送数（接续当前值，不复位）
+ * @param  data: 数据，必须按字对齐，在回调之前保持有效
+ * @param  len: 字节数，不是 4 的倍数时尾部在 TC 中断里由 CPU 补零送入
+ * @param  cb: 完成回调（可为 NULL，之后用 crc32_busy / crc32_value 查询）
+ * @param  ctx: 回调上下文
+ * @retval CRC32_OK / CRC32_BUSY / CRC32_PARAM_ERROR
+ */
+int crc32_feed_dma(const void *data, size_t len, crc32_callback_t cb, void *ctx);
+
+/**
+ * @brief  DMA 送数是否还在进行
+ */
+uint8_t crc32_busy(void);
+
+/**
+ * @brief  读取当前 CRC 值
+ */
+uint32_t crc32_value(void);
+
+/**
+ * @brief  阻塞计算一块数据的 CRC（复位后送数）
+ * @param  data: 数据
+ * @param  len: 字节数
+ * @param  crc: 输出结果
+ * @retval CRC32_OK / CRC32_BUSY / CRC32_ERROR
+ * @note   已初始化、字对齐且不少于 CRC32_DMA_MIN_BYTES 时用 DMA 送数并等待，
+ *         否则由 CPU 送数
+ */
+int crc32_compute(const void *data, size_t len, uint32_t *crc);
+
+/**
+ * @brief  软件计算（与硬件结果一致）
+ * @param  crc: 初值，首次为 CRC32_INIT，接续时为上一次的返回值
+ * @param  data: 数据
+ * @param  len: 字节数，同样只有最后一次可以不是 4 的倍数
+ * @retval 计算后的 CRC 值
+ */
+uint32_t crc32_sw(uint32_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRC32_H__ */
+
+/************************ END OF FILE *****************************************/
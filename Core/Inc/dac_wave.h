@@ -0,0 +1,186 @@
+/**
+ * @file    dac_wave.h
+ * @brief   DAC 波形发生器（TIM7 触发、DMA 循环回放、无缝换表）头文件
+ * @date    2026-10-18
+ *
+ * @note    - 两个 DAC 通道（PA4 / PA5）共用 TIM7 的采样率：TIM7 更新事件作为
+ *            TRGO 触发 DAC，每次触发 DHR 装入输出，同时请求 DMA2 通道 3 / 4
+ *            送来下一个采样；DMA 以循环模式读取波形表，稳定输出时只开
+ *            传输错误中断（出错时停止该通道，次数见 dac_wave_errors）；
+ *          - 引脚冲突：PA5（通道 2）同时是 SPI1_SCK（W25Q32、spi_bus、引导
+ *            程序的暂存区都用 SPI1）。dac_wave_init 不动引脚，某个通道第一次
+ *            回放时才把它的引脚切到模拟模式，dac_wave_deinit 恢复原来的
+ *            配置；通道 2 回放期间 SPI1 没有时钟输出，不能访问 W25Q32；
+ *          - TIM6 是软件时间轮的节拍源，频率不能随波形改变，因此触发源用
+ *            同为 DAC 原生触发的 TIM7；
+ *          - 每个通道有两块 DAC_WAVE_MAX_LEN 的表缓冲区：正在回放一块时，新表
+ *            写入另一块，换表时输出从旧表最后一个采样直接接到新表第一个采样：
+ *            长度相同时循环 DMA 不停，HT 中断把新表前半张复制进正在回放的
+ *            缓冲区，随后的 TC 中断复制后半张，中断只需在半张表的时间内响应；
+ *            长度不同时只能在 TC 中断里把 DMA 重装到新表，中断必须在一个
+ *            采样周期内响应，否则旧表尾会多输出一次；
+ *          - dac_wave_synth 用 32 位相位累加器生成表：len 个采样正好包含
+ *            cycles 个周期（相位步进的余数另行累加，表尾与表头相接处没有相位
+ *            误差），因此输出频率 = 采样率 × cycles / len；dac_wave_plan 为
+ *            目标频率选出误差最小的 len / cycles 组合。
+ */
+
+#ifndef __DAC_WAVE_H__
+#define __DAC_WAVE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  DAC 通道
+ */
+typedef enum {
+    DAC_WAVE_CH1 = 0, /*!< PA4 */
+    DAC_WAVE_CH2,     /*!< PA5 */
+    DAC_WAVE_COUNT
+} dac_wave_channel_t;
+
+/**
+ * @brief  波形
+ */
+typedef enum {
+    DAC_WAVE_SHAPE_SINE = 0,
+    DAC_WAVE_SHAPE_TRIANGLE, /*!< 从最低点开始 */
+    DAC_WAVE_SHAPE_SAW,      /*!< 从最低点上升 */
+    DAC_WAVE_SHAPE_SQUARE,   /*!< 前半周期为高 */
+} dac_wave_shape_t;
+
+/**
+ * @brief  频率方案
+ */
+typedef struct {
+    uint16_t len;      /*!< 表长度 */
+    uint16_t cycles;   /*!< 表中包含的周期数 */
+    uint32_t freq_mhz; /*!< 实际输出频率，单位 mHz */
+} dac_wave_plan_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 每个通道每块表缓冲区的采样数 */
+#ifndef DAC_WAVE_MAX_LEN
+#define DAC_WAVE_MAX_LEN 512U
+#endif
+
+/** TIM7 计数时钟（APB1 x2） */
+#define DAC_WAVE_TIM_CLK 72000000UL
+
+/** 采样率上限（DAC 输出建立时间约 3 us） */
+#define DAC_WAVE_MAX_RATE 1000000UL
+
+/** 12 位满量程 */
+#define DAC_WAVE_FULL_SCALE 4095U
+
+/** 返回值定义 */
+#define DAC_WAVE_OK 0           /*!< 成功 */
+#define DAC_WAVE_BUSY -1        /*!< DMA 通道已被占用，或上一次换表尚未完成 */
+#define DAC_WAVE_PARAM_ERROR -2 /*!< 参数错误或未初始化 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  打开 DAC / TIM7 时钟，占用 DMA2 通道 3 / 4，TIM7 开始计数（引脚在
+ *         第一次回放时才配置）
+ * @param  rate_hz: 采样率，1 ~ DAC_WAVE_MAX_RATE；实际值见 dac_wave_rate_mhz
+ * @retval DAC_WAVE_OK / DAC_WAVE_BUSY / DAC_WAVE_PARAM_ERROR
+ * @note   需在 DMA_Manager_Init() 之后调用
+ */
+int dac_wave_init(uint32_t rate_hz);
+
+/**
+ * @brief  停止两个通道和 TIM7，引脚恢复回放前的配置，释放 DMA 通道
+ */
+void dac_wave_deinit(void);
+
+/**
+ * @brief  实际采样率
+ * @retval 单位 mHz（TIM7 分频后不一定是整数 Hz）
+ */
+uint64_t dac_wave_rate_mhz(void);
+
+/**
+ * @brief  立即开始循环回放一张表（复制到通道缓冲区）
+ * @param  len: 1 ~ DAC_WAVE_MAX_LEN
+ * @retval DAC_WAVE_OK / DAC_WAVE_PARAM_ERROR
+ * @note   正在回放时先停止，输出会有一次不连续；要无缝切换请用 dac_wave_swap
+ */
+int dac_wave_play(dac_wave_channel_t ch, const uint16_t *table, uint16_t len);
+
+/**
+ * @brief  当前表播放到表尾时无缝换成新表（复制到空闲缓冲区）
+ * @retval DAC_WAVE_OK / DAC_WAVE_BUSY / DAC_WAVE_PARAM_ERROR
+ * @note   通道未在回放时等同于 dac_wave_play；长度与当前表相同时 DMA 不停，
+ *         长度不同时在表尾重装 DMA（时序要求见文件说明）
+ */
+int dac_wave_swap(dac_wave_channel_t ch, const uint16_t *table, uint16_t len);
+
+/**
+ * @brief  是否有换表在等待表尾
+ */
+uint8_t dac_wave_swap_pending(dac_wave_channel_t ch);
+
+/**
+ * @brief  传输错误次数（出错的通道已停止回放）
+ */
+uint32_t dac_wave_errors(dac_wave_channel_t ch);
+
+/**
+ * @brief  为目标频率生成并回放一张表
+ * @param  freq_hz: 目标频率，不超过采样率的一半
+ * @param  amplitude: 峰值幅度（码值），0 ~ 2048
+ * @param  offset: 中心电平（码值），0 ~ 4095，超出满量程的部分被削平
+ * @param  plan: 输出实际采用的方案，可为 NULL
+ * @retval DAC_WAVE_OK / DAC_WAVE_BUSY / DAC_WAVE_PARAM_ERROR
+ * @note   正在回放时在表尾无缝切换
+ */
+int dac_wave_tone(dac_wave_channel_t ch, uint32_t freq_hz, dac_wave_shape_t shape,
+                  uint16_t amplitude, uint16_t offset, dac_wave_plan_t *plan);
+
+/**
+ * @brief  停止回放，输出保持最后一个值
+ */
+void dac_wave_stop(dac_wave_channel_t ch);
+
+/**
+ * @brief  是否正在回放
+ */
+uint8_t dac_wave_playing(dac_wave_channel_t ch);
+
+/**
+ * @brief  为目标频率选择表长度和周期数
+ * @param  freq_hz: 目标频率
+ * @param  max_len: 表长度上限，2 ~ DAC_WAVE_MAX_LEN
+ * @param  plan: 输出
+ * @retval DAC_WAVE_OK / DAC_WAVE_PARAM_ERROR（未初始化、频率超过采样率的一半，
+ *         或低到 max_len 个采样放不下一个周期）
+ * @note   误差相同时取较长的表（波形更细）
+ */
+int dac_wave_plan(uint32_t freq_hz, uint16_t max_len, dac_wave_plan_t *plan);
+
+/**
+ * @brief  用相位累加器生成一张表
+ * @param  table: 输出，len 个 12 位码值
+ * @param  cycles: 表中包含的周期数
+ * @param  amplitude: 峰值幅度（码值）
+ * @param  offset: 中心电平（码值）
+ */
+void dac_wave_synth(uint16_t *table, uint16_t len, uint16_t cycles, dac_wave_shape_t shape,
+                    uint16_t amplitude, uint16_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DAC_WAVE_H__ */
+
+/************************ END OF FILE *****************************************/
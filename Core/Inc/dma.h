@@ -106,6 +106,13 @@ typedef struct {
 #define DMA1_FLAG_TC1                      ((uint32_t)0x00000002) /*!< DMA1 通道1 传输完成标志 */
 #define DMA1_FLAG_HT1                      ((uint32_t)0x00000004) /*!< DMA1 通道1 半传输标志 */
 #define DMA1_FLAG_TE1                      ((uint32_t)0x00000008) /*!< DMA1 通道1 传输错误标志 */
+
+/* 其余通道的标志按每通道 4 位排列：GIFx/TCIFx/HTIFx/TEIFx 位于 bit 4(x-1)+0..3 */
+#define DMA_FLAG_CH(x, flag1)              ((uint32_t)(flag1) << (4U * ((x) - 1U)))
+
+/* DMA2 的标志额外置位 DMA2_FLAG_SEL，例如 DMA2_FLAG(DMA1_FLAG_TC1, 3) 为 DMA2 通道3 TC */
+#define DMA2_FLAG_SEL                      ((uint32_t)0x10000000)
+#define DMA2_FLAG(flag1, x)                (DMA2_FLAG_SEL | DMA_FLAG_CH(x, flag1))
 /* USER CODE END Private defines */
 
 void MX_DMA_Init(void);
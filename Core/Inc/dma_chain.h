@@ -0,0 +1,123 @@
+/**
+ * @file    dma_chain.h
+ * @brief   软件 DMA 描述符链（scatter-gather）头文件
+ * @date    2026-10-18
+ *
+ * @note    STM32F1 的 DMA 没有链表模式。这里用一个 {src, dst, len, flags}
+ *          描述符数组模拟：第一段通过 DMA_StartTransfer (DMA_Init) 完整配置，
+ *          之后每个 TC 中断里只用 DMA_Restart 重写 CPAR/CMAR/CNDTR 并重新使能，
+ *          先接续下一段再调用上一段的回调，使段间空闲时间最短。
+ *
+ *          典型用法：SPI 写“命令头 + 数据”时，两段描述符共用 SPI->DR 作为
+ *          目的地址（DMA_DESC_DST_FIXED），一次启动完成整帧发送。
+ */
+
+#ifndef __DMA_CHAIN_H__
+#define __DMA_CHAIN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_manager.h"
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 描述符标志 */
+#define DMA_DESC_SRC_FIXED 0x01U /*!< 源地址不递增（如外设数据寄存器、填充值） */
+#define DMA_DESC_DST_FIXED 0x02U /*!< 目的地址不递增 */
+
+/** 返回值定义 */
+#define DMA_CHAIN_OK 0           /*!< 成功 */
+#define DMA_CHAIN_BUSY -1        /*!< 链正在执行 */
+#define DMA_CHAIN_PARAM_ERROR -2 /*!< 参数错误 */
+#define DMA_CHAIN_ERROR -3       /*!< 传输错误或下一段无法启动（仅出现在完成回调 status 中） */
+
+/* Exported types ------------------------------------------------------------*/
+
+struct DMA_Desc;
+struct DMA_Chain;
+
+/**
+ * @brief  单个描述符完成回调（中断上下文，下一段已经启动）
+ * @param  desc: 刚完成的描述符
+ * @param  ctx: 链的上下文
+ */
+typedef void (*DMA_DescCallback_t)(const struct DMA_Desc *desc, void *ctx);
+
+/**
+ * @brief  整条链完成回调（中断上下文）
+ * @param  chain: 链
+ * @param  status: DMA_CHAIN_OK 或 DMA_CHAIN_ERROR
+ */
+typedef void (*DMA_ChainDone_t)(struct DMA_Chain *chain, int status);
+
+/**
+ * @brief  描述符
+ * @note   len 以 DMA_Config_t 中配置的数据宽度为单位，必须为 1-65535
+ */
+typedef struct DMA_Desc {
+    uint32_t src;          /*!< 源地址 */
+    uint32_t dst;          /*!< 目的地址 */
+    uint16_t len;          /*!< 数据单元数 */
+    uint16_t flags;        /*!< DMA_DESC_xxx */
+    DMA_DescCallback_t cb; /*!< 本段完成回调（可为 NULL） */
+} DMA_Desc_t;
+
+/**
+ * @brief  描述符链运行时状态
+ */
+typedef struct DMA_Chain {
+    DMA_ChannelId_t ch;         /*!< 使用的通道（调用者已 DMA_Claim） */
+    DMA_Config_t cfg;           /*!< 通道模板：方向、宽度、优先级、M2M */
+    const DMA_Desc_t *desc;     /*!< 描述符数组 */
+    uint16_t count;             /*!< 描述符个数 */
+    volatile uint16_t index;    /*!< 正在执行的描述符下标 */
+    volatile uint8_t running;   /*!< 是否正在执行 */
+    volatile int status;        /*!< 最近一次执行结果 */
+    DMA_ChainDone_t done;       /*!< 整条链完成回调 */
+    void *ctx;                  /*!< 回调上下文 */
+} DMA_Chain_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  绑定通道并注册 TC/TE 回调
+ * @param  chain: 链
+ * @param  ch: 通道编号（必须已 DMA_Claim）
+ * @param  tmpl: 通道模板（地址、长度和增量位会被每个描述符覆盖）
+ * @retval DMA_CHAIN_OK / DMA_CHAIN_PARAM_ERROR
+ */
+int DMA_Chain_Init(DMA_Chain_t *chain, DMA_ChannelId_t ch,
+                   const DMA_Config_t *tmpl);
+
+/**
+ * @brief  启动一条描述符链
+ * @param  chain: 已初始化的链
+ * @param  desc: 描述符数组（执行完成前必须保持有效）
+ * @param  count: 描述符个数
+ * @param  done: 整条链完成回调（可为 NULL）
+ * @param  ctx: 回调上下文
+ * @retval DMA_CHAIN_OK / DMA_CHAIN_BUSY / DMA_CHAIN_PARAM_ERROR
+ */
+int DMA_Chain_Start(DMA_Chain_t *chain, const DMA_Desc_t *desc, uint16_t count,
+                    DMA_ChainDone_t done, void *ctx);
+
+/**
+ * @brief  中止正在执行的链（不调用完成回调）
+ */
+void DMA_Chain_Abort(DMA_Chain_t *chain);
+
+/**
+ * @brief  链是否正在执行
+ * @retval 1: 忙, 0: 空闲
+ */
+uint8_t DMA_Chain_IsBusy(const DMA_Chain_t *chain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DMA_CHAIN_H__ */
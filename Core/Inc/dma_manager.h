@@ -0,0 +1,206 @@
+/**
+ * @file    dma_manager.h
+ * @brief   DMA 通道管理器头文件
+ * @date    2026-10-18
+ *
+ * @note    在 DMA_Init / DMA_Cmd 之上统一管理 DMA1 (7 通道) 和 DMA2 (5 通道)：
+ *          - 通道占用登记，SPI/USART/I2C 等驱动先 DMA_Claim 再使用；
+ *          - TC/HT/TE 中断统一由 DMA_Manager_IRQHandler 分发到注册的回调；
+ *          - 每个通道维护忙标志、传输进度和收发计数。
+ */
+
+#ifndef __DMA_MANAGER_H__
+#define __DMA_MANAGER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  DMA 通道编号
+ */
+typedef enum {
+    DMA_CH_DMA1_1 = 0,
+    DMA_CH_DMA1_2,
+    DMA_CH_DMA1_3,
+    DMA_CH_DMA1_4,
+    DMA_CH_DMA1_5,
+    DMA_CH_DMA1_6,
+    DMA_CH_DMA1_7,
+    DMA_CH_DMA2_1,
+    DMA_CH_DMA2_2,
+    DMA_CH_DMA2_3,
+    DMA_CH_DMA2_4,
+    DMA_CH_DMA2_5,
+    DMA_CH_COUNT
+} DMA_ChannelId_t;
+
+/**
+ * @brief  DMA 事件回调
+ * @param  ch: 产生事件的通道
+ * @param  events: DMA_EVT_xxx 组合
+ * @param  ctx: 注册时传入的上下文
+ * @note   在中断上下文中调用
+ */
+typedef void (*DMA_Callback_t)(DMA_ChannelId_t ch, uint32_t events, void *ctx);
+
+/**
+ * @brief  通道统计信息
+ */
+typedef struct {
+    uint32_t started;   /*!< 启动的传输次数 */
+    uint32_t completed; /*!< 传输完成 (TC) 次数 */
+    uint32_t half;      /*!< 半传输 (HT) 次数 */
+    uint32_t errors;    /*!< 传输错误 (TE) 次数 */
+    uint32_t units;     /*!< 累计完成的数据单元数 */
+} DMA_ChannelStats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 事件位（与 ISR 中每通道 4 位的排列一致） */
+#define DMA_EVT_TC 0x02U /*!< 传输完成 */
+#define DMA_EVT_HT 0x04U /*!< 半传输 */
+#define DMA_EVT_TE 0x08U /*!< 传输错误 */
+
+/** 管理器返回值定义 */
+#define DMA_MGR_OK 0           /*!< 成功 */
+#define DMA_MGR_BUSY -1        /*!< 通道已被占用或正在传输 */
+#define DMA_MGR_NOT_OWNER -2   /*!< 通道未被占用 */
+#define DMA_MGR_PARAM_ERROR -3 /*!< 参数错误 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化管理器，绑定实际的 DMA1/DMA2 寄存器
+ * @retval DMA_MGR_OK / DMA_MGR_BUSY（仍有通道被占用，不做任何改动）
+ * @note   由 main() 在 MX_DMA_Init() 之后调用一次，会使能 DMA1/DMA2 时钟，
+ *         所有通道恢复为未占用状态；驱动和测试不应再调用，否则会抹掉
+ *         其他模块的占用
+ */
+int DMA_Manager_Init(void);
+
+/**
+ * @brief  绑定寄存器模型（用于在内存中的寄存器副本上做单元测试）
+ * @param  dma1: DMA1 ISR/IFCR 模型
+ * @param  dma1_ch: 7 个连续的 DMA1 通道寄存器模型
+ * @param  dma2: DMA2 ISR/IFCR 模型
+ * @param  dma2_ch: 5 个连续的 DMA2 通道寄存器模型
+ * @retval DMA_MGR_OK / DMA_MGR_BUSY（仍有通道被占用，不做任何改动）
+ * @note   模型模式下不操作 RCC 和 NVIC；用完后释放所有通道，再调用
+ *         DMA_Manager_Init() 恢复到实际寄存器
+ */
+int DMA_Manager_AttachModel(DMA_TypeDef *dma1, DMA_Channel_TypeDef *dma1_ch,
+                            DMA_TypeDef *dma2, DMA_Channel_TypeDef *dma2_ch);
+
+/**
+ * @brief  占用一个通道
+ * @param  ch: 通道编号
+ * @param  owner: 占用者名称（调试用，可为 NULL）
+ * @retval DMA_MGR_OK / DMA_MGR_BUSY / DMA_MGR_PARAM_ERROR
+ */
+int DMA_Claim(DMA_ChannelId_t ch, const char *owner);
+
+/**
+ * @brief  释放通道（会先中止正在进行的传输）
+ * @param  ch: 通道编号
+ */
+void DMA_Release(DMA_ChannelId_t ch);
+
+/**
+ * @brief  查询通道占用者
+ * @retval 占用者名称，未占用返回 NULL
+ */
+const char *DMA_GetOwner(DMA_ChannelId_t ch);
+
+/**
+ * @brief  获取通道寄存器指针
+ * @retval 通道寄存器指针，参数错误返回 NULL
+ */
+DMA_Channel_TypeDef *DMA_GetInstance(DMA_ChannelId_t ch);
+
+/**
+ * @brief  注册事件回调
+ * @param  ch: 通道编号（必须已占用）
+ * @param  cb: 回调函数（NULL 表示仅统计不回调）
+ * @param  ctx: 回调上下文
+ * @param  events: 需要的事件 DMA_EVT_xxx，决定 CCR 中 TCIE/HTIE/TEIE
+ * @retval DMA_MGR_OK / DMA_MGR_NOT_OWNER / DMA_MGR_PARAM_ERROR
+ */
+int DMA_SetCallback(DMA_ChannelId_t ch, DMA_Callback_t cb, void *ctx,
+                    uint32_t events);
+
+/**
+ * @brief  配置并启动一次传输
+ * @param  ch: 通道编号（必须已占用）
+ * @param  cfg: 通道配置（同 DMA_Init）
+ * @retval DMA_MGR_OK / DMA_MGR_BUSY / DMA_MGR_NOT_OWNER / DMA_MGR_PARAM_ERROR
+ */
+int DMA_StartTransfer(DMA_ChannelId_t ch, DMA_Config_t *cfg);
+
+/**
+ * @brief  不经 DMA_Init 的快速重装：只改地址、长度和增量位后重新使能
+ * @param  ch: 通道编号（必须已占用且当前空闲）
+ * @param  cpar: 新的 CPAR
+ * @param  cmar: 新的 CMAR
+ * @param  count: 新的 CNDTR（必须非 0）
+ * @param  inc: DMA_CCR_PINC / DMA_CCR_MINC 组合，替换原有增量设置
+ * @retval DMA_MGR_OK / DMA_MGR_BUSY / DMA_MGR_NOT_OWNER / DMA_MGR_PARAM_ERROR
+ * @note   CCR 其余位（方向、宽度、优先级、中断使能）沿用上一次 DMA_StartTransfer
+ *         的配置，适合在 TC 回调中背靠背地接续下一段传输
+ */
+int DMA_Restart(DMA_ChannelId_t ch, uint32_t cpar, uint32_t cmar,
+                uint16_t count, uint32_t inc);
+
+/**
+ * @brief  修改正在进行的传输上打开的中断事件
+ * @param  ch: 通道编号（必须已占用）
+ * @param  events: 新的事件组合，0 表示关闭全部中断
+ * @retval DMA_MGR_OK / DMA_MGR_NOT_OWNER / DMA_MGR_PARAM_ERROR
+ * @note   新打开的事件先清除残留标志，不会因为之前积累的标志立即进中断；
+ *         单次传输的 TC 总会打开（维护忙标志），循环传输只打开指定的事件，
+ *         用于平时只开 TE、只在需要时等待下一个 HT / TC
+ */
+int DMA_SetEvents(DMA_ChannelId_t ch, uint32_t events);
+
+/**
+ * @brief  中止传输
+ * @param  ch: 通道编号
+ */
+void DMA_AbortTransfer(DMA_ChannelId_t ch);
+
+/**
+ * @brief  通道是否正在传输
+ * @retval 1: 忙, 0: 空闲
+ */
+uint8_t DMA_IsBusy(DMA_ChannelId_t ch);
+
+/**
+ * @brief  当前传输已完成的数据单元数
+ * @retval 已完成单元数（空闲时为上一次传输的总长度）
+ */
+uint16_t DMA_GetProgress(DMA_ChannelId_t ch);
+
+/**
+ * @brief  获取通道统计信息
+ * @retval DMA_MGR_OK / DMA_MGR_PARAM_ERROR
+ */
+int DMA_GetStats(DMA_ChannelId_t ch, DMA_ChannelStats_t *stats);
+
+/**
+ * @brief  通道中断处理：读取并清除标志，更新计数并调用回调
+ * @param  ch: 通道编号
+ * @note   由 DMAx_Channely_IRQHandler 调用，也可在轮询时直接调用
+ */
+void DMA_Manager_IRQHandler(DMA_ChannelId_t ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DMA_MANAGER_H__ */
@@ -0,0 +1,117 @@
+/**
+ * @file    dma_mem.h
+ * @brief   基于 MEM2MEM DMA 通道的异步 memcpy / memset 头文件
+ * @date    2026-10-18
+ *
+ * @note    - 每次传输按源/目的地址对齐情况自动选择字 / 半字 / 字节宽度，
+ *            主体按宽度搬运，剩余的尾部字节作为下一段继续搬运；
+ *          - 单段超过 CNDTR 上限 (65535 个单元) 时自动拆分；
+ *          - 请求排队执行，前一个完成后在 TC 中断里立即启动下一个，
+ *            通道始终保持忙碌；
+ *          - 完成回调在中断上下文中执行。
+ */
+
+#ifndef __DMA_MEM_H__
+#define __DMA_MEM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_manager.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  请求完成回调
+ * @param  status: DMA_MEM_OK 或 DMA_MEM_ERROR（传输错误）
+ * @param  ctx: 提交请求时传入的上下文
+ */
+typedef void (*dma_mem_callback_t)(int status, void *ctx);
+
+/* Exported constants --------------------------------------------------------*/
+
+/**
+ * 使用的 DMA 通道：MEM2MEM 不依赖外设请求，任意通道都可以；DMA1 通道 1
+ * 是 ADC1 唯一的请求通道（adc_scan），默认改用空闲的 DMA2 通道 2
+ */
+#ifndef DMA_MEM_CHANNEL
+#define DMA_MEM_CHANNEL DMA_CH_DMA2_2
+#endif
+
+/** 请求队列深度 */
+#ifndef DMA_MEM_QUEUE_LEN
+#define DMA_MEM_QUEUE_LEN 8
+#endif
+
+/** 返回值定义 */
+#define DMA_MEM_OK 0           /*!< 成功 */
+#define DMA_MEM_QUEUE_FULL -1  /*!< 请求队列已满 */
+#define DMA_MEM_PARAM_ERROR -2 /*!< 参数错误或未初始化 */
+#define DMA_MEM_ERROR -3       /*!< 传输错误（仅出现在回调 status 中） */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化：占用 DMA_MEM_CHANNEL 并注册 TC/TE 回调
+ * @retval DMA_MEM_OK / DMA_MEM_PARAM_ERROR（通道已被占用）
+ * @note   需在 DMA_Manager_Init() 之后调用
+ */
+int dma_mem_init(void);
+
+/**
+ * @brief  释放通道，丢弃未执行的请求
+ */
+void dma_mem_deinit(void);
+
+/**
+ * @brief  异步内存复制
+ * @param  dst: 目的地址
+ * @param  src: 源地址（SRAM 或 Flash）
+ * @param  len: 字节数
+ * @param  cb: 完成回调（可为 NULL）
+ * @param  ctx: 回调上下文
+ * @retval DMA_MEM_OK / DMA_MEM_QUEUE_FULL / DMA_MEM_PARAM_ERROR
+ * @note   完成回调之前不得修改 src 或读取 dst
+ */
+int dma_memcpy_async(void *dst, const void *src, size_t len,
+                     dma_mem_callback_t cb, void *ctx);
+
+/**
+ * @brief  异步内存填充
+ * @param  dst: 目的地址
+ * @param  value: 填充字节
+ * @param  len: 字节数
+ * @param  cb: 完成回调（可为 NULL）
+ * @param  ctx: 回调上下文
+ * @retval DMA_MEM_OK / DMA_MEM_QUEUE_FULL / DMA_MEM_PARAM_ERROR
+ */
+int dma_memset_async(void *dst, uint8_t value, size_t len,
+                     dma_mem_callback_t cb, void *ctx);
+
+/**
+ * @brief  是否还有未完成的请求
+ * @retval 1: 忙, 0: 空闲
+ */
+uint8_t dma_mem_busy(void);
+
+/**
+ * @brief  等待所有请求完成
+ * @note   依赖 DMA 中断推进队列，不能在关中断或更高优先级中断中调用
+ */
+void dma_mem_wait(void);
+
+/**
+ * @brief  修改单段最大单元数（默认 65535，仅用于测试拆分逻辑）
+ * @param  units: 单段最大单元数（0 恢复默认）
+ */
+void dma_mem_set_max_units(uint16_t units);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DMA_MEM_H__ */
@@ -0,0 +1,192 @@
+/**
+ * @file    dsp.h
+ * @brief   定点 DSP 核（Q15 / Q31：FIR、抽取、级联双二阶 IIR、滑动 RMS、峰值检测）头文件
+ * @date    2026-10-18
+ *
+ * @note    - Cortex-M3 没有 FPU，全部运算为整数：乘加用 64 位累加器，编译
+ *            为 SMULL / SMLAL，内层循环按 4 展开；
+ *          - 舍入统一为"加半再算术右移"（向正无穷的四舍五入），结果饱和；
+ *            每个核的输出都可以用 double 按同样的舍入精确复现（乘积与累加
+ *            均不超过 53 位），测试逐样本比对；
+ *          - FIR / 抽取：Q15 数据 × Q15 系数，累加后右移 15；
+ *          - 双二阶：Q31 数据与状态 × Q14 系数（可表示 [-2, 2)，低通 / 高通
+ *            的 a1 需要），直接 I 型，累加后右移 14；32 × 16 位乘法让 double
+ *            参考可以精确复现，同时状态保持 31 位精度；
+ *          - 块处理：in 与 out 可以是同一个缓冲区（FIR 为原位时 n 不超过
+ *            max_block 即可）；
+ *          - 每个实例的状态由调用者提供，不使用动态内存，实例之间互不影响。
+ */
+
+#ifndef __DSP_H__
+#define __DSP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+/**
+ * @brief  Q15 FIR
+ */
+typedef struct {
+    const q15_t *coeffs; /*!< 系数 h[0..num_taps-1]，y[n] = Σ h[k] x[n-k] */
+    q15_t *state;        /*!< DSP_FIR_STATE_LEN(num_taps, max_block) 个元素 */
+    uint16_t num_taps;
+    uint16_t max_block;
+} dsp_fir_q15_t;
+
+/**
+ * @brief  Q15 FIR 抽取器（只计算保留下来的输出）
+ */
+typedef struct {
+    dsp_fir_q15_t fir;
+    uint8_t factor;
+} dsp_decim_q15_t;
+
+/**
+ * @brief  Q31 级联双二阶 IIR（直接 I 型）
+ */
+typedef struct {
+    const int16_t *coeffs; /*!< 每级 {b0, b1, b2, a1, a2}，Q14 */
+    q31_t *state;          /*!< 每级 {x1, x2, y1, y2}，4 × stages 个元素 */
+    uint8_t stages;
+} dsp_biquad_q31_t;
+
+/**
+ * @brief  Q15 滑动窗口 RMS
+ */
+typedef struct {
+    q15_t *window;  /*!< 最近 len 个采样（环形） */
+    uint64_t sumsq; /*!< 窗口内平方和，Q30 */
+    uint16_t len;
+    uint16_t pos;
+} dsp_rms_q15_t;
+
+/**
+ * @brief  Q15 峰值检测（立即上升，指数下降）
+ */
+typedef struct {
+    q15_t env;             /*!< 当前包络 */
+    uint8_t release_shift; /*!< 每个采样下降 env / 2^shift */
+} dsp_peak_q15_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** FIR 状态缓冲区长度 */
+#define DSP_FIR_STATE_LEN(taps, block) ((uint32_t)(taps) + (uint32_t)(block) - 1U)
+
+/** 双二阶系数的小数位数 */
+#define DSP_BIQUAD_SHIFT 14
+
+/** 返回值定义 */
+#define DSP_OK 0           /*!< 成功 */
+#define DSP_PARAM_ERROR -1 /*!< 参数错误 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化 FIR，状态清零
+ * @param  s: 实例
+ * @param  coeffs: 系数（调用期间保持有效）
+ * @param  num_taps: 阶数 + 1，非 0
+ * @param  state: 状态缓冲区
+ * @param  max_block: 单次 dsp_fir_q15 最多处理的采样数，非 0
+ * @retval DSP_OK / DSP_PARAM_ERROR
+ */
+int dsp_fir_q15_init(dsp_fir_q15_t *s, const q15_t *coeffs, uint16_t num_taps,
+                     q15_t *state, uint16_t max_block);
+
+/**
+ * @brief  FIR 处理一块
+ * @param  n: 采样数，不超过 max_block
+ */
+void dsp_fir_q15(dsp_fir_q15_t *s, const q15_t *in, q15_t *out, uint16_t n);
+
+/**
+ * @brief  初始化抽取器
+ * @param  factor: 抽取倍数，非 0，且整除 max_block
+ * @retval DSP_OK / DSP_PARAM_ERROR
+ */
+int dsp_decim_q15_init(dsp_decim_q15_t *s, uint8_t factor, const q15_t *coeffs,
+                       uint16_t num_taps, q15_t *state, uint16_t max_block);
+
+/**
+ * @brief  抽取处理一块：输出 y[factor - 1], y[2 factor - 1], ...
+ * @param  n: 输入采样数，factor 的整数倍且不超过 max_block
+ * @retval 输出采样数（n / factor），参数错误时为 DSP_PARAM_ERROR
+ */
+int dsp_decim_q15(dsp_decim_q15_t *s, const q15_t *in, q15_t *out, uint16_t n);
+
+/**
+ * @brief  初始化级联双二阶，状态清零
+ * @param  stages: 级数，非 0
+ * @param  coeffs: 5 × stages 个 Q14 系数
+ * @param  state: 4 × stages 个元素
+ * @retval DSP_OK / DSP_PARAM_ERROR
+ */
+int dsp_biquad_q31_init(dsp_biquad_q31_t *s, uint8_t stages, const int16_t *coeffs,
+                        q31_t *state);
+
+/**
+ * @brief  级联双二阶处理一块
+ * @note   y = (b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2) >> 14，逐级饱和
+ */
+void dsp_biquad_q31(dsp_biquad_q31_t *s, const q31_t *in, q31_t *out, uint32_t n);
+
+/**
+ * @brief  初始化滑动 RMS，窗口清零
+ * @param  window: len 个元素
+ * @param  len: 窗口长度，非 0
+ * @retval DSP_OK / DSP_PARAM_ERROR
+ */
+int dsp_rms_q15_init(dsp_rms_q15_t *s, q15_t *window, uint16_t len);
+
+/**
+ * @brief  推入一块采样，返回最近 len 个采样的 RMS
+ * @retval floor(sqrt(floor(Σx² / len)))，Q15
+ */
+q15_t dsp_rms_q15(dsp_rms_q15_t *s, const q15_t *in, uint32_t n);
+
+/**
+ * @brief  初始化峰值检测
+ * @param  release_shift: 1~15，越大下降越慢
+ * @retval DSP_OK / DSP_PARAM_ERROR
+ */
+int dsp_peak_q15_init(dsp_peak_q15_t *s, uint8_t release_shift);
+
+/**
+ * @brief  推入一块采样，返回包络
+ * @note   每个采样：env = max(|x|, env - ceil(env / 2^shift))
+ */
+q15_t dsp_peak_q15(dsp_peak_q15_t *s, const q15_t *in, uint32_t n);
+
+/**
+ * @brief  Q15 转 Q31（左移 16）
+ */
+void dsp_q15_to_q31(const q15_t *in, q31_t *out, uint32_t n);
+
+/**
+ * @brief  Q31 转 Q15（舍入并饱和）
+ */
+void dsp_q31_to_q15(const q31_t *in, q15_t *out, uint32_t n);
+
+/**
+ * @brief  整数平方根（向下取整）
+ * @note   结果不超过 65535，只用移位和加减，没有除法
+ */
+uint32_t dsp_isqrt(uint32_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DSP_H__ */
+
+/************************ END OF FILE *****************************************/
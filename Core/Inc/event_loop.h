@@ -0,0 +1,247 @@
+/**
+ * @file    event_loop.h
+ * @brief   协作式事件循环（run-to-completion）头文件
+ * @date    2026-10-18
+ *
+ * @note    - 每个任务有一个优先级（0-EV_MAX_PRIORITIES-1，数值大的先执行，
+ *            每个优先级一个任务）和一个事件环形队列；
+ *          - ev_post 可在中断或线程中调用，只入队并置就绪位；处理函数总在
+ *            线程模式由 ev_run 调用，一次处理一个事件，执行完才调度下一个；
+ *          - ev_defer 把一段工作（函数 + 参数）从中断推迟到线程模式执行，
+ *            优先于所有任务；
+ *          - 就绪位图用 CLZ 找最高优先级，调度 O(1)；
+ *          - 每个任务统计处理次数、DWT 周期数和单次最大周期数，
+ *            ev_report 按 HAL 节拍折算 CPU 占用率；
+ *          - 无事可做时调用空闲钩子（默认 tickless_idle），关中断检查
+ *            就绪位后再睡眠，不会漏掉刚投递的事件；
+ *          - 驱动完成通知：ev_timer 把时间轮到期转成事件，
+ *            ev_post_completion 可直接作为 dma_mem / spi_bus 的完成回调，
+ *            USART1 接收空闲见 usart_set_rx_event()。
+ */
+
+#ifndef __EVENT_LOOP_H__
+#define __EVENT_LOOP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "timer_wheel.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  事件
+ */
+typedef struct {
+    uint16_t sig;   /*!< 信号（EV_SIG_USER 起由应用定义） */
+    uint16_t flags; /*!< 保留 */
+    uint32_t param; /*!< 参数：状态码、长度、节拍等 */
+    void *ptr;      /*!< 附带的指针 */
+} ev_event_t;
+
+typedef struct ev_task ev_task_t;
+
+/**
+ * @brief  事件处理函数（线程模式，执行完才返回调度器）
+ */
+typedef void (*ev_handler_t)(ev_task_t *task, const ev_event_t *ev);
+
+/**
+ * @brief  推迟到线程模式执行的工作
+ */
+typedef void (*ev_work_t)(void *arg);
+
+/**
+ * @brief  运行统计
+ */
+typedef struct {
+    uint32_t handled;    /*!< 已处理事件数 */
+    uint32_t dropped;    /*!< 队列满丢弃的事件数 */
+    uint32_t peak;       /*!< 队列最高水位 */
+    uint32_t max_cycles; /*!< 单次处理最大周期数 */
+    uint64_t cycles;     /*!< 处理累计周期数 */
+} ev_stats_t;
+
+/**
+ * @brief  任务（成员由本模块维护）
+ */
+struct ev_task {
+    const char *name;     /*!< 名称 */
+    ev_handler_t handler; /*!< 处理函数 */
+    void *ctx;            /*!< 应用上下文 */
+    ev_event_t *queue;    /*!< 队列存储 */
+    uint16_t len;         /*!< 队列长度 */
+    uint16_t head;        /*!< 下一个空位 */
+    uint16_t tail;        /*!< 下一个要处理的事件 */
+    uint16_t count;       /*!< 队列中的事件数 */
+    uint8_t prio;         /*!< 优先级 */
+    ev_stats_t stats;     /*!< 统计 */
+};
+
+/**
+ * @brief  时间轮到期后向任务投递事件的定时器
+ */
+typedef struct {
+    tw_timer_t tw;   /*!< 时间轮节点 */
+    ev_task_t *task; /*!< 目标任务 */
+    uint16_t sig;    /*!< 信号，param 为到期时的 tw_now() */
+} ev_timer_t;
+
+/**
+ * @brief  完成回调绑定（ev_post_completion 的 ctx）
+ */
+typedef struct {
+    ev_task_t *task; /*!< 目标任务 */
+    uint16_t sig;    /*!< 信号，param 为完成状态 */
+    void *ptr;       /*!< 原样放入事件的 ptr */
+} ev_completion_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 优先级个数（不超过 32） */
+#ifndef EV_MAX_PRIORITIES
+#define EV_MAX_PRIORITIES 16
+#endif
+
+/** 推迟工作队列长度 */
+#ifndef EV_DEFER_LEN
+#define EV_DEFER_LEN 16
+#endif
+
+/** 应用信号起始值，之前的保留 */
+#define EV_SIG_USER 16U
+
+/** 返回值定义 */
+#define EV_OK 0            /*!< 成功 */
+#define EV_QUEUE_FULL -1   /*!< 队列已满，事件被丢弃 */
+#define EV_PARAM_ERROR -2  /*!< 参数错误或优先级已被占用 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化调度器：清空任务表和推迟队列，空闲钩子恢复为 tickless_idle
+ */
+void ev_init(void);
+
+/**
+ * @brief  注册任务
+ * @param  task: 任务（静态分配）
+ * @param  name: 名称（ev_report 中显示）
+ * @param  prio: 优先级，0-EV_MAX_PRIORITIES-1，每个优先级只能注册一个任务
+ * @param  handler: 处理函数
+ * @param  ctx: 应用上下文（task->ctx）
+ * @param  queue: 队列存储
+ * @param  len: 队列长度（事件个数）
+ * @retval EV_OK / EV_PARAM_ERROR
+ */
+int ev_task_init(ev_task_t *task, const char *name, uint8_t prio,
+                 ev_handler_t handler, void *ctx, ev_event_t *queue,
+                 uint16_t len);
+
+/**
+ * @brief  注销任务，丢弃队列中的事件
+ */
+void ev_task_remove(ev_task_t *task);
+
+/**
+ * @brief  投递事件（中断或线程中调用）
+ * @param  task: 目标任务
+ * @param  sig: 信号
+ * @param  param: 参数
+ * @param  ptr: 指针
+ * @retval EV_OK / EV_QUEUE_FULL / EV_PARAM_ERROR
+ */
+int ev_post(ev_task_t *task, uint16_t sig, uint32_t param, void *ptr);
+
+/**
+ * @brief  把工作推迟到线程模式执行（中断或线程中调用）
+ * @retval EV_OK / EV_QUEUE_FULL / EV_PARAM_ERROR
+ */
+int ev_defer(ev_work_t work, void *arg);
+
+/**
+ * @brief  处理一个推迟的工作或最高优先级任务的一个事件
+ * @retval 1 处理了一项，0 无事可做
+ */
+int ev_run_once(void);
+
+/**
+ * @brief  处理到没有事件为止
+ * @retval 处理的项数
+ */
+uint32_t ev_run_until_idle(void);
+
+/**
+ * @brief  主循环：处理事件，无事可做时调用空闲钩子；ev_stop() 后返回
+ */
+void ev_run(void);
+
+/**
+ * @brief  让 ev_run 在当前事件处理完后返回（可在处理函数或中断中调用）
+ */
+void ev_stop(void);
+
+/**
+ * @brief  是否有未处理的事件或推迟的工作
+ */
+int ev_pending(void);
+
+/**
+ * @brief  设置空闲钩子
+ * @param  hook: 关中断状态下调用，应执行 WFI 一类等待中断的操作；
+ *         NULL 表示恢复默认的 tickless_idle
+ */
+void ev_set_idle_hook(void (*hook)(void));
+
+/**
+ * @brief  推迟工作的统计
+ */
+const ev_stats_t *ev_defer_stats(void);
+
+/**
+ * @brief  清零所有统计，开始新的统计窗口
+ */
+void ev_reset_stats(void);
+
+/**
+ * @brief  打印各任务的事件数、周期数和 CPU 占用率
+ */
+void ev_report(void);
+
+/**
+ * @brief  启动事件定时器：到期时向 task 投递 sig
+ * @param  timer: 定时器
+ * @param  task: 目标任务
+ * @param  sig: 信号
+ * @param  delay: 首次到期节拍数
+ * @param  period: 周期，0 表示单次
+ * @retval TW_OK / TW_PARAM_ERROR
+ * @note   timer 须为静态（零初始化）或之前用过的定时器
+ */
+int ev_timer_start(ev_timer_t *timer, ev_task_t *task, uint16_t sig,
+                   uint32_t delay, uint32_t period);
+
+/**
+ * @brief  停止事件定时器（已投递的事件不撤回）
+ */
+int ev_timer_stop(ev_timer_t *timer);
+
+/**
+ * @brief  通用完成回调：向绑定的任务投递事件，param 为 status
+ * @param  status: 驱动给出的完成状态
+ * @param  ctx: ev_completion_t
+ * @note   签名与 dma_mem_callback_t / spi_xfer_cb_t 相同
+ */
+void ev_post_completion(int status, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EVENT_LOOP_H__ */
+
+/************************ END OF FILE *****************************************/
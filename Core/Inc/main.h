@@ -46,7 +46,18 @@ extern "C" {
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
-
+/**
+ * @brief  把函数放进 RAM（.ramfunc 段，启动时随 .data 从 Flash 复制）
+ * @note   72 MHz 下 Flash 有 2 个等待周期，每次跳转后的取指都要等待，
+ *         RAM 取指没有等待周期；只用于中断和紧凑的轮询 / 复制循环。
+ *         从 Flash 调用时由链接器插入长跳转 veneer。主机构建放进
+ *         sim_ramfunc 段，仿真器对其中的代码不计 Flash 等待周期
+ */
+#if defined(STM32_HOST_BUILD)
+#define RAMFUNC __attribute__((section("sim_ramfunc"), noinline))
+#else
+#define RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#endif
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
@@ -0,0 +1,173 @@
+/**
+ * @file    mem_pool.h
+ * @brief   固定块内存池与作用域 arena 头文件
+ * @date    2026-10-18
+ *
+ * @note    - 每个尺寸类一块静态存储，切成等长的块，空闲块串成单链表，
+ *            分配 / 释放都是 O(1)（释放时按地址范围找尺寸类，类数是常数）；
+ *          - 尺寸类由 MEM_POOL_CLASSES 配置（块大小, 块数），本类用完时
+ *            依次借用更大的类；
+ *          - 每个类统计当前占用、占用高水位、分配次数、借用和失败次数；
+ *          - arena 在一段缓冲区上顺序分配，mark / release 成对使用，
+ *            一次事务结束后整段归还，适合临时缓冲区；
+ *          - 定义 MEM_POOL_MALLOC 后 newlib 的 malloc / free / realloc /
+ *            calloc（含 printf 内部的分配）都走内存池，_sbrk 不再分配堆。
+ */
+
+#ifndef __MEM_POOL_H__
+#define __MEM_POOL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  尺寸类统计
+ */
+typedef struct {
+    uint16_t block_size; /*!< 块大小（字节） */
+    uint16_t blocks;     /*!< 块数 */
+    uint16_t used;       /*!< 当前占用块数 */
+    uint16_t peak;       /*!< 占用高水位 */
+    uint32_t allocs;     /*!< 从本类分配的次数 */
+    uint32_t borrowed;   /*!< 其中请求大小属于更小的类的次数 */
+    uint32_t failures;   /*!< 请求大小属于本类但所有可用类都已用完的次数 */
+    uint32_t requested;  /*!< 当前占用块的请求字节数之和（算内部碎片） */
+} mem_pool_stats_t;
+
+/**
+ * @brief  arena（成员由本模块维护）
+ */
+typedef struct {
+    uint8_t *base;   /*!< 缓冲区 */
+    size_t size;     /*!< 缓冲区大小 */
+    size_t used;     /*!< 已分配（含对齐） */
+    size_t peak;     /*!< 高水位 */
+    uint32_t fails;  /*!< 空间不足次数 */
+} mem_arena_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/**
+ * @brief  尺寸类配置：X(块大小, 块数)，块大小从小到大，须为 8 的倍数
+ * @note   默认共 3 KB，可在编译选项中整体替换
+ */
+#ifndef MEM_POOL_CLASSES
+#define MEM_POOL_CLASSES(X) \
+    X(16, 32)               \
+    X(32, 24)               \
+    X(64, 12)               \
+    X(128, 6)               \
+    X(256, 3)
+#endif
+
+/** 分配的对齐字节数 */
+#define MEM_ALIGN 8U
+
+/** 返回值定义 */
+#define MEM_OK 0            /*!< 成功 */
+#define MEM_PARAM_ERROR -1  /*!< 参数错误 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化内存池：所有块放回空闲链表，统计清零
+ * @note   之前分配的块全部作废；MEM_POOL_MALLOC 下首次 malloc 时自动调用
+ */
+void mem_pool_init(void);
+
+/**
+ * @brief  分配
+ * @param  size: 字节数
+ * @retval 块地址（MEM_ALIGN 对齐），size 为 0、过大或池已用完时返回 NULL
+ * @note   中断和线程中都可调用
+ */
+void *mem_alloc(size_t size);
+
+/**
+ * @brief  释放
+ * @param  ptr: mem_alloc 返回的地址，NULL 忽略；不属于内存池的地址计入
+ *         mem_pool_invalid_frees() 并忽略
+ */
+void mem_free(void *ptr);
+
+/**
+ * @brief  调整大小：原块放得下时原地返回，否则分配新块并复制
+ */
+void *mem_realloc(void *ptr, size_t size);
+
+/**
+ * @brief  ptr 所在块的可用大小（块大小），不属于内存池时返回 0
+ */
+size_t mem_block_size(const void *ptr);
+
+/**
+ * @brief  尺寸类个数
+ */
+uint32_t mem_pool_class_count(void);
+
+/**
+ * @brief  读取第 index 个尺寸类的统计
+ * @retval MEM_OK / MEM_PARAM_ERROR
+ */
+int mem_pool_get_stats(uint32_t index, mem_pool_stats_t *stats);
+
+/**
+ * @brief  非法释放（地址不属于内存池或不在块边界上）的次数
+ */
+uint32_t mem_pool_invalid_frees(void);
+
+/**
+ * @brief  清零分配次数 / 借用 / 失败统计，高水位重置为当前占用
+ */
+void mem_pool_reset_stats(void);
+
+/**
+ * @brief  打印各尺寸类的占用、高水位和内部碎片
+ */
+void mem_pool_report(void);
+
+/**
+ * @brief  在缓冲区上初始化 arena
+ * @param  arena: arena
+ * @param  buf: 缓冲区（静态数组或一个内存池块）
+ * @param  size: 缓冲区大小
+ * @retval MEM_OK / MEM_PARAM_ERROR
+ */
+int mem_arena_init(mem_arena_t *arena, void *buf, size_t size);
+
+/**
+ * @brief  从 arena 顺序分配（MEM_ALIGN 对齐），空间不足返回 NULL
+ * @note   不可在中断中对同一个 arena 分配
+ */
+void *mem_arena_alloc(mem_arena_t *arena, size_t size);
+
+/**
+ * @brief  记下当前位置，作为一次事务的开始
+ */
+size_t mem_arena_mark(const mem_arena_t *arena);
+
+/**
+ * @brief  回到 mark 的位置，其后分配的缓冲区全部归还
+ */
+void mem_arena_release(mem_arena_t *arena, size_t mark);
+
+/**
+ * @brief  清空 arena（等价于 release 到 0）
+ */
+void mem_arena_reset(mem_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_POOL_H__ */
+
+/************************ END OF FILE *****************************************/
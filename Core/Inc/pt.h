@@ -0,0 +1,161 @@
+/**
+ * @file    pt.h
+ * @brief   无栈协程（protothread）宏
+ * @date    2026-10-18
+ *
+ * @note    - 协程就是一个返回 int 的普通函数，续点（行号）保存在 pt_t 里，
+ *            每次调用从上次等待的位置继续，直到 PT_END 返回 PT_ENDED；
+ *          - 所有协程共用调用者的栈，每个协程只占一个 pt_t 加上自己的
+ *            上下文结构，适合同时挂起很多驱动操作；
+ *          - 等待原语：PT_WAIT_UNTIL 等条件，PT_AWAIT_EVENT 等中断置位的
+ *            标志，PT_AWAIT / PT_AWAIT_TIMEOUT 带 HAL 节拍超时，PT_DELAY
+ *            延时，PT_SPAWN 等子协程结束；
+ *          - 续点基于 switch / case（C11 可移植），因此：
+ *            1. 局部变量在等待之后不保留，需要跨等待的状态放进上下文结构；
+ *            2. 协程体里不能再写 switch 语句；
+ *            3. 同一行不能出现两个等待宏（续点用 __LINE__ 区分）。
+ */
+
+#ifndef __PT_H__
+#define __PT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  协程控制块
+ */
+typedef struct {
+    uint16_t lc;       /*!< 续点，0 表示从头开始 */
+    uint8_t timed_out; /*!< 最近一次 PT_AWAIT 是否因超时结束 */
+    uint32_t deadline; /*!< PT_AWAIT / PT_DELAY 的截止节拍（HAL_GetTick） */
+} pt_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 协程返回值 */
+#define PT_WAITING 0 /*!< 在等待条件 */
+#define PT_YIELDED 1 /*!< 主动让出 */
+#define PT_EXITED 2  /*!< PT_EXIT 提前结束 */
+#define PT_ENDED 3   /*!< 执行到 PT_END */
+
+/* Exported macro ------------------------------------------------------------*/
+
+/** 初始化（或复位）协程 */
+#define PT_INIT(pt)                                                            \
+    do {                                                                       \
+        (pt)->lc = 0;                                                          \
+        (pt)->timed_out = 0;                                                   \
+    } while (0)
+
+/** 协程体开始 */
+#define PT_BEGIN(pt)                                                           \
+    {                                                                          \
+        int pt_yield_flag = 1;                                                 \
+        (void)pt_yield_flag;                                                   \
+        switch ((pt)->lc) {                                                    \
+        case 0:
+
+/** 协程体结束，之后再调用从头开始 */
+#define PT_END(pt)                                                             \
+    }                                                                          \
+    PT_INIT(pt);                                                               \
+    return PT_ENDED;                                                           \
+    }
+
+/** 等到 cond 为真 */
+#define PT_WAIT_UNTIL(pt, cond)                                                \
+    do {                                                                       \
+        (pt)->lc = __LINE__;                                                   \
+    case __LINE__:                                                             \
+        if (!(cond)) {                                                         \
+            return PT_WAITING;                                                 \
+        }                                                                      \
+    } while (0)
+
+/** 等到 cond 为假 */
+#define PT_WAIT_WHILE(pt, cond) PT_WAIT_UNTIL(pt, !(cond))
+
+/** 让出一次，下次调用时继续 */
+#define PT_YIELD(pt)                                                           \
+    do {                                                                       \
+        pt_yield_flag = 0;                                                     \
+        (pt)->lc = __LINE__;                                                   \
+    case __LINE__:                                                             \
+        if (pt_yield_flag == 0) {                                              \
+            return PT_YIELDED;                                                 \
+        }                                                                      \
+    } while (0)
+
+/** 提前结束 */
+#define PT_EXIT(pt)                                                            \
+    do {                                                                       \
+        PT_INIT(pt);                                                           \
+        return PT_EXITED;                                                      \
+    } while (0)
+
+/** 等待中断置位的事件标志（volatile uint8_t），并清除它 */
+#define PT_AWAIT_EVENT(pt, flag)                                               \
+    do {                                                                       \
+        PT_WAIT_UNTIL(pt, (flag) != 0);                                        \
+        (flag) = 0;                                                            \
+    } while (0)
+
+/** 设置 ms 毫秒后的截止时间，供之后的 PT_AWAIT 共用 */
+#define PT_DEADLINE(pt, ms)                                                    \
+    do {                                                                       \
+        (pt)->deadline = HAL_GetTick() + (ms);                                 \
+        (pt)->timed_out = 0;                                                   \
+    } while (0)
+
+/** 等到 cond 为真或截止时间到，超时后 (pt)->timed_out 为 1 */
+#define PT_AWAIT(pt, cond)                                                     \
+    PT_WAIT_UNTIL(pt, (cond) || ((pt)->timed_out = pt_expired(pt)) != 0)
+
+/** 最多等 ms 毫秒 */
+#define PT_AWAIT_TIMEOUT(pt, cond, ms)                                         \
+    do {                                                                       \
+        PT_DEADLINE(pt, ms);                                                   \
+        PT_AWAIT(pt, cond);                                                    \
+    } while (0)
+
+/** 延时 ms 毫秒（节拍精度，ms 为 0 时不等待） */
+#define PT_DELAY(pt, ms)                                                       \
+    do {                                                                       \
+        PT_DEADLINE(pt, ms);                                                   \
+        PT_WAIT_UNTIL(pt, pt_expired(pt));                                     \
+    } while (0)
+
+/** 初始化子协程 child 并等它结束，thread 为调用子协程的表达式 */
+#define PT_SPAWN(pt, child, thread)                                            \
+    do {                                                                       \
+        PT_INIT(child);                                                        \
+        PT_WAIT_UNTIL(pt, (thread) >= PT_EXITED);                              \
+    } while (0)
+
+/** 协程是否还在运行（用于调度循环） */
+#define PT_RUNNING(thread) ((thread) < PT_EXITED)
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  截止时间是否已到
+ */
+static inline int pt_expired(const pt_t *pt) {
+    return (int32_t)(HAL_GetTick() - pt->deadline) >= 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PT_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,116 @@
+/**
+ * @file    ram_monitor.h
+ * @brief   栈 / 堆高水位统计与栈溢出保护字检查头文件
+ * @date    2026-10-18
+ *
+ * @note    - 启动代码（startup_stm32f103xe.s）清零 .bss 之后，把 _end 到
+ *            初始 SP 之间的堆和栈全部涂成 RAM_PAINT_PATTERN；
+ *          - 栈从 _estack 向下增长，从堆顶向上找第一个被改写的字，即栈
+ *            曾经到达的最深位置；_sbrk 的堆只增不减，堆顶就是堆的高水位；
+ *            两者之间从未被使用的部分是剩余 RAM；
+ *          - 保护字：_Min_Stack_Size 预留区最底部的 RAM_GUARD_WORDS 个字，
+ *            被改写说明栈已用到预留大小的边缘；检查只读几个字，可以放在
+ *            TIM6 时间轮的周期定时器里（ram_guard_start），不需要 MPU；
+ *          - ram_report 通过 printf（USART1）输出；
+ *          - 主机构建没有链接脚本符号，布局由仿真器提供：固件线程栈在
+ *            线程启动前涂色，没有堆。
+ */
+
+#ifndef __RAM_MONITOR_H__
+#define __RAM_MONITOR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  RAM 布局（地址）
+ */
+typedef struct {
+    uintptr_t heap_start;  /*!< 堆起点（_end） */
+    uintptr_t heap_end;    /*!< 当前堆顶 */
+    uintptr_t stack_limit; /*!< 栈预留区底部（_estack - _Min_Stack_Size） */
+    uintptr_t stack_top;   /*!< 栈顶（_estack） */
+} ram_layout_t;
+
+/**
+ * @brief  RAM 使用统计（字节）
+ */
+typedef struct {
+    uint32_t stack_size; /*!< 栈预留大小 */
+    uint32_t stack_peak; /*!< 栈最大深度 */
+    uint32_t heap_peak;  /*!< 堆最大用量 */
+    uint32_t free_min;   /*!< 堆顶与栈最深处之间从未使用的 RAM */
+    uint32_t guard_hits; /*!< 保护字检查发现改写的次数 */
+} ram_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 涂色值（与启动代码一致） */
+#define RAM_PAINT_PATTERN 0xA5A5A5A5UL
+
+/** 栈预留区底部的保护字个数 */
+#define RAM_GUARD_WORDS 8U
+
+/** 返回值定义 */
+#define RAM_OK 0           /*!< 成功 / 保护字完好 */
+#define RAM_GUARD_HIT 1    /*!< 保护字被改写 */
+#define RAM_ERROR -1       /*!< 启动定时器失败 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  读取 RAM 布局
+ */
+void ram_get_layout(ram_layout_t *layout);
+
+/**
+ * @brief  扫描涂色区，计算栈 / 堆高水位
+ * @note   栈深度按整个栈扫描，耗时与剩余 RAM 成正比，不要在中断里调用
+ */
+void ram_get_stats(ram_stats_t *stats);
+
+/**
+ * @brief  重新涂色当前 SP 以下的栈（保留 64 字节余量），之后的 ram_get_stats
+ *         只反映此后的最大深度
+ */
+void ram_paint_stack(void);
+
+/**
+ * @brief  检查保护字
+ * @retval RAM_OK / RAM_GUARD_HIT（同时计入 guard_hits）
+ * @note   中断中可调用
+ */
+int ram_guard_check(void);
+
+/**
+ * @brief  在时间轮上启动周期性保护字检查
+ * @param  period_ms: 检查周期
+ * @retval RAM_OK / RAM_ERROR
+ * @note   需先调用 tw_init
+ */
+int ram_guard_start(uint32_t period_ms);
+
+/**
+ * @brief  停止周期性检查
+ */
+void ram_guard_stop(void);
+
+/**
+ * @brief  通过 USART1 打印栈 / 堆高水位和剩余 RAM
+ */
+void ram_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RAM_MONITOR_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -47,6 +47,9 @@ uint8_t Hal_SPI_SwapByte(uint8_t byte);
 void Register_SPI_Start(void);
 void Register_SPI_Stop(void);
 uint8_t Register_SPI_SwapByte(uint8_t byte);
+HAL_StatusTypeDef Register_SPI_TransferBlock(const uint8_t *tx, uint8_t *rx, uint16_t len);
+void Register_SPI_WriteBlock(const uint8_t *tx, uint16_t len);
+HAL_StatusTypeDef Register_SPI_ReadBlock(uint8_t *rx, uint16_t len);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
@@ -0,0 +1,140 @@
+/**
+ * @file    spi_bus.h
+ * @brief   SPI1 全双工 DMA 事务接口头文件
+ * @date    2026-10-18
+ *
+ * @note    - 每个从设备用一个 spi_device_t 描述：CS 引脚、CPOL/CPHA、分频、帧宽；
+ *          - spi_xfer 把事务放入队列，由 SPI1_RX (DMA1 通道2) / SPI1_TX
+ *            (DMA1 通道3) 完成收发，RX 完成中断里释放 CS 并立即启动下一个事务；
+ *          - 只有相邻事务的设备不同时才重写 SPI1->CR1；
+ *          - SPI_XFER_KEEP_CS 让 CS 在事务结束后保持有效，
+ *            用于“命令 + 数据”分两次提交但必须在同一次片选内完成的场景。
+ */
+
+#ifndef __SPI_BUS_H__
+#define __SPI_BUS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  SPI 从设备描述
+ */
+typedef struct {
+    GPIO_TypeDef *cs_port; /*!< CS 端口 */
+    uint16_t cs_pin;       /*!< CS 引脚 (GPIO_PIN_x) */
+    uint8_t mode;          /*!< SPI_BUS_MODE0-3 (CPOL << 1 | CPHA) */
+    uint8_t prescaler;     /*!< CR1.BR 取值 0-7，fPCLK / 2^(BR+1) */
+    uint8_t frame16;       /*!< 0: 8 位帧, 1: 16 位帧 */
+    uint8_t lsb_first;     /*!< 0: MSB 先发, 1: LSB 先发 */
+} spi_device_t;
+
+/**
+ * @brief  事务完成回调（中断上下文）
+ * @param  status: SPI_BUS_OK 或 SPI_BUS_ERROR
+ * @param  ctx: 提交时传入的上下文
+ */
+typedef void (*spi_xfer_cb_t)(int status, void *ctx);
+
+/**
+ * @brief  统计信息
+ */
+typedef struct {
+    uint32_t xfers;     /*!< 完成的事务数 */
+    uint32_t frames;    /*!< 完成的帧数 */
+    uint32_t reconfigs; /*!< 因设备切换重写 CR1 的次数 */
+    uint32_t errors;    /*!< DMA 错误次数 */
+} spi_bus_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** SPI 模式 */
+#define SPI_BUS_MODE0 0 /*!< CPOL=0, CPHA=0 */
+#define SPI_BUS_MODE1 1 /*!< CPOL=0, CPHA=1 */
+#define SPI_BUS_MODE2 2 /*!< CPOL=1, CPHA=0 */
+#define SPI_BUS_MODE3 3 /*!< CPOL=1, CPHA=1 */
+
+/** 事务标志 */
+#define SPI_XFER_ASYNC 0x01U   /*!< 提交后立即返回，不等待完成 */
+#define SPI_XFER_KEEP_CS 0x02U /*!< 结束后保持 CS 有效 */
+
+/** 事务队列深度 */
+#ifndef SPI_BUS_QUEUE_LEN
+#define SPI_BUS_QUEUE_LEN 8
+#endif
+
+/** 返回值定义 */
+#define SPI_BUS_OK 0           /*!< 成功 */
+#define SPI_BUS_QUEUE_FULL -1  /*!< 事务队列已满 */
+#define SPI_BUS_PARAM_ERROR -2 /*!< 参数错误或未初始化 */
+#define SPI_BUS_ERROR -3       /*!< 传输错误 */
+#define SPI_BUS_BUSY -4        /*!< DMA 通道已被其他模块占用 */
+
+/** 板载 W25Q32（PC13 片选，模式0，fPCLK/4） */
+extern const spi_device_t spi_dev_w25q32;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  接管 SPI1：占用 DMA1 通道2/3，打开 SPI 的 DMA 请求
+ * @retval SPI_BUS_OK / SPI_BUS_BUSY
+ * @note   需在 MX_SPI1_Init() 和 DMA_Manager_Init() 之后调用
+ */
+int spi_bus_init(void);
+
+/**
+ * @brief  释放 DMA 通道，关闭 SPI 的 DMA 请求，丢弃未执行的事务
+ */
+void spi_bus_deinit(void);
+
+/**
+ * @brief  全双工事务
+ * @param  dev: 从设备
+ * @param  tx: 发送缓冲区（NULL 时发送 0xFF 填充）
+ * @param  rx: 接收缓冲区（NULL 时丢弃接收数据）
+ * @param  len: 帧数（16 位帧时按半字计）
+ * @param  flags: SPI_XFER_xxx
+ * @retval SPI_BUS_OK / SPI_BUS_QUEUE_FULL / SPI_BUS_PARAM_ERROR / SPI_BUS_ERROR
+ * @note   不带 SPI_XFER_ASYNC 时等待本事务完成，不能在中断中调用
+ */
+int spi_xfer(const spi_device_t *dev, const void *tx, void *rx, uint16_t len,
+             uint32_t flags);
+
+/**
+ * @brief  带完成回调的异步事务
+ * @param  cb: 完成回调（可为 NULL）
+ * @param  ctx: 回调上下文
+ * @retval SPI_BUS_OK / SPI_BUS_QUEUE_FULL / SPI_BUS_PARAM_ERROR
+ * @note   完成前 tx/rx 缓冲区必须保持有效
+ */
+int spi_xfer_async(const spi_device_t *dev, const void *tx, void *rx,
+                   uint16_t len, uint32_t flags, spi_xfer_cb_t cb, void *ctx);
+
+/**
+ * @brief  是否还有未完成的事务
+ * @retval 1: 忙, 0: 空闲
+ */
+uint8_t spi_bus_busy(void);
+
+/**
+ * @brief  等待队列中所有事务完成
+ */
+void spi_bus_wait(void);
+
+/**
+ * @brief  获取统计信息
+ */
+void spi_bus_get_stats(spi_bus_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPI_BUS_H__ */
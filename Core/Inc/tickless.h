@@ -0,0 +1,81 @@
+/**
+ * @file    tickless.h
+ * @brief   低功耗空闲：按最近的软件定时器到期时间停掉周期节拍并 WFI 睡眠
+ * @date    2026-10-18
+ *
+ * @note    - 主循环无事可做时调用 tickless_idle()；
+ *          - 最近的定时器（tw_next_expiry）至少 TICKLESS_MIN_TICKS 个节拍后
+ *            才到期时，停止 SysTick，把 TIM6 的 ARR 临时改为到期前的整段
+ *            间隔，WFI 睡眠；否则节拍照常运行，只 WFI 到下一个中断；
+ *          - 醒来后按 TIM6 实际计数补偿 HAL 节拍（uwTick，按 1 kHz）并用
+ *            tw_advance() 补上没有逐个产生中断的时间轮节拍；
+ *          - 任何中断都会提前唤醒，睡眠时间按实际计数计算；
+ *          - 只使用睡眠模式（WFI）：停止模式下 TIM6 的时钟也会停掉，
+ *            需要 RTC 闹钟才能定时唤醒，本工程没有配置 RTC；
+ *          - 需要先用 tw_init(tick_hz) 启动 TIM6 节拍。
+ */
+
+#ifndef __TICKLESS_H__
+#define __TICKLESS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  空闲统计
+ */
+typedef struct {
+    uint32_t window_ms;          /*!< 统计窗口（自 tickless_reset_stats 起的 HAL 毫秒数） */
+    uint32_t sleep_ms;           /*!< 睡眠总时间（毫秒） */
+    uint32_t wakeups;            /*!< 唤醒次数（即 WFI 次数） */
+    uint32_t long_sleeps;        /*!< 其中停掉节拍的睡眠次数 */
+    uint32_t residency_permille; /*!< 睡眠时间占窗口的千分比 */
+    uint32_t wakeups_per_s;      /*!< 每秒唤醒次数 */
+} tickless_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 最近的定时器至少这么多节拍后到期才停掉节拍 */
+#ifndef TICKLESS_MIN_TICKS
+#define TICKLESS_MIN_TICKS 2U
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  允许 / 禁止停掉节拍（禁止时 tickless_idle 只做普通 WFI）
+ * @param  enable: 0 禁止，非 0 允许（默认允许）
+ */
+void tickless_enable(int enable);
+
+/**
+ * @brief  空闲：睡眠到下一个定时器到期或任意中断
+ * @note   在线程模式调用；返回时被唤醒的中断已经处理完
+ */
+void tickless_idle(void);
+
+/**
+ * @brief  清零统计，从现在开始新的统计窗口
+ */
+void tickless_reset_stats(void);
+
+/**
+ * @brief  读取统计
+ * @param  stats: 输出
+ */
+void tickless_get_stats(tickless_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TICKLESS_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,178 @@
+/**
+ * @file    timer_wheel.h
+ * @brief   由 TIM6 驱动的分层时间轮软件定时器头文件
+ * @date    2026-10-18
+ *
+ * @note    - TW_LEVELS 层、每层 2^TW_SLOT_BITS 个槽，第 0 层每槽 1 个节拍，
+ *            上一层每槽覆盖下一层一整圈；
+ *          - 定时器节点由调用者提供（侵入式双向链表），启动 / 停止都是
+ *            O(1)，数量只受内存限制；
+ *          - 第 0 层转满一圈时把上一层的当前槽重新分配到下层（级联），
+ *            每个定时器最多被移动 TW_LEVELS - 1 次；
+ *          - 节拍来自 TIM6 更新中断，回调在中断上下文中执行，应尽量简短；
+ *          - 周期定时器按到期时间累加重装，不随回调延迟漂移。
+ */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct tw_timer tw_timer_t;
+
+/**
+ * @brief  到期回调
+ * @param  timer: 到期的定时器（周期定时器此时已重新启动）
+ * @param  ctx: tw_timer_init 传入的上下文
+ * @note   可以在回调中启动 / 停止任何定时器，包括自己
+ */
+typedef void (*tw_callback_t)(tw_timer_t *timer, void *ctx);
+
+/**
+ * @brief  定时器节点（成员由本模块维护，调用者不要直接修改）
+ */
+struct tw_timer {
+    tw_timer_t *next;   /*!< 槽内下一个节点 */
+    tw_timer_t **pprev; /*!< 指向前一个节点的 next（或槽头），NULL 表示未启动 */
+    uint32_t expires;   /*!< 到期节拍 */
+    uint32_t period;    /*!< 周期（节拍），0 表示单次 */
+    tw_callback_t cb;   /*!< 到期回调 */
+    void *ctx;          /*!< 回调上下文 */
+};
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 每层槽数的位数 */
+#ifndef TW_SLOT_BITS
+#define TW_SLOT_BITS 6
+#endif
+
+/** 层数 */
+#ifndef TW_LEVELS
+#define TW_LEVELS 4
+#endif
+
+/** 默认节拍频率（Hz），tw_init(0) 时 tw_ms_to_ticks 也按它换算 */
+#ifndef TW_TICK_HZ
+#define TW_TICK_HZ 1000U
+#endif
+
+/**
+ * TIM6 计数频率（Hz）。节拍频率须能整除它且不超过它的一半；
+ * 每个节拍计数 TW_TIMER_COUNT_HZ / tick_hz 次，16 位 ARR 一次最多覆盖
+ * 65536 个计数（10 kHz 时为 6.5 s），供低功耗空闲时延长节拍间隔
+ */
+#ifndef TW_TIMER_COUNT_HZ
+#define TW_TIMER_COUNT_HZ 10000U
+#endif
+
+/** 最大延时 / 周期（节拍） */
+#define TW_MAX_TICKS ((1UL << (TW_SLOT_BITS * TW_LEVELS)) - 1U)
+
+/** 返回值定义 */
+#define TW_OK 0            /*!< 成功 */
+#define TW_PARAM_ERROR -1  /*!< 参数错误 */
+#define TW_NOT_ACTIVE -2   /*!< 定时器未启动 */
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+ * @brief  初始化时间轮并按指定频率启动 TIM6
+ * @param  tick_hz: 节拍频率（Hz）；0 表示不使用 TIM6，由调用者周期性地
+ *         调用 tw_tick()
+ * @retval TW_OK / TW_PARAM_ERROR（频率不能整除 TW_TIMER_COUNT_HZ 等）
+ * @note   丢弃所有已启动的定时器；需在 MX_TIM6_Init() 之后调用
+ */
+int tw_init(uint32_t tick_hz);
+
+/**
+ * @brief  停止 TIM6 节拍（已启动的定时器保留，不再推进）
+ */
+void tw_deinit(void);
+
+/**
+ * @brief  初始化定时器节点
+ * @param  timer: 节点
+ * @param  cb: 到期回调
+ * @param  ctx: 回调上下文
+ */
+void tw_timer_init(tw_timer_t *timer, tw_callback_t cb, void *ctx);
+
+/**
+ * @brief  启动（或重新启动）定时器
+ * @param  timer: 已初始化的节点
+ * @param  delay: 首次到期前的节拍数，1-TW_MAX_TICKS（0 按 1 处理）
+ * @param  period: 之后的周期，0 表示单次，最大 TW_MAX_TICKS
+ * @retval TW_OK / TW_PARAM_ERROR
+ */
+int tw_start(tw_timer_t *timer, uint32_t delay, uint32_t period);
+
+/**
+ * @brief  停止定时器
+ * @param  timer: 节点
+ * @retval TW_OK / TW_NOT_ACTIVE（未启动或已到期的单次定时器）
+ */
+int tw_stop(tw_timer_t *timer);
+
+/**
+ * @brief  定时器是否在等待到期
+ */
+int tw_is_active(const tw_timer_t *timer);
+
+/**
+ * @brief  距离到期还有多少节拍（未启动时为 0）
+ */
+uint32_t tw_remaining(const tw_timer_t *timer);
+
+/**
+ * @brief  推进一个节拍，执行到期的回调
+ * @note   正常由 TIM6 更新中断调用；tw_init(0) 时由调用者调用
+ */
+void tw_tick(void);
+
+/**
+ * @brief  跳过若干个节拍
+ * @param  ticks: 节拍数
+ * @note   用于休眠期间 TIM6 没有逐个产生中断的节拍；没有定时器到期的
+ *         节拍只推进计数，遇到需要级联或有定时器的槽时按 tw_tick() 处理
+ */
+void tw_advance(uint32_t ticks);
+
+/**
+ * @brief  距离最早到期的定时器还有多少节拍
+ * @retval 1 表示下一个节拍就有定时器到期；没有定时器时返回 TW_MAX_TICKS
+ * @note   遍历所有槽和定时器，只适合在空闲时调用
+ */
+uint32_t tw_next_expiry(void);
+
+/**
+ * @brief  tw_init 以来经过的节拍数
+ */
+uint32_t tw_now(void);
+
+/**
+ * @brief  当前启动着的定时器数量
+ */
+uint32_t tw_active_count(void);
+
+/**
+ * @brief  毫秒换算为节拍（向上取整，至少 1）
+ * @note   tw_init(0) 时按 TW_TICK_HZ 换算
+ */
+uint32_t tw_ms_to_ticks(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMER_WHEEL_H__ */
+
+/************************ END OF FILE *****************************************/
@@ -33,7 +33,8 @@ extern "C" {
 #include "stdio.h"
 
 #include "stm32f1xx.h"
-#include <sys/_intsup.h>
+
+#include "event_loop.h"
 
 /* USER CODE END Includes */
 
@@ -67,6 +68,10 @@ extern uint8_t g_usart_rx_buffer[100];
 extern volatile uint8_t g_usart_rx_len;
 extern volatile uint8_t g_usart_message_ready;
 
+void usart_set_rx_event(ev_task_t *task, uint16_t sig);
+
+void usart_post_rx_event(void);
+
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
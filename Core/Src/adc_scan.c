@@ -0,0 +1,368 @@
+/**
+ * @file    adc_scan.c
+ * @brief   ADC 定时触发扫描采集（DMA 循环双缓冲、按块回调、块统计）
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_scan.h"
+#include "dsp.h"
+#include "main.h"
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** EXTSEL：TIM3_TRGO = 100，SWSTART = 111 */
+#define ADC_SCAN_EXTSEL_TIM3 ADC_CR2_EXTSEL_2
+#define ADC_SCAN_EXTSEL_SWSTART ADC_CR2_EXTSEL
+
+/** 规则同步模式 */
+#define ADC_SCAN_DUALMOD_REGSIMULT (6UL << ADC_CR1_DUALMOD_Pos)
+
+/** 上电稳定时间 tSTAB（1 us）与校准等待的循环上限 */
+#define ADC_SCAN_STAB_LOOPS 72U
+#define ADC_SCAN_CAL_LOOPS 100000U
+
+/** 序列长度上限 / CNDTR 上限 */
+#define ADC_SCAN_MAX_CHANNELS 16U
+#define ADC_SCAN_MAX_UNITS 0xFFFFUL
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t s_ready = 0;
+static volatile uint8_t s_running = 0;
+static volatile uint32_t s_blocks = 0;   /* 下一块的序号 */
+static volatile uint32_t s_overruns = 0;
+static uint8_t *s_buffer;
+static uint32_t s_block_bytes;
+static adc_scan_block_t s_block;
+static adc_scan_callback_t s_cb;
+static void *s_ctx;
+
+/* Private function prototypes -----------------------------------------------*/
+static void adc_scan_on_event(DMA_ChannelId_t ch, uint32_t events, void *ctx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  等待上电稳定（约 1 us）
+ */
+static void adc_scan_stab_delay(void) {
+    for (volatile uint32_t i = 0; i < ADC_SCAN_STAB_LOOPS; i++) {
+    }
+}
+
+/**
+ * @brief  上电、复位校准寄存器并校准，结束后断电
+ */
+static void adc_scan_calibrate(ADC_TypeDef *adc) {
+    uint32_t n;
+
+    adc->CR2 = ADC_CR2_ADON;
+    adc_scan_stab_delay();
+
+    adc->CR2 |= ADC_CR2_RSTCAL;
+    for (n = ADC_SCAN_CAL_LOOPS; (adc->CR2 & ADC_CR2_RSTCAL) && n > 0; n--) {
+    }
+    adc->CR2 |= ADC_CR2_CAL;
+    for (n = ADC_SCAN_CAL_LOOPS; (adc->CR2 & ADC_CR2_CAL) && n > 0; n--) {
+    }
+
+    adc->CR2 = 0;
+}
+
+/**
+ * @brief  写规则序列和序列中各通道的采样时间
+ */
+static void adc_scan_sequence(ADC_TypeDef *adc, const uint8_t *channels, uint8_t n,
+                              uint8_t smp) {
+    uint32_t sqr[3] = {0, 0, 0};
+    uint32_t smpr1 = adc->SMPR1;
+    uint32_t smpr2 = adc->SMPR2;
+
+    for (uint8_t k = 0; k < n; k++) {
+        uint32_t ch = channels[k];
+
+        sqr[k / 6U] |= ch << ((k % 6U) * 5U);
+        if (ch < 10U) {
+            smpr2 = (smpr2 & ~(7UL << (ch * 3U))) | ((uint32_t)smp << (ch * 3U));
+        } else {
+            smpr1 = (smpr1 & ~(7UL << ((ch - 10U) * 3U))) | ((uint32_t)smp << ((ch - 10U) * 3U));
+        }
+    }
+    adc->SMPR1 = smpr1;
+    adc->SMPR2 = smpr2;
+    adc->SQR3 = sqr[0];
+    adc->SQR2 = sqr[1];
+    adc->SQR1 = sqr[2] | ((uint32_t)(n - 1U) << ADC_SQR1_L_Pos);
+}
+
+/**
+ * @brief  参数检查
+ */
+static int adc_scan_check(const adc_scan_config_t *cfg) {
+    if (cfg == NULL || cfg->channels == NULL || cfg->buffer == NULL || cfg->cb == NULL ||
+        cfg->num_channels == 0 || cfg->num_channels > ADC_SCAN_MAX_CHANNELS ||
+        cfg->sample_time > 7U || cfg->block_scans == 0 || cfg->rate_hz == 0 ||
+        cfg->rate_hz > ADC_SCAN_TIM_CLK / 2U ||
+        2UL * cfg->block_scans * cfg->num_channels > ADC_SCAN_MAX_UNITS) {
+        return 0;
+    }
+    for (uint8_t k = 0; k < cfg->num_channels; k++) {
+        if (cfg->channels[k] > 17U ||
+            (cfg->channels2 != NULL && cfg->channels2[k] > 17U)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief  交出一半缓冲区
+ */
+static void adc_scan_deliver(uint32_t half) {
+    s_block.data = s_buffer + half * s_block_bytes;
+    s_block.index = s_blocks++;
+    s_cb(&s_block, s_ctx);
+}
+
+/**
+ * @brief  DMA 事件回调（中断上下文）
+ */
+static void adc_scan_on_event(DMA_ChannelId_t ch, uint32_t events, void *ctx) {
+    (void)ch;
+    (void)ctx;
+
+    if (!s_running) {
+        return;
+    }
+    if (events & DMA_EVT_TE) {
+        adc_scan_stop();
+        return;
+    }
+
+    /* 两个标志同时出现时分不清先后，两块都可能已被覆盖：都丢弃，序号照常递增 */
+    if ((events & (DMA_EVT_HT | DMA_EVT_TC)) == (DMA_EVT_HT | DMA_EVT_TC)) {
+        s_overruns++;
+        s_blocks += 2U;
+        return;
+    }
+    if (events & DMA_EVT_HT) {
+        adc_scan_deliver(0);
+    } else if (events & DMA_EVT_TC) {
+        adc_scan_deliver(1);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  打开时钟、校准，占用 DMA 通道
+ */
+int adc_scan_init(void) {
+    if (s_ready) {
+        adc_scan_deinit();
+    }
+    if (DMA_Claim(ADC_SCAN_DMA_CHANNEL, "adc_scan") != DMA_MGR_OK) {
+        return ADC_SCAN_BUSY;
+    }
+    DMA_SetCallback(ADC_SCAN_DMA_CHANNEL, adc_scan_on_event, NULL,
+                    DMA_EVT_HT | DMA_EVT_TC | DMA_EVT_TE);
+
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_ADC2_CLK_ENABLE();
+    __HAL_RCC_TIM3_CLK_ENABLE();
+    /* ADC 时钟不超过 14 MHz：PCLK2 72 MHz / 6 = 12 MHz */
+    MODIFY_REG(RCC->CFGR, RCC_CFGR_ADCPRE, RCC_CFGR_ADCPRE_DIV6);
+
+    adc_scan_calibrate(ADC1);
+    adc_scan_calibrate(ADC2);
+
+    s_running = 0;
+    s_ready = 1;
+    return ADC_SCAN_OK;
+}
+
+/**
+ * @brief  停止采集并释放 DMA 通道
+ */
+void adc_scan_deinit(void) {
+    if (!s_ready) {
+        return;
+    }
+    adc_scan_stop();
+    DMA_Release(ADC_SCAN_DMA_CHANNEL);
+    s_ready = 0;
+}
+
+/**
+ * @brief  开始采集
+ */
+int adc_scan_start(const adc_scan_config_t *cfg) {
+    uint8_t dual;
+    uint32_t units, ticks, psc;
+    DMA_Config_t dma;
+
+    if (!s_ready || !adc_scan_check(cfg)) {
+        return ADC_SCAN_PARAM_ERROR;
+    }
+    if (s_running) {
+        return ADC_SCAN_BUSY;
+    }
+
+    dual = (cfg->channels2 != NULL);
+    units = (uint32_t)cfg->block_scans * cfg->num_channels;
+    s_buffer = (uint8_t *)cfg->buffer;
+    s_block_bytes = units * (dual ? 4U : 2U);
+    s_block.scans = cfg->block_scans;
+    s_block.channels = cfg->num_channels;
+    s_block.dual = dual;
+    s_cb = cfg->cb;
+    s_ctx = cfg->ctx;
+    s_blocks = 0;
+    s_overruns = 0;
+
+    /* 步骤1：ADC 上电并配置序列（停止时已断电，上一次未完成的转换已丢弃） */
+    ADC1->CR2 = ADC_CR2_ADON;
+    if (dual) {
+        ADC2->CR2 = ADC_CR2_ADON;
+    }
+    adc_scan_stab_delay();
+
+    ADC1->CR1 = ADC_CR1_SCAN | (dual ? ADC_SCAN_DUALMOD_REGSIMULT : 0U);
+    adc_scan_sequence(ADC1, cfg->channels, cfg->num_channels, cfg->sample_time);
+    if (dual) {
+        /* 从 ADC 的外部触发必须选 SWSTART，由 ADC1 的触发同步启动 */
+        ADC2->CR1 = ADC_CR1_SCAN;
+        adc_scan_sequence(ADC2, cfg->channels2, cfg->num_channels, cfg->sample_time);
+        ADC2->CR2 = ADC_CR2_ADON | ADC_CR2_EXTTRIG | ADC_SCAN_EXTSEL_SWSTART;
+    }
+    ADC1->SR = 0;
+    (void)ADC1->DR;
+
+    /* 步骤2：DMA 循环写入整个缓冲区，HT / TC 各交出一块 */
+    dma.PeriphBaseAddr = (uint32_t)&ADC1->DR;
+    dma.PeriphInc = DMA_Inc_Disable;
+    dma.MemBaseAddr = (uint32_t)cfg->buffer;
+    dma.MemInc = DMA_Inc_Enable;
+    dma.PeriphDataSize = dual ? DMA_DataSize_Word : DMA_DataSize_HalfWord;
+    dma.MemDataSize = dma.PeriphDataSize;
+    dma.Direction = DMA_DIR_PeripheralSRC;
+    dma.BufferSize = (uint16_t)(2U * units);
+    dma.Mode = DMA_Mode_Circular;
+    dma.Priority = DMA_Priority_High;
+    dma.M2M = false;
+    if (DMA_StartTransfer(ADC_SCAN_DMA_CHANNEL, &dma) != DMA_MGR_OK) {
+        ADC1->CR2 = 0;
+        ADC2->CR2 = 0;
+        return ADC_SCAN_BUSY;
+    }
+    s_running = 1;
+
+    ADC1->CR2 = ADC_CR2_ADON | ADC_CR2_EXTTRIG | ADC_SCAN_EXTSEL_TIM3 | ADC_CR2_DMA;
+
+    /* 步骤3：TIM3 更新事件作为 TRGO，周期 = 1 / rate_hz */
+    ticks = ADC_SCAN_TIM_CLK / cfg->rate_hz;
+    psc = (ticks - 1U) / 0x10000U;
+    TIM3->CR1 = 0;
+    TIM3->CR2 = 0;
+    TIM3->PSC = psc;
+    TIM3->ARR = ticks / (psc + 1U) - 1U;
+    TIM3->CNT = 0;
+    TIM3->EGR = TIM_EGR_UG;
+    TIM3->SR = 0;
+    TIM3->CR2 = TIM_CR2_MMS_1;
+    TIM3->CR1 = TIM_CR1_CEN;
+
+    return ADC_SCAN_OK;
+}
+
+/**
+ * @brief  停止采集
+ */
+void adc_scan_stop(void) {
+    s_running = 0;
+    TIM3->CR1 = 0;
+    TIM3->CR2 = 0;
+    DMA_AbortTransfer(ADC_SCAN_DMA_CHANNEL);
+    /* 断电同时中止正在进行的转换 */
+    ADC1->CR2 = 0;
+    ADC2->CR2 = 0;
+    ADC1->CR1 = 0;
+}
+
+/**
+ * @brief  是否正在采集
+ */
+uint8_t adc_scan_running(void) {
+    return s_running;
+}
+
+/**
+ * @brief  已交出的块数
+ */
+uint32_t adc_scan_blocks(void) {
+    return s_blocks;
+}
+
+/**
+ * @brief  块丢失次数
+ */
+uint32_t adc_scan_overruns(void) {
+    return s_overruns;
+}
+
+/**
+ * @brief  统计一段采样
+ * @note   平方和用 64 位累加（Cortex-M3 上为 UMLAL），count 不超过 65535 时
+ *         方差的分子 count * sq - sum^2 不会溢出
+ */
+void adc_stats_compute(const uint16_t *data, uint32_t count, uint32_t stride,
+                       adc_stats_t *st) {
+    uint32_t min = 0xFFFFU, max = 0, sum = 0;
+    uint64_t sq = 0, var;
+
+    if (count == 0U) {
+        st->min = st->max = st->mean = st->rms = st->ac_rms = 0;
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t v = *data;
+        data += stride;
+        if (v < min) {
+            min = v;
+        }
+        if (v > max) {
+            max = v;
+        }
+        sum += v;
+        sq += (uint64_t)(v * v);
+    }
+
+    /* count * sq >= sum^2（柯西不等式），差值为 count^2 倍的方差 */
+    var = (uint64_t)count * sq - (uint64_t)sum * sum;
+
+    st->min = (uint16_t)min;
+    st->max = (uint16_t)max;
+    st->mean = (uint16_t)((sum + count / 2U) / count);
+    st->rms = (uint16_t)dsp_isqrt((uint32_t)((sq + count / 2U) / count));
+    st->ac_rms = (uint16_t)dsp_isqrt((uint32_t)(var / ((uint64_t)count * count)));
+}
+
+/**
+ * @brief  统计块中一个通道
+ */
+void adc_scan_block_stats(const adc_scan_block_t *block, uint8_t index, uint8_t adc,
+                          adc_stats_t *st) {
+    const uint16_t *p = (const uint16_t *)block->data;
+
+    if (block->dual) {
+        /* 小端：每个字的低半字为 ADC1，高半字为 ADC2 */
+        adc_stats_compute(p + 2U * index + (adc == 2U ? 1U : 0U), block->scans,
+                          2U * block->channels, st);
+    } else {
+        adc_stats_compute(p + index, block->scans, block->channels, st);
+    }
+}
+
+/************************ END OF FILE *****************************************/
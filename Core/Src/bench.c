@@ -0,0 +1,223 @@
+/**
+ * @file    bench.c
+ * @brief   周期级基准测试框架实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "bench.h"
+#include <stddef.h>
+#include <stdio.h>
+
+#include "main.h"
+
+#if defined(STM32_HOST_BUILD) && defined(BENCH_HOST_CLOCK)
+#include <time.h>
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t s_overhead = 0;
+static uint32_t s_samples[BENCH_MAX_REPS];
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  校准用的空函数
+ */
+static void bench_empty(void *arg) {
+    (void)arg;
+}
+
+/**
+ * @brief  插入排序（样本数很少，且不需要额外内存）
+ */
+static void bench_sort(uint32_t *v, uint32_t n) {
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        uint32_t j = i;
+        while (j > 0 && v[j - 1] > x) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+/**
+ * @brief  测量一次 fn(arg)
+ */
+static uint32_t bench_sample(bench_fn_t fn, void *arg, uint32_t flags) {
+    uint32_t t0, t1;
+    uint32_t primask = __get_PRIMASK();
+
+    if (flags & BENCH_FLAG_IRQ_OFF) {
+        __disable_irq();
+    }
+
+    t0 = bench_now();
+    fn(arg);
+    t1 = bench_now();
+
+    if ((flags & BENCH_FLAG_IRQ_OFF) && primask == 0) {
+        __enable_irq();
+    }
+    return t1 - t0;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+#if defined(STM32_HOST_BUILD) && defined(BENCH_HOST_CLOCK)
+
+/**
+ * @brief  读取当前计时值（主机：CLOCK_MONOTONIC 纳秒）
+ */
+uint32_t bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * @brief  计时器频率
+ */
+uint32_t bench_freq(void) {
+    return 1000000000UL;
+}
+
+/**
+ * @brief  计时单位名称
+ */
+const char *bench_unit(void) {
+    return "ns";
+}
+
+#else
+
+/**
+ * @brief  读取当前计时值（DWT 周期计数）
+ */
+uint32_t bench_now(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  计时器频率
+ */
+uint32_t bench_freq(void) {
+    return SystemCoreClock;
+}
+
+/**
+ * @brief  计时单位名称
+ */
+const char *bench_unit(void) {
+    return "cycles";
+}
+
+#endif /* BENCH_HOST_CLOCK */
+
+/**
+ * @brief  初始化计时器并校准测量开销
+ */
+void bench_init(void) {
+    uint32_t best = 0xFFFFFFFFUL;
+
+#if !(defined(STM32_HOST_BUILD) && defined(BENCH_HOST_CLOCK))
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+
+    /* 取空函数多次测量的最小值作为固定开销 */
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t t = bench_sample(bench_empty, NULL, BENCH_FLAG_IRQ_OFF);
+        if (t < best) {
+            best = t;
+        }
+    }
+    s_overhead = best;
+}
+
+/**
+ * @brief  校准得到的测量开销
+ */
+uint32_t bench_overhead(void) {
+    return s_overhead;
+}
+
+/**
+ * @brief  由样本计算统计值
+ */
+void bench_stats(const char *name, uint32_t *samples, uint32_t count,
+                 uint32_t bytes, bench_result_t *result) {
+    uint32_t median;
+
+    bench_sort(samples, count);
+    if (count & 1U) {
+        median = samples[count / 2];
+    } else {
+        median = (samples[count / 2 - 1] + samples[count / 2]) / 2;
+    }
+
+    result->name = name;
+    result->reps = count;
+    result->min = samples[0];
+    result->median = median;
+    result->max = samples[count - 1];
+    result->overhead = s_overhead;
+    result->bytes = bytes;
+    result->bytes_per_s =
+        (bytes != 0 && median != 0)
+            ? (uint32_t)((uint64_t)bytes * bench_freq() / median)
+            : 0;
+}
+
+/**
+ * @brief  运行一个基准
+ */
+int bench_run(const bench_config_t *cfg, bench_fn_t fn, void *arg,
+              bench_result_t *result) {
+    uint32_t reps;
+
+    if (cfg == NULL || fn == NULL || result == NULL ||
+        cfg->reps > BENCH_MAX_REPS) {
+        return BENCH_PARAM_ERROR;
+    }
+    reps = (cfg->reps == 0) ? BENCH_DEFAULT_REPS : cfg->reps;
+
+    /* 步骤1：预热（指令预取、缓冲区首次访问等） */
+    for (uint32_t i = 0; i < cfg->warmup; i++) {
+        fn(arg);
+    }
+
+    /* 步骤2：逐次测量并扣除固定开销 */
+    for (uint32_t i = 0; i < reps; i++) {
+        uint32_t t = bench_sample(fn, arg, cfg->flags);
+        s_samples[i] = (t > s_overhead) ? t - s_overhead : 0;
+    }
+
+    /* 步骤3：统计 */
+    bench_stats(cfg->name, s_samples, reps, cfg->bytes, result);
+    return BENCH_OK;
+}
+
+/**
+ * @brief  输出 CSV 表头行
+ */
+void bench_report_header(void) {
+    printf("BENCH,name,unit,reps,min,median,max,overhead,bytes_per_s\r\n");
+}
+
+/**
+ * @brief  输出一行 CSV 结果
+ */
+void bench_report(const bench_result_t *r) {
+    printf("BENCH,%s,%s,%lu,%lu,%lu,%lu,%lu,%lu\r\n", r->name, bench_unit(),
+           (unsigned long)r->reps, (unsigned long)r->min,
+           (unsigned long)r->median, (unsigned long)r->max,
+           (unsigned long)r->overhead, (unsigned long)r->bytes_per_s);
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,800 @@
+/**
+ * @file    boot.c
+ * @brief   串口升级引导程序（USART1 流式接收、W25Q32 暂存、CRC 校验后写入内部 Flash）
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "boot.h"
+#include "crc.h"
+#include "crc32.h"
+#include "main.h"
+#include "w25q32.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/**
+ * 上位机帧：A5 type seq len(2) payload[len] crc16(2)
+ *   START  payload = 镜像大小 u32 + 镜像 CRC-32 u32
+ *   DATA   seq = 块号 & 0xFF，payload = 第 n 块（最后一块可以不满）
+ *   END    无 payload
+ * 设备帧：5A type seq status crc16(2)
+ *   READY  暂存区擦除完成，seq = 窗口大小；status 非 0 表示拒绝
+ *   ACK    seq = 已写入暂存区的块数 & 0xFF（累计确认）
+ *   NAK    seq = 期望的块号 & 0xFF
+ *   DONE   status = 会话结果
+ * CRC-16 覆盖 SYNC 之后、CRC 之前的所有字节。
+ */
+#define BOOT_SYNC_HOST 0xA5U
+#define BOOT_SYNC_DEV 0x5AU
+#define BOOT_FRAME_START 0x01U
+#define BOOT_FRAME_DATA 0x02U
+#define BOOT_FRAME_END 0x03U
+#define BOOT_FRAME_READY 0x81U
+#define BOOT_FRAME_ACK 0x82U
+#define BOOT_FRAME_NAK 0x83U
+#define BOOT_FRAME_DONE 0x84U
+
+#define BOOT_HDR_LEN 4U   /* type seq len(2) */
+#define BOOT_START_LEN 8U
+
+/** 镜像头 */
+#define BOOT_HEADER_MAGIC 0x544F4F42UL /* "BOOT" */
+
+/** 需要擦除一个 64 KB 块中至少这么多时用块擦除（约 3.3 个扇区的时间） */
+#define BOOT_BLOCK_ERASE_MIN (4U * W25Q32_SECTOR_SIZE)
+
+/** SRAM 范围（STM32F103xE 64 KB），用于检查应用的栈顶 */
+#define BOOT_SRAM_END (SRAM_BASE + 0x10000UL)
+
+#if !defined(STM32_HOST_BUILD)
+/** 链接脚本给出的代码段末尾 */
+extern uint32_t _etext;
+#endif
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  解析器阶段
+ */
+typedef enum {
+    BOOT_RX_SYNC = 0,
+    BOOT_RX_HDR,
+    BOOT_RX_BODY,
+    BOOT_RX_CRC,
+} boot_rx_stage_t;
+
+/**
+ * @brief  块缓冲区
+ */
+typedef struct {
+    uint8_t data[BOOT_CHUNK_SIZE];
+    uint32_t index; /*!< 块号 */
+    uint16_t len;
+} boot_slot_t;
+
+/**
+ * @brief  暂存区镜像头（W25Q32 BOOT_STAGE_ADDR）
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t crc;   /*!< 镜像 CRC-32 */
+    uint32_t check; /*!< 前三个字段的 crc32_sw */
+} boot_header_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t s_ready = 0;
+static uint32_t s_saved_brr, s_saved_cr1, s_saved_cr3;
+
+/* 接收环形缓冲区（DMA 写）与解析器 */
+static uint8_t s_rx_ring[BOOT_RX_RING];
+static uint32_t s_rx_tail;
+static uint32_t s_last_rx;
+static boot_rx_stage_t s_rx_stage;
+static uint8_t s_rx_hdr[BOOT_HDR_LEN];
+static uint8_t s_rx_crc[2];
+static uint16_t s_rx_len;
+static uint16_t s_rx_got;
+static uint8_t *s_rx_dst;
+static uint8_t s_rx_in_slot; /* 载荷直接写入了下一个空闲块缓冲区 */
+static uint8_t s_scratch[BOOT_CHUNK_SIZE];
+
+/* 会话 */
+static boot_state_t s_state;
+static uint8_t s_status;
+static boot_stats_t s_stats;
+static uint32_t s_size;
+static uint32_t s_crc;
+static uint32_t s_chunks;     /* 总块数 */
+static uint32_t s_expected;   /* 下一个要收的块 */
+static uint32_t s_programmed; /* 已写入暂存区的块数 */
+static uint8_t s_nak_sent;    /* 当前缺口已发过 NAK */
+static uint8_t s_end_pending;
+
+/* 块缓冲区队列：s_slot_tail 最旧（正在或将要编程） */
+static boot_slot_t s_slot[BOOT_WINDOW];
+static uint8_t s_slot_head;
+static uint8_t s_slot_tail;
+static uint8_t s_slot_count;
+
+/* 进行中的 W25Q32 擦除 / 页编程 */
+static W25Q32_Op_t s_op;
+static uint8_t s_op_active;
+static uint32_t s_erase_addr;
+static uint32_t s_erase_end;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void boot_send(uint8_t type, uint8_t seq, uint8_t status);
+static void boot_fail(uint8_t status);
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint32_t boot_get_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief  第 n 块的长度
+ */
+static inline uint16_t boot_chunk_len(uint32_t n) {
+    uint32_t left = s_size - n * BOOT_CHUNK_SIZE;
+    return (uint16_t)((left < BOOT_CHUNK_SIZE) ? left : BOOT_CHUNK_SIZE);
+}
+
+/**
+ * @brief  等进行中的 W25Q32 操作结束（丢弃结果）
+ */
+static void boot_op_flush(void) {
+    if (s_op_active) {
+        while (W25Q32_Op_Poll(&s_op) == PT_WAITING) {
+        }
+        s_op_active = 0;
+    }
+}
+
+/**
+ * @brief  查询 TXE 发送一个应答帧
+ */
+static void boot_send(uint8_t type, uint8_t seq, uint8_t status) {
+    uint8_t frame[6];
+    uint16_t crc;
+
+    frame[0] = BOOT_SYNC_DEV;
+    frame[1] = type;
+    frame[2] = seq;
+    frame[3] = status;
+    crc = (uint16_t)crc_calc(&crc_16_ccitt, &frame[1], 3U);
+    frame[4] = (uint8_t)crc;
+    frame[5] = (uint8_t)(crc >> 8);
+
+    for (uint32_t i = 0; i < sizeof(frame); i++) {
+        while (!(USART1->SR & USART_SR_TXE)) {
+        }
+        USART1->DR = frame[i];
+    }
+}
+
+static void boot_fail(uint8_t status) {
+    boot_op_flush();
+    s_state = BOOT_STATE_FAILED;
+    s_status = status;
+    boot_send(BOOT_FRAME_DONE, 0, status);
+}
+
+/**
+ * @brief  本程序是否整个位于应用区之前，即安装不会改写自身
+ * @note   主机构建下固件和镜像不在同一片 Flash 中，总是允许
+ */
+static uint8_t boot_layout_ok(void) {
+#if defined(STM32_HOST_BUILD)
+    return 1;
+#else
+    return (uint32_t)&_etext < BOOT_APP_BASE;
+#endif
+}
+
+/**
+ * @brief  整页是否为空白
+ */
+static uint8_t boot_page_blank(uint32_t addr) {
+    const uint32_t *p = (const uint32_t *)addr;
+
+    for (uint32_t i = 0; i < FLASH_PAGE_SIZE / 4U; i++) {
+        if (p[i] != 0xFFFFFFFFUL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief  把暂存区镜像安装到应用区
+ * @retval BOOT_ST_OK / BOOT_ST_FLASH / BOOT_ST_CRC / BOOT_ST_LAYOUT
+ * @note   CPU 在片内 Flash 编程 / 擦除期间取指停顿，无法同时读 W25Q32，
+ *         所以逐页串行；停机时间主要由需要改写的页数决定，相同的页跳过
+ */
+static uint8_t boot_install(uint32_t size, uint32_t crc) {
+    static uint32_t page[FLASH_PAGE_SIZE / 4U];
+    FLASH_EraseInitTypeDef erase;
+    uint32_t start = HAL_GetTick();
+    uint32_t error, actual;
+    uint8_t status = BOOT_ST_OK;
+
+    s_stats.pages_written = 0;
+    s_stats.pages_skipped = 0;
+    if (!boot_layout_ok()) {
+        return BOOT_ST_LAYOUT;
+    }
+
+    HAL_FLASH_Unlock();
+    for (uint32_t off = 0; off < size && status == BOOT_ST_OK; off += FLASH_PAGE_SIZE) {
+        uint32_t addr = BOOT_APP_BASE + off;
+        uint32_t n = size - off;
+
+        if (n > FLASH_PAGE_SIZE) {
+            n = FLASH_PAGE_SIZE;
+        }
+        /* 步骤1：读出暂存数据，镜像末尾之后按空白处理 */
+        memset(page, 0xFF, sizeof(page));
+        if (W25Q32_ReadData(BOOT_STAGE_IMAGE + off, (uint8_t *)page, n) != W25Q32_OK) {
+            status = BOOT_ST_FLASH;
+            break;
+        }
+        if (memcmp((const void *)addr, page, FLASH_PAGE_SIZE) == 0) {
+            s_stats.pages_skipped++;
+            continue;
+        }
+
+        /* 步骤2：擦除（已是空白则不擦），按字编程，跳过全 1 的字 */
+        if (!boot_page_blank(addr)) {
+            erase.TypeErase = FLASH_TYPEERASE_PAGES;
+            erase.Banks = FLASH_BANK_1;
+            erase.PageAddress = addr;
+            erase.NbPages = 1;
+            if (HAL_FLASHEx_Erase(&erase, &error) != HAL_OK) {
+                status = BOOT_ST_FLASH;
+                break;
+            }
+        }
+        for (uint32_t i = 0; i < FLASH_PAGE_SIZE / 4U; i++) {
+            if (page[i] != 0xFFFFFFFFUL &&
+                HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + 4U * i, page[i]) != HAL_OK) {
+                status = BOOT_ST_FLASH;
+                break;
+            }
+        }
+
+        /* 步骤3：回读比较 */
+        if (status == BOOT_ST_OK && memcmp((const void *)addr, page, FLASH_PAGE_SIZE) != 0) {
+            status = BOOT_ST_FLASH;
+        }
+        s_stats.pages_written++;
+    }
+    HAL_FLASH_Lock();
+
+    if (status == BOOT_ST_OK) {
+        crc32_compute((const void *)BOOT_APP_BASE, size, &actual);
+        if (actual != crc) {
+            status = BOOT_ST_CRC;
+        }
+    }
+    s_stats.install_ms = HAL_GetTick() - start;
+    return status;
+}
+
+/**
+ * @brief  读出并检查暂存区镜像头
+ */
+static uint8_t boot_read_header(boot_header_t *hdr) {
+    if (W25Q32_ReadData(BOOT_STAGE_ADDR, (uint8_t *)hdr, sizeof(*hdr)) != W25Q32_OK) {
+        return 0;
+    }
+    return hdr->magic == BOOT_HEADER_MAGIC && hdr->size != 0U &&
+           hdr->size <= BOOT_APP_MAX_SIZE &&
+           hdr->check == crc32_sw(CRC32_INIT, hdr, offsetof(boot_header_t, check));
+}
+
+/**
+ * @brief  全部块已写入暂存区：校验、写镜像头、安装
+ */
+static void boot_finish(void) {
+    boot_header_t hdr;
+    uint32_t crc;
+
+    s_end_pending = 0;
+    if (W25Q32_ReadCRC(BOOT_STAGE_IMAGE, s_size, &crc) != W25Q32_OK) {
+        boot_fail(BOOT_ST_FLASH);
+        return;
+    }
+    if (crc != s_crc) {
+        boot_fail(BOOT_ST_CRC);
+        return;
+    }
+
+    hdr.magic = BOOT_HEADER_MAGIC;
+    hdr.size = s_size;
+    hdr.crc = s_crc;
+    hdr.check = crc32_sw(CRC32_INIT, &hdr, offsetof(boot_header_t, check));
+    if (W25Q32_PageProgram(BOOT_STAGE_ADDR / W25Q32_PAGE_SIZE, 0, (uint8_t *)&hdr,
+                           sizeof(hdr)) != W25Q32_OK) {
+        boot_fail(BOOT_ST_FLASH);
+        return;
+    }
+
+    s_status = boot_install(s_size, s_crc);
+    if (s_status != BOOT_ST_OK) {
+        boot_fail(s_status);
+        return;
+    }
+    s_state = BOOT_STATE_DONE;
+    boot_send(BOOT_FRAME_DONE, 0, BOOT_ST_OK);
+}
+
+/**
+ * @brief  START：开始新会话，先擦除暂存区
+ */
+static void boot_on_start(const uint8_t *payload, uint16_t len) {
+    uint32_t size;
+
+    if (len != BOOT_START_LEN || s_state == BOOT_STATE_ERASING) {
+        /* 擦除期间上位机重发的 START 忽略 */
+        return;
+    }
+    if (s_state == BOOT_STATE_RECEIVING && s_expected == 0U &&
+        boot_get_le32(payload) == s_size && boot_get_le32(payload + 4) == s_crc) {
+        /* 重发的 START 与 READY 交错：暂存区已擦好，不重擦，再回一次 READY */
+        s_stats.duplicates++;
+        boot_send(BOOT_FRAME_READY, BOOT_WINDOW, BOOT_ST_OK);
+        return;
+    }
+    boot_op_flush();
+    size = boot_get_le32(payload);
+    if (size == 0U || size > BOOT_APP_MAX_SIZE || !boot_layout_ok()) {
+        /* 装不下，或者装了会覆盖自身：不擦暂存区，直接拒绝 */
+        s_state = BOOT_STATE_IDLE;
+        s_status = boot_layout_ok() ? BOOT_ST_SIZE : BOOT_ST_LAYOUT;
+        boot_send(BOOT_FRAME_READY, 0, s_status);
+        return;
+    }
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.frames = 1;
+    s_size = size;
+    s_crc = boot_get_le32(payload + 4);
+    s_chunks = (size + BOOT_CHUNK_SIZE - 1U) / BOOT_CHUNK_SIZE;
+    s_expected = 0;
+    s_programmed = 0;
+    s_nak_sent = 0;
+    s_end_pending = 0;
+    s_slot_head = 0;
+    s_slot_tail = 0;
+    s_slot_count = 0;
+    s_erase_addr = BOOT_STAGE_ADDR;
+    s_erase_end = BOOT_STAGE_IMAGE + size;
+    s_status = BOOT_ST_OK;
+    s_state = BOOT_STATE_ERASING;
+}
+
+/**
+ * @brief  DATA：按序的块进入缓冲区队列，其余的 NAK 或丢弃
+ */
+static void boot_on_data(uint8_t seq, uint16_t len, uint8_t in_slot) {
+    uint8_t ahead = (uint8_t)(seq - (uint8_t)s_expected);
+
+    if (s_state != BOOT_STATE_RECEIVING) {
+        return;
+    }
+    if (ahead == 0U) {
+        if (in_slot && s_expected < s_chunks && len == boot_chunk_len(s_expected)) {
+            s_slot[s_slot_head].index = s_expected;
+            s_slot[s_slot_head].len = len;
+            s_slot_head = (uint8_t)((s_slot_head + 1U) % BOOT_WINDOW);
+            s_slot_count++;
+            s_expected++;
+            s_nak_sent = 0;
+            s_stats.chunks++;
+        }
+        return;
+    }
+    if (ahead < 0x80U) {
+        /* 前面的块丢了：每个缺口只 NAK 一次，之后靠上位机超时重发 */
+        if (!s_nak_sent) {
+            s_nak_sent = 1;
+            s_stats.naks++;
+            boot_send(BOOT_FRAME_NAK, (uint8_t)s_expected, BOOT_ST_OK);
+        }
+        return;
+    }
+    /* 已经收过的块：上位机没收到 ACK，队列空时补发一次 */
+    s_stats.duplicates++;
+    if (s_slot_count == 0U) {
+        boot_send(BOOT_FRAME_ACK, (uint8_t)s_programmed, BOOT_ST_OK);
+    }
+}
+
+/**
+ * @brief  END
+ */
+static void boot_on_end(void) {
+    if (s_state == BOOT_STATE_DONE || s_state == BOOT_STATE_FAILED) {
+        /* DONE 丢了，上位机重发 END */
+        boot_send(BOOT_FRAME_DONE, 0, s_status);
+    } else if (s_state == BOOT_STATE_RECEIVING && s_expected == s_chunks) {
+        s_end_pending = 1;
+    }
+}
+
+/**
+ * @brief  一帧收完，校验并分发
+ */
+static void boot_on_frame(void) {
+    uint8_t type = s_rx_hdr[0];
+    uint8_t seq = s_rx_hdr[1];
+    uint32_t crc = crc_init(&crc_16_ccitt);
+
+    crc = crc_update(&crc_16_ccitt, crc, s_rx_hdr, BOOT_HDR_LEN);
+    crc = crc_update(&crc_16_ccitt, crc, s_rx_dst, s_rx_len);
+    if ((uint16_t)crc_final(&crc_16_ccitt, crc) !=
+        (uint16_t)(s_rx_crc[0] | ((uint16_t)s_rx_crc[1] << 8))) {
+        s_stats.bad_frames++;
+        return;
+    }
+    s_stats.frames++;
+
+    switch (type) {
+    case BOOT_FRAME_START:
+        boot_on_start(s_rx_dst, s_rx_len);
+        break;
+    case BOOT_FRAME_DATA:
+        boot_on_data(seq, s_rx_len, s_rx_in_slot);
+        break;
+    case BOOT_FRAME_END:
+        boot_on_end();
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief  帧头收完：检查长度，决定载荷写到哪里
+ * @note   按序的 DATA 直接写入下一个空闲块缓冲区，省去一次复制
+ */
+static void boot_on_header(void) {
+    uint8_t type = s_rx_hdr[0];
+
+    s_rx_len = (uint16_t)(s_rx_hdr[2] | ((uint16_t)s_rx_hdr[3] << 8));
+    if (s_rx_len > BOOT_CHUNK_SIZE) {
+        s_stats.bad_frames++;
+        s_rx_stage = BOOT_RX_SYNC;
+        return;
+    }
+    s_rx_in_slot = (type == BOOT_FRAME_DATA && s_state == BOOT_STATE_RECEIVING &&
+                    s_rx_hdr[1] == (uint8_t)s_expected && s_slot_count < BOOT_WINDOW);
+    s_rx_dst = s_rx_in_slot ? s_slot[s_slot_head].data : s_scratch;
+    s_rx_got = 0;
+    s_rx_stage = (s_rx_len != 0U) ? BOOT_RX_BODY : BOOT_RX_CRC;
+}
+
+/**
+ * @brief  解析一段连续的字节
+ * @retval 消耗的字节数（至少 1）
+ */
+static uint32_t boot_parse(const uint8_t *data, uint32_t n) {
+    uint32_t take;
+    const uint8_t *sync;
+
+    switch (s_rx_stage) {
+    case BOOT_RX_SYNC:
+        sync = memchr(data, BOOT_SYNC_HOST, n);
+        if (sync == NULL) {
+            return n;
+        }
+        s_rx_got = 0;
+        s_rx_stage = BOOT_RX_HDR;
+        return (uint32_t)(sync - data) + 1U;
+    case BOOT_RX_HDR:
+        take = BOOT_HDR_LEN - s_rx_got;
+        take = (take < n) ? take : n;
+        memcpy(&s_rx_hdr[s_rx_got], data, take);
+        s_rx_got += take;
+        if (s_rx_got == BOOT_HDR_LEN) {
+            boot_on_header();
+        }
+        return take;
+    case BOOT_RX_BODY:
+        take = (uint32_t)s_rx_len - s_rx_got;
+        take = (take < n) ? take : n;
+        memcpy(s_rx_dst + s_rx_got, data, take);
+        s_rx_got += take;
+        if (s_rx_got == s_rx_len) {
+            s_rx_got = 0;
+            s_rx_stage = BOOT_RX_CRC;
+        }
+        return take;
+    case BOOT_RX_CRC:
+    default:
+        s_rx_crc[s_rx_got++] = data[0];
+        if (s_rx_got == 2U) {
+            s_rx_stage = BOOT_RX_SYNC;
+            boot_on_frame();
+        }
+        return 1;
+    }
+}
+
+/**
+ * @brief  取出 DMA 新写入环形缓冲区的字节
+ */
+static void boot_receive(void) {
+    uint32_t head = BOOT_RX_RING - DMA_GetInstance(BOOT_DMA_CHANNEL)->CNDTR;
+
+    if (head == BOOT_RX_RING) {
+        head = 0;
+    }
+    if (head != s_rx_tail) {
+        s_last_rx = HAL_GetTick();
+    }
+    while (s_rx_tail != head) {
+        uint32_t end = (head > s_rx_tail) ? head : BOOT_RX_RING;
+        s_rx_tail += boot_parse(&s_rx_ring[s_rx_tail], end - s_rx_tail);
+        if (s_rx_tail == BOOT_RX_RING) {
+            s_rx_tail = 0;
+        }
+    }
+}
+
+/**
+ * @brief  推进 W25Q32：擦除暂存区，或把最旧的块编程进去
+ */
+static void boot_flash_step(void) {
+    if (s_op_active) {
+        if (W25Q32_Op_Poll(&s_op) == PT_WAITING) {
+            return;
+        }
+        s_op_active = 0;
+        if (s_op.status != W25Q32_OK) {
+            boot_fail(BOOT_ST_FLASH);
+            return;
+        }
+        if (s_state == BOOT_STATE_RECEIVING) {
+            /* 页编程完成：释放缓冲区，累计确认 */
+            s_slot_tail = (uint8_t)((s_slot_tail + 1U) % BOOT_WINDOW);
+            s_slot_count--;
+            s_programmed++;
+            boot_send(BOOT_FRAME_ACK, (uint8_t)s_programmed, BOOT_ST_OK);
+        }
+    }
+
+    if (s_state == BOOT_STATE_ERASING) {
+        uint32_t left;
+
+        if (s_erase_addr >= s_erase_end) {
+            s_state = BOOT_STATE_RECEIVING;
+            boot_send(BOOT_FRAME_READY, BOOT_WINDOW, BOOT_ST_OK);
+            return;
+        }
+        left = s_erase_end - s_erase_addr;
+        if ((s_erase_addr % W25Q32_BLOCK_64K_SIZE) == 0U && left >= BOOT_BLOCK_ERASE_MIN) {
+            W25Q32_BlockErase_64KB_Start(&s_op, s_erase_addr / W25Q32_BLOCK_64K_SIZE);
+            s_erase_addr += W25Q32_BLOCK_64K_SIZE;
+        } else {
+            W25Q32_SectorErase_4KB_Start(&s_op, s_erase_addr / W25Q32_SECTOR_SIZE);
+            s_erase_addr += W25Q32_SECTOR_SIZE;
+        }
+        s_op_active = 1;
+        return;
+    }
+
+    if (s_state != BOOT_STATE_RECEIVING) {
+        return;
+    }
+    if (s_slot_count > 0U) {
+        boot_slot_t *slot = &s_slot[s_slot_tail];
+        W25Q32_PageProgram_Start(&s_op, BOOT_STAGE_IMAGE / W25Q32_PAGE_SIZE + slot->index, 0,
+                                 slot->data, slot->len);
+        s_op_active = 1;
+    } else if (s_end_pending) {
+        boot_finish();
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  初始化 W25Q32，USART1 切换到升级波特率并开始接收
+ */
+int boot_init(void) {
+    W25Q32_State_t flash;
+    DMA_Config_t dma;
+
+    if (s_ready) {
+        boot_deinit();
+    }
+    if (W25Q32_Init(&flash) != W25Q32_OK) {
+        return BOOT_ERROR;
+    }
+    if (DMA_Claim(BOOT_DMA_CHANNEL, "boot") != DMA_MGR_OK) {
+        return BOOT_BUSY;
+    }
+    DMA_SetCallback(BOOT_DMA_CHANNEL, NULL, NULL, 0);
+
+    /* 步骤1：等 printf 的最后一个字节发完，保存 USART1 配置 */
+    while (!(USART1->SR & USART_SR_TC)) {
+    }
+    s_saved_brr = USART1->BRR;
+    s_saved_cr1 = USART1->CR1;
+    s_saved_cr3 = USART1->CR3;
+
+    USART1->CR1 = 0;
+    USART1->BRR = (BOOT_USART_CLK + BOOT_BAUD / 2U) / BOOT_BAUD;
+    USART1->CR3 = USART_CR3_DMAR;
+    (void)USART1->SR;
+    (void)USART1->DR;
+
+    /* 步骤2：RX DMA 循环写入环形缓冲区，不开中断 */
+    dma.PeriphBaseAddr = (uint32_t)&USART1->DR;
+    dma.PeriphInc = DMA_Inc_Disable;
+    dma.MemBaseAddr = (uint32_t)s_rx_ring;
+    dma.MemInc = DMA_Inc_Enable;
+    dma.PeriphDataSize = DMA_DataSize_Byte;
+    dma.MemDataSize = DMA_DataSize_Byte;
+    dma.Direction = DMA_DIR_PeripheralSRC;
+    dma.BufferSize = BOOT_RX_RING;
+    dma.Mode = DMA_Mode_Circular;
+    dma.Priority = DMA_Priority_High;
+    dma.M2M = false;
+    if (DMA_StartTransfer(BOOT_DMA_CHANNEL, &dma) != DMA_MGR_OK) {
+        DMA_Release(BOOT_DMA_CHANNEL);
+        USART1->CR3 = s_saved_cr3;
+        USART1->BRR = s_saved_brr;
+        USART1->CR1 = s_saved_cr1;
+        return BOOT_BUSY;
+    }
+    USART1->CR1 = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+
+    s_rx_tail = 0;
+    s_rx_stage = BOOT_RX_SYNC;
+    s_last_rx = HAL_GetTick();
+    s_op_active = 0;
+    s_state = BOOT_STATE_IDLE;
+    s_status = BOOT_ST_OK;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_ready = 1;
+    return BOOT_OK;
+}
+
+/**
+ * @brief  停止接收，恢复 USART1
+ */
+void boot_deinit(void) {
+    if (!s_ready) {
+        return;
+    }
+    boot_op_flush();
+    while (!(USART1->SR & USART_SR_TC)) {
+    }
+    USART1->CR1 = 0;
+    DMA_AbortTransfer(BOOT_DMA_CHANNEL);
+    DMA_Release(BOOT_DMA_CHANNEL);
+    USART1->CR3 = s_saved_cr3;
+    USART1->BRR = s_saved_brr;
+    USART1->CR1 = s_saved_cr1;
+    s_ready = 0;
+}
+
+/**
+ * @brief  主循环轮询
+ */
+boot_state_t boot_poll(void) {
+    if (!s_ready) {
+        return BOOT_STATE_IDLE;
+    }
+    boot_receive();
+    boot_flash_step();
+    if ((s_state == BOOT_STATE_ERASING || s_state == BOOT_STATE_RECEIVING) &&
+        HAL_GetTick() - s_last_rx > BOOT_SESSION_TIMEOUT_MS) {
+        boot_fail(BOOT_ST_TIMEOUT);
+    }
+    return s_state;
+}
+
+uint8_t boot_status(void) {
+    return s_status;
+}
+
+void boot_get_stats(boot_stats_t *stats) {
+    *stats = s_stats;
+}
+
+/**
+ * @brief  必要时从暂存区重新安装
+ */
+int boot_resume(void) {
+    boot_header_t hdr;
+    uint32_t crc;
+
+    if (!boot_read_header(&hdr)) {
+        return BOOT_ERROR;
+    }
+    crc32_compute((const void *)BOOT_APP_BASE, hdr.size, &crc);
+    if (crc == hdr.crc) {
+        return BOOT_OK;
+    }
+    /* 暂存镜像本身也要完好，否则宁可保留现有应用 */
+    if (W25Q32_ReadCRC(BOOT_STAGE_IMAGE, hdr.size, &crc) != W25Q32_OK || crc != hdr.crc) {
+        return BOOT_ERROR;
+    }
+    return (boot_install(hdr.size, hdr.crc) == BOOT_ST_OK) ? BOOT_OK : BOOT_ERROR;
+}
+
+/**
+ * @brief  检查应用向量表
+ */
+uint8_t boot_app_valid(void) {
+    uint32_t sp = *(const volatile uint32_t *)BOOT_APP_BASE;
+    uint32_t pc = *(const volatile uint32_t *)(BOOT_APP_BASE + 4U);
+
+    return sp > SRAM_BASE && sp <= BOOT_SRAM_END && (sp & 3U) == 0U &&
+           (pc & 1U) != 0U && pc > BOOT_APP_BASE && pc < BOOT_FLASH_END;
+}
+
+/**
+ * @brief  跳转到应用
+ */
+void boot_jump(void) {
+    if (!boot_app_valid()) {
+        return;
+    }
+#if !defined(STM32_HOST_BUILD)
+    {
+        uint32_t sp = *(const volatile uint32_t *)BOOT_APP_BASE;
+        void (*entry)(void) = (void (*)(void))(*(const volatile uint32_t *)(BOOT_APP_BASE + 4U));
+
+        __disable_irq();
+        SysTick->CTRL = 0;
+        for (uint32_t i = 0; i < sizeof(NVIC->ICER) / sizeof(NVIC->ICER[0]); i++) {
+            NVIC->ICER[i] = 0xFFFFFFFFUL;
+            NVIC->ICPR[i] = 0xFFFFFFFFUL;
+        }
+        SCB->VTOR = BOOT_APP_BASE;
+        __DSB();
+        __ISB();
+        __set_MSP(sp);
+        __enable_irq();
+        entry();
+    }
+#endif
+}
+
+/**
+ * @brief  引导程序主流程
+ */
+void boot_run(uint32_t wait_ms) {
+    uint32_t start = HAL_GetTick();
+    boot_state_t state = BOOT_STATE_IDLE;
+
+    if (boot_init() == BOOT_OK) {
+        /* 等待期内开始的会话一直处理到结束 */
+        while (state == BOOT_STATE_ERASING || state == BOOT_STATE_RECEIVING ||
+               HAL_GetTick() - start < wait_ms) {
+            state = boot_poll();
+            if (state == BOOT_STATE_DONE || state == BOOT_STATE_FAILED) {
+                break;
+            }
+        }
+        boot_deinit();
+    }
+    if (state != BOOT_STATE_DONE) {
+        boot_resume();
+    }
+    boot_jump();
+}
+
+/************************ END OF FILE *****************************************/
@@ -10,9 +10,36 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "can_driver.h"
+#include "main.h"
+#include "stm32f1xx_hal.h"
 
 /* Private macro definitions -------------------------------------------------*/
 
+/** 硬件时间戳 16 位计数器的回绕周期与半周期（单位：位时间） */
+#define CAN_TIME_WRAP 0x10000ULL
+#define CAN_TIME_HALF_WRAP 0x8000ULL
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 时间戳扩展所用的时间基准
+ * @note  以最近一次观测到的时间戳作为锚点，用 HAL_GetTick 推算当前位时间，
+ *        再把 16 位原始值放到离推算值最近的回绕周期内
+ */
+typedef struct {
+  uint64_t last_ext;    /**< 最近一次扩展后的位时间 */
+  uint32_t last_tick;   /**< 观测 last_ext 时的 HAL_GetTick 值 */
+  uint32_t bits_per_ms; /**< 每毫秒的位时间数 (baudrate / 1000) */
+  uint8_t ttcm;         /**< 是否使能了 TTCM（硬件时间戳有效） */
+} CAN_TimeBase_t;
+
+/* Private variables ---------------------------------------------------------*/
+static CAN_TimeBase_t s_can_time = {CAN_TIME_WRAP, 0, 500, 0};
+
+/** FIFO 收到报文时投递事件的目标（NULL 表示轮询） */
+static ev_task_t *s_rx_task = NULL;
+static uint16_t s_rx_sig = 0;
+
 /* Private function prototypes -----------------------------------------------*/
 static void CAN_GPIO_Init(void);
 static int CAN_CalculateBTR(uint32_t baudrate, uint32_t *btr_value);
@@ -131,6 +158,19 @@ static int CAN_CalculateBTR(uint32_t baudrate, uint32_t *btr_value) {
  *         CAN_INIT_EXIT_TIMEOUT: 退出初始化模式超时
  */
 int CAN_Init(uint32_t baudrate, CAN_Mode_t mode) {
+  return CAN_InitEx(baudrate, mode, CAN_OPT_NONE);
+}
+
+/**
+ * @brief  初始化 CAN 外设（带附加选项）
+ * @param  baudrate: 波特率（如 500000 表示 500kbps）
+ * @param  mode: 工作模式
+ * @param  options: CAN_OPT_xxx 按位或组合
+ * @retval CAN_INIT_OK: 成功
+ *         CAN_INIT_ENTER_TIMEOUT: 进入初始化模式超时
+ *         CAN_INIT_EXIT_TIMEOUT: 退出初始化模式超时
+ */
+int CAN_InitEx(uint32_t baudrate, CAN_Mode_t mode, uint32_t options) {
   uint32_t timeout;
   uint32_t btr_value = 0;
 
@@ -194,6 +234,19 @@ int CAN_Init(uint32_t baudrate, CAN_Mode_t mode) {
 
   CAN1->MCR |= CAN_MCR_AWUM; /* 手动唤醒模式 */
 
+  /* TTCM：使能后 RDTR/TDTR 的 TIME[15:0] 在帧起始 (SOF) 处捕获内部位计数器 */
+  if (options & CAN_OPT_TTCM) {
+    CAN1->MCR |= CAN_MCR_TTCM;
+  } else {
+    CAN1->MCR &= ~CAN_MCR_TTCM;
+  }
+
+  /* TXFP：按请求顺序发送，周期报文的先后次序不受 ID 影响 */
+  if (options & CAN_OPT_TXFP) {
+    CAN1->MCR |= CAN_MCR_TXFP;
+  } else {
+    CAN1->MCR &= ~CAN_MCR_TXFP;
+  }
   // -------------------------------------------------------------------------
 
   /* ========== 步骤6：配置位时序寄存器 ========== */
@@ -300,6 +353,16 @@ int CAN_Init(uint32_t baudrate, CAN_Mode_t mode) {
   }
   // -------------------------------------------------------------------------
 
+  /* ========== 步骤9：复位时间戳基准 ========== */
+  /* 锚点从一个回绕周期处开始，保证首个时间戳向前回退时不会下溢 */
+  s_can_time.last_ext = CAN_TIME_WRAP;
+  s_can_time.last_tick = HAL_GetTick();
+  s_can_time.bits_per_ms = baudrate / 1000;
+  if (s_can_time.bits_per_ms == 0) {
+    s_can_time.bits_per_ms = 1;
+  }
+  s_can_time.ttcm = (options & CAN_OPT_TTCM) ? 1 : 0;
+
   return CAN_INIT_OK;
 }
 
@@ -416,8 +479,20 @@ int CAN_Transmit(uint32_t id, uint8_t ide, uint8_t rtr, uint8_t *data,
  * @retval CAN_TX_WAIT_OK/ALST/TERR/TIMEOUT
  */
 int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout) {
+  return CAN_TransmitWaitTimestamped(mailbox, timeout, NULL);
+}
+
+/**
+ * @brief  等待发送完成并取回发送时间戳
+ * @param  mailbox: 邮箱号 (0-2)
+ * @param  timeout: 超时计数值
+ * @param  timestamp: [out] 扩展后的发送 SOF 时间戳（可为 NULL）
+ * @retval CAN_TX_WAIT_OK/ALST/TERR/TIMEOUT
+ */
+int CAN_TransmitWaitTimestamped(uint8_t mailbox, uint32_t timeout,
+                                uint64_t *timestamp) {
   uint32_t tsr;
-  uint32_t rqcp_mask, txok_mask, alst_mask, terr_mask;
+  uint32_t rqcp_mask, txok_mask, alst_mask;
 
   /* 参数检查 */
   if (mailbox > 2) {
@@ -431,30 +506,27 @@ int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout) {
     // 寄存器：CAN1->TSR
     // 位域：RQCP0 (bit 0), TXOK0 (bit 1), ALST0 (bit 2), TERR0 (bit 3)
     // -------------------------------------------------------------------------
-    // rqcp_mask = CAN_TSR_RQCP0;
-    // txok_mask = CAN_TSR_TXOK0;
-    // alst_mask = CAN_TSR_ALST0;
-    // terr_mask = CAN_TSR_TERR0;
+    rqcp_mask = CAN_TSR_RQCP0;
+    txok_mask = CAN_TSR_TXOK0;
+    alst_mask = CAN_TSR_ALST0;
     // -------------------------------------------------------------------------
     break;
   case 1:
     // TODO: 设置邮箱 1 的状态位掩码
     // 位域：RQCP1 (bit 8), TXOK1 (bit 9), ALST1 (bit 10), TERR1 (bit 11)
     // -------------------------------------------------------------------------
-    // rqcp_mask = CAN_TSR_RQCP1;
-    // txok_mask = CAN_TSR_TXOK1;
-    // alst_mask = CAN_TSR_ALST1;
-    // terr_mask = CAN_TSR_TERR1;
+    rqcp_mask = CAN_TSR_RQCP1;
+    txok_mask = CAN_TSR_TXOK1;
+    alst_mask = CAN_TSR_ALST1;
     // -------------------------------------------------------------------------
     break;
   case 2:
     // TODO: 设置邮箱 2 的状态位掩码
     // 位域：RQCP2 (bit 16), TXOK2 (bit 17), ALST2 (bit 18), TERR2 (bit 19)
     // -------------------------------------------------------------------------
-    // rqcp_mask = CAN_TSR_RQCP2;
-    // txok_mask = CAN_TSR_TXOK2;
-    // alst_mask = CAN_TSR_ALST2;
-    // terr_mask = CAN_TSR_TERR2;
+    rqcp_mask = CAN_TSR_RQCP2;
+    txok_mask = CAN_TSR_TXOK2;
+    alst_mask = CAN_TSR_ALST2;
     // -------------------------------------------------------------------------
     break;
   default:
@@ -466,17 +538,17 @@ int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout) {
   // 寄存器：CAN1->TSR
   // 条件：检测 RQCPx == 1（请求完成）
   // -------------------------------------------------------------------------
-  // while (timeout > 0) {
-  //     tsr = CAN1->TSR;
-  //     if (tsr & rqcp_mask) {
-  //         break;  /* 请求完成 */
-  //     }
-  //     timeout--;
-  // }
-  //
-  // if (timeout == 0) {
-  //     return CAN_TX_WAIT_TIMEOUT;
-  // }
+  while (timeout > 0) {
+    tsr = CAN1->TSR;
+    if (tsr & rqcp_mask) {
+      break; /* 请求完成 */
+    }
+    timeout--;
+  }
+
+  if (timeout == 0) {
+    return CAN_TX_WAIT_TIMEOUT;
+  }
   // -------------------------------------------------------------------------
 
   /* ========== 检查发送结果 ========== */
@@ -484,21 +556,28 @@ int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout) {
   // 寄存器：CAN1->TSR
   // 判断：TXOK = 1 表示成功，ALST = 1 表示仲裁丢失，TERR = 1 表示错误
   // -------------------------------------------------------------------------
-  // tsr = CAN1->TSR;
-  //
-  // /* 清除 RQCP 标志（写 1 清除） */
-  // CAN1->TSR = rqcp_mask;
-  //
-  // if (tsr & txok_mask) {
-  //     return CAN_TX_WAIT_OK;
-  // } else if (tsr & alst_mask) {
-  //     return CAN_TX_WAIT_ALST;
-  // } else {
-  //     return CAN_TX_WAIT_TERR;
-  // }
-  // -------------------------------------------------------------------------
+  tsr = CAN1->TSR;
 
-  return CAN_TX_WAIT_OK; /* 临时返回 */
+  /* 清除 RQCP 标志（写 1 清除，同时清除 TXOK/ALST/TERR） */
+  CAN1->TSR = rqcp_mask;
+
+  if (tsr & txok_mask) {
+    /* TTCM 下 TDTR.TIME 保存本邮箱报文的 SOF 时刻 */
+    if (timestamp != NULL) {
+      if (s_can_time.ttcm) {
+        *timestamp = CAN_TimestampExtend(
+            (uint16_t)(CAN1->sTxMailBox[mailbox].TDTR >> CAN_TDT0R_TIME_Pos));
+      } else {
+        *timestamp = CAN_TimestampNow();
+      }
+    }
+    return CAN_TX_WAIT_OK;
+  } else if (tsr & alst_mask) {
+    return CAN_TX_WAIT_ALST;
+  } else {
+    return CAN_TX_WAIT_TERR;
+  }
+  // -------------------------------------------------------------------------
 }
 
 /**
@@ -511,8 +590,26 @@ int CAN_TransmitWait(uint8_t mailbox, uint32_t timeout) {
  * @param  len: [out] 数据长度
  * @retval CAN_RX_OK/CAN_RX_EMPTY
  */
-int CAN_Receive(uint8_t fifo, uint32_t *id, uint8_t *ide, uint8_t *rtr,
-                uint8_t *data, uint8_t *len) {
+RAMFUNC int CAN_Receive(uint8_t fifo, uint32_t *id, uint8_t *ide, uint8_t *rtr,
+                        uint8_t *data, uint8_t *len) {
+  return CAN_ReceiveTimestamped(fifo, id, ide, rtr, data, len, NULL);
+}
+
+/**
+ * @brief  接收 CAN 报文并取回接收时间戳（轮询方式）
+ * @param  fifo: FIFO 号 (0 或 1)
+ * @param  id: [out] 接收到的报文标识符
+ * @param  ide: [out] 帧类型
+ * @param  rtr: [out] 远程帧标志
+ * @param  data: [out] 数据缓冲区
+ * @param  len: [out] 数据长度
+ * @param  timestamp: [out] 扩展后的接收 SOF 时间戳（可为 NULL）
+ * @retval CAN_RX_OK/CAN_RX_EMPTY
+ * @note   在 RAM 中执行（RAMFUNC）
+ */
+RAMFUNC int CAN_ReceiveTimestamped(uint8_t fifo, uint32_t *id, uint8_t *ide,
+                                   uint8_t *rtr, uint8_t *data, uint8_t *len,
+                                   uint64_t *timestamp) {
   uint32_t rir, rdtr, rdlr, rdhr;
   __IO uint32_t *rfr; /* FIFO 状态寄存器指针 */
 
@@ -576,6 +673,15 @@ int CAN_Receive(uint8_t fifo, uint32_t *id, uint8_t *ide, uint8_t *rtr,
   if (*len > 8) {
     *len = 8;
   }
+
+  /* TIME[15:0] (bit 16-31) = 帧起始时刻的位计数器（仅 TTCM 下有效） */
+  if (timestamp != NULL) {
+    if (s_can_time.ttcm) {
+      *timestamp = CAN_TimestampExtend((uint16_t)(rdtr >> CAN_RDT0R_TIME_Pos));
+    } else {
+      *timestamp = CAN_TimestampNow();
+    }
+  }
   // -------------------------------------------------------------------------
 
   /* ========== 步骤4：读取数据（数据帧时） ========== */
@@ -603,11 +709,7 @@ int CAN_Receive(uint8_t fifo, uint32_t *id, uint8_t *ide, uint8_t *rtr,
   // 操作：置位 RFOM0 (bit 5) 或 RFOM1 (bit 5)
   // 注意：必须释放邮箱才能读取下一条报文！
   // -------------------------------------------------------------------------
-  if (fifo == 0) {
-    CAN1->RF0R |= CAN_RF0R_RFOM0;
-  } else {
-    CAN1->RF1R |= CAN_RF1R_RFOM1;
-  }
+  *rfr |= CAN_RF0R_RFOM0; /* RFOM0 与 RFOM1 同为 bit 5 */
   // -------------------------------------------------------------------------
 
   return CAN_RX_OK;
@@ -634,6 +736,7 @@ int CAN_FilterConfig(uint8_t filter_num, CAN_FilterMode_t mode,
   }
 
   filter_bit = (1UL << filter_num);
+  (void)filter_bit; /* 下面的步骤实现后使用 */
 
   /* ========== 步骤1：进入过滤器初始化模式 ========== */
   // TODO: 置位 CAN_FMR.FINIT
@@ -726,9 +829,11 @@ int CAN_FilterConfig(uint8_t filter_num, CAN_FilterMode_t mode,
  * @retval 错误标志组合 (bit0=EWGF, bit1=EPVF, bit2=BOFF)
  */
 uint8_t CAN_GetError(uint8_t *tec, uint8_t *rec, uint8_t *lec) {
-  uint32_t esr;
+  uint32_t esr = 0;
   uint8_t error_flags = 0;
 
+  (void)esr; /* 下面的步骤实现后使用 */
+
   /* ========== 读取 ESR 寄存器 ========== */
   // TODO: 读取 CAN_ESR 寄存器
   // 寄存器：CAN1->ESR
@@ -769,14 +874,225 @@ uint8_t CAN_GetPendingMessages(uint8_t fifo) {
   // 寄存器：CAN1->RF0R 或 CAN1->RF1R
   // 位域：FMP[1:0] (bit 0-1) = 待处理消息数量
   // -------------------------------------------------------------------------
-  // if (fifo == 0) {
-  //     return (CAN1->RF0R & CAN_RF0R_FMP0);
-  // } else {
-  //     return (CAN1->RF1R & CAN_RF1R_FMP1);
-  // }
+  if (fifo == 0) {
+    return (CAN1->RF0R & CAN_RF0R_FMP0);
+  } else {
+    return (CAN1->RF1R & CAN_RF1R_FMP1);
+  }
   // -------------------------------------------------------------------------
+}
+
+/**
+ * @brief  批量接收：一次调用排空 FIFO0 和 FIFO1
+ * @param  frames: [out] 帧缓冲区
+ * @param  max: 缓冲区可容纳的帧数
+ * @retval 实际读出的帧数
+ */
+uint8_t CAN_ReceiveBurst(CAN_Frame_t *frames, uint8_t max) {
+  uint8_t count = 0;
+  uint8_t fifo;
+
+  if (frames == NULL) {
+    return 0;
+  }
+
+  for (fifo = 0; fifo < 2; fifo++) {
+    __IO uint32_t *rfr = (fifo == 0) ? &CAN1->RF0R : &CAN1->RF1R;
+    CAN_FIFOMailBox_TypeDef *mb = &CAN1->sFIFOMailBox[fifo];
+
+    /* FMP[1:0] 在 RF0R/RF1R 中位置相同，每释放一帧硬件自动减一 */
+    while (count < max && (*rfr & CAN_RF0R_FMP0) != 0) {
+      CAN_Frame_t *f = &frames[count];
+      uint32_t rir = mb->RIR;
+      uint32_t rdtr = mb->RDTR;
+
+      if (rir & CAN_RI0R_IDE) {
+        f->id = (rir >> CAN_RI0R_EXID_Pos) & 0x1FFFFFFF;
+      } else {
+        f->id = (rir >> CAN_RI0R_STID_Pos) & 0x7FF;
+      }
+      f->flags = ((rir & CAN_RI0R_IDE) ? CAN_FRAME_FLAG_IDE : 0) |
+                 ((rir & CAN_RI0R_RTR) ? CAN_FRAME_FLAG_RTR : 0) |
+                 (fifo ? CAN_FRAME_FLAG_FIFO1 : 0);
+      f->dlc = rdtr & 0x0F;
+      if (f->dlc > 8) {
+        f->dlc = 8;
+      }
+      f->time = (uint16_t)(rdtr >> CAN_RDT0R_TIME_Pos);
+
+      /* 整字复制，DATA0 位于 RDLR 最低字节，与 Cortex-M 小端布局一致 */
+      f->data.w[0] = mb->RDLR;
+      f->data.w[1] = mb->RDHR;
+
+      /* RFOM 在 RF0R/RF1R 中位置相同 */
+      *rfr |= CAN_RF0R_RFOM0;
+      count++;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * @brief  批量发送：一次调用填满所有空闲邮箱
+ * @param  frames: 待发送帧数组
+ * @param  count: 帧数
+ * @retval 实际提交的帧数
+ */
+uint8_t CAN_TransmitBurst(const CAN_Frame_t *frames, uint8_t count) {
+  uint32_t tsr;
+  uint8_t queued = 0;
+  uint8_t mailbox;
+
+  if (frames == NULL) {
+    return 0;
+  }
+
+  /* TME0/1/2 连续排列在 bit 26-28，读一次 TSR 即可知道所有空闲邮箱 */
+  tsr = CAN1->TSR;
+
+  for (mailbox = 0; mailbox < CAN_TX_MAILBOX_COUNT && queued < count;
+       mailbox++) {
+    const CAN_Frame_t *f = &frames[queued];
+    CAN_TxMailBox_TypeDef *mb = &CAN1->sTxMailBox[mailbox];
+    uint32_t tir;
+
+    if ((tsr & (CAN_TSR_TME0 << mailbox)) == 0) {
+      continue;
+    }
+
+    if (f->flags & CAN_FRAME_FLAG_IDE) {
+      tir = (f->id << CAN_TI0R_EXID_Pos) | CAN_TI0R_IDE;
+    } else {
+      tir = f->id << CAN_TI0R_STID_Pos;
+    }
+    if (f->flags & CAN_FRAME_FLAG_RTR) {
+      tir |= CAN_TI0R_RTR;
+    }
+
+    mb->TDTR = (f->dlc > 8) ? 8 : f->dlc;
+    mb->TDLR = f->data.w[0];
+    mb->TDHR = f->data.w[1];
+    /* 标识符与 TXRQ 一次写入 */
+    mb->TIR = tir | CAN_TI0R_TXRQ;
+    queued++;
+  }
+
+  return queued;
+}
+
+/**
+ * @brief  把 16 位硬件时间戳扩展为 64 位位时间
+ * @param  raw: RDTR/TDTR 中的 TIME[15:0]
+ * @retval 扩展后的位时间（单位：CAN 位时间）
+ *
+ * @note   先用 HAL_GetTick 从锚点推算"现在"的位时间，再取低 16 位等于 raw 且
+ *         与推算值相差不超过半个回绕周期的值，因此：
+ *         - 两次调用之间即使经历了多次 16 位回绕也能正确恢复高位；
+ *         - 晚处理的旧报文（如 FIFO 中积压的帧）可以早于上一次的结果；
+ *         - 前提是两次观测的处理延迟之差小于半个回绕周期
+ *           （500kbps 下约 65ms）。
+ *         非可重入，应只在同一个上下文（主循环或同一中断）中调用。
+ */
+uint64_t CAN_TimestampExtend(uint16_t raw) {
+  uint32_t now = HAL_GetTick();
+  uint64_t est = CAN_TimestampNow();
+  uint64_t ext = (est & ~(CAN_TIME_WRAP - 1)) | raw;
+
+  /* 选取距推算值最近的回绕周期 */
+  if (ext > est + CAN_TIME_HALF_WRAP) {
+    ext -= CAN_TIME_WRAP;
+  } else if (ext + CAN_TIME_HALF_WRAP < est) {
+    ext += CAN_TIME_WRAP;
+  }
 
-  return 0; /* 临时返回 */
+  /* 只在时间前进时移动锚点，乱序的旧时间戳不影响基准 */
+  if (ext > s_can_time.last_ext) {
+    s_can_time.last_ext = ext;
+    s_can_time.last_tick = now;
+  }
+
+  return ext;
+}
+
+/**
+ * @brief  根据 HAL_GetTick 推算当前的 64 位位时间
+ * @retval 推算的位时间（分辨率为 1ms 对应的位数）
+ */
+uint64_t CAN_TimestampNow(void) {
+  uint32_t elapsed = HAL_GetTick() - s_can_time.last_tick;
+
+  return s_can_time.last_ext + (uint64_t)elapsed * s_can_time.bits_per_ms;
+}
+
+/**
+ * @brief  把扩展时间戳换算到 HAL_GetTick 的毫秒时间轴
+ * @param  timestamp: CAN_TimestampExtend 返回的位时间
+ * @retval 对应的 HAL_GetTick 值（ms）
+ */
+uint32_t CAN_TimestampToTick(uint64_t timestamp) {
+  int64_t diff = (int64_t)(timestamp - s_can_time.last_ext);
+
+  return s_can_time.last_tick +
+         (uint32_t)(diff / (int64_t)s_can_time.bits_per_ms);
+}
+
+/**
+ * @brief  把扩展时间戳换算为微秒
+ * @param  timestamp: CAN_TimestampExtend 返回的位时间
+ * @retval 微秒数（1 位时间 = 1000 / bits_per_ms 微秒）
+ */
+uint64_t CAN_TimestampToUs(uint64_t timestamp) {
+  return timestamp * 1000U / s_can_time.bits_per_ms;
+}
+
+/**
+ * @brief  设置 FIFO 收到报文时投递事件的目标
+ * @param  task: 目标任务，NULL 表示关闭接收中断
+ * @param  sig: 信号，事件 param 为 FIFO 号
+ */
+void CAN_SetRxEvent(ev_task_t *task, uint16_t sig) {
+  CAN1->IER &= ~(CAN_IER_FMPIE0 | CAN_IER_FMPIE1);
+  s_rx_sig = sig;
+  s_rx_task = task;
+
+  if (task == NULL) {
+    NVIC_DisableIRQ(USB_LP_CAN1_RX0_IRQn);
+    NVIC_DisableIRQ(CAN1_RX1_IRQn);
+    return;
+  }
+
+  NVIC_SetPriority(USB_LP_CAN1_RX0_IRQn, 2);
+  NVIC_SetPriority(CAN1_RX1_IRQn, 2);
+  NVIC_EnableIRQ(USB_LP_CAN1_RX0_IRQn);
+  NVIC_EnableIRQ(CAN1_RX1_IRQn);
+  CAN1->IER |= CAN_IER_FMPIE0 | CAN_IER_FMPIE1;
+}
+
+/**
+ * @brief  重新打开 FIFO 的报文挂起中断
+ * @param  fifo: FIFO 号 (0 或 1)
+ */
+void CAN_RxEventRearm(uint8_t fifo) {
+  uint32_t primask = __get_PRIMASK();
+
+  /* 另一个 FIFO 的中断会改写 IER，读-改-写期间关中断 */
+  __disable_irq();
+  if (s_rx_task != NULL) {
+    CAN1->IER |= (fifo == 0) ? CAN_IER_FMPIE0 : CAN_IER_FMPIE1;
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  FIFO 报文挂起中断：关掉该 FIFO 的 FMPIE，通知任务来读
+ * @param  fifo: FIFO 号 (0 或 1)
+ */
+RAMFUNC void CAN_RxIRQHandler(uint8_t fifo) {
+  CAN1->IER &= ~((fifo == 0) ? CAN_IER_FMPIE0 : CAN_IER_FMPIE1);
+  if (s_rx_task != NULL) {
+    ev_post(s_rx_task, s_rx_sig, fifo, NULL);
+  }
 }
 
 /************************ END OF FILE *****************************************/
@@ -0,0 +1,170 @@
+/**
+ * @file    can_sched.c
+ * @brief   CAN 周期报文调度器实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "can_sched.h"
+#include "can_driver.h"
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 调度表项
+ */
+typedef struct {
+  uint32_t id;            /**< 报文标识符 */
+  uint32_t period_ms;     /**< 发送周期 */
+  uint32_t next_due;      /**< 下一次截止时刻 */
+  uint8_t data[8];        /**< 报文数据 */
+  uint8_t ide;            /**< 帧类型 */
+  uint8_t len;            /**< 数据长度 */
+  uint8_t used;           /**< 表项是否占用 */
+  CAN_SchedStats_t stats; /**< 统计信息 */
+} CAN_SchedEntry_t;
+
+/* Private variables ---------------------------------------------------------*/
+static CAN_SchedEntry_t s_sched[CAN_SCHED_MAX_ENTRIES];
+static int s_start; /**< 本轮从哪个表项开始扫描 */
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  检查句柄是否有效
+ */
+static int CAN_Sched_IsValid(int handle) {
+  return handle >= 0 && handle < CAN_SCHED_MAX_ENTRIES && s_sched[handle].used;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  清空调度表
+ */
+void CAN_Sched_Reset(void) {
+  memset(s_sched, 0, sizeof(s_sched));
+  s_start = 0;
+}
+
+/**
+ * @brief  添加一条周期报文
+ * @retval >=0: 句柄，CAN_SCHED_FULL/CAN_SCHED_PARAM_ERROR: 失败
+ */
+int CAN_Sched_Add(uint32_t id, uint8_t ide, const uint8_t *data, uint8_t len,
+                  uint32_t period_ms, uint32_t first_ms) {
+  int i;
+
+  if (period_ms == 0 || len > 8) {
+    return CAN_SCHED_PARAM_ERROR;
+  }
+
+  for (i = 0; i < CAN_SCHED_MAX_ENTRIES; i++) {
+    if (!s_sched[i].used) {
+      memset(&s_sched[i], 0, sizeof(s_sched[i]));
+      s_sched[i].id = id;
+      s_sched[i].ide = ide;
+      s_sched[i].len = len;
+      s_sched[i].period_ms = period_ms;
+      s_sched[i].next_due = first_ms;
+      if (data != NULL) {
+        memcpy(s_sched[i].data, data, len);
+      }
+      s_sched[i].used = 1;
+      return i;
+    }
+  }
+
+  return CAN_SCHED_FULL;
+}
+
+/**
+ * @brief  更新周期报文的数据
+ * @retval CAN_SCHED_OK/CAN_SCHED_PARAM_ERROR
+ */
+int CAN_Sched_Update(int handle, const uint8_t *data, uint8_t len) {
+  if (!CAN_Sched_IsValid(handle) || data == NULL || len > 8) {
+    return CAN_SCHED_PARAM_ERROR;
+  }
+
+  memcpy(s_sched[handle].data, data, len);
+  s_sched[handle].len = len;
+  return CAN_SCHED_OK;
+}
+
+/**
+ * @brief  删除周期报文
+ * @retval CAN_SCHED_OK/CAN_SCHED_PARAM_ERROR
+ */
+int CAN_Sched_Remove(int handle) {
+  if (!CAN_Sched_IsValid(handle)) {
+    return CAN_SCHED_PARAM_ERROR;
+  }
+
+  s_sched[handle].used = 0;
+  return CAN_SCHED_OK;
+}
+
+/**
+ * @brief  调度轮询：发送所有已到期的报文
+ * @param  now_ms: 当前时刻
+ * @retval 本次提交到邮箱的报文数
+ * @note   邮箱满时下一轮从没能发出的表项开始，总线繁忙时各表项轮流
+ *         获得邮箱，编号小的表项不会一直抢在前面
+ */
+uint8_t CAN_Sched_Poll(uint32_t now_ms) {
+  uint8_t sent = 0;
+  int start = s_start;
+  int n;
+
+  for (n = 0; n < CAN_SCHED_MAX_ENTRIES; n++) {
+    int i = (start + n) % CAN_SCHED_MAX_ENTRIES;
+    CAN_SchedEntry_t *e = &s_sched[i];
+    uint32_t late;
+
+    /* 用有符号差值比较，HAL_GetTick 回绕后依然正确 */
+    if (!e->used || (int32_t)(now_ms - e->next_due) < 0) {
+      continue;
+    }
+
+    if (CAN_Transmit(e->id, e->ide, 0, e->data, e->len) < 0) {
+      /* 邮箱已满：保留截止时间，后面的表项本轮也无法发送，
+       * 下一轮先发这一项 */
+      e->stats.retried++;
+      s_start = i;
+      break;
+    }
+
+    e->stats.sent++;
+    sent++;
+
+    /* 截止时间按周期累加，发送间隔不受轮询时刻影响 */
+    e->next_due += e->period_ms;
+
+    /* 轮询太慢错过了整周期：跳到下一个未来的相位点 */
+    late = now_ms - e->next_due;
+    if ((int32_t)late >= 0) {
+      uint32_t missed = late / e->period_ms + 1;
+      e->stats.skipped += missed;
+      e->next_due += missed * e->period_ms;
+    }
+  }
+
+  return sent;
+}
+
+/**
+ * @brief  获取周期报文统计信息
+ * @retval CAN_SCHED_OK/CAN_SCHED_PARAM_ERROR
+ */
+int CAN_Sched_GetStats(int handle, CAN_SchedStats_t *stats) {
+  if (!CAN_Sched_IsValid(handle) || stats == NULL) {
+    return CAN_SCHED_PARAM_ERROR;
+  }
+
+  *stats = s_sched[handle].stats;
+  return CAN_SCHED_OK;
+}
+
+/************************ END OF FILE *****************************************/
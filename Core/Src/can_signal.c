@@ -0,0 +1,221 @@
+/**
+ * @file    can_signal.c
+ * @brief   CAN 信号打包 / PDO 映射层实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "can_signal.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  按绑定类型读取应用变量
+ * @note   返回 64 位，U32 的 0x80000000 以上的值不会变成负数
+ */
+static int64_t CAN_Pdo_ReadVar(const CAN_PdoMap_t *m) {
+  switch (m->type) {
+  case CAN_VAR_U8:
+    return *(const uint8_t *)m->var;
+  case CAN_VAR_U16:
+    return *(const uint16_t *)m->var;
+  case CAN_VAR_U32:
+    return *(const uint32_t *)m->var;
+  case CAN_VAR_I8:
+    return *(const int8_t *)m->var;
+  case CAN_VAR_I16:
+    return *(const int16_t *)m->var;
+  case CAN_VAR_I32:
+  default:
+    return *(const int32_t *)m->var;
+  }
+}
+
+/**
+ * @brief  按绑定类型写入应用变量（截断到变量宽度）
+ */
+static void CAN_Pdo_WriteVar(const CAN_PdoMap_t *m, int64_t value) {
+  switch (m->type) {
+  case CAN_VAR_U8:
+  case CAN_VAR_I8:
+    *(uint8_t *)m->var = (uint8_t)value;
+    break;
+  case CAN_VAR_U16:
+  case CAN_VAR_I16:
+    *(uint16_t *)m->var = (uint16_t)value;
+    break;
+  case CAN_VAR_U32:
+  case CAN_VAR_I32:
+  default:
+    *(uint32_t *)m->var = (uint32_t)value;
+    break;
+  }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  通用逐位打包
+ * @note   Motorola 信号从 MSB 开始按锯齿顺序遍历：
+ *         字节内从高位到低位，跨字节时跳到下一字节的 bit7
+ */
+void CAN_Signal_PackGeneric(uint8_t *data, const CAN_SignalDesc_t *desc,
+                            uint32_t raw) {
+  int pos = desc->start;
+  int i;
+
+  if (desc->order == CAN_SIG_LITTLE_ENDIAN) {
+    for (i = 0; i < desc->len; i++, pos++) {
+      if (raw & (1UL << i)) {
+        data[pos / 8] |= (uint8_t)(1U << (pos % 8));
+      } else {
+        data[pos / 8] &= (uint8_t)~(1U << (pos % 8));
+      }
+    }
+  } else {
+    for (i = desc->len - 1; i >= 0; i--) {
+      if (raw & (1UL << i)) {
+        data[pos / 8] |= (uint8_t)(1U << (pos % 8));
+      } else {
+        data[pos / 8] &= (uint8_t)~(1U << (pos % 8));
+      }
+      pos = (pos % 8 == 0) ? pos + 15 : pos - 1;
+    }
+  }
+}
+
+/**
+ * @brief  通用逐位解包
+ */
+uint32_t CAN_Signal_UnpackGeneric(const uint8_t *data,
+                                  const CAN_SignalDesc_t *desc) {
+  uint32_t raw = 0;
+  int pos = desc->start;
+  int i;
+
+  if (desc->order == CAN_SIG_LITTLE_ENDIAN) {
+    for (i = 0; i < desc->len; i++, pos++) {
+      if (data[pos / 8] & (1U << (pos % 8))) {
+        raw |= 1UL << i;
+      }
+    }
+  } else {
+    for (i = desc->len - 1; i >= 0; i--) {
+      if (data[pos / 8] & (1U << (pos % 8))) {
+        raw |= 1UL << i;
+      }
+      pos = (pos % 8 == 0) ? pos + 15 : pos - 1;
+    }
+  }
+
+  /* 符号扩展 */
+  if (desc->sign && desc->len < 32 && (raw >> (desc->len - 1)) != 0) {
+    raw |= ~(uint32_t)CAN_SIG_MASK(desc->len);
+  }
+
+  return raw;
+}
+
+/**
+ * @brief  按映射表把应用变量打包为负载
+ * @note   换算用 64 位进行：U32 变量减去负偏移或除以比例时不会溢出或变号
+ */
+uint64_t CAN_Pdo_Pack(const CAN_Pdo_t *pdo) {
+  uint64_t payload = 0;
+  uint8_t i;
+
+  for (i = 0; i < pdo->map_count; i++) {
+    const CAN_PdoMap_t *m = &pdo->map[i];
+    int64_t phys = CAN_Pdo_ReadVar(m);
+    int64_t raw = phys - m->offset;
+
+    if (m->factor != 0 && m->factor != 1) {
+      raw /= m->factor;
+    }
+    m->pack(&payload, (uint32_t)raw);
+  }
+
+  return payload;
+}
+
+/**
+ * @brief  按映射表把负载解包到应用变量
+ * @note   U32 变量按无符号解释原始值，其余类型按有符号解释
+ *         （有符号信号的 unpack 已做符号扩展）
+ */
+void CAN_Pdo_Unpack(const CAN_Pdo_t *pdo, uint64_t payload) {
+  uint8_t i;
+
+  for (i = 0; i < pdo->map_count; i++) {
+    const CAN_PdoMap_t *m = &pdo->map[i];
+    uint32_t bits = m->unpack(payload);
+    int64_t raw = (m->type == CAN_VAR_U32) ? (int64_t)bits
+                                           : (int64_t)(int32_t)bits;
+    int64_t factor = (m->factor == 0) ? 1 : m->factor;
+
+    CAN_Pdo_WriteVar(m, raw * factor + m->offset);
+  }
+}
+
+/**
+ * @brief  发送处理：打包所有 TPDO，按变化/周期条件发送
+ */
+uint8_t CAN_Pdo_TxProcess(CAN_Pdo_t *pdos, uint8_t count, uint32_t now_ms) {
+  uint8_t sent = 0;
+  uint8_t i;
+
+  for (i = 0; i < count; i++) {
+    CAN_Pdo_t *pdo = &pdos[i];
+    uint64_t payload = CAN_Pdo_Pack(pdo);
+    uint8_t changed = !pdo->valid || payload != pdo->last;
+    uint8_t due = (pdo->mode & CAN_PDO_PERIODIC) &&
+                  (!pdo->valid || (int32_t)(now_ms - pdo->next_due) >= 0);
+    CAN_Frame_t frame;
+
+    if (!((changed && (pdo->mode & CAN_PDO_ON_CHANGE)) || due)) {
+      continue;
+    }
+
+    frame.id = pdo->id;
+    frame.flags = pdo->ide ? CAN_FRAME_FLAG_IDE : 0;
+    frame.dlc = pdo->dlc;
+    frame.time = 0;
+    CAN_Frame_SetPayload(&frame, payload);
+
+    if (CAN_TransmitBurst(&frame, 1) == 0) {
+      /* 邮箱已满，保持状态不变，下次重试 */
+      break;
+    }
+
+    /* 变化触发的发送同样重置周期计时（与 CANopen 事件定时器一致） */
+    pdo->last = payload;
+    pdo->valid = 1;
+    pdo->next_due = now_ms + pdo->period_ms;
+    sent++;
+  }
+
+  return sent;
+}
+
+/**
+ * @brief  接收分发：把收到的帧解包到匹配 RPDO 的绑定变量
+ */
+int CAN_Pdo_RxDispatch(CAN_Pdo_t *pdos, uint8_t count,
+                       const CAN_Frame_t *frame) {
+  uint8_t ide = (frame->flags & CAN_FRAME_FLAG_IDE) ? 1 : 0;
+  uint8_t i;
+
+  for (i = 0; i < count; i++) {
+    if (pdos[i].id == frame->id && pdos[i].ide == ide) {
+      uint64_t payload = CAN_Frame_GetPayload(frame);
+      CAN_Pdo_Unpack(&pdos[i], payload);
+      pdos[i].last = payload;
+      pdos[i].valid = 1;
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,204 @@
+/**
+ * @file    crc.c
+ * @brief   查表法软件 CRC（CRC-8 / CRC-16 / CRC-32，含 slice-by-4/8）实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "crc.h"
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** w 位寄存器的掩码 */
+#define CRC_MASK(w) (0xFFFFFFFFU >> (32U - (w)))
+
+/**
+ * 反转算法移入一位：右移，移出 1 时异或反转后的多项式 p
+ * 正常算法移入一位：左移，移出 1 时异或多项式 p，截断到 w 位
+ */
+#define CRC_R1(p, c) (((c) >> 1) ^ ((p) & (0U - ((c) & 1U))))
+#define CRC_R2(p, c) CRC_R1(p, CRC_R1(p, c))
+#define CRC_R4(p, c) CRC_R2(p, CRC_R2(p, c))
+#define CRC_R8(p, c) CRC_R4(p, CRC_R4(p, c))
+
+#define CRC_N1(w, p, c) ((((c) << 1) ^ ((p) & (0U - (((c) >> ((w) - 1U)) & 1U)))) & CRC_MASK(w))
+#define CRC_N2(w, p, c) CRC_N1(w, p, CRC_N1(w, p, c))
+#define CRC_N4(w, p, c) CRC_N2(w, p, CRC_N2(w, p, c))
+#define CRC_N8(w, p, c) CRC_N4(w, p, CRC_N4(w, p, c))
+
+/** 对 0..255 依次展开 f(i)，生成整张字节表 */
+#define CRC_T4(f, i) f(i), f((i) + 1U), f((i) + 2U), f((i) + 3U)
+#define CRC_T16(f, i) CRC_T4(f, i), CRC_T4(f, (i) + 4U), CRC_T4(f, (i) + 8U), CRC_T4(f, (i) + 12U)
+#define CRC_T64(f, i) CRC_T16(f, i), CRC_T16(f, (i) + 16U), CRC_T16(f, (i) + 32U), CRC_T16(f, (i) + 48U)
+#define CRC_T256(f) CRC_T64(f, 0U), CRC_T64(f, 64U), CRC_T64(f, 128U), CRC_T64(f, 192U)
+
+/** 各算法的表项：字节 i 移入全零寄存器后的值 */
+#define CRC_J1850_E(i) (uint8_t)CRC_N8(8U, 0x1DU, (uint32_t)(i))
+#define CRC_MODBUS_E(i) (uint16_t)CRC_R8(0xA001U, (uint32_t)(i))
+#define CRC_CCITT_E(i) (uint16_t)CRC_N8(16U, 0x1021U, (uint32_t)(i) << 8)
+#define CRC_32_E(i) CRC_R8(0xEDB88320U, (uint32_t)(i))
+#define CRC_MPEG2_E(i) CRC_N8(32U, 0x04C11DB7U, (uint32_t)(i) << 24)
+
+/**
+ * slice 表 Tk[i] 是字节 i 后面再跟 k 个零字节的结果，对 i 线性：
+ * Tk[i] = 异或 i 中每个置位 b 对应的 Tk[1 << b]。逐位展开 8k 次在预处理
+ * 阶段不可行，因此每张表只写出 8 个基（测试中按 Tk = (Tk-1 >> 8) ^
+ * T0[Tk-1 & 0xFF] 逐项核对），其余表项同样由宏展开
+ */
+#define CRC_LIN(i, b0, b1, b2, b3, b4, b5, b6, b7)                            \
+    (((b0) & (0U - ((uint32_t)(i) & 1U))) ^                                  \
+     ((b1) & (0U - (((uint32_t)(i) >> 1) & 1U))) ^                           \
+     ((b2) & (0U - (((uint32_t)(i) >> 2) & 1U))) ^                           \
+     ((b3) & (0U - (((uint32_t)(i) >> 3) & 1U))) ^                           \
+     ((b4) & (0U - (((uint32_t)(i) >> 4) & 1U))) ^                           \
+     ((b5) & (0U - (((uint32_t)(i) >> 5) & 1U))) ^                           \
+     ((b6) & (0U - (((uint32_t)(i) >> 6) & 1U))) ^                           \
+     ((b7) & (0U - (((uint32_t)(i) >> 7) & 1U))))
+
+#define CRC_32_S1(i) CRC_LIN(i, 0x191B3141U, 0x32366282U, 0x646CC504U, 0xC8D98A08U, \
+                             0x4AC21251U, 0x958424A2U, 0xF0794F05U, 0x3B83984BU)
+#define CRC_32_S2(i) CRC_LIN(i, 0x01C26A37U, 0x0384D46EU, 0x0709A8DCU, 0x0E1351B8U, \
+                             0x1C26A370U, 0x384D46E0U, 0x709A8DC0U, 0xE1351B80U)
+#define CRC_32_S3(i) CRC_LIN(i, 0xB8BC6765U, 0xAA09C88BU, 0x8F629757U, 0xC5B428EFU, \
+                             0x5019579FU, 0xA032AF3EU, 0x9B14583DU, 0xED59B63BU)
+#define CRC_32_S4(i) CRC_LIN(i, 0x3D6029B0U, 0x7AC05360U, 0xF580A6C0U, 0x30704BC1U, \
+                             0x60E09782U, 0xC1C12F04U, 0x58F35849U, 0xB1E6B092U)
+#define CRC_32_S5(i) CRC_LIN(i, 0xCB5CD3A5U, 0x4DC8A10BU, 0x9B914216U, 0xEC53826DU, \
+                             0x03D6029BU, 0x07AC0536U, 0x0F580A6CU, 0x1EB014D8U)
+#define CRC_32_S6(i) CRC_LIN(i, 0xA6770BB4U, 0x979F1129U, 0xF44F2413U, 0x33EF4E67U, \
+                             0x67DE9CCEU, 0xCFBD399CU, 0x440B7579U, 0x8816EAF2U)
+#define CRC_32_S7(i) CRC_LIN(i, 0xCCAA009EU, 0x4225077DU, 0x844A0EFAU, 0xD3E51BB5U, \
+                             0x7CBB312BU, 0xF9766256U, 0x299DC2EDU, 0x533B85DAU)
+
+/* Private variables ---------------------------------------------------------*/
+
+static const uint8_t s_j1850_table[256] = {CRC_T256(CRC_J1850_E)};
+static const uint16_t s_modbus_table[256] = {CRC_T256(CRC_MODBUS_E)};
+static const uint16_t s_ccitt_table[256] = {CRC_T256(CRC_CCITT_E)};
+static const uint32_t s_mpeg2_table[256] = {CRC_T256(CRC_MPEG2_E)};
+static const uint32_t s_crc32_table[8][256] = {
+    {CRC_T256(CRC_32_E)},  {CRC_T256(CRC_32_S1)}, {CRC_T256(CRC_32_S2)},
+    {CRC_T256(CRC_32_S3)}, {CRC_T256(CRC_32_S4)}, {CRC_T256(CRC_32_S5)},
+    {CRC_T256(CRC_32_S6)}, {CRC_T256(CRC_32_S7)},
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+const crc_algo_t crc_8_j1850 = {
+    "CRC-8/SAE-J1850", 8, 0, 0x1DU, 0xFFU, 0xFFU, 0x4BU, s_j1850_table, NULL,
+};
+const crc_algo_t crc_16_modbus = {
+    "CRC-16/MODBUS", 16, 1, 0x8005U, 0xFFFFU, 0x0000U, 0x4B37U, s_modbus_table, NULL,
+};
+const crc_algo_t crc_16_ccitt = {
+    "CRC-16/CCITT-FALSE", 16, 0, 0x1021U, 0xFFFFU, 0x0000U, 0x29B1U, s_ccitt_table, NULL,
+};
+const crc_algo_t crc_32 = {
+    "CRC-32", 32, 1, 0x04C11DB7U, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xCBF43926U,
+    s_crc32_table[0], s_crc32_table,
+};
+const crc_algo_t crc_32_mpeg2 = {
+    "CRC-32/MPEG-2", 32, 0, 0x04C11DB7U, 0xFFFFFFFFU, 0x00000000U, 0x0376E6E7U,
+    s_mpeg2_table, NULL,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  按小端读 32 位（可以不对齐）
+ */
+static inline uint32_t crc_load32(const uint8_t *p) {
+    uint32_t v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+uint32_t crc_update_bytewise(const crc_algo_t *algo, uint32_t crc, const void *data,
+                             size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    if (algo->width == 8) {
+        const uint8_t *t = (const uint8_t *)algo->table;
+        /* 8 位寄存器反转与否查表方式相同 */
+        while (len--) {
+            crc = t[(crc ^ *p++) & 0xFFU];
+        }
+    } else if (algo->width == 16) {
+        const uint16_t *t = (const uint16_t *)algo->table;
+        if (algo->reflected) {
+            while (len--) {
+                crc = (crc >> 8) ^ t[(crc ^ *p++) & 0xFFU];
+            }
+        } else {
+            while (len--) {
+                crc = ((crc << 8) ^ t[((crc >> 8) ^ *p++) & 0xFFU]) & 0xFFFFU;
+            }
+        }
+    } else {
+        const uint32_t *t = (const uint32_t *)algo->table;
+        if (algo->reflected) {
+            while (len--) {
+                crc = (crc >> 8) ^ t[(crc ^ *p++) & 0xFFU];
+            }
+        } else {
+            while (len--) {
+                crc = (crc << 8) ^ t[(crc >> 24) ^ *p++];
+            }
+        }
+    }
+    return crc;
+}
+
+uint32_t crc_update_slice4(const crc_algo_t *algo, uint32_t crc, const void *data,
+                           size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    const uint32_t (*t)[256] = algo->slice;
+
+    if (t == NULL) {
+        return crc_update_bytewise(algo, crc, data, len);
+    }
+
+    for (; len >= 4; len -= 4, p += 4) {
+        uint32_t a = crc_load32(p) ^ crc;
+        crc = t[3][a & 0xFFU] ^ t[2][(a >> 8) & 0xFFU] ^
+              t[1][(a >> 16) & 0xFFU] ^ t[0][a >> 24];
+    }
+    return crc_update_bytewise(algo, crc, p, len);
+}
+
+uint32_t crc_update_slice8(const crc_algo_t *algo, uint32_t crc, const void *data,
+                           size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    const uint32_t (*t)[256] = algo->slice;
+
+    if (t == NULL) {
+        return crc_update_bytewise(algo, crc, data, len);
+    }
+
+    for (; len >= 8; len -= 8, p += 8) {
+        uint32_t a = crc_load32(p) ^ crc;
+        uint32_t b = crc_load32(p + 4);
+        crc = t[7][a & 0xFFU] ^ t[6][(a >> 8) & 0xFFU] ^
+              t[5][(a >> 16) & 0xFFU] ^ t[4][a >> 24] ^
+              t[3][b & 0xFFU] ^ t[2][(b >> 8) & 0xFFU] ^
+              t[1][(b >> 16) & 0xFFU] ^ t[0][b >> 24];
+    }
+    return crc_update_bytewise(algo, crc, p, len);
+}
+
+uint32_t crc_update(const crc_algo_t *algo, uint32_t crc, const void *data, size_t len) {
+    if (algo->slice != NULL && len >= CRC_SLICE_MIN_BYTES) {
+        return crc_update_slice8(algo, crc, data, len);
+    }
+    return crc_update_bytewise(algo, crc, data, len);
+}
+
+uint32_t crc_calc(const crc_algo_t *algo, const void *data, size_t len) {
+    return crc_final(algo, crc_update(algo, crc_init(algo), data, len));
+}
+
+/************************ END OF FILE *****************************************/
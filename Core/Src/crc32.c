@@ -0,0 +1,291 @@
+/**
+ * @file    crc32.c
+ * @brief   CRC 计算单元驱动（CPU / MEM2MEM DMA 送数）与软件实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "crc32.h"
+#include "crc.h"
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** CNDTR 上限（字） */
+#define CRC32_MAX_WORDS 0xFFFFU
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t s_ready = 0;
+static volatile uint8_t s_busy = 0;
+static volatile int s_status = CRC32_OK; /* 最近一次 DMA 送数的结果 */
+static uint32_t s_src;            /* 下一段的源地址 */
+static uint32_t s_words;          /* 剩余的整字数（含正在传输的段） */
+static uint32_t s_seg_words;      /* 正在传输的段长度 */
+static uint32_t s_tail;           /* 补零后的尾字 */
+static uint8_t s_has_tail;
+static crc32_callback_t s_cb;
+static void *s_ctx;
+
+/* Private function prototypes -----------------------------------------------*/
+static void crc32_start_segment(void);
+static void crc32_on_event(DMA_ChannelId_t ch, uint32_t events, void *ctx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  读出末尾 1~3 个字节，按小端拼成高位补零的字
+ */
+static uint32_t crc32_tail_word(const uint8_t *p, size_t n) {
+    uint32_t word = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        word |= (uint32_t)p[i] << (8U * i);
+    }
+    return word;
+}
+
+/**
+ * @brief  软件计算一个字：按 CRC-32/MPEG-2 从最高字节开始逐字节查表
+ */
+static uint32_t crc32_sw_word(uint32_t crc, uint32_t word) {
+    const uint8_t bytes[4] = {
+        (uint8_t)(word >> 24), (uint8_t)(word >> 16), (uint8_t)(word >> 8), (uint8_t)word,
+    };
+
+    return crc_update_bytewise(&crc_32_mpeg2, crc, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief  启动下一段 DMA 传输
+ */
+static void crc32_start_segment(void) {
+    DMA_Config_t cfg;
+
+    s_seg_words = (s_words > CRC32_MAX_WORDS) ? CRC32_MAX_WORDS : s_words;
+
+    /* MEM2MEM 且 DIR=0 时 CPAR 为源，CMAR 为目的 */
+    cfg.PeriphBaseAddr = s_src;
+    cfg.PeriphInc = DMA_Inc_Enable;
+    cfg.MemBaseAddr = (uint32_t)&CRC->DR;
+    cfg.MemInc = DMA_Inc_Disable;
+    cfg.PeriphDataSize = DMA_DataSize_Word;
+    cfg.MemDataSize = DMA_DataSize_Word;
+    cfg.Direction = DMA_DIR_PeripheralSRC;
+    cfg.BufferSize = (uint16_t)s_seg_words;
+    cfg.Mode = DMA_Mode_Normal;
+    cfg.Priority = DMA_Priority_Low;
+    cfg.M2M = true;
+
+    DMA_StartTransfer(CRC32_DMA_CHANNEL, &cfg);
+}
+
+/**
+ * @brief  结束本次送数并回调
+ */
+static void crc32_finish(int status) {
+    crc32_callback_t cb = s_cb;
+    void *ctx = s_ctx;
+
+    if (status == CRC32_OK && s_has_tail) {
+        CRC->DR = s_tail;
+    }
+    s_status = status;
+    s_busy = 0;
+
+    if (cb != NULL) {
+        cb(status, CRC->DR, ctx);
+    }
+}
+
+/**
+ * @brief  DMA 事件回调（中断上下文）
+ */
+static void crc32_on_event(DMA_ChannelId_t ch, uint32_t events, void *ctx) {
+    (void)ch;
+    (void)ctx;
+
+    if (!s_busy) {
+        return;
+    }
+
+    if (events & DMA_EVT_TE) {
+        crc32_finish(CRC32_ERROR);
+        return;
+    }
+
+    if (events & DMA_EVT_TC) {
+        s_src += s_seg_words * 4U;
+        s_words -= s_seg_words;
+        if (s_words > 0) {
+            crc32_start_segment();
+        } else {
+            crc32_finish(CRC32_OK);
+        }
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  打开时钟，占用 DMA 通道
+ */
+int crc32_init(void) {
+    __HAL_RCC_CRC_CLK_ENABLE();
+
+    if (DMA_Claim(CRC32_DMA_CHANNEL, "crc32") != DMA_MGR_OK) {
+        return CRC32_PARAM_ERROR;
+    }
+    DMA_SetCallback(CRC32_DMA_CHANNEL, crc32_on_event, NULL,
+                    DMA_EVT_TC | DMA_EVT_TE);
+
+    s_busy = 0;
+    s_ready = 1;
+    return CRC32_OK;
+}
+
+/**
+ * @brief  释放 DMA 通道
+ */
+void crc32_deinit(void) {
+    DMA_Release(CRC32_DMA_CHANNEL);
+    s_busy = 0;
+    s_ready = 0;
+}
+
+/**
+ * @brief  复位 CRC 单元
+ */
+void crc32_reset(void) {
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->CR = CRC_CR_RESET;
+}
+
+/**
+ * @brief  CPU 送数
+ */
+uint32_t crc32_feed(const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t word;
+
+    if (((uintptr_t)p & 3U) == 0) {
+        const uint32_t *w = (const uint32_t *)p;
+        for (size_t n = len >> 2; n > 0; n--) {
+            CRC->DR = *w++;
+        }
+        p = (const uint8_t *)w;
+    } else {
+        for (size_t n = len >> 2; n > 0; n--) {
+            memcpy(&word, p, 4);
+            CRC->DR = word;
+            p += 4;
+        }
+    }
+
+    if ((len & 3U) != 0) {
+        CRC->DR = crc32_tail_word(p, len & 3U);
+    }
+    return CRC->DR;
+}
+
+/**
+ * @brief  启动 DMA 送数
+ */
+int crc32_feed_dma(const void *data, size_t len, crc32_callback_t cb, void *ctx) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t primask;
+
+    if (!s_ready || p == NULL || ((uintptr_t)p & 3U) != 0) {
+        return CRC32_PARAM_ERROR;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (s_busy) {
+        if (primask == 0) {
+            __enable_irq();
+        }
+        return CRC32_BUSY;
+    }
+
+    s_src = (uint32_t)p;
+    s_words = (uint32_t)(len >> 2);
+    s_has_tail = (len & 3U) != 0;
+    s_tail = s_has_tail ? crc32_tail_word(p + (len & ~(size_t)3U), len & 3U) : 0U;
+    s_cb = cb;
+    s_ctx = ctx;
+    s_busy = 1;
+
+    if (s_words > 0) {
+        crc32_start_segment();
+    } else {
+        crc32_finish(CRC32_OK);
+    }
+
+    if (primask == 0) {
+        __enable_irq();
+    }
+    return CRC32_OK;
+}
+
+/**
+ * @brief  DMA 送数是否还在进行
+ */
+uint8_t crc32_busy(void) {
+    return s_busy;
+}
+
+/**
+ * @brief  读取当前 CRC 值
+ */
+uint32_t crc32_value(void) {
+    return CRC->DR;
+}
+
+/**
+ * @brief  阻塞计算一块数据的 CRC
+ */
+int crc32_compute(const void *data, size_t len, uint32_t *crc) {
+    int status = CRC32_OK;
+
+    if (s_busy) {
+        return CRC32_BUSY;
+    }
+
+    crc32_reset();
+    if (s_ready && ((uintptr_t)data & 3U) == 0 && len >= CRC32_DMA_MIN_BYTES) {
+        if (crc32_feed_dma(data, len, NULL, NULL) != CRC32_OK) {
+            return CRC32_BUSY;
+        }
+        while (s_busy) {
+        }
+        status = s_status;
+    } else {
+        (void)crc32_feed(data, len);
+    }
+
+    *crc = CRC->DR;
+    return status;
+}
+
+/**
+ * @brief  软件计算
+ */
+uint32_t crc32_sw(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t word;
+
+    for (size_t n = len >> 2; n > 0; n--) {
+        memcpy(&word, p, 4);
+        crc = crc32_sw_word(crc, word);
+        p += 4;
+    }
+
+    if ((len & 3U) != 0) {
+        crc = crc32_sw_word(crc, crc32_tail_word(p, len & 3U));
+    }
+    return crc;
+}
+
+/************************ END OF FILE *****************************************/
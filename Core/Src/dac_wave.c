@@ -0,0 +1,525 @@
+/**
+ * @file    dac_wave.c
+ * @brief   DAC 波形发生器（TIM7 触发、DMA 循环回放、无缝换表）实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dac_wave.h"
+#include "dma_manager.h"
+#include "main.h"
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** TSEL = 010：TIM7_TRGO */
+#define DAC_WAVE_TSEL_TIM7 (2UL << DAC_CR_TSEL1_Pos)
+
+/** 通道 2 的 CR 字段在高 16 位 */
+#define DAC_WAVE_CR(ch, bits) ((uint32_t)(bits) << (16U * (uint32_t)(ch)))
+
+/** 相位累加器高 8 位查正弦表，其后 16 位做线性插值 */
+#define DAC_WAVE_SINE_BITS 8U
+
+/** 换表状态（s_pending） */
+#define DAC_WAVE_SWAP_NONE 0U    /* 没有换表 */
+#define DAC_WAVE_SWAP_HEAD 1U    /* 同长度：等 HT 改写前半张 */
+#define DAC_WAVE_SWAP_TAIL 2U    /* 同长度：等 TC 改写后半张 */
+#define DAC_WAVE_SWAP_RESTART 3U /* 长度不同：等 TC 重装 DMA */
+
+/** 回放期间常开的 DMA 事件：只有传输错误 */
+#define DAC_WAVE_EVT_IDLE DMA_EVT_TE
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  通道静态配置
+ */
+typedef struct {
+    uint16_t pin;            /* GPIOA 引脚 */
+    uint8_t crl_shift;       /* 引脚在 GPIOA->CRL 中的位置 */
+    volatile uint32_t *dhr;  /* DHR12Rx */
+    DMA_ChannelId_t dma;     /* DACx 请求所在的 DMA 通道 */
+} dac_wave_def_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static const dac_wave_def_t s_defs[DAC_WAVE_COUNT] = {
+    {GPIO_PIN_4, 16U, &DAC->DHR12R1, DMA_CH_DMA2_3},
+    {GPIO_PIN_5, 20U, &DAC->DHR12R2, DMA_CH_DMA2_4},
+};
+
+/** 一个周期的正弦，Q15，多一项便于插值 */
+static const int16_t s_sine[(1U << DAC_WAVE_SINE_BITS) + 1U] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+    6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285,
+    32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+    30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683,
+    27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+    23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868,
+    18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179,
+    6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+    0, -804, -1608, -2410, -3212, -4011, -4808, -5602,
+    -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+    -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+    -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+    -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+    -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+    -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+    -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179,
+    -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+    0,
+};
+
+/** 两块表缓冲区，s_active 指向正在回放的一块，新表先写入另一块 */
+static uint16_t s_buf[DAC_WAVE_COUNT][2][DAC_WAVE_MAX_LEN];
+static uint8_t s_active[DAC_WAVE_COUNT];
+static uint16_t s_len[DAC_WAVE_COUNT]; /* 正在回放的表长度 */
+static volatile uint8_t s_playing[DAC_WAVE_COUNT];
+static volatile uint8_t s_pending[DAC_WAVE_COUNT];
+static uint16_t s_pending_len[DAC_WAVE_COUNT];
+static volatile uint32_t s_errors[DAC_WAVE_COUNT];
+static uint8_t s_pin_claimed[DAC_WAVE_COUNT];
+static uint32_t s_pin_saved[DAC_WAVE_COUNT]; /* 占用前该引脚的 CRL 配置 */
+
+static uint32_t s_ticks; /* 每个采样的 TIM7 计数时钟数 */
+static uint8_t s_ready;
+
+/* Private function prototypes -----------------------------------------------*/
+static void dac_wave_on_event(DMA_ChannelId_t dma, uint32_t events, void *ctx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  通道号是否有效
+ */
+static inline uint8_t dac_wave_valid(dac_wave_channel_t ch) {
+    return s_ready && (uint32_t)ch < DAC_WAVE_COUNT;
+}
+
+/**
+ * @brief  第一次回放时才把引脚切换为模拟模式，并记下原来的配置
+ * @note   PA5 同时是 SPI1_SCK，只用通道 1 时不能动它
+ */
+static void dac_wave_claim_pin(dac_wave_channel_t ch) {
+    const dac_wave_def_t *def = &s_defs[ch];
+    GPIO_InitTypeDef gpio = {0};
+
+    if (s_pin_claimed[ch]) {
+        return;
+    }
+    s_pin_saved[ch] = GPIOA->CRL & (0xFUL << def->crl_shift);
+    /* 模拟输入模式断开数字输入，避免额外电流 */
+    gpio.Pin = def->pin;
+    gpio.Mode = GPIO_MODE_ANALOG;
+    HAL_GPIO_Init(GPIOA, &gpio);
+    s_pin_claimed[ch] = 1;
+}
+
+/**
+ * @brief  从缓冲区 buf 开始循环回放
+ * @note   先把表尾装入 DHR：第一次触发输出表尾，同时 DMA 送来表头，
+ *         与换表时"旧表尾接新表头"的时序一致
+ */
+static void dac_wave_start(dac_wave_channel_t ch, uint16_t len) {
+    const dac_wave_def_t *def = &s_defs[ch];
+    const uint16_t *buf = s_buf[ch][s_active[ch]];
+    DMA_Config_t dma;
+
+    dac_wave_claim_pin(ch);
+    *def->dhr = buf[len - 1U];
+
+    dma.PeriphBaseAddr = (uint32_t)def->dhr;
+    dma.PeriphInc = DMA_Inc_Disable;
+    dma.MemBaseAddr = (uint32_t)buf;
+    dma.MemInc = DMA_Inc_Enable;
+    dma.PeriphDataSize = DMA_DataSize_Word;
+    dma.MemDataSize = DMA_DataSize_HalfWord;
+    dma.Direction = DMA_DIR_PeripheralDST_Mem2Per;
+    dma.BufferSize = len;
+    dma.Mode = DMA_Mode_Circular;
+    dma.Priority = DMA_Priority_High;
+    dma.M2M = false;
+    /* 稳定回放时只开 TE（循环传输不强制 TC） */
+    DMA_StartTransfer(def->dma, &dma);
+
+    s_len[ch] = len;
+    s_pending[ch] = DAC_WAVE_SWAP_NONE;
+    s_playing[ch] = 1;
+    DAC->CR |= DAC_WAVE_CR(ch, DAC_CR_EN1 | DAC_CR_DMAEN1);
+}
+
+/**
+ * @brief  空闲缓冲区已写好 len 个采样：回放中则等待换入，否则直接开始
+ * @note   长度相同时 DMA 不停：HT 之后前半张已经送完，把新表的前半张
+ *         复制进正在回放的缓冲区，TC 之后再复制后半张；长度不同只能在
+ *         TC 重装 DMA
+ */
+static void dac_wave_load(dac_wave_channel_t ch, uint16_t len) {
+    if (s_playing[ch]) {
+        s_pending_len[ch] = len;
+        if (len == s_len[ch] && len >= 2U) {
+            s_pending[ch] = DAC_WAVE_SWAP_HEAD;
+            DMA_SetEvents(s_defs[ch].dma, DAC_WAVE_EVT_IDLE | DMA_EVT_HT | DMA_EVT_TC);
+        } else {
+            s_pending[ch] = DAC_WAVE_SWAP_RESTART;
+            DMA_SetEvents(s_defs[ch].dma, DAC_WAVE_EVT_IDLE | DMA_EVT_TC);
+        }
+    } else {
+        s_active[ch] ^= 1U;
+        dac_wave_start(ch, len);
+    }
+}
+
+/**
+ * @brief  DMA 事件：改写半张表、TC 重装，或传输错误
+ * @note   - 同长度：HT 改写前半张，之后的 TC 改写后半张，DMA 回绕后
+ *           从新表表头开始；复制必须在半张表的时间内完成。在 HT 之后
+ *           才请求的换表先跳过这一次 TC，等下一个 HT；
+ *         - 长度不同：TC 时旧表最后一个采样已送入 DHR，下一次触发先输出
+ *           旧表尾，再请求新表的第一个采样，重装必须在一个采样周期内完成；
+ *         - TE：硬件已关闭通道，停止回放，输出保持最后一个值
+ */
+static void dac_wave_on_event(DMA_ChannelId_t dma, uint32_t events, void *ctx) {
+    dac_wave_channel_t ch = (dac_wave_channel_t)(uintptr_t)ctx;
+    uint16_t *active = s_buf[ch][s_active[ch]];
+    const uint16_t *next = s_buf[ch][s_active[ch] ^ 1U];
+    uint16_t half = s_len[ch] / 2U;
+
+    if (events & DMA_EVT_TE) {
+        s_errors[ch]++;
+        dac_wave_stop(ch);
+        return;
+    }
+
+    switch (s_pending[ch]) {
+    case DAC_WAVE_SWAP_HEAD:
+        if (events & DMA_EVT_HT) {
+            memcpy(active, next, (size_t)half * sizeof(uint16_t));
+            s_pending[ch] = DAC_WAVE_SWAP_TAIL;
+        }
+        break;
+    case DAC_WAVE_SWAP_TAIL:
+        if (events & DMA_EVT_TC) {
+            memcpy(active + half, next + half, (size_t)(s_len[ch] - half) * sizeof(uint16_t));
+            DMA_SetEvents(dma, DAC_WAVE_EVT_IDLE);
+            s_pending[ch] = DAC_WAVE_SWAP_NONE;
+        }
+        break;
+    case DAC_WAVE_SWAP_RESTART:
+        if (events & DMA_EVT_TC) {
+            s_active[ch] ^= 1U;
+            s_len[ch] = s_pending_len[ch];
+            DMA_AbortTransfer(dma);
+            DMA_Restart(dma, (uint32_t)s_defs[ch].dhr, (uint32_t)s_buf[ch][s_active[ch]],
+                        s_len[ch], DMA_CCR_MINC);
+            DMA_SetEvents(dma, DAC_WAVE_EVT_IDLE);
+            s_pending[ch] = DAC_WAVE_SWAP_NONE;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief  相位 phase（一个周期 = 2^32）处的波形值，Q15
+ */
+static int32_t dac_wave_shape(dac_wave_shape_t shape, uint32_t phase) {
+    uint32_t p = phase >> 16;
+
+    switch (shape) {
+    case DAC_WAVE_SHAPE_SINE: {
+        uint32_t i = phase >> (32U - DAC_WAVE_SINE_BITS);
+        int32_t frac = (int32_t)((phase >> (16U - DAC_WAVE_SINE_BITS)) & 0xFFFFU);
+        int32_t a = s_sine[i];
+        int32_t b = s_sine[i + 1U];
+        return a + (int32_t)(((int64_t)(b - a) * frac + 0x8000) >> 16);
+    }
+    case DAC_WAVE_SHAPE_TRIANGLE: {
+        int32_t t = (int32_t)((p < 0x8000U) ? p : 0xFFFFU - p);
+        return 2 * t - 32767;
+    }
+    case DAC_WAVE_SHAPE_SAW:
+        return (int32_t)p - 32768;
+    case DAC_WAVE_SHAPE_SQUARE:
+    default:
+        return (p < 0x8000U) ? 32767 : -32767;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  初始化 DAC、TIM7 和 DMA 通道
+ */
+int dac_wave_init(uint32_t rate_hz) {
+    uint32_t psc;
+
+    if (rate_hz == 0 || rate_hz > DAC_WAVE_MAX_RATE) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+    if (s_ready) {
+        dac_wave_deinit();
+    }
+    if (DMA_Claim(s_defs[DAC_WAVE_CH1].dma, "dac_wave") != DMA_MGR_OK) {
+        return DAC_WAVE_BUSY;
+    }
+    if (DMA_Claim(s_defs[DAC_WAVE_CH2].dma, "dac_wave") != DMA_MGR_OK) {
+        DMA_Release(s_defs[DAC_WAVE_CH1].dma);
+        return DAC_WAVE_BUSY;
+    }
+    for (uint32_t ch = 0; ch < DAC_WAVE_COUNT; ch++) {
+        DMA_SetCallback(s_defs[ch].dma, dac_wave_on_event, (void *)(uintptr_t)ch,
+                        DAC_WAVE_EVT_IDLE);
+        s_pin_claimed[ch] = 0;
+        s_active[ch] = 0;
+        s_playing[ch] = 0;
+        s_pending[ch] = DAC_WAVE_SWAP_NONE;
+        s_errors[ch] = 0;
+    }
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_DAC_CLK_ENABLE();
+    __HAL_RCC_TIM7_CLK_ENABLE();
+
+    /* 两个通道都由 TIM7_TRGO 触发，EN 在开始回放时才置位 */
+    DAC->CR = DAC_WAVE_CR(DAC_WAVE_CH1, DAC_CR_TEN1 | DAC_WAVE_TSEL_TIM7) |
+              DAC_WAVE_CR(DAC_WAVE_CH2, DAC_CR_TEN1 | DAC_WAVE_TSEL_TIM7);
+
+    /* TIM7 更新事件作为 TRGO，周期 = 1 / rate_hz */
+    s_ticks = DAC_WAVE_TIM_CLK / rate_hz;
+    psc = (s_ticks - 1U) / 0x10000U;
+    TIM7->CR1 = 0;
+    TIM7->CR2 = 0;
+    TIM7->PSC = psc;
+    TIM7->ARR = s_ticks / (psc + 1U) - 1U;
+    s_ticks = (psc + 1U) * (TIM7->ARR + 1U);
+    TIM7->CNT = 0;
+    TIM7->EGR = TIM_EGR_UG;
+    TIM7->SR = 0;
+    TIM7->CR2 = TIM_CR2_MMS_1;
+    TIM7->CR1 = TIM_CR1_CEN;
+
+    s_ready = 1;
+    return DAC_WAVE_OK;
+}
+
+/**
+ * @brief  停止两个通道和 TIM7，恢复引脚，释放 DMA 通道
+ */
+void dac_wave_deinit(void) {
+    if (!s_ready) {
+        return;
+    }
+    dac_wave_stop(DAC_WAVE_CH1);
+    dac_wave_stop(DAC_WAVE_CH2);
+    TIM7->CR1 = 0;
+    TIM7->CR2 = 0;
+    DAC->CR = 0;
+    for (uint32_t ch = 0; ch < DAC_WAVE_COUNT; ch++) {
+        /* 引脚交还原来的功能（例如 PA5 的 SPI1_SCK） */
+        if (s_pin_claimed[ch]) {
+            GPIOA->CRL = (GPIOA->CRL & ~(0xFUL << s_defs[ch].crl_shift)) | s_pin_saved[ch];
+            s_pin_claimed[ch] = 0;
+        }
+    }
+    DMA_Release(s_defs[DAC_WAVE_CH1].dma);
+    DMA_Release(s_defs[DAC_WAVE_CH2].dma);
+    s_ready = 0;
+}
+
+/**
+ * @brief  实际采样率（mHz）
+ */
+uint64_t dac_wave_rate_mhz(void) {
+    if (!s_ready) {
+        return 0;
+    }
+    return ((uint64_t)DAC_WAVE_TIM_CLK * 1000U + s_ticks / 2U) / s_ticks;
+}
+
+/**
+ * @brief  立即开始回放
+ */
+int dac_wave_play(dac_wave_channel_t ch, const uint16_t *table, uint16_t len) {
+    if (!dac_wave_valid(ch) || table == NULL || len == 0 || len > DAC_WAVE_MAX_LEN) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+    dac_wave_stop(ch);
+    memcpy(s_buf[ch][s_active[ch] ^ 1U], table, (size_t)len * sizeof(uint16_t));
+    dac_wave_load(ch, len);
+    return DAC_WAVE_OK;
+}
+
+/**
+ * @brief  在表尾无缝换表
+ */
+int dac_wave_swap(dac_wave_channel_t ch, const uint16_t *table, uint16_t len) {
+    if (!dac_wave_valid(ch) || table == NULL || len == 0 || len > DAC_WAVE_MAX_LEN) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+    if (s_pending[ch]) {
+        return DAC_WAVE_BUSY;
+    }
+    memcpy(s_buf[ch][s_active[ch] ^ 1U], table, (size_t)len * sizeof(uint16_t));
+    dac_wave_load(ch, len);
+    return DAC_WAVE_OK;
+}
+
+/**
+ * @brief  是否有换表在等待
+ */
+uint8_t dac_wave_swap_pending(dac_wave_channel_t ch) {
+    return (dac_wave_valid(ch) && s_pending[ch] != DAC_WAVE_SWAP_NONE) ? 1U : 0U;
+}
+
+/**
+ * @brief  传输错误次数
+ */
+uint32_t dac_wave_errors(dac_wave_channel_t ch) {
+    return dac_wave_valid(ch) ? s_errors[ch] : 0U;
+}
+
+/**
+ * @brief  为目标频率生成并回放一张表
+ */
+int dac_wave_tone(dac_wave_channel_t ch, uint32_t freq_hz, dac_wave_shape_t shape,
+                  uint16_t amplitude, uint16_t offset, dac_wave_plan_t *plan) {
+    dac_wave_plan_t p;
+
+    if (!dac_wave_valid(ch) || amplitude > 2048U || offset > DAC_WAVE_FULL_SCALE ||
+        (uint32_t)shape > DAC_WAVE_SHAPE_SQUARE) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+    if (dac_wave_plan(freq_hz, DAC_WAVE_MAX_LEN, &p) != DAC_WAVE_OK) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+    if (s_pending[ch]) {
+        return DAC_WAVE_BUSY;
+    }
+    dac_wave_synth(s_buf[ch][s_active[ch] ^ 1U], p.len, p.cycles, shape, amplitude, offset);
+    dac_wave_load(ch, p.len);
+    if (plan != NULL) {
+        *plan = p;
+    }
+    return DAC_WAVE_OK;
+}
+
+/**
+ * @brief  停止回放，输出保持最后一个值
+ */
+void dac_wave_stop(dac_wave_channel_t ch) {
+    if (!dac_wave_valid(ch) || !s_playing[ch]) {
+        return;
+    }
+    s_playing[ch] = 0;
+    s_pending[ch] = DAC_WAVE_SWAP_NONE;
+    DMA_AbortTransfer(s_defs[ch].dma);
+    DAC->CR &= ~DAC_WAVE_CR(ch, DAC_CR_DMAEN1);
+    /* DMA 已经送入的下一个采样不再输出 */
+    *s_defs[ch].dhr = (ch == DAC_WAVE_CH1) ? DAC->DOR1 : DAC->DOR2;
+}
+
+/**
+ * @brief  是否正在回放
+ */
+uint8_t dac_wave_playing(dac_wave_channel_t ch) {
+    return dac_wave_valid(ch) ? s_playing[ch] : 0U;
+}
+
+/**
+ * @brief  选择表长度和周期数
+ * @note   len 个采样含 cycles 个周期时 f = fs × cycles / len；对每个 len 取
+ *         最接近的 cycles，比较 |cycles × CLK - f × ticks × len| / len
+ */
+int dac_wave_plan(uint32_t freq_hz, uint16_t max_len, dac_wave_plan_t *plan) {
+    uint64_t best_diff = 0;
+    uint32_t best_len = 0, best_cycles = 0;
+
+    if (!s_ready || plan == NULL || max_len < 2U || max_len > DAC_WAVE_MAX_LEN ||
+        freq_hz == 0 || 2ULL * freq_hz * s_ticks > DAC_WAVE_TIM_CLK) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+
+    for (uint32_t len = max_len; len >= 2U; len--) {
+        uint64_t target = (uint64_t)freq_hz * s_ticks * len;
+        uint64_t cycles = (target + DAC_WAVE_TIM_CLK / 2U) / DAC_WAVE_TIM_CLK;
+        uint64_t actual, diff;
+
+        if (cycles == 0 || 2U * cycles > len || cycles > 0xFFFFU) {
+            continue;
+        }
+        actual = cycles * DAC_WAVE_TIM_CLK;
+        diff = (actual > target) ? actual - target : target - actual;
+        if (best_len == 0 || diff * best_len < best_diff * len) {
+            best_diff = diff;
+            best_len = len;
+            best_cycles = (uint32_t)cycles;
+        }
+    }
+    if (best_len == 0) {
+        return DAC_WAVE_PARAM_ERROR;
+    }
+
+    plan->len = (uint16_t)best_len;
+    plan->cycles = (uint16_t)best_cycles;
+    plan->freq_mhz = (uint32_t)(((uint64_t)best_cycles * DAC_WAVE_TIM_CLK * 1000U +
+                                 (uint64_t)s_ticks * best_len / 2U) /
+                                ((uint64_t)s_ticks * best_len));
+    return DAC_WAVE_OK;
+}
+
+/**
+ * @brief  相位累加器生成一张表
+ * @note   步进 2^32 × cycles / len 的整数部分和余数分别累加，第 len 个采样
+ *         的相位正好回到 cycles × 2^32，表首尾相接处没有累积误差
+ */
+void dac_wave_synth(uint16_t *table, uint16_t len, uint16_t cycles, dac_wave_shape_t shape,
+                    uint16_t amplitude, uint16_t offset) {
+    uint64_t step;
+    uint32_t inc, rem, err = 0, phase = 0;
+
+    if (table == NULL || len == 0) {
+        return;
+    }
+    step = (uint64_t)cycles << 32;
+    inc = (uint32_t)(step / len);
+    rem = (uint32_t)(step % len);
+
+    for (uint32_t i = 0; i < len; i++) {
+        int32_t v = dac_wave_shape(shape, phase);
+        int32_t code = (int32_t)offset + (((int32_t)amplitude * v + 16384) >> 15);
+
+        if (code < 0) {
+            code = 0;
+        } else if (code > (int32_t)DAC_WAVE_FULL_SCALE) {
+            code = DAC_WAVE_FULL_SCALE;
+        }
+        table[i] = (uint16_t)code;
+
+        phase += inc;
+        err += rem;
+        if (err >= len) {
+            err -= len;
+            phase++;
+        }
+    }
+}
+
+/************************ END OF FILE *****************************************/
@@ -208,8 +208,7 @@ uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef* dma_channel) {
     // TODO: 读取 CNDTR 寄存器
     // 寄存器: dma_channel->CNDTR
     // 操作: return (uint16_t)(dma_channel->CNDTR)
-    
-    return 0; // 占位符
+    return (uint16_t)(dma_channel->CNDTR);
 }
 
 /**
@@ -219,17 +218,16 @@ uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef* dma_channel) {
  */
 uint8_t DMA_GetFlagStatus(uint32_t flag) {
     /* 在 DMA1 ISR 中检查状态 */
-    // 注意: 如果使用 DMA2，逻辑需要根据标志/通道检查 DMA2->ISR。
-    // 为了简单起见，假设使用 DMA1 或通过标志参数全局处理。
+    // 注意: DMA2 的标志带有 DMA2_FLAG_SEL 位，据此选择 DMA2->ISR。
     
     // TODO: 读取 DMA1 中断状态寄存器
     // 寄存器: DMA1->ISR (或 DMA2->ISR)
     // 操作: 检查 if (DMA1->ISR & flag) != 0
-    
-    // 示例逻辑 (占位符):
-    // if ((DMA1->ISR & flag) != 0) {
-    //     return 1;
-    // }
+    uint32_t isr = (flag & DMA2_FLAG_SEL) ? DMA2->ISR : DMA1->ISR;
+
+    if ((isr & (flag & ~DMA2_FLAG_SEL)) != 0) {
+        return 1;
+    }
     
     return 0;
 }
@@ -246,6 +244,11 @@ void DMA_ClearFlag(uint32_t flag) {
     // TODO: 写入 DMA1 中断标志清除寄存器
     // 寄存器: DMA1->IFCR (或 DMA2->IFCR)
     // 操作: DMA1->IFCR = flag
+    if (flag & DMA2_FLAG_SEL) {
+        DMA2->IFCR = flag & ~DMA2_FLAG_SEL;
+    } else {
+        DMA1->IFCR = flag;
+    }
 }
 
 /* USER CODE END 2 */
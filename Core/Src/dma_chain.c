@@ -0,0 +1,189 @@
+/**
+ * @file    dma_chain.c
+ * @brief   软件 DMA 描述符链（scatter-gather）实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_chain.h"
+#include <stddef.h>
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  把描述符换算为 CPAR/CMAR 和增量位
+ * @note   存储器到外设 (DIR=1) 时 CPAR 为目的，其余情况 CPAR 为源
+ */
+static void DMA_Chain_Map(const DMA_Chain_t *chain, const DMA_Desc_t *d,
+                          uint32_t *cpar, uint32_t *cmar, uint32_t *inc) {
+    uint8_t p_fixed, m_fixed;
+
+    if (chain->cfg.Direction == DMA_DIR_PeripheralDST_Mem2Per) {
+        *cpar = d->dst;
+        *cmar = d->src;
+        p_fixed = (d->flags & DMA_DESC_DST_FIXED) != 0;
+        m_fixed = (d->flags & DMA_DESC_SRC_FIXED) != 0;
+    } else {
+        *cpar = d->src;
+        *cmar = d->dst;
+        p_fixed = (d->flags & DMA_DESC_SRC_FIXED) != 0;
+        m_fixed = (d->flags & DMA_DESC_DST_FIXED) != 0;
+    }
+
+    *inc = (p_fixed ? 0U : DMA_CCR_PINC) | (m_fixed ? 0U : DMA_CCR_MINC);
+}
+
+/**
+ * @brief  结束整条链
+ */
+static void DMA_Chain_Finish(DMA_Chain_t *chain, int status) {
+    chain->status = status;
+    chain->running = 0;
+    if (chain->done != NULL) {
+        chain->done(chain, status);
+    }
+}
+
+/**
+ * @brief  通道事件回调（中断上下文）
+ */
+static void DMA_Chain_OnEvent(DMA_ChannelId_t ch, uint32_t events, void *ctx) {
+    DMA_Chain_t *chain = (DMA_Chain_t *)ctx;
+    const DMA_Desc_t *cur;
+    uint32_t cpar, cmar, inc;
+
+    (void)ch;
+
+    if (!chain->running) {
+        return;
+    }
+    cur = &chain->desc[chain->index];
+
+    if (events & DMA_EVT_TE) {
+        DMA_Chain_Finish(chain, DMA_CHAIN_ERROR);
+        return;
+    }
+    if ((events & DMA_EVT_TC) == 0) {
+        return;
+    }
+
+    /* 步骤1：先接续下一段，回调放到后面，不占用段间空闲时间 */
+    if (chain->index + 1U < chain->count) {
+        const DMA_Desc_t *next = cur + 1;
+
+        DMA_Chain_Map(chain, next, &cpar, &cmar, &inc);
+        if (DMA_Restart(chain->ch, cpar, cmar, next->len, inc) != DMA_MGR_OK) {
+            /* 通道没有启动就不会再有 TC，链停在本段并以错误结束 */
+            if (cur->cb != NULL) {
+                cur->cb(cur, chain->ctx);
+            }
+            DMA_Chain_Finish(chain, DMA_CHAIN_ERROR);
+            return;
+        }
+        chain->index++;
+
+        /* 步骤2：本段回调 */
+        if (cur->cb != NULL) {
+            cur->cb(cur, chain->ctx);
+        }
+        return;
+    }
+
+    /* 最后一段 */
+    if (cur->cb != NULL) {
+        cur->cb(cur, chain->ctx);
+    }
+    DMA_Chain_Finish(chain, DMA_CHAIN_OK);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  绑定通道并注册回调
+ */
+int DMA_Chain_Init(DMA_Chain_t *chain, DMA_ChannelId_t ch,
+                   const DMA_Config_t *tmpl) {
+    if (chain == NULL || tmpl == NULL || tmpl->Mode != DMA_Mode_Normal) {
+        return DMA_CHAIN_PARAM_ERROR;
+    }
+
+    chain->ch = ch;
+    chain->cfg = *tmpl;
+    chain->desc = NULL;
+    chain->count = 0;
+    chain->index = 0;
+    chain->running = 0;
+    chain->status = DMA_CHAIN_OK;
+    chain->done = NULL;
+    chain->ctx = NULL;
+
+    if (DMA_SetCallback(ch, DMA_Chain_OnEvent, chain,
+                        DMA_EVT_TC | DMA_EVT_TE) != DMA_MGR_OK) {
+        return DMA_CHAIN_PARAM_ERROR;
+    }
+    return DMA_CHAIN_OK;
+}
+
+/**
+ * @brief  启动一条描述符链
+ */
+int DMA_Chain_Start(DMA_Chain_t *chain, const DMA_Desc_t *desc, uint16_t count,
+                    DMA_ChainDone_t done, void *ctx) {
+    DMA_Config_t cfg;
+    uint32_t inc;
+    uint16_t i;
+
+    if (chain == NULL || desc == NULL || count == 0) {
+        return DMA_CHAIN_PARAM_ERROR;
+    }
+    if (chain->running) {
+        return DMA_CHAIN_BUSY;
+    }
+    /* CNDTR 为 0 时通道不会产生 TC，链会停住 */
+    for (i = 0; i < count; i++) {
+        if (desc[i].len == 0) {
+            return DMA_CHAIN_PARAM_ERROR;
+        }
+    }
+
+    chain->desc = desc;
+    chain->count = count;
+    chain->index = 0;
+    chain->done = done;
+    chain->ctx = ctx;
+    chain->status = DMA_CHAIN_OK;
+    chain->running = 1;
+
+    /* 第一段通过 DMA_Init 完整配置通道 */
+    cfg = chain->cfg;
+    DMA_Chain_Map(chain, &desc[0], &cfg.PeriphBaseAddr, &cfg.MemBaseAddr, &inc);
+    cfg.PeriphInc = (inc & DMA_CCR_PINC) ? DMA_Inc_Enable : DMA_Inc_Disable;
+    cfg.MemInc = (inc & DMA_CCR_MINC) ? DMA_Inc_Enable : DMA_Inc_Disable;
+    cfg.BufferSize = desc[0].len;
+
+    if (DMA_StartTransfer(chain->ch, &cfg) != DMA_MGR_OK) {
+        chain->running = 0;
+        return DMA_CHAIN_BUSY;
+    }
+    return DMA_CHAIN_OK;
+}
+
+/**
+ * @brief  中止正在执行的链
+ */
+void DMA_Chain_Abort(DMA_Chain_t *chain) {
+    if (chain == NULL || !chain->running) {
+        return;
+    }
+    DMA_AbortTransfer(chain->ch);
+    chain->running = 0;
+}
+
+/**
+ * @brief  链是否正在执行
+ */
+uint8_t DMA_Chain_IsBusy(const DMA_Chain_t *chain) {
+    return (chain != NULL) ? chain->running : 0;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,451 @@
+/**
+ * @file    dma_manager.c
+ * @brief   DMA 通道管理器实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_manager.h"
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** DMA1 通道数 */
+#define DMA1_CHANNEL_COUNT 7
+
+/** 每个通道在 ISR/IFCR 中占 4 位：GIF, TCIF, HTIF, TEIF */
+#define DMA_FLAG_BITS 4U
+#define DMA_FLAG_ALL 0x0FU
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  通道运行时状态
+ */
+typedef struct {
+    DMA_TypeDef *ctrl;          /*!< 所属控制器 (ISR/IFCR) */
+    DMA_Channel_TypeDef *regs;  /*!< 通道寄存器 */
+    const char *owner;          /*!< 占用者，NULL 表示未占用 */
+    DMA_Callback_t cb;          /*!< 事件回调 */
+    void *ctx;                  /*!< 回调上下文 */
+    uint32_t events;            /*!< 使能的事件 */
+    uint16_t length;            /*!< 当前传输长度 */
+    volatile uint8_t busy;      /*!< 是否正在传输 */
+    DMA_ChannelStats_t stats;   /*!< 统计信息 */
+} DMA_ChannelState_t;
+
+/* Private variables ---------------------------------------------------------*/
+static DMA_ChannelState_t s_dma_ch[DMA_CH_COUNT];
+
+/** 模型模式：不操作 RCC/NVIC */
+static uint8_t s_dma_model = 0;
+
+/** 各通道对应的中断号（DMA2 通道 4/5 共用一个中断） */
+static const IRQn_Type s_dma_irqn[DMA_CH_COUNT] = {
+    DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn,
+    DMA1_Channel4_IRQn, DMA1_Channel5_IRQn, DMA1_Channel6_IRQn,
+    DMA1_Channel7_IRQn, DMA2_Channel1_IRQn, DMA2_Channel2_IRQn,
+    DMA2_Channel3_IRQn, DMA2_Channel4_5_IRQn, DMA2_Channel4_5_IRQn,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  通道在所属控制器 ISR/IFCR 中的位偏移
+ */
+static uint32_t DMA_FlagShift(DMA_ChannelId_t ch) {
+    uint32_t idx = (ch < DMA1_CHANNEL_COUNT) ? ch : ch - DMA1_CHANNEL_COUNT;
+    return idx * DMA_FLAG_BITS;
+}
+
+/**
+ * @brief  进入临界区，返回之前的 PRIMASK
+ */
+static uint32_t DMA_EnterCritical(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+/**
+ * @brief  退出临界区
+ */
+static void DMA_ExitCritical(uint32_t primask) {
+    if (primask == 0) {
+        __enable_irq();
+    }
+}
+
+/**
+ * @brief  清空全部运行时状态
+ * @retval DMA_MGR_OK / DMA_MGR_BUSY（仍有通道被占用，状态保持不变）
+ */
+static int DMA_ResetState(void) {
+    for (int i = 0; i < DMA_CH_COUNT; i++) {
+        if (s_dma_ch[i].owner != NULL) {
+            return DMA_MGR_BUSY;
+        }
+    }
+    memset(s_dma_ch, 0, sizeof(s_dma_ch));
+    return DMA_MGR_OK;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  初始化管理器，绑定实际的 DMA1/DMA2 寄存器
+ */
+int DMA_Manager_Init(void) {
+    static DMA_Channel_TypeDef *const dma1_ch[DMA1_CHANNEL_COUNT] = {
+        DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4,
+        DMA1_Channel5, DMA1_Channel6, DMA1_Channel7,
+    };
+    static DMA_Channel_TypeDef *const dma2_ch[DMA_CH_COUNT - DMA1_CHANNEL_COUNT] = {
+        DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4,
+        DMA2_Channel5,
+    };
+
+    if (DMA_ResetState() != DMA_MGR_OK) {
+        return DMA_MGR_BUSY;
+    }
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    s_dma_model = 0;
+
+    for (int i = 0; i < DMA_CH_COUNT; i++) {
+        if (i < DMA1_CHANNEL_COUNT) {
+            s_dma_ch[i].ctrl = DMA1;
+            s_dma_ch[i].regs = dma1_ch[i];
+        } else {
+            s_dma_ch[i].ctrl = DMA2;
+            s_dma_ch[i].regs = dma2_ch[i - DMA1_CHANNEL_COUNT];
+        }
+    }
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  绑定寄存器模型
+ */
+int DMA_Manager_AttachModel(DMA_TypeDef *dma1, DMA_Channel_TypeDef *dma1_ch,
+                            DMA_TypeDef *dma2, DMA_Channel_TypeDef *dma2_ch) {
+    if (DMA_ResetState() != DMA_MGR_OK) {
+        return DMA_MGR_BUSY;
+    }
+    s_dma_model = 1;
+
+    for (int i = 0; i < DMA_CH_COUNT; i++) {
+        if (i < DMA1_CHANNEL_COUNT) {
+            s_dma_ch[i].ctrl = dma1;
+            s_dma_ch[i].regs = &dma1_ch[i];
+        } else {
+            s_dma_ch[i].ctrl = dma2;
+            s_dma_ch[i].regs = &dma2_ch[i - DMA1_CHANNEL_COUNT];
+        }
+    }
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  占用一个通道
+ */
+int DMA_Claim(DMA_ChannelId_t ch, const char *owner) {
+    uint32_t primask;
+    int ret = DMA_MGR_OK;
+
+    if (ch >= DMA_CH_COUNT || s_dma_ch[ch].regs == NULL) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+
+    primask = DMA_EnterCritical();
+    if (s_dma_ch[ch].owner != NULL) {
+        ret = DMA_MGR_BUSY;
+    } else {
+        s_dma_ch[ch].owner = (owner != NULL) ? owner : "?";
+        s_dma_ch[ch].cb = NULL;
+        s_dma_ch[ch].ctx = NULL;
+        s_dma_ch[ch].events = 0;
+        memset(&s_dma_ch[ch].stats, 0, sizeof(s_dma_ch[ch].stats));
+    }
+    DMA_ExitCritical(primask);
+
+    return ret;
+}
+
+/**
+ * @brief  释放通道
+ */
+void DMA_Release(DMA_ChannelId_t ch) {
+    if (ch >= DMA_CH_COUNT || s_dma_ch[ch].owner == NULL) {
+        return;
+    }
+
+    DMA_AbortTransfer(ch);
+    s_dma_ch[ch].cb = NULL;
+    s_dma_ch[ch].owner = NULL;
+}
+
+/**
+ * @brief  查询通道占用者
+ */
+const char *DMA_GetOwner(DMA_ChannelId_t ch) {
+    return (ch < DMA_CH_COUNT) ? s_dma_ch[ch].owner : NULL;
+}
+
+/**
+ * @brief  获取通道寄存器指针
+ */
+DMA_Channel_TypeDef *DMA_GetInstance(DMA_ChannelId_t ch) {
+    return (ch < DMA_CH_COUNT) ? s_dma_ch[ch].regs : NULL;
+}
+
+/**
+ * @brief  注册事件回调
+ */
+int DMA_SetCallback(DMA_ChannelId_t ch, DMA_Callback_t cb, void *ctx,
+                    uint32_t events) {
+    if (ch >= DMA_CH_COUNT) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+    if (s_dma_ch[ch].owner == NULL) {
+        return DMA_MGR_NOT_OWNER;
+    }
+
+    s_dma_ch[ch].cb = cb;
+    s_dma_ch[ch].ctx = ctx;
+    s_dma_ch[ch].events = events & (DMA_EVT_TC | DMA_EVT_HT | DMA_EVT_TE);
+
+    if (!s_dma_model && s_dma_ch[ch].events != 0) {
+        NVIC_EnableIRQ(s_dma_irqn[ch]);
+    }
+
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  配置并启动一次传输
+ */
+int DMA_StartTransfer(DMA_ChannelId_t ch, DMA_Config_t *cfg) {
+    DMA_ChannelState_t *st;
+    uint32_t ccr_ie = 0;
+
+    if (ch >= DMA_CH_COUNT || cfg == NULL) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+    st = &s_dma_ch[ch];
+    if (st->owner == NULL) {
+        return DMA_MGR_NOT_OWNER;
+    }
+    if (st->busy) {
+        return DMA_MGR_BUSY;
+    }
+
+    /* 步骤1：配置通道（DMA_Init 会先关闭通道） */
+    if (DMA_Init(st->regs, cfg) != 0) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+
+    /* 步骤2：按注册的事件打开中断；单次传输的 TC 总是打开以便维护忙标志，
+     * 循环传输一直忙，只开注册的事件 */
+    if (st->events & DMA_EVT_TE) {
+        ccr_ie |= DMA_CCR_TEIE;
+    }
+    if (st->events & DMA_EVT_HT) {
+        ccr_ie |= DMA_CCR_HTIE;
+    }
+    if (st->events & DMA_EVT_TC) {
+        ccr_ie |= DMA_CCR_TCIE;
+    }
+    if (st->events != 0 && (st->regs->CCR & DMA_CCR_CIRC) == 0) {
+        ccr_ie |= DMA_CCR_TCIE;
+    }
+    st->regs->CCR |= ccr_ie;
+
+    /* 步骤3：清除残留标志，登记状态后启动 */
+    st->ctrl->IFCR = DMA_FLAG_ALL << DMA_FlagShift(ch);
+    st->length = cfg->BufferSize;
+    st->busy = 1;
+    st->stats.started++;
+
+    DMA_Cmd(st->regs, true);
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  快速重装并启动下一段传输
+ */
+int DMA_Restart(DMA_ChannelId_t ch, uint32_t cpar, uint32_t cmar,
+                uint16_t count, uint32_t inc) {
+    DMA_ChannelState_t *st;
+    DMA_Channel_TypeDef *regs;
+
+    if (ch >= DMA_CH_COUNT || count == 0) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+    st = &s_dma_ch[ch];
+    if (st->owner == NULL) {
+        return DMA_MGR_NOT_OWNER;
+    }
+    if (st->busy) {
+        return DMA_MGR_BUSY;
+    }
+    regs = st->regs;
+
+    /* EN 已在 TC 处理中清除，这里只写必须变化的寄存器 */
+    regs->CCR &= ~DMA_CCR_EN;
+    regs->CPAR = cpar;
+    regs->CMAR = cmar;
+    regs->CNDTR = count;
+    regs->CCR = (regs->CCR & ~(DMA_CCR_PINC | DMA_CCR_MINC)) |
+                (inc & (DMA_CCR_PINC | DMA_CCR_MINC));
+    st->ctrl->IFCR = DMA_FLAG_ALL << DMA_FlagShift(ch);
+    st->length = count;
+    st->busy = 1;
+    st->stats.started++;
+
+    regs->CCR |= DMA_CCR_EN;
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  修改正在进行的传输上打开的中断事件
+ */
+int DMA_SetEvents(DMA_ChannelId_t ch, uint32_t events) {
+    DMA_ChannelState_t *st;
+    uint32_t ie, enable;
+
+    if (ch >= DMA_CH_COUNT) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+    st = &s_dma_ch[ch];
+    if (st->owner == NULL) {
+        return DMA_MGR_NOT_OWNER;
+    }
+
+    /* 事件位与 CCR 中 TCIE / HTIE / TEIE 的位置相同 */
+    events &= DMA_EVT_TC | DMA_EVT_HT | DMA_EVT_TE;
+    ie = events;
+    if (events != 0 && (st->regs->CCR & DMA_CCR_CIRC) == 0) {
+        ie |= DMA_CCR_TCIE;
+    }
+    enable = ie & ~st->regs->CCR;
+
+    st->events = events;
+    if (enable != 0) {
+        st->ctrl->IFCR = enable << DMA_FlagShift(ch);
+        if (!s_dma_model) {
+            NVIC_EnableIRQ(s_dma_irqn[ch]);
+        }
+    }
+    st->regs->CCR = (st->regs->CCR & ~(DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE)) | ie;
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  中止传输
+ */
+void DMA_AbortTransfer(DMA_ChannelId_t ch) {
+    DMA_ChannelState_t *st;
+
+    if (ch >= DMA_CH_COUNT || s_dma_ch[ch].regs == NULL) {
+        return;
+    }
+    st = &s_dma_ch[ch];
+
+    st->regs->CCR &= ~(DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+    DMA_Cmd(st->regs, false);
+    st->ctrl->IFCR = DMA_FLAG_ALL << DMA_FlagShift(ch);
+    st->busy = 0;
+}
+
+/**
+ * @brief  通道是否正在传输
+ */
+uint8_t DMA_IsBusy(DMA_ChannelId_t ch) {
+    return (ch < DMA_CH_COUNT) ? s_dma_ch[ch].busy : 0;
+}
+
+/**
+ * @brief  当前传输已完成的数据单元数
+ */
+uint16_t DMA_GetProgress(DMA_ChannelId_t ch) {
+    DMA_ChannelState_t *st;
+    uint16_t remaining;
+
+    if (ch >= DMA_CH_COUNT || s_dma_ch[ch].regs == NULL) {
+        return 0;
+    }
+    st = &s_dma_ch[ch];
+
+    if (!st->busy) {
+        return st->length;
+    }
+
+    remaining = DMA_GetCurrDataCounter(st->regs);
+    return (remaining <= st->length) ? (uint16_t)(st->length - remaining) : 0;
+}
+
+/**
+ * @brief  获取通道统计信息
+ */
+int DMA_GetStats(DMA_ChannelId_t ch, DMA_ChannelStats_t *stats) {
+    if (ch >= DMA_CH_COUNT || stats == NULL) {
+        return DMA_MGR_PARAM_ERROR;
+    }
+
+    *stats = s_dma_ch[ch].stats;
+    return DMA_MGR_OK;
+}
+
+/**
+ * @brief  通道中断处理
+ */
+void DMA_Manager_IRQHandler(DMA_ChannelId_t ch) {
+    DMA_ChannelState_t *st;
+    uint32_t shift, flags, events;
+
+    if (ch >= DMA_CH_COUNT || s_dma_ch[ch].regs == NULL) {
+        return;
+    }
+    st = &s_dma_ch[ch];
+    shift = DMA_FlagShift(ch);
+
+    /* 步骤1：读取并清除本通道的标志（写 IFCR 的 CGIF 同时清除全部 4 位） */
+    flags = (st->ctrl->ISR >> shift) & DMA_FLAG_ALL;
+    if ((flags & (DMA_EVT_TC | DMA_EVT_HT | DMA_EVT_TE)) == 0) {
+        return;
+    }
+    st->ctrl->IFCR = flags << shift;
+
+    /* 步骤2：更新计数与忙标志 */
+    if (flags & DMA_EVT_HT) {
+        st->stats.half++;
+    }
+    if (flags & DMA_EVT_TC) {
+        st->stats.completed++;
+        st->stats.units += st->length;
+        /* 循环模式会自动重装，传输一直进行 */
+        if ((st->regs->CCR & DMA_CCR_CIRC) == 0) {
+            st->regs->CCR &= ~DMA_CCR_EN;
+            st->busy = 0;
+        }
+    }
+    if (flags & DMA_EVT_TE) {
+        /* TE 时硬件已自动清除 EN；进度只记到出错前实际搬运的单元数 */
+        uint16_t remaining = DMA_GetCurrDataCounter(st->regs);
+        if (remaining <= st->length) {
+            st->length -= remaining;
+        }
+        st->stats.errors++;
+        st->regs->CCR &= ~DMA_CCR_EN;
+        st->busy = 0;
+    }
+
+    /* 步骤3：分发给回调 */
+    events = flags & st->events;
+    if (st->cb != NULL && events != 0) {
+        st->cb(ch, events, st->ctx);
+    }
+}
+
+/************************ END OF FILE *****************************************/
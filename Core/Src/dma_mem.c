@@ -0,0 +1,275 @@
+/**
+ * @file    dma_mem.c
+ * @brief   基于 MEM2MEM DMA 通道的异步 memcpy / memset 实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_mem.h"
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** CNDTR 上限 */
+#define DMA_MEM_MAX_UNITS 0xFFFFU
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  队列中的一个请求
+ */
+typedef struct {
+    uint32_t dst;           /*!< 当前目的地址（随分段推进） */
+    uint32_t src;           /*!< 当前源地址（memset 时不使用） */
+    uint32_t remaining;     /*!< 剩余字节数 */
+    uint32_t seg_bytes;     /*!< 正在传输的段长度 */
+    dma_mem_callback_t cb;  /*!< 完成回调 */
+    void *ctx;              /*!< 回调上下文 */
+    uint8_t is_set;         /*!< 是否为 memset */
+    uint8_t value;          /*!< memset 填充值 */
+} dma_mem_job_t;
+
+/* Private variables ---------------------------------------------------------*/
+static dma_mem_job_t s_jobs[DMA_MEM_QUEUE_LEN];
+static volatile uint8_t s_head = 0;  /* 下一个空位 */
+static volatile uint8_t s_tail = 0;  /* 正在执行的请求 */
+static volatile uint8_t s_count = 0; /* 队列中的请求数（含正在执行的） */
+static uint8_t s_ready = 0;
+static uint16_t s_max_units = DMA_MEM_MAX_UNITS;
+
+/** memset 的源数据：填充字节复制到 4 个字节，供任意宽度读取 */
+static volatile uint32_t s_pattern;
+
+/* Private function prototypes -----------------------------------------------*/
+static void dma_mem_start_segment(void);
+static void dma_mem_on_event(DMA_ChannelId_t ch, uint32_t events, void *ctx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  为队首请求启动下一段传输
+ * @note   宽度取决于地址对齐和剩余长度：字对齐且至少 4 字节用字，
+ *         半字对齐且至少 2 字节用半字，否则用字节
+ */
+static void dma_mem_start_segment(void) {
+    dma_mem_job_t *job = &s_jobs[s_tail];
+    uint32_t align = job->dst | (job->is_set ? 0U : job->src);
+    uint32_t shift;
+    uint32_t units;
+    DMA_Config_t cfg;
+
+    if ((align & 3U) == 0 && job->remaining >= 4) {
+        shift = 2;
+        cfg.PeriphDataSize = DMA_DataSize_Word;
+    } else if ((align & 1U) == 0 && job->remaining >= 2) {
+        shift = 1;
+        cfg.PeriphDataSize = DMA_DataSize_HalfWord;
+    } else {
+        shift = 0;
+        cfg.PeriphDataSize = DMA_DataSize_Byte;
+    }
+    cfg.MemDataSize = cfg.PeriphDataSize;
+
+    units = job->remaining >> shift;
+    if (units > s_max_units) {
+        units = s_max_units;
+    }
+    job->seg_bytes = units << shift;
+
+    /* MEM2MEM 且 DIR=0 时 CPAR 为源，CMAR 为目的 */
+    if (job->is_set) {
+        s_pattern = job->value * 0x01010101UL;
+        cfg.PeriphBaseAddr = (uint32_t)&s_pattern;
+        cfg.PeriphInc = DMA_Inc_Disable;
+    } else {
+        cfg.PeriphBaseAddr = job->src;
+        cfg.PeriphInc = DMA_Inc_Enable;
+    }
+    cfg.MemBaseAddr = job->dst;
+    cfg.MemInc = DMA_Inc_Enable;
+    cfg.Direction = DMA_DIR_PeripheralSRC;
+    cfg.BufferSize = (uint16_t)units;
+    cfg.Mode = DMA_Mode_Normal;
+    cfg.Priority = DMA_Priority_Low;
+    cfg.M2M = true;
+
+    DMA_StartTransfer(DMA_MEM_CHANNEL, &cfg);
+}
+
+/**
+ * @brief  完成当前请求并启动队列中的下一个
+ */
+static void dma_mem_finish_job(int status) {
+    dma_mem_job_t *job = &s_jobs[s_tail];
+    dma_mem_callback_t cb = job->cb;
+    void *ctx = job->ctx;
+
+    s_tail = (uint8_t)((s_tail + 1) % DMA_MEM_QUEUE_LEN);
+    s_count--;
+
+    /* 先启动下一个请求再回调，缩短通道空闲时间 */
+    if (s_count > 0) {
+        dma_mem_start_segment();
+    }
+
+    if (cb != NULL) {
+        cb(status, ctx);
+    }
+}
+
+/**
+ * @brief  DMA 事件回调（中断上下文）
+ */
+static void dma_mem_on_event(DMA_ChannelId_t ch, uint32_t events, void *ctx) {
+    dma_mem_job_t *job = &s_jobs[s_tail];
+
+    (void)ch;
+    (void)ctx;
+
+    if (s_count == 0) {
+        return;
+    }
+
+    if (events & DMA_EVT_TE) {
+        dma_mem_finish_job(DMA_MEM_ERROR);
+        return;
+    }
+
+    if (events & DMA_EVT_TC) {
+        job->dst += job->seg_bytes;
+        if (!job->is_set) {
+            job->src += job->seg_bytes;
+        }
+        job->remaining -= job->seg_bytes;
+
+        if (job->remaining > 0) {
+            dma_mem_start_segment();
+        } else {
+            dma_mem_finish_job(DMA_MEM_OK);
+        }
+    }
+}
+
+/**
+ * @brief  把请求加入队列，通道空闲时立即启动
+ */
+static int dma_mem_submit(uint32_t dst, uint32_t src, size_t len,
+                          uint8_t is_set, uint8_t value,
+                          dma_mem_callback_t cb, void *ctx) {
+    uint32_t primask;
+    dma_mem_job_t *job;
+
+    if (!s_ready || dst == 0) {
+        return DMA_MEM_PARAM_ERROR;
+    }
+
+    if (len == 0) {
+        if (cb != NULL) {
+            cb(DMA_MEM_OK, ctx);
+        }
+        return DMA_MEM_OK;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (s_count >= DMA_MEM_QUEUE_LEN) {
+        if (primask == 0) {
+            __enable_irq();
+        }
+        return DMA_MEM_QUEUE_FULL;
+    }
+
+    job = &s_jobs[s_head];
+    job->dst = dst;
+    job->src = src;
+    job->remaining = (uint32_t)len;
+    job->seg_bytes = 0;
+    job->cb = cb;
+    job->ctx = ctx;
+    job->is_set = is_set;
+    job->value = value;
+    s_head = (uint8_t)((s_head + 1) % DMA_MEM_QUEUE_LEN);
+    s_count++;
+
+    if (s_count == 1) {
+        dma_mem_start_segment();
+    }
+
+    if (primask == 0) {
+        __enable_irq();
+    }
+    return DMA_MEM_OK;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  初始化：占用 DMA_MEM_CHANNEL 并注册回调
+ */
+int dma_mem_init(void) {
+    if (DMA_Claim(DMA_MEM_CHANNEL, "dma_mem") != DMA_MGR_OK) {
+        return DMA_MEM_PARAM_ERROR;
+    }
+    DMA_SetCallback(DMA_MEM_CHANNEL, dma_mem_on_event, NULL,
+                    DMA_EVT_TC | DMA_EVT_TE);
+
+    s_head = 0;
+    s_tail = 0;
+    s_count = 0;
+    s_ready = 1;
+    return DMA_MEM_OK;
+}
+
+/**
+ * @brief  释放通道，丢弃未执行的请求
+ */
+void dma_mem_deinit(void) {
+    DMA_Release(DMA_MEM_CHANNEL);
+    s_count = 0;
+    s_head = 0;
+    s_tail = 0;
+    s_ready = 0;
+}
+
+/**
+ * @brief  异步内存复制
+ */
+int dma_memcpy_async(void *dst, const void *src, size_t len,
+                     dma_mem_callback_t cb, void *ctx) {
+    if (src == NULL) {
+        return DMA_MEM_PARAM_ERROR;
+    }
+    return dma_mem_submit((uint32_t)dst, (uint32_t)src, len, 0, 0, cb, ctx);
+}
+
+/**
+ * @brief  异步内存填充
+ */
+int dma_memset_async(void *dst, uint8_t value, size_t len,
+                     dma_mem_callback_t cb, void *ctx) {
+    return dma_mem_submit((uint32_t)dst, 0, len, 1, value, cb, ctx);
+}
+
+/**
+ * @brief  是否还有未完成的请求
+ */
+uint8_t dma_mem_busy(void) {
+    return s_count != 0;
+}
+
+/**
+ * @brief  等待所有请求完成
+ */
+void dma_mem_wait(void) {
+    while (s_count != 0) {
+    }
+}
+
+/**
+ * @brief  修改单段最大单元数
+ */
+void dma_mem_set_max_units(uint16_t units) {
+    s_max_units = (units == 0) ? DMA_MEM_MAX_UNITS : units;
+}
+
+/************************ END OF FILE *****************************************/
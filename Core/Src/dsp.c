@@ -0,0 +1,327 @@
+/**
+ * @file    dsp.c
+ * @brief   定点 DSP 核（Q15 / Q31：FIR、抽取、级联双二阶 IIR、滑动 RMS、峰值检测）实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dsp.h"
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define DSP_Q15_MAX 32767
+#define DSP_Q15_MIN (-32768)
+#define DSP_Q31_MAX 2147483647LL
+#define DSP_Q31_MIN (-2147483647LL - 1LL)
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  64 位累加器舍入、右移并饱和到 Q15
+ */
+static inline q15_t dsp_round_q15(int64_t acc, uint32_t shift) {
+    int64_t v = (acc + (1LL << (shift - 1U))) >> shift;
+
+    if (v > DSP_Q15_MAX) {
+        return DSP_Q15_MAX;
+    }
+    if (v < DSP_Q15_MIN) {
+        return DSP_Q15_MIN;
+    }
+    return (q15_t)v;
+}
+
+/**
+ * @brief  64 位累加器舍入、右移并饱和到 Q31
+ */
+static inline q31_t dsp_round_q31(int64_t acc, uint32_t shift) {
+    int64_t v = (acc + (1LL << (shift - 1U))) >> shift;
+
+    if (v > DSP_Q31_MAX) {
+        return (q31_t)DSP_Q31_MAX;
+    }
+    if (v < DSP_Q31_MIN) {
+        return (q31_t)DSP_Q31_MIN;
+    }
+    return (q31_t)v;
+}
+
+/**
+ * @brief  一个 FIR 输出：x 指向最新的采样，向前取 num_taps 个
+ * @note   每次乘加是一条 SMLAL；按 4 展开减少循环开销
+ */
+static inline int64_t dsp_fir_dot(const q15_t *h, const q15_t *x, uint32_t taps) {
+    int64_t acc = 0;
+    uint32_t k = taps >> 2;
+
+    while (k-- > 0U) {
+        acc += (int32_t)h[0] * x[0];
+        acc += (int32_t)h[1] * x[-1];
+        acc += (int32_t)h[2] * x[-2];
+        acc += (int32_t)h[3] * x[-3];
+        h += 4;
+        x -= 4;
+    }
+    k = taps & 3U;
+    while (k-- > 0U) {
+        acc += (int32_t)*h++ * *x--;
+    }
+    return acc;
+}
+
+/**
+ * @brief  把新采样接到历史后面
+ * @retval 指向状态缓冲区中第一个新采样
+ */
+static q15_t *dsp_fir_push(dsp_fir_q15_t *s, const q15_t *in, uint16_t n) {
+    q15_t *x = s->state + (s->num_taps - 1U);
+
+    memmove(x, in, (size_t)n * sizeof(q15_t));
+    return x;
+}
+
+/**
+ * @brief  保留最后 num_taps - 1 个采样作为下一块的历史
+ */
+static void dsp_fir_shift(dsp_fir_q15_t *s, uint16_t n) {
+    memmove(s->state, s->state + n, (size_t)(s->num_taps - 1U) * sizeof(q15_t));
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  初始化 FIR
+ */
+int dsp_fir_q15_init(dsp_fir_q15_t *s, const q15_t *coeffs, uint16_t num_taps,
+                     q15_t *state, uint16_t max_block) {
+    if (s == NULL || coeffs == NULL || state == NULL || num_taps == 0 || max_block == 0) {
+        return DSP_PARAM_ERROR;
+    }
+    s->coeffs = coeffs;
+    s->state = state;
+    s->num_taps = num_taps;
+    s->max_block = max_block;
+    memset(state, 0, DSP_FIR_STATE_LEN(num_taps, max_block) * sizeof(q15_t));
+    return DSP_OK;
+}
+
+/**
+ * @brief  FIR 处理一块
+ */
+void dsp_fir_q15(dsp_fir_q15_t *s, const q15_t *in, q15_t *out, uint16_t n) {
+    const q15_t *x;
+
+    if (n == 0 || n > s->max_block) {
+        return;
+    }
+    x = dsp_fir_push(s, in, n);
+    for (uint16_t i = 0; i < n; i++) {
+        out[i] = dsp_round_q15(dsp_fir_dot(s->coeffs, x + i, s->num_taps), 15U);
+    }
+    dsp_fir_shift(s, n);
+}
+
+/**
+ * @brief  初始化抽取器
+ */
+int dsp_decim_q15_init(dsp_decim_q15_t *s, uint8_t factor, const q15_t *coeffs,
+                       uint16_t num_taps, q15_t *state, uint16_t max_block) {
+    if (s == NULL || factor == 0 || max_block % factor != 0U) {
+        return DSP_PARAM_ERROR;
+    }
+    s->factor = factor;
+    return dsp_fir_q15_init(&s->fir, coeffs, num_taps, state, max_block);
+}
+
+/**
+ * @brief  抽取处理一块
+ */
+int dsp_decim_q15(dsp_decim_q15_t *s, const q15_t *in, q15_t *out, uint16_t n) {
+    const q15_t *x;
+    uint16_t m = 0;
+
+    if (n > s->fir.max_block || n % s->factor != 0U) {
+        return DSP_PARAM_ERROR;
+    }
+    if (n == 0) {
+        return 0;
+    }
+    x = dsp_fir_push(&s->fir, in, n);
+    for (uint16_t i = s->factor - 1U; i < n; i += s->factor) {
+        out[m++] = dsp_round_q15(dsp_fir_dot(s->fir.coeffs, x + i, s->fir.num_taps), 15U);
+    }
+    dsp_fir_shift(&s->fir, n);
+    return m;
+}
+
+/**
+ * @brief  初始化级联双二阶
+ */
+int dsp_biquad_q31_init(dsp_biquad_q31_t *s, uint8_t stages, const int16_t *coeffs,
+                        q31_t *state) {
+    if (s == NULL || coeffs == NULL || state == NULL || stages == 0) {
+        return DSP_PARAM_ERROR;
+    }
+    s->coeffs = coeffs;
+    s->state = state;
+    s->stages = stages;
+    memset(state, 0, 4U * stages * sizeof(q31_t));
+    return DSP_OK;
+}
+
+/**
+ * @brief  级联双二阶处理一块
+ * @note   逐级处理整块：一级的系数与状态在内层循环里都留在寄存器中；
+ *         in 读完后只写 out，之后的级在 out 上原位进行
+ */
+void dsp_biquad_q31(dsp_biquad_q31_t *s, const q31_t *in, q31_t *out, uint32_t n) {
+    const int16_t *c = s->coeffs;
+    q31_t *st = s->state;
+    const q31_t *src = in;
+
+    for (uint8_t k = 0; k < s->stages; k++, c += 5, st += 4) {
+        const int32_t b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        q31_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+        for (uint32_t i = 0; i < n; i++) {
+            q31_t x0 = src[i];
+            int64_t acc = (int64_t)b0 * x0;
+
+            acc += (int64_t)b1 * x1;
+            acc += (int64_t)b2 * x2;
+            acc -= (int64_t)a1 * y1;
+            acc -= (int64_t)a2 * y2;
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = dsp_round_q31(acc, DSP_BIQUAD_SHIFT);
+            out[i] = y1;
+        }
+
+        st[0] = x1;
+        st[1] = x2;
+        st[2] = y1;
+        st[3] = y2;
+        src = out;
+    }
+}
+
+/**
+ * @brief  初始化滑动 RMS
+ */
+int dsp_rms_q15_init(dsp_rms_q15_t *s, q15_t *window, uint16_t len) {
+    if (s == NULL || window == NULL || len == 0) {
+        return DSP_PARAM_ERROR;
+    }
+    s->window = window;
+    s->sumsq = 0;
+    s->len = len;
+    s->pos = 0;
+    memset(window, 0, (size_t)len * sizeof(q15_t));
+    return DSP_OK;
+}
+
+/**
+ * @brief  推入一块采样，返回 RMS
+ * @note   平方和增量更新（加新减旧），每块只做一次除法和开方
+ */
+q15_t dsp_rms_q15(dsp_rms_q15_t *s, const q15_t *in, uint32_t n) {
+    uint64_t sumsq = s->sumsq;
+    uint32_t pos = s->pos;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t old = s->window[pos];
+        int32_t v = in[i];
+
+        sumsq += (uint32_t)(v * v);
+        sumsq -= (uint32_t)(old * old);
+        s->window[pos] = (q15_t)v;
+        if (++pos == s->len) {
+            pos = 0;
+        }
+    }
+    s->sumsq = sumsq;
+    s->pos = (uint16_t)pos;
+
+    /* 均方值不超过 2^30，开方后不超过 32768，饱和到 Q15 */
+    uint32_t r = dsp_isqrt((uint32_t)(sumsq / s->len));
+    return (q15_t)((r > (uint32_t)DSP_Q15_MAX) ? DSP_Q15_MAX : r);
+}
+
+/**
+ * @brief  初始化峰值检测
+ */
+int dsp_peak_q15_init(dsp_peak_q15_t *s, uint8_t release_shift) {
+    if (s == NULL || release_shift == 0 || release_shift > 15U) {
+        return DSP_PARAM_ERROR;
+    }
+    s->env = 0;
+    s->release_shift = release_shift;
+    return DSP_OK;
+}
+
+/**
+ * @brief  推入一块采样，返回包络
+ */
+q15_t dsp_peak_q15(dsp_peak_q15_t *s, const q15_t *in, uint32_t n) {
+    const uint32_t shift = s->release_shift;
+    const int32_t round = (1 << shift) - 1;
+    int32_t env = s->env;
+
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t a = in[i];
+
+        if (a < 0) {
+            a = (a == DSP_Q15_MIN) ? DSP_Q15_MAX : -a;
+        }
+        env -= (env + round) >> shift;
+        if (a > env) {
+            env = a;
+        }
+    }
+    s->env = (q15_t)env;
+    return s->env;
+}
+
+/**
+ * @brief  Q15 转 Q31
+ */
+void dsp_q15_to_q31(const q15_t *in, q31_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = (q31_t)((uint32_t)(int32_t)in[i] << 16);
+    }
+}
+
+/**
+ * @brief  Q31 转 Q15
+ */
+void dsp_q31_to_q15(const q31_t *in, q15_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = dsp_round_q15(in[i], 16U);
+    }
+}
+
+/**
+ * @brief  整数平方根（向下取整，逐位试商）
+ */
+uint32_t dsp_isqrt(uint32_t x) {
+    uint32_t r = 0;
+    uint32_t b = 1UL << 30;
+
+    while (b > x) {
+        b >>= 2;
+    }
+    while (b != 0) {
+        if (x >= r + b) {
+            x -= r + b;
+            r = (r >> 1) + b;
+        } else {
+            r >>= 1;
+        }
+        b >>= 2;
+    }
+    return r;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,328 @@
+/**
+ * @file    event_loop.c
+ * @brief   协作式事件循环（run-to-completion）实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "event_loop.h"
+#include "bench.h"
+#include "tickless.h"
+#include <stdio.h>
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  推迟的工作
+ */
+typedef struct {
+    ev_work_t work;
+    void *arg;
+} ev_deferred_t;
+
+/* Private variables ---------------------------------------------------------*/
+static ev_task_t *s_tasks[EV_MAX_PRIORITIES];
+static volatile uint32_t s_ready = 0; /* 位 n：优先级 n 的任务有事件 */
+static ev_deferred_t s_defer[EV_DEFER_LEN];
+static volatile uint16_t s_defer_head = 0;
+static volatile uint16_t s_defer_tail = 0;
+static volatile uint16_t s_defer_count = 0;
+static ev_stats_t s_defer_stats;
+static volatile uint8_t s_stop = 0;
+static void (*s_idle_hook)(void) = tickless_idle;
+static uint32_t s_window_start = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint32_t ev_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void ev_unlock(uint32_t primask) {
+    if (primask == 0) {
+        __enable_irq();
+    }
+}
+
+/**
+ * @brief  记录一次处理的耗时
+ */
+static void ev_account(ev_stats_t *stats, uint32_t cycles) {
+    stats->handled++;
+    stats->cycles += cycles;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+}
+
+static void ev_timer_expired(tw_timer_t *timer, void *ctx) {
+    ev_timer_t *t = ctx;
+    (void)timer;
+    ev_post(t->task, t->sig, tw_now(), t);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void ev_init(void) {
+    uint32_t primask = ev_lock();
+
+    for (uint32_t i = 0; i < EV_MAX_PRIORITIES; i++) {
+        s_tasks[i] = NULL;
+    }
+    s_ready = 0;
+    s_defer_head = 0;
+    s_defer_tail = 0;
+    s_defer_count = 0;
+    s_stop = 0;
+    s_idle_hook = tickless_idle;
+    ev_unlock(primask);
+
+    bench_init();
+    ev_reset_stats();
+}
+
+int ev_task_init(ev_task_t *task, const char *name, uint8_t prio,
+                 ev_handler_t handler, void *ctx, ev_event_t *queue,
+                 uint16_t len) {
+    uint32_t primask;
+
+    if (task == NULL || handler == NULL || queue == NULL || len == 0 ||
+        prio >= EV_MAX_PRIORITIES) {
+        return EV_PARAM_ERROR;
+    }
+
+    primask = ev_lock();
+    if (s_tasks[prio] != NULL) {
+        ev_unlock(primask);
+        return EV_PARAM_ERROR;
+    }
+    task->name = name;
+    task->handler = handler;
+    task->ctx = ctx;
+    task->queue = queue;
+    task->len = len;
+    task->head = 0;
+    task->tail = 0;
+    task->count = 0;
+    task->prio = prio;
+    task->stats = (ev_stats_t){0};
+    s_tasks[prio] = task;
+    ev_unlock(primask);
+    return EV_OK;
+}
+
+void ev_task_remove(ev_task_t *task) {
+    uint32_t primask = ev_lock();
+
+    if (s_tasks[task->prio] == task) {
+        s_tasks[task->prio] = NULL;
+        s_ready &= ~(1UL << task->prio);
+        task->count = 0;
+        task->head = task->tail = 0;
+    }
+    ev_unlock(primask);
+}
+
+int ev_post(ev_task_t *task, uint16_t sig, uint32_t param, void *ptr) {
+    uint32_t primask;
+    ev_event_t *ev;
+
+    if (task == NULL) {
+        return EV_PARAM_ERROR;
+    }
+
+    primask = ev_lock();
+    if (task->count >= task->len) {
+        task->stats.dropped++;
+        ev_unlock(primask);
+        return EV_QUEUE_FULL;
+    }
+    ev = &task->queue[task->head];
+    ev->sig = sig;
+    ev->flags = 0;
+    ev->param = param;
+    ev->ptr = ptr;
+    task->head = (uint16_t)((task->head + 1U) % task->len);
+    task->count++;
+    if (task->count > task->stats.peak) {
+        task->stats.peak = task->count;
+    }
+    if (s_tasks[task->prio] == task) {
+        s_ready |= 1UL << task->prio;
+    }
+    ev_unlock(primask);
+    return EV_OK;
+}
+
+int ev_defer(ev_work_t work, void *arg) {
+    uint32_t primask;
+
+    if (work == NULL) {
+        return EV_PARAM_ERROR;
+    }
+
+    primask = ev_lock();
+    if (s_defer_count >= EV_DEFER_LEN) {
+        s_defer_stats.dropped++;
+        ev_unlock(primask);
+        return EV_QUEUE_FULL;
+    }
+    s_defer[s_defer_head].work = work;
+    s_defer[s_defer_head].arg = arg;
+    s_defer_head = (uint16_t)((s_defer_head + 1U) % EV_DEFER_LEN);
+    s_defer_count++;
+    if (s_defer_count > s_defer_stats.peak) {
+        s_defer_stats.peak = s_defer_count;
+    }
+    ev_unlock(primask);
+    return EV_OK;
+}
+
+int ev_run_once(void) {
+    uint32_t primask;
+    uint32_t t0;
+
+    primask = ev_lock();
+
+    /* 推迟的工作优先 */
+    if (s_defer_count != 0) {
+        ev_deferred_t item = s_defer[s_defer_tail];
+        s_defer_tail = (uint16_t)((s_defer_tail + 1U) % EV_DEFER_LEN);
+        s_defer_count--;
+        ev_unlock(primask);
+
+        t0 = bench_now();
+        item.work(item.arg);
+        ev_account(&s_defer_stats, bench_now() - t0);
+        return 1;
+    }
+
+    if (s_ready != 0) {
+        uint32_t prio = 31U - __CLZ(s_ready);
+        ev_task_t *task = s_tasks[prio];
+        ev_event_t ev = task->queue[task->tail];
+
+        task->tail = (uint16_t)((task->tail + 1U) % task->len);
+        if (--task->count == 0) {
+            s_ready &= ~(1UL << prio);
+        }
+        ev_unlock(primask);
+
+        t0 = bench_now();
+        task->handler(task, &ev);
+        ev_account(&task->stats, bench_now() - t0);
+        return 1;
+    }
+
+    ev_unlock(primask);
+    return 0;
+}
+
+uint32_t ev_run_until_idle(void) {
+    uint32_t n = 0;
+
+    while (ev_run_once()) {
+        n++;
+    }
+    return n;
+}
+
+void ev_run(void) {
+    s_stop = 0;
+    while (!s_stop) {
+        if (ev_run_once()) {
+            continue;
+        }
+        /* 关中断检查后再睡，WFI 在 PRIMASK = 1 时也会被挂起的中断唤醒 */
+        __disable_irq();
+        if (!ev_pending() && !s_stop) {
+            s_idle_hook();
+        }
+        __enable_irq();
+    }
+}
+
+void ev_stop(void) {
+    s_stop = 1;
+}
+
+int ev_pending(void) {
+    return s_ready != 0 || s_defer_count != 0;
+}
+
+void ev_set_idle_hook(void (*hook)(void)) {
+    s_idle_hook = hook != NULL ? hook : tickless_idle;
+}
+
+const ev_stats_t *ev_defer_stats(void) {
+    return &s_defer_stats;
+}
+
+void ev_reset_stats(void) {
+    uint32_t primask = ev_lock();
+
+    for (uint32_t i = 0; i < EV_MAX_PRIORITIES; i++) {
+        if (s_tasks[i] != NULL) {
+            s_tasks[i]->stats = (ev_stats_t){0};
+        }
+    }
+    s_defer_stats = (ev_stats_t){0};
+    s_window_start = HAL_GetTick();
+    ev_unlock(primask);
+}
+
+void ev_report(void) {
+    uint32_t window_ms = HAL_GetTick() - s_window_start;
+    uint64_t window = (uint64_t)window_ms * (SystemCoreClock / 1000U);
+
+    printf("  task          prio  events  dropped  peak    kcycles      max  cpu%%\r\n");
+    for (int i = EV_MAX_PRIORITIES; i >= 0; i--) {
+        const char *name;
+        const ev_stats_t *st;
+        uint32_t permille;
+
+        if (i == EV_MAX_PRIORITIES) {
+            name = "(deferred)";
+            st = &s_defer_stats;
+        } else if (s_tasks[i] != NULL) {
+            name = s_tasks[i]->name;
+            st = &s_tasks[i]->stats;
+        } else {
+            continue;
+        }
+        permille = window != 0 ? (uint32_t)(st->cycles * 1000U / window) : 0;
+        printf("  %-12s  %4d  %6lu  %7lu  %4lu  %9lu  %7lu  %2lu.%lu\r\n", name,
+               i == EV_MAX_PRIORITIES ? -1 : i, (unsigned long)st->handled,
+               (unsigned long)st->dropped, (unsigned long)st->peak,
+               (unsigned long)(st->cycles / 1000U), (unsigned long)st->max_cycles,
+               (unsigned long)(permille / 10U), (unsigned long)(permille % 10U));
+    }
+    printf("  window %lu ms\r\n", (unsigned long)window_ms);
+}
+
+int ev_timer_start(ev_timer_t *timer, ev_task_t *task, uint16_t sig,
+                   uint32_t delay, uint32_t period) {
+    if (timer == NULL || task == NULL) {
+        return TW_PARAM_ERROR;
+    }
+    if (tw_is_active(&timer->tw)) {
+        tw_stop(&timer->tw);
+    }
+    timer->task = task;
+    timer->sig = sig;
+    tw_timer_init(&timer->tw, ev_timer_expired, timer);
+    return tw_start(&timer->tw, delay, period);
+}
+
+int ev_timer_stop(ev_timer_t *timer) {
+    return tw_stop(&timer->tw);
+}
+
+void ev_post_completion(int status, void *ctx) {
+    ev_completion_t *c = ctx;
+    ev_post(c->task, c->sig, (uint32_t)status, c->ptr);
+}
+
+/************************ END OF FILE *****************************************/
@@ -33,8 +33,15 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "can_driver.h"
 #include "dma.h"
+#include "dma_manager.h"
+#include "dma_mem.h"
 #include "dma_test.h"
+#include "event_loop.h"
+#include "ram_monitor.h"
+#include "spi_bus.h"
+#include "timer_wheel.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -47,6 +54,15 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* 主任务的信号 */
+#define MAIN_SIG_USART_RX (EV_SIG_USER + 0U) /* USART1 收到一帧，param 为长度 */
+#define MAIN_SIG_CMD_COPIED (EV_SIG_USER + 1U) /* 命令已由 DMA 复制出来 */
+#define MAIN_SIG_FLASH_ID (EV_SIG_USER + 2U) /* W25Q32 JEDEC ID 读取完成 */
+#define MAIN_SIG_CAN_RX (EV_SIG_USER + 3U)   /* CAN FIFO 有报文，param 为 FIFO 号 */
+
+#define MAIN_PRIO 1
+#define MAIN_QUEUE_LEN 8
+#define MAIN_CAN_BAUDRATE 500000
 
 /* USER CODE END PD */
 
@@ -58,18 +74,137 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
+static ev_task_t s_main_task;
+static ev_event_t s_main_queue[MAIN_QUEUE_LEN];
+
+/* 命令行：从 USART1 接收缓冲区复制出来，末尾补 '\0' */
+static char s_cmd[sizeof(g_usart_rx_buffer) + 1];
+static uint16_t s_cmd_len;
+
+/* JEDEC ID 读取：0x9F 后跟 3 个填充字节 */
+static const uint8_t s_flash_id_tx[4] = {0x9F, 0xFF, 0xFF, 0xFF};
+static uint8_t s_flash_id_rx[4];
+
+/* DMA / SPI 完成回调投递到主任务 */
+static ev_completion_t s_cmd_done = {&s_main_task, MAIN_SIG_CMD_COPIED, NULL};
+static ev_completion_t s_flash_done = {&s_main_task, MAIN_SIG_FLASH_ID, NULL};
 
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
+static void main_task_init(void);
+static void main_on_event(ev_task_t *task, const ev_event_t *ev);
+static void main_run_command(char *cmd);
 
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 
+/**
+ * @brief  注册主任务，把各驱动的完成通知接到主任务上
+ * @note   - USART1 接收空闲：usart_set_rx_event
+ *         - DMA 内存复制 / SPI 总线事务：完成回调 ev_post_completion
+ *         - CAN 接收 FIFO 报文挂起中断：CAN_SetRxEvent（初始化失败时不接）
+ */
+static void main_task_init(void) {
+  ev_task_init(&s_main_task, "main", MAIN_PRIO, main_on_event, NULL,
+               s_main_queue, MAIN_QUEUE_LEN);
+
+  if (dma_mem_init() != DMA_MEM_OK || spi_bus_init() != SPI_BUS_OK) {
+    printf("main: DMA channel already claimed\r\n");
+  }
+  usart_set_rx_event(&s_main_task, MAIN_SIG_USART_RX);
+
+  if (CAN_Init(MAIN_CAN_BAUDRATE, BX_CAN_MODE_NORMAL) == CAN_INIT_OK) {
+    CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+    CAN_SetRxEvent(&s_main_task, MAIN_SIG_CAN_RX);
+  } else {
+    printf("main: CAN init failed, CAN RX disabled\r\n");
+  }
+}
+
+/**
+ * @brief  主任务事件处理
+ */
+static void main_on_event(ev_task_t *task, const ev_event_t *ev) {
+  CAN_Frame_t frames[6];
+  uint8_t n;
+
+  (void)task;
+  switch (ev->sig) {
+  case MAIN_SIG_USART_RX:
+    /* 复制完成才清零接收长度：命令一问一答，复制期间不会有下一帧到达 */
+    s_cmd_len = (uint16_t)ev->param;
+    if (s_cmd_len == 0 ||
+        dma_memcpy_async(s_cmd, g_usart_rx_buffer, s_cmd_len,
+                         ev_post_completion, &s_cmd_done) != DMA_MEM_OK) {
+      g_usart_rx_len = 0;
+    }
+    break;
+
+  case MAIN_SIG_CMD_COPIED:
+    g_usart_rx_len = 0;
+    g_usart_message_ready = 0;
+    if ((int)ev->param == DMA_MEM_OK) {
+      s_cmd[s_cmd_len] = '\0';
+      main_run_command(s_cmd);
+    }
+    break;
+
+  case MAIN_SIG_FLASH_ID:
+    if ((int)ev->param == SPI_BUS_OK) {
+      printf("W25Q32 JEDEC ID: %02X %02X %02X\r\n", s_flash_id_rx[1],
+             s_flash_id_rx[2], s_flash_id_rx[3]);
+    } else {
+      printf("W25Q32 JEDEC ID: SPI error\r\n");
+    }
+    break;
+
+  case MAIN_SIG_CAN_RX:
+    /* 一次读空两个 FIFO，读完再打开中断 */
+    while ((n = CAN_ReceiveBurst(frames, 6)) > 0) {
+      for (uint8_t i = 0; i < n; i++) {
+        printf("CAN RX id=0x%03lX dlc=%u\r\n", (unsigned long)frames[i].id,
+               frames[i].dlc);
+      }
+    }
+    CAN_RxEventRearm((uint8_t)ev->param);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief  执行一条串口命令（id / stats / ram）
+ * @param  cmd: 以 '\0' 结尾的命令行，行尾的回车换行在这里去掉
+ */
+static void main_run_command(char *cmd) {
+  size_t len = strlen(cmd);
+
+  while (len > 0 && (cmd[len - 1] == '\r' || cmd[len - 1] == '\n')) {
+    cmd[--len] = '\0';
+  }
+
+  if (strcmp(cmd, "id") == 0) {
+    if (spi_xfer_async(&spi_dev_w25q32, s_flash_id_tx, s_flash_id_rx,
+                       sizeof(s_flash_id_tx), 0, ev_post_completion,
+                       &s_flash_done) != SPI_BUS_OK) {
+      printf("W25Q32 JEDEC ID: SPI bus busy\r\n");
+    }
+  } else if (strcmp(cmd, "stats") == 0) {
+    ev_report();
+  } else if (strcmp(cmd, "ram") == 0) {
+    ram_report();
+  } else if (len > 0) {
+    printf("unknown command: %s\r\n", cmd);
+  }
+}
+
 /* USER CODE END 0 */
 
 /**
@@ -108,7 +243,13 @@ int main(void) {
   MX_TIM6_Init();
   // MX_CAN_Init();
   /* USER CODE BEGIN 2 */
+  DMA_Manager_Init();
   DMA_RunAllTests();
+  ram_report();
+  tw_init(TW_TICK_HZ);
+  ram_guard_start(10);
+  ev_init();
+  main_task_init();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -117,6 +258,7 @@ int main(void) {
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    ev_run();
   }
   /* USER CODE END 3 */
 }
@@ -0,0 +1,414 @@
+/**
+ * @file    mem_pool.c
+ * @brief   固定块内存池与作用域 arena 实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mem_pool.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  空闲块（复用块本身的存储）
+ */
+typedef struct mem_free_block {
+    struct mem_free_block *next;
+} mem_free_block_t;
+
+/**
+ * @brief  尺寸类配置
+ */
+typedef struct {
+    uint8_t *base;  /* 存储 */
+    uint16_t *req;  /* 每块的请求字节数，0 表示空闲 */
+    uint16_t size;  /* 块大小 */
+    uint16_t count; /* 块数 */
+} mem_class_cfg_t;
+
+/**
+ * @brief  尺寸类运行状态
+ */
+typedef struct {
+    mem_free_block_t *free;
+    mem_pool_stats_t st;
+} mem_class_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+#define MEM_POOL_STORAGE(size, count)                                          \
+    static uint8_t s_pool_##size[(size) * (count)]                            \
+        __attribute__((aligned(MEM_ALIGN)));                                   \
+    static uint16_t s_req_##size[count];
+MEM_POOL_CLASSES(MEM_POOL_STORAGE)
+#undef MEM_POOL_STORAGE
+
+#define MEM_POOL_ENTRY(size, count) {s_pool_##size, s_req_##size, (size), (count)},
+static const mem_class_cfg_t s_cfg[] = {MEM_POOL_CLASSES(MEM_POOL_ENTRY)};
+#undef MEM_POOL_ENTRY
+
+#define MEM_CLASS_COUNT (sizeof(s_cfg) / sizeof(s_cfg[0]))
+
+static mem_class_t s_classes[MEM_CLASS_COUNT];
+static uint8_t s_ready = 0;
+static uint32_t s_invalid_frees = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint32_t mem_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void mem_unlock(uint32_t primask) {
+    if (primask == 0) {
+        __enable_irq();
+    }
+}
+
+/**
+ * @brief  空闲链表按地址顺序重建，统计清零（调用者关中断）
+ */
+static void mem_pool_build(void) {
+    for (uint32_t i = 0; i < MEM_CLASS_COUNT; i++) {
+        const mem_class_cfg_t *cfg = &s_cfg[i];
+        mem_class_t *c = &s_classes[i];
+        mem_free_block_t *next = NULL;
+
+        for (uint32_t n = cfg->count; n-- > 0;) {
+            mem_free_block_t *blk = (mem_free_block_t *)&cfg->base[n * cfg->size];
+            blk->next = next;
+            next = blk;
+            cfg->req[n] = 0;
+        }
+        c->free = next;
+        memset(&c->st, 0, sizeof(c->st));
+        c->st.block_size = cfg->size;
+        c->st.blocks = cfg->count;
+    }
+    s_invalid_frees = 0;
+    s_ready = 1;
+}
+
+/**
+ * @brief  找到 ptr 所在的尺寸类和块号
+ * @retval 尺寸类序号，不属于内存池或不在块边界上时返回 -1
+ */
+static int mem_locate(const void *ptr, uint32_t *block) {
+    const uint8_t *p = ptr;
+
+    for (uint32_t i = 0; i < MEM_CLASS_COUNT; i++) {
+        const mem_class_cfg_t *cfg = &s_cfg[i];
+        uint32_t off;
+
+        if (p < cfg->base || p >= cfg->base + (size_t)cfg->size * cfg->count) {
+            continue;
+        }
+        off = (uint32_t)(p - cfg->base);
+        if (off % cfg->size != 0) {
+            return -1;
+        }
+        *block = off / cfg->size;
+        return (int)i;
+    }
+    return -1;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void mem_pool_init(void) {
+    uint32_t primask = mem_lock();
+    mem_pool_build();
+    mem_unlock(primask);
+}
+
+void *mem_alloc(size_t size) {
+    uint32_t primask;
+    uint32_t first;
+
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* 放得下的最小尺寸类 */
+    for (first = 0; first < MEM_CLASS_COUNT && s_cfg[first].size < size; first++) {
+    }
+
+    primask = mem_lock();
+    if (!s_ready) {
+        mem_pool_build();
+    }
+    if (first == MEM_CLASS_COUNT) {
+        s_classes[MEM_CLASS_COUNT - 1].st.failures++;
+        mem_unlock(primask);
+        return NULL;
+    }
+
+    for (uint32_t i = first; i < MEM_CLASS_COUNT; i++) {
+        mem_class_t *c = &s_classes[i];
+        mem_free_block_t *blk = c->free;
+
+        if (blk == NULL) {
+            continue;
+        }
+        c->free = blk->next;
+        c->st.used++;
+        if (c->st.used > c->st.peak) {
+            c->st.peak = c->st.used;
+        }
+        c->st.allocs++;
+        if (i != first) {
+            c->st.borrowed++;
+        }
+        c->st.requested += size;
+        s_cfg[i].req[((uint8_t *)blk - s_cfg[i].base) / s_cfg[i].size] = (uint16_t)size;
+        mem_unlock(primask);
+        return blk;
+    }
+
+    s_classes[first].st.failures++;
+    mem_unlock(primask);
+    return NULL;
+}
+
+void mem_free(void *ptr) {
+    uint32_t primask;
+    uint32_t block;
+    int i;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    i = mem_locate(ptr, &block);
+    primask = mem_lock();
+    if (i < 0 || s_cfg[i].req[block] == 0) {
+        /* 不属于内存池、不在块边界上或重复释放 */
+        s_invalid_frees++;
+        mem_unlock(primask);
+        return;
+    }
+
+    mem_class_t *c = &s_classes[i];
+    mem_free_block_t *blk = ptr;
+
+    c->st.requested -= s_cfg[i].req[block];
+    s_cfg[i].req[block] = 0;
+    blk->next = c->free;
+    c->free = blk;
+    c->st.used--;
+    mem_unlock(primask);
+}
+
+void *mem_realloc(void *ptr, size_t size) {
+    uint32_t block;
+    int i;
+    void *p;
+
+    if (ptr == NULL) {
+        return mem_alloc(size);
+    }
+    if (size == 0) {
+        mem_free(ptr);
+        return NULL;
+    }
+
+    i = mem_locate(ptr, &block);
+    if (i < 0 || s_cfg[i].req[block] == 0) {
+        return NULL;
+    }
+    if (size <= s_cfg[i].size) {
+        uint32_t primask = mem_lock();
+        s_classes[i].st.requested += size;
+        s_classes[i].st.requested -= s_cfg[i].req[block];
+        s_cfg[i].req[block] = (uint16_t)size;
+        mem_unlock(primask);
+        return ptr;
+    }
+
+    p = mem_alloc(size);
+    if (p != NULL) {
+        memcpy(p, ptr, s_cfg[i].req[block]);
+        mem_free(ptr);
+    }
+    return p;
+}
+
+size_t mem_block_size(const void *ptr) {
+    uint32_t block;
+    int i = mem_locate(ptr, &block);
+
+    return i < 0 ? 0 : s_cfg[i].size;
+}
+
+uint32_t mem_pool_class_count(void) {
+    return MEM_CLASS_COUNT;
+}
+
+int mem_pool_get_stats(uint32_t index, mem_pool_stats_t *stats) {
+    uint32_t primask;
+
+    if (index >= MEM_CLASS_COUNT || stats == NULL) {
+        return MEM_PARAM_ERROR;
+    }
+    primask = mem_lock();
+    if (!s_ready) {
+        mem_pool_build();
+    }
+    *stats = s_classes[index].st;
+    mem_unlock(primask);
+    return MEM_OK;
+}
+
+uint32_t mem_pool_invalid_frees(void) {
+    return s_invalid_frees;
+}
+
+void mem_pool_reset_stats(void) {
+    uint32_t primask = mem_lock();
+
+    for (uint32_t i = 0; i < MEM_CLASS_COUNT; i++) {
+        mem_pool_stats_t *st = &s_classes[i].st;
+        st->peak = st->used;
+        st->allocs = 0;
+        st->borrowed = 0;
+        st->failures = 0;
+    }
+    s_invalid_frees = 0;
+    mem_unlock(primask);
+}
+
+void mem_pool_report(void) {
+    printf("  size  blocks  used  peak   allocs  borrowed  failures  waste%%\r\n");
+    for (uint32_t i = 0; i < MEM_CLASS_COUNT; i++) {
+        mem_pool_stats_t st;
+        uint32_t held;
+        uint32_t waste = 0;
+
+        mem_pool_get_stats(i, &st);
+        held = (uint32_t)st.used * st.block_size;
+        if (held != 0) {
+            waste = (held - st.requested) * 100U / held;
+        }
+        printf("  %4u  %6u  %4u  %4u  %7lu  %8lu  %8lu  %5lu\r\n", st.block_size,
+               st.blocks, st.used, st.peak, (unsigned long)st.allocs,
+               (unsigned long)st.borrowed, (unsigned long)st.failures,
+               (unsigned long)waste);
+    }
+    if (s_invalid_frees != 0) {
+        printf("  invalid frees: %lu\r\n", (unsigned long)s_invalid_frees);
+    }
+}
+
+int mem_arena_init(mem_arena_t *arena, void *buf, size_t size) {
+    uintptr_t start, end;
+
+    if (arena == NULL || buf == NULL) {
+        return MEM_PARAM_ERROR;
+    }
+    /* 起点按 MEM_ALIGN 对齐 */
+    start = ((uintptr_t)buf + MEM_ALIGN - 1U) & ~(uintptr_t)(MEM_ALIGN - 1U);
+    end = (uintptr_t)buf + size;
+    if (start > end) {
+        return MEM_PARAM_ERROR;
+    }
+    arena->base = (uint8_t *)start;
+    arena->size = end - start;
+    arena->used = 0;
+    arena->peak = 0;
+    arena->fails = 0;
+    return MEM_OK;
+}
+
+void *mem_arena_alloc(mem_arena_t *arena, size_t size) {
+    size_t need = (size + MEM_ALIGN - 1U) & ~(size_t)(MEM_ALIGN - 1U);
+    void *p;
+
+    if (size == 0 || need < size || need > arena->size - arena->used) {
+        arena->fails++;
+        return NULL;
+    }
+    p = &arena->base[arena->used];
+    arena->used += need;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return p;
+}
+
+size_t mem_arena_mark(const mem_arena_t *arena) {
+    return arena->used;
+}
+
+void mem_arena_release(mem_arena_t *arena, size_t mark) {
+    if (mark <= arena->used) {
+        arena->used = mark;
+    }
+}
+
+void mem_arena_reset(mem_arena_t *arena) {
+    arena->used = 0;
+}
+
+/* newlib 分配接口 -----------------------------------------------------------*/
+
+#if defined(MEM_POOL_MALLOC) && !defined(STM32_HOST_BUILD)
+#include <reent.h>
+
+void *_malloc_r(struct _reent *r, size_t size) {
+    void *p = mem_alloc(size);
+    if (p == NULL && size != 0) {
+        r->_errno = ENOMEM;
+    }
+    return p;
+}
+
+void _free_r(struct _reent *r, void *ptr) {
+    (void)r;
+    mem_free(ptr);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size) {
+    void *p = mem_realloc(ptr, size);
+    if (p == NULL && size != 0) {
+        r->_errno = ENOMEM;
+    }
+    return p;
+}
+
+void *_calloc_r(struct _reent *r, size_t n, size_t size) {
+    void *p;
+
+    if (size != 0 && n > SIZE_MAX / size) {
+        r->_errno = ENOMEM;
+        return NULL;
+    }
+    p = _malloc_r(r, n * size);
+    if (p != NULL) {
+        memset(p, 0, n * size);
+    }
+    return p;
+}
+
+void *malloc(size_t size) {
+    return _malloc_r(_REENT, size);
+}
+
+void free(void *ptr) {
+    mem_free(ptr);
+}
+
+void *realloc(void *ptr, size_t size) {
+    return _realloc_r(_REENT, ptr, size);
+}
+
+void *calloc(size_t n, size_t size) {
+    return _calloc_r(_REENT, n, size);
+}
+#endif /* MEM_POOL_MALLOC */
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,130 @@
+/**
+ * @file    ram_monitor.c
+ * @brief   栈 / 堆高水位统计与栈溢出保护字检查实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ram_monitor.h"
+#include "timer_wheel.h"
+#include <stdio.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** ram_paint_stack 在当前栈位置以下保留的字节数（本函数自己的帧） */
+#define RAM_PAINT_MARGIN 128U
+
+/** 地址按字对齐 */
+#define RAM_ALIGN_UP(a) (((a) + 3U) & ~(uintptr_t)3U)
+#define RAM_ALIGN_DOWN(a) ((a) & ~(uintptr_t)3U)
+
+/* Private variables ---------------------------------------------------------*/
+
+#if !defined(STM32_HOST_BUILD)
+extern uint8_t _end;             /* 链接脚本：堆起点 */
+extern uint8_t _estack;          /* 链接脚本：RAM 末尾 */
+extern uint32_t _Min_Stack_Size; /* 链接脚本：栈预留大小 */
+extern uint8_t *_sbrk_heap_end(void);
+#endif
+
+static volatile uint32_t s_guard_hits = 0;
+static tw_timer_t s_guard_timer;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  时间轮回调（TIM6 中断）：检查保护字
+ */
+static void ram_guard_cb(tw_timer_t *timer, void *ctx) {
+    (void)timer;
+    (void)ctx;
+    ram_guard_check();
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void ram_get_layout(ram_layout_t *layout) {
+#if defined(STM32_HOST_BUILD)
+    sim_ram_layout(&layout->heap_start, &layout->stack_limit, &layout->stack_top);
+    layout->heap_end = layout->heap_start;
+#else
+    layout->heap_start = (uintptr_t)&_end;
+    layout->heap_end = (uintptr_t)_sbrk_heap_end();
+    layout->stack_top = (uintptr_t)&_estack;
+    layout->stack_limit = layout->stack_top - (uintptr_t)&_Min_Stack_Size;
+#endif
+}
+
+void ram_get_stats(ram_stats_t *stats) {
+    ram_layout_t l;
+    uintptr_t p;
+
+    ram_get_layout(&l);
+
+    /* 堆顶以上第一个被改写的字就是栈到过的最深处 */
+    p = RAM_ALIGN_UP(l.heap_end);
+    while (p < l.stack_top && *(volatile uint32_t *)p == RAM_PAINT_PATTERN) {
+        p += 4U;
+    }
+
+    stats->stack_size = (uint32_t)(l.stack_top - l.stack_limit);
+    stats->stack_peak = (uint32_t)(l.stack_top - p);
+    stats->heap_peak = (uint32_t)(l.heap_end - l.heap_start);
+    stats->free_min = (uint32_t)(p - l.heap_end);
+    stats->guard_hits = s_guard_hits;
+}
+
+void ram_paint_stack(void) {
+    volatile uint32_t marker = 0;
+    ram_layout_t l;
+    uintptr_t end;
+
+    ram_get_layout(&l);
+    end = RAM_ALIGN_DOWN((uintptr_t)&marker) - RAM_PAINT_MARGIN;
+    for (uintptr_t p = RAM_ALIGN_UP(l.heap_end); p < end; p += 4U) {
+        *(volatile uint32_t *)p = RAM_PAINT_PATTERN;
+    }
+    (void)marker;
+}
+
+int ram_guard_check(void) {
+    ram_layout_t l;
+    const volatile uint32_t *guard;
+
+    ram_get_layout(&l);
+    guard = (const volatile uint32_t *)RAM_ALIGN_UP(l.stack_limit);
+    for (uint32_t i = 0; i < RAM_GUARD_WORDS; i++) {
+        if (guard[i] != RAM_PAINT_PATTERN) {
+            s_guard_hits++;
+            return RAM_GUARD_HIT;
+        }
+    }
+    return RAM_OK;
+}
+
+int ram_guard_start(uint32_t period_ms) {
+    uint32_t ticks = tw_ms_to_ticks(period_ms);
+
+    tw_timer_init(&s_guard_timer, ram_guard_cb, NULL);
+    if (tw_start(&s_guard_timer, ticks, ticks) != TW_OK) {
+        return RAM_ERROR;
+    }
+    return RAM_OK;
+}
+
+void ram_guard_stop(void) {
+    tw_stop(&s_guard_timer);
+}
+
+void ram_report(void) {
+    ram_stats_t st;
+
+    ram_get_stats(&st);
+    printf("RAM: stack %lu/%lu bytes peak (%ld headroom), heap %lu bytes peak, "
+           "%lu bytes never used, guard hits %lu\r\n",
+           (unsigned long)st.stack_peak, (unsigned long)st.stack_size,
+           (long)st.stack_size - (long)st.stack_peak, (unsigned long)st.heap_peak,
+           (unsigned long)st.free_min, (unsigned long)st.guard_hits);
+}
+
+/************************ END OF FILE *****************************************/
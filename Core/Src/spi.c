@@ -21,7 +21,9 @@
 #include "spi.h"
 
 /* USER CODE BEGIN 0 */
-
+/* 块传输中连续查询 SR 没有任何进展的次数上限，超过即判为超时
+   （最慢的 256 分频下一个字节约 200 次查询） */
+#define REGISTER_SPI_SPIN_LIMIT 10000U
 /* USER CODE END 0 */
 
 SPI_HandleTypeDef hspi1;
@@ -173,9 +175,9 @@ void Register_SPI_Stop(void){
  * @brief  使用寄存器方式进行SPI数据交换
  * @param  byte: 要发送的字节数据
  * @retval 接收到的字节数据
- * @note   直接操作SPI1寄存器实现数据收发
+ * @note   直接操作SPI1寄存器实现数据收发；在 RAM 中执行（RAMFUNC）
  */
-uint8_t Register_SPI_SwapByte(uint8_t byte){
+RAMFUNC uint8_t Register_SPI_SwapByte(uint8_t byte){
   // 等待发送缓冲区为空（TXE位为1表示空闲）
   while ((SPI1->SR & SPI_SR_TXE) == 0) ;
   
@@ -188,4 +190,98 @@ uint8_t Register_SPI_SwapByte(uint8_t byte){
   // 读取接收到的数据并返回
   return (uint8_t)(SPI1->DR& 0xFF);
 }
+/**
+ * @brief  块传输出错后的收尾：等待总线空闲，依次读 DR、SR 清除 RXNE 和 OVR
+ * @param  None
+ * @retval None
+ */
+static RAMFUNC void Register_SPI_Recover(void){
+  uint32_t spin = REGISTER_SPI_SPIN_LIMIT;
+
+  while ((SPI1->SR & SPI_SR_BSY) && --spin) ;
+  (void)SPI1->DR;
+  (void)SPI1->SR;
+}
+
+/**
+ * @brief  寄存器方式全双工块传输
+ * @param  tx: 发送缓冲区，NULL 时发送 0xFF 填充字节
+ * @param  rx: 接收缓冲区
+ * @param  len: 字节数
+ * @retval HAL_OK / HAL_ERROR（OVR，有字节丢失）/ HAL_TIMEOUT（SPI 无响应）
+ * @note   TXE 一置位就写入下一个字节，同时读取 RXNE，移位寄存器不留空闲；
+ *         在途字节最多 2 个（移位寄存器 + 发送缓冲），每个字节必须在下一个
+ *         字节移完之前读出。传输期间不关中断：中断占用超过一个字节时间会
+ *         产生 OVR，此时清除 OVR 并返回 HAL_ERROR，接收到的数据不完整，
+ *         调用者应拉高 CS 后重新发起整条命令；在 RAM 中执行
+ */
+RAMFUNC HAL_StatusTypeDef Register_SPI_TransferBlock(const uint8_t *tx, uint8_t *rx, uint16_t len){
+  uint16_t tx_i = 0;
+  uint16_t rx_i = 0;
+  uint32_t spin = 0;
+  uint32_t sr;
+
+  // 丢弃之前残留的接收数据和 OVR 标志
+  if (SPI1->SR & (SPI_SR_RXNE | SPI_SR_OVR)) {
+    (void)SPI1->DR;
+    (void)SPI1->SR;
+  }
+
+  while (rx_i < len) {
+    sr = SPI1->SR;
+    if (sr & SPI_SR_OVR) {
+      Register_SPI_Recover();
+      return HAL_ERROR;
+    }
+    if ((sr & SPI_SR_TXE) && tx_i < len && (uint16_t)(tx_i - rx_i) < 2) {
+      SPI1->DR = (tx != NULL) ? tx[tx_i] : 0xFF;
+      tx_i++;
+      spin = 0;
+    }
+    if (sr & SPI_SR_RXNE) {
+      rx[rx_i++] = (uint8_t)SPI1->DR;
+      spin = 0;
+    } else if (++spin > REGISTER_SPI_SPIN_LIMIT) {
+      Register_SPI_Recover();
+      return HAL_TIMEOUT;
+    }
+  }
+  return HAL_OK;
+}
+
+/**
+ * @brief  寄存器方式只发送块传输
+ * @param  tx: 发送缓冲区
+ * @param  len: 字节数
+ * @retval None
+ * @note   只轮询 TXE，不读取接收数据；结束时等待 BSY 清零并清除 OVR；
+ *         在 RAM 中执行
+ */
+RAMFUNC void Register_SPI_WriteBlock(const uint8_t *tx, uint16_t len){
+  for (uint16_t i = 0; i < len; i++) {
+    while ((SPI1->SR & SPI_SR_TXE) == 0) ;
+    SPI1->DR = tx[i];
+  }
+
+  // 等待最后一个字节移出后再交还总线
+  while ((SPI1->SR & SPI_SR_TXE) == 0) ;
+  while (SPI1->SR & SPI_SR_BSY) ;
+
+  // 依次读 DR、SR 清除 RXNE 和 OVR
+  (void)SPI1->DR;
+  (void)SPI1->SR;
+}
+
+/**
+ * @brief  寄存器方式只接收块传输
+ * @param  rx: 接收缓冲区
+ * @param  len: 字节数
+ * @retval HAL_OK / HAL_ERROR（OVR）/ HAL_TIMEOUT
+ * @note   发送 0xFF 填充字节，流水方式和出错处理同 TransferBlock；
+ *         在 RAM 中执行，从 Flash 执行时每轮循环的取指等待可能赶不上
+ *         在途的两个字节
+ */
+RAMFUNC HAL_StatusTypeDef Register_SPI_ReadBlock(uint8_t *rx, uint16_t len){
+  return Register_SPI_TransferBlock(NULL, rx, len);
+}
 /* USER CODE END 1 */
@@ -0,0 +1,381 @@
+/**
+ * @file    spi_bus.c
+ * @brief   SPI1 全双工 DMA 事务接口实现
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "spi_bus.h"
+#include "dma_manager.h"
+#include <stddef.h>
+
+/* Private macro definitions -------------------------------------------------*/
+#define SPI_BUS_RX_CH DMA_CH_DMA1_2 /* SPI1_RX */
+#define SPI_BUS_TX_CH DMA_CH_DMA1_3 /* SPI1_TX */
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  队列中的一个事务
+ */
+typedef struct {
+    const spi_device_t *dev;
+    const void *tx;
+    void *rx;
+    uint16_t len;
+    uint32_t flags;
+    spi_xfer_cb_t cb;
+    void *ctx;
+} spi_job_t;
+
+/**
+ * @brief  同步等待用的完成标志
+ */
+typedef struct {
+    volatile uint8_t done;
+    volatile int status;
+} spi_sync_t;
+
+/* Private variables ---------------------------------------------------------*/
+const spi_device_t spi_dev_w25q32 = {
+    CS_GPIO_Port, CS_Pin, SPI_BUS_MODE0, 1, 0, 0,
+};
+
+static spi_job_t s_jobs[SPI_BUS_QUEUE_LEN];
+static volatile uint8_t s_head = 0;
+static volatile uint8_t s_tail = 0;
+static volatile uint8_t s_count = 0;
+static uint8_t s_ready = 0;
+
+/** 当前 CR1 对应的设备；NULL 表示下次必须重写 CR1 并完整配置 DMA */
+static const spi_device_t *s_cur_dev = NULL;
+/** CS 仍处于有效状态的设备（SPI_XFER_KEEP_CS） */
+static const spi_device_t *s_cs_dev = NULL;
+/** spi_bus_init 之前的 CR1，deinit 时恢复给 HAL 使用 */
+static uint32_t s_saved_cr1 = 0;
+
+static const uint16_t s_fill = 0xFFFF;
+static uint16_t s_discard;
+static spi_bus_stats_t s_stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void spi_bus_start_job(void);
+static void spi_bus_on_rx(DMA_ChannelId_t ch, uint32_t events, void *ctx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  释放 CS
+ */
+static void spi_bus_cs_release(void) {
+    if (s_cs_dev != NULL) {
+        s_cs_dev->cs_port->BSRR = s_cs_dev->cs_pin;
+        s_cs_dev = NULL;
+    }
+}
+
+/**
+ * @brief  由设备描述计算 CR1（不含 SPE）
+ */
+static uint32_t spi_bus_cr1(const spi_device_t *dev) {
+    uint32_t cr1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI;
+
+    if (dev->mode & 0x01U) {
+        cr1 |= SPI_CR1_CPHA;
+    }
+    if (dev->mode & 0x02U) {
+        cr1 |= SPI_CR1_CPOL;
+    }
+    if (dev->frame16) {
+        cr1 |= SPI_CR1_DFF;
+    }
+    if (dev->lsb_first) {
+        cr1 |= SPI_CR1_LSBFIRST;
+    }
+    cr1 |= ((uint32_t)(dev->prescaler & 0x07U)) << SPI_CR1_BR_Pos;
+    return cr1;
+}
+
+/**
+ * @brief  完整配置一个 DMA 通道并启动
+ */
+static int spi_bus_dma_full(DMA_ChannelId_t ch, DMA_Direction_TypeDef dir,
+                            uint32_t mem, uint8_t mem_inc, uint16_t len,
+                            uint8_t frame16, DMA_Priority_TypeDef prio) {
+    DMA_Config_t cfg;
+
+    cfg.PeriphBaseAddr = (uint32_t)&SPI1->DR;
+    cfg.MemBaseAddr = mem;
+    cfg.Direction = dir;
+    cfg.BufferSize = len;
+    cfg.PeriphInc = DMA_Inc_Disable;
+    cfg.MemInc = mem_inc ? DMA_Inc_Enable : DMA_Inc_Disable;
+    cfg.PeriphDataSize = frame16 ? DMA_DataSize_HalfWord : DMA_DataSize_Byte;
+    cfg.MemDataSize = cfg.PeriphDataSize;
+    cfg.Mode = DMA_Mode_Normal;
+    cfg.Priority = prio;
+    cfg.M2M = false;
+
+    return DMA_StartTransfer(ch, &cfg);
+}
+
+/**
+ * @brief  启动队首事务（关中断或在 DMA 中断中调用）
+ * @note   设备不变时只用 DMA_Restart 改地址和长度，不重写 CR1 和 CCR
+ */
+static void spi_bus_start_job(void) {
+    spi_job_t *job = &s_jobs[s_tail];
+    const spi_device_t *dev = job->dev;
+    uint32_t rx_addr = job->rx ? (uint32_t)job->rx : (uint32_t)&s_discard;
+    uint32_t tx_addr = job->tx ? (uint32_t)job->tx : (uint32_t)&s_fill;
+    int ret;
+
+    /* 步骤1：换设备时先释放上一个设备保持的 CS，再重写 CR1 */
+    if (s_cs_dev != NULL && s_cs_dev != dev) {
+        spi_bus_cs_release();
+    }
+
+    if (dev != s_cur_dev) {
+        SPI1->CR1 &= ~SPI_CR1_SPE;
+        SPI1->CR1 = spi_bus_cr1(dev);
+        SPI1->CR1 |= SPI_CR1_SPE;
+        s_stats.reconfigs++;
+    }
+
+    /* 步骤2：清除残留的 RXNE/OVR */
+    (void)SPI1->DR;
+    (void)SPI1->SR;
+
+    /* 步骤3：拉低 CS */
+    dev->cs_port->BSRR = (uint32_t)dev->cs_pin << 16;
+    s_cs_dev = dev;
+
+    /* 步骤4：先启动 RX 再启动 TX，TX 请求在 TXE 置位时立即触发 */
+    if (dev == s_cur_dev) {
+        ret = DMA_Restart(SPI_BUS_RX_CH, (uint32_t)&SPI1->DR, rx_addr, job->len,
+                          job->rx ? DMA_CCR_MINC : 0U);
+        if (ret == DMA_MGR_OK) {
+            ret = DMA_Restart(SPI_BUS_TX_CH, (uint32_t)&SPI1->DR, tx_addr,
+                              job->len, job->tx ? DMA_CCR_MINC : 0U);
+        }
+    } else {
+        ret = spi_bus_dma_full(SPI_BUS_RX_CH, DMA_DIR_PeripheralSRC, rx_addr,
+                               job->rx != NULL, job->len, dev->frame16,
+                               DMA_Priority_VeryHigh);
+        if (ret == DMA_MGR_OK) {
+            ret = spi_bus_dma_full(SPI_BUS_TX_CH, DMA_DIR_PeripheralDST_Mem2Per,
+                                   tx_addr, job->tx != NULL, job->len,
+                                   dev->frame16, DMA_Priority_High);
+        }
+        s_cur_dev = dev;
+    }
+
+    if (ret != DMA_MGR_OK) {
+        /* 通道状态异常：按传输错误结束本事务 */
+        spi_bus_on_rx(SPI_BUS_RX_CH, DMA_EVT_TE, NULL);
+    }
+}
+
+/**
+ * @brief  SPI1_RX DMA 事件：最后一帧已收到，事务结束
+ */
+static void spi_bus_on_rx(DMA_ChannelId_t ch, uint32_t events, void *ctx) {
+    spi_job_t *job = &s_jobs[s_tail];
+    spi_xfer_cb_t cb;
+    void *cb_ctx;
+    int status = SPI_BUS_OK;
+
+    (void)ch;
+    (void)ctx;
+
+    if (s_count == 0) {
+        return;
+    }
+
+    /* 收到最后一帧说明 TX 早已搬完，直接关闭 TX 通道，省掉一次 TX 中断 */
+    DMA_AbortTransfer(SPI_BUS_TX_CH);
+
+    if (events & DMA_EVT_TE) {
+        DMA_AbortTransfer(SPI_BUS_RX_CH);
+        s_cur_dev = NULL; /* 下一事务完整重新配置 */
+        s_stats.errors++;
+        status = SPI_BUS_ERROR;
+    } else {
+        s_stats.xfers++;
+        s_stats.frames += job->len;
+    }
+
+    if (status != SPI_BUS_OK || (job->flags & SPI_XFER_KEEP_CS) == 0) {
+        spi_bus_cs_release();
+    }
+
+    cb = job->cb;
+    cb_ctx = job->ctx;
+    s_tail = (uint8_t)((s_tail + 1) % SPI_BUS_QUEUE_LEN);
+    s_count--;
+
+    if (s_count > 0) {
+        spi_bus_start_job();
+    }
+
+    if (cb != NULL) {
+        cb(status, cb_ctx);
+    }
+}
+
+/**
+ * @brief  同步事务的完成回调
+ */
+static void spi_bus_sync_cb(int status, void *ctx) {
+    spi_sync_t *sync = (spi_sync_t *)ctx;
+    sync->status = status;
+    sync->done = 1;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  接管 SPI1
+ */
+int spi_bus_init(void) {
+    if (DMA_Claim(SPI_BUS_RX_CH, "spi_bus_rx") != DMA_MGR_OK) {
+        return SPI_BUS_BUSY;
+    }
+    if (DMA_Claim(SPI_BUS_TX_CH, "spi_bus_tx") != DMA_MGR_OK) {
+        DMA_Release(SPI_BUS_RX_CH);
+        return SPI_BUS_BUSY;
+    }
+
+    /* 只有 RX 需要中断；TX 不注册事件，由 RX 完成时统一关闭 */
+    DMA_SetCallback(SPI_BUS_RX_CH, spi_bus_on_rx, NULL,
+                    DMA_EVT_TC | DMA_EVT_TE);
+
+    s_saved_cr1 = SPI1->CR1;
+    SPI1->CR2 |= SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+
+    s_head = 0;
+    s_tail = 0;
+    s_count = 0;
+    s_cur_dev = NULL;
+    s_cs_dev = NULL;
+    s_stats.xfers = 0;
+    s_stats.frames = 0;
+    s_stats.reconfigs = 0;
+    s_stats.errors = 0;
+    s_ready = 1;
+    return SPI_BUS_OK;
+}
+
+/**
+ * @brief  释放 SPI1
+ */
+void spi_bus_deinit(void) {
+    if (!s_ready) {
+        return;
+    }
+
+    DMA_Release(SPI_BUS_RX_CH);
+    DMA_Release(SPI_BUS_TX_CH);
+    spi_bus_cs_release();
+
+    SPI1->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CR1 = s_saved_cr1;
+
+    s_count = 0;
+    s_cur_dev = NULL;
+    s_ready = 0;
+}
+
+/**
+ * @brief  带完成回调的异步事务
+ */
+int spi_xfer_async(const spi_device_t *dev, const void *tx, void *rx,
+                   uint16_t len, uint32_t flags, spi_xfer_cb_t cb, void *ctx) {
+    uint32_t primask;
+    spi_job_t *job;
+
+    if (!s_ready || dev == NULL || dev->cs_port == NULL || len == 0) {
+        return SPI_BUS_PARAM_ERROR;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (s_count >= SPI_BUS_QUEUE_LEN) {
+        if (primask == 0) {
+            __enable_irq();
+        }
+        return SPI_BUS_QUEUE_FULL;
+    }
+
+    job = &s_jobs[s_head];
+    job->dev = dev;
+    job->tx = tx;
+    job->rx = rx;
+    job->len = len;
+    job->flags = flags;
+    job->cb = cb;
+    job->ctx = ctx;
+    s_head = (uint8_t)((s_head + 1) % SPI_BUS_QUEUE_LEN);
+    s_count++;
+
+    if (s_count == 1) {
+        spi_bus_start_job();
+    }
+
+    if (primask == 0) {
+        __enable_irq();
+    }
+    return SPI_BUS_OK;
+}
+
+/**
+ * @brief  全双工事务
+ */
+int spi_xfer(const spi_device_t *dev, const void *tx, void *rx, uint16_t len,
+             uint32_t flags) {
+    spi_sync_t sync;
+    int ret;
+
+    if (flags & SPI_XFER_ASYNC) {
+        return spi_xfer_async(dev, tx, rx, len, flags, NULL, NULL);
+    }
+
+    sync.done = 0;
+    sync.status = SPI_BUS_OK;
+    ret = spi_xfer_async(dev, tx, rx, len, flags, spi_bus_sync_cb, &sync);
+    if (ret != SPI_BUS_OK) {
+        return ret;
+    }
+
+    while (!sync.done) {
+    }
+    return sync.status;
+}
+
+/**
+ * @brief  是否还有未完成的事务
+ */
+uint8_t spi_bus_busy(void) {
+    return s_count != 0;
+}
+
+/**
+ * @brief  等待队列中所有事务完成
+ */
+void spi_bus_wait(void) {
+    while (s_count != 0) {
+    }
+}
+
+/**
+ * @brief  获取统计信息
+ */
+void spi_bus_get_stats(spi_bus_stats_t *stats) {
+    if (stats != NULL) {
+        *stats = s_stats;
+    }
+}
+
+/************************ END OF FILE *****************************************/
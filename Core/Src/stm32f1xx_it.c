@@ -37,6 +37,9 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "usart.h"
+#include "can_driver.h"
+#include "dma_manager.h"
+#include "key.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -215,8 +218,9 @@ void SysTick_Handler(void)
 
 /**
   * @brief This function handles USART1 global interrupt.
+  * @note  在 RAM 中执行（RAMFUNC），HAL_UART_IRQHandler 仍在 Flash 中
   */
-void USART1_IRQHandler(void)
+RAMFUNC void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
 
@@ -224,8 +228,12 @@ void USART1_IRQHandler(void)
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
   
+  // 只读一次 SR：读 SR 再读 DR 会同时清除 IDLE，若最后一个字节的中断
+  // 响应晚于线路空闲，先处理 RXNE 再读 SR 就会丢掉这次空闲事件
+  uint32_t sr = USART1->SR;
+
   // 检查是否接收到数据 (RXNE标志位)
-  if ((USART1->SR & USART_SR_RXNE) != 0) {
+  if ((sr & USART_SR_RXNE) != 0) {
     if (g_usart_rx_len < sizeof(g_usart_rx_buffer)) {
       // 缓冲区未满，存储接收到的字节
       g_usart_rx_buffer[g_usart_rx_len++] = (uint8_t)USART1->DR;
@@ -237,12 +245,13 @@ void USART1_IRQHandler(void)
   }
 
   // 检查线路是否空闲 (IDLE标志位)，表示一次传输结束
-  if ((USART1->SR & USART_SR_IDLE) != 0) {
-    // 清除IDLE标志：先读SR寄存器，再读DR寄存器
+  if ((sr & USART_SR_IDLE) != 0) {
+    // 清除IDLE标志：先读SR寄存器，再读DR寄存器（已读过DR时重复无害）
     volatile uint32_t temp_val = USART1->SR; // 读取状态寄存器
     temp_val = USART1->DR;                   // 读取数据寄存器完成清除序列
     (void)temp_val;                          // 避免编译器警告
     g_usart_message_ready = 1;               // 设置消息接收完成标志
+    usart_post_rx_event();                   // 通知事件循环
   }
   /* USER CODE END USART1_IRQn 1 */
 }
@@ -263,4 +272,45 @@ void TIM6_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief DMA 通道中断统一交给 dma_manager 分发
+  * @note  DMA1 通道1 由 hdma_memtomem_dma1_channel1 以轮询方式使用时不会打开中断
+  */
+void DMA1_Channel1_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_1); }
+void DMA1_Channel2_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_2); }
+void DMA1_Channel3_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_3); }
+void DMA1_Channel4_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_4); }
+void DMA1_Channel5_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_5); }
+void DMA1_Channel6_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_6); }
+void DMA1_Channel7_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA1_7); }
+void DMA2_Channel1_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA2_1); }
+void DMA2_Channel2_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA2_2); }
+void DMA2_Channel3_IRQHandler(void) { DMA_Manager_IRQHandler(DMA_CH_DMA2_3); }
+
+/**
+  * @brief DMA2 通道4/5 共用一个中断向量
+  */
+void DMA2_Channel4_5_IRQHandler(void)
+{
+  DMA_Manager_IRQHandler(DMA_CH_DMA2_4);
+  DMA_Manager_IRQHandler(DMA_CH_DMA2_5);
+}
+
+/**
+  * @brief EXTI 线交给按键驱动记录边沿（只有按键使用的线会被使能）
+  */
+void EXTI0_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+void EXTI1_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+void EXTI2_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+void EXTI3_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+void EXTI4_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+void EXTI9_5_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+void EXTI15_10_IRQHandler(void) { Key_EXTI_IRQHandler(); }
+
+/**
+  * @brief CAN 接收 FIFO0/FIFO1 报文挂起中断交给 CAN 驱动投递事件
+  */
+void USB_LP_CAN1_RX0_IRQHandler(void) { CAN_RxIRQHandler(0); }
+void CAN1_RX1_IRQHandler(void) { CAN_RxIRQHandler(1); }
+
 /* USER CODE END 1 */
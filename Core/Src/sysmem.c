@@ -60,6 +60,14 @@ void *_sbrk(ptrdiff_t incr)
   const uint8_t *max_heap = (uint8_t *)stack_limit;
   uint8_t *prev_heap_end;
 
+#if defined(MEM_POOL_MALLOC)
+  /* malloc is served by mem_pool.c; keep the RAM above _end for the stack */
+  (void)max_heap;
+  (void)incr;
+  errno = ENOMEM;
+  return (void *)-1;
+#endif
+
   /* Initialize heap end at first call */
   if (NULL == __sbrk_heap_end)
   {
@@ -85,3 +93,15 @@ void *_sbrk(ptrdiff_t incr)
   // calls to `sbrk()` are resolved to our `_sbrk()` implementation.
   __strong_reference(_sbrk, sbrk);
 #endif
+
+/**
+ * @brief Current end of the newlib heap (_end until the first _sbrk call)
+ *
+ * The heap never shrinks, so this is also its high watermark.
+ */
+uint8_t *_sbrk_heap_end(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+
+  return (NULL == __sbrk_heap_end) ? &_end : __sbrk_heap_end;
+}
@@ -93,7 +93,13 @@
 /*!< Uncomment the following line if you need to relocate the vector table
      anywhere in Flash or Sram, else the vector table is kept at the automatic
      remap of boot address selected */
-/* #define USER_VECT_TAB_ADDRESS */
+/* The bootloader (STM32F103XX_BOOT.ld) and the application behind it
+   (STM32F103XX_APP.ld, 0x08008000) are linked at different addresses, so the
+   offset is taken from the vector table the image was actually linked with.
+   The host simulator has no vector table. */
+#if !defined(STM32_HOST_BUILD)
+#define USER_VECT_TAB_ADDRESS
+#endif
 
 #if defined(USER_VECT_TAB_ADDRESS)
 /*!< Uncomment the following line if you need to relocate your vector Table
@@ -105,9 +111,10 @@
 #define VECT_TAB_OFFSET         0x00000000U     /*!< Vector Table base offset field.
                                                      This value must be a multiple of 0x200. */
 #else
+extern const uint32_t g_pfnVectors[];           /*!< startup_stm32f103xe.s */
 #define VECT_TAB_BASE_ADDRESS   FLASH_BASE      /*!< Vector Table base address field.
                                                      This value must be a multiple of 0x200. */
-#define VECT_TAB_OFFSET         0x00000000U     /*!< Vector Table base offset field.
+#define VECT_TAB_OFFSET         ((uint32_t)g_pfnVectors - FLASH_BASE) /*!< Vector Table base offset field.
                                                      This value must be a multiple of 0x200. */
 #endif /* VECT_TAB_SRAM */
 #endif /* USER_VECT_TAB_ADDRESS */
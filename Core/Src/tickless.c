@@ -0,0 +1,188 @@
+/**
+ * @file    tickless.c
+ * @brief   低功耗空闲实现
+ * @date    2026-10-18
+ *
+ * @note    长睡眠的时间基准是 TIM6 计数（TW_TIMER_COUNT_HZ）。进入时 TIM6
+ *          在当前节拍中的 start 处，ARR 改为 ticks * cpt - 1，睡满时更新
+ *          事件恰好落在第 ticks 个节拍的边界上，UIF 留给 TIM6 中断处理最后
+ *          一个节拍；提前醒来时已经过去 CNT / cpt 个节拍，余数写回 CNT。
+ *          SysTick 停止前已走过的部分和睡眠时间一起累计到微秒余数里，
+ *          满 1 ms 才加到 uwTick，长期看 HAL 节拍不丢时间。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "tickless.h"
+#include "timer_wheel.h"
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** TIM6 一个计数的微秒数 */
+#define TICKLESS_US_PER_COUNT (1000000U / TW_TIMER_COUNT_HZ)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t s_enabled = 1;
+static uint32_t s_residue_us = 0; /* 还没加到 uwTick 的时间 */
+static uint64_t s_sleep_us = 0;
+static uint32_t s_wakeups = 0;
+static uint32_t s_long_sleeps = 0;
+static uint32_t s_window_start = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  SysTick 计数时钟的每微秒周期数
+ */
+static uint32_t tickless_systick_per_us(void) {
+    uint32_t hz = SystemCoreClock;
+
+    if ((SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk) == 0) {
+        hz /= 8U;
+    }
+    return hz / 1000000U;
+}
+
+/**
+ * @brief  节拍照常运行，WFI 到下一个中断（关中断状态下调用）
+ * @note   SysTick 每毫秒唤醒一次，睡眠期间最多回绕一次
+ */
+static void tickless_short_sleep(void) {
+    uint32_t reload = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;
+    uint32_t before = SysTick->VAL;
+    uint32_t after;
+
+    __DSB();
+    __WFI();
+
+    after = SysTick->VAL;
+    s_sleep_us += ((before + reload - after) % reload) / tickless_systick_per_us();
+}
+
+/**
+ * @brief  停掉节拍睡眠 ticks 个节拍（关中断状态下调用）
+ * @note   TIM6 一直在计数，只改 ARR 和 CNT，不会因为启停丢掉预分频相位
+ */
+static void tickless_long_sleep(uint32_t ticks) {
+    uint32_t cpt = (TIM6->ARR & 0xFFFFU) + 1U;
+    uint32_t max = 0x10000U / cpt;
+    uint32_t start, now, counts, done, val;
+
+    if (ticks > max) {
+        ticks = max;
+    }
+
+    /* 关闭 ARPE，ARR 立即生效；新 ARR 不小于当前 CNT */
+    start = TIM6->CNT;
+    TIM6->CR1 &= ~TIM_CR1_ARPE;
+    TIM6->ARR = ticks * cpt - 1U;
+    if (TIM6->SR & TIM_SR_UIF) {
+        /* 节拍边界已经过去（中断挂起），恢复后先回去处理 */
+        TIM6->ARR = cpt - 1U;
+        TIM6->CR1 |= TIM_CR1_ARPE;
+        return;
+    }
+
+    /* SysTick 在当前毫秒里已走过的部分（VAL 为 0 时刚重装或刚写过 VAL） */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    val = SysTick->VAL;
+    if (val != 0) {
+        s_residue_us += ((SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) - val) /
+                        tickless_systick_per_us();
+    }
+
+    __DSB();
+    __WFI();
+
+    if (TIM6->SR & TIM_SR_UIF) {
+        /* 睡满：CNT 已从 0 重新开始，最后一个节拍留给 TIM6 中断 */
+        TIM6->ARR = cpt - 1U;
+        counts = ticks * cpt - start + TIM6->CNT;
+        done = ticks - 1U;
+    } else {
+        /* 提前唤醒：跨过的节拍边界交给 tw_advance，CNT 只保留节拍内的部分 */
+        now = TIM6->CNT;
+        done = now / cpt;
+        TIM6->CNT = now - done * cpt;
+        TIM6->ARR = cpt - 1U;
+        counts = now - start;
+    }
+    TIM6->CR1 |= TIM_CR1_ARPE;
+
+    /* 补偿 HAL 节拍后重新启动 SysTick（从完整的一个周期开始） */
+    s_residue_us += counts * TICKLESS_US_PER_COUNT;
+    uwTick += s_residue_us / 1000U;
+    s_residue_us %= 1000U;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    /* 这段时间里没有定时器到期（ticks 不超过最近的到期时间），关中断推进即可 */
+    tw_advance(done);
+
+    s_sleep_us += (uint64_t)counts * TICKLESS_US_PER_COUNT;
+    s_long_sleeps++;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void tickless_enable(int enable) {
+    s_enabled = enable ? 1 : 0;
+}
+
+void tickless_idle(void) {
+    uint32_t primask;
+    uint32_t ticks = 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (s_enabled && (TIM6->CR1 & TIM_CR1_CEN) && (TIM6->DIER & TIM_DIER_UIE)) {
+        ticks = tw_next_expiry();
+    }
+    if (ticks >= TICKLESS_MIN_TICKS) {
+        tickless_long_sleep(ticks);
+    } else {
+        tickless_short_sleep();
+    }
+    s_wakeups++;
+
+    /* 开中断后唤醒源的中断在这里执行 */
+    if (primask == 0) {
+        __enable_irq();
+    }
+}
+
+void tickless_reset_stats(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    s_sleep_us = 0;
+    s_wakeups = 0;
+    s_long_sleeps = 0;
+    s_window_start = HAL_GetTick();
+    if (primask == 0) {
+        __enable_irq();
+    }
+}
+
+void tickless_get_stats(tickless_stats_t *stats) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stats->window_ms = HAL_GetTick() - s_window_start;
+    stats->sleep_ms = (uint32_t)(s_sleep_us / 1000U);
+    stats->wakeups = s_wakeups;
+    stats->long_sleeps = s_long_sleeps;
+    if (primask == 0) {
+        __enable_irq();
+    }
+
+    if (stats->window_ms != 0) {
+        stats->residency_permille =
+            (uint32_t)((uint64_t)stats->sleep_ms * 1000U / stats->window_ms);
+        stats->wakeups_per_s =
+            (uint32_t)((uint64_t)stats->wakeups * 1000U / stats->window_ms);
+    } else {
+        stats->residency_permille = 0;
+        stats->wakeups_per_s = 0;
+    }
+}
+
+/************************ END OF FILE *****************************************/
@@ -21,6 +21,7 @@
 #include "tim.h"
 
 /* USER CODE BEGIN 0 */
+#include "timer_wheel.h"
 
 /* USER CODE END 0 */
 
@@ -100,5 +101,15 @@ void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef* tim_baseHandle)
 }
 
 /* USER CODE BEGIN 1 */
+/**
+ * @brief  定时器更新中断回调：TIM6 为软件时间轮提供节拍
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM6)
+  {
+    tw_tick();
+  }
+}
 
 /* USER CODE END 1 */
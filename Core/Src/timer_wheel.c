@@ -0,0 +1,330 @@
+/**
+ * @file    timer_wheel.c
+ * @brief   由 TIM6 驱动的分层时间轮软件定时器实现
+ * @date    2026-10-18
+ *
+ * @note    s_jiffies 是下一个要处理的节拍。定时器按到期节拍与 s_jiffies 的
+ *          差值选择层：差值小于 2^(TW_SLOT_BITS * (L + 1)) 时放入第 L 层，
+ *          槽号取到期节拍在该层的那几位。第 0 层当前槽回到 0 时，依次把
+ *          上层的当前槽取出重新插入，上层槽号不为 0 时停止。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "timer_wheel.h"
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define TW_SLOTS (1UL << TW_SLOT_BITS)
+#define TW_SLOT_MASK (TW_SLOTS - 1U)
+
+/** 第 level 层的槽号 */
+#define TW_INDEX(t, level) (((t) >> (TW_SLOT_BITS * (level))) & TW_SLOT_MASK)
+
+/* Private variables ---------------------------------------------------------*/
+static tw_timer_t *s_wheel[TW_LEVELS][TW_SLOTS];
+static volatile uint32_t s_jiffies = 0; /* 下一个要处理的节拍 */
+static volatile uint32_t s_active = 0;
+static uint32_t s_tick_hz = TW_TICK_HZ;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint32_t tw_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void tw_unlock(uint32_t primask) {
+    if (primask == 0) {
+        __enable_irq();
+    }
+}
+
+static inline void tw_link(tw_timer_t **head, tw_timer_t *timer) {
+    timer->next = *head;
+    if (timer->next != NULL) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head = timer;
+}
+
+static inline void tw_unlink(tw_timer_t *timer) {
+    *timer->pprev = timer->next;
+    if (timer->next != NULL) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+/**
+ * @brief  按到期节拍放入对应的层和槽（调用者已关中断）
+ */
+static void tw_enqueue(tw_timer_t *timer) {
+    uint32_t delta = timer->expires - s_jiffies;
+    uint32_t level;
+
+    if ((int32_t)delta < 0) {
+        /* 已经过期：放入马上要处理的槽 */
+        tw_link(&s_wheel[0][TW_INDEX(s_jiffies, 0)], timer);
+        return;
+    }
+    for (level = 0; level < TW_LEVELS - 1U; level++) {
+        if (delta < (1UL << (TW_SLOT_BITS * (level + 1U)))) {
+            break;
+        }
+    }
+    tw_link(&s_wheel[level][TW_INDEX(timer->expires, level)], timer);
+}
+
+/**
+ * @brief  把第 level 层的 index 槽重新分配到下层
+ * @retval index（为 0 时需要继续级联上一层）
+ */
+static uint32_t tw_cascade(uint32_t level, uint32_t index) {
+    tw_timer_t *list = s_wheel[level][index];
+
+    s_wheel[level][index] = NULL;
+    while (list != NULL) {
+        tw_timer_t *timer = list;
+        list = timer->next;
+        tw_enqueue(timer);
+    }
+    return index;
+}
+
+/**
+ * @brief  计算 TIM6 计数时钟
+ * @note   APB1 分频不为 1 时定时器时钟为 PCLK1 的 2 倍
+ */
+static uint32_t tw_timer_clock(void) {
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+        pclk1 *= 2U;
+    }
+    return pclk1;
+}
+
+/**
+ * @brief  第 0 层当前槽回到 0 时依次级联上层（调用者已关中断）
+ */
+static void tw_cascade_all(void) {
+    for (uint32_t level = 1; level < TW_LEVELS; level++) {
+        if (tw_cascade(level, TW_INDEX(s_jiffies, level)) != 0) {
+            break;
+        }
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+int tw_init(uint32_t tick_hz) {
+    uint32_t primask;
+    uint32_t psc = 0;
+    uint32_t arr = 0;
+
+    if (tick_hz != 0) {
+        psc = tw_timer_clock() / TW_TIMER_COUNT_HZ - 1U;
+        arr = TW_TIMER_COUNT_HZ / tick_hz - 1U;
+        if (tick_hz > TW_TIMER_COUNT_HZ / 2U || TW_TIMER_COUNT_HZ % tick_hz != 0 ||
+            psc > 0xFFFFU || arr > 0xFFFFU) {
+            return TW_PARAM_ERROR;
+        }
+    }
+
+    tw_deinit();
+
+    primask = tw_lock();
+    for (uint32_t level = 0; level < TW_LEVELS; level++) {
+        for (uint32_t i = 0; i < TW_SLOTS; i++) {
+            s_wheel[level][i] = NULL;
+        }
+    }
+    s_jiffies = 0;
+    s_active = 0;
+    s_tick_hz = tick_hz != 0 ? tick_hz : TW_TICK_HZ;
+    tw_unlock(primask);
+
+    if (tick_hz != 0) {
+        /* UG 装载 PSC / ARR（ARPE = 1），URS 避免 UG 本身产生中断 */
+        TIM6->CR1 |= TIM_CR1_URS;
+        TIM6->PSC = psc;
+        TIM6->ARR = arr;
+        TIM6->EGR = TIM_EGR_UG;
+        TIM6->SR = 0;
+        TIM6->DIER |= TIM_DIER_UIE;
+        TIM6->CR1 |= TIM_CR1_CEN;
+    }
+    return TW_OK;
+}
+
+void tw_deinit(void) {
+    TIM6->CR1 &= ~TIM_CR1_CEN;
+    TIM6->DIER &= ~TIM_DIER_UIE;
+    TIM6->SR = 0;
+}
+
+void tw_timer_init(tw_timer_t *timer, tw_callback_t cb, void *ctx) {
+    timer->next = NULL;
+    timer->pprev = NULL;
+    timer->expires = 0;
+    timer->period = 0;
+    timer->cb = cb;
+    timer->ctx = ctx;
+}
+
+int tw_start(tw_timer_t *timer, uint32_t delay, uint32_t period) {
+    uint32_t primask;
+
+    if (timer == NULL || delay > TW_MAX_TICKS || period > TW_MAX_TICKS) {
+        return TW_PARAM_ERROR;
+    }
+    if (delay == 0) {
+        delay = 1;
+    }
+
+    primask = tw_lock();
+    if (timer->pprev != NULL) {
+        tw_unlink(timer);
+    } else {
+        s_active++;
+    }
+    /* 第 delay 次 tw_tick() 处理的节拍 */
+    timer->expires = s_jiffies + delay - 1U;
+    timer->period = period;
+    tw_enqueue(timer);
+    tw_unlock(primask);
+    return TW_OK;
+}
+
+int tw_stop(tw_timer_t *timer) {
+    uint32_t primask;
+    int ret = TW_NOT_ACTIVE;
+
+    primask = tw_lock();
+    if (timer->pprev != NULL) {
+        tw_unlink(timer);
+        s_active--;
+        ret = TW_OK;
+    }
+    tw_unlock(primask);
+    return ret;
+}
+
+int tw_is_active(const tw_timer_t *timer) {
+    return timer->pprev != NULL;
+}
+
+uint32_t tw_remaining(const tw_timer_t *timer) {
+    uint32_t primask;
+    uint32_t ret = 0;
+
+    primask = tw_lock();
+    if (timer->pprev != NULL) {
+        ret = timer->expires - s_jiffies + 1U;
+    }
+    tw_unlock(primask);
+    return ret;
+}
+
+void tw_tick(void) {
+    tw_timer_t *list;
+    uint32_t primask;
+    uint32_t index;
+
+    primask = tw_lock();
+    index = TW_INDEX(s_jiffies, 0);
+    if (index == 0) {
+        tw_cascade_all();
+    }
+    s_jiffies++;
+
+    /* 整个槽挂到局部链表头上，回调中停止其中的定时器也能正确摘除 */
+    list = s_wheel[0][index];
+    s_wheel[0][index] = NULL;
+    if (list != NULL) {
+        list->pprev = &list;
+    }
+
+    while (list != NULL) {
+        tw_timer_t *timer = list;
+
+        tw_unlink(timer);
+        if (timer->period != 0) {
+            timer->expires += timer->period;
+            tw_enqueue(timer);
+        } else {
+            s_active--;
+        }
+        tw_unlock(primask);
+
+        if (timer->cb != NULL) {
+            timer->cb(timer, timer->ctx);
+        }
+
+        primask = tw_lock();
+    }
+    tw_unlock(primask);
+}
+
+void tw_advance(uint32_t ticks) {
+    uint32_t primask;
+
+    while (ticks > 0) {
+        primask = tw_lock();
+        /* 空槽且不需要级联：只推进计数 */
+        while (ticks > 0 && TW_INDEX(s_jiffies, 0) != 0 &&
+               s_wheel[0][TW_INDEX(s_jiffies, 0)] == NULL) {
+            s_jiffies++;
+            ticks--;
+        }
+        tw_unlock(primask);
+        if (ticks > 0) {
+            tw_tick();
+            ticks--;
+        }
+    }
+}
+
+uint32_t tw_next_expiry(void) {
+    uint32_t primask;
+    uint32_t best = TW_MAX_TICKS;
+
+    primask = tw_lock();
+    for (uint32_t level = 0; level < TW_LEVELS; level++) {
+        for (uint32_t i = 0; i < TW_SLOTS; i++) {
+            for (tw_timer_t *t = s_wheel[level][i]; t != NULL; t = t->next) {
+                uint32_t left = t->expires - s_jiffies;
+                if ((int32_t)left < 0) {
+                    left = 0;
+                }
+                if (left + 1U < best) {
+                    best = left + 1U;
+                }
+            }
+        }
+    }
+    tw_unlock(primask);
+    return best;
+}
+
+uint32_t tw_now(void) {
+    return s_jiffies;
+}
+
+uint32_t tw_active_count(void) {
+    return s_active;
+}
+
+uint32_t tw_ms_to_ticks(uint32_t ms) {
+    uint64_t ticks = ((uint64_t)ms * s_tick_hz + 999U) / 1000U;
+
+    if (ticks == 0) {
+        return 1;
+    }
+    return ticks > TW_MAX_TICKS ? TW_MAX_TICKS : (uint32_t)ticks;
+}
+
+/************************ END OF FILE *****************************************/
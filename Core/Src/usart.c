@@ -25,6 +25,10 @@ uint8_t g_usart_rx_buffer[100] = {0};
 volatile uint8_t g_usart_rx_len = 0;
 volatile uint8_t g_usart_message_ready = 0;
 
+/* 接收空闲时投递事件的目标（NULL 表示不投递） */
+static ev_task_t *s_rx_task = NULL;
+static uint16_t s_rx_sig = 0;
+
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart1;
@@ -254,4 +258,22 @@ void Driver_USART1_ReceiveString(uint8_t buff[], uint8_t *len) {
     i++;
   }
 }
+/**
+ * @brief  设置 USART1 接收空闲事件的目标
+ * @param  task: 目标任务，NULL 表示不投递
+ * @param  sig: 信号，事件 param 为 g_usart_rx_len，ptr 为 g_usart_rx_buffer
+ */
+void usart_set_rx_event(ev_task_t *task, uint16_t sig) {
+  s_rx_sig = sig;
+  s_rx_task = task;
+}
+
+/**
+ * @brief  接收空闲（一条消息结束）：由 USART1_IRQHandler 调用
+ */
+void usart_post_rx_event(void) {
+  if (s_rx_task != NULL) {
+    ev_post(s_rx_task, s_rx_sig, g_usart_rx_len, g_usart_rx_buffer);
+  }
+}
 /* USER CODE END 1 */
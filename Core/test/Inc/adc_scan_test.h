@@ -0,0 +1,17 @@
+/**
+ * @file    adc_scan_test.h
+ * @brief   ADC 扫描采集测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __ADC_SCAN_TEST_H__
+#define __ADC_SCAN_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void ADC_Scan_RunAllTests(void);
+
+#endif /* __ADC_SCAN_TEST_H__ */
@@ -0,0 +1,17 @@
+/**
+ * @file    bench_test.h
+ * @brief   基准测试框架自检头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __BENCH_TEST_H__
+#define __BENCH_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void Bench_RunAllTests(void);
+
+#endif /* __BENCH_TEST_H__ */
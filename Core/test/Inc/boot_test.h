@@ -0,0 +1,17 @@
+/**
+ * @file    boot_test.h
+ * @brief   串口升级引导程序测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __BOOT_TEST_H__
+#define __BOOT_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void BOOT_RunAllTests(void);
+
+#endif /* __BOOT_TEST_H__ */
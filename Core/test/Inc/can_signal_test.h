@@ -0,0 +1,17 @@
+/**
+ * @file    can_signal_test.h
+ * @brief   CAN 信号打包 / PDO 映射层测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __CAN_SIGNAL_TEST_H__
+#define __CAN_SIGNAL_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void CAN_Signal_RunAllTests(void);
+
+#endif /* __CAN_SIGNAL_TEST_H__ */
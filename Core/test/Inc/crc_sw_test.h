@@ -0,0 +1,17 @@
+/**
+ * @file    crc_sw_test.h
+ * @brief   软件 CRC 库测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __CRC_SW_TEST_H__
+#define __CRC_SW_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void CRC_SW_RunAllTests(void);
+
+#endif /* __CRC_SW_TEST_H__ */
@@ -0,0 +1,17 @@
+/**
+ * @file    crc_test.h
+ * @brief   CRC 计算单元驱动测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __CRC_TEST_H__
+#define __CRC_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void CRC_RunAllTests(void);
+
+#endif /* __CRC_TEST_H__ */
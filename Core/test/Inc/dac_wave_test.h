@@ -0,0 +1,17 @@
+/**
+ * @file    dac_wave_test.h
+ * @brief   DAC 波形发生器测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __DAC_WAVE_TEST_H__
+#define __DAC_WAVE_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void DAC_Wave_RunAllTests(void);
+
+#endif /* __DAC_WAVE_TEST_H__ */
@@ -0,0 +1,17 @@
+/**
+ * @file    dma_chain_test.h
+ * @brief   DMA 描述符链测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __DMA_CHAIN_TEST_H__
+#define __DMA_CHAIN_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void DMA_Chain_RunAllTests(void);
+
+#endif /* __DMA_CHAIN_TEST_H__ */
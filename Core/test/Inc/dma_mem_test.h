@@ -0,0 +1,17 @@
+/**
+ * @file    dma_mem_test.h
+ * @brief   异步 DMA memcpy/memset 测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __DMA_MEM_TEST_H__
+#define __DMA_MEM_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void DMA_Mem_RunAllTests(void);
+
+#endif /* __DMA_MEM_TEST_H__ */
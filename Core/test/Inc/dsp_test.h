@@ -0,0 +1,17 @@
+/**
+ * @file    dsp_test.h
+ * @brief   定点 DSP 核测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __DSP_TEST_H__
+#define __DSP_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void DSP_RunAllTests(void);
+
+#endif /* __DSP_TEST_H__ */
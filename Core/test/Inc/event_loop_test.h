@@ -0,0 +1,17 @@
+/**
+ * @file    event_loop_test.h
+ * @brief   协作式事件循环测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __EVENT_LOOP_TEST_H__
+#define __EVENT_LOOP_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void Event_Loop_RunAllTests(void);
+
+#endif /* __EVENT_LOOP_TEST_H__ */
@@ -0,0 +1,17 @@
+/**
+ * @file    key_test.h
+ * @brief   按键驱动测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __KEY_TEST_H__
+#define __KEY_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void Key_RunAllTests(void);
+
+#endif /* __KEY_TEST_H__ */
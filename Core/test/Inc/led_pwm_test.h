@@ -0,0 +1,17 @@
+/**
+ * @file    led_pwm_test.h
+ * @brief   LED PWM 驱动测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __LED_PWM_TEST_H__
+#define __LED_PWM_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void LED_PWM_RunAllTests(void);
+
+#endif /* __LED_PWM_TEST_H__ */
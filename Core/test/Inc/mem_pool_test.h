@@ -0,0 +1,17 @@
+/**
+ * @file    mem_pool_test.h
+ * @brief   内存池测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __MEM_POOL_TEST_H__
+#define __MEM_POOL_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void Mem_Pool_RunAllTests(void);
+
+#endif /* __MEM_POOL_TEST_H__ */
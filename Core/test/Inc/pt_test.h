@@ -0,0 +1,17 @@
+/**
+ * @file    pt_test.h
+ * @brief   无栈协程测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __PT_TEST_H__
+#define __PT_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void PT_RunAllTests(void);
+
+#endif /* __PT_TEST_H__ */
@@ -0,0 +1,17 @@
+/**
+ * @file    ram_monitor_test.h
+ * @brief   栈 / 堆高水位测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __RAM_MONITOR_TEST_H__
+#define __RAM_MONITOR_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void RAM_Monitor_RunAllTests(void);
+
+#endif /* __RAM_MONITOR_TEST_H__ */
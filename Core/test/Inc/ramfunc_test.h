@@ -0,0 +1,17 @@
+/**
+ * @file    ramfunc_test.h
+ * @brief   RAM 中执行函数的测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __RAMFUNC_TEST_H__
+#define __RAMFUNC_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void RAMFunc_RunAllTests(void);
+
+#endif /* __RAMFUNC_TEST_H__ */
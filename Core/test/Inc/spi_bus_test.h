@@ -0,0 +1,17 @@
+/**
+ * @file    spi_bus_test.h
+ * @brief   SPI1 DMA 事务接口测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __SPI_BUS_TEST_H__
+#define __SPI_BUS_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void SPI_Bus_RunAllTests(void);
+
+#endif /* __SPI_BUS_TEST_H__ */
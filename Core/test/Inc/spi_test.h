@@ -61,8 +61,8 @@ int SPI_Test_HAL_Functions(void);
 int SPI_Test_Register_Functions(void);
 
 /**
- * @brief  SPI性能对比测试（HAL vs 寄存器）
- * @note   比较两种方法的速度差异
+ * @brief  SPI性能对比测试（HAL vs 寄存器逐字节 vs 寄存器块传输）
+ * @note   以 字节/秒 报告三种方式的速率
  */
 void SPI_Test_Performance_Compare(void);
 
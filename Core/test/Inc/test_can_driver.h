@@ -25,6 +25,7 @@ extern "C" {
  *          - 环回收发测试
  *          - 状态查询测试
  *          - 边界条件测试
+ *          - TTCM 时间戳与周期调度测试
  *
  * @retval  0: 所有测试通过
  *          -1: 有测试失败
@@ -0,0 +1,17 @@
+/**
+ * @file    tickless_test.h
+ * @brief   低功耗空闲测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __TICKLESS_TEST_H__
+#define __TICKLESS_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void Tickless_RunAllTests(void);
+
+#endif /* __TICKLESS_TEST_H__ */
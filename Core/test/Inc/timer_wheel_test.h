@@ -0,0 +1,17 @@
+/**
+ * @file    timer_wheel_test.h
+ * @brief   分层时间轮软件定时器测试头文件
+ * @date    2026-10-18
+ */
+
+#ifndef __TIMER_WHEEL_TEST_H__
+#define __TIMER_WHEEL_TEST_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* Exported functions ------------------------------------------------------- */
+void Timer_Wheel_RunAllTests(void);
+
+#endif /* __TIMER_WHEEL_TEST_H__ */
@@ -0,0 +1,371 @@
+/**
+ * @file    adc_scan_test.c
+ * @brief   ADC 扫描采集测试文件
+ * @note    1. 统计核：已知序列的最小 / 最大 / 均值 / RMS / 交流 RMS
+ *          2. 单 ADC 双缓冲：按块回调的个数与节拍，块内交错顺序，块与块
+ *             之间采样连续不丢
+ *          3. 双 ADC 规则同步：一个字里 ADC1 / ADC2 的结果各自统计
+ *          4. 参数检查、DMA 通道被占用、停止后不再回调；dma_mem 已初始化
+ *             时 adc_scan_init 仍然成功（通道不冲突）
+ *          仿真中通道输入为回放波形：通道 0 为 host/data/adc_sine.txt 中的
+ *          正弦，通道 1 为内存中的锯齿；目标板上不检查采样值
+ */
+
+#include "adc_scan_test.h"
+#include "adc_scan.h"
+#include "dma_manager.h"
+#include "dma_mem.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_RATE_HZ 20000U
+#define TEST_BLOCK_SCANS 60U /* 正弦 3 个周期 */
+#define TEST_BLOCK_MS (1000U * TEST_BLOCK_SCANS / TEST_RATE_HZ)
+#define TEST_BLOCKS 10U
+#define TEST_CHANNELS 2U
+#define TEST_RAMP_LEN 1000U
+#define TEST_RAMP_STEP 4U
+#define TEST_ADC2_LEVEL 3000U
+#define TEST_VREFINT 1489U
+
+/** 正弦波形文件的统计（2048 + 1000 * sin） */
+#define TEST_SINE_MIN 1048U
+#define TEST_SINE_MAX 3048U
+#define TEST_SINE_MEAN 2048U
+#define TEST_SINE_AC_RMS 707U
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint16_t s_buf16[2U * TEST_BLOCK_SCANS * TEST_CHANNELS];
+static uint32_t s_buf32[2U * TEST_BLOCK_SCANS * TEST_CHANNELS];
+static uint16_t s_ramp[TEST_RAMP_LEN];
+
+/* 块回调记录（中断上下文写入） */
+static volatile uint32_t s_calls;
+static volatile uint32_t s_order_errors;  /* 块序号不连续 */
+static volatile uint32_t s_sample_errors; /* 锯齿通道不连续或统计不符 */
+static uint32_t s_ramp_next;
+static adc_stats_t s_last[4]; /* ADC1 通道 0/1，ADC2 通道 0/1 */
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void test_reset(void);
+static void test_on_block(const adc_scan_block_t *block, void *ctx);
+static int test_stats_kernel(void);
+static int test_single(void);
+static int test_dual(void);
+static int test_errors(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 ADC 扫描采集测试
+ */
+void ADC_Scan_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         ADC Scan Test Suite            \r\n");
+  printf("========================================\r\n");
+
+  if (adc_scan_init() != ADC_SCAN_OK) {
+    printf("  [FAIL] adc_scan_init (DMA channel already claimed)\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+#if defined(STM32_HOST_BUILD)
+  for (uint32_t i = 0; i < TEST_RAMP_LEN; i++) {
+    s_ramp[i] = (uint16_t)(i * TEST_RAMP_STEP);
+  }
+#endif
+
+  int result1 = test_stats_kernel();
+  int result2 = test_single();
+  int result3 = test_dual();
+  int result4 = test_errors();
+
+  adc_scan_deinit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  清空回调记录，波形从头回放
+ */
+static void test_reset(void) {
+  s_calls = 0;
+  s_order_errors = 0;
+  s_sample_errors = 0;
+  s_ramp_next = 0;
+#if defined(STM32_HOST_BUILD)
+  if (sim_adc_load(1, 0, HOST_DATA_DIR "/adc_sine.txt") != 20) {
+    printf("  [FAIL] cannot load adc_sine.txt\r\n");
+    s_sample_errors++;
+  }
+  sim_adc_waveform(1, 1, s_ramp, TEST_RAMP_LEN);
+#endif
+}
+
+/**
+ * @brief  块回调：检查序号与锯齿通道的连续性，记录统计
+ */
+static void test_on_block(const adc_scan_block_t *block, void *ctx) {
+  (void)ctx;
+
+  if (block->index != s_calls) {
+    s_order_errors++;
+  }
+  s_calls++;
+  if (block->channels != TEST_CHANNELS) {
+    return;
+  }
+
+  adc_scan_block_stats(block, 0, 1, &s_last[0]);
+  adc_scan_block_stats(block, 1, 1, &s_last[1]);
+  if (block->dual) {
+    adc_scan_block_stats(block, 0, 2, &s_last[2]);
+    adc_scan_block_stats(block, 1, 2, &s_last[3]);
+  }
+
+#if defined(STM32_HOST_BUILD)
+  for (uint32_t s = 0; s < block->scans; s++) {
+    uint16_t v;
+
+    if (block->dual) {
+      v = (uint16_t)((const uint32_t *)block->data)[s * block->channels + 1U];
+    } else {
+      v = ((const uint16_t *)block->data)[s * block->channels + 1U];
+    }
+    if (v != s_ramp_next) {
+      s_sample_errors++;
+    }
+    s_ramp_next = (v + TEST_RAMP_STEP) % (TEST_RAMP_LEN * TEST_RAMP_STEP);
+  }
+  if (s_last[0].min != TEST_SINE_MIN || s_last[0].max != TEST_SINE_MAX ||
+      s_last[0].mean != TEST_SINE_MEAN || s_last[0].ac_rms != TEST_SINE_AC_RMS) {
+    s_sample_errors++;
+  }
+#endif
+}
+
+/**
+ * @brief  测试1：统计核
+ */
+static int test_stats_kernel(void) {
+  static const uint16_t data[8] = {100, 900, 100, 900, 100, 900, 100, 900};
+  static const uint16_t flat[3] = {4095, 4095, 4095};
+  adc_stats_t st, odd, one;
+  adc_stats_t none = {1, 1, 1, 1, 1};
+
+  printf("\r\n[TEST] Block statistics kernel\r\n");
+
+  adc_stats_compute(data, 8, 1, &st);
+  adc_stats_compute(data + 1, 4, 2, &odd);
+  adc_stats_compute(flat, 3, 1, &one);
+  adc_stats_compute(data, 0, 1, &none);
+
+  /* 方波 500 ± 400：RMS = sqrt(410000) = 640.3 */
+  if (st.min != 100 || st.max != 900 || st.mean != 500 || st.rms != 640 ||
+      st.ac_rms != 400) {
+    printf("  [FAIL] square: %u/%u/%u/%u/%u\r\n", st.min, st.max, st.mean, st.rms,
+           st.ac_rms);
+    return TEST_FAIL;
+  }
+  if (odd.min != 900 || odd.max != 900 || odd.ac_rms != 0 || one.rms != 4095 ||
+      one.ac_rms != 0) {
+    printf("  [FAIL] stride / constant input\r\n");
+    return TEST_FAIL;
+  }
+  if (none.min != 0 || none.max != 0 || none.mean != 0 || none.rms != 0 ||
+      none.ac_rms != 0) {
+    printf("  [FAIL] empty input not zeroed\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] mean %u, rms %u, ac_rms %u\r\n", st.mean, st.rms, st.ac_rms);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试2：单 ADC，两通道扫描，双缓冲按块回调
+ */
+static int test_single(void) {
+  static const uint8_t channels[TEST_CHANNELS] = {0, 1};
+  adc_scan_config_t cfg = {0};
+  DMA_ChannelStats_t st;
+  uint32_t blocks;
+
+  printf("\r\n[TEST] Single ADC scan, double-buffered blocks\r\n");
+
+  test_reset();
+  cfg.channels = channels;
+  cfg.num_channels = TEST_CHANNELS;
+  cfg.sample_time = 1; /* 7.5 周期 */
+  cfg.block_scans = TEST_BLOCK_SCANS;
+  cfg.rate_hz = TEST_RATE_HZ;
+  cfg.buffer = s_buf16;
+  cfg.cb = test_on_block;
+  if (adc_scan_start(&cfg) != ADC_SCAN_OK || adc_scan_start(&cfg) != ADC_SCAN_BUSY) {
+    printf("  [FAIL] adc_scan_start\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay(TEST_BLOCKS * TEST_BLOCK_MS + 1U);
+  adc_scan_stop();
+
+  blocks = s_calls;
+  DMA_GetStats(ADC_SCAN_DMA_CHANNEL, &st);
+  if (blocks < TEST_BLOCKS - 1U || blocks > TEST_BLOCKS + 1U ||
+      adc_scan_blocks() != blocks || adc_scan_overruns() != 0 || s_order_errors != 0 ||
+      st.half + st.completed < blocks) {
+    printf("  [FAIL] %lu blocks in %lu ms (expected %lu), %lu out of order\r\n",
+           (unsigned long)blocks, (unsigned long)(TEST_BLOCKS * TEST_BLOCK_MS),
+           (unsigned long)TEST_BLOCKS, (unsigned long)s_order_errors);
+    return TEST_FAIL;
+  }
+  if (s_sample_errors != 0) {
+    printf("  [FAIL] %lu sample errors (min %u max %u mean %u ac_rms %u)\r\n",
+           (unsigned long)s_sample_errors, s_last[0].min, s_last[0].max, s_last[0].mean,
+           s_last[0].ac_rms);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu blocks of %u scans, sine mean %u ac_rms %u, ramp continuous\r\n",
+         (unsigned long)blocks, (unsigned)TEST_BLOCK_SCANS, s_last[0].mean,
+         s_last[0].ac_rms);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试3：双 ADC 规则同步
+ */
+static int test_dual(void) {
+  static const uint8_t channels[TEST_CHANNELS] = {0, 1};
+  static const uint8_t channels2[TEST_CHANNELS] = {5, 17};
+  adc_scan_config_t cfg = {0};
+
+  printf("\r\n[TEST] Dual ADC regular simultaneous\r\n");
+
+  test_reset();
+#if defined(STM32_HOST_BUILD)
+  {
+    static const uint16_t level = TEST_ADC2_LEVEL;
+    sim_adc_waveform(2, 5, &level, 1);
+  }
+#endif
+  cfg.channels = channels;
+  cfg.channels2 = channels2;
+  cfg.num_channels = TEST_CHANNELS;
+  cfg.sample_time = 1;
+  cfg.block_scans = TEST_BLOCK_SCANS;
+  cfg.rate_hz = TEST_RATE_HZ;
+  cfg.buffer = s_buf32;
+  cfg.cb = test_on_block;
+  if (adc_scan_start(&cfg) != ADC_SCAN_OK) {
+    printf("  [FAIL] adc_scan_start\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay(4U * TEST_BLOCK_MS + 1U);
+  adc_scan_stop();
+
+  if (s_calls < 3U || s_order_errors != 0 || s_sample_errors != 0) {
+    printf("  [FAIL] %lu blocks, %lu sample errors\r\n", (unsigned long)s_calls,
+           (unsigned long)s_sample_errors);
+    return TEST_FAIL;
+  }
+#if defined(STM32_HOST_BUILD)
+  if (s_last[2].min != TEST_ADC2_LEVEL || s_last[2].max != TEST_ADC2_LEVEL ||
+      s_last[3].mean != TEST_VREFINT || s_last[3].ac_rms != 0) {
+    printf("  [FAIL] ADC2 channel 5: %u..%u, VREFINT %u\r\n", s_last[2].min,
+           s_last[2].max, s_last[3].mean);
+    return TEST_FAIL;
+  }
+#endif
+
+  printf("  [PASS] %lu blocks, ADC1 sine + ramp, ADC2 level %u\r\n",
+         (unsigned long)s_calls, s_last[2].mean);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试4：参数检查、通道占用、停止
+ */
+static int test_errors(void) {
+  static const uint8_t channels[1] = {17};
+  static const uint8_t bad[1] = {18};
+  adc_scan_config_t cfg = {0};
+  uint32_t calls;
+
+  printf("\r\n[TEST] Parameter checks, channel claim and stop\r\n");
+
+  cfg.channels = channels;
+  cfg.num_channels = 1;
+  cfg.block_scans = TEST_BLOCK_SCANS;
+  cfg.rate_hz = TEST_RATE_HZ;
+  cfg.buffer = s_buf16;
+  cfg.cb = test_on_block;
+
+  cfg.num_channels = 0;
+  int r1 = adc_scan_start(&cfg);
+  cfg.num_channels = 1;
+  cfg.channels = bad;
+  int r2 = adc_scan_start(&cfg);
+  cfg.channels = channels;
+  cfg.block_scans = 40000U; /* 2 × 40000 个元素超出 CNDTR */
+  int r3 = adc_scan_start(&cfg);
+  cfg.block_scans = TEST_BLOCK_SCANS;
+  cfg.cb = NULL;
+  int r4 = adc_scan_start(&cfg);
+  cfg.cb = test_on_block;
+  if (r1 != ADC_SCAN_PARAM_ERROR || r2 != ADC_SCAN_PARAM_ERROR ||
+      r3 != ADC_SCAN_PARAM_ERROR || r4 != ADC_SCAN_PARAM_ERROR || adc_scan_running()) {
+    printf("  [FAIL] bad configs returned %d/%d/%d/%d\r\n", r1, r2, r3, r4);
+    return TEST_FAIL;
+  }
+
+  /* 停止后不再回调 */
+  s_calls = 0;
+  if (adc_scan_start(&cfg) != ADC_SCAN_OK) {
+    printf("  [FAIL] adc_scan_start\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay(2U * TEST_BLOCK_MS + 1U);
+  adc_scan_stop();
+  calls = s_calls;
+  HAL_Delay(2U * TEST_BLOCK_MS);
+  if (calls == 0 || s_calls != calls || adc_scan_running()) {
+    printf("  [FAIL] %lu blocks before stop, %lu after\r\n", (unsigned long)calls,
+           (unsigned long)(s_calls - calls));
+    return TEST_FAIL;
+  }
+
+  /* DMA1 通道 1 被其他驱动占用时初始化失败 */
+  adc_scan_deinit();
+  if (DMA_Claim(ADC_SCAN_DMA_CHANNEL, "other") != DMA_MGR_OK ||
+      adc_scan_init() != ADC_SCAN_BUSY) {
+    printf("  [FAIL] init with DMA1 channel 1 claimed\r\n");
+    return TEST_FAIL;
+  }
+  DMA_Release(ADC_SCAN_DMA_CHANNEL);
+
+  /* 应用里 main_task_init 先初始化 dma_mem，ADC1 的通道不能被它占用 */
+  int rm = dma_mem_init();
+  int ra = adc_scan_init();
+  if (rm == DMA_MEM_OK) {
+    dma_mem_deinit();
+  }
+  if (rm != DMA_MEM_OK || ra != ADC_SCAN_OK) {
+    printf("  [FAIL] dma_mem_init %d, adc_scan_init %d after release\r\n", rm, ra);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] bad configs rejected, %lu blocks then silence, claim respected\r\n",
+         (unsigned long)calls);
+  return TEST_PASS;
+}
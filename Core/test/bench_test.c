@@ -0,0 +1,176 @@
+/**
+ * @file    bench_test.c
+ * @brief   基准测试框架自检
+ * @note    1. 统计：奇偶样本数的中位数、最小/最大值、速率换算
+ *          2. 开销校准：空函数扣除开销后接近 0
+ *          3. 线性度：2 倍工作量的中位数约为 2 倍
+ *          4. 参数检查
+ */
+
+#include "bench_test.h"
+#include "bench.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int test_bench_stats(void);
+static int test_bench_overhead(void);
+static int test_bench_linearity(void);
+static int test_bench_params(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行基准测试框架自检
+ */
+void Bench_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("      Benchmark Harness Self Test       \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+
+  int result1 = test_bench_stats();
+  int result2 = test_bench_overhead();
+  int result3 = test_bench_linearity();
+  int result4 = test_bench_params();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  空函数
+ */
+static void bench_fn_empty(void *arg) {
+  (void)arg;
+}
+
+/**
+ * @brief  固定次数的忙循环，次数由 arg 指定
+ */
+static void bench_fn_spin(void *arg) {
+  uint32_t n = *(const uint32_t *)arg;
+  for (volatile uint32_t i = 0; i < n; i++) {
+  }
+}
+
+/**
+ * @brief  统计计算
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_bench_stats(void) {
+  uint32_t odd[5] = {5, 1, 9, 3, 7};
+  uint32_t even[4] = {4, 1, 3, 2};
+  bench_result_t r1, r2;
+
+  printf("[TEST] Statistics\r\n");
+
+  bench_stats("odd", odd, 5, 100, &r1);
+  bench_stats("even", even, 4, 0, &r2);
+
+  if (r1.min != 1 || r1.median != 5 || r1.max != 9 || r1.reps != 5 ||
+      r1.bytes_per_s != (uint32_t)((uint64_t)100 * bench_freq() / 5) ||
+      r2.min != 1 || r2.median != 2 || r2.max != 4 || r2.bytes_per_s != 0) {
+    printf("  [FAIL] odd %lu/%lu/%lu even %lu/%lu/%lu\r\n",
+           (unsigned long)r1.min, (unsigned long)r1.median,
+           (unsigned long)r1.max, (unsigned long)r2.min,
+           (unsigned long)r2.median, (unsigned long)r2.max);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] min/median/max and throughput\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  开销校准
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_bench_overhead(void) {
+  bench_config_t cfg = {"empty", 2, 15, 0, BENCH_FLAG_IRQ_OFF};
+  bench_result_t r;
+
+  printf("[TEST] Overhead calibration\r\n");
+
+  bench_run(&cfg, bench_fn_empty, NULL, &r);
+  bench_report_header();
+  bench_report(&r);
+
+  /* 扣除开销后，空函数的最小值应为 0，中位数只剩零星抖动 */
+  if (r.min != 0 || r.median > r.overhead / 2 + 2) {
+    printf("  [FAIL] overhead=%lu residual min=%lu median=%lu %s\r\n",
+           (unsigned long)r.overhead, (unsigned long)r.min,
+           (unsigned long)r.median, bench_unit());
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] overhead %lu %s subtracted\r\n", (unsigned long)r.overhead,
+         bench_unit());
+  return TEST_PASS;
+}
+
+/**
+ * @brief  线性度：工作量加倍，中位数在 1.8 - 2.2 倍之间
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_bench_linearity(void) {
+  bench_config_t cfg = {"spin", 1, 9, 0, BENCH_FLAG_IRQ_OFF};
+  bench_result_t r1, r2;
+  uint32_t n1 = 1000, n2 = 2000;
+
+  printf("[TEST] Linearity\r\n");
+
+  cfg.name = "spin_1000";
+  bench_run(&cfg, bench_fn_spin, &n1, &r1);
+  cfg.name = "spin_2000";
+  bench_run(&cfg, bench_fn_spin, &n2, &r2);
+  bench_report(&r1);
+  bench_report(&r2);
+
+  if (r1.median == 0 || r2.median * 10 < r1.median * 18 ||
+      r2.median * 10 > r1.median * 22) {
+    printf("  [FAIL] %lu vs %lu\r\n", (unsigned long)r1.median,
+           (unsigned long)r2.median);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] ratio within 1.8-2.2\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  参数检查
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_bench_params(void) {
+  bench_config_t cfg = {"bad", 0, BENCH_MAX_REPS + 1, 0, 0};
+  bench_result_t r;
+
+  printf("[TEST] Parameter checks\r\n");
+
+  if (bench_run(&cfg, bench_fn_empty, NULL, &r) != BENCH_PARAM_ERROR ||
+      bench_run(NULL, bench_fn_empty, NULL, &r) != BENCH_PARAM_ERROR) {
+    printf("  [FAIL] Invalid config accepted\r\n");
+    return TEST_FAIL;
+  }
+  cfg.reps = 0; /* 默认次数 */
+  if (bench_run(&cfg, bench_fn_empty, NULL, &r) != BENCH_OK ||
+      r.reps != BENCH_DEFAULT_REPS) {
+    printf("  [FAIL] Default repetitions\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Invalid configs rejected\r\n");
+  return TEST_PASS;
+}
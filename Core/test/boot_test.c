@@ -0,0 +1,432 @@
+/**
+ * @file    boot_test.c
+ * @brief   串口升级引导程序测试文件
+ * @note    1. DMA1 通道 5 被占用时 boot_init 返回 BUSY，退出后 USART1 恢复
+ *          2. 流式升级：窗口 4 传送 24 KB 镜像，安装后应用区与镜像一致，
+ *             打印端到端时间与吞吐率
+ *          3. 停等对比：窗口 1 传送同一镜像，传输时间明显更长；内容相同的
+ *             页全部跳过
+ *          4. 只改一页：安装只写这一页
+ *          5. 重传：某一块第一次发送时损坏，NAK 后重发，结果正确
+ *          6. 断电恢复：改坏应用区的一页，boot_resume 从暂存区重新安装
+ *          7. 镜像 CRC 不符：会话失败，应用区保持原样；大小为 0 的镜像被拒绝
+ *          8. READY 之后再收到相同的 START：只再回 READY，不重新擦除，
+ *             会话正常完成
+ *          会话期间 USART1 接在仿真上位机上（不能 printf），上位机记录各
+ *          阶段的时刻；目标板上没有上位机，也不能改写正在运行的程序，
+ *          只做第 1 项（应用固件不编译本文件，boot.c 只属于 stm32Boot）
+ */
+
+#include "boot_test.h"
+#include "boot.h"
+#include "dma_manager.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_IMAGE_SIZE (24U * 1024U)
+#define TEST_PAGES (TEST_IMAGE_SIZE / FLASH_PAGE_SIZE)
+#define TEST_CHUNKS (TEST_IMAGE_SIZE / BOOT_CHUNK_SIZE)
+#define TEST_NO_CORRUPT 0xFFFFFFFFUL
+#define TEST_CORRUPT_CHUNK 10U
+#define TEST_CHANGED_PAGE 5U
+
+/** 每块在线路上的字节数（A5 + 4 字节帧头 + 载荷 + CRC-16），每字节 10 位 */
+#define TEST_FRAME_BYTES (BOOT_CHUNK_SIZE + 7U)
+#define TEST_BRR ((BOOT_USART_CLK + BOOT_BAUD / 2U) / BOOT_BAUD)
+
+/* 私有变量 ------------------------------------------------------------------*/
+#if defined(STM32_HOST_BUILD)
+static uint8_t s_image[TEST_IMAGE_SIZE];
+
+/**
+ * @brief  一次会话的结果
+ */
+typedef struct {
+  int status;
+  uint64_t ready;    /* START 到 READY（擦除暂存区） */
+  uint64_t streamed; /* START 到最后一个 ACK */
+  uint64_t done;     /* START 到 DONE（含安装） */
+  uint32_t resent;
+  boot_stats_t stats;
+} test_session_t;
+#endif
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int test_busy(void);
+#if defined(STM32_HOST_BUILD)
+static void test_build_image(void);
+static int test_session(uint32_t window, uint32_t corrupt, test_session_t *s);
+static uint32_t test_ms(uint64_t cycles);
+static int test_stream(void);
+static int test_stop_and_wait(void);
+static int test_partial(void);
+static int test_retransmit(void);
+static int test_resume(void);
+static int test_bad_image(void);
+static int test_repeat_start(void);
+#endif
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有引导程序测试
+ */
+void BOOT_RunAllTests(void) {
+  int result = TEST_PASS;
+
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         Bootloader Test Suite          \r\n");
+  printf("========================================\r\n");
+
+  result &= test_busy();
+#if defined(STM32_HOST_BUILD)
+  test_build_image();
+  result &= test_stream();
+  result &= test_stop_and_wait();
+  result &= test_partial();
+  result &= test_retransmit();
+  result &= test_resume();
+  result &= test_bad_image();
+  result &= test_repeat_start();
+#endif
+
+  if (result == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  DMA 通道被占用；退出后 USART1 配置恢复
+ */
+static int test_busy(void) {
+  uint32_t brr = USART1->BRR;
+  uint32_t cr1 = USART1->CR1;
+
+  printf("\r\n[TEST] Channel claim and USART1 restore\r\n");
+
+  DMA_Claim(BOOT_DMA_CHANNEL, "test");
+  int r1 = boot_init();
+  DMA_Release(BOOT_DMA_CHANNEL);
+  if (r1 != BOOT_BUSY || USART1->BRR != brr) {
+    printf("  [FAIL] boot_init with channel claimed returned %d\r\n", r1);
+    return TEST_FAIL;
+  }
+
+  int r2 = boot_init();
+  uint32_t boot_brr = USART1->BRR;
+  const char *owner = DMA_GetOwner(BOOT_DMA_CHANNEL);
+  boot_deinit();
+  if (r2 != BOOT_OK || boot_brr != TEST_BRR || owner == NULL ||
+      DMA_GetOwner(BOOT_DMA_CHANNEL) != NULL || USART1->BRR != brr || USART1->CR1 != cr1) {
+    printf("  [FAIL] boot_init %d, BRR %lu during session, %lu after\r\n", r2,
+           (unsigned long)boot_brr, (unsigned long)USART1->BRR);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] BUSY while claimed, BRR %lu during session, restored after\r\n",
+         (unsigned long)boot_brr);
+  return TEST_PASS;
+}
+
+#if defined(STM32_HOST_BUILD)
+
+/**
+ * @brief  测试镜像：合法的向量表 + 伪随机内容
+ */
+static void test_build_image(void) {
+  uint32_t x = 0x12345678UL;
+  uint32_t word;
+
+  for (uint32_t i = 0; i < TEST_IMAGE_SIZE; i += 4U) {
+    x = x * 1664525UL + 1013904223UL;
+    word = x;
+    if (i == 0U) {
+      word = SRAM_BASE + 0x10000UL;
+    } else if (i == 4U) {
+      word = BOOT_APP_BASE + 0x101UL;
+    }
+    memcpy(&s_image[i], &word, 4U);
+  }
+}
+
+/**
+ * @brief  执行一次升级会话，直到上位机收到 DONE 或放弃
+ * @retval DONE 的 status，上位机放弃时为 -2
+ */
+static int test_session(uint32_t window, uint32_t corrupt, test_session_t *s) {
+  memset(s, 0, sizeof(*s));
+  if (boot_init() != BOOT_OK) {
+    printf("  [FAIL] boot_init\r\n");
+    s->status = -3;
+    return s->status;
+  }
+
+  sim_uploader_start(s_image, TEST_IMAGE_SIZE, window, corrupt);
+  while ((s->status = sim_uploader_result(&s->ready, &s->streamed, &s->done, &s->resent)) ==
+         -1) {
+    boot_poll();
+  }
+  boot_get_stats(&s->stats);
+  boot_deinit();
+  return s->status;
+}
+
+static uint32_t test_ms(uint64_t cycles) {
+  return (uint32_t)(cycles / (SystemCoreClock / 1000U));
+}
+
+/**
+ * @brief  窗口 4 的流式升级
+ */
+static int test_stream(void) {
+  test_session_t s;
+  uint32_t stream_ms, wire_ms;
+
+  printf("\r\n[TEST] Streamed update, window %u\r\n", BOOT_WINDOW);
+
+  if (test_session(BOOT_WINDOW, TEST_NO_CORRUPT, &s) != BOOT_ST_OK ||
+      boot_status() != BOOT_ST_OK) {
+    printf("  [FAIL] session status %d\r\n", s.status);
+    return TEST_FAIL;
+  }
+  if (memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0 || !boot_app_valid() ||
+      s.stats.chunks != TEST_CHUNKS || s.stats.pages_written != TEST_PAGES || s.resent != 0U) {
+    printf("  [FAIL] image mismatch or stats: %lu chunks, %lu pages written, %lu resent\r\n",
+           (unsigned long)s.stats.chunks, (unsigned long)s.stats.pages_written,
+           (unsigned long)s.resent);
+    return TEST_FAIL;
+  }
+
+  /* 传输应被线路速率限制：不超过纯线路时间的 110% */
+  stream_ms = test_ms(s.streamed - s.ready);
+  wire_ms = (uint32_t)(10ULL * TEST_BRR * TEST_FRAME_BYTES * TEST_CHUNKS /
+                       (SystemCoreClock / 1000U));
+  printf("  erase %lu ms, stream %lu ms (wire %lu ms, %lu B/s), install %lu ms, total %lu ms\r\n",
+         (unsigned long)test_ms(s.ready), (unsigned long)stream_ms, (unsigned long)wire_ms,
+         (unsigned long)(1000ULL * TEST_IMAGE_SIZE / stream_ms),
+         (unsigned long)s.stats.install_ms, (unsigned long)test_ms(s.done));
+  if (stream_ms * 10U > wire_ms * 11U) {
+    printf("  [FAIL] streaming not wire-limited\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] image installed, transfer runs at line rate\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  停等协议对比；相同内容的页全部跳过
+ */
+static int test_stop_and_wait(void) {
+  test_session_t win, saw;
+
+  printf("\r\n[TEST] Stop-and-wait comparison\r\n");
+
+  if (test_session(BOOT_WINDOW, TEST_NO_CORRUPT, &win) != BOOT_ST_OK ||
+      test_session(1, TEST_NO_CORRUPT, &saw) != BOOT_ST_OK) {
+    printf("  [FAIL] session status %d / %d\r\n", win.status, saw.status);
+    return TEST_FAIL;
+  }
+
+  uint32_t win_ms = test_ms(win.streamed - win.ready);
+  uint32_t saw_ms = test_ms(saw.streamed - saw.ready);
+  printf("  window %u: %lu ms, window 1: %lu ms; total %lu / %lu ms\r\n", BOOT_WINDOW,
+         (unsigned long)win_ms, (unsigned long)saw_ms, (unsigned long)test_ms(win.done),
+         (unsigned long)test_ms(saw.done));
+  if (win_ms * 10U > saw_ms * 9U) {
+    printf("  [FAIL] sliding window not faster than stop-and-wait\r\n");
+    return TEST_FAIL;
+  }
+  if (saw.stats.pages_written != 0U || saw.stats.pages_skipped != TEST_PAGES) {
+    printf("  [FAIL] unchanged image rewrote %lu pages\r\n",
+           (unsigned long)saw.stats.pages_written);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] window overlaps transfer with page programming, unchanged pages skipped\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  只改一页
+ */
+static int test_partial(void) {
+  test_session_t s;
+
+  printf("\r\n[TEST] Single page change\r\n");
+
+  s_image[TEST_CHANGED_PAGE * FLASH_PAGE_SIZE + 100U] ^= 0xFFU;
+  if (test_session(BOOT_WINDOW, TEST_NO_CORRUPT, &s) != BOOT_ST_OK ||
+      memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0) {
+    printf("  [FAIL] session status %d\r\n", s.status);
+    return TEST_FAIL;
+  }
+  if (s.stats.pages_written != 1U || s.stats.pages_skipped != TEST_PAGES - 1U) {
+    printf("  [FAIL] %lu pages written, %lu skipped\r\n", (unsigned long)s.stats.pages_written,
+           (unsigned long)s.stats.pages_skipped);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] 1 page written in %lu ms, %u skipped\r\n", (unsigned long)s.stats.install_ms,
+         TEST_PAGES - 1U);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  损坏的块被 NAK 后重发
+ */
+static int test_retransmit(void) {
+  test_session_t s;
+
+  printf("\r\n[TEST] Corrupted chunk retransmission\r\n");
+
+  s_image[TEST_CHANGED_PAGE * FLASH_PAGE_SIZE + 100U] ^= 0xFFU;
+  if (test_session(BOOT_WINDOW, TEST_CORRUPT_CHUNK, &s) != BOOT_ST_OK ||
+      memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0) {
+    printf("  [FAIL] session status %d\r\n", s.status);
+    return TEST_FAIL;
+  }
+  if (s.stats.bad_frames == 0U || s.stats.naks == 0U || s.resent == 0U ||
+      s.stats.chunks != TEST_CHUNKS) {
+    printf("  [FAIL] %lu bad frames, %lu NAKs, %lu resent, %lu chunks\r\n",
+           (unsigned long)s.stats.bad_frames, (unsigned long)s.stats.naks,
+           (unsigned long)s.resent, (unsigned long)s.stats.chunks);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu bad frame, %lu NAK, %lu chunks resent\r\n",
+         (unsigned long)s.stats.bad_frames, (unsigned long)s.stats.naks,
+         (unsigned long)s.resent);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  安装中途掉电：应用区一页被改坏，从暂存区恢复
+ */
+static int test_resume(void) {
+  boot_stats_t stats;
+  uint32_t addr = BOOT_APP_BASE + 3U * FLASH_PAGE_SIZE + 64U;
+
+  printf("\r\n[TEST] Resume from staged image\r\n");
+
+  if (boot_resume() != BOOT_OK) {
+    printf("  [FAIL] boot_resume on intact application\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 模拟只写了一半的页：擦除后只编程一个字 */
+  FLASH_EraseInitTypeDef erase = {FLASH_TYPEERASE_PAGES, FLASH_BANK_1, addr & ~(FLASH_PAGE_SIZE - 1U),
+                                  1};
+  uint32_t error;
+  HAL_FLASH_Unlock();
+  HAL_FLASHEx_Erase(&erase, &error);
+  HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, 0);
+  HAL_FLASH_Lock();
+  if (memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) == 0) {
+    printf("  [FAIL] page not damaged\r\n");
+    return TEST_FAIL;
+  }
+
+  int r = boot_resume();
+  boot_get_stats(&stats);
+  if (r != BOOT_OK || memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0 ||
+      stats.pages_written != 1U) {
+    printf("  [FAIL] boot_resume %d, %lu pages written\r\n", r,
+           (unsigned long)stats.pages_written);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] damaged page reinstalled in %lu ms\r\n", (unsigned long)stats.install_ms);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  镜像 CRC 不符、大小为 0
+ */
+static int test_bad_image(void) {
+  test_session_t s;
+  int status;
+
+  printf("\r\n[TEST] Rejected images\r\n");
+
+  /* START 中的 CRC 按原内容计算，之后发送的第 0 块被改动 */
+  if (boot_init() != BOOT_OK) {
+    printf("  [FAIL] boot_init\r\n");
+    return TEST_FAIL;
+  }
+  sim_uploader_start(s_image, TEST_IMAGE_SIZE, BOOT_WINDOW, TEST_NO_CORRUPT);
+  s_image[16] ^= 0xFFU;
+  while ((status = sim_uploader_result(NULL, NULL, NULL, NULL)) == -1) {
+    boot_poll();
+  }
+  boot_state_t state = boot_poll();
+  boot_deinit();
+  s_image[16] ^= 0xFFU;
+  if (status != BOOT_ST_CRC || state != BOOT_STATE_FAILED ||
+      memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0 || !boot_app_valid()) {
+    printf("  [FAIL] CRC mismatch: status %d, state %d\r\n", status, state);
+    return TEST_FAIL;
+  }
+
+  /* 暂存区已为新会话擦除，没有可恢复的镜像，应用保持不变 */
+  if (boot_resume() != BOOT_ERROR ||
+      memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0) {
+    printf("  [FAIL] boot_resume after failed session\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 大小为 0：READY 带错误码 */
+  if (boot_init() != BOOT_OK) {
+    printf("  [FAIL] boot_init\r\n");
+    return TEST_FAIL;
+  }
+  sim_uploader_start(s_image, 0, BOOT_WINDOW, TEST_NO_CORRUPT);
+  while ((s.status = sim_uploader_result(NULL, NULL, NULL, NULL)) == -1) {
+    boot_poll();
+  }
+  boot_deinit();
+  if (s.status != BOOT_ST_SIZE) {
+    printf("  [FAIL] empty image: status %d\r\n", s.status);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] bad CRC leaves application intact, empty image refused\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  上位机重发的 START 与 READY 交错
+ */
+static int test_repeat_start(void) {
+  test_session_t s;
+
+  printf("\r\n[TEST] START repeated after READY\r\n");
+
+  s_image[TEST_CHANGED_PAGE * FLASH_PAGE_SIZE + 200U] ^= 0xFFU;
+  sim_uploader_repeat_start();
+  if (test_session(BOOT_WINDOW, TEST_NO_CORRUPT, &s) != BOOT_ST_OK ||
+      memcmp((const void *)BOOT_APP_BASE, s_image, TEST_IMAGE_SIZE) != 0) {
+    printf("  [FAIL] session status %d\r\n", s.status);
+    return TEST_FAIL;
+  }
+  /* 重新擦除的话，随后的块会在擦除期间丢失并被重发 */
+  if (s.stats.duplicates != 1U || s.resent != 0U || s.stats.chunks != TEST_CHUNKS) {
+    printf("  [FAIL] %lu duplicates, %lu resent, %lu chunks\r\n",
+           (unsigned long)s.stats.duplicates, (unsigned long)s.resent,
+           (unsigned long)s.stats.chunks);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] READY repeated, staging not erased again, nothing resent\r\n");
+  return TEST_PASS;
+}
+
+#endif
@@ -0,0 +1,340 @@
+/**
+ * @file    can_signal_test.c
+ * @brief   CAN 信号打包 / PDO 映射层测试文件
+ * @note    1. 生成的 pack/unpack 与通用逐位实现交叉校验
+ *          2. PDO 绑定变量的打包/解包与比例换算
+ *          3. 变化即发 / 周期发送（环回模式）
+ *          4. 生成实现与逐位实现的周期数对比
+ */
+
+#include "can_signal_test.h"
+#include "can_signal.h"
+#include "bench.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_RANDOM_ROUNDS 200
+#define TEST_BENCH_ROUNDS 1000
+
+/**
+ * 测试信号表：名称, 起始位, 位长, 字节序, 有符号
+ * 覆盖字节对齐/非对齐、跨字节、32 位和单个位
+ */
+#define TEST_SIGNALS(X)                                                        \
+  X(sig_le_u16, 0, 16, CAN_SIG_LITTLE_ENDIAN, 0)                               \
+  X(sig_le_s12, 20, 12, CAN_SIG_LITTLE_ENDIAN, 1)                              \
+  X(sig_le_u32, 29, 32, CAN_SIG_LITTLE_ENDIAN, 0)                              \
+  X(sig_le_b1, 63, 1, CAN_SIG_LITTLE_ENDIAN, 0)                                \
+  X(sig_be_u16, 7, 16, CAN_SIG_BIG_ENDIAN, 0)                                  \
+  X(sig_be_s10, 45, 10, CAN_SIG_BIG_ENDIAN, 1)                                 \
+  X(sig_be_u32, 23, 32, CAN_SIG_BIG_ENDIAN, 0)                                 \
+  X(sig_be_u3, 58, 3, CAN_SIG_BIG_ENDIAN, 0)                                 \
+  X(sig_le_u8, 32, 8, CAN_SIG_LITTLE_ENDIAN, 0)
+
+TEST_SIGNALS(CAN_SIGNAL_DEFINE)
+
+#define TEST_SIGNAL_FNS(name, start, len, order, sign)                         \
+  {name##_pack, name##_unpack},
+
+/* 私有变量 ------------------------------------------------------------------*/
+static const CAN_SignalDesc_t s_desc[] = {TEST_SIGNALS(CAN_SIGNAL_DESC)};
+
+static const struct {
+  CAN_SigPackFn_t pack;
+  CAN_SigUnpackFn_t unpack;
+} s_fns[] = {TEST_SIGNALS(TEST_SIGNAL_FNS)};
+
+#define TEST_SIGNAL_COUNT (sizeof(s_desc) / sizeof(s_desc[0]))
+
+static uint32_t s_rand_state = 0x12345678;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint32_t test_rand(void);
+static int test_signal_cross_check(void);
+static int test_pdo_pack_unpack(void);
+static int test_pdo_tx_modes(void);
+static int test_signal_benchmark(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 CAN 信号层测试
+ */
+void CAN_Signal_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("    CAN Signal/PDO Test Suite Start     \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  int result1 = test_signal_cross_check();
+  int result2 = test_pdo_pack_unpack();
+  int result3 = test_pdo_tx_modes();
+  int result4 = test_signal_benchmark();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  简单线性同余随机数（结果可复现）
+ */
+static uint32_t test_rand(void) {
+  s_rand_state = s_rand_state * 1664525U + 1013904223U;
+  return s_rand_state;
+}
+
+/**
+ * @brief  生成的 pack/unpack 与通用逐位实现在随机负载上逐一比较
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_signal_cross_check(void) {
+  printf("[TEST] Generated packers vs generic bit loop\r\n");
+
+  for (uint32_t s = 0; s < TEST_SIGNAL_COUNT; s++) {
+    for (int r = 0; r < TEST_RANDOM_ROUNDS; r++) {
+      uint64_t payload = ((uint64_t)test_rand() << 32) | test_rand();
+      uint32_t value = test_rand();
+      uint8_t bytes[8];
+
+      /* 解包比较 */
+      memcpy(bytes, &payload, 8);
+      if (s_fns[s].unpack(payload) !=
+          CAN_Signal_UnpackGeneric(bytes, &s_desc[s])) {
+        printf("  [FAIL] %s unpack mismatch\r\n", s_desc[s].name);
+        return TEST_FAIL;
+      }
+
+      /* 打包比较：其余位必须保持不变 */
+      s_fns[s].pack(&payload, value);
+      CAN_Signal_PackGeneric(bytes, &s_desc[s], value);
+      if (memcmp(bytes, &payload, 8) != 0) {
+        printf("  [FAIL] %s pack mismatch\r\n", s_desc[s].name);
+        return TEST_FAIL;
+      }
+    }
+  }
+
+  /* 已知位置：Motorola 16 位信号 start=7 占 DATA0(高字节)/DATA1 */
+  uint64_t p = 0;
+  sig_be_u16_pack(&p, 0x1234);
+  if ((uint8_t)p != 0x12 || (uint8_t)(p >> 8) != 0x34) {
+    printf("  [FAIL] Motorola byte layout\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 有符号信号符号扩展 */
+  p = 0;
+  sig_le_s12_pack(&p, (uint32_t)-100);
+  if ((int32_t)sig_le_s12_unpack(p) != -100) {
+    printf("  [FAIL] Signed sign extension\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %u signals x %d random payloads match\r\n",
+         (unsigned)TEST_SIGNAL_COUNT, TEST_RANDOM_ROUNDS);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  PDO 绑定变量的打包/解包与比例换算
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_pdo_pack_unpack(void) {
+  /* 发送端变量：
+   * 转速 (1rpm), 温度 (1℃/bit, 偏移 -40), 电流 (5mA/bit, 偏移 -100mA),
+   * 电压 (10mV/bit), 档位 (0-7) */
+  uint16_t tx_rpm = 3250;
+  int16_t tx_temp = -12;
+  int16_t tx_ma = -350;
+  int32_t tx_mv = 13800;
+  uint8_t tx_gear = 5;
+  uint16_t rx_rpm = 0;
+  int16_t rx_temp = 0;
+  int16_t rx_ma = 0;
+  int32_t rx_mv = 0;
+  uint8_t rx_gear = 0;
+  /* 32 位无符号计数 (16/bit)，值超过 0x80000000 */
+  uint32_t tx_count = 0x90000010UL;
+  uint32_t rx_count = 0;
+
+  const CAN_PdoMap_t tx_map[] = {
+      CAN_PDO_MAP(sig_le_u16, tx_rpm, CAN_VAR_U16, 1, 0),
+      CAN_PDO_MAP(sig_le_u8, tx_temp, CAN_VAR_I16, 1, -40),
+      CAN_PDO_MAP(sig_be_s10, tx_ma, CAN_VAR_I16, 5, -100),
+      CAN_PDO_MAP(sig_le_s12, tx_mv, CAN_VAR_I32, 10, 0),
+      CAN_PDO_MAP(sig_be_u3, tx_gear, CAN_VAR_U8, 1, 0),
+  };
+  const CAN_PdoMap_t rx_map[] = {
+      CAN_PDO_MAP(sig_le_u16, rx_rpm, CAN_VAR_U16, 1, 0),
+      CAN_PDO_MAP(sig_le_u8, rx_temp, CAN_VAR_I16, 1, -40),
+      CAN_PDO_MAP(sig_be_s10, rx_ma, CAN_VAR_I16, 5, -100),
+      CAN_PDO_MAP(sig_le_s12, rx_mv, CAN_VAR_I32, 10, 0),
+      CAN_PDO_MAP(sig_be_u3, rx_gear, CAN_VAR_U8, 1, 0),
+  };
+  const CAN_PdoMap_t tx_map32[] = {
+      CAN_PDO_MAP(sig_le_u32, tx_count, CAN_VAR_U32, 16, 0),
+  };
+  const CAN_PdoMap_t rx_map32[] = {
+      CAN_PDO_MAP(sig_le_u32, rx_count, CAN_VAR_U32, 16, 0),
+  };
+  CAN_Pdo_t tpdo = {0x181, 0, 8, CAN_PDO_ON_CHANGE, 0, tx_map, 5, 0, 0, 0};
+  CAN_Pdo_t rpdo = {0x181, 0, 8, 0, 0, rx_map, 5, 0, 0, 0};
+  CAN_Pdo_t tpdo32 = {0x281, 0, 8, CAN_PDO_ON_CHANGE, 0, tx_map32, 1, 0, 0, 0};
+  CAN_Pdo_t rpdo32 = {0x281, 0, 8, 0, 0, rx_map32, 1, 0, 0, 0};
+  CAN_Frame_t frame;
+  uint64_t payload;
+
+  printf("[TEST] PDO variable binding\r\n");
+
+  memset(&frame, 0, sizeof(frame));
+  frame.id = 0x181;
+  payload = CAN_Pdo_Pack(&tpdo);
+  CAN_Frame_SetPayload(&frame, payload);
+
+  /* 原始值：温度 -12 - (-40) = 28，电流 (-350 + 100) / 5 = -50 */
+  if (sig_le_u8_unpack(payload) != 28 ||
+      (int32_t)sig_be_s10_unpack(payload) != -50) {
+    printf("  [FAIL] raw temp=%lu ma=%ld\r\n",
+           (unsigned long)sig_le_u8_unpack(payload),
+           (long)(int32_t)sig_be_s10_unpack(payload));
+    return TEST_FAIL;
+  }
+
+  if (CAN_Pdo_RxDispatch(&rpdo, 1, &frame) != 0) {
+    printf("  [FAIL] RPDO not matched\r\n");
+    return TEST_FAIL;
+  }
+
+  if (rx_rpm != tx_rpm || rx_temp != tx_temp || rx_ma != tx_ma ||
+      rx_mv != tx_mv || rx_gear != tx_gear) {
+    printf("  [FAIL] rpm=%u temp=%d ma=%d mv=%ld gear=%u\r\n", rx_rpm,
+           rx_temp, rx_ma, (long)rx_mv, rx_gear);
+    return TEST_FAIL;
+  }
+
+  frame.id = 0x182;
+  if (CAN_Pdo_RxDispatch(&rpdo, 1, &frame) != -1) {
+    printf("  [FAIL] Unrelated ID dispatched\r\n");
+    return TEST_FAIL;
+  }
+
+  /* U32 高位为 1 时按无符号换算：原始值 0x09000001 */
+  frame.id = 0x281;
+  payload = CAN_Pdo_Pack(&tpdo32);
+  CAN_Frame_SetPayload(&frame, payload);
+  if (sig_le_u32_unpack(payload) != 0x09000001UL ||
+      CAN_Pdo_RxDispatch(&rpdo32, 1, &frame) != 0 || rx_count != tx_count) {
+    printf("  [FAIL] u32 raw=0x%08lx value=0x%08lx\r\n",
+           (unsigned long)sig_le_u32_unpack(payload), (unsigned long)rx_count);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Variables round-trip through payload\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  变化即发 / 周期发送（环回模式）
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_pdo_tx_modes(void) {
+  uint16_t speed = 100;
+  const CAN_PdoMap_t map[] = {
+      CAN_PDO_MAP(sig_le_u16, speed, CAN_VAR_U16, 1, 0),
+  };
+  CAN_Pdo_t pdos[2] = {
+      {0x201, 0, 2, CAN_PDO_ON_CHANGE, 0, map, 1, 0, 0, 0},
+      {0x202, 0, 2, CAN_PDO_PERIODIC, 50, map, 1, 0, 0, 0},
+  };
+  CAN_Frame_t rx[6];
+  int ok = 1;
+
+  printf("[TEST] PDO on-change / periodic transmission\r\n");
+
+  if (CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_TXFP) != CAN_INIT_OK) {
+    printf("  [SKIP] CAN init failed\r\n");
+    return TEST_PASS;
+  }
+
+  /* 第一次：两个 PDO 都发送 */
+  ok &= CAN_Pdo_TxProcess(pdos, 2, 1000) == 2;
+  /* 数据不变、周期未到：都不发送 */
+  ok &= CAN_Pdo_TxProcess(pdos, 2, 1010) == 0;
+  /* 数据变化：只有 ON_CHANGE 发送 */
+  speed = 200;
+  ok &= CAN_Pdo_TxProcess(pdos, 2, 1020) == 1;
+  for (int i = 0; i < 3; i++) {
+    CAN_TransmitWait(i, CAN_TIMEOUT_VALUE);
+  }
+  while (CAN_ReceiveBurst(rx, 6) > 0)
+    ;
+  /* 周期到期：只有 PERIODIC 发送 */
+  ok &= CAN_Pdo_TxProcess(pdos, 2, 1050) == 1;
+  for (int i = 0; i < 3; i++) {
+    CAN_TransmitWait(i, CAN_TIMEOUT_VALUE);
+  }
+  ok &= CAN_ReceiveBurst(rx, 6) == 1 && rx[0].id == 0x202 &&
+        rx[0].data.b[0] == 200;
+
+  if (!ok) {
+    printf("  [FAIL] Unexpected transmission pattern\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] On-change and periodic triggers\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  生成实现与通用逐位实现的周期数对比（仅打印）
+ * @retval TEST_PASS
+ */
+static int test_signal_benchmark(void) {
+  volatile uint32_t sink = 0;
+  uint64_t payload = 0;
+  uint8_t bytes[8] = {0};
+  uint32_t t0, generated, generic;
+
+  printf("[TEST] Pack/unpack benchmark (%d rounds x 4 signals)\r\n",
+         TEST_BENCH_ROUNDS);
+
+  t0 = bench_now();
+  for (uint32_t i = 0; i < TEST_BENCH_ROUNDS; i++) {
+    sig_le_u16_pack(&payload, i);
+    sig_le_s12_pack(&payload, i);
+    sig_be_u16_pack(&payload, i);
+    sig_be_s10_pack(&payload, i);
+    sink += sig_le_u16_unpack(payload) + sig_le_s12_unpack(payload) +
+            sig_be_u16_unpack(payload) + sig_be_s10_unpack(payload);
+  }
+  generated = bench_now() - t0;
+
+  t0 = bench_now();
+  for (uint32_t i = 0; i < TEST_BENCH_ROUNDS; i++) {
+    CAN_Signal_PackGeneric(bytes, &s_desc[0], i);
+    CAN_Signal_PackGeneric(bytes, &s_desc[1], i);
+    CAN_Signal_PackGeneric(bytes, &s_desc[4], i);
+    CAN_Signal_PackGeneric(bytes, &s_desc[5], i);
+    sink += CAN_Signal_UnpackGeneric(bytes, &s_desc[0]) +
+            CAN_Signal_UnpackGeneric(bytes, &s_desc[1]) +
+            CAN_Signal_UnpackGeneric(bytes, &s_desc[4]) +
+            CAN_Signal_UnpackGeneric(bytes, &s_desc[5]);
+  }
+  generic = bench_now() - t0;
+
+  (void)sink;
+  printf("  [INFO] cycles/signal (pack+unpack): generated=%lu generic=%lu\r\n",
+         (unsigned long)(generated / (TEST_BENCH_ROUNDS * 4)),
+         (unsigned long)(generic / (TEST_BENCH_ROUNDS * 4)));
+  return TEST_PASS;
+}
@@ -100,7 +100,7 @@ static int test_can_hal_loopback(void) {
     return TEST_FAIL;
   }
 
-  printf("  Message transmitted (Mailbox: %lu)\r\n", TxMailbox);
+  printf("  Message transmitted (Mailbox: %lu)\r\n", (unsigned long)TxMailbox);
 
   /* 6. 等待接收 (轮询 FIFO0) */
   uint32_t tickstart = HAL_GetTick();
@@ -132,7 +132,7 @@ static int test_can_hal_loopback(void) {
   } else {
     printf("  [FAIL] Verification mismatch\r\n");
     if (!id_match)
-      printf("    ID Expected: 0x321, Actual: 0x%lX\r\n", RxHeader.StdId);
+      printf("    ID Expected: 0x321, Actual: 0x%lX\r\n", (unsigned long)RxHeader.StdId);
     if (!data_match)
       printf("    Data mismatch\r\n");
     return TEST_FAIL;
@@ -0,0 +1,322 @@
+/**
+ * @file    crc_sw_test.c
+ * @brief   软件 CRC 库测试文件
+ * @note    1. 各算法 "123456789" 的校验值（逐字节 / slice-by-4 / slice-by-8）
+ *          2. 分段增量计算与一次计算一致，slice 与逐字节在任意对齐下一致
+ *          3. 编译期展开的 slice 表逐项满足 Tk = (Tk-1 >> 8) ^ T0[Tk-1 & 0xFF]
+ *          4. 与 CRC 计算单元交叉核对：
+ *             CRC-32/MPEG-2 = 单元按字送入字节序反转后的数据；
+ *             CRC-32 = ~RBIT(单元按字送入 RBIT 后的数据)
+ *          5. 每字节周期数
+ */
+
+#include "crc_sw_test.h"
+#include "bench.h"
+#include "crc.h"
+#include "crc32.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_BUF_SIZE 1024U /* 测试缓冲区大小 */
+#define TEST_ROUNDS 40U     /* 随机分段的轮数 */
+#define TEST_HW_SIZE 256U   /* 与 CRC 单元核对的字节数 */
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/**
+ * @brief  被测实现
+ */
+typedef uint32_t (*test_update_fn_t)(const crc_algo_t *algo, uint32_t crc,
+                                     const void *data, size_t len);
+
+/**
+ * @brief  基准测试参数
+ */
+typedef struct {
+  const crc_algo_t *algo;
+  test_update_fn_t fn;
+} test_bench_arg_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint32_t s_buf[TEST_BUF_SIZE / 4];
+static uint32_t s_words[TEST_HW_SIZE / 4];
+
+static const crc_algo_t *const s_algos[] = {
+    &crc_8_j1850, &crc_16_modbus, &crc_16_ccitt, &crc_32, &crc_32_mpeg2,
+};
+
+static const test_update_fn_t s_fns[] = {
+    crc_update_bytewise, crc_update_slice4, crc_update_slice8, crc_update,
+};
+
+#define TEST_ALGO_COUNT (sizeof(s_algos) / sizeof(s_algos[0]))
+#define TEST_FN_COUNT (sizeof(s_fns) / sizeof(s_fns[0]))
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint32_t test_rand(void);
+static uint32_t test_rbit(uint32_t v);
+static void bench_fn_crc(void *arg);
+static void bench_fn_hw(void *arg);
+static int test_check(void);
+static int test_incremental(void);
+static int test_slice_tables(void);
+static int test_hardware(void);
+static int test_speed(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有软件 CRC 测试
+ */
+void CRC_SW_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("       Software CRC Test Suite          \r\n");
+  printf("========================================\r\n");
+
+  uint8_t *bytes = (uint8_t *)s_buf;
+  for (uint32_t i = 0; i < TEST_BUF_SIZE; i++) {
+    bytes[i] = (uint8_t)test_rand();
+  }
+
+  int result1 = test_check();
+  int result2 = test_incremental();
+  int result3 = test_slice_tables();
+  int result4 = test_hardware();
+  int result5 = test_speed();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  线性同余伪随机数
+ */
+static uint32_t test_rand(void) {
+  static uint32_t seed = 2024U;
+
+  seed = seed * 1103515245U + 12345U;
+  return seed >> 8;
+}
+
+/**
+ * @brief  32 位按位反转（同 Cortex-M3 的 RBIT）
+ */
+static uint32_t test_rbit(uint32_t v) {
+  uint32_t r = 0;
+
+  for (uint32_t i = 0; i < 32; i++) {
+    r = (r << 1) | (v & 1U);
+    v >>= 1;
+  }
+  return r;
+}
+
+/**
+ * @brief  被测函数：软件计算 TEST_BUF_SIZE 字节
+ */
+static void bench_fn_crc(void *arg) {
+  const test_bench_arg_t *b = (const test_bench_arg_t *)arg;
+  volatile uint32_t crc = b->fn(b->algo, crc_init(b->algo), s_buf, TEST_BUF_SIZE);
+  (void)crc;
+}
+
+/**
+ * @brief  被测函数：CRC 单元（CPU 送数）
+ */
+static void bench_fn_hw(void *arg) {
+  (void)arg;
+  crc32_reset();
+  (void)crc32_feed(s_buf, TEST_BUF_SIZE);
+}
+
+/**
+ * @brief  校验值
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_check(void) {
+  printf("[TEST] Check values\r\n");
+
+  for (uint32_t a = 0; a < TEST_ALGO_COUNT; a++) {
+    const crc_algo_t *algo = s_algos[a];
+    for (uint32_t f = 0; f < TEST_FN_COUNT; f++) {
+      uint32_t crc = crc_final(algo, s_fns[f](algo, crc_init(algo), "123456789", 9));
+      if (crc != algo->check) {
+        printf("  [FAIL] %s impl %lu: %08lx expected %08lx\r\n", algo->name,
+               (unsigned long)f, (unsigned long)crc, (unsigned long)algo->check);
+        return TEST_FAIL;
+      }
+    }
+    printf("  %-20s %08lx\r\n", algo->name, (unsigned long)algo->check);
+  }
+
+  printf("  [PASS] %u algorithms\r\n", (unsigned)TEST_ALGO_COUNT);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  分段增量计算与对齐
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_incremental(void) {
+  const uint8_t *bytes = (const uint8_t *)s_buf;
+
+  printf("[TEST] Incremental updates and alignment\r\n");
+
+  for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+    uint32_t off = round & 7U;
+    uint32_t len = test_rand() % (TEST_BUF_SIZE - off);
+    uint32_t split = test_rand() % (len + 1U);
+
+    for (uint32_t a = 0; a < TEST_ALGO_COUNT; a++) {
+      const crc_algo_t *algo = s_algos[a];
+      uint32_t whole = crc_calc(algo, bytes + off, len);
+
+      for (uint32_t f = 0; f < TEST_FN_COUNT; f++) {
+        uint32_t crc = crc_init(algo);
+        crc = s_fns[f](algo, crc, bytes + off, split);
+        crc = s_fns[f](algo, crc, bytes + off + split, len - split);
+        if (crc_final(algo, crc) != whole) {
+          printf("  [FAIL] %s impl %lu off %lu len %lu split %lu\r\n", algo->name,
+                 (unsigned long)f, (unsigned long)off, (unsigned long)len,
+                 (unsigned long)split);
+          return TEST_FAIL;
+        }
+      }
+    }
+  }
+
+  printf("  [PASS] %u rounds\r\n", (unsigned)TEST_ROUNDS);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  slice 表核对
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_slice_tables(void) {
+  const uint32_t (*t)[256] = crc_32.slice;
+
+  printf("[TEST] Slice tables\r\n");
+
+  for (uint32_t k = 1; k < 8; k++) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t expected = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFFU];
+      if (t[k][i] != expected) {
+        printf("  [FAIL] T%lu[%lu] %08lx expected %08lx\r\n", (unsigned long)k,
+               (unsigned long)i, (unsigned long)t[k][i], (unsigned long)expected);
+        return TEST_FAIL;
+      }
+    }
+  }
+
+  printf("  [PASS] T1..T7 match T0\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  与 CRC 计算单元交叉核对
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_hardware(void) {
+  uint8_t swapped[TEST_HW_SIZE];
+  const uint8_t *bytes = (const uint8_t *)s_buf;
+  uint32_t sw, hw;
+
+  printf("[TEST] Cross-check with the CRC unit\r\n");
+
+  /* 单元按字从最高位开始计算：每个字内字节倒序后即为逐字节的 MPEG-2 */
+  for (uint32_t i = 0; i < TEST_HW_SIZE; i++) {
+    swapped[i] = bytes[(i & ~3U) + 3U - (i & 3U)];
+  }
+  sw = crc_calc(&crc_32_mpeg2, swapped, TEST_HW_SIZE);
+  crc32_reset();
+  hw = crc32_feed(bytes, TEST_HW_SIZE);
+  if (sw != hw) {
+    printf("  [FAIL] CRC-32/MPEG-2 sw %08lx hw %08lx\r\n", (unsigned long)sw,
+           (unsigned long)hw);
+    return TEST_FAIL;
+  }
+
+  /* 反转算法：送入按位反转的字，结果按位反转后取反 */
+  for (uint32_t i = 0; i < TEST_HW_SIZE / 4U; i++) {
+    s_words[i] = test_rbit(s_buf[i]);
+  }
+  sw = crc_calc(&crc_32, bytes, TEST_HW_SIZE);
+  crc32_reset();
+  hw = ~test_rbit(crc32_feed(s_words, TEST_HW_SIZE));
+  if (sw != hw) {
+    printf("  [FAIL] CRC-32 sw %08lx hw %08lx\r\n", (unsigned long)sw,
+           (unsigned long)hw);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] MPEG-2 and reflected CRC-32 match over %u bytes\r\n",
+         (unsigned)TEST_HW_SIZE);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  每字节周期数：slice 应快于逐字节
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_speed(void) {
+  static const struct {
+    const char *name;
+    test_bench_arg_t arg;
+  } cases[] = {
+      {"crc8_j1850_bytewise", {&crc_8_j1850, crc_update_bytewise}},
+      {"crc16_modbus_bytewise", {&crc_16_modbus, crc_update_bytewise}},
+      {"crc16_ccitt_bytewise", {&crc_16_ccitt, crc_update_bytewise}},
+      {"crc32_bytewise", {&crc_32, crc_update_bytewise}},
+      {"crc32_slice4", {&crc_32, crc_update_slice4}},
+      {"crc32_slice8", {&crc_32, crc_update_slice8}},
+  };
+  uint32_t median[sizeof(cases) / sizeof(cases[0])];
+  bench_result_t r;
+
+  printf("[TEST] Cycles per byte\r\n");
+
+  bench_init();
+  bench_report_header();
+  for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    bench_config_t cfg = {cases[i].name, 2, 15, TEST_BUF_SIZE, BENCH_FLAG_IRQ_OFF};
+    if (bench_run(&cfg, bench_fn_crc, (void *)&cases[i].arg, &r) != BENCH_OK) {
+      printf("  [FAIL] bench_run\r\n");
+      return TEST_FAIL;
+    }
+    bench_report(&r);
+    median[i] = r.median;
+  }
+  bench_config_t cfg_hw = {"crc32_unit_cpu_feed", 2, 15, TEST_BUF_SIZE, BENCH_FLAG_IRQ_OFF};
+  if (bench_run(&cfg_hw, bench_fn_hw, NULL, &r) != BENCH_OK) {
+    printf("  [FAIL] bench_run\r\n");
+    return TEST_FAIL;
+  }
+  bench_report(&r);
+
+  for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    printf("  %-22s %lu.%02lu %s/byte\r\n", cases[i].name,
+           (unsigned long)(median[i] / TEST_BUF_SIZE),
+           (unsigned long)(median[i] % TEST_BUF_SIZE * 100U / TEST_BUF_SIZE), bench_unit());
+  }
+
+  /* 3 = 逐字节，4 = slice-by-4，5 = slice-by-8 */
+  if (median[4] >= median[3] || median[5] >= median[3]) {
+    printf("  [FAIL] Slicing not faster than bytewise\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] slice-by-8 %lu%% of bytewise\r\n",
+         (unsigned long)(median[5] * 100U / median[3]));
+  return TEST_PASS;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file    crc_test.c
+ * @brief   CRC 计算单元驱动测试文件
+ * @note    1. 已知向量：软件实现与 CRC 单元
+ *          2. 任意长度 / 对齐：软件、CPU 送数、DMA 送数、分段接续结果一致
+ *          3. 1KB 数据的软件 / CPU 送数 / DMA 送数耗时
+ *          4. W25Q32_ReadCRC：DMA 与 CPU 送数都与写入数据的 CRC 一致，
+ *             区域错开一个字节时不一致
+ */
+
+#include "crc_test.h"
+#include "bench.h"
+#include "crc32.h"
+#include "w25q32.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_BUF_SIZE 1024U       /* 测试缓冲区大小 */
+#define TEST_MAX_LEN 300U         /* 随机长度上限 */
+#define TEST_ROUNDS 40U           /* 随机长度 / 对齐的轮数 */
+#define TEST_FLASH_ADDR 0x020000U /* W25Q32 测试区域（块 2） */
+#define TEST_FLASH_SIZE 1000U     /* 跨 4 页，最后一块不足 4 字节的倍数 */
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/**
+ * @brief  已知向量
+ */
+typedef struct {
+    const char *data;
+    uint32_t len;
+    uint32_t crc;
+} test_vector_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint32_t s_buf[TEST_BUF_SIZE / 4];
+
+static const test_vector_t s_vectors[] = {
+    {"", 0, 0xFFFFFFFFUL},
+    {"\0\0\0\0", 4, 0xC704DD7BUL},
+    {"\x78\x56\x34\x12", 4, 0xDF8A8A2BUL},
+    {"12345678", 8, 0xFEFC54F9UL},
+    {"123456789", 9, 0xAFF19057UL},
+};
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint32_t test_rand(void);
+static void bench_fn_sw(void *arg);
+static void bench_fn_cpu(void *arg);
+static void bench_fn_dma(void *arg);
+static int test_vectors(void);
+static int test_match(void);
+static int test_speed(void);
+static int test_w25q32(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 CRC 测试
+ */
+void CRC_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("           CRC-32 Test Suite            \r\n");
+  printf("========================================\r\n");
+
+  if (crc32_init() != CRC32_OK) {
+    printf("  [FAIL] crc32_init (channel already claimed)\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    printf("========================================\r\n");
+    return;
+  }
+
+  int result1 = test_vectors();
+  int result2 = test_match();
+  int result3 = test_speed();
+  int result4 = test_w25q32();
+
+  crc32_deinit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  线性同余伪随机数
+ */
+static uint32_t test_rand(void) {
+  static uint32_t seed = 12345U;
+
+  seed = seed * 1103515245U + 12345U;
+  return seed >> 8;
+}
+
+/**
+ * @brief  被测函数：软件计算 TEST_BUF_SIZE 字节
+ */
+static void bench_fn_sw(void *arg) {
+  volatile uint32_t crc = crc32_sw(CRC32_INIT, arg, TEST_BUF_SIZE);
+  (void)crc;
+}
+
+/**
+ * @brief  被测函数：CPU 送数
+ */
+static void bench_fn_cpu(void *arg) {
+  crc32_reset();
+  (void)crc32_feed(arg, TEST_BUF_SIZE);
+}
+
+/**
+ * @brief  被测函数：DMA 送数并等待完成
+ */
+static void bench_fn_dma(void *arg) {
+  uint32_t crc;
+
+  (void)crc32_compute(arg, TEST_BUF_SIZE, &crc);
+}
+
+/**
+ * @brief  已知向量
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_vectors(void) {
+  printf("[TEST] Known vectors\r\n");
+
+  for (uint32_t i = 0; i < sizeof(s_vectors) / sizeof(s_vectors[0]); i++) {
+    const test_vector_t *v = &s_vectors[i];
+    uint32_t sw = crc32_sw(CRC32_INIT, v->data, v->len);
+    uint32_t hw;
+
+    crc32_reset();
+    hw = crc32_feed(v->data, v->len);
+    if (sw != v->crc || hw != v->crc) {
+      printf("  [FAIL] Vector %lu: sw %08lx hw %08lx expected %08lx\r\n",
+             (unsigned long)i, (unsigned long)sw, (unsigned long)hw,
+             (unsigned long)v->crc);
+      return TEST_FAIL;
+    }
+  }
+
+  printf("  [PASS] %u vectors\r\n", (unsigned)(sizeof(s_vectors) / sizeof(s_vectors[0])));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  任意长度 / 对齐一致性
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_match(void) {
+  uint8_t *bytes = (uint8_t *)s_buf;
+
+  printf("[TEST] Software / CPU / DMA agree\r\n");
+
+  for (uint32_t i = 0; i < TEST_BUF_SIZE; i++) {
+    bytes[i] = (uint8_t)test_rand();
+  }
+
+  for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+    uint32_t len = test_rand() % TEST_MAX_LEN;
+    uint32_t off = round & 3U;
+    uint32_t split = (test_rand() % (len / 4U + 1U)) * 4U;
+    uint32_t sw, cpu, dma, chained;
+
+    sw = crc32_sw(CRC32_INIT, bytes + off, len);
+
+    crc32_reset();
+    cpu = crc32_feed(bytes + off, len);
+
+    if (crc32_compute(bytes + off, len, &dma) != CRC32_OK) {
+      printf("  [FAIL] crc32_compute\r\n");
+      return TEST_FAIL;
+    }
+
+    /* 前一段字对齐地走 DMA，后一段接续；软件实现同样分两段 */
+    crc32_reset();
+    if (crc32_feed_dma(bytes, split, NULL, NULL) != CRC32_OK) {
+      printf("  [FAIL] crc32_feed_dma\r\n");
+      return TEST_FAIL;
+    }
+    while (crc32_busy()) {
+    }
+    chained = crc32_feed(bytes + split, len - split);
+
+    if (cpu != sw || dma != sw ||
+        chained != crc32_sw(crc32_sw(CRC32_INIT, bytes, split), bytes + split,
+                            len - split)) {
+      printf("  [FAIL] len %lu off %lu: sw %08lx cpu %08lx dma %08lx\r\n",
+             (unsigned long)len, (unsigned long)off, (unsigned long)sw,
+             (unsigned long)cpu, (unsigned long)dma);
+      return TEST_FAIL;
+    }
+  }
+
+  if (crc32_feed_dma(bytes + 1, 8, NULL, NULL) != CRC32_PARAM_ERROR) {
+    printf("  [FAIL] Unaligned DMA source accepted\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %u lengths and alignments\r\n", (unsigned)TEST_ROUNDS);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  耗时比较：CRC 单元应快于软件查表
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_speed(void) {
+  bench_config_t cfg_sw = {"crc32_sw_1k", 2, 15, TEST_BUF_SIZE, BENCH_FLAG_IRQ_OFF};
+  bench_config_t cfg_cpu = {"crc32_cpu_1k", 2, 15, TEST_BUF_SIZE, BENCH_FLAG_IRQ_OFF};
+  bench_config_t cfg_dma = {"crc32_dma_1k", 2, 15, TEST_BUF_SIZE, 0};
+  bench_result_t r_sw, r_cpu, r_dma;
+
+  printf("[TEST] Software vs CPU feed vs DMA feed\r\n");
+
+  bench_init();
+  bench_report_header();
+  if (bench_run(&cfg_sw, bench_fn_sw, s_buf, &r_sw) != BENCH_OK ||
+      bench_run(&cfg_cpu, bench_fn_cpu, s_buf, &r_cpu) != BENCH_OK ||
+      bench_run(&cfg_dma, bench_fn_dma, s_buf, &r_dma) != BENCH_OK) {
+    printf("  [FAIL] bench_run\r\n");
+    return TEST_FAIL;
+  }
+  bench_report(&r_sw);
+  bench_report(&r_cpu);
+  bench_report(&r_dma);
+
+  if (r_cpu.median >= r_sw.median || r_dma.median >= r_sw.median) {
+    printf("  [FAIL] CRC unit not faster than software\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu / %lu / %lu %s per KB\r\n", (unsigned long)r_sw.median,
+         (unsigned long)r_cpu.median, (unsigned long)r_dma.median, bench_unit());
+  return TEST_PASS;
+}
+
+/**
+ * @brief  W25Q32 区域校验
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_w25q32(void) {
+  W25Q32_State_t state;
+  uint8_t *bytes = (uint8_t *)s_buf;
+  uint32_t expected, dma, cpu, shifted;
+  uint32_t done = 0;
+
+  printf("[TEST] W25Q32 region CRC\r\n");
+
+  if (W25Q32_Init(&state) != W25Q32_OK ||
+      W25Q32_SectorErase_4KB(TEST_FLASH_ADDR / W25Q32_SECTOR_SIZE) != W25Q32_OK) {
+    printf("  [FAIL] W25Q32 init / erase\r\n");
+    return TEST_FAIL;
+  }
+
+  for (uint32_t i = 0; i < TEST_FLASH_SIZE; i++) {
+    bytes[i] = (uint8_t)test_rand();
+  }
+  while (done < TEST_FLASH_SIZE) {
+    uint32_t n = TEST_FLASH_SIZE - done;
+    if (n > W25Q32_PAGE_SIZE) {
+      n = W25Q32_PAGE_SIZE;
+    }
+    if (W25Q32_PageProgram((TEST_FLASH_ADDR + done) / W25Q32_PAGE_SIZE, 0,
+                           bytes + done, n) != W25Q32_OK) {
+      printf("  [FAIL] Page program\r\n");
+      return TEST_FAIL;
+    }
+    done += n;
+  }
+  expected = crc32_sw(CRC32_INIT, bytes, TEST_FLASH_SIZE);
+
+  if (W25Q32_ReadCRC(TEST_FLASH_ADDR, TEST_FLASH_SIZE, &dma) != W25Q32_OK ||
+      W25Q32_ReadCRC(TEST_FLASH_ADDR + 1U, TEST_FLASH_SIZE, &shifted) != W25Q32_OK) {
+    printf("  [FAIL] W25Q32_ReadCRC\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 不占用 DMA 通道时由 CPU 送数 */
+  crc32_deinit();
+  if (W25Q32_ReadCRC(TEST_FLASH_ADDR, TEST_FLASH_SIZE, &cpu) != W25Q32_OK ||
+      crc32_init() != CRC32_OK) {
+    printf("  [FAIL] W25Q32_ReadCRC without DMA\r\n");
+    return TEST_FAIL;
+  }
+
+  if (dma != expected || cpu != expected || shifted == expected) {
+    printf("  [FAIL] expected %08lx dma %08lx cpu %08lx shifted %08lx\r\n",
+           (unsigned long)expected, (unsigned long)dma, (unsigned long)cpu,
+           (unsigned long)shifted);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %u bytes, CRC %08lx\r\n", (unsigned)TEST_FLASH_SIZE,
+         (unsigned long)expected);
+  return TEST_PASS;
+}
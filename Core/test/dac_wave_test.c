@@ -0,0 +1,570 @@
+/**
+ * @file    dac_wave_test.c
+ * @brief   DAC 波形发生器测试文件
+ * @note    1. 表生成：各波形的关键点，len / cycles 翻倍后的表等于原表重复两次
+ *             （相位累加没有误差）
+ *          2. 频率方案：实际频率与目标的误差，Nyquist 与最低频率边界
+ *          3. 输出频率：回放 1234 Hz 正弦，按上升过零点测得的频率与方案一致，
+ *             相邻输出间隔恒为一个采样周期
+ *          4. 无缝换表：旧表最后一个采样之后紧接新表第一个采样，间隔不变；
+ *             等待表尾期间再次换表返回 BUSY；同长度换表（在半张表之后才
+ *             请求）DMA 不重启，之后只开 TE 中断
+ *          5. 参数检查、停止后输出保持、DMA 通道被占用
+ *          6. 引脚：init 不改 GPIOA 配置，只回放通道 1 时 PA5（SPI1_SCK）
+ *             不变，deinit 后两个引脚恢复原来的配置
+ *          仿真中由 DAC 模型的输出日志检查时序；目标板上只检查返回值
+ */
+
+#include "dac_wave_test.h"
+#include "dac_wave.h"
+#include "dma_manager.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_RATE_HZ 100000U
+#define TEST_SAMPLE_CYCLES (DAC_WAVE_TIM_CLK / TEST_RATE_HZ)
+#define TEST_TONE_HZ 1234U
+#define TEST_TONE_MS 200U
+#define TEST_AMPLITUDE 2000U
+#define TEST_OFFSET 2048U
+#define TEST_LOG_CHUNK 256
+#define TEST_TABLE_A 500U /* 5 ms 一圈，换表调用不会碰上表尾 */
+#define TEST_TABLE_B 3U
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint16_t s_table[2U * DAC_WAVE_MAX_LEN];
+static uint16_t s_table2[2U * DAC_WAVE_MAX_LEN];
+
+#if defined(STM32_HOST_BUILD)
+static uint16_t s_value[TEST_LOG_CHUNK];
+static uint64_t s_when[TEST_LOG_CHUNK];
+#endif
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int test_pins(uint32_t crl);
+static int test_synth(void);
+static int test_plan(void);
+static int test_tone(void);
+static int test_swap(void);
+static int test_refill(void);
+static int test_errors(void);
+#if defined(STM32_HOST_BUILD)
+static void test_drain(int ch);
+static uint32_t test_follow(uint32_t len_a, uint32_t len_b, uint32_t *samples,
+                            uint32_t *seen_b);
+#endif
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 DAC 波形发生器测试
+ */
+void DAC_Wave_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         DAC Wave Test Suite            \r\n");
+  printf("========================================\r\n");
+
+  uint32_t crl = GPIOA->CRL;
+
+  if (dac_wave_init(TEST_RATE_HZ) != DAC_WAVE_OK) {
+    printf("  [FAIL] dac_wave_init (DMA channel already claimed)\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result0 = test_pins(crl);
+  int result1 = test_synth();
+  int result2 = test_plan();
+  int result3 = test_tone();
+  int result4 = test_swap();
+  int result5 = test_refill();
+  int result6 = test_errors();
+
+  dac_wave_deinit();
+  if (GPIOA->CRL != crl) {
+    printf("  [FAIL] GPIOA CRL 0x%08lX after deinit, was 0x%08lX\r\n",
+           (unsigned long)GPIOA->CRL, (unsigned long)crl);
+    result0 = TEST_FAIL;
+  }
+
+  if (result0 == TEST_PASS && result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS && result6 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  引脚只在通道回放时占用
+ * @param  crl: dac_wave_init 之前的 GPIOA->CRL
+ */
+static int test_pins(uint32_t crl) {
+  const uint32_t pa4 = 0xFUL << 16, pa5 = 0xFUL << 20;
+
+  printf("\r\n[TEST] Pins claimed on first play\r\n");
+
+  if (GPIOA->CRL != crl) {
+    printf("  [FAIL] dac_wave_init changed GPIOA CRL to 0x%08lX\r\n",
+           (unsigned long)GPIOA->CRL);
+    return TEST_FAIL;
+  }
+
+  dac_wave_synth(s_table, 100, 1, DAC_WAVE_SHAPE_SINE, TEST_AMPLITUDE, TEST_OFFSET);
+  if (dac_wave_play(DAC_WAVE_CH1, s_table, 100) != DAC_WAVE_OK) {
+    printf("  [FAIL] dac_wave_play\r\n");
+    return TEST_FAIL;
+  }
+  dac_wave_stop(DAC_WAVE_CH1);
+  /* PA4 模拟模式（CNF = MODE = 0），PA5 保持原样 */
+  if ((GPIOA->CRL & pa4) != 0U || (GPIOA->CRL & pa5) != (crl & pa5)) {
+    printf("  [FAIL] GPIOA CRL 0x%08lX after playing channel 1\r\n",
+           (unsigned long)GPIOA->CRL);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] PA4 analog, PA5 (SPI1_SCK) untouched\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  表生成
+ */
+static int test_synth(void) {
+  printf("\r\n[TEST] Table synthesis\r\n");
+
+  /* 正弦：0 / 90 / 180 / 270 度 */
+  dac_wave_synth(s_table, 256, 1, DAC_WAVE_SHAPE_SINE, TEST_AMPLITUDE, TEST_OFFSET);
+  if (s_table[0] != TEST_OFFSET || s_table[64] != TEST_OFFSET + TEST_AMPLITUDE ||
+      s_table[128] != TEST_OFFSET || s_table[192] != TEST_OFFSET - TEST_AMPLITUDE) {
+    printf("  [FAIL] sine %u/%u/%u/%u\r\n", s_table[0], s_table[64], s_table[128],
+           s_table[192]);
+    return TEST_FAIL;
+  }
+
+  /* 三角：从最低点开始，半周期处最高 */
+  dac_wave_synth(s_table, 100, 1, DAC_WAVE_SHAPE_TRIANGLE, TEST_AMPLITUDE, TEST_OFFSET);
+  if (s_table[0] != TEST_OFFSET - TEST_AMPLITUDE ||
+      s_table[50] != TEST_OFFSET + TEST_AMPLITUDE || s_table[25] != TEST_OFFSET) {
+    printf("  [FAIL] triangle %u/%u/%u\r\n", s_table[0], s_table[25], s_table[50]);
+    return TEST_FAIL;
+  }
+
+  /* 锯齿单调上升；方波前半高后半低 */
+  dac_wave_synth(s_table, 100, 1, DAC_WAVE_SHAPE_SAW, TEST_AMPLITUDE, TEST_OFFSET);
+  for (uint32_t i = 1; i < 100U; i++) {
+    if (s_table[i] <= s_table[i - 1U]) {
+      printf("  [FAIL] saw not rising at %lu\r\n", (unsigned long)i);
+      return TEST_FAIL;
+    }
+  }
+  dac_wave_synth(s_table, 100, 1, DAC_WAVE_SHAPE_SQUARE, TEST_AMPLITUDE, TEST_OFFSET);
+  if (s_table[49] != TEST_OFFSET + TEST_AMPLITUDE || s_table[50] != TEST_OFFSET - TEST_AMPLITUDE) {
+    printf("  [FAIL] square %u/%u\r\n", s_table[49], s_table[50]);
+    return TEST_FAIL;
+  }
+
+  /* 超出满量程的部分被削平 */
+  dac_wave_synth(s_table, 4, 1, DAC_WAVE_SHAPE_SQUARE, 2048U, 4000U);
+  if (s_table[0] != DAC_WAVE_FULL_SCALE || s_table[2] != 4000U - 2048U) {
+    printf("  [FAIL] clipping %u/%u\r\n", s_table[0], s_table[2]);
+    return TEST_FAIL;
+  }
+
+  /* 7 个采样 3 个周期：14 个采样 6 个周期的表必须是它重复两次 */
+  dac_wave_synth(s_table, 7, 3, DAC_WAVE_SHAPE_SINE, TEST_AMPLITUDE, TEST_OFFSET);
+  dac_wave_synth(s_table2, 14, 6, DAC_WAVE_SHAPE_SINE, TEST_AMPLITUDE, TEST_OFFSET);
+  for (uint32_t i = 0; i < 14U; i++) {
+    if (s_table2[i] != s_table[i % 7U]) {
+      printf("  [FAIL] phase drift at sample %lu\r\n", (unsigned long)i);
+      return TEST_FAIL;
+    }
+  }
+
+  printf("  [PASS] shapes, clipping and exact wrap\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  频率方案
+ */
+static int test_plan(void) {
+  static const uint32_t freqs[] = {1234U, 440U, 1000U, 7777U, 20000U};
+  dac_wave_plan_t plan;
+
+  printf("\r\n[TEST] Frequency plan\r\n");
+
+  if (dac_wave_rate_mhz() != 1000ULL * TEST_RATE_HZ) {
+    printf("  [FAIL] sample rate %lu mHz\r\n", (unsigned long)dac_wave_rate_mhz());
+    return TEST_FAIL;
+  }
+
+  for (uint32_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++) {
+    uint64_t target = 1000ULL * freqs[i];
+    uint64_t diff;
+
+    if (dac_wave_plan(freqs[i], DAC_WAVE_MAX_LEN, &plan) != DAC_WAVE_OK) {
+      printf("  [FAIL] plan %lu Hz\r\n", (unsigned long)freqs[i]);
+      return TEST_FAIL;
+    }
+    diff = (plan.freq_mhz > target) ? plan.freq_mhz - target : target - plan.freq_mhz;
+    /* 表长不超过 512 时，误差不超过 0.2% */
+    if (diff * 500U > target || 2U * plan.cycles > plan.len) {
+      printf("  [FAIL] %lu Hz -> %u samples / %u cycles = %lu mHz\r\n",
+             (unsigned long)freqs[i], plan.len, plan.cycles, (unsigned long)plan.freq_mhz);
+      return TEST_FAIL;
+    }
+    printf("  %5lu Hz -> %3u samples / %3u cycles = %lu mHz\r\n", (unsigned long)freqs[i],
+           plan.len, plan.cycles, (unsigned long)plan.freq_mhz);
+  }
+
+  /* 整除的频率没有误差 */
+  if (dac_wave_plan(1000U, DAC_WAVE_MAX_LEN, &plan) != DAC_WAVE_OK ||
+      plan.freq_mhz != 1000000U || plan.len * 1000U != plan.cycles * TEST_RATE_HZ) {
+    printf("  [FAIL] 1000 Hz not exact\r\n");
+    return TEST_FAIL;
+  }
+
+  /* Nyquist 边界；512 个采样放不下 1 Hz 的一个周期 */
+  if (dac_wave_plan(TEST_RATE_HZ / 2U, DAC_WAVE_MAX_LEN, &plan) != DAC_WAVE_OK ||
+      plan.len != 2U * plan.cycles ||
+      dac_wave_plan(TEST_RATE_HZ / 2U + 1U, DAC_WAVE_MAX_LEN, &plan) != DAC_WAVE_PARAM_ERROR ||
+      dac_wave_plan(1U, DAC_WAVE_MAX_LEN, &plan) != DAC_WAVE_PARAM_ERROR ||
+      dac_wave_plan(1000U, 1U, &plan) != DAC_WAVE_PARAM_ERROR) {
+    printf("  [FAIL] plan limits\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] plans within 0.2%%, limits rejected\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  输出频率
+ */
+static int test_tone(void) {
+  dac_wave_plan_t plan;
+
+  printf("\r\n[TEST] Tone output frequency\r\n");
+
+  if (dac_wave_tone(DAC_WAVE_CH1, TEST_TONE_HZ, DAC_WAVE_SHAPE_SINE, TEST_AMPLITUDE, TEST_OFFSET,
+                    &plan) != DAC_WAVE_OK ||
+      !dac_wave_playing(DAC_WAVE_CH1)) {
+    printf("  [FAIL] dac_wave_tone\r\n");
+    return TEST_FAIL;
+  }
+
+#if defined(STM32_HOST_BUILD)
+  uint64_t first = 0, last = 0, prev_when = 0;
+  uint32_t crossings = 0, gaps = 0, samples = 0;
+  uint16_t prev = 0;
+
+  test_drain(1);
+  for (uint32_t ms = 0; ms < TEST_TONE_MS; ms++) {
+    int n;
+
+    HAL_Delay(1);
+    while ((n = sim_dac_log(1, s_value, s_when, TEST_LOG_CHUNK)) > 0) {
+      for (int i = 0; i < n; i++) {
+        if (samples > 0) {
+          if (s_when[i] - prev_when != TEST_SAMPLE_CYCLES) {
+            gaps++;
+          }
+          if (prev < TEST_OFFSET && s_value[i] >= TEST_OFFSET) {
+            if (crossings == 0) {
+              first = s_when[i];
+            }
+            last = s_when[i];
+            crossings++;
+          }
+        }
+        prev = s_value[i];
+        prev_when = s_when[i];
+        samples++;
+      }
+    }
+  }
+
+  /* 测得的频率（mHz）与方案一致，误差不超过 0.02% */
+  uint64_t measured = (crossings > 1U)
+                          ? ((uint64_t)(crossings - 1U) * DAC_WAVE_TIM_CLK * 1000U +
+                             (last - first) / 2U) / (last - first)
+                          : 0U;
+  uint64_t diff = (measured > plan.freq_mhz) ? measured - plan.freq_mhz : plan.freq_mhz - measured;
+
+  if (gaps != 0 || samples < TEST_TONE_MS * (TEST_RATE_HZ / 1000U) - 10U ||
+      diff * 5000U > plan.freq_mhz) {
+    printf("  [FAIL] %lu samples, %lu gaps, measured %lu mHz vs plan %lu mHz\r\n",
+           (unsigned long)samples, (unsigned long)gaps, (unsigned long)measured,
+           (unsigned long)plan.freq_mhz);
+    dac_wave_stop(DAC_WAVE_CH1);
+    return TEST_FAIL;
+  }
+  printf("  %lu samples, %lu crossings, measured %lu mHz (plan %lu mHz)\r\n",
+         (unsigned long)samples, (unsigned long)crossings, (unsigned long)measured,
+         (unsigned long)plan.freq_mhz);
+#endif
+
+  dac_wave_stop(DAC_WAVE_CH1);
+  printf("  [PASS] tone at planned frequency, even sample spacing\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  无缝换表
+ */
+static int test_swap(void) {
+  printf("\r\n[TEST] Seamless table swap\r\n");
+
+  for (uint32_t i = 0; i < TEST_TABLE_A; i++) {
+    s_table[i] = (uint16_t)(1000U + i);
+  }
+  for (uint32_t i = 0; i < TEST_TABLE_B; i++) {
+    s_table2[i] = (uint16_t)(3000U + i);
+  }
+
+  if (dac_wave_play(DAC_WAVE_CH2, s_table, TEST_TABLE_A) != DAC_WAVE_OK) {
+    printf("  [FAIL] dac_wave_play\r\n");
+    return TEST_FAIL;
+  }
+#if defined(STM32_HOST_BUILD)
+  test_drain(2);
+#endif
+  HAL_Delay(2);
+
+  int r1 = dac_wave_swap(DAC_WAVE_CH2, s_table2, TEST_TABLE_B);
+  uint8_t pending = dac_wave_swap_pending(DAC_WAVE_CH2);
+  int r2 = dac_wave_swap(DAC_WAVE_CH2, s_table, TEST_TABLE_A);
+  int r3 = dac_wave_tone(DAC_WAVE_CH2, 1000U, DAC_WAVE_SHAPE_SINE, 100U, TEST_OFFSET, NULL);
+  if (r1 != DAC_WAVE_OK || !pending || r2 != DAC_WAVE_BUSY || r3 != DAC_WAVE_BUSY) {
+    printf("  [FAIL] swap %d, pending %u, second swap %d, tone %d\r\n", r1, pending, r2, r3);
+    dac_wave_stop(DAC_WAVE_CH2);
+    return TEST_FAIL;
+  }
+
+#if defined(STM32_HOST_BUILD)
+  uint32_t samples, seen_b;
+  uint32_t errors = test_follow(TEST_TABLE_A, TEST_TABLE_B, &samples, &seen_b);
+
+  if (errors != 0 || seen_b < 100U || dac_wave_swap_pending(DAC_WAVE_CH2)) {
+    printf("  [FAIL] %lu samples, %lu from new table, %lu order errors / gaps\r\n",
+           (unsigned long)samples, (unsigned long)seen_b, (unsigned long)errors);
+    dac_wave_stop(DAC_WAVE_CH2);
+    return TEST_FAIL;
+  }
+  printf("  %lu samples, switched after A[%u] -> B[0], no gaps\r\n", (unsigned long)samples,
+         TEST_TABLE_A - 1U);
+#else
+  HAL_Delay(8);
+  if (dac_wave_swap_pending(DAC_WAVE_CH2)) {
+    printf("  [FAIL] swap still pending\r\n");
+    dac_wave_stop(DAC_WAVE_CH2);
+    return TEST_FAIL;
+  }
+#endif
+
+  dac_wave_stop(DAC_WAVE_CH2);
+  printf("  [PASS] new table starts right after the old one ends\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  同长度换表：循环 DMA 不停，HT / TC 中改写半张表
+ */
+static int test_refill(void) {
+  DMA_ChannelStats_t before, after;
+  DMA_Channel_TypeDef *dma = DMA_GetInstance(DMA_CH_DMA2_4);
+
+  printf("\r\n[TEST] Same-length swap refills the running buffer\r\n");
+
+  for (uint32_t i = 0; i < TEST_TABLE_A; i++) {
+    s_table[i] = (uint16_t)(1000U + i);
+    s_table2[i] = (uint16_t)(2000U + i);
+  }
+
+  if (dac_wave_play(DAC_WAVE_CH2, s_table, TEST_TABLE_A) != DAC_WAVE_OK) {
+    printf("  [FAIL] dac_wave_play\r\n");
+    return TEST_FAIL;
+  }
+#if defined(STM32_HOST_BUILD)
+  test_drain(2);
+#endif
+  /* 已过半张表：这一圈的 TC 不能改写，要等下一个 HT */
+  HAL_Delay(3);
+  DMA_GetStats(DMA_CH_DMA2_4, &before);
+  if (dac_wave_swap(DAC_WAVE_CH2, s_table2, TEST_TABLE_A) != DAC_WAVE_OK ||
+      !dac_wave_swap_pending(DAC_WAVE_CH2)) {
+    printf("  [FAIL] dac_wave_swap\r\n");
+    dac_wave_stop(DAC_WAVE_CH2);
+    return TEST_FAIL;
+  }
+
+#if defined(STM32_HOST_BUILD)
+  uint32_t samples, seen_b;
+  uint32_t errors = test_follow(TEST_TABLE_A, TEST_TABLE_A, &samples, &seen_b);
+#else
+  uint32_t samples = 0, errors = 0;
+  HAL_Delay(13);
+#endif
+  DMA_GetStats(DMA_CH_DMA2_4, &after);
+
+  if (errors != 0 || dac_wave_swap_pending(DAC_WAVE_CH2) ||
+      after.started != before.started ||
+      (dma->CCR & (DMA_CCR_TEIE | DMA_CCR_HTIE | DMA_CCR_TCIE)) != DMA_CCR_TEIE) {
+    printf("  [FAIL] %lu samples, %lu errors, restarts %lu, CCR 0x%03lX\r\n",
+           (unsigned long)samples, (unsigned long)errors,
+           (unsigned long)(after.started - before.started), (unsigned long)dma->CCR);
+    dac_wave_stop(DAC_WAVE_CH2);
+    return TEST_FAIL;
+  }
+#if defined(STM32_HOST_BUILD)
+  if (seen_b < TEST_TABLE_A) {
+    printf("  [FAIL] only %lu samples from the new table\r\n", (unsigned long)seen_b);
+    dac_wave_stop(DAC_WAVE_CH2);
+    return TEST_FAIL;
+  }
+  printf("  %lu samples, %lu from new table\r\n", (unsigned long)samples,
+         (unsigned long)seen_b);
+#endif
+
+  dac_wave_stop(DAC_WAVE_CH2);
+  printf("  [PASS] switched at the table end without restarting DMA, TE kept on\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  参数检查、停止后保持、DMA 通道被占用
+ */
+static int test_errors(void) {
+  printf("\r\n[TEST] Parameter checks, stop and channel claim\r\n");
+
+  int r1 = dac_wave_play(DAC_WAVE_CH1, s_table, 0);
+  int r2 = dac_wave_play(DAC_WAVE_CH1, s_table, DAC_WAVE_MAX_LEN + 1U);
+  int r3 = dac_wave_play(DAC_WAVE_COUNT, s_table, 4);
+  int r4 = dac_wave_tone(DAC_WAVE_CH1, 1000U, DAC_WAVE_SHAPE_SINE, 2049U, TEST_OFFSET, NULL);
+  int r5 = dac_wave_tone(DAC_WAVE_CH1, TEST_RATE_HZ, DAC_WAVE_SHAPE_SINE, 100U, TEST_OFFSET, NULL);
+  if (r1 != DAC_WAVE_PARAM_ERROR || r2 != DAC_WAVE_PARAM_ERROR || r3 != DAC_WAVE_PARAM_ERROR ||
+      r4 != DAC_WAVE_PARAM_ERROR || r5 != DAC_WAVE_PARAM_ERROR ||
+      dac_wave_playing(DAC_WAVE_CH1)) {
+    printf("  [FAIL] bad arguments returned %d/%d/%d/%d/%d\r\n", r1, r2, r3, r4, r5);
+    return TEST_FAIL;
+  }
+
+  /* 停止后输出保持最后一个值 */
+  if (dac_wave_tone(DAC_WAVE_CH1, 1000U, DAC_WAVE_SHAPE_SAW, TEST_AMPLITUDE, TEST_OFFSET, NULL) !=
+      DAC_WAVE_OK) {
+    printf("  [FAIL] dac_wave_tone\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay(1);
+  dac_wave_stop(DAC_WAVE_CH1);
+#if defined(STM32_HOST_BUILD)
+  uint16_t held = (uint16_t)DAC->DOR1;
+  uint32_t changed = 0;
+  int n;
+
+  test_drain(1);
+  HAL_Delay(1);
+  while ((n = sim_dac_log(1, s_value, NULL, TEST_LOG_CHUNK)) > 0) {
+    for (int i = 0; i < n; i++) {
+      if (s_value[i] != held) {
+        changed++;
+      }
+    }
+  }
+  if (changed != 0 || DAC->DOR1 != held) {
+    printf("  [FAIL] output moved %lu times after stop\r\n", (unsigned long)changed);
+    return TEST_FAIL;
+  }
+#endif
+  if (dac_wave_playing(DAC_WAVE_CH1)) {
+    printf("  [FAIL] still playing after stop\r\n");
+    return TEST_FAIL;
+  }
+
+  /* DMA2 通道 3 被其他驱动占用时初始化失败，通道 4 不被留下 */
+  dac_wave_deinit();
+  int r6 = dac_wave_init(0);
+  int r7 = dac_wave_init(DAC_WAVE_MAX_RATE + 1U);
+  if (r6 != DAC_WAVE_PARAM_ERROR || r7 != DAC_WAVE_PARAM_ERROR ||
+      DMA_Claim(DMA_CH_DMA2_3, "other") != DMA_MGR_OK ||
+      dac_wave_init(TEST_RATE_HZ) != DAC_WAVE_BUSY || DMA_GetOwner(DMA_CH_DMA2_4) != NULL) {
+    printf("  [FAIL] init with DMA2 channel 3 claimed\r\n");
+    return TEST_FAIL;
+  }
+  DMA_Release(DMA_CH_DMA2_3);
+  if (dac_wave_init(TEST_RATE_HZ) != DAC_WAVE_OK ||
+      dac_wave_play(DAC_WAVE_CH1, s_table, 4) != DAC_WAVE_OK) {
+    printf("  [FAIL] init after release\r\n");
+    return TEST_FAIL;
+  }
+  dac_wave_stop(DAC_WAVE_CH1);
+
+  printf("  [PASS] bad arguments rejected, output held, claim conflict detected\r\n");
+  return TEST_PASS;
+}
+
+#if defined(STM32_HOST_BUILD)
+/**
+ * @brief  丢弃通道 ch 已记录的输出
+ */
+static void test_drain(int ch) {
+  while (sim_dac_log(ch, s_value, NULL, TEST_LOG_CHUNK) > 0) {
+  }
+}
+
+/**
+ * @brief  跟踪通道 2 接下来 16 ms 的输出：s_table 循环（从表尾预装开始），
+ *         第一次出现 s_table2[0] 之后按 s_table2 循环
+ * @param  samples / seen_b: 输出总数、来自新表的个数
+ * @retval 顺序错误和间隔不等于一个采样周期的次数之和
+ */
+static uint32_t test_follow(uint32_t len_a, uint32_t len_b, uint32_t *samples,
+                            uint32_t *seen_b) {
+  uint32_t expect_a = len_a - 1U, expect_b = 0, in_b = 0, errors = 0;
+  uint64_t prev_when = 0;
+
+  *samples = 0;
+  *seen_b = 0;
+  for (uint32_t ms = 0; ms < 16U; ms++) {
+    int n;
+
+    HAL_Delay(1);
+    while ((n = sim_dac_log(2, s_value, s_when, TEST_LOG_CHUNK)) > 0) {
+      for (int i = 0; i < n; i++) {
+        if (*samples > 0 && s_when[i] - prev_when != TEST_SAMPLE_CYCLES) {
+          errors++;
+        }
+        prev_when = s_when[i];
+        (*samples)++;
+
+        if (!in_b && s_value[i] == s_table2[0]) {
+          /* 只能紧接在 A 的最后一个采样之后 */
+          if (expect_a != 0U) {
+            errors++;
+          }
+          in_b = 1;
+        }
+        if (in_b) {
+          if (s_value[i] != s_table2[expect_b]) {
+            errors++;
+          }
+          expect_b = (expect_b + 1U) % len_b;
+          (*seen_b)++;
+        } else {
+          if (s_value[i] != s_table[expect_a]) {
+            errors++;
+          }
+          expect_a = (expect_a + 1U) % len_a;
+        }
+      }
+    }
+  }
+  return errors;
+}
+#endif
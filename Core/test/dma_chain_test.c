@@ -0,0 +1,388 @@
+/**
+ * @file    dma_chain_test.c
+ * @brief   DMA 描述符链测试文件
+ * @note    1. 寄存器模型：由测试代码扮演 DMA 硬件，检查每段写入的
+ *             CPAR/CMAR/CNDTR/增量位，并测量 TC 到下一段使能的间隔
+ *          2. 寄存器模型：传输错误时中止整条链
+ *          3. 真实硬件：MEM2MEM 通道把分散的缓冲区聚合到一块，
+ *             与单次整块传输比较得到每段的平均空闲周期
+ */
+
+#include "dma_chain_test.h"
+#include "dma_chain.h"
+#include "bench.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_SEG_COUNT 8
+#define TEST_SEG_LEN 64
+
+/* DMA 寄存器模型 ------------------------------------------------------------*/
+static DMA_TypeDef s_model_dma1;
+static DMA_TypeDef s_model_dma2;
+static DMA_Channel_TypeDef s_model_dma1_ch[7];
+static DMA_Channel_TypeDef s_model_dma2_ch[5];
+
+/** 模型中每段启动时的寄存器快照 */
+typedef struct {
+  uint32_t ccr;
+  uint32_t cpar;
+  uint32_t cmar;
+  uint32_t cndtr;
+} test_seg_log_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static test_seg_log_t s_log[TEST_SEG_COUNT];
+static uint32_t s_log_count = 0;
+static volatile uint32_t s_tc_cycles = 0;
+static volatile uint32_t s_gap_max = 0;
+static volatile uint32_t s_gap_min = 0xFFFFFFFFU;
+static volatile uint32_t s_desc_done = 0;
+static volatile uint32_t s_chain_done = 0;
+static volatile int s_chain_status = 0;
+
+static uint8_t s_src[TEST_SEG_COUNT][TEST_SEG_LEN + 4];
+static uint8_t s_dst[TEST_SEG_COUNT * TEST_SEG_LEN + 16];
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int test_chain_model(void);
+static int test_chain_model_error(void);
+static int test_chain_hw_gather(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 DMA 描述符链测试
+ */
+void DMA_Chain_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("     DMA Descriptor Chain Test Suite    \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  int result1 = test_chain_model();
+  int result2 = test_chain_model_error();
+  int result3 = test_chain_hw_gather();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  重置寄存器模型并绑定到管理器
+ */
+static void test_model_attach(void) {
+  memset(&s_model_dma1, 0, sizeof(s_model_dma1));
+  memset(&s_model_dma2, 0, sizeof(s_model_dma2));
+  memset(s_model_dma1_ch, 0, sizeof(s_model_dma1_ch));
+  memset(s_model_dma2_ch, 0, sizeof(s_model_dma2_ch));
+  DMA_Manager_AttachModel(&s_model_dma1, s_model_dma1_ch, &s_model_dma2,
+                          s_model_dma2_ch);
+  s_log_count = 0;
+  s_desc_done = 0;
+  s_chain_done = 0;
+  s_gap_max = 0;
+  s_gap_min = 0xFFFFFFFFU;
+}
+
+/**
+ * @brief  释放模型上的通道，管理器恢复到实际寄存器
+ */
+static void test_model_detach(void) {
+  DMA_Release(DMA_CH_DMA1_2);
+  DMA_Manager_Init();
+}
+
+/**
+ * @brief  模型“硬件”执行一步：通道 2 使能时记录寄存器、完成传输并触发中断
+ * @param  flag: 要产生的事件（DMA_ISR_TCIF1 或 DMA_ISR_TEIF1）
+ * @retval 1: 执行了一段, 0: 通道未使能
+ */
+static int test_model_step(uint32_t flag) {
+  DMA_Channel_TypeDef *regs = &s_model_dma1_ch[1];
+
+  if ((regs->CCR & DMA_CCR_EN) == 0) {
+    return 0;
+  }
+  if (s_log_count < TEST_SEG_COUNT) {
+    s_log[s_log_count].ccr = regs->CCR;
+    s_log[s_log_count].cpar = regs->CPAR;
+    s_log[s_log_count].cmar = regs->CMAR;
+    s_log[s_log_count].cndtr = regs->CNDTR;
+    s_log_count++;
+  }
+
+  regs->CNDTR = (flag == DMA_ISR_TCIF1) ? 0 : regs->CNDTR / 2;
+  if (flag == DMA_ISR_TEIF1) {
+    regs->CCR &= ~DMA_CCR_EN;
+  }
+  s_model_dma1.ISR = (DMA_ISR_GIF1 | flag) << 4;
+  s_tc_cycles = bench_now();
+  DMA_Manager_IRQHandler(DMA_CH_DMA1_2);
+  s_model_dma1.ISR = 0;
+  return 1;
+}
+
+/**
+ * @brief  描述符回调：下一段已启动，记录 TC 到此刻的周期数作为空闲时间上界
+ */
+static void test_desc_cb(const DMA_Desc_t *desc, void *ctx) {
+  uint32_t gap = bench_now() - s_tc_cycles;
+
+  (void)desc;
+  (void)ctx;
+  if (s_model_dma1_ch[1].CCR & DMA_CCR_EN) {
+    if (gap > s_gap_max) {
+      s_gap_max = gap;
+    }
+    if (gap < s_gap_min) {
+      s_gap_min = gap;
+    }
+  }
+  s_desc_done++;
+}
+
+/**
+ * @brief  整条链完成回调
+ */
+static void test_chain_done(DMA_Chain_t *chain, int status) {
+  (void)chain;
+  s_chain_status = status;
+  s_chain_done++;
+}
+
+/**
+ * @brief  存储器到外设的三段链：命令头 + 数据 + 校验，目的固定为 SPI1->DR
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_chain_model(void) {
+  static const uint8_t hdr[4] = {0x02, 0x00, 0x10, 0x00};
+  static const uint8_t crc[2] = {0xAB, 0xCD};
+  static uint8_t payload[200];
+  const uint32_t dr = 0x4001300C; /* SPI1->DR */
+  DMA_Desc_t desc[3] = {
+      {(uint32_t)hdr, dr, sizeof(hdr), DMA_DESC_DST_FIXED, test_desc_cb},
+      {(uint32_t)payload, dr, sizeof(payload), DMA_DESC_DST_FIXED, NULL},
+      {(uint32_t)crc, dr, sizeof(crc), DMA_DESC_DST_FIXED, test_desc_cb},
+  };
+  DMA_Config_t tmpl;
+  DMA_Chain_t chain;
+  int fail = 0;
+  int i;
+
+  printf("[TEST] Chain on register model (header + payload + crc)\r\n");
+
+  test_model_attach();
+  memset(&tmpl, 0, sizeof(tmpl));
+  tmpl.Direction = DMA_DIR_PeripheralDST_Mem2Per;
+  tmpl.Priority = DMA_Priority_High;
+
+  if (DMA_Chain_Init(&chain, DMA_CH_DMA1_2, &tmpl) != DMA_CHAIN_PARAM_ERROR ||
+      DMA_Claim(DMA_CH_DMA1_2, "chain") != DMA_MGR_OK ||
+      DMA_Chain_Init(&chain, DMA_CH_DMA1_2, &tmpl) != DMA_CHAIN_OK) {
+    printf("  [FAIL] Init requires a claimed channel\r\n");
+    fail++;
+  }
+
+  if (DMA_Chain_Start(&chain, desc, 3, test_chain_done, NULL) != DMA_CHAIN_OK ||
+      DMA_Chain_Start(&chain, desc, 3, NULL, NULL) != DMA_CHAIN_BUSY) {
+    printf("  [FAIL] Start\r\n");
+    fail++;
+  }
+
+  while (test_model_step(DMA_ISR_TCIF1)) {
+  }
+
+  if (s_log_count != 3 || s_chain_done != 1 || s_chain_status != DMA_CHAIN_OK ||
+      s_desc_done != 2 || DMA_Chain_IsBusy(&chain)) {
+    printf("  [FAIL] segments=%lu done=%lu desc_cb=%lu\r\n",
+           (unsigned long)s_log_count, (unsigned long)s_chain_done,
+           (unsigned long)s_desc_done);
+    fail++;
+  }
+
+  for (i = 0; i < 3 && i < (int)s_log_count; i++) {
+    uint32_t ccr = s_log[i].ccr;
+    if (s_log[i].cpar != dr || s_log[i].cmar != desc[i].src ||
+        s_log[i].cndtr != desc[i].len || (ccr & DMA_CCR_DIR) == 0 ||
+        (ccr & DMA_CCR_PINC) != 0 || (ccr & DMA_CCR_MINC) == 0 ||
+        (ccr & (DMA_CCR_TCIE | DMA_CCR_TEIE)) != (DMA_CCR_TCIE | DMA_CCR_TEIE) ||
+        (ccr & DMA_CCR_PL) != DMA_CCR_PL_1) {
+      printf("  [FAIL] Segment %d registers\r\n", i);
+      fail++;
+    }
+  }
+
+  /* 零长度描述符会让链停住，必须拒绝 */
+  desc[1].len = 0;
+  if (DMA_Chain_Start(&chain, desc, 3, NULL, NULL) != DMA_CHAIN_PARAM_ERROR) {
+    printf("  [FAIL] Zero-length descriptor accepted\r\n");
+    fail++;
+  }
+
+  test_model_detach();
+  if (fail == 0) {
+    printf("  [PASS] 3 segments reprogrammed, gap %lu-%lu cycles TC->EN\r\n",
+           (unsigned long)s_gap_min, (unsigned long)s_gap_max);
+    return TEST_PASS;
+  }
+  return TEST_FAIL;
+}
+
+/**
+ * @brief  第二段发生传输错误、或下一段无法启动时整条链以 DMA_CHAIN_ERROR 结束
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_chain_model_error(void) {
+  static uint8_t buf[3][16];
+  DMA_Desc_t desc[3] = {
+      {(uint32_t)buf[0], 0x40013804, 16, DMA_DESC_DST_FIXED, NULL},
+      {(uint32_t)buf[1], 0x40013804, 16, DMA_DESC_DST_FIXED, NULL},
+      {(uint32_t)buf[2], 0x40013804, 16, DMA_DESC_DST_FIXED, NULL},
+  };
+  DMA_Config_t tmpl;
+  DMA_Chain_t chain;
+
+  printf("[TEST] Chain aborts on transfer error\r\n");
+
+  test_model_attach();
+  memset(&tmpl, 0, sizeof(tmpl));
+  tmpl.Direction = DMA_DIR_PeripheralDST_Mem2Per;
+  DMA_Claim(DMA_CH_DMA1_2, "chain");
+  DMA_Chain_Init(&chain, DMA_CH_DMA1_2, &tmpl);
+  DMA_Chain_Start(&chain, desc, 3, test_chain_done, NULL);
+
+  test_model_step(DMA_ISR_TCIF1);
+  test_model_step(DMA_ISR_TEIF1);
+
+  test_model_detach();
+  if (s_chain_done != 1 || s_chain_status != DMA_CHAIN_ERROR ||
+      DMA_Chain_IsBusy(&chain) || chain.index != 1 ||
+      (s_model_dma1_ch[1].CCR & DMA_CCR_EN) != 0) {
+    printf("  [FAIL] done=%lu status=%d index=%u\r\n",
+           (unsigned long)s_chain_done, s_chain_status, chain.index);
+    return TEST_FAIL;
+  }
+
+  /* 下一段无法启动（描述符在运行中被改成零长度）时同样以错误结束 */
+  test_model_attach();
+  DMA_Claim(DMA_CH_DMA1_2, "chain");
+  DMA_Chain_Init(&chain, DMA_CH_DMA1_2, &tmpl);
+  desc[1].len = 16;
+  DMA_Chain_Start(&chain, desc, 3, test_chain_done, NULL);
+  desc[1].len = 0;
+
+  test_model_step(DMA_ISR_TCIF1);
+
+  test_model_detach();
+  if (s_chain_done != 1 || s_chain_status != DMA_CHAIN_ERROR ||
+      DMA_Chain_IsBusy(&chain) || chain.index != 0 || s_log_count != 1) {
+    printf("  [FAIL] restart failure: done=%lu status=%d index=%u\r\n",
+           (unsigned long)s_chain_done, s_chain_status, chain.index);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Chain stops with error status on TE and failed restart\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  真实 MEM2MEM 通道上的聚合复制与段间开销
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_chain_hw_gather(void) {
+  static DMA_Desc_t desc[TEST_SEG_COUNT + 1];
+  static const uint8_t fill = 0x5A;
+  DMA_Config_t tmpl;
+  DMA_Chain_t chain;
+  uint32_t t0, chain_cycles, single_cycles;
+  int fail = 0;
+  int i;
+
+  printf("[TEST] Gather copy on DMA1 channel 1 (MEM2MEM)\r\n");
+
+  if (DMA_Claim(DMA_CH_DMA1_1, "chain") != DMA_MGR_OK) {
+    printf("  [FAIL] Claim\r\n");
+    return TEST_FAIL;
+  }
+
+  memset(&tmpl, 0, sizeof(tmpl));
+  tmpl.Direction = DMA_DIR_PeripheralSRC;
+  tmpl.M2M = true;
+  DMA_Chain_Init(&chain, DMA_CH_DMA1_1, &tmpl);
+
+  /* 8 个分散的源块聚合到连续目的区，最后用固定源地址填充 16 字节 */
+  for (i = 0; i < TEST_SEG_COUNT; i++) {
+    for (int k = 0; k < TEST_SEG_LEN; k++) {
+      s_src[i][k] = (uint8_t)(i * 31 + k);
+    }
+    desc[i].src = (uint32_t)s_src[i];
+    desc[i].dst = (uint32_t)&s_dst[i * TEST_SEG_LEN];
+    desc[i].len = TEST_SEG_LEN;
+    desc[i].flags = 0;
+    desc[i].cb = NULL;
+  }
+  desc[TEST_SEG_COUNT].src = (uint32_t)&fill;
+  desc[TEST_SEG_COUNT].dst = (uint32_t)&s_dst[TEST_SEG_COUNT * TEST_SEG_LEN];
+  desc[TEST_SEG_COUNT].len = 16;
+  desc[TEST_SEG_COUNT].flags = DMA_DESC_SRC_FIXED;
+  desc[TEST_SEG_COUNT].cb = NULL;
+
+  memset(s_dst, 0, sizeof(s_dst));
+  s_chain_done = 0;
+  DMA_Chain_Start(&chain, desc, TEST_SEG_COUNT + 1, test_chain_done, NULL);
+  while (DMA_Chain_IsBusy(&chain)) {
+  }
+
+  for (i = 0; i < TEST_SEG_COUNT; i++) {
+    if (memcmp(&s_dst[i * TEST_SEG_LEN], s_src[i], TEST_SEG_LEN) != 0) {
+      fail++;
+    }
+  }
+  for (i = 0; i < 16; i++) {
+    if (s_dst[TEST_SEG_COUNT * TEST_SEG_LEN + i] != fill) {
+      fail++;
+    }
+  }
+  if (fail != 0 || s_chain_done != 1 || s_chain_status != DMA_CHAIN_OK) {
+    printf("  [FAIL] Gather result\r\n");
+    DMA_Release(DMA_CH_DMA1_1);
+    return TEST_FAIL;
+  }
+
+  /* 同样字节数：8 段链 vs 1 段整块，差值 / 7 即每次接续的额外周期 */
+  t0 = bench_now();
+  DMA_Chain_Start(&chain, desc, TEST_SEG_COUNT, NULL, NULL);
+  while (DMA_Chain_IsBusy(&chain)) {
+  }
+  chain_cycles = bench_now() - t0;
+
+  desc[0].len = TEST_SEG_COUNT * TEST_SEG_LEN;
+  desc[0].dst = (uint32_t)s_dst;
+  t0 = bench_now();
+  DMA_Chain_Start(&chain, desc, 1, NULL, NULL);
+  while (DMA_Chain_IsBusy(&chain)) {
+  }
+  single_cycles = bench_now() - t0;
+
+  DMA_Release(DMA_CH_DMA1_1);
+
+  printf("  [PASS] %d segments gathered, chain=%lu single=%lu cycles, "
+         "~%lu cycles per hop\r\n",
+         TEST_SEG_COUNT + 1, (unsigned long)chain_cycles,
+         (unsigned long)single_cycles,
+         (unsigned long)(chain_cycles > single_cycles
+                             ? (chain_cycles - single_cycles) /
+                                   (TEST_SEG_COUNT - 1)
+                             : 0));
+  return TEST_PASS;
+}
@@ -0,0 +1,260 @@
+/**
+ * @file    dma_mem_test.c
+ * @brief   异步 DMA memcpy/memset 测试文件
+ * @note    1. 源/目的各种对齐与长度组合的正确性（含首尾保护字节）
+ *          2. memset 正确性
+ *          3. 超过单段上限时的自动拆分
+ *          4. 请求队列满与完成回调
+ *          5. 64B - 16KB 与 CPU memcpy 的周期数对比
+ */
+
+#include "dma_mem_test.h"
+#include "dma_mem.h"
+#include "bench.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_MAX_BENCH 16384
+#define TEST_GUARD 0xA5
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint8_t s_src[TEST_MAX_BENCH + 8];
+static uint8_t s_dst[TEST_MAX_BENCH + 8];
+static volatile uint32_t s_done_count = 0;
+static volatile int s_last_status = 0;
+static volatile uint32_t s_done_cycles = 0;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void test_done_cb(int status, void *ctx);
+static int test_copy_alignment(void);
+static int test_memset(void);
+static int test_split(void);
+static int test_queue(void);
+static int test_benchmark(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有异步 DMA 内存操作测试
+ */
+void DMA_Mem_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("     DMA memcpy/memset Test Suite       \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  if (dma_mem_init() != DMA_MEM_OK) {
+    printf("  [FAIL] dma_mem_init (channel already claimed)\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result1 = test_copy_alignment();
+  int result2 = test_memset();
+  int result3 = test_split();
+  int result4 = test_queue();
+  int result5 = test_benchmark();
+
+  dma_mem_deinit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  完成回调：记录状态、次数和完成时刻
+ */
+static void test_done_cb(int status, void *ctx) {
+  (void)ctx;
+  s_last_status = status;
+  s_done_count++;
+  s_done_cycles = bench_now();
+}
+
+/**
+ * @brief  检查 dst[off, off+len) 与期望一致，且前后保护字节未被改写
+ */
+static int test_check_region(const uint8_t *expect, uint32_t off, uint32_t len,
+                             uint8_t fill) {
+  for (uint32_t i = 0; i < len; i++) {
+    uint8_t e = expect ? expect[i] : fill;
+    if (s_dst[off + i] != e) {
+      return 0;
+    }
+  }
+  if (off > 0 && s_dst[off - 1] != TEST_GUARD) {
+    return 0;
+  }
+  return s_dst[off + len] == TEST_GUARD;
+}
+
+/**
+ * @brief  源/目的偏移 0-3 与多种长度组合下的复制
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_copy_alignment(void) {
+  static const uint16_t lens[] = {1, 2, 3, 4, 5, 7, 8, 63, 64, 65, 130};
+
+  printf("[TEST] dma_memcpy_async alignment matrix\r\n");
+
+  for (uint32_t i = 0; i < sizeof(s_src); i++) {
+    s_src[i] = (uint8_t)(i * 7 + 3);
+  }
+
+  for (uint32_t so = 0; so < 4; so++) {
+    for (uint32_t d = 0; d < 4; d++) {
+      for (uint32_t k = 0; k < sizeof(lens) / sizeof(lens[0]); k++) {
+        uint32_t doff = d + 4; /* 保证前面有保护字节 */
+        memset(s_dst, TEST_GUARD, 256);
+        s_done_count = 0;
+        if (dma_memcpy_async(&s_dst[doff], &s_src[so], lens[k], test_done_cb,
+                             NULL) != DMA_MEM_OK) {
+          printf("  [FAIL] submit failed\r\n");
+          return TEST_FAIL;
+        }
+        dma_mem_wait();
+        if (s_done_count != 1 || s_last_status != DMA_MEM_OK ||
+            !test_check_region(&s_src[so], doff, lens[k], 0)) {
+          printf("  [FAIL] src+%lu dst+%lu len=%u\r\n", (unsigned long)so,
+                 (unsigned long)d, lens[k]);
+          return TEST_FAIL;
+        }
+      }
+    }
+  }
+
+  printf("  [PASS] 16 alignments x %u lengths\r\n",
+         (unsigned)(sizeof(lens) / sizeof(lens[0])));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  memset 正确性
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_memset(void) {
+  printf("[TEST] dma_memset_async\r\n");
+
+  for (uint32_t d = 0; d < 4; d++) {
+    for (uint32_t len = 1; len < 40; len += 3) {
+      uint32_t doff = d + 4;
+      memset(s_dst, TEST_GUARD, 64);
+      dma_memset_async(&s_dst[doff], 0x3C, len, NULL, NULL);
+      dma_mem_wait();
+      if (!test_check_region(NULL, doff, len, 0x3C)) {
+        printf("  [FAIL] dst+%lu len=%lu\r\n", (unsigned long)d,
+               (unsigned long)len);
+        return TEST_FAIL;
+      }
+    }
+  }
+
+  printf("  [PASS] Fill verified with guard bytes\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  单段上限缩小到 16 个单元，验证大块传输被正确拆分
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_split(void) {
+  DMA_ChannelStats_t stats;
+  int ok;
+
+  printf("[TEST] Automatic split across CNDTR reloads\r\n");
+
+  dma_mem_set_max_units(16);
+  DMA_GetStats(DMA_MEM_CHANNEL, &stats);
+  uint32_t started = stats.started;
+
+  memset(s_dst, TEST_GUARD, 1100);
+  s_done_count = 0;
+  dma_memcpy_async(&s_dst[4], &s_src[0], 1001, test_done_cb, NULL);
+  dma_mem_wait();
+  DMA_GetStats(DMA_MEM_CHANNEL, &stats);
+  dma_mem_set_max_units(0);
+
+  /* 1000 字节按字 16 个一段 = 16 段（最后一段 40 字节），再加 1 字节尾部 */
+  ok = s_done_count == 1 && test_check_region(&s_src[0], 4, 1001, 0) &&
+       stats.started - started == 17;
+  if (!ok) {
+    printf("  [FAIL] segments=%lu\r\n",
+           (unsigned long)(stats.started - started));
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] 1001 bytes in 17 segments, callback once\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  关中断时提交请求，验证队列满和依次完成
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_queue(void) {
+  int ret_full;
+
+  printf("[TEST] Pending-request queue\r\n");
+
+  s_done_count = 0;
+  __disable_irq();
+  for (int i = 0; i < DMA_MEM_QUEUE_LEN; i++) {
+    dma_memcpy_async(&s_dst[i * 64], &s_src[i * 64], 64, test_done_cb, NULL);
+  }
+  ret_full = dma_memcpy_async(s_dst, s_src, 64, test_done_cb, NULL);
+  __enable_irq();
+  dma_mem_wait();
+
+  if (ret_full != DMA_MEM_QUEUE_FULL || s_done_count != DMA_MEM_QUEUE_LEN ||
+      memcmp(s_dst, s_src, DMA_MEM_QUEUE_LEN * 64) != 0) {
+    printf("  [FAIL] full=%d done=%lu\r\n", ret_full,
+           (unsigned long)s_done_count);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %d queued requests completed in order\r\n",
+         DMA_MEM_QUEUE_LEN);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  与 CPU memcpy 的周期数对比
+ * @note   submit 为 CPU 提交请求的开销，total 为提交到完成回调的总时间，
+ *         freed = total - submit 即 DMA 搬运期间 CPU 可用于其他工作的周期
+ * @retval TEST_PASS
+ */
+static int test_benchmark(void) {
+  printf("[TEST] Cycles vs memcpy (word aligned)\r\n");
+  printf("  size   memcpy   submit    total    freed\r\n");
+
+  for (uint32_t size = 64; size <= TEST_MAX_BENCH; size *= 4) {
+    uint32_t t0, cpu, submit, total;
+
+    t0 = bench_now();
+    memcpy(s_dst, s_src, size);
+    cpu = bench_now() - t0;
+
+    s_done_count = 0;
+    t0 = bench_now();
+    dma_memcpy_async(s_dst, s_src, size, test_done_cb, NULL);
+    submit = bench_now() - t0;
+    dma_mem_wait();
+    total = s_done_cycles - t0;
+
+    printf("  %5lu %8lu %8lu %8lu %8lu\r\n", (unsigned long)size,
+           (unsigned long)cpu, (unsigned long)submit, (unsigned long)total,
+           (unsigned long)(total > submit ? total - submit : 0));
+  }
+
+  return TEST_PASS;
+}
@@ -6,6 +6,7 @@
 
 #include "dma_test.h"
 #include "dma.h"
+#include "dma_manager.h"
 #include <string.h>
 
 /* 引用 dma.c 中定义的句柄 */
@@ -19,6 +20,7 @@ extern DMA_HandleTypeDef hdma_memtomem_dma1_channel1;
 /* 私有函数声明 --------------------------------------------------------------*/
 static int test_dma_mem2mem_transfer(void);
 static int test_custom_dma_init(void);
+static int test_dma_manager_model(void);
 
 /* 公开函数实现 --------------------------------------------------------------*/
 
@@ -33,8 +35,9 @@ void DMA_RunAllTests(void) {
 
   int result1 = test_dma_mem2mem_transfer();
   int result2 = test_custom_dma_init();
+  int result3 = test_dma_manager_model();
 
-  if (result1 == TEST_PASS && result2 == TEST_PASS) {
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS) {
     printf("\r\nTest Result: PASSED\r\n");
   } else {
     printf("\r\nTest Result: FAILED\r\n");
@@ -145,17 +148,17 @@ static int test_custom_dma_init(void) {
   /* 检查 CPAR 和 CMAR */
   if (test_channel->CPAR != dummy_periph) {
     printf("  [FAIL] CPAR mismatch: 0x%08lX (expected 0x%08lX)\r\n",
-           test_channel->CPAR, dummy_periph);
+           (unsigned long)test_channel->CPAR, (unsigned long)dummy_periph);
     fail++;
   }
   if (test_channel->CMAR != dummy_mem) {
     printf("  [FAIL] CMAR mismatch: 0x%08lX (expected 0x%08lX)\r\n",
-           test_channel->CMAR, dummy_mem);
+           (unsigned long)test_channel->CMAR, (unsigned long)dummy_mem);
     fail++;
   }
   if (test_channel->CNDTR != 128) {
     printf("  [FAIL] CNDTR mismatch: %lu (expected 128)\r\n",
-           test_channel->CNDTR);
+           (unsigned long)test_channel->CNDTR);
     fail++;
   }
 
@@ -201,6 +204,12 @@ static int test_custom_dma_init(void) {
     fail++;
   }
 
+  /* 检查 DMA_GetCurrDataCounter 读回 CNDTR */
+  if (DMA_GetCurrDataCounter(test_channel) != 128) {
+    printf("  [FAIL] DMA_GetCurrDataCounter mismatch\r\n");
+    fail++;
+  }
+
   /* 4. 测试 DMA_Cmd */
   DMA_Cmd(test_channel, true);
   if ((test_channel->CCR & DMA_CCR_EN) == 0) {
@@ -221,3 +230,161 @@ static int test_custom_dma_init(void) {
     return TEST_FAIL;
   }
 }
+
+/* DMA 寄存器模型（内存中的寄存器副本） ------------------------------------*/
+static DMA_TypeDef s_model_dma1;
+static DMA_TypeDef s_model_dma2;
+static DMA_Channel_TypeDef s_model_dma1_ch[7];
+static DMA_Channel_TypeDef s_model_dma2_ch[5];
+
+/** 回调记录 */
+static volatile uint32_t s_cb_events = 0;
+static volatile uint32_t s_cb_count = 0;
+static volatile int s_cb_channel = -1;
+
+/**
+ * @brief  测试用 DMA 事件回调，记录最后一次事件
+ */
+static void test_dma_manager_callback(DMA_ChannelId_t ch, uint32_t events,
+                                      void *ctx) {
+  (void)ctx;
+  s_cb_channel = (int)ch;
+  s_cb_events = events;
+  s_cb_count++;
+}
+
+/**
+ * @brief  在寄存器模型上测试 DMA 通道管理器
+ * @note   由测试代码扮演硬件：改写 CNDTR 模拟进度，置位 ISR 模拟中断标志
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_dma_manager_model(void) {
+  DMA_Config_t cfg;
+  DMA_ChannelStats_t stats;
+  int fail = 0;
+
+  printf("[TEST] DMA Channel Manager (register model)\r\n");
+
+  memset(&s_model_dma1, 0, sizeof(s_model_dma1));
+  memset(&s_model_dma2, 0, sizeof(s_model_dma2));
+  memset(s_model_dma1_ch, 0, sizeof(s_model_dma1_ch));
+  memset(s_model_dma2_ch, 0, sizeof(s_model_dma2_ch));
+  if (DMA_Manager_AttachModel(&s_model_dma1, s_model_dma1_ch, &s_model_dma2,
+                              s_model_dma2_ch) != DMA_MGR_OK) {
+    printf("  [FAIL] Channels still claimed, cannot attach model\r\n");
+    return TEST_FAIL;
+  }
+
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.PeriphBaseAddr = 0x4001300C; /* SPI1->DR */
+  cfg.MemBaseAddr = 0x20001000;
+  cfg.Direction = DMA_DIR_PeripheralDST_Mem2Per;
+  cfg.BufferSize = 100;
+  cfg.MemInc = DMA_Inc_Enable;
+
+  /* 1. 占用登记 */
+  if (DMA_Claim(DMA_CH_DMA1_3, "spi1_tx") != DMA_MGR_OK ||
+      DMA_Claim(DMA_CH_DMA1_3, "usart") != DMA_MGR_BUSY ||
+      DMA_StartTransfer(DMA_CH_DMA1_4, &cfg) != DMA_MGR_NOT_OWNER ||
+      DMA_Claim(DMA_CH_COUNT, "bad") != DMA_MGR_PARAM_ERROR) {
+    printf("  [FAIL] Claim bookkeeping\r\n");
+    fail++;
+  }
+
+  /* 2. 启动传输：通道使能、中断位、标志清除、忙标志 */
+  DMA_SetCallback(DMA_CH_DMA1_3, test_dma_manager_callback, NULL,
+                  DMA_EVT_TC | DMA_EVT_HT);
+  if (DMA_StartTransfer(DMA_CH_DMA1_3, &cfg) != DMA_MGR_OK ||
+      (s_model_dma1_ch[2].CCR & (DMA_CCR_EN | DMA_CCR_TCIE | DMA_CCR_HTIE)) !=
+          (DMA_CCR_EN | DMA_CCR_TCIE | DMA_CCR_HTIE) ||
+      (s_model_dma1_ch[2].CCR & DMA_CCR_TEIE) != 0 ||
+      s_model_dma1.IFCR != (0x0FU << 8) || !DMA_IsBusy(DMA_CH_DMA1_3) ||
+      DMA_StartTransfer(DMA_CH_DMA1_3, &cfg) != DMA_MGR_BUSY) {
+    printf("  [FAIL] Start transfer\r\n");
+    fail++;
+  }
+
+  /* 3. 进度：硬件 CNDTR 递减到 40 */
+  s_model_dma1_ch[2].CNDTR = 40;
+  if (DMA_GetProgress(DMA_CH_DMA1_3) != 60) {
+    printf("  [FAIL] Progress %u (expected 60)\r\n",
+           DMA_GetProgress(DMA_CH_DMA1_3));
+    fail++;
+  }
+
+  /* 4. 半传输中断 */
+  s_cb_count = 0;
+  s_model_dma1.ISR = (DMA_ISR_GIF1 | DMA_ISR_HTIF1) << 8;
+  DMA_Manager_IRQHandler(DMA_CH_DMA1_3);
+  if (s_cb_count != 1 || s_cb_events != DMA_EVT_HT ||
+      s_cb_channel != DMA_CH_DMA1_3 || !DMA_IsBusy(DMA_CH_DMA1_3) ||
+      s_model_dma1.IFCR != ((DMA_ISR_GIF1 | DMA_ISR_HTIF1) << 8)) {
+    printf("  [FAIL] HT dispatch\r\n");
+    fail++;
+  }
+
+  /* 5. 传输完成中断 */
+  s_model_dma1.ISR = (DMA_ISR_GIF1 | DMA_ISR_TCIF1) << 8;
+  s_model_dma1_ch[2].CNDTR = 0;
+  DMA_Manager_IRQHandler(DMA_CH_DMA1_3);
+  DMA_GetStats(DMA_CH_DMA1_3, &stats);
+  if (s_cb_count != 2 || s_cb_events != DMA_EVT_TC ||
+      DMA_IsBusy(DMA_CH_DMA1_3) || stats.completed != 1 || stats.half != 1 ||
+      stats.units != 100 || DMA_GetProgress(DMA_CH_DMA1_3) != 100 ||
+      (s_model_dma1_ch[2].CCR & DMA_CCR_EN) != 0) {
+    printf("  [FAIL] TC dispatch\r\n");
+    fail++;
+  }
+
+  /* 6. 其他通道的标志不应触发本通道回调 */
+  s_model_dma1.ISR = (DMA_ISR_GIF1 | DMA_ISR_TCIF1) << 12;
+  DMA_Manager_IRQHandler(DMA_CH_DMA1_3);
+  if (s_cb_count != 2) {
+    printf("  [FAIL] Foreign flag dispatched\r\n");
+    fail++;
+  }
+
+  /* 7. DMA2 通道4 传输错误（位于 DMA2 ISR bit 12-15） */
+  s_model_dma2.ISR = 0;
+  DMA_Claim(DMA_CH_DMA2_4, "usart");
+  DMA_SetCallback(DMA_CH_DMA2_4, test_dma_manager_callback, NULL, DMA_EVT_TE);
+  cfg.BufferSize = 50;
+  DMA_StartTransfer(DMA_CH_DMA2_4, &cfg);
+  s_model_dma2_ch[3].CNDTR = 20;
+  s_model_dma2.ISR = (DMA_ISR_GIF1 | DMA_ISR_TEIF1) << 12;
+  DMA_Manager_IRQHandler(DMA_CH_DMA2_4);
+  DMA_GetStats(DMA_CH_DMA2_4, &stats);
+  if (s_cb_channel != DMA_CH_DMA2_4 || s_cb_events != DMA_EVT_TE ||
+      stats.errors != 1 || DMA_IsBusy(DMA_CH_DMA2_4) ||
+      DMA_GetProgress(DMA_CH_DMA2_4) != 30) {
+    printf("  [FAIL] TE dispatch on DMA2\r\n");
+    fail++;
+  }
+
+  /* 8. 释放后可被重新占用 */
+  DMA_Release(DMA_CH_DMA1_3);
+  if (DMA_GetOwner(DMA_CH_DMA1_3) != NULL ||
+      DMA_Claim(DMA_CH_DMA1_3, "i2c") != DMA_MGR_OK) {
+    printf("  [FAIL] Release\r\n");
+    fail++;
+  }
+
+  /* 释放模型上的通道后恢复到实际硬件（仍有占用时管理器拒绝重置） */
+  if (DMA_Manager_Init() != DMA_MGR_BUSY) {
+    printf("  [FAIL] Reset allowed while channels are claimed\r\n");
+    fail++;
+  }
+  DMA_Release(DMA_CH_DMA1_3);
+  DMA_Release(DMA_CH_DMA2_4);
+  if (DMA_Manager_Init() != DMA_MGR_OK) {
+    printf("  [FAIL] Restore hardware binding\r\n");
+    fail++;
+  }
+
+  if (fail == 0) {
+    printf("  [PASS] Claim / dispatch / progress verified\r\n");
+    return TEST_PASS;
+  } else {
+    return TEST_FAIL;
+  }
+}
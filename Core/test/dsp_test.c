@@ -0,0 +1,469 @@
+/**
+ * @file    dsp_test.c
+ * @brief   定点 DSP 核测试文件
+ * @note    1. FIR：分块（1 / 17 / 64 个采样）处理的结果与 double 参考逐样本相等
+ *          2. 抽取：等于 FIR 参考每 factor 个取最后一个
+ *          3. 级联双二阶：两级低通与 double 参考逐样本相等，阶跃收敛到输入
+ *          4. 滑动 RMS、峰值检测、Q15 / Q31 转换
+ *          5. 每采样周期数（DWT）
+ *          double 参考对整数乘积与累加是精确的，舍入与饱和按库的定义实现，
+ *          因此比较不需要容差
+ */
+
+#include "dsp_test.h"
+#include "bench.h"
+#include "dsp.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_LEN 256U
+#define TEST_FIR_TAPS 31U
+#define TEST_BLOCK 64U
+#define TEST_DECIM 4U
+#define TEST_STAGES 2U
+#define TEST_RMS_LEN 50U
+#define TEST_BENCH_TAPS 32U
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/** 基准参数：每次处理 TEST_BLOCK 个采样 */
+typedef struct {
+  dsp_fir_q15_t fir;
+  dsp_decim_q15_t decim;
+  dsp_biquad_q31_t iir;
+  dsp_rms_q15_t rms;
+} test_bench_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/** 两级 RBJ 低通，fs = 20 kHz：fc = 1 kHz / 4 kHz，Q = 0.707，直流增益为 1 */
+static const int16_t s_lowpass[5U * TEST_STAGES] = {
+    329, 658, 329, -25576, 10508,
+    3384, 6769, 3384, -6054, 3208,
+};
+
+static q15_t s_h[TEST_BENCH_TAPS];
+static q15_t s_x15[TEST_LEN];
+static q15_t s_y15[TEST_LEN];
+static q31_t s_x31[TEST_LEN];
+static q31_t s_y31[TEST_LEN];
+static double s_ref[TEST_LEN];
+static q15_t s_fir_state[DSP_FIR_STATE_LEN(TEST_BENCH_TAPS, TEST_BLOCK)];
+static q31_t s_iir_state[4U * TEST_STAGES];
+static q15_t s_window[TEST_RMS_LEN];
+static uint32_t s_seed;
+static test_bench_t s_bench;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int32_t test_rand(void);
+static void test_fill(void);
+static double test_round(double acc, double scale, double lo, double hi);
+static void test_fir_ref(const q15_t *h, uint32_t taps, const q15_t *x, uint32_t n);
+static int test_compare(const char *what, const double *ref, const void *y, int wide,
+                        uint32_t n, uint32_t step, uint32_t first);
+static void bench_fn_fir(void *arg);
+static void bench_fn_decim(void *arg);
+static void bench_fn_biquad(void *arg);
+static void bench_fn_rms(void *arg);
+static int test_fir(void);
+static int test_decim(void);
+static int test_biquad(void);
+static int test_detectors(void);
+static int test_speed(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 DSP 测试
+ */
+void DSP_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         DSP Kernel Test Suite          \r\n");
+  printf("========================================\r\n");
+
+  test_fill();
+
+  int result1 = test_fir();
+  int result2 = test_decim();
+  int result3 = test_biquad();
+  int result4 = test_detectors();
+  int result5 = test_speed();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  线性同余伪随机数，返回 [-32768, 32767]
+ */
+static int32_t test_rand(void) {
+  s_seed = s_seed * 1664525U + 1013904223U;
+  return (int32_t)(s_seed >> 16) - 32768;
+}
+
+/**
+ * @brief  随机系数与满幅随机输入（含 ±满量程，覆盖饱和）
+ */
+static void test_fill(void) {
+  s_seed = 12345U;
+  for (uint32_t k = 0; k < TEST_BENCH_TAPS; k++) {
+    s_h[k] = (q15_t)(test_rand() / 4); /* 系数和可超过 1，输出会饱和 */
+  }
+  for (uint32_t i = 0; i < TEST_LEN; i++) {
+    s_x15[i] = (q15_t)test_rand();
+  }
+  s_x15[10] = -32768;
+  s_x15[11] = 32767;
+}
+
+/**
+ * @brief  参考舍入：floor(acc / scale + 0.5)，饱和到 [lo, hi]
+ */
+static double test_round(double acc, double scale, double lo, double hi) {
+  double v = acc / scale + 0.5;
+  double f = (double)(int64_t)v;
+
+  if (f > v) {
+    f -= 1.0; /* 向下取整 */
+  }
+  return (f > hi) ? hi : ((f < lo) ? lo : f);
+}
+
+/**
+ * @brief  FIR 参考（从零状态开始），结果写入 s_ref
+ */
+static void test_fir_ref(const q15_t *h, uint32_t taps, const q15_t *x, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    double acc = 0.0;
+    for (uint32_t k = 0; k < taps && k <= i; k++) {
+      acc += (double)h[k] * (double)x[i - k];
+    }
+    s_ref[i] = test_round(acc, 32768.0, -32768.0, 32767.0);
+  }
+}
+
+/**
+ * @brief  逐样本比较 y[j] 与 ref[first + j * step]
+ * @param  wide: 0 为 q15_t，1 为 q31_t
+ */
+static int test_compare(const char *what, const double *ref, const void *y, int wide,
+                        uint32_t n, uint32_t step, uint32_t first) {
+  for (uint32_t j = 0; j < n; j++) {
+    double got = wide ? (double)((const q31_t *)y)[j] : (double)((const q15_t *)y)[j];
+    double expect = ref[first + j * step];
+    if (got != expect) {
+      printf("  [FAIL] %s: sample %lu = %ld, reference %ld\r\n", what, (unsigned long)j,
+             (long)got, (long)expect);
+      return TEST_FAIL;
+    }
+  }
+  return TEST_PASS;
+}
+
+/**
+ * @brief  被测函数：32 抽头 FIR 处理一块
+ */
+static void bench_fn_fir(void *arg) {
+  test_bench_t *b = (test_bench_t *)arg;
+  dsp_fir_q15(&b->fir, s_x15, s_y15, TEST_BLOCK);
+}
+
+/**
+ * @brief  被测函数：32 抽头 4 倍抽取处理一块
+ */
+static void bench_fn_decim(void *arg) {
+  test_bench_t *b = (test_bench_t *)arg;
+  dsp_decim_q15(&b->decim, s_x15, s_y15, TEST_BLOCK);
+}
+
+/**
+ * @brief  被测函数：两级双二阶处理一块
+ */
+static void bench_fn_biquad(void *arg) {
+  test_bench_t *b = (test_bench_t *)arg;
+  dsp_biquad_q31(&b->iir, s_x31, s_y31, TEST_BLOCK);
+}
+
+/**
+ * @brief  被测函数：滑动 RMS 处理一块
+ */
+static void bench_fn_rms(void *arg) {
+  test_bench_t *b = (test_bench_t *)arg;
+  volatile q15_t r = dsp_rms_q15(&b->rms, s_x15, TEST_BLOCK);
+  (void)r;
+}
+
+/**
+ * @brief  测试1：分块 FIR 与参考逐样本相等
+ */
+static int test_fir(void) {
+  static const uint16_t blocks[] = {1, 17, TEST_BLOCK, 30, TEST_BLOCK, 15, TEST_BLOCK};
+  dsp_fir_q15_t fir;
+  uint32_t done = 0, saturated = 0;
+
+  printf("\r\n[TEST] Q15 FIR against double reference\r\n");
+
+  if (dsp_fir_q15_init(&fir, s_h, TEST_FIR_TAPS, s_fir_state, TEST_BLOCK) != DSP_OK ||
+      dsp_fir_q15_init(&fir, s_h, 0, s_fir_state, TEST_BLOCK) != DSP_PARAM_ERROR) {
+    printf("  [FAIL] dsp_fir_q15_init\r\n");
+    return TEST_FAIL;
+  }
+  dsp_fir_q15_init(&fir, s_h, TEST_FIR_TAPS, s_fir_state, TEST_BLOCK);
+
+  /* 原位处理：先复制输入 */
+  for (uint32_t i = 0; i < TEST_LEN; i++) {
+    s_y15[i] = s_x15[i];
+  }
+  for (uint32_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]) && done < TEST_LEN; b++) {
+    dsp_fir_q15(&fir, s_y15 + done, s_y15 + done, blocks[b]);
+    done += blocks[b];
+  }
+
+  test_fir_ref(s_h, TEST_FIR_TAPS, s_x15, done);
+  if (test_compare("fir", s_ref, s_y15, 0, done, 1, 0) != TEST_PASS) {
+    return TEST_FAIL;
+  }
+  for (uint32_t i = 0; i < done; i++) {
+    saturated += (s_y15[i] == 32767 || s_y15[i] == -32768);
+  }
+
+  printf("  [PASS] %lu taps, %lu samples in 7 blocks bit-exact (%lu saturated)\r\n",
+         (unsigned long)TEST_FIR_TAPS, (unsigned long)done, (unsigned long)saturated);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试2：抽取
+ */
+static int test_decim(void) {
+  dsp_decim_q15_t d;
+  int m1, m2;
+
+  printf("\r\n[TEST] Q15 decimator\r\n");
+
+  if (dsp_decim_q15_init(&d, 3, s_h, TEST_FIR_TAPS, s_fir_state, TEST_BLOCK) !=
+          DSP_PARAM_ERROR ||
+      dsp_decim_q15_init(&d, TEST_DECIM, s_h, TEST_FIR_TAPS, s_fir_state, TEST_BLOCK) !=
+          DSP_OK ||
+      dsp_decim_q15(&d, s_x15, s_y15, 6) != DSP_PARAM_ERROR) {
+    printf("  [FAIL] factor must divide the block\r\n");
+    return TEST_FAIL;
+  }
+
+  m1 = dsp_decim_q15(&d, s_x15, s_y15, TEST_BLOCK);
+  m2 = dsp_decim_q15(&d, s_x15 + TEST_BLOCK, s_y15 + TEST_BLOCK / TEST_DECIM, 8);
+  if (m1 != (int)(TEST_BLOCK / TEST_DECIM) || m2 != 2) {
+    printf("  [FAIL] %d + %d outputs\r\n", m1, m2);
+    return TEST_FAIL;
+  }
+
+  test_fir_ref(s_h, TEST_FIR_TAPS, s_x15, TEST_BLOCK + 8U);
+  if (test_compare("decim", s_ref, s_y15, 0, (uint32_t)(m1 + m2), TEST_DECIM,
+                   TEST_DECIM - 1U) != TEST_PASS) {
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] x%lu: %d outputs bit-exact\r\n", (unsigned long)TEST_DECIM, m1 + m2);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试3：两级双二阶低通
+ */
+static int test_biquad(void) {
+  dsp_biquad_q31_t iir;
+  double st[4U * TEST_STAGES] = {0};
+
+  printf("\r\n[TEST] Q31 biquad cascade against double reference\r\n");
+
+  /* 前半段随机（放大到 Q31），后半段 0.5 的阶跃 */
+  for (uint32_t i = 0; i < TEST_LEN; i++) {
+    s_x31[i] = (i < TEST_LEN / 2U) ? (q31_t)(test_rand() * 32768 + test_rand())
+                                   : 0x40000000;
+  }
+
+  if (dsp_biquad_q31_init(&iir, 0, s_lowpass, s_iir_state) != DSP_PARAM_ERROR ||
+      dsp_biquad_q31_init(&iir, TEST_STAGES, s_lowpass, s_iir_state) != DSP_OK) {
+    printf("  [FAIL] dsp_biquad_q31_init\r\n");
+    return TEST_FAIL;
+  }
+  dsp_biquad_q31(&iir, s_x31, s_y31, 100);
+  dsp_biquad_q31(&iir, s_x31 + 100, s_y31 + 100, TEST_LEN - 100U);
+
+  for (uint32_t i = 0; i < TEST_LEN; i++) {
+    double v = (double)s_x31[i];
+    for (uint32_t k = 0; k < TEST_STAGES; k++) {
+      const int16_t *c = &s_lowpass[5U * k];
+      double *z = &st[4U * k];
+      double acc = c[0] * v + c[1] * z[0] + c[2] * z[1] - c[3] * z[2] - c[4] * z[3];
+      double y = test_round(acc, 16384.0, -2147483648.0, 2147483647.0);
+      z[1] = z[0];
+      z[0] = v;
+      z[3] = z[2];
+      z[2] = y;
+      v = y;
+    }
+    s_ref[i] = v;
+  }
+  if (test_compare("biquad", s_ref, s_y31, 1, TEST_LEN, 1, 0) != TEST_PASS) {
+    return TEST_FAIL;
+  }
+
+  /* 直流增益为 1：阶跃末尾与 0.5 的差不超过 0.1% */
+  int32_t err = s_y31[TEST_LEN - 1U] - 0x40000000;
+  if (err < 0) {
+    err = -err;
+  }
+  if (err > 0x40000000 / 1000) {
+    printf("  [FAIL] step settles at 0x%08lx\r\n", (unsigned long)s_y31[TEST_LEN - 1U]);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu stages, %lu samples bit-exact, step error %ld LSB\r\n",
+         (unsigned long)TEST_STAGES, (unsigned long)TEST_LEN, (long)err);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试4：滑动 RMS、峰值检测、格式转换
+ */
+static int test_detectors(void) {
+  static const q15_t burst[4] = {-32768, 1000, -20000, 0};
+  dsp_rms_q15_t rms;
+  dsp_peak_q15_t peak;
+  q15_t r = 0, p;
+  int32_t expect_env = 0;
+
+  printf("\r\n[TEST] Moving RMS, peak detector and conversions\r\n");
+
+  /* RMS：每推入一段都与窗口内最近 TEST_RMS_LEN 个采样的参考比较 */
+  dsp_rms_q15_init(&rms, s_window, TEST_RMS_LEN);
+  for (uint32_t done = 0, n = 7; done + n <= TEST_LEN; done += n, n = n * 3U % 41U + 1U) {
+    double sum = 0.0, ms, expect;
+
+    r = dsp_rms_q15(&rms, s_x15 + done, n);
+    for (uint32_t i = 0; i < TEST_RMS_LEN && i < done + n; i++) {
+      double v = s_x15[done + n - 1U - i];
+      sum += v * v;
+    }
+    ms = sum / TEST_RMS_LEN;
+    ms = (double)(int64_t)ms;
+    for (expect = 0.0; (expect + 1.0) * (expect + 1.0) <= ms && expect < 32767.0;) {
+      expect += 1.0; /* 不依赖 libm 的 floor(sqrt(ms)) */
+    }
+    if ((double)r != expect) {
+      printf("  [FAIL] rms after %lu samples: %d, reference %ld\r\n",
+             (unsigned long)(done + n), r, (long)expect);
+      return TEST_FAIL;
+    }
+  }
+
+  /* 峰值：立即跟随 |x|，之后按 1/16 衰减，最终归零 */
+  dsp_peak_q15_init(&peak, 4);
+  p = dsp_peak_q15(&peak, burst, 4);
+  for (uint32_t i = 0; i < 4; i++) {
+    int32_t a = (burst[i] == -32768) ? 32767 : (burst[i] < 0 ? -burst[i] : burst[i]);
+    expect_env -= (expect_env + 15) >> 4;
+    expect_env = (a > expect_env) ? a : expect_env;
+  }
+  if (p != expect_env || dsp_peak_q15_init(&peak, 0) != DSP_PARAM_ERROR) {
+    printf("  [FAIL] peak %d, expected %ld\r\n", p, (long)expect_env);
+    return TEST_FAIL;
+  }
+  dsp_peak_q15_init(&peak, 4);
+  dsp_peak_q15(&peak, burst, 1);
+  for (uint32_t i = 0; i < 300; i++) {
+    p = dsp_peak_q15(&peak, &burst[3], 1);
+  }
+  if (p != 0) {
+    printf("  [FAIL] peak decays to %d\r\n", p);
+    return TEST_FAIL;
+  }
+
+  /* Q31 -> Q15 舍入与饱和，Q15 -> Q31 可逆 */
+  {
+    static const q31_t in[4] = {0x7FFFFFFF, (q31_t)0x80000000, 0x00008000, -0x00008001};
+    static const q15_t expect[4] = {32767, -32768, 1, -1};
+    q15_t out[4];
+    q31_t back[4];
+
+    dsp_q31_to_q15(in, out, 4);
+    dsp_q15_to_q31(expect, back, 4);
+    for (uint32_t i = 0; i < 4; i++) {
+      if (out[i] != expect[i] || back[i] != (q31_t)((uint32_t)(int32_t)expect[i] << 16)) {
+        printf("  [FAIL] conversion %lu: %d\r\n", (unsigned long)i, out[i]);
+        return TEST_FAIL;
+      }
+    }
+  }
+
+  printf("  [PASS] rms %d over %lu samples, peak %ld, conversions saturate\r\n", r,
+         (unsigned long)TEST_RMS_LEN, (long)expect_env);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试5：每采样周期数
+ */
+static int test_speed(void) {
+  static const struct {
+    const char *name;
+    bench_fn_t fn;
+  } cases[] = {
+      {"fir_q15_32tap", bench_fn_fir},
+      {"decim4_q15_32tap", bench_fn_decim},
+      {"biquad_q31_2stage", bench_fn_biquad},
+      {"rms_q15_50", bench_fn_rms},
+  };
+  uint32_t median[sizeof(cases) / sizeof(cases[0])];
+  bench_result_t r;
+
+  printf("\r\n[TEST] Cycles per sample\r\n");
+
+  dsp_fir_q15_init(&s_bench.fir, s_h, TEST_BENCH_TAPS, s_fir_state, TEST_BLOCK);
+  dsp_biquad_q31_init(&s_bench.iir, TEST_STAGES, s_lowpass, s_iir_state);
+  dsp_rms_q15_init(&s_bench.rms, s_window, TEST_RMS_LEN);
+
+  bench_init();
+  bench_report_header();
+  for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    bench_config_t cfg = {cases[i].name, 2, 15, TEST_BLOCK * sizeof(q15_t),
+                          BENCH_FLAG_IRQ_OFF};
+    /* 抽取与 FIR 共用状态缓冲区，每次换用前重新初始化 */
+    if (cases[i].fn == bench_fn_decim) {
+      dsp_decim_q15_init(&s_bench.decim, TEST_DECIM, s_h, TEST_BENCH_TAPS, s_fir_state,
+                         TEST_BLOCK);
+    }
+    if (bench_run(&cfg, cases[i].fn, &s_bench, &r) != BENCH_OK) {
+      printf("  [FAIL] bench_run\r\n");
+      return TEST_FAIL;
+    }
+    bench_report(&r);
+    median[i] = r.median;
+  }
+
+  for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    printf("  %-20s %lu.%02lu %s/sample\r\n", cases[i].name,
+           (unsigned long)(median[i] / TEST_BLOCK),
+           (unsigned long)(median[i] % TEST_BLOCK * 100U / TEST_BLOCK), bench_unit());
+  }
+
+  /* 抽取只算四分之一的输出 */
+  if (median[1] >= median[0]) {
+    printf("  [FAIL] Decimator not faster than full-rate FIR\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] decimate-by-4 %lu%% of full-rate FIR\r\n",
+         (unsigned long)(median[1] * 100U / median[0]));
+  return TEST_PASS;
+}
@@ -0,0 +1,398 @@
+/**
+ * @file    event_loop_test.c
+ * @brief   协作式事件循环测试文件
+ * @note    1. 优先级顺序、同一任务内 FIFO、处理函数中投递更高优先级事件
+ *          2. 队列满时丢弃并计数
+ *          3. 中断投递（事件定时器）与推迟工作都在线程模式执行
+ *          4. DMA 完成回调直接投递事件
+ *          5. USART1 接收空闲事件（需要 TX / RX 短接）
+ *          6. 每个任务的周期数统计与 ev_report
+ */
+
+#include "event_loop_test.h"
+#include "event_loop.h"
+#include "dma_mem.h"
+#include "usart.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_QUEUE_LEN 8
+#define TEST_LOG_LEN 16
+#define TEST_TIMER_EVENTS 10U
+#define TEST_TIMER_PERIOD 5U
+#define TEST_COPY_SIZE 256U
+#define TEST_RX_MESSAGE "PING-EVENT"
+#define TEST_QUIET_MS 3U
+
+/** 测试信号 */
+#define SIG_DATA (EV_SIG_USER + 0U)
+#define SIG_KICK (EV_SIG_USER + 1U)
+#define SIG_TICK (EV_SIG_USER + 2U)
+#define SIG_DONE (EV_SIG_USER + 3U)
+#define SIG_RX (EV_SIG_USER + 4U)
+#define SIG_TIMEOUT (EV_SIG_USER + 5U)
+#define SIG_WORK (EV_SIG_USER + 6U)
+
+/* 私有变量 ------------------------------------------------------------------*/
+static ev_task_t s_low, s_mid, s_high;
+static ev_event_t s_low_q[TEST_QUEUE_LEN];
+static ev_event_t s_mid_q[TEST_QUEUE_LEN];
+static ev_event_t s_high_q[TEST_QUEUE_LEN];
+static ev_timer_t s_tick_timer;
+static ev_timer_t s_timeout_timer;
+static tw_timer_t s_isr_timer;
+static ev_completion_t s_copy_done;
+static uint8_t s_copy_src[TEST_COPY_SIZE];
+static uint8_t s_copy_dst[TEST_COPY_SIZE];
+
+/** 处理记录：高 8 位为优先级，低 8 位为 param */
+static uint16_t s_log[TEST_LOG_LEN];
+static uint32_t s_log_len = 0;
+static ev_event_t s_last;
+static uint32_t s_ticks = 0;
+static uint32_t s_in_isr = 0;
+static volatile uint32_t s_deferred = 0;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void test_setup(ev_handler_t handler);
+static void test_record(ev_task_t *task, const ev_event_t *ev);
+static int test_priority_order(void);
+static int test_queue_full(void);
+static int test_isr_posting(void);
+static int test_dma_completion(void);
+static int test_usart_rx(void);
+static int test_accounting(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有事件循环测试
+ */
+void Event_Loop_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("        Event Loop Test Suite           \r\n");
+  printf("========================================\r\n");
+
+  if (tw_init(TW_TICK_HZ) != TW_OK) {
+    printf("  [FAIL] tw_init\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result1 = test_priority_order();
+  int result2 = test_queue_full();
+  int result3 = test_isr_posting();
+  int result4 = test_dma_completion();
+  int result5 = test_usart_rx();
+  int result6 = test_accounting();
+
+  tw_deinit();
+  ev_init();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS && result6 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  重新初始化调度器，注册优先级 1 / 5 / 10 三个任务
+ */
+static void test_setup(ev_handler_t handler) {
+  ev_init();
+  ev_task_init(&s_low, "low", 1, handler, NULL, s_low_q, TEST_QUEUE_LEN);
+  ev_task_init(&s_mid, "mid", 5, handler, NULL, s_mid_q, TEST_QUEUE_LEN);
+  ev_task_init(&s_high, "high", 10, handler, NULL, s_high_q, TEST_QUEUE_LEN);
+  s_log_len = 0;
+  s_ticks = 0;
+  s_in_isr = 0;
+  s_deferred = 0;
+  memset(&s_last, 0, sizeof(s_last));
+}
+
+/**
+ * @brief  通用处理函数：记录顺序；SIG_KICK 向 high 投递；
+ *         SIG_DONE / SIG_RX / SIG_TIMEOUT 结束 ev_run
+ */
+static void test_record(ev_task_t *task, const ev_event_t *ev) {
+  if (__get_IPSR() != 0) {
+    s_in_isr++;
+  }
+  if (s_log_len < TEST_LOG_LEN) {
+    s_log[s_log_len++] = (uint16_t)((task->prio << 8) | (ev->param & 0xFFU));
+  }
+  s_last = *ev;
+
+  switch (ev->sig) {
+  case SIG_KICK:
+    ev_post(&s_high, SIG_DATA, 0x99, NULL);
+    break;
+  case SIG_TICK:
+    if (++s_ticks >= TEST_TIMER_EVENTS) {
+      ev_timer_stop(&s_tick_timer);
+      ev_stop();
+    }
+    break;
+  case SIG_DONE:
+  case SIG_RX:
+  case SIG_TIMEOUT:
+    ev_stop();
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief  优先级顺序
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_priority_order(void) {
+  /* low 的 KICK（param 2）处理完后 high 的 0x99 先于 low 的下一个事件 */
+  static const uint16_t expect[] = {0x0A01, 0x0A02, 0x0501, 0x0502,
+                                    0x0101, 0x0102, 0x0A99, 0x0102};
+
+  printf("[TEST] Priority order\r\n");
+
+  test_setup(test_record);
+  ev_post(&s_low, SIG_DATA, 1, NULL);
+  ev_post(&s_mid, SIG_DATA, 1, NULL);
+  ev_post(&s_low, SIG_KICK, 2, NULL); /* 处理时向 high 投递 0x99 */
+  ev_post(&s_high, SIG_DATA, 1, NULL);
+  ev_post(&s_mid, SIG_DATA, 2, NULL);
+  ev_post(&s_high, SIG_DATA, 2, NULL);
+  /* low 的第三个事件排在 high 的 0x99 之后 */
+  ev_post(&s_low, SIG_DATA, 2, NULL);
+
+  if (ev_task_init(&s_mid, "dup", 10, test_record, NULL, s_mid_q,
+                   TEST_QUEUE_LEN) != EV_PARAM_ERROR) {
+    printf("  [FAIL] Duplicate priority accepted\r\n");
+    return TEST_FAIL;
+  }
+
+  ev_run_until_idle();
+
+  if (s_log_len != 8 || memcmp(s_log, expect, sizeof(expect)) != 0 ||
+      ev_pending()) {
+    printf("  [FAIL] order:");
+    for (uint32_t i = 0; i < s_log_len; i++) {
+      printf(" %04x", s_log[i]);
+    }
+    printf("\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] high > mid > low, FIFO per task, kick runs next\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  队列满
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_queue_full(void) {
+  int full = 0;
+
+  printf("[TEST] Queue overflow\r\n");
+
+  test_setup(test_record);
+  for (uint32_t i = 0; i < TEST_QUEUE_LEN + 3U; i++) {
+    if (ev_post(&s_mid, SIG_DATA, i, NULL) == EV_QUEUE_FULL) {
+      full++;
+    }
+  }
+  ev_run_until_idle();
+
+  if (full != 3 || s_mid.stats.dropped != 3 ||
+      s_mid.stats.peak != TEST_QUEUE_LEN ||
+      s_mid.stats.handled != TEST_QUEUE_LEN ||
+      s_log[TEST_QUEUE_LEN - 1] != (0x0500 | (TEST_QUEUE_LEN - 1))) {
+    printf("  [FAIL] full=%d dropped=%lu peak=%lu handled=%lu\r\n", full,
+           (unsigned long)s_mid.stats.dropped, (unsigned long)s_mid.stats.peak,
+           (unsigned long)s_mid.stats.handled);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] 3 dropped, oldest %d kept\r\n", TEST_QUEUE_LEN);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  推迟的工作：检查在线程模式执行
+ */
+static void test_work(void *arg) {
+  (void)arg;
+  if (__get_IPSR() != 0) {
+    s_in_isr++;
+  }
+  s_deferred++;
+}
+
+/**
+ * @brief  时间轮回调（TIM6 中断）：推迟一项工作
+ */
+static void test_isr_cb(tw_timer_t *timer, void *ctx) {
+  (void)timer;
+  (void)ctx;
+  ev_defer(test_work, NULL);
+}
+
+/**
+ * @brief  中断投递：周期事件定时器 + 中断里推迟的工作
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_isr_posting(void) {
+  uint32_t start;
+  uint32_t elapsed;
+
+  printf("[TEST] Events and deferred work from interrupts\r\n");
+
+  test_setup(test_record);
+  tw_timer_init(&s_isr_timer, test_isr_cb, NULL);
+  tw_start(&s_isr_timer, 3, 3);
+  start = HAL_GetTick();
+  ev_timer_start(&s_tick_timer, &s_mid, SIG_TICK, TEST_TIMER_PERIOD,
+                 TEST_TIMER_PERIOD);
+  ev_run();
+  elapsed = HAL_GetTick() - start;
+  tw_stop(&s_isr_timer);
+  ev_run_until_idle();
+
+  if (s_ticks != TEST_TIMER_EVENTS || s_in_isr != 0 ||
+      s_deferred < TEST_TIMER_EVENTS * TEST_TIMER_PERIOD / 3U ||
+      elapsed + 1U < TEST_TIMER_EVENTS * TEST_TIMER_PERIOD ||
+      elapsed > TEST_TIMER_EVENTS * TEST_TIMER_PERIOD + 2U) {
+    printf("  [FAIL] ticks=%lu deferred=%lu in_isr=%lu elapsed=%lu ms\r\n",
+           (unsigned long)s_ticks, (unsigned long)s_deferred,
+           (unsigned long)s_in_isr, (unsigned long)elapsed);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu timer events, %lu deferred, all in thread mode (%lu ms)\r\n",
+         (unsigned long)s_ticks, (unsigned long)s_deferred,
+         (unsigned long)elapsed);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  DMA 完成回调投递事件
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_dma_completion(void) {
+  printf("[TEST] DMA completion event\r\n");
+
+  test_setup(test_record);
+  if (dma_mem_init() != DMA_MEM_OK) {
+    printf("  [FAIL] dma_mem_init\r\n");
+    return TEST_FAIL;
+  }
+  for (uint32_t i = 0; i < TEST_COPY_SIZE; i++) {
+    s_copy_src[i] = (uint8_t)(i * 7U + 3U);
+  }
+  memset(s_copy_dst, 0, sizeof(s_copy_dst));
+
+  s_copy_done.task = &s_high;
+  s_copy_done.sig = SIG_DONE;
+  s_copy_done.ptr = s_copy_dst;
+  ev_timer_start(&s_timeout_timer, &s_low, SIG_TIMEOUT, 100, 0);
+  dma_memcpy_async(s_copy_dst, s_copy_src, TEST_COPY_SIZE, ev_post_completion,
+                   &s_copy_done);
+  ev_run();
+  ev_timer_stop(&s_timeout_timer);
+  dma_mem_deinit();
+
+  if (s_last.sig != SIG_DONE || s_last.param != DMA_MEM_OK ||
+      s_last.ptr != s_copy_dst ||
+      memcmp(s_copy_src, s_copy_dst, TEST_COPY_SIZE) != 0) {
+    printf("  [FAIL] sig=%u param=%lu\r\n", s_last.sig,
+           (unsigned long)s_last.param);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Completion delivered to task\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  USART1 接收空闲事件
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_usart_rx(void) {
+  Driver_USART1_Init();
+  printf("[TEST] USART1 RX idle event (TX/RX looped)\r\n");
+
+  /* 日志本身也会被环回接收：等线路连续 TEST_QUIET_MS 没有空闲事件再清空 */
+  do {
+    g_usart_message_ready = 0;
+    HAL_Delay(TEST_QUIET_MS);
+  } while (g_usart_message_ready);
+  g_usart_rx_len = 0;
+
+  test_setup(test_record);
+  usart_set_rx_event(&s_high, SIG_RX);
+  ev_timer_start(&s_timeout_timer, &s_low, SIG_TIMEOUT, 100, 0);
+  Driver_USART1_SendString((uint8_t *)TEST_RX_MESSAGE,
+                           (uint16_t)strlen(TEST_RX_MESSAGE));
+  ev_run();
+  ev_timer_stop(&s_timeout_timer);
+  usart_set_rx_event(NULL, 0);
+
+  if (s_last.sig != SIG_RX || s_last.param != strlen(TEST_RX_MESSAGE) ||
+      s_last.ptr != g_usart_rx_buffer ||
+      memcmp(g_usart_rx_buffer, TEST_RX_MESSAGE, strlen(TEST_RX_MESSAGE)) != 0) {
+    printf("  [FAIL] sig=%u len=%lu\r\n", s_last.sig, (unsigned long)s_last.param);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu bytes delivered as one event\r\n",
+         (unsigned long)s_last.param);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  按 param 忙等若干次的处理函数
+ */
+static void test_spin(ev_task_t *task, const ev_event_t *ev) {
+  (void)task;
+  for (volatile uint32_t i = 0; i < ev->param; i++) {
+  }
+}
+
+/**
+ * @brief  周期数统计
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_accounting(void) {
+  printf("[TEST] Per-task CPU accounting\r\n");
+
+  test_setup(test_spin);
+  for (uint32_t i = 0; i < 4; i++) {
+    ev_post(&s_low, SIG_WORK, 2000, NULL);
+    ev_post(&s_high, SIG_WORK, 100, NULL);
+  }
+  ev_post(&s_mid, SIG_WORK, 500, NULL);
+  ev_run_until_idle();
+  ev_report();
+
+  if (s_low.stats.handled != 4 || s_high.stats.handled != 4 ||
+      s_mid.stats.handled != 1 ||
+      s_low.stats.cycles < s_high.stats.cycles * 10U ||
+      s_mid.stats.max_cycles < s_high.stats.max_cycles * 2U ||
+      s_low.stats.max_cycles * 4U < s_low.stats.cycles) {
+    printf("  [FAIL] low=%lu mid=%lu high=%lu cycles\r\n",
+           (unsigned long)s_low.stats.cycles, (unsigned long)s_mid.stats.cycles,
+           (unsigned long)s_high.stats.cycles);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Cycles proportional to work\r\n");
+  return TEST_PASS;
+}
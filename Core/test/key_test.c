@@ -0,0 +1,386 @@
+/**
+ * @file    key_test.c
+ * @brief   按键驱动测试文件
+ * @note    1. 合成抖动序列：按下 / 松开各只产生一个事件，事件时间正确
+ *          2. 长按与连发的时刻和计数
+ *          3. 双击窗口内外、长按后的单击不算双击
+ *          4. 队列满时丢弃并计数
+ *          5. 仿真中驱动 PF10：EXTI 启动采样器，按下事件时间为第一个边沿，
+ *             松开后采样器停止（目标板上跳过）
+ */
+
+#include "key_test.h"
+#include "key.h"
+#include "timer_wheel.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_MAX_EVENTS 32
+#define TEST_BOUNCE_LOOPS 2000U /* 仿真中两次抖动之间的空转次数 */
+#define TEST_SETTLE_MS 40U      /* 等待采样器消抖完成 */
+
+/** PF10：端口编号从 GPIOA = 0 开始 */
+#define TEST_PORT 5
+#define TEST_PIN 10
+
+/* 私有变量 ------------------------------------------------------------------*/
+static Key_Event_t s_events[TEST_MAX_EVENTS];
+static uint32_t s_event_count = 0;
+static uint32_t s_now = 0;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void test_reset(void);
+static void test_feed(const uint8_t *levels, uint32_t n);
+static void test_hold(uint8_t level, uint32_t ms);
+static void test_collect(void);
+static uint32_t test_count(uint8_t type);
+static int test_debounce(void);
+static int test_long_repeat(void);
+static int test_double_click(void);
+static int test_queue_full(void);
+static int test_exti(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有按键测试
+ */
+void Key_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("           Key Test Suite               \r\n");
+  printf("========================================\r\n");
+
+  if (tw_init(TW_TICK_HZ) != TW_OK) {
+    printf("  [FAIL] tw_init\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result1 = test_debounce();
+  int result2 = test_long_repeat();
+  int result3 = test_double_click();
+  int result4 = test_queue_full();
+  int result5 = test_exti();
+
+  Key_DeInit();
+  tw_deinit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  重新初始化驱动（按键松开，采样器不运行），合成时间从 1000 开始
+ */
+static void test_reset(void) {
+  Key_Init();
+  s_event_count = 0;
+  s_now = 1000;
+}
+
+/**
+ * @brief  按采样周期依次送入电平
+ */
+static void test_feed(const uint8_t *levels, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    Key_Process(levels[i], s_now);
+    s_now += KEY_SCAN_MS;
+  }
+  test_collect();
+}
+
+/**
+ * @brief  保持电平 ms 毫秒
+ */
+static void test_hold(uint8_t level, uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t += KEY_SCAN_MS) {
+    Key_Process(level, s_now);
+    s_now += KEY_SCAN_MS;
+  }
+  test_collect();
+}
+
+/**
+ * @brief  取出队列中的全部事件
+ */
+static void test_collect(void) {
+  Key_Event_t evt;
+
+  while (Key_GetEvent(&evt)) {
+    if (s_event_count < TEST_MAX_EVENTS) {
+      s_events[s_event_count++] = evt;
+    }
+  }
+}
+
+/**
+ * @brief  某类事件的个数
+ */
+static uint32_t test_count(uint8_t type) {
+  uint32_t n = 0;
+
+  for (uint32_t i = 0; i < s_event_count; i++) {
+    if (s_events[i].type == type) {
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief  测试1：抖动只产生一次按下 / 松开
+ */
+static int test_debounce(void) {
+  static const uint8_t press[] = {1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1};
+  static const uint8_t release[] = {0, 1, 0, 0, 1, 0, 0, 0, 0, 0};
+  uint32_t press_time;
+
+  printf("\r\n[TEST] Debounce\r\n");
+  test_reset();
+
+  /* 最后一次抖动从第 8 个采样开始，连续 KEY_DEBOUNCE_SAMPLES 个 1 后翻转 */
+  press_time = s_now + (7U + KEY_DEBOUNCE_SAMPLES - 1U) * KEY_SCAN_MS;
+  test_feed(press, sizeof(press));
+  if (s_event_count != 1 || s_events[0].type != KEY_EVT_PRESS ||
+      s_events[0].key != KEY0 || s_events[0].time != press_time ||
+      Key_GetState() != 1) {
+    printf("  [FAIL] press: %lu events, time %lu (expected %lu)\r\n",
+           (unsigned long)s_event_count,
+           (unsigned long)(s_event_count ? s_events[0].time : 0),
+           (unsigned long)press_time);
+    return TEST_FAIL;
+  }
+
+  test_feed(release, sizeof(release));
+  if (s_event_count != 2 || s_events[1].type != KEY_EVT_RELEASE ||
+      Key_GetState() != 0) {
+    printf("  [FAIL] release: %lu events\r\n", (unsigned long)s_event_count);
+    return TEST_FAIL;
+  }
+
+  /* 短于 KEY_DEBOUNCE_SAMPLES 的脉冲被滤掉 */
+  test_feed(press, KEY_DEBOUNCE_SAMPLES - 1U);
+  test_hold(0, 100);
+  if (s_event_count != 2) {
+    printf("  [FAIL] glitch produced %lu events\r\n", (unsigned long)(s_event_count - 2U));
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] one PRESS at t+%lu ms and one RELEASE despite bounce\r\n",
+         (unsigned long)(press_time - 1000U));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试2：长按与连发
+ */
+static int test_long_repeat(void) {
+  uint32_t press_time;
+
+  printf("\r\n[TEST] Long press and repeat\r\n");
+  test_reset();
+
+  test_hold(1, KEY_DEBOUNCE_SAMPLES * KEY_SCAN_MS);
+  press_time = s_now - KEY_SCAN_MS;
+  test_hold(1, KEY_LONG_MS + 3U * KEY_REPEAT_MS);
+  test_hold(0, 100);
+
+  /* PRESS, LONG, REPEAT x3, RELEASE */
+  if (s_event_count != 6 || s_events[1].type != KEY_EVT_LONG ||
+      s_events[1].time != press_time + KEY_LONG_MS) {
+    printf("  [FAIL] %lu events, LONG time %lu (expected %lu)\r\n",
+           (unsigned long)s_event_count,
+           (unsigned long)(s_event_count > 1 ? s_events[1].time : 0),
+           (unsigned long)(press_time + KEY_LONG_MS));
+    return TEST_FAIL;
+  }
+  for (uint32_t i = 0; i < 3; i++) {
+    const Key_Event_t *e = &s_events[2 + i];
+    if (e->type != KEY_EVT_REPEAT || e->count != i + 1U ||
+        e->time != press_time + KEY_LONG_MS + (i + 1U) * KEY_REPEAT_MS) {
+      printf("  [FAIL] REPEAT %lu: type %u count %u time %lu\r\n", (unsigned long)i,
+             e->type, e->count, (unsigned long)e->time);
+      return TEST_FAIL;
+    }
+  }
+  if (s_events[5].type != KEY_EVT_RELEASE) {
+    printf("  [FAIL] last event type %u\r\n", s_events[5].type);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] LONG at %u ms, REPEAT every %u ms\r\n", (unsigned)KEY_LONG_MS,
+         (unsigned)KEY_REPEAT_MS);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试3：双击
+ */
+static int test_double_click(void) {
+  const uint32_t click = KEY_DEBOUNCE_SAMPLES * KEY_SCAN_MS * 2U;
+
+  printf("\r\n[TEST] Double click\r\n");
+  test_reset();
+
+  /* 窗口内第二次按下：PRESS RELEASE PRESS DOUBLE RELEASE */
+  test_hold(1, click);
+  test_hold(0, 100);
+  test_hold(1, click);
+  test_hold(0, 100);
+  if (s_event_count != 5 || test_count(KEY_EVT_DOUBLE) != 1 ||
+      s_events[3].type != KEY_EVT_DOUBLE || s_events[3].time != s_events[2].time) {
+    printf("  [FAIL] within window: %lu events, %lu DOUBLE\r\n",
+           (unsigned long)s_event_count, (unsigned long)test_count(KEY_EVT_DOUBLE));
+    return TEST_FAIL;
+  }
+
+  /* 紧接着的第三次单击不与第二次组成双击 */
+  test_hold(1, click);
+  test_hold(0, KEY_DCLICK_MS + 100U);
+  if (test_count(KEY_EVT_DOUBLE) != 1) {
+    printf("  [FAIL] third click counted as DOUBLE\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 超出窗口 */
+  test_reset();
+  test_hold(1, click);
+  test_hold(0, KEY_DCLICK_MS + 50U);
+  test_hold(1, click);
+  test_hold(0, 100);
+  if (s_event_count != 4 || test_count(KEY_EVT_DOUBLE) != 0) {
+    printf("  [FAIL] outside window: %lu events, %lu DOUBLE\r\n",
+           (unsigned long)s_event_count, (unsigned long)test_count(KEY_EVT_DOUBLE));
+    return TEST_FAIL;
+  }
+
+  /* 长按后的单击 */
+  test_reset();
+  test_hold(1, KEY_LONG_MS + 50U);
+  test_hold(0, 100);
+  test_hold(1, click);
+  test_hold(0, 100);
+  if (test_count(KEY_EVT_DOUBLE) != 0 || test_count(KEY_EVT_LONG) != 1) {
+    printf("  [FAIL] click after long press counted as DOUBLE\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] DOUBLE only within %u ms of a short click\r\n", (unsigned)KEY_DCLICK_MS);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试4：队列满
+ */
+static int test_queue_full(void) {
+  const uint32_t clicks = KEY_QUEUE_LEN;
+  Key_Event_t evt;
+  uint32_t n = 0;
+
+  printf("\r\n[TEST] Queue full\r\n");
+  test_reset();
+
+  /* 每次单击 2 个事件（间隔超出双击窗口），不取出 */
+  for (uint32_t i = 0; i < clicks; i++) {
+    for (uint32_t t = 0; t < 50U; t += KEY_SCAN_MS) {
+      Key_Process(1, s_now);
+      s_now += KEY_SCAN_MS;
+    }
+    for (uint32_t t = 0; t < KEY_DCLICK_MS + 50U; t += KEY_SCAN_MS) {
+      Key_Process(0, s_now);
+      s_now += KEY_SCAN_MS;
+    }
+  }
+  while (Key_GetEvent(&evt)) {
+    n++;
+  }
+
+  if (n != KEY_QUEUE_LEN || Key_GetDropped() != 2U * clicks - KEY_QUEUE_LEN) {
+    printf("  [FAIL] queued %lu, dropped %lu\r\n", (unsigned long)n,
+           (unsigned long)Key_GetDropped());
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu queued, %lu dropped\r\n", (unsigned long)n,
+         (unsigned long)Key_GetDropped());
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试5：EXTI 边沿时间戳与采样器启停
+ */
+static int test_exti(void) {
+  printf("\r\n[TEST] EXTI timestamp and sampler\r\n");
+
+#if defined(STM32_HOST_BUILD)
+  static const uint8_t bounce[] = {1, 0, 1, 0, 1};
+  uint32_t edge_time, start;
+
+  test_reset();
+  if (Key_IsScanning()) {
+    printf("  [FAIL] sampler running while idle\r\n");
+    return TEST_FAIL;
+  }
+
+  edge_time = HAL_GetTick();
+  for (uint32_t i = 0; i < sizeof(bounce); i++) {
+    sim_gpio_input(TEST_PORT, TEST_PIN, bounce[i]);
+    for (volatile uint32_t n = 0; n < TEST_BOUNCE_LOOPS; n++) {
+    }
+  }
+  if (!Key_IsScanning()) {
+    printf("  [FAIL] EXTI did not start the sampler\r\n");
+    return TEST_FAIL;
+  }
+
+  start = HAL_GetTick();
+  while (HAL_GetTick() - start < TEST_SETTLE_MS) {
+  }
+  test_collect();
+  if (s_event_count != 1 || s_events[0].type != KEY_EVT_PRESS ||
+      s_events[0].time != edge_time || !Key_IsScanning()) {
+    printf("  [FAIL] press: %lu events, time %lu (edge %lu)\r\n",
+           (unsigned long)s_event_count,
+           (unsigned long)(s_event_count ? s_events[0].time : 0),
+           (unsigned long)edge_time);
+    return TEST_FAIL;
+  }
+
+  edge_time = HAL_GetTick();
+  for (uint32_t i = 0; i < sizeof(bounce); i++) {
+    sim_gpio_input(TEST_PORT, TEST_PIN, !bounce[i]);
+    for (volatile uint32_t n = 0; n < TEST_BOUNCE_LOOPS; n++) {
+    }
+  }
+  start = HAL_GetTick();
+  while (HAL_GetTick() - start < TEST_SETTLE_MS) {
+  }
+  test_collect();
+  sim_gpio_input(TEST_PORT, TEST_PIN, -1);
+
+  if (s_event_count != 2 || s_events[1].type != KEY_EVT_RELEASE ||
+      s_events[1].time != edge_time) {
+    printf("  [FAIL] release: %lu events\r\n", (unsigned long)s_event_count);
+    return TEST_FAIL;
+  }
+  if (Key_IsScanning()) {
+    printf("  [FAIL] sampler still running after release\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] events stamped at the first edge, sampler stopped when idle\r\n");
+  return TEST_PASS;
+#else
+  printf("  [PASS] skipped (needs simulated PF10 input)\r\n");
+  return TEST_PASS;
+#endif
+}
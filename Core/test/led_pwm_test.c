@@ -0,0 +1,299 @@
+/**
+ * @file    led_pwm_test.c
+ * @brief   LED PWM 驱动测试文件
+ * @note    1. 伽马曲线与呼吸 / 渐变 / 闪烁序列生成
+ *          2. 固定亮度：每个周期的占空比等于设定值
+ *          3. 循环播放：两路不同长度的序列逐周期输出，DMA 不产生任何中断
+ *          4. 单次播放：序列输出一遍后保持最后一项，结束时一次 TC
+ *          仿真中逐周期的占空比来自 TIM2 模型的日志；目标板上只检查播放
+ *          状态和 DMA 统计
+ */
+
+#include "led_pwm_test.h"
+#include "dma_manager.h"
+#include "led_pwm.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_BREATHE_LEN 40U
+#define TEST_BLINK_LEN 25U
+#define TEST_FADE_LEN 30U
+#define TEST_CAPTURE_LEN 256
+#define TEST_FRAME_MS (1000U / LED_PWM_FREQ_HZ)
+
+/** 序列开始前的占空比：伽马曲线不会产生这个值，用来定位序列起点 */
+#define TEST_MARKER (LED_PWM_PERIOD - 1U)
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint16_t s_breathe[TEST_BREATHE_LEN];
+static uint16_t s_blink[TEST_BLINK_LEN];
+static uint16_t s_fade[TEST_FADE_LEN];
+static uint16_t s_capture[TEST_CAPTURE_LEN];
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int test_capture(LED_PWM_Channel_t ch);
+static void test_prepare(LED_PWM_Channel_t ch);
+static int test_match(int n, const uint16_t *seq, uint32_t len, uint8_t loop,
+                      uint32_t *frames);
+static int test_generators(void);
+static int test_static(void);
+static int test_loop(void);
+static int test_oneshot(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 LED PWM 测试
+ */
+void LED_PWM_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         LED PWM Test Suite             \r\n");
+  printf("========================================\r\n");
+
+  if (LED_PWM_Init() != LED_PWM_OK) {
+    printf("  [FAIL] LED_PWM_Init (DMA channel already claimed)\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result1 = test_generators();
+  int result2 = test_static();
+  int result3 = test_loop();
+  int result4 = test_oneshot();
+
+  LED_PWM_DeInit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  取出通道各周期的占空比
+ * @retval 个数，目标板上为 -1（无法逐周期观测）
+ */
+static int test_capture(LED_PWM_Channel_t ch) {
+#if defined(STM32_HOST_BUILD)
+  return sim_tim2_pwm_log((int)ch + 1, s_capture, TEST_CAPTURE_LEN);
+#else
+  (void)ch;
+  return -1;
+#endif
+}
+
+/**
+ * @brief  输出标记占空比并清空之前的记录
+ */
+static void test_prepare(LED_PWM_Channel_t ch) {
+  LED_PWM_SetDuty(ch, TEST_MARKER);
+  HAL_Delay(3U * TEST_FRAME_MS);
+  test_capture(ch);
+}
+
+/**
+ * @brief  跳过开头的标记后，逐周期与序列比较
+ * @param  loop: 1 循环比较；0 序列之后应一直保持最后一项
+ * @param  frames: 输出比较过的周期数
+ */
+static int test_match(int n, const uint16_t *seq, uint32_t len, uint8_t loop,
+                      uint32_t *frames) {
+  int i = 0;
+
+  while (i < n && s_capture[i] == TEST_MARKER) {
+    i++;
+  }
+  if (i == 0 || i > 2) {
+    printf("  [FAIL] %d marker periods before the sequence\r\n", i);
+    return TEST_FAIL;
+  }
+  for (uint32_t k = 0; i < n; i++, k++) {
+    uint16_t expect = loop ? seq[k % len] : seq[(k < len) ? k : len - 1U];
+    if (s_capture[i] != expect) {
+      printf("  [FAIL] period %lu: duty %u, expected %u\r\n", (unsigned long)k,
+             s_capture[i], expect);
+      return TEST_FAIL;
+    }
+    *frames = k + 1U;
+  }
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试1：伽马曲线与序列生成
+ */
+static int test_generators(void) {
+  uint16_t prev = 0;
+
+  printf("\r\n[TEST] Gamma and sequence generators\r\n");
+
+  if (LED_PWM_Gamma(0) != 0 || LED_PWM_Gamma(255) != LED_PWM_PERIOD ||
+      LED_PWM_Gamma(128) < 210 || LED_PWM_Gamma(128) > 235) {
+    printf("  [FAIL] gamma(0/128/255) = %u/%u/%u\r\n", LED_PWM_Gamma(0),
+           LED_PWM_Gamma(128), LED_PWM_Gamma(255));
+    return TEST_FAIL;
+  }
+  for (uint32_t l = 0; l < 256; l++) {
+    uint16_t d = LED_PWM_Gamma((uint8_t)l);
+    if (d < prev || d == TEST_MARKER) {
+      printf("  [FAIL] gamma(%lu) = %u\r\n", (unsigned long)l, d);
+      return TEST_FAIL;
+    }
+    prev = d;
+  }
+
+  LED_PWM_Breathe(s_breathe, TEST_BREATHE_LEN);
+  LED_PWM_Blink(s_blink, TEST_BLINK_LEN, 5, 200);
+  LED_PWM_Fade(s_fade, TEST_FADE_LEN, 0, 255);
+
+  if (s_breathe[0] != 0 || s_breathe[TEST_BREATHE_LEN / 2U] != LED_PWM_PERIOD ||
+      s_breathe[TEST_BREATHE_LEN / 4U] != LED_PWM_Gamma(127) ||
+      s_breathe[TEST_BREATHE_LEN - 1U] >= s_breathe[TEST_BREATHE_LEN - 2U]) {
+    printf("  [FAIL] breathe shape\r\n");
+    return TEST_FAIL;
+  }
+  if (s_blink[4] != LED_PWM_Gamma(200) || s_blink[5] != 0 ||
+      s_blink[TEST_BLINK_LEN - 1U] != 0) {
+    printf("  [FAIL] blink shape\r\n");
+    return TEST_FAIL;
+  }
+  if (s_fade[0] != 0 || s_fade[TEST_FADE_LEN - 1U] != LED_PWM_PERIOD ||
+      s_fade[TEST_FADE_LEN / 2U] <= s_fade[TEST_FADE_LEN / 2U - 1U]) {
+    printf("  [FAIL] fade shape\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] gamma(128) = %u / %u, sequences shaped as expected\r\n",
+         LED_PWM_Gamma(128), (unsigned)LED_PWM_PERIOD);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试2：固定亮度
+ */
+static int test_static(void) {
+  const uint16_t duty = LED_PWM_Gamma(100);
+  int n;
+
+  printf("\r\n[TEST] Static level\r\n");
+
+  test_prepare(LED_PWM_LED1);
+  if (LED_PWM_SetLevel(LED_PWM_LED1, 100) != LED_PWM_OK ||
+      LED_PWM_SetDuty(LED_PWM_LED1, LED_PWM_PERIOD + 1U) != LED_PWM_PARAM_ERROR ||
+      LED_PWM_SetDuty(LED_PWM_COUNT, 0) != LED_PWM_PARAM_ERROR) {
+    printf("  [FAIL] parameter checks\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay(10U * TEST_FRAME_MS);
+
+  n = test_capture(LED_PWM_LED1);
+  if (n >= 0) {
+    uint32_t frames = 0;
+    if (test_match(n, &duty, 1, 1, &frames) != TEST_PASS || frames < 8U) {
+      printf("  [FAIL] %lu periods at duty %u\r\n", (unsigned long)frames, duty);
+      return TEST_FAIL;
+    }
+  }
+
+  printf("  [PASS] duty %u / %u from the next period on\r\n", duty, (unsigned)LED_PWM_PERIOD);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试3：两路循环播放
+ */
+static int test_loop(void) {
+  DMA_ChannelStats_t st1, st2;
+  uint32_t frames1 = 0, frames2 = 0;
+  int n;
+
+  printf("\r\n[TEST] Looped sequences with no CPU involvement\r\n");
+
+  LED_PWM_SetDuty(LED_PWM_LED2, TEST_MARKER);
+  test_prepare(LED_PWM_LED1);
+  test_capture(LED_PWM_LED2);
+  /* 参数错误的调用不影响正在播放的序列 */
+  if (LED_PWM_Play(LED_PWM_LED1, s_breathe, TEST_BREATHE_LEN, 1) != LED_PWM_OK ||
+      LED_PWM_Play(LED_PWM_LED2, s_blink, TEST_BLINK_LEN, 1) != LED_PWM_OK ||
+      LED_PWM_Play(LED_PWM_LED2, s_blink, 0, 1) != LED_PWM_PARAM_ERROR) {
+    printf("  [FAIL] LED_PWM_Play\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay((2U * TEST_BREATHE_LEN + 5U) * TEST_FRAME_MS);
+
+  n = test_capture(LED_PWM_LED1);
+  if (n >= 0 && (test_match(n, s_breathe, TEST_BREATHE_LEN, 1, &frames1) != TEST_PASS ||
+                 frames1 < 2U * TEST_BREATHE_LEN)) {
+    printf("  [FAIL] LED1 breathe: %lu periods matched\r\n", (unsigned long)frames1);
+    return TEST_FAIL;
+  }
+  n = test_capture(LED_PWM_LED2);
+  if (n >= 0 && (test_match(n, s_blink, TEST_BLINK_LEN, 1, &frames2) != TEST_PASS ||
+                 frames2 < 3U * TEST_BLINK_LEN)) {
+    printf("  [FAIL] LED2 blink: %lu periods matched\r\n", (unsigned long)frames2);
+    return TEST_FAIL;
+  }
+
+  /* 循环播放不开中断：统计只在中断里更新，应保持为 0 */
+  DMA_GetStats(DMA_CH_DMA1_5, &st1);
+  DMA_GetStats(DMA_CH_DMA1_7, &st2);
+  if (!LED_PWM_IsPlaying(LED_PWM_LED1) || !LED_PWM_IsPlaying(LED_PWM_LED2) ||
+      st1.completed != 0 || st1.half != 0 || st2.completed != 0 || st2.half != 0) {
+    printf("  [FAIL] playing %u/%u, DMA interrupts %lu/%lu\r\n",
+           LED_PWM_IsPlaying(LED_PWM_LED1), LED_PWM_IsPlaying(LED_PWM_LED2),
+           (unsigned long)(st1.completed + st1.half),
+           (unsigned long)(st2.completed + st2.half));
+    return TEST_FAIL;
+  }
+
+  LED_PWM_Stop(LED_PWM_LED1);
+  LED_PWM_Stop(LED_PWM_LED2);
+  printf("  [PASS] %lu + %lu periods from RAM tables, 0 DMA interrupts\r\n",
+         (unsigned long)frames1, (unsigned long)frames2);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  测试4：单次播放
+ */
+static int test_oneshot(void) {
+  DMA_ChannelStats_t before, after;
+  uint32_t frames = 0;
+  int n;
+
+  printf("\r\n[TEST] One-shot fade\r\n");
+
+  test_prepare(LED_PWM_LED1);
+  DMA_GetStats(DMA_CH_DMA1_5, &before);
+  if (LED_PWM_Play(LED_PWM_LED1, s_fade, TEST_FADE_LEN, 0) != LED_PWM_OK) {
+    printf("  [FAIL] LED_PWM_Play\r\n");
+    return TEST_FAIL;
+  }
+  HAL_Delay((TEST_FADE_LEN + 10U) * TEST_FRAME_MS);
+
+  n = test_capture(LED_PWM_LED1);
+  if (n >= 0 && (test_match(n, s_fade, TEST_FADE_LEN, 0, &frames) != TEST_PASS ||
+                 frames < TEST_FADE_LEN + 5U)) {
+    printf("  [FAIL] fade: %lu periods matched\r\n", (unsigned long)frames);
+    return TEST_FAIL;
+  }
+
+  DMA_GetStats(DMA_CH_DMA1_5, &after);
+  if (LED_PWM_IsPlaying(LED_PWM_LED1) || after.completed != before.completed + 1U) {
+    printf("  [FAIL] playing %u, %lu TC interrupts\r\n", LED_PWM_IsPlaying(LED_PWM_LED1),
+           (unsigned long)(after.completed - before.completed));
+    return TEST_FAIL;
+  }
+
+  LED_PWM_Stop(LED_PWM_LED1);
+  printf("  [PASS] fade played once and held at %u, 1 TC interrupt\r\n",
+         s_fade[TEST_FADE_LEN - 1U]);
+  return TEST_PASS;
+}
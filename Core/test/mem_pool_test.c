@@ -0,0 +1,444 @@
+/**
+ * @file    mem_pool_test.c
+ * @brief   内存池测试文件
+ * @note    1. 分配到用完：对齐、借用更大的类、失败计数、高水位、全部归还
+ *          2. realloc 原地 / 搬迁，非法释放和重复释放被识别
+ *          3. arena：对齐、mark / release 嵌套、空间不足
+ *          4. 随机分配释放：内容不串块，统计内部碎片，结束后全部回收
+ *          5. 吞吐：内存池、arena 与 C 库 malloc 的分配 + 释放耗时
+ */
+
+#include "mem_pool_test.h"
+#include "mem_pool.h"
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_SLOTS 40U      /* 随机测试同时持有的块数上限 */
+#define TEST_CHURN_OPS 4000U /* 随机测试的操作次数 */
+#define TEST_BATCH 8U       /* 吞吐测试每次分配 / 释放的块数 */
+#define TEST_BATCH_SIZE 24U /* 吞吐测试每块的字节数 */
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/**
+ * @brief  随机测试中持有的一块
+ */
+typedef struct {
+  uint8_t *p;
+  uint16_t size;
+  uint8_t fill;
+} test_slot_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint32_t s_seed = 1;
+static test_slot_t s_slots[TEST_SLOTS];
+static uint8_t s_arena_buf[512];
+static mem_arena_t s_bench_arena;
+static void *s_batch[TEST_BATCH];
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint32_t test_rand(void);
+static uint16_t test_rand_size(void);
+static int test_all_free(void);
+static int test_exhaust(void);
+static int test_realloc_invalid(void);
+static int test_arena(void);
+static int test_churn(void);
+static int test_throughput(void);
+static void bench_fn_pool(void *arg);
+static void bench_fn_arena(void *arg);
+static void bench_fn_malloc(void *arg);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有内存池测试
+ */
+void Mem_Pool_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         Memory Pool Test Suite         \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  mem_pool_init();
+
+  int result1 = test_exhaust();
+  int result2 = test_realloc_invalid();
+  int result3 = test_arena();
+  int result4 = test_churn();
+  int result5 = test_throughput();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  线性同余伪随机数（结果可复现）
+ */
+static uint32_t test_rand(void) {
+  s_seed = s_seed * 1103515245U + 12345U;
+  return s_seed >> 16;
+}
+
+/**
+ * @brief  随机请求大小：多数是小报文，少量中等和大缓冲区
+ */
+static uint16_t test_rand_size(void) {
+  uint32_t r = test_rand() % 100U;
+
+  if (r < 70U) {
+    return (uint16_t)(1U + test_rand() % 32U);
+  }
+  if (r < 95U) {
+    return (uint16_t)(33U + test_rand() % 96U);
+  }
+  return (uint16_t)(129U + test_rand() % 112U);
+}
+
+/**
+ * @brief  所有尺寸类都没有占用的块
+ */
+static int test_all_free(void) {
+  mem_pool_stats_t st;
+
+  for (uint32_t i = 0; i < mem_pool_class_count(); i++) {
+    mem_pool_get_stats(i, &st);
+    if (st.used != 0 || st.requested != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/**
+ * @brief  分配到用完
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_exhaust(void) {
+  static void *blocks[128];
+  mem_pool_stats_t small, next;
+  uint32_t total = 0, n = 0;
+
+  printf("[TEST] Exhaust and fall back\r\n");
+
+  mem_pool_init();
+  for (uint32_t i = 0; i < mem_pool_class_count(); i++) {
+    mem_pool_get_stats(i, &small);
+    total += small.blocks;
+  }
+  if (total > sizeof(blocks) / sizeof(blocks[0])) {
+    printf("  [FAIL] %lu blocks, test array too small\r\n", (unsigned long)total);
+    return TEST_FAIL;
+  }
+
+  /* 只申请最小的尺寸：先用完本类，再依次借用更大的类 */
+  while (n < total) {
+    blocks[n] = mem_alloc(1);
+    if (blocks[n] == NULL || ((uintptr_t)blocks[n] & (MEM_ALIGN - 1U)) != 0) {
+      break;
+    }
+    n++;
+  }
+  if (n != total || mem_alloc(1) != NULL || mem_alloc(1024) != NULL || mem_alloc(0) != NULL) {
+    printf("  [FAIL] got %lu of %lu blocks\r\n", (unsigned long)n, (unsigned long)total);
+    return TEST_FAIL;
+  }
+  mem_pool_get_stats(0, &small);
+  mem_pool_get_stats(1, &next);
+  if (small.failures != 1 || small.peak != small.blocks || next.borrowed != next.blocks) {
+    printf("  [FAIL] failures %lu, peak %u, borrowed %lu\r\n",
+           (unsigned long)small.failures, small.peak, (unsigned long)next.borrowed);
+    return TEST_FAIL;
+  }
+  mem_pool_report();
+
+  while (n > 0) {
+    mem_free(blocks[--n]);
+  }
+  if (!test_all_free() || mem_pool_invalid_frees() != 0) {
+    printf("  [FAIL] Blocks not returned\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu blocks, smallest class borrowed from every larger one\r\n",
+         (unsigned long)total);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  realloc 与非法释放
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_realloc_invalid(void) {
+  uint8_t local[16];
+  uint8_t *p, *q;
+
+  printf("[TEST] Realloc and invalid free\r\n");
+
+  mem_pool_init();
+  p = mem_alloc(10);
+  if (p == NULL || mem_block_size(p) != 16U) {
+    printf("  [FAIL] alloc\r\n");
+    return TEST_FAIL;
+  }
+  memcpy(p, "0123456789", 10);
+
+  /* 块内放得下：原地返回 */
+  q = mem_realloc(p, 16);
+  if (q != p) {
+    printf("  [FAIL] Realloc within block moved\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 放不下：搬到更大的类，内容保留 */
+  q = mem_realloc(p, 100);
+  if (q == NULL || q == p || mem_block_size(q) != 128U || memcmp(q, "0123456789", 10) != 0 ||
+      mem_block_size(p) != 16U) {
+    printf("  [FAIL] Realloc grow\r\n");
+    return TEST_FAIL;
+  }
+
+  mem_free(p);       /* 已被 realloc 释放：重复释放 */
+  mem_free(local);   /* 不属于内存池 */
+  mem_free(q + 8);   /* 不在块边界上 */
+  mem_free(NULL);
+  if (mem_pool_invalid_frees() != 3 || mem_block_size(local) != 0) {
+    printf("  [FAIL] invalid frees %lu\r\n", (unsigned long)mem_pool_invalid_frees());
+    return TEST_FAIL;
+  }
+
+  if (mem_realloc(q, 0) != NULL || !test_all_free()) {
+    printf("  [FAIL] Realloc to 0 did not free\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] In place, move, 3 invalid frees caught\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  arena 分配与回退
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_arena(void) {
+  mem_arena_t arena;
+  uint8_t *a, *b, *c;
+  size_t outer, inner;
+
+  printf("[TEST] Arena mark and release\r\n");
+
+  /* 故意从未对齐的地址开始 */
+  if (mem_arena_init(&arena, &s_arena_buf[3], 200) != MEM_OK ||
+      mem_arena_init(&arena, NULL, 0) != MEM_PARAM_ERROR ||
+      mem_arena_init(&arena, &s_arena_buf[3], 200) != MEM_OK) {
+    printf("  [FAIL] init\r\n");
+    return TEST_FAIL;
+  }
+
+  outer = mem_arena_mark(&arena);
+  a = mem_arena_alloc(&arena, 5);
+  inner = mem_arena_mark(&arena);
+  b = mem_arena_alloc(&arena, 20);
+  c = mem_arena_alloc(&arena, 1);
+  if (a == NULL || b == NULL || c == NULL || ((uintptr_t)a & (MEM_ALIGN - 1U)) != 0 ||
+      b != a + 8 || c != b + 24 || mem_arena_alloc(&arena, arena.size) != NULL ||
+      arena.fails != 1) {
+    printf("  [FAIL] Alignment or overflow\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 内层事务结束，b 的位置被重新使用 */
+  mem_arena_release(&arena, inner);
+  if (mem_arena_alloc(&arena, 4) != b) {
+    printf("  [FAIL] Inner release\r\n");
+    return TEST_FAIL;
+  }
+  mem_arena_release(&arena, outer);
+  if (arena.used != 0 || arena.peak != 40U) {
+    printf("  [FAIL] used %lu peak %lu\r\n", (unsigned long)arena.used,
+           (unsigned long)arena.peak);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu of %lu bytes peak\r\n", (unsigned long)arena.peak,
+         (unsigned long)arena.size);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  随机分配释放
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_churn(void) {
+  mem_pool_stats_t st;
+  uint32_t allocs = 0, fails = 0, borrowed = 0;
+  uint32_t held_max = 0, req_at_max = 0;
+
+  printf("[TEST] Random churn\r\n");
+
+  mem_pool_init();
+  s_seed = 1;
+  memset(s_slots, 0, sizeof(s_slots));
+
+  for (uint32_t op = 0; op < TEST_CHURN_OPS; op++) {
+    test_slot_t *s = &s_slots[test_rand() % TEST_SLOTS];
+    uint32_t held = 0, req = 0;
+
+    if (s->p != NULL) {
+      /* 释放前检查内容没有被别的块覆盖 */
+      for (uint32_t i = 0; i < s->size; i++) {
+        if (s->p[i] != s->fill) {
+          printf("  [FAIL] Block %p overwritten at %lu\r\n", (void *)s->p,
+                 (unsigned long)i);
+          return TEST_FAIL;
+        }
+      }
+      mem_free(s->p);
+      s->p = NULL;
+      continue;
+    }
+
+    s->size = test_rand_size();
+    s->fill = (uint8_t)op;
+    s->p = mem_alloc(s->size);
+    if (s->p == NULL) {
+      continue;
+    }
+    memset(s->p, s->fill, s->size);
+
+    for (uint32_t i = 0; i < mem_pool_class_count(); i++) {
+      mem_pool_get_stats(i, &st);
+      held += (uint32_t)st.used * st.block_size;
+      req += st.requested;
+    }
+    if (held > held_max) {
+      held_max = held;
+      req_at_max = req;
+    }
+  }
+
+  for (uint32_t i = 0; i < TEST_SLOTS; i++) {
+    mem_free(s_slots[i].p);
+  }
+  for (uint32_t i = 0; i < mem_pool_class_count(); i++) {
+    mem_pool_get_stats(i, &st);
+    allocs += st.allocs;
+    fails += st.failures;
+    borrowed += st.borrowed;
+  }
+  mem_pool_report();
+
+  if (!test_all_free() || mem_pool_invalid_frees() != 0 || allocs == 0) {
+    printf("  [FAIL] Pool not fully reclaimed\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 尺寸类按 2 的幂划分，内部碎片不应超过一半 */
+  printf("  %lu allocs, %lu borrowed, %lu failed; peak %lu bytes held for %lu "
+         "requested (%lu%% internal waste)\r\n",
+         (unsigned long)allocs, (unsigned long)borrowed, (unsigned long)fails,
+         (unsigned long)held_max, (unsigned long)req_at_max,
+         (unsigned long)((held_max - req_at_max) * 100U / held_max));
+  if ((held_max - req_at_max) * 2U > held_max) {
+    printf("  [FAIL] Internal waste above 50%%\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] No overlap, fully reclaimed, no external fragmentation\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  被测函数：内存池分配 TEST_BATCH 块再全部释放
+ */
+static void bench_fn_pool(void *arg) {
+  (void)arg;
+  for (uint32_t i = 0; i < TEST_BATCH; i++) {
+    s_batch[i] = mem_alloc(TEST_BATCH_SIZE);
+  }
+  for (uint32_t i = 0; i < TEST_BATCH; i++) {
+    mem_free(s_batch[i]);
+  }
+}
+
+/**
+ * @brief  被测函数：arena 分配 TEST_BATCH 块再整体回退
+ */
+static void bench_fn_arena(void *arg) {
+  size_t mark = mem_arena_mark(&s_bench_arena);
+
+  (void)arg;
+  for (uint32_t i = 0; i < TEST_BATCH; i++) {
+    s_batch[i] = mem_arena_alloc(&s_bench_arena, TEST_BATCH_SIZE);
+  }
+  mem_arena_release(&s_bench_arena, mark);
+}
+
+/**
+ * @brief  被测函数：C 库 malloc / free（参考）
+ */
+static void bench_fn_malloc(void *arg) {
+  (void)arg;
+  for (uint32_t i = 0; i < TEST_BATCH; i++) {
+    s_batch[i] = malloc(TEST_BATCH_SIZE);
+  }
+  for (uint32_t i = 0; i < TEST_BATCH; i++) {
+    free(s_batch[i]);
+  }
+}
+
+/**
+ * @brief  吞吐对比
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_throughput(void) {
+  bench_config_t cfg_pool = {"pool_8x24", 4, 31, 0, BENCH_FLAG_IRQ_OFF};
+  bench_config_t cfg_arena = {"arena_8x24", 4, 31, 0, BENCH_FLAG_IRQ_OFF};
+  bench_config_t cfg_malloc = {"malloc_8x24", 4, 31, 0, BENCH_FLAG_IRQ_OFF};
+  bench_result_t r_pool, r_arena, r_malloc;
+  mem_pool_stats_t st;
+
+  printf("[TEST] Throughput\r\n");
+
+  mem_pool_init();
+  mem_arena_init(&s_bench_arena, s_arena_buf, sizeof(s_arena_buf));
+
+  if (bench_run(&cfg_pool, bench_fn_pool, NULL, &r_pool) != BENCH_OK ||
+      bench_run(&cfg_arena, bench_fn_arena, NULL, &r_arena) != BENCH_OK ||
+      bench_run(&cfg_malloc, bench_fn_malloc, NULL, &r_malloc) != BENCH_OK) {
+    printf("  [FAIL] bench_run\r\n");
+    return TEST_FAIL;
+  }
+  bench_report_header();
+  bench_report(&r_pool);
+  bench_report(&r_arena);
+  bench_report(&r_malloc);
+
+  /* 每次都从本类分配成功，用完全部还回 */
+  mem_pool_get_stats(1, &st);
+  if (st.allocs != (cfg_pool.warmup + cfg_pool.reps) * TEST_BATCH || st.failures != 0 ||
+      st.borrowed != 0 || st.peak != TEST_BATCH || !test_all_free() ||
+      s_bench_arena.used != 0 || s_bench_arena.fails != 0) {
+    printf("  [FAIL] allocs %lu failures %lu peak %u\r\n", (unsigned long)st.allocs,
+           (unsigned long)st.failures, st.peak);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] per alloc+free: pool %lu, arena %lu, malloc %lu %s\r\n",
+         (unsigned long)(r_pool.median / TEST_BATCH),
+         (unsigned long)(r_arena.median / TEST_BATCH),
+         (unsigned long)(r_malloc.median / TEST_BATCH), bench_unit());
+  return TEST_PASS;
+}
@@ -0,0 +1,531 @@
+/**
+ * @file    pt_test.c
+ * @brief   无栈协程与非阻塞擦写测试文件
+ * @note    1. 协程原语：让出、等条件、等中断事件、超时、延时、子协程
+ *          2. W25Q32 非阻塞扇区擦除 + 页编程，两个操作同时挂起时轮流执行；
+ *             后发起的操作先轮询也不会让先发出的操作误判超时
+ *          3. W24C02 非阻塞页写入（应答轮询等待写周期），阻塞版本走同一路径
+ *          4. Flash 和 EEPROM 同时写：协程交替推进 vs 阻塞版本依次执行，
+ *             比较完成时间、每轮推进的开销和上下文 RAM
+ */
+
+#include "pt_test.h"
+#include "pt.h"
+#include "bench.h"
+#include "timer_wheel.h"
+#include "w24c02.h"
+#include "w25q32.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_SECTOR 20U                               /* W25Q32 测试扇区 */
+#define TEST_PAGES 4U                                 /* 编程的页数 */
+#define TEST_FIRST_PAGE (TEST_SECTOR * W25Q32_SECTOR_SIZE / W25Q32_PAGE_SIZE)
+#define TEST_EE_ADDR 0xA0U                            /* W24C02 测试区域 */
+#define TEST_EE_PAGE 8U                               /* 页写入长度 */
+#define TEST_EE_WRITES 4U                             /* 页写入次数 */
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/**
+ * @brief  Flash 任务：擦除一个扇区后编程 TEST_PAGES 页
+ */
+typedef struct {
+  pt_t pt;
+  W25Q32_Op_t op;
+  uint32_t page;
+  uint32_t done;   /* 完成时刻（bench_now） */
+  int ok;
+} test_flash_job_t;
+
+/**
+ * @brief  EEPROM 任务：依次写入 TEST_EE_WRITES 页
+ */
+typedef struct {
+  pt_t pt;
+  W24C02_Op_t op;
+  uint32_t n;
+  uint32_t done;
+  int ok;
+} test_ee_job_t;
+
+/**
+ * @brief  原语测试协程的上下文
+ */
+typedef struct {
+  pt_t pt;
+  pt_t child;
+  uint32_t step;        /* 已执行到的步骤 */
+  uint32_t child_runs;  /* 子协程被调用的次数 */
+  uint32_t t0;
+  uint32_t delay_ms;    /* PT_DELAY(5) 实际经过的毫秒数 */
+  uint32_t event_ms;    /* 等到事件经过的毫秒数 */
+  uint8_t timed_out[2]; /* 两次 PT_AWAIT_TIMEOUT 的结果 */
+} test_prim_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static uint8_t s_flash_data[TEST_PAGES * W25Q32_PAGE_SIZE];
+static uint8_t s_flash_read[TEST_PAGES * W25Q32_PAGE_SIZE];
+static uint8_t s_ee_data[TEST_EE_WRITES * TEST_EE_PAGE];
+static uint8_t s_ee_read[TEST_EE_WRITES * TEST_EE_PAGE];
+static volatile uint8_t s_event = 0;
+static tw_timer_t s_event_timer;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void test_event_cb(tw_timer_t *timer, void *ctx);
+static int test_child(test_prim_t *ctx);
+static int test_prim_thread(test_prim_t *ctx);
+static int test_flash_job(test_flash_job_t *job);
+static int test_ee_job(test_ee_job_t *job);
+static uint32_t test_us(uint32_t cycles);
+static void test_fill(uint8_t seed);
+static int test_verify(void);
+static int test_primitives(void);
+static int test_w25q32_ops(void);
+static int test_w25q32_order(void);
+static int test_w24c02_ops(void);
+static int test_compare(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有协程测试
+ */
+void PT_RunAllTests(void) {
+  W25Q32_State_t state;
+
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("        Protothread Test Suite          \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  register_W24C02_Init();
+  if (tw_init(TW_TICK_HZ) != TW_OK || W25Q32_Init(&state) != W25Q32_OK) {
+    printf("  [FAIL] init\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result1 = test_primitives();
+  int result2 = test_w25q32_ops();
+  if (result2 == TEST_PASS) {
+    result2 = test_w25q32_order();
+  }
+  int result3 = test_w24c02_ops();
+  int result4 = test_compare();
+
+  tw_deinit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  时间轮回调（TIM6 中断）：置位事件标志
+ */
+static void test_event_cb(tw_timer_t *timer, void *ctx) {
+  (void)timer;
+  (void)ctx;
+  s_event = 1;
+}
+
+/**
+ * @brief  子协程：让出两次后结束
+ */
+static int test_child(test_prim_t *ctx) {
+  ctx->child_runs++;
+  PT_BEGIN(&ctx->child);
+  PT_YIELD(&ctx->child);
+  PT_YIELD(&ctx->child);
+  PT_END(&ctx->child);
+}
+
+/**
+ * @brief  原语测试协程
+ */
+static int test_prim_thread(test_prim_t *ctx) {
+  PT_BEGIN(&ctx->pt);
+
+  ctx->step = 1;
+  PT_YIELD(&ctx->pt);
+
+  /* 中断置位的事件 */
+  ctx->step = 2;
+  ctx->t0 = HAL_GetTick();
+  tw_start(&s_event_timer, 3, 0);
+  PT_AWAIT_EVENT(&ctx->pt, s_event);
+  ctx->event_ms = HAL_GetTick() - ctx->t0;
+
+  /* 条件在截止前成立 / 永不成立 */
+  ctx->step = 3;
+  PT_AWAIT_TIMEOUT(&ctx->pt, HAL_GetTick() - ctx->t0 >= ctx->event_ms + 2U, 10);
+  ctx->timed_out[0] = ctx->pt.timed_out;
+  PT_AWAIT_TIMEOUT(&ctx->pt, 0, 4);
+  ctx->timed_out[1] = ctx->pt.timed_out;
+
+  ctx->step = 4;
+  ctx->t0 = HAL_GetTick();
+  PT_DELAY(&ctx->pt, 5);
+  ctx->delay_ms = HAL_GetTick() - ctx->t0;
+
+  ctx->step = 5;
+  PT_SPAWN(&ctx->pt, &ctx->child, test_child(ctx));
+
+  ctx->step = 6;
+  PT_END(&ctx->pt);
+}
+
+/**
+ * @brief  协程原语
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_primitives(void) {
+  test_prim_t ctx;
+  int first, second, ret;
+  uint32_t calls = 2;
+  uint32_t start;
+
+  printf("[TEST] Primitives\r\n");
+
+  memset(&ctx, 0, sizeof(ctx));
+  PT_INIT(&ctx.pt);
+  s_event = 0;
+  tw_timer_init(&s_event_timer, test_event_cb, NULL);
+
+  first = test_prim_thread(&ctx);
+  second = test_prim_thread(&ctx);
+  start = HAL_GetTick();
+  do {
+    ret = test_prim_thread(&ctx);
+    calls++;
+  } while (PT_RUNNING(ret) && HAL_GetTick() - start < 100U);
+
+  if (first != PT_YIELDED || second != PT_WAITING || ret != PT_ENDED ||
+      ctx.step != 6 || ctx.event_ms < 2U || ctx.event_ms > 4U ||
+      ctx.timed_out[0] != 0 || ctx.timed_out[1] != 1 || ctx.delay_ms < 4U ||
+      ctx.delay_ms > 5U || ctx.child_runs != 3 || s_event != 0 ||
+      ctx.pt.lc != 0) {
+    printf("  [FAIL] ret=%d/%d/%d step=%lu event=%lu ms to=%u/%u delay=%lu ms "
+           "child=%lu\r\n",
+           first, second, ret, (unsigned long)ctx.step,
+           (unsigned long)ctx.event_ms, ctx.timed_out[0], ctx.timed_out[1],
+           (unsigned long)ctx.delay_ms, (unsigned long)ctx.child_runs);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu calls, event after %lu ms, delay %lu ms, pt_t %u bytes\r\n",
+         (unsigned long)calls, (unsigned long)ctx.event_ms,
+         (unsigned long)ctx.delay_ms, (unsigned)sizeof(pt_t));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  Flash 任务协程
+ */
+static int test_flash_job(test_flash_job_t *job) {
+  PT_BEGIN(&job->pt);
+
+  job->ok = 0;
+  W25Q32_SectorErase_4KB_Start(&job->op, TEST_SECTOR);
+  PT_WAIT_UNTIL(&job->pt, !PT_RUNNING(W25Q32_Op_Poll(&job->op)));
+  if (job->op.status != W25Q32_OK) {
+    PT_EXIT(&job->pt);
+  }
+
+  for (job->page = 0; job->page < TEST_PAGES; job->page++) {
+    W25Q32_PageProgram_Start(&job->op, TEST_FIRST_PAGE + job->page, 0,
+                             &s_flash_data[job->page * W25Q32_PAGE_SIZE],
+                             W25Q32_PAGE_SIZE);
+    PT_WAIT_UNTIL(&job->pt, !PT_RUNNING(W25Q32_Op_Poll(&job->op)));
+    if (job->op.status != W25Q32_OK) {
+      PT_EXIT(&job->pt);
+    }
+  }
+  job->ok = 1;
+  job->done = bench_now();
+
+  PT_END(&job->pt);
+}
+
+/**
+ * @brief  EEPROM 任务协程
+ */
+static int test_ee_job(test_ee_job_t *job) {
+  PT_BEGIN(&job->pt);
+
+  job->ok = 0;
+  for (job->n = 0; job->n < TEST_EE_WRITES; job->n++) {
+    register_W24C02_WriteBytes_Start(&job->op,
+                                     (uint8_t)(TEST_EE_ADDR + job->n * TEST_EE_PAGE),
+                                     &s_ee_data[job->n * TEST_EE_PAGE],
+                                     TEST_EE_PAGE);
+    PT_WAIT_UNTIL(&job->pt, !PT_RUNNING(register_W24C02_Op_Poll(&job->op)));
+    if (job->op.status != W24C02_OP_OK) {
+      PT_EXIT(&job->pt);
+    }
+  }
+  job->ok = 1;
+  job->done = bench_now();
+
+  PT_END(&job->pt);
+}
+
+/**
+ * @brief  周期数换算为微秒
+ */
+static uint32_t test_us(uint32_t cycles) {
+  return (uint32_t)((uint64_t)cycles * 1000000U / bench_freq());
+}
+
+/**
+ * @brief  生成 Flash / EEPROM 测试数据
+ */
+static void test_fill(uint8_t seed) {
+  for (uint32_t i = 0; i < sizeof(s_flash_data); i++) {
+    s_flash_data[i] = (uint8_t)(seed + i * 13U);
+  }
+  for (uint32_t i = 0; i < sizeof(s_ee_data); i++) {
+    s_ee_data[i] = (uint8_t)(seed ^ (i * 29U));
+  }
+}
+
+/**
+ * @brief  读回并比较两个器件的数据
+ * @retval 1 一致
+ */
+static int test_verify(void) {
+  W25Q32_ReadData(TEST_SECTOR * W25Q32_SECTOR_SIZE, s_flash_read,
+                  sizeof(s_flash_read));
+  Hal_W24C02_ReadBytes(TEST_EE_ADDR, s_ee_read, sizeof(s_ee_read));
+  return memcmp(s_flash_read, s_flash_data, sizeof(s_flash_data)) == 0 &&
+         memcmp(s_ee_read, s_ee_data, sizeof(s_ee_data)) == 0;
+}
+
+/**
+ * @brief  W25Q32 非阻塞擦写
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_w25q32_ops(void) {
+  static const uint8_t pattern[] = {0x5A, 0xA5, 0x3C, 0xC3};
+  W25Q32_Op_t erase, prog;
+  uint8_t read[sizeof(pattern)];
+  int r1, r2;
+  uint32_t polls = 0;
+  uint32_t start;
+
+  printf("[TEST] W25Q32 erase + program in flight together\r\n");
+
+  if (W25Q32_SectorErase_4KB_Start(&erase, 1024) != W25Q32_INVALID_PARAM ||
+      W25Q32_PageProgram_Start(&prog, 0, 256, pattern, 1) != W25Q32_INVALID_PARAM) {
+    printf("  [FAIL] Invalid parameters accepted\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 同时启动：编程要等擦除完成后才会发出 */
+  W25Q32_SectorErase_4KB_Start(&erase, TEST_SECTOR);
+  W25Q32_PageProgram_Start(&prog, TEST_FIRST_PAGE, 16, pattern, sizeof(pattern));
+  start = HAL_GetTick();
+  do {
+    r1 = W25Q32_Op_Poll(&erase);
+    r2 = W25Q32_Op_Poll(&prog);
+    polls++;
+  } while ((PT_RUNNING(r1) || PT_RUNNING(r2)) && HAL_GetTick() - start < 1000U);
+
+  W25Q32_ReadData(TEST_SECTOR * W25Q32_SECTOR_SIZE + 16, read, sizeof(read));
+  if (erase.status != W25Q32_OK || prog.status != W25Q32_OK ||
+      memcmp(read, pattern, sizeof(pattern)) != 0) {
+    printf("  [FAIL] status %d / %d, data %02X %02X\r\n", erase.status,
+           prog.status, read[0], read[1]);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu ms, %lu polls, W25Q32_Op_t %u bytes\r\n",
+         (unsigned long)(HAL_GetTick() - start), (unsigned long)polls,
+         (unsigned)sizeof(W25Q32_Op_t));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  W25Q32 后发起的操作先轮询
+ * @retval TEST_PASS / TEST_FAIL
+ *
+ * @details
+ * 页编程先发出指令，之后每轮先轮询擦除：芯片空闲后擦除若立即发出，
+ * BUSY 会一直保持到擦除结束，编程就会在自己的 5ms 预算内等不到空闲。
+ * 芯片从写使能到 BUSY 清除都归一个操作所有，擦除要等编程结束才发出。
+ */
+static int test_w25q32_order(void) {
+  static const uint8_t pattern[] = {0x11, 0x22, 0x33, 0x44};
+  W25Q32_Op_t prog, erase;
+  uint8_t read[sizeof(pattern)];
+  int r1, r2;
+  uint32_t start;
+
+  printf("[TEST] W25Q32 later op polled first\r\n");
+
+  /* 编程写入上一项擦除过的扇区的空白区域，擦除另一个扇区 */
+  W25Q32_PageProgram_Start(&prog, TEST_FIRST_PAGE, 32, pattern, sizeof(pattern));
+  W25Q32_Op_Poll(&prog);
+  W25Q32_SectorErase_4KB_Start(&erase, TEST_SECTOR + 1U);
+  start = HAL_GetTick();
+  do {
+    r2 = W25Q32_Op_Poll(&erase);
+    r1 = W25Q32_Op_Poll(&prog);
+  } while ((PT_RUNNING(r1) || PT_RUNNING(r2)) && HAL_GetTick() - start < 1000U);
+
+  W25Q32_ReadData(TEST_SECTOR * W25Q32_SECTOR_SIZE + 32, read, sizeof(read));
+  if (prog.status != W25Q32_OK || erase.status != W25Q32_OK ||
+      memcmp(read, pattern, sizeof(pattern)) != 0) {
+    printf("  [FAIL] status %d / %d, data %02X %02X\r\n", prog.status,
+           erase.status, read[0], read[1]);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu ms\r\n", (unsigned long)(HAL_GetTick() - start));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  W24C02 非阻塞写入
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_w24c02_ops(void) {
+  static const uint8_t page[TEST_EE_PAGE] = {1, 2, 3, 4, 5, 6, 7, 8};
+  W24C02_Op_t a, b;
+  uint8_t read[TEST_EE_PAGE + 1];
+  int r1, r2;
+  uint32_t t0, t_blocking, t_pt, start;
+
+  printf("[TEST] W24C02 page + byte write in flight together\r\n");
+
+  /* 阻塞版本的单次页写入时间作为对比 */
+  t0 = bench_now();
+  if (register_W24C02_WriteBytes(TEST_EE_ADDR, (uint8_t *)page, TEST_EE_PAGE) !=
+      W24C02_OP_OK) {
+    printf("  [FAIL] Blocking page write\r\n");
+    return TEST_FAIL;
+  }
+  t_blocking = bench_now() - t0;
+
+  register_W24C02_WriteBytes_Start(&a, TEST_EE_ADDR, page, TEST_EE_PAGE);
+  register_W24C02_WriteByte_Start(&b, TEST_EE_ADDR + TEST_EE_PAGE, 0x99);
+  t0 = bench_now();
+  start = HAL_GetTick();
+  t_pt = 0;
+  do {
+    r1 = register_W24C02_Op_Poll(&a);
+    if (!PT_RUNNING(r1) && t_pt == 0) {
+      t_pt = bench_now() - t0;
+    }
+    r2 = register_W24C02_Op_Poll(&b);
+  } while ((PT_RUNNING(r1) || PT_RUNNING(r2)) && HAL_GetTick() - start < 100U);
+
+  Hal_W24C02_ReadBytes(TEST_EE_ADDR, read, sizeof(read));
+  if (a.status != W24C02_OP_OK || b.status != W24C02_OP_OK ||
+      memcmp(read, page, TEST_EE_PAGE) != 0 || read[TEST_EE_PAGE] != 0x99) {
+    printf("  [FAIL] status %d / %d, data %02X %02X\r\n", a.status, b.status,
+           read[0], read[TEST_EE_PAGE]);
+    return TEST_FAIL;
+  }
+  /* 阻塞版本就是把同一个操作轮询到结束，两者都在写周期结束时返回 */
+  if (t_pt > t_blocking + t_blocking / 4U || t_blocking > t_pt + t_pt / 4U) {
+    printf("  [FAIL] page write %lu us vs blocking %lu us\r\n",
+           (unsigned long)test_us(t_pt), (unsigned long)test_us(t_blocking));
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] page write %lu us (blocking %lu us), W24C02_Op_t %u bytes\r\n",
+         (unsigned long)test_us(t_pt), (unsigned long)test_us(t_blocking),
+         (unsigned)sizeof(W24C02_Op_t));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  两个器件同时写：协程 vs 阻塞
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_compare(void) {
+  test_flash_job_t fj;
+  test_ee_job_t ej;
+  uint32_t t0, t_flash_blk, t_all_blk, t_all_pt;
+  uint32_t t_busy = 0;
+  uint32_t polls = 0;
+  int rf = PT_WAITING;
+  int re = PT_WAITING;
+
+  printf("[TEST] Flash + EEPROM writes: protothreads vs blocking\r\n");
+
+  /* 阻塞版本：依次执行，CPU 全程忙等 */
+  test_fill(0x11);
+  t0 = bench_now();
+  W25Q32_SectorErase_4KB(TEST_SECTOR);
+  for (uint32_t i = 0; i < TEST_PAGES; i++) {
+    W25Q32_PageProgram(TEST_FIRST_PAGE + i, 0, &s_flash_data[i * W25Q32_PAGE_SIZE],
+                       W25Q32_PAGE_SIZE);
+  }
+  t_flash_blk = bench_now() - t0;
+  for (uint32_t i = 0; i < TEST_EE_WRITES; i++) {
+    register_W24C02_WriteBytes((uint8_t)(TEST_EE_ADDR + i * TEST_EE_PAGE),
+                               &s_ee_data[i * TEST_EE_PAGE], TEST_EE_PAGE);
+  }
+  t_all_blk = bench_now() - t0;
+  if (!test_verify()) {
+    printf("  [FAIL] Blocking data mismatch\r\n");
+    return TEST_FAIL;
+  }
+
+  /* 协程版本：一个循环推进两个任务，统计调用次数和在协程里花的时间 */
+  test_fill(0x77);
+  PT_INIT(&fj.pt);
+  PT_INIT(&ej.pt);
+  t0 = bench_now();
+  while ((PT_RUNNING(rf) || PT_RUNNING(re)) && bench_now() - t0 < bench_freq()) {
+    uint32_t t = bench_now();
+    if (PT_RUNNING(rf)) {
+      rf = test_flash_job(&fj);
+    }
+    if (PT_RUNNING(re)) {
+      re = test_ee_job(&ej);
+    }
+    t_busy += bench_now() - t;
+    polls++;
+  }
+  t_all_pt = bench_now() - t0;
+
+  if (!fj.ok || !ej.ok || !test_verify()) {
+    printf("  [FAIL] flash %d eeprom %d\r\n", fj.ok, ej.ok);
+    return TEST_FAIL;
+  }
+
+  printf("  mode          total us  flash done us  eeprom done us\r\n");
+  printf("  blocking     %9lu      %9lu       %9lu\r\n",
+         (unsigned long)test_us(t_all_blk), (unsigned long)test_us(t_flash_blk),
+         (unsigned long)test_us(t_all_blk));
+  printf("  protothread  %9lu      %9lu       %9lu\r\n",
+         (unsigned long)test_us(t_all_pt), (unsigned long)test_us(fj.done - t0),
+         (unsigned long)test_us(ej.done - t0));
+  printf("  %lu passes, %lu cycles per pass; RAM per job: flash %u, eeprom %u "
+         "bytes on one shared stack\r\n",
+         (unsigned long)polls, (unsigned long)(t_busy / (polls ? polls : 1)),
+         (unsigned)sizeof(fj), (unsigned)sizeof(ej));
+
+  /* EEPROM 写入与 Flash 擦除重叠，总时间接近两者中较长的一个 */
+  if (t_all_pt >= t_all_blk || ej.done - t0 >= t_all_blk - t_flash_blk + t_flash_blk / 2U) {
+    printf("  [FAIL] Writes did not overlap\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu us -> %lu us\r\n", (unsigned long)test_us(t_all_blk),
+         (unsigned long)test_us(t_all_pt));
+  return TEST_PASS;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file    ram_monitor_test.c
+ * @brief   栈 / 堆高水位测试文件
+ * @note    1. 启动涂色后的布局与统计：栈深度、堆用量、剩余 RAM
+ *          2. 重新涂色后分别调用使用 256 / 1024 字节局部缓冲区的函数，
+ *             测得的深度差与缓冲区大小之差一致（主机上深度还包含仿真器
+ *             在同一个栈上运行的外设模型，只有差值有意义）
+ *          3. 保护字：改写后 TIM6 时间轮上的周期检查发现，恢复后不再报告
+ */
+
+#include "ram_monitor_test.h"
+#include "ram_monitor.h"
+#include "timer_wheel.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_ALIGN 16U     /* 帧大小的对齐误差 */
+#define TEST_REPEAT 3U     /* 深度测量次数 */
+#define TEST_GUARD_MS 2U   /* 保护字检查周期 */
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint32_t test_use_256(void) __attribute__((noinline));
+static uint32_t test_use_1024(void) __attribute__((noinline));
+static uint32_t test_depth_of(uint32_t (*fn)(void));
+static int test_layout(void);
+static int test_depth(void);
+static int test_guard(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 RAM 监视测试
+ */
+void RAM_Monitor_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("         RAM Monitor Test Suite         \r\n");
+  printf("========================================\r\n");
+
+  int result1 = test_layout();
+  int result2 = test_depth();
+  int result3 = test_guard();
+
+  ram_report();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  在栈上使用 256 字节（同 test_performance 的页缓冲区）
+ */
+static uint32_t test_use_256(void) {
+  volatile uint8_t buffer[256];
+  uint32_t sum = 0;
+
+  for (uint32_t i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = (uint8_t)i;
+  }
+  for (uint32_t i = 0; i < sizeof(buffer); i++) {
+    sum += buffer[i];
+  }
+  return sum;
+}
+
+/**
+ * @brief  在栈上使用 1024 字节
+ */
+static uint32_t test_use_1024(void) {
+  volatile uint8_t buffer[1024];
+  uint32_t sum = 0;
+
+  for (uint32_t i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = (uint8_t)i;
+  }
+  for (uint32_t i = 0; i < sizeof(buffer); i++) {
+    sum += buffer[i];
+  }
+  return sum;
+}
+
+/**
+ * @brief  重新涂色后调用 fn，返回比 ram_get_stats 自身多用的栈深度
+ * @note   取 TEST_REPEAT 次中的最小值，排除恰好叠加了中断帧的一次
+ */
+static uint32_t test_depth_of(uint32_t (*fn)(void)) {
+  ram_stats_t before, after;
+  uint32_t depth = UINT32_MAX;
+
+  for (uint32_t i = 0; i < TEST_REPEAT; i++) {
+    ram_paint_stack();
+    ram_get_stats(&before);
+    (void)fn();
+    ram_get_stats(&after);
+    if (after.stack_peak - before.stack_peak < depth) {
+      depth = after.stack_peak - before.stack_peak;
+    }
+  }
+  return depth;
+}
+
+/**
+ * @brief  布局与统计
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_layout(void) {
+  ram_layout_t l;
+  ram_stats_t st;
+
+  printf("[TEST] Layout and high-water marks\r\n");
+
+  ram_get_layout(&l);
+  ram_get_stats(&st);
+  printf("  heap %08lx-%08lx, stack %08lx-%08lx\r\n", (unsigned long)l.heap_start,
+         (unsigned long)l.heap_end, (unsigned long)l.stack_limit,
+         (unsigned long)l.stack_top);
+
+  if (l.heap_start > l.heap_end || l.heap_end > l.stack_limit ||
+      l.stack_limit >= l.stack_top || st.stack_peak == 0 ||
+      st.stack_peak > st.stack_size || st.free_min == 0 ||
+      st.heap_peak + st.free_min + st.stack_peak != l.stack_top - l.heap_start) {
+    printf("  [FAIL] stack %lu/%lu heap %lu free %lu\r\n",
+           (unsigned long)st.stack_peak, (unsigned long)st.stack_size,
+           (unsigned long)st.heap_peak, (unsigned long)st.free_min);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] stack peak %lu of %lu, heap %lu, never used %lu bytes\r\n",
+         (unsigned long)st.stack_peak, (unsigned long)st.stack_size,
+         (unsigned long)st.heap_peak, (unsigned long)st.free_min);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  深度测量
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_depth(void) {
+  uint32_t d256, d1024;
+
+  printf("[TEST] Stack depth of a call\r\n");
+
+  d256 = test_depth_of(test_use_256);
+  d1024 = test_depth_of(test_use_1024);
+  printf("  256-byte buffer: %lu, 1024-byte buffer: %lu bytes\r\n",
+         (unsigned long)d256, (unsigned long)d1024);
+
+  /* 两个函数只差缓冲区大小，深度差应为 768 字节（帧按 8 / 16 字节对齐） */
+  if (d1024 < d256 + 768U - TEST_ALIGN || d1024 > d256 + 768U + TEST_ALIGN) {
+    printf("  [FAIL] Depth does not follow buffer size\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Difference %lu bytes\r\n", (unsigned long)(d1024 - d256));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  保护字检查
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_guard(void) {
+  ram_layout_t l;
+  ram_stats_t st;
+  volatile uint32_t *guard;
+  uint32_t hits, t0;
+
+  printf("[TEST] Guard words checked from TIM6\r\n");
+
+  ram_get_layout(&l);
+  guard = (volatile uint32_t *)((l.stack_limit + 3U) & ~(uintptr_t)3U);
+  ram_get_stats(&st);
+  hits = st.guard_hits;
+
+  if (ram_guard_check() != RAM_OK || tw_init(TW_TICK_HZ) != TW_OK ||
+      ram_guard_start(TEST_GUARD_MS) != RAM_OK) {
+    printf("  [FAIL] Guard already hit or timer failed\r\n");
+    tw_deinit();
+    return TEST_FAIL;
+  }
+
+  /* 模拟栈溢出到预留区底部 */
+  HAL_Delay(5);
+  ram_get_stats(&st);
+  if (st.guard_hits != hits) {
+    printf("  [FAIL] Hit before overflow\r\n");
+    ram_guard_stop();
+    tw_deinit();
+    return TEST_FAIL;
+  }
+  guard[RAM_GUARD_WORDS - 1U] = 0;
+  t0 = HAL_GetTick();
+  do {
+    ram_get_stats(&st);
+  } while (st.guard_hits == hits && HAL_GetTick() - t0 < 20U);
+  ram_guard_stop();
+  tw_deinit();
+  guard[RAM_GUARD_WORDS - 1U] = RAM_PAINT_PATTERN;
+
+  if (st.guard_hits == hits || ram_guard_check() != RAM_OK) {
+    printf("  [FAIL] Overflow not detected\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Detected after %lu ms\r\n", (unsigned long)(HAL_GetTick() - t0));
+  return TEST_PASS;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file    ramfunc_test.c
+ * @brief   RAM 中执行函数的测试文件
+ * @note    同一段代码各编译一份 Flash 版本（本文件）和 RAM 版本（RAMFUNC），
+ *          比较 FLASH_LATENCY_2 下的周期数：
+ *          1. Register_SPI_SwapByte：每字节节省的周期
+ *          2. USART1_IRQHandler（无标志时的进出路径）：每次中断节省的周期
+ */
+
+#include "ramfunc_test.h"
+#include "bench.h"
+#include "spi.h"
+#include "stm32f1xx_it.h"
+#include "usart.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_SPI_BYTES 64U /* 每次测量交换的字节数 */
+#define TEST_ISR_CALLS 16U /* 每次测量调用中断处理函数的次数 */
+
+/* 私有类型 ------------------------------------------------------------------*/
+typedef uint8_t (*test_swap_fn_t)(uint8_t byte);
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint8_t test_swap_flash(uint8_t byte) __attribute__((noinline));
+static void test_usart1_irq_flash(void) __attribute__((noinline));
+static void bench_fn_swap(void *arg);
+static void bench_fn_isr(void *arg);
+static int test_compare(const char *what, bench_config_t *cfg_flash,
+                        bench_config_t *cfg_ram, bench_fn_t fn, void *flash,
+                        void *ram, uint32_t count);
+static int test_spi_byte(void);
+static int test_usart_isr(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 RAM 函数测试
+ */
+void RAMFunc_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("       RAM Function Test Suite          \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  printf("  FLASH_ACR.LATENCY = %lu wait states\r\n",
+         (unsigned long)(FLASH->ACR & FLASH_ACR_LATENCY));
+  bench_report_header();
+
+  int result1 = test_spi_byte();
+  int result2 = test_usart_isr();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  Register_SPI_SwapByte 的 Flash 版本（代码相同）
+ */
+static uint8_t test_swap_flash(uint8_t byte) {
+  while ((SPI1->SR & SPI_SR_TXE) == 0) ;
+  SPI1->DR = byte;
+  while ((SPI1->SR & SPI_SR_RXNE) == 0) ;
+  return (uint8_t)(SPI1->DR & 0xFF);
+}
+
+/**
+ * @brief  USART1_IRQHandler 的 Flash 版本（代码相同）
+ */
+static void test_usart1_irq_flash(void) {
+  HAL_UART_IRQHandler(&huart1);
+
+  uint32_t sr = USART1->SR;
+
+  if ((sr & USART_SR_RXNE) != 0) {
+    if (g_usart_rx_len < sizeof(g_usart_rx_buffer)) {
+      g_usart_rx_buffer[g_usart_rx_len++] = (uint8_t)USART1->DR;
+    } else {
+      volatile uint32_t discard = USART1->DR;
+      (void)discard;
+    }
+  }
+  if ((sr & USART_SR_IDLE) != 0) {
+    volatile uint32_t temp_val = USART1->SR;
+    temp_val = USART1->DR;
+    (void)temp_val;
+    g_usart_message_ready = 1;
+    usart_post_rx_event();
+  }
+}
+
+/**
+ * @brief  被测函数：交换 TEST_SPI_BYTES 个字节
+ */
+static void bench_fn_swap(void *arg) {
+  test_swap_fn_t swap = (test_swap_fn_t)arg;
+
+  Register_SPI_Start();
+  for (uint32_t i = 0; i < TEST_SPI_BYTES; i++) {
+    (void)swap((uint8_t)i);
+  }
+  Register_SPI_Stop();
+}
+
+/**
+ * @brief  被测函数：调用 TEST_ISR_CALLS 次中断处理函数
+ */
+static void bench_fn_isr(void *arg) {
+  void (*isr)(void) = (void (*)(void))arg;
+
+  for (uint32_t i = 0; i < TEST_ISR_CALLS; i++) {
+    isr();
+  }
+}
+
+/**
+ * @brief  分别测量 Flash / RAM 版本，RAM 版本应更快
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_compare(const char *what, bench_config_t *cfg_flash,
+                        bench_config_t *cfg_ram, bench_fn_t fn, void *flash,
+                        void *ram, uint32_t count) {
+  bench_result_t r_flash, r_ram;
+
+  if (bench_run(cfg_flash, fn, flash, &r_flash) != BENCH_OK ||
+      bench_run(cfg_ram, fn, ram, &r_ram) != BENCH_OK) {
+    printf("  [FAIL] bench_run\r\n");
+    return TEST_FAIL;
+  }
+  bench_report(&r_flash);
+  bench_report(&r_ram);
+
+  if (r_ram.median >= r_flash.median) {
+    printf("  [FAIL] RAM %lu >= flash %lu %s\r\n", (unsigned long)r_ram.median,
+           (unsigned long)r_flash.median, bench_unit());
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu -> %lu %s per %s, %lu saved (%lu%%)\r\n",
+         (unsigned long)(r_flash.median / count), (unsigned long)(r_ram.median / count),
+         bench_unit(), what,
+         (unsigned long)((r_flash.median - r_ram.median) / count),
+         (unsigned long)((r_flash.median - r_ram.median) * 100U / r_flash.median));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  SPI 逐字节交换
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_spi_byte(void) {
+  bench_config_t cfg_flash = {"spi_swap_flash", 2, 15, TEST_SPI_BYTES, BENCH_FLAG_IRQ_OFF};
+  bench_config_t cfg_ram = {"spi_swap_ram", 2, 15, TEST_SPI_BYTES, BENCH_FLAG_IRQ_OFF};
+
+  printf("[TEST] Register_SPI_SwapByte from RAM\r\n");
+
+  __HAL_SPI_ENABLE(&hspi1);
+  return test_compare("byte", &cfg_flash, &cfg_ram, bench_fn_swap,
+                      (void *)test_swap_flash, (void *)Register_SPI_SwapByte,
+                      TEST_SPI_BYTES);
+}
+
+/**
+ * @brief  USART1 中断处理函数
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_usart_isr(void) {
+  bench_config_t cfg_flash = {"usart1_isr_flash", 2, 15, 0, BENCH_FLAG_IRQ_OFF};
+  bench_config_t cfg_ram = {"usart1_isr_ram", 2, 15, 0, BENCH_FLAG_IRQ_OFF};
+
+  printf("[TEST] USART1_IRQHandler from RAM\r\n");
+
+  /* 等日志发完，TXE / TC 之外没有挂起的标志 */
+  while ((USART1->SR & USART_SR_TC) == 0) {
+  }
+  return test_compare("ISR", &cfg_flash, &cfg_ram, bench_fn_isr,
+                      (void *)test_usart1_irq_flash, (void *)USART1_IRQHandler,
+                      TEST_ISR_CALLS);
+}
@@ -0,0 +1,238 @@
+/**
+ * @file    spi_bus_test.c
+ * @brief   SPI1 DMA 事务接口测试文件
+ * @note    1. 设备切换时才重写 CR1，CR1 与设备描述一致
+ *          2. 异步队列按提交顺序完成并回调
+ *          3. 通过 spi_xfer 读取板载 W25Q32 的 JEDEC ID（KEEP_CS 分两段提交）
+ *          4. 256 字节传输：DMA 事务与 Register_SPI_SwapByte 逐字节的周期数对比
+ */
+
+#include "spi_bus_test.h"
+#include "dma_manager.h"
+#include "spi.h"
+#include "spi_bus.h"
+#include "w25q32.h"
+#include "bench.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_BLOCK 256
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/** 与 W25Q32 共用 CS，但使用模式3、16 位帧、更低速率，用于验证设备切换 */
+static const spi_device_t s_dev_alt = {
+    CS_GPIO_Port, CS_Pin, SPI_BUS_MODE3, 5, 1, 0,
+};
+
+static uint8_t s_tx[TEST_BLOCK];
+static uint8_t s_rx[TEST_BLOCK];
+static volatile uint8_t s_order[SPI_BUS_QUEUE_LEN];
+static volatile uint32_t s_order_count = 0;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static int test_reconfigure(void);
+static int test_queue_order(void);
+static int test_jedec_id(void);
+static int test_throughput(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有 SPI 事务接口测试
+ */
+void SPI_Bus_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("     SPI1 DMA Transaction Test Suite    \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+  if (spi_bus_init() != SPI_BUS_OK) {
+    printf("  [FAIL] spi_bus_init (DMA channel already claimed)\r\n");
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+
+  int result1 = test_reconfigure();
+  int result2 = test_queue_order();
+  int result3 = test_jedec_id();
+  int result4 = test_throughput();
+
+  spi_bus_deinit();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  同一设备连续事务不重写 CR1，换设备时重写且内容正确
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_reconfigure(void) {
+  spi_bus_stats_t before, after;
+  uint16_t words[4] = {0x1234, 0x5678, 0x9ABC, 0xDEF0};
+  uint32_t cr1;
+  int fail = 0;
+
+  printf("[TEST] CR1 rewritten only on device change\r\n");
+
+  spi_bus_get_stats(&before);
+  spi_xfer(&spi_dev_w25q32, NULL, NULL, 4, 0);
+  spi_xfer(&spi_dev_w25q32, NULL, NULL, 4, 0);
+  spi_xfer(&spi_dev_w25q32, NULL, NULL, 4, 0);
+  spi_bus_get_stats(&after);
+  if (after.reconfigs - before.reconfigs != 1 ||
+      after.xfers - before.xfers != 3) {
+    printf("  [FAIL] Same device: reconfigs=%lu\r\n",
+           (unsigned long)(after.reconfigs - before.reconfigs));
+    fail++;
+  }
+
+  spi_xfer(&s_dev_alt, words, NULL, 4, 0);
+  cr1 = SPI1->CR1;
+  if ((cr1 & (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_DFF)) !=
+          (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_DFF) ||
+      ((cr1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos) != 5 ||
+      (cr1 & (SPI_CR1_MSTR | SPI_CR1_SPE)) != (SPI_CR1_MSTR | SPI_CR1_SPE)) {
+    printf("  [FAIL] CR1=0x%04lX for mode3/16-bit/div64\r\n",
+           (unsigned long)cr1);
+    fail++;
+  }
+
+  spi_xfer(&spi_dev_w25q32, NULL, NULL, 4, 0);
+  spi_bus_get_stats(&after);
+  if (after.reconfigs - before.reconfigs != 3 ||
+      (SPI1->CR1 & (SPI_CR1_CPOL | SPI_CR1_DFF)) != 0) {
+    printf("  [FAIL] Switch back: reconfigs=%lu\r\n",
+           (unsigned long)(after.reconfigs - before.reconfigs));
+    fail++;
+  }
+
+  if (fail == 0) {
+    printf("  [PASS] 3 reconfigurations for 5 transactions\r\n");
+    return TEST_PASS;
+  }
+  return TEST_FAIL;
+}
+
+/**
+ * @brief  记录回调顺序
+ */
+static void test_order_cb(int status, void *ctx) {
+  if (status == SPI_BUS_OK && s_order_count < SPI_BUS_QUEUE_LEN) {
+    s_order[s_order_count++] = (uint8_t)(uintptr_t)ctx;
+  }
+}
+
+/**
+ * @brief  关中断一次提交满队列，依次完成
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_queue_order(void) {
+  int ret_full;
+  int i;
+
+  printf("[TEST] Back-to-back queued transactions\r\n");
+
+  s_order_count = 0;
+  __disable_irq();
+  for (i = 0; i < SPI_BUS_QUEUE_LEN; i++) {
+    const spi_device_t *dev = (i & 1) ? &s_dev_alt : &spi_dev_w25q32;
+    spi_xfer_async(dev, s_tx, NULL, 16, 0, test_order_cb, (void *)(uintptr_t)i);
+  }
+  ret_full = spi_xfer_async(&spi_dev_w25q32, s_tx, NULL, 16, 0, NULL, NULL);
+  __enable_irq();
+  spi_bus_wait();
+
+  if (ret_full != SPI_BUS_QUEUE_FULL || s_order_count != SPI_BUS_QUEUE_LEN) {
+    printf("  [FAIL] full=%d completed=%lu\r\n", ret_full,
+           (unsigned long)s_order_count);
+    return TEST_FAIL;
+  }
+  for (i = 0; i < SPI_BUS_QUEUE_LEN; i++) {
+    if (s_order[i] != i) {
+      printf("  [FAIL] Completion %d was job %u\r\n", i, s_order[i]);
+      return TEST_FAIL;
+    }
+  }
+  if (HAL_GPIO_ReadPin(CS_GPIO_Port, CS_Pin) != GPIO_PIN_SET) {
+    printf("  [FAIL] CS left asserted\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %d transactions completed in order, CS released\r\n",
+         SPI_BUS_QUEUE_LEN);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  命令字节与 3 字节应答分两次提交，用 KEEP_CS 保持同一次片选
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_jedec_id(void) {
+  uint8_t cmd = W25Q32_CMD_JEDEC_ID;
+  uint8_t id[3] = {0};
+
+  printf("[TEST] W25Q32 JEDEC ID via spi_xfer\r\n");
+
+  if (spi_xfer(&spi_dev_w25q32, &cmd, NULL, 1, SPI_XFER_KEEP_CS) !=
+          SPI_BUS_OK ||
+      HAL_GPIO_ReadPin(CS_GPIO_Port, CS_Pin) != GPIO_PIN_RESET ||
+      spi_xfer(&spi_dev_w25q32, NULL, id, 3, 0) != SPI_BUS_OK ||
+      HAL_GPIO_ReadPin(CS_GPIO_Port, CS_Pin) != GPIO_PIN_SET) {
+    printf("  [FAIL] KEEP_CS sequencing\r\n");
+    return TEST_FAIL;
+  }
+
+  if (id[0] != W25Q32_EXPECTED_MANUFACTURER_ID) {
+    printf("  [FAIL] JEDEC ID %02X %02X %02X\r\n", id[0], id[1], id[2]);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] JEDEC ID %02X %02X %02X\r\n", id[0], id[1], id[2]);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  256 字节：DMA 事务 vs 寄存器方式逐字节
+ * @retval TEST_PASS
+ */
+static int test_throughput(void) {
+  uint32_t t0, dma_cycles, reg_cycles;
+  int i;
+
+  printf("[TEST] 256-byte transfer cycles\r\n");
+
+  for (i = 0; i < TEST_BLOCK; i++) {
+    s_tx[i] = (uint8_t)i;
+  }
+
+  /* 先让 CR1 回到 W25Q32 的配置，两种方式使用相同的 SCK 频率 */
+  spi_xfer(&spi_dev_w25q32, NULL, NULL, 1, 0);
+
+  t0 = bench_now();
+  spi_xfer(&spi_dev_w25q32, s_tx, s_rx, TEST_BLOCK, 0);
+  dma_cycles = bench_now() - t0;
+
+  t0 = bench_now();
+  Register_SPI_Start();
+  for (i = 0; i < TEST_BLOCK; i++) {
+    s_rx[i] = Register_SPI_SwapByte(s_tx[i]);
+  }
+  Register_SPI_Stop();
+  reg_cycles = bench_now() - t0;
+
+  printf("  [PASS] spi_xfer=%lu cycles, SwapByte loop=%lu cycles\r\n",
+         (unsigned long)dma_cycles, (unsigned long)reg_cycles);
+  return TEST_PASS;
+}
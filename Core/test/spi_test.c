@@ -7,11 +7,12 @@
  * @details 测试SPI驱动的各项功能，包括：
  *          - HAL库方式的SPI通信
  *          - 寄存器方式的SPI通信
- *          - 两种方式的性能对比
+ *          - HAL、寄存器逐字节与寄存器块传输三种方式的性能对比
  */
 
 #include "spi_test.h"
 #include "spi.h"
+#include "bench.h"
 #include "usart.h"
 #include <stdio.h>
 #include <string.h>
@@ -81,9 +82,9 @@ static void print_test_summary(void) {
   printf("==============================================================\r\n");
   printf("测试汇总\r\n");
   printf("==============================================================\r\n");
-  printf("  总测试数: %lu\r\n", g_test_stats.total_tests);
-  printf("  通过: %lu\r\n", g_test_stats.passed_tests);
-  printf("  失败: %lu\r\n", g_test_stats.failed_tests);
+  printf("  总测试数: %lu\r\n", (unsigned long)g_test_stats.total_tests);
+  printf("  通过: %lu\r\n", (unsigned long)g_test_stats.passed_tests);
+  printf("  失败: %lu\r\n", (unsigned long)g_test_stats.failed_tests);
 
   if (g_test_stats.failed_tests == 0) {
     printf("\r\n>>> 所有测试通过! <<<\r\n");
@@ -157,7 +158,6 @@ static int test_hal_data_exchange(void) {
  */
 static int test_hal_burst_transfer(void) {
   uint8_t tx_buffer[TEST_BUFFER_SIZE];
-  uint8_t rx_buffer[TEST_BUFFER_SIZE];
 
   // 填充测试数据
   for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
@@ -167,7 +167,7 @@ static int test_hal_burst_transfer(void) {
   Hal_SPI_Start();
 
   for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
-    rx_buffer[i] = Hal_SPI_SwapByte(tx_buffer[i]);
+    (void)Hal_SPI_SwapByte(tx_buffer[i]); // 没有发送指令，收到的字节无意义
   }
 
   Hal_SPI_Stop();
@@ -259,7 +259,6 @@ static int test_register_data_exchange(void) {
  */
 static int test_register_burst_transfer(void) {
   uint8_t tx_buffer[TEST_BUFFER_SIZE];
-  uint8_t rx_buffer[TEST_BUFFER_SIZE];
 
   // 填充测试数据
   for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
@@ -269,7 +268,7 @@ static int test_register_burst_transfer(void) {
   Register_SPI_Start();
 
   for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
-    rx_buffer[i] = Register_SPI_SwapByte(tx_buffer[i]);
+    (void)Register_SPI_SwapByte(tx_buffer[i]); // 没有发送指令，收到的字节无意义
   }
 
   Register_SPI_Stop();
@@ -279,6 +278,52 @@ static int test_register_burst_transfer(void) {
   return SPI_TEST_PASS;
 }
 
+/**
+ * @brief  测试寄存器方式块传输
+ * @return int 0表示成功
+ * @note   分别用 SwapByte、TransferBlock、WriteBlock+ReadBlock 读取
+ *         W25Q32 的 JEDEC ID，三种方式的结果必须一致
+ */
+static int test_register_block_transfer(void) {
+  uint8_t cmd[4] = {0x9F, 0xFF, 0xFF, 0xFF};
+  uint8_t id_swap[3];
+  uint8_t id_block[4];
+  uint8_t id_split[3];
+  HAL_StatusTypeDef st_block, st_split;
+
+  Register_SPI_Start();
+  Register_SPI_SwapByte(cmd[0]);
+  for (int i = 0; i < 3; i++) {
+    id_swap[i] = Register_SPI_SwapByte(0xFF);
+  }
+  Register_SPI_Stop();
+
+  Register_SPI_Start();
+  st_block = Register_SPI_TransferBlock(cmd, id_block, sizeof(cmd));
+  Register_SPI_Stop();
+
+  Register_SPI_Start();
+  Register_SPI_WriteBlock(cmd, 1);
+  st_split = Register_SPI_ReadBlock(id_split, sizeof(id_split));
+  Register_SPI_Stop();
+
+  if (st_block != HAL_OK || st_split != HAL_OK) {
+    printf("  寄存器 Block传输: 返回状态 %d / %d\r\n", st_block, st_split);
+    return SPI_TEST_COMMUNICATION;
+  }
+
+  printf("  寄存器 Block传输: JEDEC ID %02X %02X %02X / %02X %02X %02X / "
+         "%02X %02X %02X\r\n",
+         id_swap[0], id_swap[1], id_swap[2], id_block[1], id_block[2],
+         id_block[3], id_split[0], id_split[1], id_split[2]);
+
+  if (memcmp(id_swap, &id_block[1], 3) != 0 ||
+      memcmp(id_swap, id_split, 3) != 0) {
+    return SPI_TEST_COMMUNICATION;
+  }
+  return SPI_TEST_PASS;
+}
+
 /**
  * @brief  测试寄存器方式的SPI功能
  * @return int 0表示成功，负值表示失败
@@ -307,6 +352,12 @@ int SPI_Test_Register_Functions(void) {
   if (test_result != SPI_TEST_PASS)
     result = SPI_TEST_FAIL;
 
+  // 子测试4: 块传输（TransferBlock / WriteBlock / ReadBlock）
+  test_result = test_register_block_transfer();
+  print_test_result("寄存器 Block传输", test_result);
+  if (test_result != SPI_TEST_PASS)
+    result = SPI_TEST_FAIL;
+
   return result;
 }
 
@@ -314,71 +365,119 @@ int SPI_Test_Register_Functions(void) {
 //                          性能对比测试
 //======================================================================
 
-/**
- * @brief  获取当前系统tick值（用于计时）
- * @return uint32_t 当前tick值
- */
-static uint32_t get_tick_count(void) { return HAL_GetTick(); }
+static uint8_t s_perf_tx[TEST_LOOP_COUNT];
+static uint8_t s_perf_rx[TEST_LOOP_COUNT];
 
 /**
- * @brief  SPI性能对比测试（HAL vs 寄存器）
- * @note   比较两种方法的速度差异
+ * @brief  被测函数: HAL库方式逐字节
  */
-void SPI_Test_Performance_Compare(void) {
-  uint32_t start_tick, hal_time, reg_time;
-  uint8_t dummy_data = 0xAA;
-
-  print_test_header("性能对比测试 (HAL vs 寄存器)");
-
-  printf("  测试内容: 发送 %d 字节数据\r\n", TEST_LOOP_COUNT);
-  printf("\r\n");
-
-  // ------ HAL库方式性能测试 ------
+static void perf_hal_swap(void *arg) {
+  (void)arg;
   Hal_SPI_Start();
-  start_tick = get_tick_count();
-
   for (int i = 0; i < TEST_LOOP_COUNT; i++) {
-    Hal_SPI_SwapByte(dummy_data);
+    Hal_SPI_SwapByte(s_perf_tx[i]);
   }
-
-  hal_time = get_tick_count() - start_tick;
   Hal_SPI_Stop();
+}
 
-  printf("  HAL库方式:\r\n");
-  printf("    传输 %d 字节耗时: %lu ms\r\n", TEST_LOOP_COUNT, hal_time);
-  if (hal_time > 0) {
-    printf("    近似速率: %.2f KB/s\r\n", (float)TEST_LOOP_COUNT / hal_time);
+/**
+ * @brief  被测函数: 寄存器方式逐字节
+ */
+static void perf_reg_swap(void *arg) {
+  (void)arg;
+  Register_SPI_Start();
+  for (int i = 0; i < TEST_LOOP_COUNT; i++) {
+    Register_SPI_SwapByte(s_perf_tx[i]);
   }
-  printf("\r\n");
+  Register_SPI_Stop();
+}
 
-  // ------ 寄存器方式性能测试 ------
+/**
+ * @brief  被测函数: 寄存器方式全双工块传输
+ */
+static void perf_reg_block(void *arg) {
+  (void)arg;
+  // 被中断打断造成接收溢出时整块重传，计入耗时
   Register_SPI_Start();
-  start_tick = get_tick_count();
-
-  for (int i = 0; i < TEST_LOOP_COUNT; i++) {
-    Register_SPI_SwapByte(dummy_data);
+  while (Register_SPI_TransferBlock(s_perf_tx, s_perf_rx, TEST_LOOP_COUNT) != HAL_OK) {
+    Register_SPI_Stop();
+    Register_SPI_Start();
   }
+  Register_SPI_Stop();
+}
+
+/**
+ * @brief  被测函数: 寄存器方式只发送
+ */
+static void perf_reg_write(void *arg) {
+  (void)arg;
+  Register_SPI_Start();
+  Register_SPI_WriteBlock(s_perf_tx, TEST_LOOP_COUNT);
+  Register_SPI_Stop();
+}
 
-  reg_time = get_tick_count() - start_tick;
+/**
+ * @brief  被测函数: 寄存器方式只接收
+ */
+static void perf_reg_read(void *arg) {
+  (void)arg;
+  // 被中断打断造成接收溢出时整块重传，计入耗时
+  Register_SPI_Start();
+  while (Register_SPI_ReadBlock(s_perf_rx, TEST_LOOP_COUNT) != HAL_OK) {
+    Register_SPI_Stop();
+    Register_SPI_Start();
+  }
   Register_SPI_Stop();
+}
+
+/**
+ * @brief  SPI性能对比测试（HAL vs 寄存器逐字节 vs 寄存器块传输）
+ * @note   通过 bench 框架重复测量，以 BENCH CSV 行报告中位数和 字节/秒；
+ *         SCK 频率相同，差别全部来自字节之间的空闲时间
+ */
+void SPI_Test_Performance_Compare(void) {
+  static const struct {
+    const char *name;
+    bench_fn_t fn;
+  } methods[] = {
+      {"spi_hal_swapbyte", perf_hal_swap},
+      {"spi_reg_swapbyte", perf_reg_swap},
+      {"spi_reg_transferblock", perf_reg_block},
+      {"spi_reg_writeblock", perf_reg_write},
+      {"spi_reg_readblock", perf_reg_read},
+  };
+  bench_result_t res[sizeof(methods) / sizeof(methods[0])];
+  bench_config_t cfg = {NULL, 1, 5, TEST_LOOP_COUNT, 0};
+
+  print_test_header("性能对比测试 (HAL vs 寄存器 vs 块传输)");
+
+  printf("  测试内容: 传输 %d 字节数据，每种方式重复 %lu 次\r\n",
+         TEST_LOOP_COUNT, (unsigned long)cfg.reps);
+  printf("\r\n");
+
+  memset(s_perf_tx, 0xAA, sizeof(s_perf_tx));
+  bench_init();
+  bench_report_header();
 
-  printf("  寄存器方式:\r\n");
-  printf("    传输 %d 字节耗时: %lu ms\r\n", TEST_LOOP_COUNT, reg_time);
-  if (reg_time > 0) {
-    printf("    近似速率: %.2f KB/s\r\n", (float)TEST_LOOP_COUNT / reg_time);
+  for (unsigned i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+    cfg.name = methods[i].name;
+    bench_run(&cfg, methods[i].fn, NULL, &res[i]);
+    bench_report(&res[i]);
   }
   printf("\r\n");
 
-  // ------ 性能比较结论 ------
+  // ------ 性能比较结论（按中位数）------
   printf("  性能比较结论:\r\n");
-  if (hal_time == reg_time) {
-    printf("    两种方式耗时相同\r\n");
-  } else if (hal_time > reg_time && reg_time > 0) {
-    printf("    寄存器方式更快 (快 %.1f%%)\r\n",
-           ((float)hal_time - reg_time) / reg_time * 100);
-  } else if (reg_time > hal_time && hal_time > 0) {
-    printf("    HAL库方式更快 (快 %.1f%%)\r\n",
-           ((float)reg_time - hal_time) / hal_time * 100);
+  if (res[1].median > 0 && res[2].median > 0) {
+    printf("    寄存器逐字节比HAL快 %lu%%，块传输比逐字节快 %lu%%\r\n",
+           (unsigned long)(res[0].median > res[1].median
+                               ? (uint64_t)(res[0].median - res[1].median) *
+                                     100 / res[1].median
+                               : 0),
+           (unsigned long)(res[1].median > res[2].median
+                               ? (uint64_t)(res[1].median - res[2].median) *
+                                     100 / res[2].median
+                               : 0));
   } else {
     printf("    测试时间太短，无法比较\r\n");
   }
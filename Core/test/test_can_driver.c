@@ -14,6 +14,9 @@
 
 #include "test_can_driver.h"
 #include "can_driver.h"
+#include "can_sched.h"
+#include "stm32f1xx_hal.h"
+#include "bench.h"
 #include <string.h>
 
 /* 私有变量 ---------------------------------------------------------------*/
@@ -74,6 +77,13 @@ static void test_can_loopback_remote_frame(void);
 static void test_can_get_error(void);
 static void test_can_get_pending_messages(void);
 static void test_can_transmit_no_mailbox(void);
+static void test_can_timestamp_extend(void);
+static void test_can_loopback_timestamps(void);
+static void test_can_sched_periodic(void);
+static void test_can_sched_fairness(void);
+static void test_can_burst_roundtrip(void);
+static void test_can_burst_benchmark(void);
+static void test_can_rx_event(void);
 
 /* 公开函数实现 ------------------------------------------------------------*/
 
@@ -92,6 +102,8 @@ int can_driver_run_tests(void) {
   printf("      CAN Driver Test Suite Start      \r\n");
   printf("========================================\r\n");
 
+  bench_init();
+
   /* 执行各组测试 */
 
   /* 测试组 1：初始化测试 */
@@ -134,14 +146,33 @@ int can_driver_run_tests(void) {
   test_can_transmit_no_mailbox();
   TEST_GROUP_END();
 
+  /* 测试组 6：时间戳与周期调度测试 */
+  TEST_GROUP_BEGIN("CAN Timestamp / Scheduler Tests");
+  test_can_timestamp_extend();
+  test_can_loopback_timestamps();
+  test_can_sched_periodic();
+  test_can_sched_fairness();
+  TEST_GROUP_END();
+
+  /* 测试组 7：批量收发测试 */
+  TEST_GROUP_BEGIN("CAN Burst Transmit/Receive Tests");
+  test_can_burst_roundtrip();
+  test_can_burst_benchmark();
+  TEST_GROUP_END();
+
+  /* 测试组 8：接收中断投递事件测试 */
+  TEST_GROUP_BEGIN("CAN RX Interrupt Event Tests");
+  test_can_rx_event();
+  TEST_GROUP_END();
+
   /* 打印测试结果统计 */
   printf("========================================\r\n");
   printf("          Test Results Summary          \r\n");
   printf("========================================\r\n");
-  printf("  Passed:  %lu\r\n", test_passed);
-  printf("  Failed:  %lu\r\n", test_failed);
-  printf("  Skipped: %lu\r\n", test_skipped);
-  printf("  Total:   %lu\r\n", test_passed + test_failed + test_skipped);
+  printf("  Passed:  %lu\r\n", (unsigned long)test_passed);
+  printf("  Failed:  %lu\r\n", (unsigned long)test_failed);
+  printf("  Skipped: %lu\r\n", (unsigned long)test_skipped);
+  printf("  Total:   %lu\r\n", (unsigned long)(test_passed + test_failed + test_skipped));
   printf("========================================\r\n");
 
   if (test_failed > 0) {
@@ -190,7 +221,7 @@ int can_driver_self_test(void) {
     return -1;
   }
   printf("[Self-Test] Transmit OK (mailbox=%d, id=0x%03lX)\r\n", mailbox,
-         test_id);
+         (unsigned long)test_id);
 
   /* 步骤 4：等待发送完成 */
   ret = CAN_TransmitWait(mailbox, CAN_TIMEOUT_VALUE);
@@ -210,13 +241,13 @@ int can_driver_self_test(void) {
     printf("[Self-Test] FAIL: CAN_Receive returned %d\r\n", ret);
     return -1;
   }
-  printf("[Self-Test] Receive OK (id=0x%03lX, len=%d)\r\n", rx_id, rx_len);
+  printf("[Self-Test] Receive OK (id=0x%03lX, len=%d)\r\n", (unsigned long)rx_id, rx_len);
 
   /* 步骤 6：验证数据 */
   if (rx_id != test_id) {
     printf("[Self-Test] FAIL: ID mismatch (expected=0x%03lX, "
            "actual=0x%03lX)\r\n",
-           test_id, rx_id);
+           (unsigned long)test_id, (unsigned long)rx_id);
     return -1;
   }
 
@@ -509,3 +540,325 @@ static void test_can_transmit_no_mailbox(void) {
   while (CAN_Receive(0, &id, &ide, &rtr, rx_data, &len) == CAN_RX_OK)
     ;
 }
+
+/**
+ * @brief   测试 16 位时间戳的回绕扩展
+ * @note    刚初始化完，HAL_GetTick 推算值几乎不变，结果只取决于回绕判断
+ */
+static void test_can_timestamp_extend(void) {
+  CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_TTCM);
+
+  uint64_t t1 = CAN_TimestampExtend(0xFFF0);
+  uint64_t t2 = CAN_TimestampExtend(0x0010);
+  uint64_t t3 = CAN_TimestampExtend(0x0008);
+
+  TEST_ASSERT(t2 > t1, "Timestamp: monotonic across 16-bit wrap");
+  TEST_ASSERT_EQUAL(0x20, (uint32_t)(t2 - t1), "Timestamp: wrap delta");
+  TEST_ASSERT_EQUAL(8, (uint32_t)(t2 - t3),
+                    "Timestamp: late stamp resolves backwards");
+  TEST_ASSERT_EQUAL(64, (uint32_t)(CAN_TimestampToUs(t2) - CAN_TimestampToUs(t1)),
+                    "Timestamp: 32 bits = 64us at 500kbps");
+}
+
+/**
+ * @brief   测试 TTCM 环回模式下的收发时间戳
+ */
+static void test_can_loopback_timestamps(void) {
+  uint8_t tx_data[8] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80};
+  uint64_t tx_ts[2] = {0}, rx_ts[2] = {0};
+  uint32_t now;
+  uint32_t id;
+  uint8_t ide, rtr, len;
+  uint8_t rx_data[8];
+  int ok = 1;
+
+  if (CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_TTCM) != CAN_INIT_OK) {
+    TEST_SKIP("TTCM timestamp tests skipped - CAN init failed");
+    return;
+  }
+  CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+
+  for (int i = 0; i < 2 && ok; i++) {
+    int mailbox = CAN_Transmit(0x200 + i, 0, 0, tx_data, 8);
+    ok = mailbox >= 0 &&
+         CAN_TransmitWaitTimestamped(mailbox, CAN_TIMEOUT_VALUE, &tx_ts[i]) ==
+             CAN_TX_WAIT_OK &&
+         CAN_ReceiveTimestamped(0, &id, &ide, &rtr, rx_data, &len,
+                                &rx_ts[i]) == CAN_RX_OK;
+  }
+  /* 在打印结果之前取时刻：每行日志经 USART1 发送需要几毫秒 */
+  now = HAL_GetTick();
+  TEST_ASSERT(ok, "TTCM: two frames transmitted and received");
+
+  if (ok) {
+    /* 环回时收发捕获的是同一帧的 SOF，允许几个位时间的同步误差 */
+    int64_t skew = (int64_t)(rx_ts[0] - tx_ts[0]);
+    TEST_ASSERT(skew >= -4 && skew <= 4, "TTCM: RX stamp matches TX stamp");
+
+    /* 8 字节标准帧至少 108 位，第二帧必须晚于第一帧结束 */
+    TEST_ASSERT(rx_ts[1] >= rx_ts[0] + 108, "TTCM: frames ordered by SOF");
+
+    uint32_t tick = CAN_TimestampToTick(rx_ts[1]);
+    TEST_ASSERT(now - tick <= 2, "TTCM: timestamp correlates with HAL_GetTick");
+  }
+
+  while (CAN_Receive(0, &id, &ide, &rtr, rx_data, &len) == CAN_RX_OK)
+    ;
+}
+
+/**
+ * @brief   测试周期报文调度的相位保持与跳周期统计
+ * @note    使用人为给定的时刻调用 CAN_Sched_Poll，与实际时钟无关
+ */
+static void test_can_sched_periodic(void) {
+  uint8_t data[2] = {0xAB, 0xCD};
+  CAN_SchedStats_t stats;
+  uint32_t id;
+  uint8_t ide, rtr, len;
+  uint8_t rx_data[8];
+  uint32_t base = 1000;
+
+  CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_TXFP);
+  CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+  CAN_Sched_Reset();
+
+  int h = CAN_Sched_Add(0x300, 0, data, 2, 10, base);
+  TEST_ASSERT(h >= 0, "Sched: add periodic message");
+  TEST_ASSERT_EQUAL(CAN_SCHED_PARAM_ERROR, CAN_Sched_Add(0x301, 0, data, 2, 0, base),
+                    "Sched: zero period rejected");
+
+  TEST_ASSERT_EQUAL(1, CAN_Sched_Poll(base), "Sched: first send at offset");
+  TEST_ASSERT_EQUAL(0, CAN_Sched_Poll(base + 5), "Sched: not due at +5ms");
+  TEST_ASSERT_EQUAL(1, CAN_Sched_Poll(base + 10), "Sched: due at +10ms");
+  while (CAN_Receive(0, &id, &ide, &rtr, rx_data, &len) == CAN_RX_OK)
+    ;
+  TEST_ASSERT_EQUAL(1, CAN_Sched_Poll(base + 25), "Sched: late poll sends once");
+  /* 截止时间应为 +30 而不是 +35，间隔不随轮询漂移 */
+  TEST_ASSERT_EQUAL(1, CAN_Sched_Poll(base + 30), "Sched: phase preserved");
+  while (CAN_Receive(0, &id, &ide, &rtr, rx_data, &len) == CAN_RX_OK)
+    ;
+  TEST_ASSERT_EQUAL(1, CAN_Sched_Poll(base + 72), "Sched: stalled poll sends once");
+
+  CAN_Sched_GetStats(h, &stats);
+  TEST_ASSERT_EQUAL(5, stats.sent, "Sched: sent count");
+  TEST_ASSERT_EQUAL(3, stats.skipped, "Sched: skipped periods 50/60/70");
+
+  CAN_Sched_Remove(h);
+  TEST_ASSERT_EQUAL(0, CAN_Sched_Poll(base + 100), "Sched: removed entry idle");
+
+  while (CAN_Receive(0, &id, &ide, &rtr, rx_data, &len) == CAN_RX_OK)
+    ;
+}
+
+/**
+ * @brief   测试总线繁忙时各表项轮流获得邮箱
+ * @note    4 个 1ms 周期的报文每轮都到期，3 个邮箱每轮只能发 3 帧
+ */
+static void test_can_sched_fairness(void) {
+  uint8_t data[1] = {0x55};
+  CAN_SchedStats_t stats;
+  uint32_t id;
+  uint8_t ide, rtr, len;
+  uint8_t rx_data[8];
+  uint32_t base = 2000;
+  int h[4];
+  int k;
+
+  CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_TXFP);
+  CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+  CAN_Sched_Reset();
+
+  for (k = 0; k < 4; k++) {
+    h[k] = CAN_Sched_Add(0x310 + k, 0, data, 1, 1, base);
+  }
+  for (k = 0; k < 4; k++) {
+    uint8_t sent = CAN_Sched_Poll(base + k);
+    TEST_ASSERT_EQUAL(3, sent, "Sched: three mailboxes per poll");
+    /* 等邮箱发空，取走回环收到的帧 */
+    HAL_Delay(2);
+    while (CAN_Receive(0, &id, &ide, &rtr, rx_data, &len) == CAN_RX_OK)
+      ;
+  }
+
+  /* 4 轮共 12 帧，每个表项恰好 3 帧，没有表项被饿死 */
+  for (k = 0; k < 4; k++) {
+    CAN_Sched_GetStats(h[k], &stats);
+    TEST_ASSERT_EQUAL(3, stats.sent, "Sched: entries served in turn");
+  }
+
+  CAN_Sched_Reset();
+}
+
+/**
+ * @brief   测试批量发送/接收的往返一致性
+ */
+static void test_can_burst_roundtrip(void) {
+  CAN_Frame_t tx[3];
+  CAN_Frame_t rx[6];
+  uint8_t n;
+
+  CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_TXFP);
+  CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+  while (CAN_ReceiveBurst(rx, 6) > 0)
+    ;
+
+  memset(tx, 0, sizeof(tx));
+  tx[0].id = 0x101;
+  tx[0].dlc = 8;
+  tx[0].data.w[0] = 0x44332211;
+  tx[0].data.w[1] = 0x88776655;
+  tx[1].id = 0x1ABCDEF0;
+  tx[1].flags = CAN_FRAME_FLAG_IDE;
+  tx[1].dlc = 3;
+  tx[1].data.b[0] = 0xA1;
+  tx[1].data.b[1] = 0xA2;
+  tx[1].data.b[2] = 0xA3;
+  tx[2].id = 0x7FF;
+  tx[2].flags = CAN_FRAME_FLAG_RTR;
+
+  n = CAN_TransmitBurst(tx, 3);
+  TEST_ASSERT_EQUAL(3, n, "Burst: 3 frames queued in one call");
+
+  for (int i = 0; i < 3; i++) {
+    CAN_TransmitWait(i, CAN_TIMEOUT_VALUE);
+  }
+
+  n = CAN_ReceiveBurst(rx, 6);
+  TEST_ASSERT_EQUAL(3, n, "Burst: 3 frames drained in one call");
+  if (n == 3) {
+    TEST_ASSERT(rx[0].id == 0x101 && rx[0].dlc == 8 &&
+                    rx[0].data.b[0] == 0x11 && rx[0].data.b[7] == 0x88,
+                "Burst: std frame word copy");
+    TEST_ASSERT(rx[1].id == 0x1ABCDEF0 && (rx[1].flags & CAN_FRAME_FLAG_IDE) &&
+                    rx[1].dlc == 3 && rx[1].data.b[2] == 0xA3,
+                "Burst: ext frame");
+    TEST_ASSERT(rx[2].id == 0x7FF && (rx[2].flags & CAN_FRAME_FLAG_RTR),
+                "Burst: remote frame");
+  }
+  TEST_ASSERT_EQUAL(0, CAN_ReceiveBurst(rx, 6), "Burst: FIFOs empty");
+}
+
+/**
+ * @brief   对比逐帧 API 与批量 API 的每帧周期数
+ * @note    FIFO0 满（3 帧）和 3 个空邮箱两种场景各测一次，结果仅打印
+ */
+static void test_can_burst_benchmark(void) {
+  CAN_Frame_t frames[6];
+  uint8_t tx_data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  uint32_t id;
+  uint8_t ide, rtr, len;
+  uint8_t rx_data[8];
+  uint32_t t0, old_tx, old_rx, new_tx, new_rx;
+
+  CAN_InitEx(500000, BX_CAN_MODE_LOOPBACK, CAN_OPT_NONE);
+  CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+  while (CAN_ReceiveBurst(frames, 6) > 0)
+    ;
+
+  /* 逐帧发送 3 帧 */
+  t0 = bench_now();
+  for (int i = 0; i < 3; i++) {
+    CAN_Transmit(0x100 + i, 0, 0, tx_data, 8);
+  }
+  old_tx = bench_now() - t0;
+  for (int i = 0; i < 3; i++) {
+    CAN_TransmitWait(i, CAN_TIMEOUT_VALUE);
+  }
+
+  /* 逐帧接收 3 帧 */
+  t0 = bench_now();
+  for (int i = 0; i < 3; i++) {
+    CAN_Receive(0, &id, &ide, &rtr, rx_data, &len);
+  }
+  old_rx = bench_now() - t0;
+
+  /* 批量发送 3 帧 */
+  for (int i = 0; i < 3; i++) {
+    frames[i].id = 0x100 + i;
+    frames[i].dlc = 8;
+    frames[i].flags = 0;
+    memcpy(frames[i].data.b, tx_data, 8);
+  }
+  t0 = bench_now();
+  uint8_t queued = CAN_TransmitBurst(frames, 3);
+  new_tx = bench_now() - t0;
+  for (int i = 0; i < 3; i++) {
+    CAN_TransmitWait(i, CAN_TIMEOUT_VALUE);
+  }
+
+  /* 批量接收 3 帧 */
+  t0 = bench_now();
+  uint8_t drained = CAN_ReceiveBurst(frames, 6);
+  new_rx = bench_now() - t0;
+
+  TEST_ASSERT(queued == 3 && drained == 3, "Burst bench: 3 frames each way");
+  printf("[INFO] TX cycles/frame: single=%lu burst=%lu\r\n",
+         (unsigned long)(old_tx / 3), (unsigned long)(new_tx / 3));
+  printf("[INFO] RX cycles/frame: single=%lu burst=%lu\r\n",
+         (unsigned long)(old_rx / 3), (unsigned long)(new_rx / 3));
+}
+
+/** 接收事件测试：任务、队列和读出的帧数 */
+static ev_task_t s_rx_task;
+static ev_event_t s_rx_queue[4];
+static uint32_t s_rx_events;
+static uint32_t s_rx_frames;
+
+/**
+ * @brief   接收事件处理：读空 FIFO 后重新打开中断
+ */
+static void test_can_rx_handler(ev_task_t *task, const ev_event_t *ev) {
+  CAN_Frame_t frames[6];
+
+  (void)task;
+  s_rx_events++;
+  s_rx_frames += CAN_ReceiveBurst(frames, 6);
+  CAN_RxEventRearm((uint8_t)ev->param);
+}
+
+/**
+ * @brief   FIFO 报文挂起中断向任务投递事件，读空并重新打开后才会再次投递
+ */
+static void test_can_rx_event(void) {
+  CAN_Frame_t frames[6];
+  uint8_t tx_data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  CAN_Init(500000, BX_CAN_MODE_LOOPBACK);
+  CAN_FilterConfig(0, CAN_FILTER_MODE_MASK, CAN_FILTER_SCALE_32BIT, 0, 0, 0);
+  while (CAN_ReceiveBurst(frames, 6) > 0)
+    ;
+
+  ev_init();
+  ev_task_init(&s_rx_task, "can_rx", 1, test_can_rx_handler, NULL, s_rx_queue,
+               4);
+  s_rx_events = 0;
+  s_rx_frames = 0;
+  CAN_SetRxEvent(&s_rx_task, EV_SIG_USER);
+
+  /* 两帧到达只投递一次事件：第一帧的中断已关掉 FMPIE0 */
+  CAN_Transmit(0x120, 0, 0, tx_data, 8);
+  CAN_TransmitWait(0, CAN_TIMEOUT_VALUE);
+  CAN_Transmit(0x121, 0, 0, tx_data, 8);
+  CAN_TransmitWait(0, CAN_TIMEOUT_VALUE);
+  TEST_ASSERT_EQUAL(1, s_rx_task.count, "RX event: one event for two frames");
+  ev_run_until_idle();
+  TEST_ASSERT(s_rx_events == 1 && s_rx_frames == 2,
+              "RX event: handler drained both frames");
+
+  /* 重新打开后下一帧再次投递 */
+  CAN_Transmit(0x122, 0, 0, tx_data, 8);
+  CAN_TransmitWait(0, CAN_TIMEOUT_VALUE);
+  ev_run_until_idle();
+  TEST_ASSERT(s_rx_events == 2 && s_rx_frames == 3,
+              "RX event: rearmed interrupt posts again");
+
+  /* 关闭后回到轮询 */
+  CAN_SetRxEvent(NULL, 0);
+  CAN_Transmit(0x123, 0, 0, tx_data, 8);
+  CAN_TransmitWait(0, CAN_TIMEOUT_VALUE);
+  TEST_ASSERT(!ev_pending() && CAN_GetPendingMessages(0) == 1,
+              "RX event: disabled, frame left for polling");
+  while (CAN_ReceiveBurst(frames, 6) > 0)
+    ;
+  ev_task_remove(&s_rx_task);
+}
@@ -383,10 +383,10 @@ int w24c02_run_tests(void) {
   printf("========================================\r\n");
   printf("          Test Results Summary          \r\n");
   printf("========================================\r\n");
-  printf("  Passed:  %lu\r\n", test_passed);
-  printf("  Failed:  %lu\r\n", test_failed);
-  printf("  Skipped: %lu\r\n", test_skipped);
-  printf("  Total:   %lu\r\n", test_passed + test_failed + test_skipped);
+  printf("  Passed:  %lu\r\n", (unsigned long)test_passed);
+  printf("  Failed:  %lu\r\n", (unsigned long)test_failed);
+  printf("  Skipped: %lu\r\n", (unsigned long)test_skipped);
+  printf("  Total:   %lu\r\n", (unsigned long)(test_passed + test_failed + test_skipped));
   printf("========================================\r\n");
 
   if (test_failed > 0) {
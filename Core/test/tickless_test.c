@@ -0,0 +1,289 @@
+/**
+ * @file    tickless_test.c
+ * @brief   低功耗空闲测试文件
+ * @note    1. 一次长睡眠：定时器按时到期，HAL 节拍与时间轮节拍一致
+ *          2. DMA 完成中断反复提前唤醒时到期时间和节拍补偿仍然准确
+ *          3. 周期任务下的睡眠占比和每秒唤醒次数（与普通 WFI 对比）
+ */
+
+#include "tickless_test.h"
+#include "tickless.h"
+#include "timer_wheel.h"
+#include "dma_mem.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_TICK_HZ 1000U
+#define TEST_LONG_TICKS 500U
+#define TEST_EARLY_TICKS 50U
+#define TEST_EARLY_BUSY_MS 20U
+#define TEST_WINDOW_MS 2000U
+#define TEST_COPY_SIZE 1024U
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/**
+ * @brief  到期记录
+ */
+typedef struct {
+  uint32_t count;    /* 到期次数 */
+  uint32_t hal_ms;   /* 最后一次到期时的 HAL_GetTick() */
+  uint32_t tw_ticks; /* 最后一次到期时的 tw_now() */
+} test_rec_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static tw_timer_t s_timer_a;
+static tw_timer_t s_timer_b;
+static test_rec_t s_rec_a;
+static test_rec_t s_rec_b;
+static uint8_t s_copy_src[TEST_COPY_SIZE];
+static uint8_t s_copy_dst[TEST_COPY_SIZE];
+static volatile uint32_t s_copies = 0;
+static volatile uint8_t s_copy_busy = 0;
+static uint32_t s_busy_until = 0;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void test_cb(tw_timer_t *timer, void *ctx);
+static void test_copy_done(int status, void *ctx);
+static void test_idle_until(volatile test_rec_t *rec, uint32_t count,
+                            uint32_t timeout_ms);
+static int test_run_window(tickless_stats_t *stats);
+static int test_long_sleep(void);
+static int test_early_wakeups(void);
+static int test_residency(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有低功耗空闲测试
+ */
+void Tickless_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("        Tickless Idle Test Suite        \r\n");
+  printf("========================================\r\n");
+
+  if (tw_init(TEST_TICK_HZ) != TW_OK) {
+    printf("  [FAIL] tw_init(%u)\r\n", TEST_TICK_HZ);
+    printf("\r\nTest Result: FAILED\r\n");
+    return;
+  }
+  tw_timer_init(&s_timer_a, test_cb, &s_rec_a);
+  tw_timer_init(&s_timer_b, test_cb, &s_rec_b);
+
+  int result1 = test_long_sleep();
+  int result2 = test_early_wakeups();
+  int result3 = test_residency();
+
+  tw_stop(&s_timer_a);
+  tw_stop(&s_timer_b);
+  tw_deinit();
+  tickless_enable(1);
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  到期回调（TIM6 中断上下文）
+ */
+static void test_cb(tw_timer_t *timer, void *ctx) {
+  test_rec_t *rec = ctx;
+  (void)timer;
+
+  rec->count++;
+  rec->hal_ms = HAL_GetTick();
+  rec->tw_ticks = tw_now();
+}
+
+/**
+ * @brief  在到期记录 rec 的次数达到 count 之前一直空闲
+ */
+static void test_idle_until(volatile test_rec_t *rec, uint32_t count,
+                            uint32_t timeout_ms) {
+  uint32_t start = HAL_GetTick();
+  while (rec->count < count && HAL_GetTick() - start < timeout_ms) {
+    tickless_idle();
+  }
+}
+
+/**
+ * @brief  一次长睡眠
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_long_sleep(void) {
+  tickless_stats_t st;
+  uint32_t hal0, tw0;
+
+  printf("[TEST] Single long sleep (%u ticks)\r\n", TEST_LONG_TICKS);
+
+  s_rec_a.count = 0;
+  tickless_reset_stats();
+  hal0 = HAL_GetTick();
+  tw0 = tw_now();
+  tw_start(&s_timer_a, TEST_LONG_TICKS, 0);
+  test_idle_until(&s_rec_a, 1, 2 * TEST_LONG_TICKS);
+  tickless_get_stats(&st);
+
+  if (s_rec_a.count != 1 || s_rec_a.tw_ticks - tw0 != TEST_LONG_TICKS ||
+      s_rec_a.hal_ms - hal0 + 1U < TEST_LONG_TICKS ||
+      s_rec_a.hal_ms - hal0 > TEST_LONG_TICKS + 1U) {
+    printf("  [FAIL] fired %lu times, after %lu ticks / %lu ms\r\n",
+           (unsigned long)s_rec_a.count, (unsigned long)(s_rec_a.tw_ticks - tw0),
+           (unsigned long)(s_rec_a.hal_ms - hal0));
+    return TEST_FAIL;
+  }
+  if (st.long_sleeps == 0 || st.wakeups > 5) {
+    printf("  [FAIL] %lu wakeups, %lu long sleeps\r\n", (unsigned long)st.wakeups,
+           (unsigned long)st.long_sleeps);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu ms, %lu wakeups, slept %lu ms\r\n",
+         (unsigned long)(s_rec_a.hal_ms - hal0), (unsigned long)st.wakeups,
+         (unsigned long)st.sleep_ms);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  DMA 复制完成回调：忙碌期间继续提交下一次复制
+ */
+static void test_copy_done(int status, void *ctx) {
+  (void)status;
+  (void)ctx;
+  s_copies++;
+  if (HAL_GetTick() - s_busy_until < 0x80000000UL) {
+    s_copy_busy = 0;
+    return;
+  }
+  dma_memcpy_async(s_copy_dst, s_copy_src, TEST_COPY_SIZE, test_copy_done, NULL);
+}
+
+/**
+ * @brief  前 TEST_EARLY_BUSY_MS 毫秒里 DMA 中断不断打断长睡眠
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_early_wakeups(void) {
+  tickless_stats_t st;
+  uint32_t hal0, tw0;
+
+  printf("[TEST] Early wakeups from DMA interrupts\r\n");
+
+  if (dma_mem_init() != DMA_MEM_OK) {
+    printf("  [FAIL] dma_mem_init\r\n");
+    return TEST_FAIL;
+  }
+
+  s_rec_a.count = 0;
+  s_copies = 0;
+  tickless_reset_stats();
+  hal0 = HAL_GetTick();
+  tw0 = tw_now();
+  tw_start(&s_timer_a, TEST_EARLY_TICKS, 0);
+  s_busy_until = hal0 + TEST_EARLY_BUSY_MS;
+  s_copy_busy = 1;
+  dma_memcpy_async(s_copy_dst, s_copy_src, TEST_COPY_SIZE, test_copy_done, NULL);
+  test_idle_until(&s_rec_a, 1, 4 * TEST_EARLY_TICKS);
+  while (s_copy_busy) {
+    tickless_idle();
+  }
+  tickless_get_stats(&st);
+  dma_mem_deinit();
+
+  if (s_rec_a.count != 1 || s_rec_a.tw_ticks - tw0 != TEST_EARLY_TICKS ||
+      s_rec_a.hal_ms - hal0 + 1U < TEST_EARLY_TICKS ||
+      s_rec_a.hal_ms - hal0 > TEST_EARLY_TICKS + 1U) {
+    printf("  [FAIL] fired %lu times, after %lu ticks / %lu ms\r\n",
+           (unsigned long)s_rec_a.count, (unsigned long)(s_rec_a.tw_ticks - tw0),
+           (unsigned long)(s_rec_a.hal_ms - hal0));
+    return TEST_FAIL;
+  }
+  if (s_copies < TEST_EARLY_BUSY_MS || st.long_sleeps < TEST_EARLY_BUSY_MS) {
+    printf("  [FAIL] only %lu copies / %lu long sleeps\r\n",
+           (unsigned long)s_copies, (unsigned long)st.long_sleeps);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu early wakeups, timer on time (%lu ms)\r\n",
+         (unsigned long)st.wakeups, (unsigned long)(s_rec_a.hal_ms - hal0));
+  return TEST_PASS;
+}
+
+/**
+ * @brief  100 ms 和 250 ms 两个周期任务下空闲 TEST_WINDOW_MS
+ * @param  stats: 输出统计
+ * @retval TEST_PASS / TEST_FAIL（到期次数不对）
+ */
+static int test_run_window(tickless_stats_t *stats) {
+  uint32_t start;
+
+  s_rec_a.count = 0;
+  s_rec_b.count = 0;
+  tickless_reset_stats();
+  start = HAL_GetTick();
+  tw_start(&s_timer_a, 100, 100);
+  tw_start(&s_timer_b, 250, 250);
+  while (HAL_GetTick() - start < TEST_WINDOW_MS) {
+    tickless_idle();
+  }
+  tickless_get_stats(stats);
+  tw_stop(&s_timer_a);
+  tw_stop(&s_timer_b);
+
+  if (s_rec_a.count + 1U < TEST_WINDOW_MS / 100U ||
+      s_rec_a.count > TEST_WINDOW_MS / 100U ||
+      s_rec_b.count + 1U < TEST_WINDOW_MS / 250U ||
+      s_rec_b.count > TEST_WINDOW_MS / 250U) {
+    printf("  [FAIL] periodic counts %lu / %lu\r\n", (unsigned long)s_rec_a.count,
+           (unsigned long)s_rec_b.count);
+    return TEST_FAIL;
+  }
+  return TEST_PASS;
+}
+
+/**
+ * @brief  睡眠占比和每秒唤醒次数
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_residency(void) {
+  tickless_stats_t on, off;
+
+  printf("[TEST] Idle residency, 100 ms + 250 ms periodic jobs\r\n");
+
+  tickless_enable(0);
+  if (test_run_window(&off) != TEST_PASS) {
+    return TEST_FAIL;
+  }
+  tickless_enable(1);
+  if (test_run_window(&on) != TEST_PASS) {
+    return TEST_FAIL;
+  }
+
+  printf("  mode      window  sleep  resid  wakeups/s\r\n");
+  printf("  ticking  %5lu  %5lu  %3lu.%lu%%  %6lu\r\n", (unsigned long)off.window_ms,
+         (unsigned long)off.sleep_ms, (unsigned long)(off.residency_permille / 10),
+         (unsigned long)(off.residency_permille % 10),
+         (unsigned long)off.wakeups_per_s);
+  printf("  tickless %5lu  %5lu  %3lu.%lu%%  %6lu\r\n", (unsigned long)on.window_ms,
+         (unsigned long)on.sleep_ms, (unsigned long)(on.residency_permille / 10),
+         (unsigned long)(on.residency_permille % 10),
+         (unsigned long)on.wakeups_per_s);
+
+  /* 周期任务每秒 14 次到期；普通 WFI 每个 SysTick / TIM6 节拍都醒 */
+  if (on.wakeups_per_s > 30 || on.residency_permille < 900 ||
+      off.wakeups_per_s < 900) {
+    printf("  [FAIL] tickless not effective\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu -> %lu wakeups/s\r\n", (unsigned long)off.wakeups_per_s,
+         (unsigned long)on.wakeups_per_s);
+  return TEST_PASS;
+}
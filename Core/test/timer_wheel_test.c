@@ -0,0 +1,428 @@
+/**
+ * @file    timer_wheel_test.c
+ * @brief   分层时间轮软件定时器测试文件
+ * @note    1. 各层边界（63/64/4095/4096/262144 节拍附近）的到期时刻
+ *          2. 停止、重新启动与 tw_remaining
+ *          3. 周期定时器不漂移，回调中停止自己
+ *          4. 回调中停止同一槽内的其他定时器
+ *          5. 随机延时的大量定时器逐个按时到期
+ *          6. TIM6 实际节拍频率（与 HAL_GetTick 对比）
+ *          7. 启动+停止 / 到期开销与定时器数量的关系
+ */
+
+#include "timer_wheel_test.h"
+#include "timer_wheel.h"
+#include "bench.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+#define TEST_PASS 1
+#define TEST_FAIL 0
+#define TEST_MAX_TIMERS 256
+#define TEST_RANDOM_SPAN 20000U
+#define TEST_BENCH_SPAN 4096U
+#define TEST_TIM6_TICKS 20U
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/**
+ * @brief  每个测试定时器的记录
+ */
+typedef struct {
+  uint32_t expect;   /* 期望的到期节拍 */
+  uint32_t fired_at; /* 最后一次到期的节拍 */
+  uint32_t count;    /* 到期次数 */
+  uint32_t limit;    /* 周期定时器到期这么多次后在回调中停止，0 表示不停止 */
+  tw_timer_t *victim; /* 回调中要停止的定时器 */
+} test_rec_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+static tw_timer_t s_timers[TEST_MAX_TIMERS];
+static test_rec_t s_recs[TEST_MAX_TIMERS];
+static tw_timer_t s_probe;
+static uint32_t s_rand_state = 0x2468ACE1;
+static volatile uint32_t s_tim6_fired = 0;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static uint32_t test_rand(void);
+static void test_cb(tw_timer_t *timer, void *ctx);
+static void test_reset(uint32_t n);
+static void test_run_ticks(uint32_t n);
+static int test_boundaries(void);
+static int test_stop_restart(void);
+static int test_periodic(void);
+static int test_stop_in_callback(void);
+static int test_random(void);
+static int test_tim6(void);
+static int test_benchmark(void);
+
+/* 公开函数实现 --------------------------------------------------------------*/
+
+/**
+ * @brief  运行所有时间轮测试
+ */
+void Timer_Wheel_RunAllTests(void) {
+  printf("\r\n");
+  printf("========================================\r\n");
+  printf("       Timer Wheel Test Suite           \r\n");
+  printf("========================================\r\n");
+
+  bench_init();
+
+  int result1 = test_boundaries();
+  int result2 = test_stop_restart();
+  int result3 = test_periodic();
+  int result4 = test_stop_in_callback();
+  int result5 = test_random();
+  int result6 = test_tim6();
+  int result7 = test_benchmark();
+
+  if (result1 == TEST_PASS && result2 == TEST_PASS && result3 == TEST_PASS &&
+      result4 == TEST_PASS && result5 == TEST_PASS && result6 == TEST_PASS &&
+      result7 == TEST_PASS) {
+    printf("\r\nTest Result: PASSED\r\n");
+  } else {
+    printf("\r\nTest Result: FAILED\r\n");
+  }
+  printf("========================================\r\n");
+}
+
+/* 私有函数实现 --------------------------------------------------------------*/
+
+static uint32_t test_rand(void) {
+  s_rand_state = s_rand_state * 1664525U + 1013904223U;
+  return s_rand_state;
+}
+
+/**
+ * @brief  到期回调：记录时刻和次数，按记录停止自己或其他定时器
+ */
+static void test_cb(tw_timer_t *timer, void *ctx) {
+  test_rec_t *rec = ctx;
+
+  rec->fired_at = tw_now();
+  rec->count++;
+  if (rec->limit != 0 && rec->count >= rec->limit) {
+    tw_stop(timer);
+  }
+  if (rec->victim != NULL) {
+    tw_stop(rec->victim);
+  }
+}
+
+/**
+ * @brief  手动节拍模式下清空时间轮，初始化前 n 个定时器
+ */
+static void test_reset(uint32_t n) {
+  tw_init(0);
+  memset(s_recs, 0, sizeof(s_recs));
+  for (uint32_t i = 0; i < n; i++) {
+    tw_timer_init(&s_timers[i], test_cb, &s_recs[i]);
+  }
+}
+
+static void test_run_ticks(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    tw_tick();
+  }
+}
+
+/**
+ * @brief  层边界：从非对齐的起点启动，每个定时器恰好在 delay 个节拍后到期
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_boundaries(void) {
+  static const uint32_t delays[] = {1,    2,    63,    64,     65,     127,
+                                    4095, 4096, 4097,  8191,   262143, 262144,
+                                    262145, 300001};
+  const uint32_t n = sizeof(delays) / sizeof(delays[0]);
+  uint32_t start;
+
+  printf("[TEST] Expiry across level boundaries\r\n");
+
+  test_reset(n);
+  test_run_ticks(37); /* 起点不与任何一层对齐 */
+  start = tw_now();
+  for (uint32_t i = 0; i < n; i++) {
+    s_recs[i].expect = start + delays[i];
+    tw_start(&s_timers[i], delays[i], 0);
+  }
+  test_run_ticks(delays[n - 1] + 10);
+
+  for (uint32_t i = 0; i < n; i++) {
+    if (s_recs[i].count != 1 || s_recs[i].fired_at != s_recs[i].expect) {
+      printf("  [FAIL] delay %lu fired %lu times at %lu (expect %lu)\r\n",
+             (unsigned long)delays[i], (unsigned long)s_recs[i].count,
+             (unsigned long)s_recs[i].fired_at,
+             (unsigned long)s_recs[i].expect);
+      return TEST_FAIL;
+    }
+  }
+  if (tw_active_count() != 0) {
+    printf("  [FAIL] %lu timers still active\r\n",
+           (unsigned long)tw_active_count());
+    return TEST_FAIL;
+  }
+  if (tw_start(&s_timers[0], TW_MAX_TICKS + 1U, 0) != TW_PARAM_ERROR) {
+    printf("  [FAIL] Delay above TW_MAX_TICKS accepted\r\n");
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu delays up to %lu ticks exact\r\n", (unsigned long)n,
+         (unsigned long)delays[n - 1]);
+  return TEST_PASS;
+}
+
+/**
+ * @brief  停止 / 重新启动
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_stop_restart(void) {
+  printf("[TEST] Stop and restart\r\n");
+
+  test_reset(3);
+  tw_start(&s_timers[0], 100, 0);
+  tw_start(&s_timers[1], 5000, 0);
+  tw_start(&s_timers[2], 10, 0);
+
+  test_run_ticks(5);
+  if (tw_remaining(&s_timers[2]) != 5 || tw_active_count() != 3) {
+    printf("  [FAIL] remaining=%lu active=%lu\r\n",
+           (unsigned long)tw_remaining(&s_timers[2]),
+           (unsigned long)tw_active_count());
+    return TEST_FAIL;
+  }
+  /* 停止一个，重新启动一个（从上层移回第 0 层） */
+  if (tw_stop(&s_timers[0]) != TW_OK || tw_stop(&s_timers[0]) != TW_NOT_ACTIVE) {
+    printf("  [FAIL] tw_stop return values\r\n");
+    return TEST_FAIL;
+  }
+  tw_start(&s_timers[1], 20, 0);
+  test_run_ticks(200);
+
+  if (s_recs[0].count != 0 || s_recs[1].count != 1 ||
+      s_recs[1].fired_at != 25 || s_recs[2].fired_at != 10 ||
+      tw_is_active(&s_timers[1]) || tw_stop(&s_timers[2]) != TW_NOT_ACTIVE ||
+      tw_active_count() != 0) {
+    printf("  [FAIL] counts %lu/%lu/%lu\r\n", (unsigned long)s_recs[0].count,
+           (unsigned long)s_recs[1].count, (unsigned long)s_recs[2].count);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Stopped timer silent, restarted timer moved\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  周期定时器：跨过多次级联后仍按 delay + k * period 到期
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_periodic(void) {
+  printf("[TEST] Periodic timers\r\n");
+
+  test_reset(2);
+  s_recs[0].limit = 0;
+  s_recs[1].limit = 7;
+  tw_start(&s_timers[0], 5, 70);
+  tw_start(&s_timers[1], 1, 1000);
+
+  test_run_ticks(10000);
+
+  /* 5, 75, ... , 9945：共 143 次 */
+  if (s_recs[0].count != 143 || s_recs[0].fired_at != 9945 ||
+      !tw_is_active(&s_timers[0]) || tw_remaining(&s_timers[0]) != 15) {
+    printf("  [FAIL] period 70: %lu times, last %lu\r\n",
+           (unsigned long)s_recs[0].count, (unsigned long)s_recs[0].fired_at);
+    return TEST_FAIL;
+  }
+  /* 1, 1001, ... , 6001 后在回调中停止 */
+  if (s_recs[1].count != 7 || s_recs[1].fired_at != 6001 ||
+      tw_is_active(&s_timers[1])) {
+    printf("  [FAIL] self stop: %lu times, last %lu\r\n",
+           (unsigned long)s_recs[1].count, (unsigned long)s_recs[1].fired_at);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] No drift over 10000 ticks, stop from callback\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  回调中停止同一槽内还未执行的定时器
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_stop_in_callback(void) {
+  printf("[TEST] Stop sibling from callback\r\n");
+
+  test_reset(4);
+  /* 0 和 1 同一时刻到期、互相停止：不论槽内顺序如何，只有先执行的那个到期 */
+  s_recs[0].victim = &s_timers[1];
+  s_recs[1].victim = &s_timers[0];
+  for (uint32_t i = 0; i < 4; i++) {
+    tw_start(&s_timers[i], 300, 0);
+  }
+  test_run_ticks(300);
+
+  if (s_recs[0].count + s_recs[1].count != 1 || s_recs[2].count != 1 ||
+      s_recs[3].count != 1 || tw_active_count() != 0) {
+    printf("  [FAIL] counts %lu/%lu/%lu/%lu\r\n", (unsigned long)s_recs[0].count,
+           (unsigned long)s_recs[1].count, (unsigned long)s_recs[2].count,
+           (unsigned long)s_recs[3].count);
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] Sibling removed from expiring slot\r\n");
+  return TEST_PASS;
+}
+
+/**
+ * @brief  TEST_MAX_TIMERS 个随机延时定时器，启动过程中时间轮在推进
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_random(void) {
+  uint32_t late = 0;
+
+  printf("[TEST] %d random timers\r\n", TEST_MAX_TIMERS);
+
+  test_reset(TEST_MAX_TIMERS);
+  for (uint32_t i = 0; i < TEST_MAX_TIMERS; i++) {
+    uint32_t delay = test_rand() % TEST_RANDOM_SPAN + 1U;
+    s_recs[i].expect = tw_now() + delay;
+    tw_start(&s_timers[i], delay, 0);
+    test_run_ticks(test_rand() % 8U);
+  }
+  test_run_ticks(TEST_RANDOM_SPAN + 1U);
+
+  for (uint32_t i = 0; i < TEST_MAX_TIMERS; i++) {
+    if (s_recs[i].count != 1 || s_recs[i].fired_at != s_recs[i].expect) {
+      late++;
+    }
+  }
+  if (late != 0 || tw_active_count() != 0) {
+    printf("  [FAIL] %lu timers off schedule, %lu still active\r\n",
+           (unsigned long)late, (unsigned long)tw_active_count());
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] All fired exactly once on time\r\n");
+  return TEST_PASS;
+}
+
+static void test_tim6_cb(tw_timer_t *timer, void *ctx) {
+  (void)timer;
+  (void)ctx;
+  s_tim6_fired = HAL_GetTick();
+}
+
+/**
+ * @brief  TIM6 节拍：1 kHz 下 TEST_TIM6_TICKS 个节拍约等于同样的毫秒数
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_tim6(void) {
+  uint32_t start;
+  uint32_t elapsed;
+
+  printf("[TEST] TIM6 tick source\r\n");
+
+  if (tw_init(1000) != TW_OK) {
+    printf("  [FAIL] tw_init(1000)\r\n");
+    return TEST_FAIL;
+  }
+  s_tim6_fired = 0;
+  tw_timer_init(&s_probe, test_tim6_cb, NULL);
+  start = HAL_GetTick();
+  tw_start(&s_probe, tw_ms_to_ticks(TEST_TIM6_TICKS), 0);
+  while (s_tim6_fired == 0 && HAL_GetTick() - start < 10U * TEST_TIM6_TICKS) {
+  }
+  tw_deinit();
+
+  elapsed = s_tim6_fired - start;
+  if (s_tim6_fired == 0 || elapsed + 1U < TEST_TIM6_TICKS ||
+      elapsed > TEST_TIM6_TICKS + 1U) {
+    printf("  [FAIL] %lu ticks took %lu ms\r\n", (unsigned long)TEST_TIM6_TICKS,
+           (unsigned long)(s_tim6_fired == 0 ? 0 : elapsed));
+    return TEST_FAIL;
+  }
+
+  printf("  [PASS] %lu ticks in %lu ms (now=%lu)\r\n",
+         (unsigned long)TEST_TIM6_TICKS, (unsigned long)elapsed,
+         (unsigned long)tw_now());
+  return TEST_PASS;
+}
+
+/**
+ * @brief  被测函数：在已有定时器的时间轮里启动再停止一个定时器
+ */
+static void bench_fn_start_stop(void *arg) {
+  uint32_t delay = *(const uint32_t *)arg;
+  tw_start(&s_probe, delay, 0);
+  tw_stop(&s_probe);
+}
+
+/**
+ * @brief  开销与定时器数量：启动+停止应与数量无关，到期开销扣除空转节拍后
+ *         按定时器均摊（含级联）
+ * @retval TEST_PASS / TEST_FAIL
+ */
+static int test_benchmark(void) {
+  bench_config_t cfg = {NULL, 2, 15, 0, BENCH_FLAG_IRQ_OFF};
+  static char names[4][24];
+  bench_result_t r;
+  uint32_t first = 0;
+  uint32_t row = 0;
+  uint32_t base;
+  uint32_t t0;
+  int ret = TEST_PASS;
+
+  printf("[TEST] Cost vs timer count (%s)\r\n", bench_unit());
+  bench_report_header();
+
+  /* 空时间轮推进同样节拍数的基础开销 */
+  test_reset(0);
+  t0 = bench_now();
+  test_run_ticks(TEST_BENCH_SPAN);
+  base = bench_now() - t0;
+
+  tw_timer_init(&s_probe, NULL, NULL);
+  for (uint32_t n = 16; n <= TEST_MAX_TIMERS; n *= 4, row++) {
+    uint32_t delay = TEST_BENCH_SPAN / 2U;
+    uint32_t total;
+
+    test_reset(n);
+    for (uint32_t i = 0; i < n; i++) {
+      tw_start(&s_timers[i], test_rand() % TEST_BENCH_SPAN + 1U, 0);
+    }
+
+    snprintf(names[row], sizeof(names[row]), "tw_start_stop_%lu",
+             (unsigned long)n);
+    cfg.name = names[row];
+    bench_run(&cfg, bench_fn_start_stop, &delay, &r);
+    bench_report(&r);
+    if (n == 16) {
+      first = r.median;
+    } else if (r.median > first * 2U + 8U) {
+      /* O(1)：数量增加 16 倍，开销不应明显增长 */
+      printf("  [FAIL] start+stop %lu with %lu timers vs %lu with 16\r\n",
+             (unsigned long)r.median, (unsigned long)n, (unsigned long)first);
+      ret = TEST_FAIL;
+    }
+
+    t0 = bench_now();
+    test_run_ticks(TEST_BENCH_SPAN);
+    total = bench_now() - t0;
+    if (tw_active_count() != 0) {
+      printf("  [FAIL] %lu timers left after %lu ticks\r\n",
+             (unsigned long)tw_active_count(), (unsigned long)TEST_BENCH_SPAN);
+      ret = TEST_FAIL;
+    }
+    printf("  timers %4lu: %lu ticks in %lu (empty %lu), %lu per expiry\r\n",
+           (unsigned long)n, (unsigned long)TEST_BENCH_SPAN,
+           (unsigned long)total, (unsigned long)base,
+           (unsigned long)(total > base ? (total - base) / n : 0));
+  }
+
+  if (ret == TEST_PASS) {
+    printf("  [PASS] start+stop independent of timer count\r\n");
+  }
+  return ret;
+}
@@ -82,6 +82,12 @@ static TestStatus run_interrupt_loopback(void) {
   reset_usart_rx_state();  // 重置接收状态
   usart_test_log("\r\n[USART] Interrupt loopback test start\r\n");
 
+  // 环回连接下日志本身也会被接收：等它收完（线路空闲）后再清空接收状态
+  uint32_t log_timeout = USART_TEST_TIMEOUT;
+  while (!g_usart_message_ready && log_timeout--) {
+  }
+  reset_usart_rx_state();
+
   const size_t loopback_len = strlen(LOOPBACK_MESSAGE);
   Driver_USART1_SendString((uint8_t *)LOOPBACK_MESSAGE, loopback_len);  // 发送测试消息
 
@@ -16,6 +16,7 @@
 
 #include "w25q32.h"
 #include "usart.h"  // 用于打印测试结果
+#include "bench.h"  // 性能测试计时
 #include <string.h>
 #include <stdio.h>
 #include "stdlib.h"
@@ -64,10 +65,10 @@ static void print_chip_info(W25Q32_State_t *state) {
     printf("制造商ID: 0x%02X\r\n", state->manufacturer_id);
     printf("JEDEC ID: 0x%04X\r\n", state->jedec_id);
     printf("设备ID: 0x%02X\r\n", state->device_id);
-    printf("唯一ID: 0x%016llX\r\n", state->unique_id);
-    printf("总页数: %lu\r\n", state->page_count);
-    printf("总扇区数: %lu\r\n", state->sector_count);
-    printf("总块数(64KB): %lu\r\n", state->block_64k_count);
+    printf("唯一ID: 0x%016llX\r\n", (unsigned long long)state->unique_id);
+    printf("总页数: %lu\r\n", (unsigned long)state->page_count);
+    printf("总扇区数: %lu\r\n", (unsigned long)state->sector_count);
+    printf("总块数(64KB): %lu\r\n", (unsigned long)state->block_64k_count);
     printf("====================================\r\n\r\n");
 }
 
@@ -320,8 +321,41 @@ static void test_erase_operations(void) {
     print_test_result("扇区擦除验证", verify_erased(read_buffer, W25Q32_SECTOR_SIZE));
 }
 
+/**
+ * @brief 性能测试的被测函数参数
+ */
+typedef struct {
+    uint32_t index;     // 下一次操作的页号（擦除时为扇区号）
+    uint8_t *buffer;    // 数据缓冲区
+} perf_arg_t;
+
+/**
+ * @brief 被测函数: 擦除 arg->index 指定的 4KB 扇区
+ */
+static void perf_sector_erase(void *arg) {
+    perf_arg_t *p = (perf_arg_t *)arg;
+    W25Q32_SectorErase_4KB(p->index);
+}
+
+/**
+ * @brief 被测函数: 编程一页并等待完成，之后页号递增
+ */
+static void perf_page_program(void *arg) {
+    perf_arg_t *p = (perf_arg_t *)arg;
+    W25Q32_PageProgram(p->index++, 0, p->buffer, W25Q32_PAGE_SIZE);
+}
+
+/**
+ * @brief 被测函数: 读取一页
+ */
+static void perf_page_read(void *arg) {
+    perf_arg_t *p = (perf_arg_t *)arg;
+    W25Q32_ReadData(p->index * W25Q32_PAGE_SIZE, p->buffer, W25Q32_PAGE_SIZE);
+}
+
 /**
  * @brief 测试7: 性能测试
+ * @note  使用 bench 框架计时，结果以 BENCH CSV 行输出
  */
 static void test_performance(void) {
     printf("\r\n========== 测试7: 性能测试 ==========\r\n");
@@ -331,23 +365,38 @@ static void test_performance(void) {
     
     uint32_t test_page = TEST_PAGE_NUM + 50;
     uint32_t test_sector = (test_page * W25Q32_PAGE_SIZE) / W25Q32_SECTOR_SIZE;
+    perf_arg_t arg = {test_page, buffer};
+    bench_config_t cfg = {NULL, 0, 10, W25Q32_PAGE_SIZE, 0};
+    bench_result_t res;
     
-    // 擦除测试
-    W25Q32_SectorErase_4KB(test_sector);
+    bench_init();
+    bench_report_header();
     
-    // 页编程速度测试 (写10页)
+    // 擦除测试
+    cfg.name = "w25q32_sector_erase_4k";
+    cfg.reps = 1;
+    cfg.bytes = W25Q32_SECTOR_SIZE;
+    arg.index = test_sector;
+    bench_run(&cfg, perf_sector_erase, &arg, &res);
+    bench_report(&res);
+    
+    // 页编程速度测试 (每次写一页，共10页)
     printf("页编程性能测试 (10页)...\r\n");
-    // 注意: 这里需要添加时间测量代码,使用HAL_GetTick()或DWT
-    for (int i = 0; i < 10; i++) {
-        W25Q32_PageProgram(test_page + i, 0, buffer, W25Q32_PAGE_SIZE);
-    }
+    cfg.name = "w25q32_page_program";
+    cfg.reps = 10;
+    cfg.bytes = W25Q32_PAGE_SIZE;
+    arg.index = test_page;
+    bench_run(&cfg, perf_page_program, &arg, &res);
+    bench_report(&res);
     printf("页编程完成\r\n");
     
-    // 读取速度测试 (读取10页)
+    // 读取速度测试 (同一页读取10次)
     printf("读取性能测试 (10页)...\r\n");
-    for (int i = 0; i < 10; i++) {
-        W25Q32_ReadData((test_page + i) * W25Q32_PAGE_SIZE, buffer, W25Q32_PAGE_SIZE);
-    }
+    cfg.name = "w25q32_page_read";
+    cfg.warmup = 1;
+    arg.index = test_page;
+    bench_run(&cfg, perf_page_read, &arg, &res);
+    bench_report(&res);
     printf("读取完成\r\n");
     
     print_test_result("性能测试完成", 1);
@@ -410,9 +459,9 @@ void W25Q32_RunAllTests(void) {
     printf("========================================\r\n");
     printf("           测试总结\r\n");
     printf("========================================\r\n");
-    printf("总测试数: %lu\r\n", g_test_result.total_tests);
-    printf("通过: %lu\r\n", g_test_result.passed_tests);
-    printf("失败: %lu\r\n", g_test_result.failed_tests);
+    printf("总测试数: %lu\r\n", (unsigned long)g_test_result.total_tests);
+    printf("通过: %lu\r\n", (unsigned long)g_test_result.passed_tests);
+    printf("失败: %lu\r\n", (unsigned long)g_test_result.failed_tests);
     printf("通过率: %.2f%%\r\n", 
            (float)g_test_result.passed_tests / g_test_result.total_tests * 100.0f);
     printf("========================================\r\n\r\n");
@@ -432,5 +481,6 @@ void W25Q32_RunQuickTest(void) {
     test_basic_read_write();
     
     printf("\r\n快速测试完成: %lu/%lu 通过\r\n\r\n", 
-           g_test_result.passed_tests, g_test_result.total_tests);
+           (unsigned long)g_test_result.passed_tests,
+           (unsigned long)g_test_result.total_tests);
 }
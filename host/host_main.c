@@ -0,0 +1,373 @@
+/**
+ * @file    host_main.c
+ * @brief   主机构建的测试入口：初始化仿真器后运行一个测试套件
+ * @date    2026-10-18
+ *
+ * @note    用法：stm32_host <suite>，不带参数时列出全部套件。
+ *          - 固件代码把指针转成 32 位地址交给 DMA，所以可执行文件用
+ *            -no-pie 链接（全局变量在低 4GB），堆只用 brk 分配，
+ *            固件线程的栈用 MAP_32BIT 映射；
+ *          - 固件线程按 main() 的顺序初始化时钟和外设，然后运行套件；
+ *          - stdout 换成经由 main.c 中 _write 的流，printf 和目标板上一样
+ *            通过 USART1 阻塞发送并消耗虚拟时间，USART 模型再把字节回显到
+ *            主机终端；
+ *          - 返回值：0 通过，1 套件报告失败，2 用法错误。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include "sim.h"
+
+#include <malloc.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "main.h"
+#include "dma.h"
+#include "dma_manager.h"
+#include "gpio.h"
+#include "i2c.h"
+#include "spi.h"
+#include "tim.h"
+#include "usart.h"
+
+#include "adc_scan_test.h"
+#include "bench_test.h"
+#include "boot_test.h"
+#include "can_signal_test.h"
+#include "can_test.h"
+#include "crc_sw_test.h"
+#include "crc_test.h"
+#include "dac_wave_test.h"
+#include "dma_chain_test.h"
+#include "dma_mem_test.h"
+#include "dma_test.h"
+#include "dsp_test.h"
+#include "event_loop_test.h"
+#include "key_test.h"
+#include "led_pwm_test.h"
+#include "mem_pool_test.h"
+#include "pt_test.h"
+#include "ram_monitor_test.h"
+#include "ramfunc_test.h"
+#include "spi_bus_test.h"
+#include "spi_test.h"
+#include "test_can_driver.h"
+#include "test_w24c02.h"
+#include "tickless_test.h"
+#include "timer_wheel_test.h"
+#include "usart_test.h"
+#include "w25q32_test.h"
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define HOST_STACK_SIZE (1024UL * 1024UL)
+
+/** 栈涂色值（与 ram_monitor.h 的 RAM_PAINT_PATTERN 相同） */
+#define HOST_STACK_PAINT 0xA5A5A5A5UL
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    const char *name;
+    int (*run)(void);
+} host_suite_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static const host_suite_t *s_suite;
+static int s_result;
+static uintptr_t s_stack_base;
+static uintptr_t s_stack_top;
+
+/* Private functions ---------------------------------------------------------*/
+
+/* main.c 中定义，未在 main.h 中声明 */
+void SystemClock_Config(void);
+int _write(int file, char *ptr, int len);
+
+/**
+ * @brief  固件 stdout：交给 main.c 的 _write（USART1 阻塞发送）
+ */
+static ssize_t host_stdout_write(void *cookie, const char *buf, size_t size) {
+    (void)cookie;
+    return _write(1, (char *)buf, (int)size);
+}
+
+/* 没有返回值的套件只靠输出判断结果（ctest 匹配 [FAIL] 等关键字） */
+static int run_dma(void) {
+    DMA_RunAllTests();
+    return 0;
+}
+
+static int run_dma_mem(void) {
+    DMA_Mem_RunAllTests();
+    return 0;
+}
+
+static int run_dma_chain(void) {
+    DMA_Chain_RunAllTests();
+    return 0;
+}
+
+static int run_spi(void) {
+    SPI_RunAllTests();
+    return 0;
+}
+
+static int run_spi_bus(void) {
+    SPI_Bus_RunAllTests();
+    return 0;
+}
+
+static int run_w25q32(void) {
+    W25Q32_RunAllTests();
+    return 0;
+}
+
+static int run_w24c02(void) {
+    return w24c02_run_tests() == 0 ? 0 : 1;
+}
+
+static int run_can(void) {
+    CAN_RunHALTests();
+    return 0;
+}
+
+static int run_can_driver(void) {
+    return can_driver_run_tests() == 0 ? 0 : 1;
+}
+
+static int run_can_signal(void) {
+    CAN_Signal_RunAllTests();
+    return 0;
+}
+
+static int run_usart_loopback(void) {
+    int ret;
+
+    sim_usart1_loopback(1);
+    ret = usart_loopback_test() == TEST_STATUS_PASS ? 0 : 1;
+    sim_usart1_loopback(0);
+    return ret;
+}
+
+static int run_usart_blocking(void) {
+    return usart_blocking_tx_rx_test() == TEST_STATUS_PASS ? 0 : 1;
+}
+
+static int run_bench(void) {
+    Bench_RunAllTests();
+    return 0;
+}
+
+static int run_timer_wheel(void) {
+    Timer_Wheel_RunAllTests();
+    return 0;
+}
+
+static int run_tickless(void) {
+    Tickless_RunAllTests();
+    return 0;
+}
+
+static int run_pt(void) {
+    PT_RunAllTests();
+    return 0;
+}
+
+static int run_event_loop(void) {
+    sim_usart1_loopback(1);
+    Event_Loop_RunAllTests();
+    sim_usart1_loopback(0);
+    return 0;
+}
+
+static int run_mem_pool(void) {
+    Mem_Pool_RunAllTests();
+    return 0;
+}
+
+static int run_ram_monitor(void) {
+    RAM_Monitor_RunAllTests();
+    return 0;
+}
+
+static int run_ramfunc(void) {
+    RAMFunc_RunAllTests();
+    return 0;
+}
+
+static int run_crc(void) {
+    CRC_RunAllTests();
+    return 0;
+}
+
+static int run_crc_sw(void) {
+    CRC_SW_RunAllTests();
+    return 0;
+}
+
+static int run_key(void) {
+    Key_RunAllTests();
+    return 0;
+}
+
+static int run_led_pwm(void) {
+    LED_PWM_RunAllTests();
+    return 0;
+}
+
+static int run_adc_scan(void) {
+    ADC_Scan_RunAllTests();
+    return 0;
+}
+
+static int run_dsp(void) {
+    DSP_RunAllTests();
+    return 0;
+}
+
+static int run_dac_wave(void) {
+    DAC_Wave_RunAllTests();
+    return 0;
+}
+
+static int run_boot(void) {
+    BOOT_RunAllTests();
+    return 0;
+}
+
+static const host_suite_t s_suites[] = {
+    {"dma", run_dma},
+    {"dma_mem", run_dma_mem},
+    {"dma_chain", run_dma_chain},
+    {"spi", run_spi},
+    {"spi_bus", run_spi_bus},
+    {"w25q32", run_w25q32},
+    {"w24c02", run_w24c02},
+    {"can", run_can},
+    {"can_driver", run_can_driver},
+    {"can_signal", run_can_signal},
+    {"usart_loopback", run_usart_loopback},
+    {"usart_blocking", run_usart_blocking},
+    {"bench", run_bench},
+    {"timer_wheel", run_timer_wheel},
+    {"tickless", run_tickless},
+    {"event_loop", run_event_loop},
+    {"pt", run_pt},
+    {"mem_pool", run_mem_pool},
+    {"ram_monitor", run_ram_monitor},
+    {"ramfunc", run_ramfunc},
+    {"crc", run_crc},
+    {"crc_sw", run_crc_sw},
+    {"key", run_key},
+    {"led_pwm", run_led_pwm},
+    {"adc_scan", run_adc_scan},
+    {"dsp", run_dsp},
+    {"dac_wave", run_dac_wave},
+    {"boot", run_boot},
+};
+
+#define HOST_SUITE_COUNT (sizeof(s_suites) / sizeof(s_suites[0]))
+
+/**
+ * @brief  固件线程：与 main() 相同的初始化顺序，然后运行套件
+ */
+static void *firmware_thread(void *arg) {
+    (void)arg;
+
+    /* 线程描述符和 TLS 放在映射区顶部，从这里开始才算固件的栈 */
+    s_stack_top = (uintptr_t)__builtin_frame_address(0);
+
+    SystemInit();
+    HAL_Init();
+    SystemClock_Config();
+    MX_GPIO_Init();
+    MX_DMA_Init();
+    MX_USART1_UART_Init();
+    MX_I2C2_Init();
+    MX_SPI1_Init();
+    MX_TIM6_Init();
+    DMA_Manager_Init();
+
+    s_result = s_suite->run();
+    return NULL;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s <suite>\nsuites:", prog);
+    for (size_t i = 0; i < HOST_SUITE_COUNT; i++) {
+        fprintf(stderr, " %s", s_suites[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  RAM 布局：主机构建没有堆，整个固件线程栈都算栈预留区
+ */
+void sim_ram_layout(uintptr_t *heap_start, uintptr_t *stack_limit, uintptr_t *stack_top) {
+    *heap_start = s_stack_base;
+    *stack_limit = s_stack_base;
+    *stack_top = s_stack_top;
+}
+
+int main(int argc, char **argv) {
+    pthread_attr_t attr;
+    pthread_t thread;
+    void *stack;
+
+    if (argc != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    for (size_t i = 0; i < HOST_SUITE_COUNT; i++) {
+        if (strcmp(argv[1], s_suites[i].name) == 0) {
+            s_suite = &s_suites[i];
+        }
+    }
+    if (s_suite == NULL) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    /* 堆保持在低 4GB：只用主 arena，不用 mmap 分配大块 */
+    mallopt(M_ARENA_MAX, 1);
+    mallopt(M_MMAP_MAX, 0);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    /* sim_init 之后 stdout 才换成固件流，USART 模型保留真正的终端 */
+    sim_init();
+
+    stdout = fopencookie(NULL, "w", (cookie_io_functions_t){.write = host_stdout_write});
+    if (stdout == NULL) {
+        sim_fatal("cannot redirect stdout");
+    }
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    stack = mmap(NULL, HOST_STACK_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (stack == MAP_FAILED) {
+        sim_fatal("cannot map firmware stack");
+    }
+    /* 相当于启动代码对栈的涂色 */
+    for (size_t i = 0; i < HOST_STACK_SIZE / sizeof(uint32_t); i++) {
+        ((uint32_t *)stack)[i] = HOST_STACK_PAINT;
+    }
+    s_stack_base = (uintptr_t)stack;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, HOST_STACK_SIZE);
+    if (pthread_create(&thread, &attr, firmware_thread, NULL) != 0) {
+        sim_fatal("cannot start firmware thread");
+    }
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+
+    return s_result;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,232 @@
+/**
+ * @file    cmsis_host.h
+ * @brief   主机构建的 CMSIS 内核函数实现（替代 cmsis_gcc.h）
+ * @date    2026-10-18
+ *
+ * @note    - PRIMASK / BASEPRI / WFI 等与中断相关的操作转到仿真器，
+ *            其余（REV、CLZ、SSAT 等）用等价的 C 代码实现；
+ *          - __DSB / __ISB / __DMB 只作为编译器屏障；
+ *          - 独占访问 (LDREX/STREX) 在单线程仿真中总是成功。
+ */
+
+#ifndef __CMSIS_HOST_H
+#define __CMSIS_HOST_H
+
+#include <stdint.h>
+
+/* 阻止 cmsis_compiler.h 再引入 cmsis_gcc.h */
+#define __CMSIS_GCC_H
+
+#ifndef __has_builtin
+#define __has_builtin(x) (0)
+#endif
+
+/* 编译器相关宏（与 cmsis_gcc.h 相同） ---------------------------------------*/
+#define __ASM __asm
+#define __INLINE inline
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#define __NO_RETURN __attribute__((__noreturn__))
+#define __USED __attribute__((used))
+#define __WEAK __attribute__((weak))
+#define __PACKED __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#define __RESTRICT __restrict
+#define __COMPILER_BARRIER() __asm volatile("" ::: "memory")
+
+struct __attribute__((packed)) T_UINT32 { uint32_t v; };
+__PACKED_STRUCT T_UINT16_WRITE { uint16_t v; };
+__PACKED_STRUCT T_UINT16_READ { uint16_t v; };
+__PACKED_STRUCT T_UINT32_WRITE { uint32_t v; };
+__PACKED_STRUCT T_UINT32_READ { uint32_t v; };
+#define __UNALIGNED_UINT32(x) (((struct T_UINT32 *)(x))->v)
+#define __UNALIGNED_UINT16_WRITE(addr, val) \
+    (void)((((struct T_UINT16_WRITE *)(void *)(addr))->v) = (val))
+#define __UNALIGNED_UINT16_READ(addr) \
+    (((const struct T_UINT16_READ *)(const void *)(addr))->v)
+#define __UNALIGNED_UINT32_WRITE(addr, val) \
+    (void)((((struct T_UINT32_WRITE *)(void *)(addr))->v) = (val))
+#define __UNALIGNED_UINT32_READ(addr) \
+    (((const struct T_UINT32_READ *)(const void *)(addr))->v)
+
+/* HAL 中 PWR_OverloadWfe 直接写了 "wfe" 汇编，这里把它定义成空的汇编宏 */
+__asm__(".ifndef __cmsis_host_asm\n"
+        ".set __cmsis_host_asm, 1\n"
+        ".macro wfe\n.endm\n"
+        ".macro wfi\n.endm\n"
+        ".macro sev\n.endm\n"
+        ".endif\n");
+
+/* 仿真器提供的 CPU 接口 ----------------------------------------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+void sim_cpu_enable_irq(void);
+void sim_cpu_disable_irq(void);
+uint32_t sim_cpu_get_primask(void);
+void sim_cpu_set_primask(uint32_t primask);
+uint32_t sim_cpu_get_basepri(void);
+void sim_cpu_set_basepri(uint32_t basepri);
+uint32_t sim_cpu_get_faultmask(void);
+void sim_cpu_set_faultmask(uint32_t faultmask);
+uint32_t sim_cpu_get_ipsr(void);
+void sim_cpu_nop(void);
+void sim_cpu_wfi(void);
+void sim_cpu_wfe(void);
+void sim_cpu_sev(void);
+void sim_cpu_bkpt(uint32_t value);
+/* 代替链接脚本符号的 RAM 布局：固件线程栈的底部、预留区底部和栈顶 */
+void sim_ram_layout(uintptr_t *heap_start, uintptr_t *stack_limit, uintptr_t *stack_top);
+/* 测试激励：外部驱动输入引脚（port 0 为 GPIOA），level < 0 表示释放 */
+void sim_gpio_input(int port, int pin, int level);
+/* 测试观测：取出 TIM2 通道 ch（1~4）各 PWM 周期的有效电平计数，返回个数 */
+int sim_tim2_pwm_log(int ch, uint16_t *duty, int max);
+/* 测试激励：ADCn（1 / 2）通道 channel 循环回放的 12 位采样，来自内存或文本文件 */
+void sim_adc_waveform(int adc, int channel, const uint16_t *samples, uint32_t count);
+int sim_adc_load(int adc, int channel, const char *path);
+/* 测试观测：取出 DAC 通道 ch（1 / 2）每次输出更新的值和时刻（CPU 周期），返回个数 */
+int sim_dac_log(int ch, uint16_t *value, uint64_t *when, int max);
+/* 测试激励：USART1 上的升级上位机按窗口发送镜像，corrupt_chunk 为第一次发送时损坏的块 */
+void sim_uploader_start(const uint8_t *image, uint32_t size, uint32_t window,
+                        uint32_t corrupt_chunk);
+/* 测试观测：上位机结果（-1 进行中），START 到 READY / 最后一个 ACK / DONE 的 CPU 周期 */
+int sim_uploader_result(uint64_t *ready, uint64_t *streamed, uint64_t *done, uint32_t *resent);
+/* 测试激励：下一次会话收到 READY 后上位机再发一次 START */
+void sim_uploader_repeat_start(void);
+#ifdef __cplusplus
+}
+#endif
+
+/* 内核寄存器访问 -----------------------------------------------------------*/
+
+__STATIC_FORCEINLINE void __enable_irq(void) { sim_cpu_enable_irq(); }
+__STATIC_FORCEINLINE void __disable_irq(void) { sim_cpu_disable_irq(); }
+__STATIC_FORCEINLINE void __enable_fault_irq(void) { sim_cpu_set_faultmask(0); }
+__STATIC_FORCEINLINE void __disable_fault_irq(void) { sim_cpu_set_faultmask(1); }
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void) { return sim_cpu_get_primask(); }
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask) { sim_cpu_set_primask(priMask); }
+__STATIC_FORCEINLINE uint32_t __get_BASEPRI(void) { return sim_cpu_get_basepri(); }
+__STATIC_FORCEINLINE void __set_BASEPRI(uint32_t basePri) { sim_cpu_set_basepri(basePri); }
+__STATIC_FORCEINLINE void __set_BASEPRI_MAX(uint32_t basePri) {
+    uint32_t cur = sim_cpu_get_basepri();
+    if (basePri != 0 && (cur == 0 || basePri < cur)) {
+        sim_cpu_set_basepri(basePri);
+    }
+}
+__STATIC_FORCEINLINE uint32_t __get_FAULTMASK(void) { return sim_cpu_get_faultmask(); }
+__STATIC_FORCEINLINE void __set_FAULTMASK(uint32_t faultMask) { sim_cpu_set_faultmask(faultMask); }
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void) { return sim_cpu_get_ipsr(); }
+__STATIC_FORCEINLINE uint32_t __get_xPSR(void) { return sim_cpu_get_ipsr(); }
+__STATIC_FORCEINLINE uint32_t __get_APSR(void) { return 0U; }
+__STATIC_FORCEINLINE uint32_t __get_CONTROL(void) { return 0U; }
+__STATIC_FORCEINLINE void __set_CONTROL(uint32_t control) { (void)control; }
+
+/* 仿真栈位于 4GB 以下，取当前帧地址作为 SP */
+__STATIC_FORCEINLINE uint32_t __get_MSP(void) {
+    return (uint32_t)(uintptr_t)__builtin_frame_address(0);
+}
+__STATIC_FORCEINLINE uint32_t __get_PSP(void) { return __get_MSP(); }
+__STATIC_FORCEINLINE void __set_MSP(uint32_t topOfMainStack) { (void)topOfMainStack; }
+__STATIC_FORCEINLINE void __set_PSP(uint32_t topOfProcStack) { (void)topOfProcStack; }
+
+/* 指令 ---------------------------------------------------------------------*/
+
+#define __NOP() sim_cpu_nop()
+#define __WFI() sim_cpu_wfi()
+#define __WFE() sim_cpu_wfe()
+#define __SEV() sim_cpu_sev()
+#define __BKPT(value) sim_cpu_bkpt(value)
+
+__STATIC_FORCEINLINE void __ISB(void) { __COMPILER_BARRIER(); }
+__STATIC_FORCEINLINE void __DSB(void) { __COMPILER_BARRIER(); }
+__STATIC_FORCEINLINE void __DMB(void) { __COMPILER_BARRIER(); }
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value) { return __builtin_bswap32(value); }
+
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value) {
+    return ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);
+}
+
+__STATIC_FORCEINLINE int16_t __REVSH(int16_t value) {
+    return (int16_t)__builtin_bswap16((uint16_t)value);
+}
+
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t op1, uint32_t op2) {
+    op2 %= 32U;
+    if (op2 == 0U) {
+        return op1;
+    }
+    return (op1 >> op2) | (op1 << (32U - op2));
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value) {
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i++) {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+    return result;
+}
+
+/* ARM 的 CLZ(0) = 32，__builtin_clz(0) 未定义 */
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value) {
+    return value == 0U ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t val, uint32_t sat) {
+    if (sat >= 1U && sat <= 32U) {
+        const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+        const int32_t min = -1 - max;
+        if (val > max) {
+            return max;
+        } else if (val < min) {
+            return min;
+        }
+    }
+    return val;
+}
+
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t val, uint32_t sat) {
+    if (sat <= 31U) {
+        const uint32_t max = ((1U << sat) - 1U);
+        if (val > (int32_t)max) {
+            return max;
+        } else if (val < 0) {
+            return 0U;
+        }
+    }
+    return (uint32_t)val;
+}
+
+__STATIC_FORCEINLINE uint32_t __RRX(uint32_t value) { return value >> 1; }
+
+/* 独占访问：单线程仿真中 STREX 总是成功 */
+__STATIC_FORCEINLINE uint8_t __LDREXB(volatile uint8_t *addr) { return *addr; }
+__STATIC_FORCEINLINE uint16_t __LDREXH(volatile uint16_t *addr) { return *addr; }
+__STATIC_FORCEINLINE uint32_t __LDREXW(volatile uint32_t *addr) { return *addr; }
+__STATIC_FORCEINLINE uint32_t __STREXB(uint8_t value, volatile uint8_t *addr) {
+    *addr = value;
+    return 0U;
+}
+__STATIC_FORCEINLINE uint32_t __STREXH(uint16_t value, volatile uint16_t *addr) {
+    *addr = value;
+    return 0U;
+}
+__STATIC_FORCEINLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) {
+    *addr = value;
+    return 0U;
+}
+__STATIC_FORCEINLINE void __CLREX(void) {}
+
+__STATIC_FORCEINLINE uint8_t __LDRBT(volatile uint8_t *ptr) { return *ptr; }
+__STATIC_FORCEINLINE uint16_t __LDRHT(volatile uint16_t *ptr) { return *ptr; }
+__STATIC_FORCEINLINE uint32_t __LDRT(volatile uint32_t *ptr) { return *ptr; }
+__STATIC_FORCEINLINE void __STRBT(uint8_t value, volatile uint8_t *ptr) { *ptr = value; }
+__STATIC_FORCEINLINE void __STRHT(uint16_t value, volatile uint16_t *ptr) { *ptr = value; }
+__STATIC_FORCEINLINE void __STRT(uint32_t value, volatile uint32_t *ptr) { *ptr = value; }
+
+#endif /* __CMSIS_HOST_H */
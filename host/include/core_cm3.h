@@ -0,0 +1,19 @@
+/**
+ * @file    core_cm3.h
+ * @brief   主机构建用的 core_cm3.h 包装
+ * @date    2026-10-18
+ *
+ * @note    host/include 排在 CMSIS 头文件目录之前。这里先引入 cmsis_host.h，
+ *          它定义了 __CMSIS_GCC_H 并给出所有内核函数的主机实现，
+ *          然后再 include_next 真正的 core_cm3.h，寄存器结构体和
+ *          NVIC / SysTick 辅助函数保持原样。
+ */
+
+#ifndef __HOST_CORE_CM3_WRAPPER_H
+#define __HOST_CORE_CM3_WRAPPER_H
+
+#include "cmsis_host.h"
+
+#endif /* __HOST_CORE_CM3_WRAPPER_H */
+
+#include_next <core_cm3.h>
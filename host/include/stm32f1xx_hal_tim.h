@@ -0,0 +1,22 @@
+/**
+ * @file    stm32f1xx_hal_tim.h
+ * @brief   主机构建用的 stm32f1xx_hal_tim.h 包装
+ * @date    2026-10-18
+ *
+ * @note    CMSIS 的位掩码写成 0x1UL << n，主机 (LP64) 上 unsigned long 是
+ *          64 位，__HAL_TIM_CLEAR_FLAG 的 ~(__FLAG__) 写入 32 位的 SR 时
+ *          会被截断并产生 -Woverflow 警告（结果本身正确）。这里先
+ *          include_next 真正的头文件，再把这个宏换成先转成 uint32_t
+ *          再取反的等价写法，其余保持原样。
+ */
+
+#include_next <stm32f1xx_hal_tim.h>
+
+#ifndef __HOST_HAL_TIM_WRAPPER_H
+#define __HOST_HAL_TIM_WRAPPER_H
+
+#undef __HAL_TIM_CLEAR_FLAG
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__) \
+    ((__HANDLE__)->Instance->SR = ~(uint32_t)(__FLAG__))
+
+#endif /* __HOST_HAL_TIM_WRAPPER_H */
@@ -0,0 +1,191 @@
+/**
+ * @file    sim.h
+ * @brief   STM32F103 主机仿真器内部接口
+ * @date    2026-10-18
+ *
+ * @note    工作原理：
+ *          - 固件、HAL 和测试用 -fsanitize=thread 编译但不链接 TSan 运行时，
+ *            每次内存访问前编译器插入的 __tsan_* 调用由 sim_core.c 实现；
+ *            加上 --param tsan-distinguish-volatile=1 后寄存器（volatile）
+ *            访问走 __tsan_volatile_*，据此驱动外设模型；
+ *          - 外设地址区间用 mmap 映射到真实地址，CMSIS 的 SPI1、DMA1 等宏
+ *            无需修改即可使用，模型直接读写这块内存；
+ *          - 写钩子在写入之前调用，因此写操作记为“挂起”，在下一次钩子开头
+ *            处理，此时新值已经在内存里；外设位带别名区的访问折算成对
+ *            目标字的读 / 读-改-写；
+ *          - 虚拟时钟以 72 MHz CPU 周期计数，每次访问推进若干周期；
+ *            TSan 不插桩不逃逸的局部变量，另用 -fsanitize-coverage=trace-pc
+ *            在每个基本块入口计入周期，纯寄存器 / 栈上的循环同样消耗时间；
+ *          - 外设用事件在指定周期触发。
+ */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "stm32f1xx.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+/** 虚拟 CPU 频率 */
+#define SIM_CPU_HZ 72000000UL
+
+/** 各类访问计入的周期数 */
+#define SIM_CYCLES_ACCESS 1U   /*!< 普通内存访问 */
+#define SIM_CYCLES_PERIPH 2U   /*!< 外设寄存器访问 */
+#define SIM_CYCLES_CALL 3U     /*!< 函数调用 / 返回 */
+#define SIM_CYCLES_BLOCK 2U    /*!< 进入一个基本块（分支与流水线填充） */
+#define SIM_CYCLES_EXC 12U     /*!< 异常进入或退出 */
+
+/** 仿真映射的地址区间 */
+#define SIM_PERIPH_BASE 0x40000000UL
+#define SIM_PERIPH_SIZE 0x00030000UL
+#define SIM_CORE_BASE 0xE0000000UL
+#define SIM_CORE_SIZE 0x00100000UL
+
+/** 外部中断个数（F103xE） */
+#define SIM_IRQ_COUNT 60
+
+/** GPIO 端口编号 */
+#define SIM_GPIOA 0
+#define SIM_GPIOB 1
+#define SIM_GPIOC 2
+#define SIM_GPIOD 3
+#define SIM_GPIOE 4
+#define SIM_GPIOF 5
+#define SIM_GPIOG 6
+#define SIM_GPIO_PORTS 7
+
+/** DMA 通道编号（与 DMA_ChannelId_t 相同：DMA1_1..DMA1_7, DMA2_1..DMA2_5） */
+#define SIM_DMA_CH(dma, n) ((dma) == 1 ? (n) - 1 : 7 + (n) - 1)
+#define SIM_DMA_CHANNELS 12
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef uint64_t sim_time_t;
+
+/**
+ * @brief  外设模型
+ * @note   off 为相对 base 的字对齐偏移；寄存器内容始终保存在映射的内存中
+ */
+typedef struct {
+    const char *name;
+    uint32_t base;
+    uint32_t size;
+    /** 复位：写入复位值 */
+    void (*reset)(void);
+    /** 固件读之前调用，把当前值写入寄存器 */
+    void (*read)(uint32_t off);
+    /** 固件读之后调用，处理读清除等副作用 */
+    void (*read_done)(uint32_t off);
+    /** 固件写之后调用：val 为写入后的字，old 为写入前的字 */
+    void (*write)(uint32_t off, uint32_t val, uint32_t old);
+} sim_periph_t;
+
+/**
+ * @brief  定时事件
+ */
+typedef struct sim_event {
+    sim_time_t when;                     /*!< 触发时刻 */
+    void (*fn)(struct sim_event *ev);    /*!< 回调 */
+    void *arg;                           /*!< 回调参数 */
+    struct sim_event *next;
+    uint8_t armed;
+} sim_event_t;
+
+/** GPIO 输出变化回调 */
+typedef void (*sim_gpio_cb_t)(int port, int pin, int level);
+
+/**
+ * @brief  I2C 从设备
+ */
+typedef struct {
+    uint8_t addr;                        /*!< 7 位地址 */
+    /** 地址匹配后开始一次传输，返回 1 表示 ACK */
+    int (*start)(int read);
+    /** 主机写一个字节，返回 1 表示 ACK */
+    int (*write)(uint8_t byte);
+    /** 主机读一个字节 */
+    uint8_t (*read)(void);
+    /** 停止条件 */
+    void (*stop)(void);
+} sim_i2c_slave_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/* 核心：地址映射、时钟与事件 */
+void sim_init(void);
+void sim_register(const sim_periph_t *p);
+void sim_reset_all(void);
+sim_time_t sim_now(void);
+void sim_advance(uint64_t cycles);
+void sim_sync(void);
+void sim_charge(uint32_t cycles);
+void sim_idle(void);
+void sim_event_init(sim_event_t *ev, void (*fn)(sim_event_t *ev), void *arg);
+void sim_event_at(sim_event_t *ev, sim_time_t when);
+void sim_event_after(sim_event_t *ev, uint64_t cycles);
+void sim_event_cancel(sim_event_t *ev);
+uint32_t sim_bus_read(uint32_t addr, uint32_t size, int *error);
+void sim_bus_write(uint32_t addr, uint32_t size, uint32_t value, int *error);
+void sim_fatal(const char *fmt, ...);
+
+/* 内核：NVIC、SysTick、DWT、SCB */
+void sim_nvic_init(void);
+void sim_irq_level(int irqn, int level);
+void sim_irq_pend(int irqn);
+void sim_irq_check(void);
+int sim_irq_deliverable(void);
+extern volatile int sim_irq_dirty;
+
+/* 外设模型 */
+void sim_rcc_init(void);
+extern uint32_t sim_flash_wait; /* Flash 取指等待周期（FLASH_ACR.LATENCY） */
+void sim_gpio_init(void);
+void sim_gpio_watch(int port, int pin, sim_gpio_cb_t cb);
+void sim_gpio_input(int port, int pin, int level);
+void sim_exti_init(void);
+void sim_exti_edge(int port, int pin, int level);
+int sim_gpio_output(int port, int pin);
+void sim_dma_init(void);
+void sim_dma_request(int ch, uint32_t source, int level);
+void sim_dma_pulse(int ch);
+void sim_spi_init(void);
+void sim_spi1_attach(uint8_t (*xfer)(uint8_t byte));
+void sim_w25q32_init(void);
+void sim_i2c_init(void);
+void sim_i2c2_attach(const sim_i2c_slave_t *slave);
+void sim_w24c02_init(void);
+void sim_usart_init(void);
+void sim_usart1_loopback(int on);
+void sim_usart1_inject(const uint8_t *data, size_t len);
+void sim_usart1_echo(int on);
+void sim_usart1_attach(void (*rx)(uint8_t byte));
+void sim_can_init(void);
+void sim_tim_init(void);
+int sim_tim2_pwm_log(int ch, uint16_t *duty, int max);
+void sim_crc_init(void);
+void sim_adc_init(void);
+void sim_adc_trigger(int extsel);
+void sim_adc_waveform(int adc, int channel, const uint16_t *samples, uint32_t count);
+int sim_adc_load(int adc, int channel, const char *path);
+void sim_dac_init(void);
+void sim_dac_trigger(int tsel, sim_time_t when);
+int sim_dac_log(int ch, uint16_t *value, uint64_t *when, int max);
+void sim_uploader_start(const uint8_t *image, uint32_t size, uint32_t window,
+                        uint32_t corrupt_chunk);
+int sim_uploader_result(uint64_t *ready, uint64_t *streamed, uint64_t *done, uint32_t *resent);
+void sim_uploader_repeat_start(void);
+
+/** DMA 请求源位（同一通道上多个外设请求相或） */
+#define SIM_DMA_SRC_SPI1_RX 0x01U
+#define SIM_DMA_SRC_SPI1_TX 0x02U
+#define SIM_DMA_SRC_USART1_TX 0x04U
+#define SIM_DMA_SRC_USART1_RX 0x08U
+#define SIM_DMA_SRC_I2C2_TX 0x10U
+#define SIM_DMA_SRC_I2C2_RX 0x20U
+#define SIM_DMA_SRC_ADC1 0x40U
+
+#endif /* __SIM_H__ */
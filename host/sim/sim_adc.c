@@ -0,0 +1,371 @@
+/**
+ * @file    sim_adc.c
+ * @brief   ADC1 / ADC2 规则通道模型（波形回放）
+ * @date    2026-10-18
+ *
+ * @note    - 每个通道的输入是一段循环回放的 12 位采样序列，由测试用
+ *            sim_adc_waveform（内存）或 sim_adc_load（文本文件）提供；通道
+ *            每完成一次转换取下一个采样。没有波形的通道读出 0，VREFINT
+ *            （通道 17）为 1489（1.20 V / 3.3 V）；
+ *          - 一次转换耗时 (采样时间 + 12.5) 个 ADC 时钟，ADC 时钟为 72 MHz
+ *            按 RCC_CFGR.ADCPRE 分频；SCAN 时按 SQR 依次转换 L + 1 个通道，
+ *            CONT 时序列结束后立即重新开始；
+ *          - 启动：EXTTRIG 且 EXTSEL 选中的触发到来（TIM3_TRGO 经
+ *            sim_adc_trigger 送入），或 EXTSEL = SWSTART 时写 SWSTART；
+ *            转换进行中到来的触发被忽略；
+ *          - 每次转换结束写 DR、置 EOC，读 DR 清除 EOC；ADC1 的 DMA 位
+ *            以 EOC 电平向 DMA1 通道 1 提出请求；
+ *          - ADC1 CR1.DUALMOD = 0110（规则同步）时 ADC1 的触发同时启动
+ *            ADC2 的序列，每次转换 ADC2 结果写入 ADC1_DR 高 16 位；
+ *          - 校准（CAL / RSTCAL）立即完成；注入通道、模拟看门狗不建模。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_SR 0x00U
+#define OFF_CR1 0x04U
+#define OFF_CR2 0x08U
+#define OFF_DR 0x4CU
+
+#define ADC_CHANNELS 18
+#define ADC_UNITS 2
+#define ADC_EXTSEL_SWSTART 7U
+#define ADC_DUALMOD_REGSIMULT 6U
+#define ADC_VREFINT_CODE 1489U
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    ADC_TypeDef *regs;
+    uint16_t *wave[ADC_CHANNELS];
+    uint32_t len[ADC_CHANNELS];
+    uint32_t pos[ADC_CHANNELS];
+    sim_event_t ev;
+    int busy;
+    int index;              /* 序列中正在转换的位置 */
+} adc_unit_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static adc_unit_t s_adc[ADC_UNITS];
+
+/** 采样时间（半个 ADC 时钟为单位）：1.5, 7.5, 13.5, 28.5, 41.5, 55.5, 71.5, 239.5 */
+static const uint16_t s_smp_half[8] = {3, 15, 27, 57, 83, 111, 143, 479};
+
+/* Private functions ---------------------------------------------------------*/
+
+static int adc_dual(void) {
+    return ((ADC1->CR1 & ADC_CR1_DUALMOD) >> ADC_CR1_DUALMOD_Pos) == ADC_DUALMOD_REGSIMULT;
+}
+
+static void adc_update(void) {
+    int irq = 0;
+
+    sim_dma_request(SIM_DMA_CH(1, 1), SIM_DMA_SRC_ADC1,
+                    (ADC1->CR2 & ADC_CR2_DMA) && (ADC1->SR & ADC_SR_EOC));
+    for (int i = 0; i < ADC_UNITS; i++) {
+        ADC_TypeDef *r = s_adc[i].regs;
+        irq |= (r->CR1 & ADC_CR1_EOCIE) && (r->SR & ADC_SR_EOC);
+    }
+    sim_irq_level(ADC1_2_IRQn, irq);
+}
+
+/**
+ * @brief  规则序列长度
+ */
+static int adc_seq_len(const adc_unit_t *a) {
+    if (!(a->regs->CR1 & ADC_CR1_SCAN)) {
+        return 1;
+    }
+    return (int)((a->regs->SQR1 & ADC_SQR1_L) >> ADC_SQR1_L_Pos) + 1;
+}
+
+/**
+ * @brief  序列第 k 个（0 起）通道号
+ */
+static uint32_t adc_seq_channel(const adc_unit_t *a, int k) {
+    uint32_t sqr = (k < 6) ? a->regs->SQR3 : (k < 12) ? a->regs->SQR2 : a->regs->SQR1;
+
+    return (sqr >> ((k % 6) * 5)) & 0x1FU;
+}
+
+/**
+ * @brief  一次转换的 CPU 周期数
+ */
+static uint64_t adc_conv_cycles(const adc_unit_t *a, uint32_t ch) {
+    uint32_t div = 2U * (((RCC->CFGR & RCC_CFGR_ADCPRE) >> RCC_CFGR_ADCPRE_Pos) + 1U);
+    uint32_t smpr = (ch < 10U) ? a->regs->SMPR2 : a->regs->SMPR1;
+    uint32_t code = (smpr >> ((ch % 10U) * 3U)) & 7U;
+
+    return (uint64_t)(s_smp_half[code] + 25U) * div / 2U;
+}
+
+/**
+ * @brief  通道的下一个采样
+ */
+static uint16_t adc_sample(adc_unit_t *a, uint32_t ch) {
+    uint16_t v;
+
+    if (ch >= ADC_CHANNELS) {
+        return 0;
+    }
+    if (a->wave[ch] == NULL) {
+        return (ch == 17U) ? ADC_VREFINT_CODE : 0U;
+    }
+    v = a->wave[ch][a->pos[ch]];
+    a->pos[ch] = (a->pos[ch] + 1U) % a->len[ch];
+    return v;
+}
+
+static void adc_schedule(adc_unit_t *a) {
+    sim_event_after(&a->ev, adc_conv_cycles(a, adc_seq_channel(a, a->index)));
+}
+
+static void adc_start(adc_unit_t *a) {
+    if (a->busy || !(a->regs->CR2 & ADC_CR2_ADON)) {
+        return;
+    }
+    a->busy = 1;
+    a->index = 0;
+    a->regs->SR |= ADC_SR_STRT;
+    adc_schedule(a);
+}
+
+static void adc_stop(adc_unit_t *a) {
+    sim_event_cancel(&a->ev);
+    a->busy = 0;
+}
+
+/**
+ * @brief  一次转换结束
+ */
+static void adc_conv_done(sim_event_t *ev) {
+    adc_unit_t *a = ev->arg;
+    uint32_t value = adc_sample(a, adc_seq_channel(a, a->index));
+
+    if (a == &s_adc[0] && adc_dual()) {
+        adc_unit_t *b = &s_adc[1];
+        uint32_t v2 = adc_sample(b, adc_seq_channel(b, a->index));
+        b->regs->DR = v2;
+        b->regs->SR |= ADC_SR_EOC | ADC_SR_STRT;
+        value |= v2 << 16;
+    }
+    a->regs->DR = value;
+    a->regs->SR |= ADC_SR_EOC;
+
+    a->index++;
+    if (a->index >= adc_seq_len(a)) {
+        a->index = 0;
+        a->busy = (a->regs->CR2 & ADC_CR2_CONT) != 0;
+    }
+    if (a->busy) {
+        adc_schedule(a);
+    }
+    adc_update();
+}
+
+static void adc_reset_unit(adc_unit_t *a) {
+    memset((void *)a->regs, 0, 0x400);
+    adc_stop(a);
+    memset(a->pos, 0, sizeof(a->pos));
+}
+
+static void adc_reset(void) {
+    for (int i = 0; i < ADC_UNITS; i++) {
+        adc_reset_unit(&s_adc[i]);
+    }
+    sim_dma_request(SIM_DMA_CH(1, 1), SIM_DMA_SRC_ADC1, 0);
+    sim_irq_level(ADC1_2_IRQn, 0);
+}
+
+static void adc_read_done(adc_unit_t *a, uint32_t off) {
+    if (off == OFF_DR) {
+        a->regs->SR &= ~ADC_SR_EOC;
+        adc_update();
+    }
+}
+
+static void adc_write(adc_unit_t *a, uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case OFF_SR:
+        a->regs->SR = old & val;
+        break;
+    case OFF_CR2:
+        a->regs->CR2 &= ~(ADC_CR2_CAL | ADC_CR2_RSTCAL);
+        if (!(val & ADC_CR2_ADON)) {
+            adc_stop(a);
+        } else if ((val & ADC_CR2_SWSTART) && (val & ADC_CR2_EXTTRIG) &&
+                   ((val & ADC_CR2_EXTSEL) >> ADC_CR2_EXTSEL_Pos) == ADC_EXTSEL_SWSTART) {
+            adc_start(a);
+        }
+        a->regs->CR2 &= ~ADC_CR2_SWSTART;
+        break;
+    default:
+        break;
+    }
+    adc_update();
+}
+
+static void adc1_read_done(uint32_t off) {
+    adc_read_done(&s_adc[0], off);
+}
+
+static void adc2_read_done(uint32_t off) {
+    adc_read_done(&s_adc[1], off);
+}
+
+static void adc1_write(uint32_t off, uint32_t val, uint32_t old) {
+    adc_write(&s_adc[0], off, val, old);
+}
+
+static void adc2_write(uint32_t off, uint32_t val, uint32_t old) {
+    adc_write(&s_adc[1], off, val, old);
+}
+
+static const sim_periph_t s_adc1_model = {
+    .name = "ADC1",
+    .base = ADC1_BASE,
+    .size = 0x400,
+    .reset = adc_reset,
+    .read = NULL,
+    .read_done = adc1_read_done,
+    .write = adc1_write,
+};
+
+static const sim_periph_t s_adc2_model = {
+    .name = "ADC2",
+    .base = ADC2_BASE,
+    .size = 0x400,
+    .reset = NULL,
+    .read = NULL,
+    .read_done = adc2_read_done,
+    .write = adc2_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_adc_init(void) {
+    s_adc[0].regs = ADC1;
+    s_adc[1].regs = ADC2;
+    for (int i = 0; i < ADC_UNITS; i++) {
+        sim_event_init(&s_adc[i].ev, adc_conv_done, &s_adc[i]);
+    }
+    sim_register(&s_adc1_model);
+    sim_register(&s_adc2_model);
+}
+
+/**
+ * @brief  外部触发：extsel 为 ADC12 的 EXTSEL 编号
+ * @note   双 ADC 模式下 ADC2 跟随 ADC1，不单独响应触发
+ */
+void sim_adc_trigger(int extsel) {
+    for (int i = 0; i < ADC_UNITS; i++) {
+        adc_unit_t *a = &s_adc[i];
+        uint32_t cr2 = a->regs->CR2;
+
+        if (i == 1 && adc_dual()) {
+            continue;
+        }
+        if ((cr2 & ADC_CR2_EXTTRIG) &&
+            ((cr2 & ADC_CR2_EXTSEL) >> ADC_CR2_EXTSEL_Pos) == (uint32_t)extsel) {
+            adc_start(a);
+        }
+    }
+}
+
+/**
+ * @brief  设置 ADCn（1 / 2）通道 channel 的回放波形（复制一份）
+ * @note   count 为 0 时清除波形
+ */
+void sim_adc_waveform(int adc, int channel, const uint16_t *samples, uint32_t count) {
+    adc_unit_t *a;
+
+    if (adc < 1 || adc > ADC_UNITS || channel < 0 || channel >= ADC_CHANNELS) {
+        sim_fatal("sim_adc_waveform: bad ADC%d channel %d", adc, channel);
+    }
+    a = &s_adc[adc - 1];
+    free(a->wave[channel]);
+    a->wave[channel] = NULL;
+    a->len[channel] = 0;
+    a->pos[channel] = 0;
+    if (count == 0) {
+        return;
+    }
+
+    a->wave[channel] = malloc(count * sizeof(uint16_t));
+    if (a->wave[channel] == NULL) {
+        sim_fatal("sim_adc_waveform: out of memory");
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        a->wave[channel][i] = samples[i] & 0x0FFFU;
+    }
+    a->len[channel] = count;
+}
+
+/**
+ * @brief  从文本文件加载回放波形
+ * @note   采样为十进制整数，以空白或逗号分隔，# 到行尾为注释
+ * @retval 采样数，打开或解析失败返回 -1
+ */
+int sim_adc_load(int adc, int channel, const char *path) {
+    FILE *f = fopen(path, "r");
+    uint16_t *buf = NULL;
+    uint32_t count = 0, cap = 0;
+    char line[256];
+
+    if (f == NULL) {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *p = line;
+        char *hash = strchr(line, '#');
+
+        if (hash != NULL) {
+            *hash = '\0';
+        }
+        for (;;) {
+            char *end;
+            long v;
+
+            p += strspn(p, " \t\r\n,");
+            if (*p == '\0') {
+                break;
+            }
+            v = strtol(p, &end, 10);
+            if (end == p || v < 0 || v > 0x0FFF) {
+                free(buf);
+                fclose(f);
+                return -1;
+            }
+            if (count == cap) {
+                uint16_t *grown;
+                cap = cap ? cap * 2U : 256U;
+                grown = realloc(buf, cap * sizeof(uint16_t));
+                if (grown == NULL) {
+                    sim_fatal("sim_adc_load: out of memory");
+                }
+                buf = grown;
+            }
+            buf[count++] = (uint16_t)v;
+            p = end;
+        }
+    }
+    fclose(f);
+
+    if (count == 0) {
+        free(buf);
+        return -1;
+    }
+    sim_adc_waveform(adc, channel, buf, count);
+    free(buf);
+    return (int)count;
+}
+
+/************************ END OF FILE *****************************************/
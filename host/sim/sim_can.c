@@ -0,0 +1,503 @@
+/**
+ * @file    sim_can.c
+ * @brief   bxCAN (CAN1) 模型
+ * @date    2026-10-18
+ *
+ * @note    - 总线上没有其他节点：环回模式 (LBKM) 下发送的帧经过过滤器进入
+ *            接收 FIFO；正常模式下得不到应答，记 ACK 错误并自动重发
+ *            （NART 时置 TERR 结束）；
+ *          - 一位的时间 = (BRP + 1) × (3 + TS1 + TS2) 个 PCLK1 周期，
+ *            帧长按不含填充位计算（标准帧 47 + 8n 位，扩展帧 67 + 8n 位，
+ *            均含 3 位帧间隔）；
+ *          - 内部位计数器在退出初始化模式时清零，TTCM 下在 SOF 处锁存到
+ *            TDTR / RDTR 的 TIME 字段；
+ *          - 邮箱仲裁：TXFP = 1 按请求顺序，否则按标识符优先级。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_MCR 0x000U
+#define OFF_MSR 0x004U
+#define OFF_TSR 0x008U
+#define OFF_RF0R 0x00CU
+#define OFF_RF1R 0x010U
+#define OFF_IER 0x014U
+#define OFF_ESR 0x018U
+#define OFF_BTR 0x01CU
+#define OFF_TX_FIRST 0x180U
+#define OFF_TX_END 0x1B0U
+#define OFF_FMR 0x200U
+
+#define CAN_FIFO_DEPTH 3
+#define CAN_FILTER_BANKS 14
+
+/** 每个邮箱在 TSR 中的状态位 */
+#define TSR_MB_SHIFT(mb) ((uint32_t)(mb) * 8U)
+#define TSR_MB_STATUS 0x0FU /* RQCP | TXOK | ALST | TERR */
+#define TSR_MB_ABRQ 0x80U
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t rir;
+    uint32_t rdtr;
+    uint32_t rdlr;
+    uint32_t rdhr;
+} can_msg_t;
+
+typedef struct {
+    can_msg_t msg[CAN_FIFO_DEPTH];
+    uint8_t count;
+} can_fifo_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static sim_event_t s_tx_ev;
+static uint8_t s_tx_pending[3];
+static uint32_t s_tx_order[3];
+static uint32_t s_order_seq;
+static int s_tx_active = -1;       /* 正在发送的邮箱 */
+static sim_time_t s_sof;           /* 当前帧 SOF 时刻 */
+static sim_time_t s_time_base;     /* 位计数器清零时刻 */
+static sim_time_t s_bus_free;      /* 帧间隔结束时刻 */
+static can_fifo_t s_fifo[2];
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint64_t can_bit_cycles(void) {
+    uint32_t btr = CAN1->BTR;
+    uint32_t brp = (btr & CAN_BTR_BRP) >> CAN_BTR_BRP_Pos;
+    uint32_t ts1 = (btr & CAN_BTR_TS1) >> CAN_BTR_TS1_Pos;
+    uint32_t ts2 = (btr & CAN_BTR_TS2) >> CAN_BTR_TS2_Pos;
+
+    /* CPU 72 MHz = 2 × PCLK1 */
+    return 2ULL * (brp + 1U) * (3U + ts1 + ts2);
+}
+
+static uint16_t can_time_at(sim_time_t t) {
+    return (uint16_t)((t - s_time_base) / can_bit_cycles());
+}
+
+static int can_running(void) {
+    return (CAN1->MSR & (CAN_MSR_INAK | CAN_MSR_SLAK)) == 0;
+}
+
+static void can_update_irq(void) {
+    uint32_t ier = CAN1->IER;
+    uint32_t tsr = CAN1->TSR;
+    uint32_t rf0 = CAN1->RF0R;
+    uint32_t rf1 = CAN1->RF1R;
+
+    sim_irq_level(USB_HP_CAN1_TX_IRQn,
+                  (ier & CAN_IER_TMEIE) &&
+                      (tsr & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2)));
+    sim_irq_level(USB_LP_CAN1_RX0_IRQn,
+                  ((ier & CAN_IER_FMPIE0) && (rf0 & CAN_RF0R_FMP0)) ||
+                      ((ier & CAN_IER_FFIE0) && (rf0 & CAN_RF0R_FULL0)) ||
+                      ((ier & CAN_IER_FOVIE0) && (rf0 & CAN_RF0R_FOVR0)));
+    sim_irq_level(CAN1_RX1_IRQn,
+                  ((ier & CAN_IER_FMPIE1) && (rf1 & CAN_RF1R_FMP1)) ||
+                      ((ier & CAN_IER_FFIE1) && (rf1 & CAN_RF1R_FULL1)) ||
+                      ((ier & CAN_IER_FOVIE1) && (rf1 & CAN_RF1R_FOVR1)));
+}
+
+/**
+ * @brief  FIFO 状态和输出邮箱寄存器
+ */
+static void can_fifo_publish(int f) {
+    can_fifo_t *fifo = &s_fifo[f];
+    volatile uint32_t *rfr = f ? &CAN1->RF1R : &CAN1->RF0R;
+    uint32_t keep = *rfr & (CAN_RF0R_FULL0 | CAN_RF0R_FOVR0);
+
+    *rfr = keep | fifo->count;
+    if (fifo->count > 0) {
+        CAN1->sFIFOMailBox[f].RIR = fifo->msg[0].rir;
+        CAN1->sFIFOMailBox[f].RDTR = fifo->msg[0].rdtr;
+        CAN1->sFIFOMailBox[f].RDLR = fifo->msg[0].rdlr;
+        CAN1->sFIFOMailBox[f].RDHR = fifo->msg[0].rdhr;
+    }
+}
+
+/**
+ * @brief  TSR 中的 TME / CODE 字段
+ */
+static void can_tsr_publish(void) {
+    uint32_t tsr = CAN1->TSR & ~(CAN_TSR_TME | CAN_TSR_CODE);
+    int code = -1;
+
+    for (int mb = 0; mb < 3; mb++) {
+        if (!s_tx_pending[mb] && s_tx_active != mb) {
+            tsr |= CAN_TSR_TME0 << mb;
+            if (code < 0) {
+                code = mb;
+            }
+        }
+    }
+    CAN1->TSR = tsr | ((uint32_t)(code < 0 ? 0 : code) << CAN_TSR_CODE_Pos);
+}
+
+/**
+ * @brief  32 位过滤器字：STID[31:21] EXID[20:3] IDE[2] RTR[1]
+ */
+static int can_match32(uint32_t w, uint32_t fr1, uint32_t fr2, int list, int *n) {
+    w &= ~1U;
+    if (list) {
+        if (w == (fr1 & ~1U)) {
+            return 1;
+        }
+        (*n)++;
+        if (w == (fr2 & ~1U)) {
+            return 1;
+        }
+        (*n)++;
+        return 0;
+    }
+    if ((w & fr2 & ~1U) == (fr1 & fr2 & ~1U)) {
+        return 1;
+    }
+    (*n)++;
+    return 0;
+}
+
+/**
+ * @brief  16 位过滤器字：STID[15:5] RTR[4] IDE[3] EXID[17:15][2:0]
+ */
+static int can_match16(uint16_t h, uint32_t fr1, uint32_t fr2, int list, int *n) {
+    if (list) {
+        uint16_t ids[4] = {(uint16_t)fr1, (uint16_t)(fr1 >> 16),
+                           (uint16_t)fr2, (uint16_t)(fr2 >> 16)};
+        for (int i = 0; i < 4; i++) {
+            if (h == ids[i]) {
+                return 1;
+            }
+            (*n)++;
+        }
+        return 0;
+    }
+    for (int i = 0; i < 2; i++) {
+        uint32_t fr = i ? fr2 : fr1;
+        uint16_t id = (uint16_t)fr;
+        uint16_t mask = (uint16_t)(fr >> 16);
+        if ((h & mask) == (id & mask)) {
+            return 1;
+        }
+        (*n)++;
+    }
+    return 0;
+}
+
+/**
+ * @brief  验收过滤
+ * @param  fmi: 输出匹配的过滤器编号
+ * @retval FIFO 号，不匹配返回 -1
+ */
+static int can_filter(uint32_t rir, uint32_t *fmi) {
+    uint16_t h = (uint16_t)(((rir >> 21) << 5) | (((rir >> 1) & 1U) << 4) |
+                            (((rir >> 2) & 1U) << 3) | ((rir >> 18) & 7U));
+    int number[2] = {0, 0};
+
+    for (int bank = 0; bank < CAN_FILTER_BANKS; bank++) {
+        uint32_t bit = 1UL << bank;
+        int f = (CAN1->FFA1R & bit) ? 1 : 0;
+        int list = (CAN1->FM1R & bit) != 0;
+        int wide = (CAN1->FS1R & bit) != 0;
+        uint32_t fr1 = CAN1->sFilterRegister[bank].FR1;
+        uint32_t fr2 = CAN1->sFilterRegister[bank].FR2;
+        int n = number[f];
+        int hit;
+
+        if (wide) {
+            hit = can_match32(rir, fr1, fr2, list, &n);
+        } else {
+            hit = can_match16(h, fr1, fr2, list, &n);
+        }
+        if (!(CAN1->FA1R & bit)) {
+            /* 未激活的过滤器同样占用编号 */
+            number[f] += wide ? (list ? 2 : 1) : (list ? 4 : 2);
+            continue;
+        }
+        if (hit) {
+            *fmi = (uint32_t)n;
+            return f;
+        }
+        number[f] += wide ? (list ? 2 : 1) : (list ? 4 : 2);
+    }
+    return -1;
+}
+
+static void can_receive(uint32_t rir, uint32_t dlc, uint32_t rdlr, uint32_t rdhr) {
+    uint32_t fmi = 0;
+    int f;
+    can_fifo_t *fifo;
+    volatile uint32_t *rfr;
+    can_msg_t msg;
+
+    if (CAN1->FMR & CAN_FMR_FINIT) {
+        return;
+    }
+    f = can_filter(rir, &fmi);
+    if (f < 0) {
+        return;
+    }
+    fifo = &s_fifo[f];
+    rfr = f ? &CAN1->RF1R : &CAN1->RF0R;
+
+    msg.rir = rir & ~1U;
+    msg.rdtr = (dlc & 0xFU) | (fmi << CAN_RDT0R_FMI_Pos);
+    if (CAN1->MCR & CAN_MCR_TTCM) {
+        msg.rdtr |= (uint32_t)can_time_at(s_sof) << CAN_RDT0R_TIME_Pos;
+    }
+    msg.rdlr = rdlr;
+    msg.rdhr = rdhr;
+
+    if (fifo->count == CAN_FIFO_DEPTH) {
+        *rfr |= CAN_RF0R_FOVR0;
+        if (!(CAN1->MCR & CAN_MCR_RFLM)) {
+            fifo->msg[CAN_FIFO_DEPTH - 1] = msg;
+        }
+    } else {
+        fifo->msg[fifo->count++] = msg;
+        if (fifo->count == CAN_FIFO_DEPTH) {
+            *rfr |= CAN_RF0R_FULL0;
+        }
+    }
+    can_fifo_publish(f);
+}
+
+/**
+ * @brief  标识符仲裁值，越小优先级越高
+ */
+static uint32_t can_priority(int mb) {
+    uint32_t tir = CAN1->sTxMailBox[mb].TIR;
+    uint32_t id = (tir & CAN_TI0R_IDE) ? (tir >> 3) : ((tir >> 21) << 18);
+
+    return (id << 2) | (tir & (CAN_TI0R_IDE | CAN_TI0R_RTR)) >> 1;
+}
+
+static int can_pick_mailbox(void) {
+    int best = -1;
+
+    for (int mb = 0; mb < 3; mb++) {
+        if (!s_tx_pending[mb]) {
+            continue;
+        }
+        if (best < 0) {
+            best = mb;
+        } else if (CAN1->MCR & CAN_MCR_TXFP) {
+            if (s_tx_order[mb] < s_tx_order[best]) {
+                best = mb;
+            }
+        } else if (can_priority(mb) < can_priority(best)) {
+            best = mb;
+        }
+    }
+    return best;
+}
+
+static void can_schedule(void) {
+    sim_time_t start;
+
+    if (s_tx_active >= 0 || s_tx_ev.armed || !can_running() ||
+        can_pick_mailbox() < 0) {
+        return;
+    }
+    start = sim_now() > s_bus_free ? sim_now() : s_bus_free;
+    sim_event_at(&s_tx_ev, start);
+}
+
+static uint32_t can_frame_bits(uint32_t tir, uint32_t tdtr) {
+    uint32_t dlc = tdtr & 0xFU;
+    uint32_t bytes = (tir & CAN_TI0R_RTR) ? 0U : (dlc > 8U ? 8U : dlc);
+
+    return ((tir & CAN_TI0R_IDE) ? 67U : 47U) + 8U * bytes;
+}
+
+static void can_tx_event(sim_event_t *ev) {
+    (void)ev;
+    if (s_tx_active < 0) {
+        /* 帧起始 */
+        int mb = can_pick_mailbox();
+        if (mb < 0 || !can_running()) {
+            return;
+        }
+        s_tx_active = mb;
+        s_tx_pending[mb] = 0;
+        s_sof = sim_now();
+        if (CAN1->MCR & CAN_MCR_TTCM) {
+            CAN1->sTxMailBox[mb].TDTR = (CAN1->sTxMailBox[mb].TDTR & 0xFFFFU) |
+                                        ((uint32_t)can_time_at(s_sof) << CAN_TDT0R_TIME_Pos);
+        }
+        sim_event_after(&s_tx_ev, can_frame_bits(CAN1->sTxMailBox[mb].TIR,
+                                                 CAN1->sTxMailBox[mb].TDTR) *
+                                      can_bit_cycles());
+        return;
+    }
+
+    /* 帧结束 */
+    int mb = s_tx_active;
+    uint32_t shift = TSR_MB_SHIFT(mb);
+    CAN_TxMailBox_TypeDef *box = &CAN1->sTxMailBox[mb];
+
+    s_tx_active = -1;
+    s_bus_free = sim_now();
+    if (CAN1->BTR & CAN_BTR_LBKM) {
+        can_receive(box->TIR, box->TDTR, box->TDLR, box->TDHR);
+        CAN1->TSR |= (CAN_TSR_RQCP0 | CAN_TSR_TXOK0) << shift;
+        box->TIR &= ~CAN_TI0R_TXRQ;
+    } else {
+        /* 没有节点应答：ACK 错误 */
+        uint32_t esr = CAN1->ESR;
+        uint32_t tec = (esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos;
+
+        if (tec < 128U) {
+            tec += 8U;
+        }
+        esr = (esr & ~(CAN_ESR_TEC | CAN_ESR_LEC)) | (tec << CAN_ESR_TEC_Pos) |
+              (3U << CAN_ESR_LEC_Pos);
+        if (tec >= 96U) {
+            esr |= CAN_ESR_EWGF;
+        }
+        if (tec >= 128U) {
+            esr |= CAN_ESR_EPVF;
+        }
+        CAN1->ESR = esr;
+        if (CAN1->MCR & CAN_MCR_NART) {
+            CAN1->TSR |= (CAN_TSR_RQCP0 | CAN_TSR_TERR0) << shift;
+            box->TIR &= ~CAN_TI0R_TXRQ;
+        } else {
+            s_tx_pending[mb] = 1;
+        }
+    }
+    can_tsr_publish();
+    can_update_irq();
+    can_schedule();
+}
+
+static void can_reset(void) {
+    memset((void *)CAN1, 0, 0x400);
+    CAN1->MCR = 0x00010002U;
+    CAN1->MSR = 0x00000C02U;
+    CAN1->TSR = 0x1C000000U;
+    CAN1->BTR = 0x01230000U;
+    CAN1->FMR = 0x2A1C0E01U;
+    memset(s_tx_pending, 0, sizeof(s_tx_pending));
+    memset(s_fifo, 0, sizeof(s_fifo));
+    s_tx_active = -1;
+    s_bus_free = 0;
+    sim_event_cancel(&s_tx_ev);
+}
+
+static void can_write_mcr(uint32_t val) {
+    uint32_t msr = CAN1->MSR;
+    uint32_t was_init = msr & CAN_MSR_INAK;
+
+    if (val & CAN_MCR_RESET) {
+        can_reset();
+        return;
+    }
+    msr &= ~(CAN_MSR_INAK | CAN_MSR_SLAK);
+    if (val & CAN_MCR_INRQ) {
+        msr |= CAN_MSR_INAK;
+    } else if (val & CAN_MCR_SLEEP) {
+        msr |= CAN_MSR_SLAK;
+    }
+    if (was_init && !(msr & CAN_MSR_INAK)) {
+        s_time_base = sim_now();
+    }
+    CAN1->MSR = msr;
+    if ((msr & CAN_MSR_INAK) && s_tx_active >= 0) {
+        /* 进入初始化模式时中断当前帧，邮箱保持挂起，退出后重新发送 */
+        sim_event_cancel(&s_tx_ev);
+        s_tx_pending[s_tx_active] = 1;
+        s_tx_active = -1;
+    }
+    can_schedule();
+}
+
+static void can_write_tsr(uint32_t val, uint32_t old) {
+    CAN1->TSR = old;
+    for (int mb = 0; mb < 3; mb++) {
+        uint32_t shift = TSR_MB_SHIFT(mb);
+        if (val & (CAN_TSR_RQCP0 << shift)) {
+            CAN1->TSR &= ~(TSR_MB_STATUS << shift);
+        }
+        if ((val & (TSR_MB_ABRQ << shift)) && s_tx_pending[mb]) {
+            s_tx_pending[mb] = 0;
+            CAN1->sTxMailBox[mb].TIR &= ~CAN_TI0R_TXRQ;
+            CAN1->TSR |= CAN_TSR_RQCP0 << shift;
+        }
+    }
+    can_tsr_publish();
+}
+
+static void can_write_rfr(int f, uint32_t val, uint32_t old) {
+    volatile uint32_t *rfr = f ? &CAN1->RF1R : &CAN1->RF0R;
+    can_fifo_t *fifo = &s_fifo[f];
+    uint32_t flags = old & (CAN_RF0R_FULL0 | CAN_RF0R_FOVR0);
+
+    flags &= ~(val & (CAN_RF0R_FULL0 | CAN_RF0R_FOVR0));
+    *rfr = flags | fifo->count;
+    if ((val & CAN_RF0R_RFOM0) && fifo->count > 0) {
+        memmove(&fifo->msg[0], &fifo->msg[1], sizeof(can_msg_t) * (CAN_FIFO_DEPTH - 1));
+        fifo->count--;
+        *rfr &= ~CAN_RF0R_FULL0;
+    }
+    can_fifo_publish(f);
+}
+
+static void can_write(uint32_t off, uint32_t val, uint32_t old) {
+    if (off == OFF_MCR) {
+        can_write_mcr(val);
+    } else if (off == OFF_MSR) {
+        /* ERRI / WKUI / SLAKI 写 1 清除，其余只读 */
+        CAN1->MSR = old & ~(val & (CAN_MSR_ERRI | CAN_MSR_WKUI | CAN_MSR_SLAKI));
+    } else if (off == OFF_TSR) {
+        can_write_tsr(val, old);
+    } else if (off == OFF_RF0R || off == OFF_RF1R) {
+        can_write_rfr(off == OFF_RF1R, val, old);
+    } else if (off == OFF_ESR) {
+        /* 只有 LEC 可写 */
+        CAN1->ESR = (old & ~CAN_ESR_LEC) | (val & CAN_ESR_LEC);
+    } else if (off == OFF_BTR) {
+        if (!(CAN1->MSR & CAN_MSR_INAK)) {
+            CAN1->BTR = old;
+        }
+    } else if (off >= OFF_TX_FIRST && off < OFF_TX_END) {
+        int mb = (int)((off - OFF_TX_FIRST) / 0x10U);
+        if ((off & 0xFU) == 0U && (val & CAN_TI0R_TXRQ) && !(old & CAN_TI0R_TXRQ)) {
+            s_tx_pending[mb] = 1;
+            s_tx_order[mb] = s_order_seq++;
+            CAN1->TSR &= ~(TSR_MB_STATUS << TSR_MB_SHIFT(mb));
+            can_tsr_publish();
+            can_schedule();
+        }
+    } else if (off >= OFF_TX_END && off < OFF_FMR) {
+        /* 接收邮箱只读 */
+        *(volatile uint32_t *)((uintptr_t)CAN1 + off) = old;
+    }
+    can_update_irq();
+}
+
+static const sim_periph_t s_can1_model = {
+    .name = "CAN1",
+    .base = CAN1_BASE,
+    .size = 0x400,
+    .reset = can_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = can_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_can_init(void) {
+    sim_event_init(&s_tx_ev, can_tx_event, NULL);
+    sim_register(&s_can1_model);
+}
+
+/************************ END OF FILE *****************************************/
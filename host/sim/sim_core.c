@@ -0,0 +1,577 @@
+/**
+ * @file    sim_core.c
+ * @brief   仿真器核心：地址映射、虚拟时钟、事件队列和 __tsan_* 访问钩子
+ * @date    2026-10-18
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include "sim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+/** 外设查找表粒度：1KB（所有外设基址都按 1KB 对齐） */
+#define SIM_SLOT_SHIFT 10
+
+#define SIM_MAX_PERIPHS 48
+
+/** 额外映射的区间：Flash、系统存储区（UID / 容量）、SRAM 别名 */
+#define SIM_FLASH_BASE 0x08000000UL
+#define SIM_FLASH_SIZE 0x00080000UL
+#define SIM_SYSMEM_BASE 0x1FFFF000UL
+#define SIM_SYSMEM_SIZE 0x00001000UL
+#define SIM_SRAM_BASE 0x20000000UL
+#define SIM_SRAM_SIZE 0x00010000UL
+
+/** 外设位带别名区：别名字 n 对应 SIM_PERIPH_BASE 起第 n / 32 字的第 n % 32 位 */
+#define SIM_BITBAND_BASE 0x42000000UL
+#define SIM_BITBAND_SIZE (SIM_PERIPH_SIZE * 32UL)
+
+/* Private types -------------------------------------------------------------*/
+
+/** 挂起的访问：写在下一次钩子里提交，读在下一次钩子里处理读清除 */
+typedef struct {
+    const sim_periph_t *p;
+    uint32_t off;
+    uint32_t old;
+    uintptr_t alias; /* 位带写的别名地址 */
+    uint8_t kind;    /* 0: 无, 1: 写, 2: 读, 3: 位带写 */
+} sim_pending_t;
+
+/* Private variables ---------------------------------------------------------*/
+static sim_time_t s_now = 0;
+static sim_time_t s_next_event = UINT64_MAX;
+static sim_event_t *s_events = NULL;
+static sim_pending_t s_pending;
+
+static const sim_periph_t *s_periph_slot[SIM_PERIPH_SIZE >> SIM_SLOT_SHIFT];
+static const sim_periph_t *s_core_slot[SIM_CORE_SIZE >> SIM_SLOT_SHIFT];
+static const sim_periph_t *s_periphs[SIM_MAX_PERIPHS];
+static int s_periph_count = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  地址所属的外设模型，非外设区返回 NULL
+ */
+static inline const sim_periph_t *sim_lookup(uintptr_t a) {
+    if (a - SIM_PERIPH_BASE < SIM_PERIPH_SIZE) {
+        return s_periph_slot[(a - SIM_PERIPH_BASE) >> SIM_SLOT_SHIFT];
+    }
+    if (a - SIM_CORE_BASE < SIM_CORE_SIZE) {
+        return s_core_slot[(a - SIM_CORE_BASE) >> SIM_SLOT_SHIFT];
+    }
+    return NULL;
+}
+
+/**
+ * @brief  提交挂起的访问
+ */
+static void sim_flush(void) {
+    sim_pending_t p = s_pending;
+
+    s_pending.kind = 0;
+    if (p.kind == 3) {
+        /* 位带写：把别名字的最低位合并进目标字 */
+        volatile uint32_t *word = (volatile uint32_t *)(uintptr_t)(p.p->base + p.off);
+        uint32_t bit = 1UL << (((p.alias - SIM_BITBAND_BASE) >> 2) & 31U);
+        uint32_t val = (*(volatile uint32_t *)p.alias & 1U) ? (p.old | bit) : (p.old & ~bit);
+
+        *word = val;
+        if (p.p->write != NULL) {
+            p.p->write(p.off, val, p.old);
+        }
+    } else if (p.kind == 1) {
+        uint32_t val = *(volatile uint32_t *)(uintptr_t)(p.p->base + p.off);
+        p.p->write(p.off, val, p.old);
+    } else {
+        p.p->read_done(p.off);
+    }
+}
+
+/**
+ * @brief  执行所有到期事件
+ */
+static void sim_run_events(void) {
+    while (s_events != NULL && s_events->when <= s_now) {
+        sim_event_t *ev = s_events;
+
+        s_events = ev->next;
+        ev->next = NULL;
+        ev->armed = 0;
+        s_next_event = s_events ? s_events->when : UINT64_MAX;
+        ev->fn(ev);
+    }
+    s_next_event = s_events ? s_events->when : UINT64_MAX;
+}
+
+/**
+ * @brief  每次钩子的公共步骤：提交挂起访问 → 推进时钟 → 事件 → 中断
+ */
+static inline void sim_step(uint32_t cycles) {
+    if (s_pending.kind != 0) {
+        sim_flush();
+    }
+    s_now += cycles;
+    if (s_now >= s_next_event) {
+        sim_run_events();
+    }
+    if (sim_irq_dirty) {
+        sim_irq_check();
+    }
+}
+
+/**
+ * @brief  位带别名地址对应的外设字地址
+ */
+static inline uintptr_t sim_bitband_word(uintptr_t a) {
+    return SIM_PERIPH_BASE + (((a - SIM_BITBAND_BASE) >> 5) & ~(uintptr_t)3);
+}
+
+/**
+ * @brief  位带读：别名字填入目标位的值
+ */
+static void sim_bitband_read(uintptr_t a) {
+    uintptr_t w = sim_bitband_word(a);
+    const sim_periph_t *p = sim_lookup(w);
+    uint32_t bit = ((a - SIM_BITBAND_BASE) >> 2) & 31U;
+
+    sim_step(SIM_CYCLES_PERIPH);
+    if (p != NULL && p->read != NULL) {
+        p->read((uint32_t)w - p->base);
+    }
+    *(volatile uint32_t *)(a & ~(uintptr_t)3) = (*(volatile uint32_t *)w >> bit) & 1U;
+    if (p != NULL && p->read_done != NULL) {
+        s_pending.p = p;
+        s_pending.off = (uint32_t)w - p->base;
+        s_pending.kind = 2;
+    }
+}
+
+/**
+ * @brief  位带写：目标字的读-改-写推迟到下一次钩子
+ */
+static void sim_bitband_write(uintptr_t a) {
+    uintptr_t w = sim_bitband_word(a);
+    const sim_periph_t *p = sim_lookup(w);
+
+    sim_step(SIM_CYCLES_PERIPH);
+    if (p == NULL) {
+        sim_fatal("bit-band write to unmodelled address 0x%08lX", (unsigned long)w);
+    }
+    s_pending.p = p;
+    s_pending.off = (uint32_t)w - p->base;
+    s_pending.old = *(volatile uint32_t *)w;
+    s_pending.alias = a & ~(uintptr_t)3;
+    s_pending.kind = 3;
+}
+
+/**
+ * @brief  volatile 读：外设寄存器先由模型准备好值
+ */
+static inline void sim_volatile_read(void *addr) {
+    uintptr_t a = (uintptr_t)addr;
+    const sim_periph_t *p = sim_lookup(a);
+
+    if (a - SIM_BITBAND_BASE < SIM_BITBAND_SIZE) {
+        sim_bitband_read(a);
+        return;
+    }
+    if (p == NULL) {
+        sim_step(SIM_CYCLES_ACCESS);
+        return;
+    }
+    sim_step(SIM_CYCLES_PERIPH);
+
+    uint32_t off = (uint32_t)(a & ~(uintptr_t)3) - p->base;
+    if (p->read != NULL) {
+        p->read(off);
+    }
+    if (p->read_done != NULL) {
+        s_pending.p = p;
+        s_pending.off = off;
+        s_pending.kind = 2;
+    }
+}
+
+/**
+ * @brief  volatile 写：记录旧值，写入后的处理推迟到下一次钩子
+ */
+static inline void sim_volatile_write(void *addr) {
+    uintptr_t a = (uintptr_t)addr;
+    const sim_periph_t *p = sim_lookup(a);
+
+    if (a - SIM_BITBAND_BASE < SIM_BITBAND_SIZE) {
+        sim_bitband_write(a);
+        return;
+    }
+    if (p == NULL) {
+        sim_step(SIM_CYCLES_ACCESS);
+        return;
+    }
+    sim_step(SIM_CYCLES_PERIPH);
+
+    if (p->write != NULL) {
+        uintptr_t w = a & ~(uintptr_t)3;
+        s_pending.p = p;
+        s_pending.off = (uint32_t)w - p->base;
+        s_pending.old = *(volatile uint32_t *)w;
+        s_pending.kind = 1;
+    }
+}
+
+/**
+ * @brief  在固定地址映射一段匿名内存
+ */
+static void sim_map(uint32_t base, uint32_t size, uint8_t fill) {
+    void *want = (void *)(uintptr_t)base;
+    void *got = mmap(want, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (got != want) {
+        sim_fatal("cannot map 0x%08lX (+0x%lX)", (unsigned long)base,
+                  (unsigned long)size);
+    }
+    if (fill != 0) {
+        memset(got, fill, size);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  映射所有地址区间并初始化全部外设模型
+ */
+void sim_init(void) {
+    sim_map(SIM_PERIPH_BASE, SIM_PERIPH_SIZE, 0);
+    sim_map(SIM_CORE_BASE, SIM_CORE_SIZE, 0);
+    sim_map(SIM_FLASH_BASE, SIM_FLASH_SIZE, 0xFF);
+    sim_map(SIM_SYSMEM_BASE, SIM_SYSMEM_SIZE, 0xFF);
+    sim_map(SIM_SRAM_BASE, SIM_SRAM_SIZE, 0);
+    sim_map(SIM_BITBAND_BASE, SIM_BITBAND_SIZE, 0);
+
+    /* 512KB Flash 容量和 96 位唯一 ID */
+    *(volatile uint16_t *)(uintptr_t)FLASHSIZE_BASE = 512;
+    *(volatile uint32_t *)(uintptr_t)(UID_BASE + 0) = 0x066DFF35U;
+    *(volatile uint32_t *)(uintptr_t)(UID_BASE + 4) = 0x3435504DU;
+    *(volatile uint32_t *)(uintptr_t)(UID_BASE + 8) = 0x43097128U;
+
+    sim_nvic_init();
+    sim_rcc_init();
+    sim_gpio_init();
+    sim_exti_init();
+    sim_dma_init();
+    sim_spi_init();
+    sim_i2c_init();
+    sim_usart_init();
+    sim_can_init();
+    sim_tim_init();
+    sim_crc_init();
+    sim_adc_init();
+    sim_dac_init();
+    sim_w25q32_init();
+    sim_w24c02_init();
+
+    sim_reset_all();
+}
+
+/**
+ * @brief  登记外设模型
+ */
+void sim_register(const sim_periph_t *p) {
+    uint32_t first = p->base >> SIM_SLOT_SHIFT;
+    uint32_t last = (p->base + p->size - 1) >> SIM_SLOT_SHIFT;
+
+    if (s_periph_count >= SIM_MAX_PERIPHS) {
+        sim_fatal("too many peripheral models");
+    }
+    s_periphs[s_periph_count++] = p;
+
+    for (uint32_t s = first; s <= last; s++) {
+        uint32_t addr = s << SIM_SLOT_SHIFT;
+        if (addr - SIM_PERIPH_BASE < SIM_PERIPH_SIZE) {
+            s_periph_slot[(addr - SIM_PERIPH_BASE) >> SIM_SLOT_SHIFT] = p;
+        } else if (addr - SIM_CORE_BASE < SIM_CORE_SIZE) {
+            s_core_slot[(addr - SIM_CORE_BASE) >> SIM_SLOT_SHIFT] = p;
+        } else {
+            sim_fatal("%s outside mapped regions", p->name);
+        }
+    }
+}
+
+/**
+ * @brief  所有外设恢复复位值
+ */
+void sim_reset_all(void) {
+    for (int i = 0; i < s_periph_count; i++) {
+        if (s_periphs[i]->reset != NULL) {
+            s_periphs[i]->reset();
+        }
+    }
+}
+
+/**
+ * @brief  当前虚拟时间（CPU 周期）
+ */
+sim_time_t sim_now(void) {
+    return s_now;
+}
+
+/**
+ * @brief  推进时钟（与一次访问钩子的处理相同）
+ */
+void sim_advance(uint64_t cycles) {
+    sim_step((uint32_t)cycles);
+}
+
+/**
+ * @brief  只提交挂起的访问（中断返回时调用）
+ */
+void sim_sync(void) {
+    if (s_pending.kind != 0) {
+        sim_flush();
+    }
+}
+
+/**
+ * @brief  计入周期但不处理事件（异常进入 / 退出开销）
+ */
+void sim_charge(uint32_t cycles) {
+    s_now += cycles;
+}
+
+/**
+ * @brief  WFI：没有待处理中断时直接跳到下一个事件
+ */
+void sim_idle(void) {
+    if (s_pending.kind != 0) {
+        sim_flush();
+    }
+    while (!sim_irq_deliverable()) {
+        if (s_events == NULL) {
+            sim_fatal("WFI with no pending interrupt or timer event");
+        }
+        if (s_now < s_next_event) {
+            s_now = s_next_event;
+        }
+        sim_run_events();
+    }
+    sim_irq_check();
+}
+
+/**
+ * @brief  初始化事件
+ */
+void sim_event_init(sim_event_t *ev, void (*fn)(sim_event_t *ev), void *arg) {
+    memset(ev, 0, sizeof(*ev));
+    ev->fn = fn;
+    ev->arg = arg;
+}
+
+/**
+ * @brief  在指定时刻触发事件（已在队列中则先移除）
+ */
+void sim_event_at(sim_event_t *ev, sim_time_t when) {
+    sim_event_t **pp = &s_events;
+
+    sim_event_cancel(ev);
+    ev->when = when;
+    while (*pp != NULL && (*pp)->when <= when) {
+        pp = &(*pp)->next;
+    }
+    ev->next = *pp;
+    *pp = ev;
+    ev->armed = 1;
+    s_next_event = s_events->when;
+}
+
+/**
+ * @brief  在当前时刻之后若干周期触发事件
+ */
+void sim_event_after(sim_event_t *ev, uint64_t cycles) {
+    sim_event_at(ev, s_now + cycles);
+}
+
+/**
+ * @brief  取消事件
+ */
+void sim_event_cancel(sim_event_t *ev) {
+    sim_event_t **pp = &s_events;
+
+    if (!ev->armed) {
+        return;
+    }
+    while (*pp != NULL && *pp != ev) {
+        pp = &(*pp)->next;
+    }
+    if (*pp == ev) {
+        *pp = ev->next;
+    }
+    ev->next = NULL;
+    ev->armed = 0;
+    s_next_event = s_events ? s_events->when : UINT64_MAX;
+}
+
+/**
+ * @brief  总线读（DMA 使用）：外设地址经过模型处理
+ * @param  error: 地址无效时置 1
+ */
+uint32_t sim_bus_read(uint32_t addr, uint32_t size, int *error) {
+    const sim_periph_t *p = sim_lookup(addr);
+    uint32_t off = 0;
+    uint32_t v;
+
+    if (addr < 0x1000U) {
+        *error = 1;
+        return 0;
+    }
+    if (p != NULL) {
+        off = (addr & ~3U) - p->base;
+        if (p->read != NULL) {
+            p->read(off);
+        }
+    }
+    if (size == 4) {
+        v = *(volatile uint32_t *)(uintptr_t)addr;
+    } else if (size == 2) {
+        v = *(volatile uint16_t *)(uintptr_t)addr;
+    } else {
+        v = *(volatile uint8_t *)(uintptr_t)addr;
+    }
+    if (p != NULL && p->read_done != NULL) {
+        p->read_done(off);
+    }
+    return v;
+}
+
+/**
+ * @brief  总线写（DMA 使用）
+ */
+void sim_bus_write(uint32_t addr, uint32_t size, uint32_t value, int *error) {
+    const sim_periph_t *p = sim_lookup(addr);
+    uint32_t word = addr & ~3U;
+    uint32_t old = 0;
+
+    if (addr < 0x1000U) {
+        *error = 1;
+        return;
+    }
+    if (p != NULL) {
+        old = *(volatile uint32_t *)(uintptr_t)word;
+    }
+    if (size == 4) {
+        *(volatile uint32_t *)(uintptr_t)addr = value;
+    } else if (size == 2) {
+        *(volatile uint16_t *)(uintptr_t)addr = (uint16_t)value;
+    } else {
+        *(volatile uint8_t *)(uintptr_t)addr = (uint8_t)value;
+    }
+    if (p != NULL && p->write != NULL) {
+        p->write(word - p->base, *(volatile uint32_t *)(uintptr_t)word, old);
+    }
+}
+
+/**
+ * @brief  致命错误：打印虚拟时间后退出
+ */
+void sim_fatal(const char *fmt, ...) {
+    va_list ap;
+
+    fflush(NULL);
+    fprintf(stderr, "[SIM] FATAL @%llu cycles: ",
+            (unsigned long long)s_now);
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fprintf(stderr, "\n");
+    exit(2);
+}
+
+/* 编译器插入的访问钩子 -------------------------------------------------------*/
+
+void __tsan_init(void) {}
+
+void __tsan_func_entry(void *pc) {
+    (void)pc;
+    sim_step(SIM_CYCLES_CALL);
+}
+
+void __tsan_func_exit(void) {
+    sim_step(0);
+}
+
+/* RAMFUNC 函数所在的段，链接器生成起止符号；没有 RAMFUNC 时为空 */
+extern const char __start_sim_ramfunc[] __attribute__((weak));
+extern const char __stop_sim_ramfunc[] __attribute__((weak));
+
+/* -fsanitize-coverage=trace-pc：每个基本块入口
+ * 基本块入口就是跳转目标，预取缓冲区里没有，从 Flash 取指要等
+ * FLASH_ACR.LATENCY 个周期；RAMFUNC 中的代码从 SRAM 取指，不等待 */
+void __sanitizer_cov_trace_pc(void) {
+    const char *pc = __builtin_return_address(0);
+    uint32_t wait = sim_flash_wait;
+
+    if (pc >= __start_sim_ramfunc && pc < __stop_sim_ramfunc) {
+        wait = 0;
+    }
+    sim_step(SIM_CYCLES_BLOCK + wait);
+}
+
+#define SIM_PLAIN_HOOK(name)                                                   \
+    void name(void *addr) {                                                    \
+        (void)addr;                                                            \
+        sim_step(SIM_CYCLES_ACCESS);                                           \
+    }
+
+SIM_PLAIN_HOOK(__tsan_read1)
+SIM_PLAIN_HOOK(__tsan_read2)
+SIM_PLAIN_HOOK(__tsan_read4)
+SIM_PLAIN_HOOK(__tsan_read8)
+SIM_PLAIN_HOOK(__tsan_read16)
+SIM_PLAIN_HOOK(__tsan_write1)
+SIM_PLAIN_HOOK(__tsan_write2)
+SIM_PLAIN_HOOK(__tsan_write4)
+SIM_PLAIN_HOOK(__tsan_write8)
+SIM_PLAIN_HOOK(__tsan_write16)
+SIM_PLAIN_HOOK(__tsan_unaligned_read2)
+SIM_PLAIN_HOOK(__tsan_unaligned_read4)
+SIM_PLAIN_HOOK(__tsan_unaligned_read8)
+SIM_PLAIN_HOOK(__tsan_unaligned_read16)
+SIM_PLAIN_HOOK(__tsan_unaligned_write2)
+SIM_PLAIN_HOOK(__tsan_unaligned_write4)
+SIM_PLAIN_HOOK(__tsan_unaligned_write8)
+SIM_PLAIN_HOOK(__tsan_unaligned_write16)
+
+void __tsan_read_range(void *addr, size_t size) {
+    (void)addr;
+    sim_step(SIM_CYCLES_ACCESS + (uint32_t)(size / 4));
+}
+
+void __tsan_write_range(void *addr, size_t size) {
+    (void)addr;
+    sim_step(SIM_CYCLES_ACCESS + (uint32_t)(size / 4));
+}
+
+#define SIM_VOLATILE_HOOKS(n)                                                  \
+    void __tsan_volatile_read##n(void *addr) { sim_volatile_read(addr); }      \
+    void __tsan_volatile_write##n(void *addr) { sim_volatile_write(addr); }    \
+    void __tsan_unaligned_volatile_read##n(void *addr) {                       \
+        sim_volatile_read(addr);                                               \
+    }                                                                          \
+    void __tsan_unaligned_volatile_write##n(void *addr) {                      \
+        sim_volatile_write(addr);                                              \
+    }
+
+SIM_VOLATILE_HOOKS(1)
+SIM_VOLATILE_HOOKS(2)
+SIM_VOLATILE_HOOKS(4)
+SIM_VOLATILE_HOOKS(8)
+SIM_VOLATILE_HOOKS(16)
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,74 @@
+/**
+ * @file    sim_crc.c
+ * @brief   CRC 计算单元模型
+ * @date    2026-10-18
+ *
+ * @note    - CRC-32/MPEG-2：多项式 0x04C11DB7，初值 0xFFFFFFFF，不反转，
+ *            无结果异或；
+ *          - 写 DR 的 32 位数据从最高位开始移入，之后读 DR 得到结果；
+ *          - CR.RESET 把 DR 恢复为 0xFFFFFFFF，该位读出始终为 0；
+ *          - IDR 是与计算无关的 8 位暂存寄存器，RESET 不影响它。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_DR 0x00U
+#define OFF_IDR 0x04U
+#define OFF_CR 0x08U
+
+#define CRC_POLY 0x04C11DB7U
+
+/* Private functions ---------------------------------------------------------*/
+
+static void crc_reset(void) {
+    memset((void *)CRC, 0, 0x400);
+    CRC->DR = 0xFFFFFFFFU;
+}
+
+static void crc_write(uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case OFF_DR: {
+        uint32_t crc = old ^ val;
+        for (int i = 0; i < 32; i++) {
+            crc = (crc & 0x80000000U) ? (crc << 1) ^ CRC_POLY : (crc << 1);
+        }
+        CRC->DR = crc;
+        break;
+    }
+    case OFF_IDR:
+        /* IDR 只有低 8 位，其余为保留位 */
+        *(volatile uint32_t *)&CRC->IDR = val & CRC_IDR_IDR;
+        break;
+    case OFF_CR:
+        if (val & CRC_CR_RESET) {
+            CRC->DR = 0xFFFFFFFFU;
+        }
+        CRC->CR = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+static const sim_periph_t s_crc_model = {
+    .name = "CRC",
+    .base = CRC_BASE,
+    .size = 0x400,
+    .reset = crc_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = crc_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_crc_init(void) {
+    sim_register(&s_crc_model);
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,216 @@
+/**
+ * @file    sim_dac.c
+ * @brief   DAC 双通道模型（触发、DMA 请求、输出日志）
+ * @date    2026-10-18
+ *
+ * @note    - 写 DHR12Rx / DHR12Lx / DHR8Rx 及双通道 DHRxxD 更新通道的数据
+ *            保持值；TENx = 0 时立即装入 DORx，TENx = 1 时等触发；
+ *          - 触发：TSELx 选中的定时器 TRGO（sim_dac_trigger，TIM6 = 0，
+ *            TIM7 = 2，TIM2 = 4），或 TSELx = 111 时写 SWTRIGR；触发时
+ *            DHR 装入 DOR，DMAENx = 1 则向 DMA2 通道 3 / 4 发出一次请求，
+ *            DMA 写入的是下一次触发的值；
+ *          - 每次 DOR 更新记入日志（值和虚拟时刻），测试用 sim_dac_log
+ *            取出；WAVEx 噪声 / 三角波发生器和输出电压不建模。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_CR 0x00U
+#define OFF_SWTRIGR 0x04U
+#define OFF_DHR12R1 0x08U
+#define OFF_DHR12L1 0x0CU
+#define OFF_DHR8R1 0x10U
+#define OFF_DHR12R2 0x14U
+#define OFF_DHR12L2 0x18U
+#define OFF_DHR8R2 0x1CU
+#define OFF_DHR12RD 0x20U
+#define OFF_DHR12LD 0x24U
+#define OFF_DHR8RD 0x28U
+
+#define DAC_CHANNELS 2
+#define DAC_TSEL_SW 7U
+#define DAC_LOG_LEN 4096U
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  输出日志（环形，满时覆盖最旧的）
+ */
+typedef struct {
+    uint16_t value[DAC_LOG_LEN];
+    sim_time_t when[DAC_LOG_LEN];
+    uint32_t head;
+    uint32_t count;
+} dac_log_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint16_t s_dhr[DAC_CHANNELS];
+static dac_log_t s_log[DAC_CHANNELS];
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  通道 ch 的 CR 字段（通道 2 在高 16 位）
+ */
+static uint32_t dac_cr(int ch) {
+    return (DAC->CR >> (16 * ch)) & 0xFFFFU;
+}
+
+/**
+ * @brief  DHR 装入 DOR 并记入日志
+ * @param  when: 更新时刻（定时器触发取更新事件本身的时刻）
+ */
+static void dac_output(int ch, sim_time_t when) {
+    dac_log_t *log = &s_log[ch];
+
+    if (ch == 0) {
+        DAC->DOR1 = s_dhr[0];
+    } else {
+        DAC->DOR2 = s_dhr[1];
+    }
+    log->value[log->head] = s_dhr[ch];
+    log->when[log->head] = when;
+    log->head = (log->head + 1U) % DAC_LOG_LEN;
+    if (log->count < DAC_LOG_LEN) {
+        log->count++;
+    }
+}
+
+/**
+ * @brief  一次触发：输出，并请求 DMA 送来下一个值
+ */
+static void dac_fire(int ch, sim_time_t when) {
+    dac_output(ch, when);
+    if (dac_cr(ch) & DAC_CR_DMAEN1) {
+        sim_dma_pulse(SIM_DMA_CH(2, 3 + ch));
+    }
+}
+
+/**
+ * @brief  数据保持值更新
+ */
+static void dac_hold(int ch, uint32_t value) {
+    uint32_t cr = dac_cr(ch);
+
+    s_dhr[ch] = (uint16_t)(value & 0x0FFFU);
+    if ((cr & DAC_CR_EN1) && !(cr & DAC_CR_TEN1)) {
+        dac_output(ch, sim_now());
+    }
+}
+
+static void dac_reset(void) {
+    memset((void *)DAC, 0, 0x400);
+    memset(s_dhr, 0, sizeof(s_dhr));
+    memset(s_log, 0, sizeof(s_log));
+}
+
+static void dac_write(uint32_t off, uint32_t val, uint32_t old) {
+    (void)old;
+
+    switch (off) {
+    case OFF_SWTRIGR:
+        for (int ch = 0; ch < DAC_CHANNELS; ch++) {
+            uint32_t cr = dac_cr(ch);
+            if ((val & (1U << ch)) && (cr & DAC_CR_EN1) && (cr & DAC_CR_TEN1) &&
+                ((cr & DAC_CR_TSEL1) >> DAC_CR_TSEL1_Pos) == DAC_TSEL_SW) {
+                dac_fire(ch, sim_now());
+            }
+        }
+        DAC->SWTRIGR = 0;
+        break;
+    case OFF_DHR12R1:
+        dac_hold(0, val);
+        break;
+    case OFF_DHR12L1:
+        dac_hold(0, val >> 4);
+        break;
+    case OFF_DHR8R1:
+        dac_hold(0, (val & 0xFFU) << 4);
+        break;
+    case OFF_DHR12R2:
+        dac_hold(1, val);
+        break;
+    case OFF_DHR12L2:
+        dac_hold(1, val >> 4);
+        break;
+    case OFF_DHR8R2:
+        dac_hold(1, (val & 0xFFU) << 4);
+        break;
+    case OFF_DHR12RD:
+        dac_hold(0, val);
+        dac_hold(1, val >> 16);
+        break;
+    case OFF_DHR12LD:
+        dac_hold(0, val >> 4);
+        dac_hold(1, val >> 20);
+        break;
+    case OFF_DHR8RD:
+        dac_hold(0, (val & 0xFFU) << 4);
+        dac_hold(1, ((val >> 8) & 0xFFU) << 4);
+        break;
+    default:
+        break;
+    }
+}
+
+static const sim_periph_t s_dac_model = {
+    .name = "DAC",
+    .base = DAC_BASE,
+    .size = 0x400,
+    .reset = dac_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = dac_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_dac_init(void) {
+    sim_register(&s_dac_model);
+}
+
+/**
+ * @brief  定时器 TRGO：tsel 为 DAC 的 TSEL 编号，when 为更新事件的时刻
+ */
+void sim_dac_trigger(int tsel, sim_time_t when) {
+    for (int ch = 0; ch < DAC_CHANNELS; ch++) {
+        uint32_t cr = dac_cr(ch);
+        if ((cr & DAC_CR_EN1) && (cr & DAC_CR_TEN1) &&
+            ((cr & DAC_CR_TSEL1) >> DAC_CR_TSEL1_Pos) == (uint32_t)tsel) {
+            dac_fire(ch, when);
+        }
+    }
+}
+
+/**
+ * @brief  取出通道 ch（1 / 2）记录的输出值和时刻，从最旧的开始
+ * @param  when: 输出时刻（CPU 周期），可为 NULL
+ * @retval 取出的个数
+ */
+int sim_dac_log(int ch, uint16_t *value, uint64_t *when, int max) {
+    dac_log_t *log;
+    int n = 0;
+
+    if (ch < 1 || ch > DAC_CHANNELS) {
+        return 0;
+    }
+    log = &s_log[ch - 1];
+    while (n < max && log->count > 0U) {
+        uint32_t i = (log->head + DAC_LOG_LEN - log->count) % DAC_LOG_LEN;
+        value[n] = log->value[i];
+        if (when != NULL) {
+            when[n] = log->when[i];
+        }
+        n++;
+        log->count--;
+    }
+    return n;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,320 @@
+/**
+ * @file    sim_dma.c
+ * @brief   DMA1 (7 通道) / DMA2 (5 通道) 模型
+ * @date    2026-10-18
+ *
+ * @note    - EN 置位时锁存 CPAR / CMAR / CNDTR，之后每个数据单元一次总线传输，
+ *            外设地址经过对应外设模型，因此 DMA 读写 SPI1->DR 等寄存器的
+ *            副作用与 CPU 访问一致；
+ *          - 所有通道共用一个传输引擎事件，每个单元约 DMA_UNIT_CYCLES 周期，
+ *            就绪通道按 PL 仲裁，同优先级通道号小的优先；
+ *          - MEM2MEM 通道始终有请求，其余通道由外设模型用
+ *            sim_dma_request（电平）或 sim_dma_pulse（单次）提出请求。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define DMA_UNIT_CYCLES 6U
+
+#define OFF_ISR 0x00U
+#define OFF_IFCR 0x04U
+#define OFF_CH_FIRST 0x08U
+#define CH_STRIDE 0x14U
+#define CH_CCR 0x00U
+#define CH_CNDTR 0x04U
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    DMA_TypeDef *dma;
+    DMA_Channel_TypeDef *regs;
+    uint8_t shift;      /* 在 ISR 中的位置 */
+    uint8_t irqn;
+    uint16_t total;     /* 锁存的 CNDTR */
+    uint16_t index;     /* 已传输单元数 */
+    uint32_t par;
+    uint32_t mar;
+    uint32_t request;   /* 请求电平（各外设位相或） */
+    uint8_t pulse;      /* 单次请求 */
+} dma_chan_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static dma_chan_t s_ch[SIM_DMA_CHANNELS];
+static sim_event_t s_engine;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline int ch_ready(const dma_chan_t *c) {
+    uint32_t ccr = c->regs->CCR;
+
+    if (!(ccr & DMA_CCR_EN) || c->regs->CNDTR == 0) {
+        return 0;
+    }
+    return (ccr & DMA_CCR_MEM2MEM) || c->request != 0 || c->pulse != 0;
+}
+
+/**
+ * @brief  按 PL 和通道号仲裁出下一个要服务的通道
+ */
+static dma_chan_t *dma_arbitrate(void) {
+    dma_chan_t *best = NULL;
+    uint32_t best_pl = 0;
+
+    for (int i = 0; i < SIM_DMA_CHANNELS; i++) {
+        dma_chan_t *c = &s_ch[i];
+        if (ch_ready(c)) {
+            uint32_t pl = (c->regs->CCR & DMA_CCR_PL) >> DMA_CCR_PL_Pos;
+            if (best == NULL || pl > best_pl) {
+                best = c;
+                best_pl = pl;
+            }
+        }
+    }
+    return best;
+}
+
+static void dma_kick(void) {
+    if (!s_engine.armed && dma_arbitrate() != NULL) {
+        sim_event_after(&s_engine, DMA_UNIT_CYCLES);
+    }
+}
+
+/**
+ * @brief  根据标志和中断使能更新中断线
+ */
+static void dma_update_irq(const dma_chan_t *c) {
+    uint32_t level = 0;
+
+    for (int i = 0; i < SIM_DMA_CHANNELS; i++) {
+        const dma_chan_t *o = &s_ch[i];
+        if (o->irqn == c->irqn) {
+            uint32_t flags = (o->dma->ISR >> o->shift) & 0xEU;
+            uint32_t ie = o->regs->CCR & (DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+            level |= flags & ie;
+        }
+    }
+    sim_irq_level(c->irqn, level != 0);
+}
+
+static void dma_set_flags(dma_chan_t *c, uint32_t flags) {
+    c->dma->ISR |= (flags | DMA_ISR_GIF1) << c->shift;
+    dma_update_irq(c);
+}
+
+static uint32_t unit_size(uint32_t field) {
+    return (field == 0U) ? 1U : (field == 1U) ? 2U : 4U;
+}
+
+/**
+ * @brief  传输一个数据单元
+ */
+static void dma_transfer(dma_chan_t *c) {
+    uint32_t ccr = c->regs->CCR;
+    uint32_t psize = unit_size((ccr & DMA_CCR_PSIZE) >> DMA_CCR_PSIZE_Pos);
+    uint32_t msize = unit_size((ccr & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+    uint32_t paddr = c->par + ((ccr & DMA_CCR_PINC) ? c->index * psize : 0U);
+    uint32_t maddr = c->mar + ((ccr & DMA_CCR_MINC) ? c->index * msize : 0U);
+    uint32_t src, src_size, dst, dst_size, value;
+    uint16_t remaining;
+    int error = 0;
+
+    if (ccr & DMA_CCR_DIR) {
+        src = maddr, src_size = msize, dst = paddr, dst_size = psize;
+    } else {
+        src = paddr, src_size = psize, dst = maddr, dst_size = msize;
+    }
+
+    c->pulse = 0;
+    value = sim_bus_read(src, src_size, &error);
+    if (!error) {
+        sim_bus_write(dst, dst_size, value, &error);
+    }
+    if (error) {
+        c->regs->CCR &= ~DMA_CCR_EN;
+        dma_set_flags(c, DMA_ISR_TEIF1);
+        return;
+    }
+
+    c->index++;
+    remaining = (uint16_t)(c->regs->CNDTR - 1U);
+    c->regs->CNDTR = remaining;
+    if (remaining == c->total / 2U) {
+        dma_set_flags(c, DMA_ISR_HTIF1);
+    }
+    if (remaining == 0U) {
+        if (ccr & DMA_CCR_CIRC) {
+            c->regs->CNDTR = c->total;
+            c->index = 0;
+        }
+        dma_set_flags(c, DMA_ISR_TCIF1);
+    }
+}
+
+static void dma_engine(sim_event_t *ev) {
+    dma_chan_t *c = dma_arbitrate();
+
+    (void)ev;
+    if (c != NULL) {
+        dma_transfer(c);
+    }
+    dma_kick();
+}
+
+static dma_chan_t *dma_channel_at(const DMA_TypeDef *dma, uint32_t off) {
+    int first = (dma == DMA1) ? 0 : 7;
+    int count = (dma == DMA1) ? 7 : 5;
+    uint32_t n = (off - OFF_CH_FIRST) / CH_STRIDE;
+
+    if (off < OFF_CH_FIRST || n >= (uint32_t)count) {
+        return NULL;
+    }
+    return &s_ch[first + (int)n];
+}
+
+static void dma_reset_block(DMA_TypeDef *dma) {
+    memset(dma, 0, 0x400);
+}
+
+static void dma_write_block(DMA_TypeDef *dma, uint32_t off, uint32_t val, uint32_t old) {
+    if (off == OFF_ISR) {
+        dma->ISR = old;
+        return;
+    }
+    if (off == OFF_IFCR) {
+        int first = (dma == DMA1) ? 0 : 7;
+        int count = (dma == DMA1) ? 7 : 5;
+
+        for (int i = first; i < first + count; i++) {
+            dma_chan_t *c = &s_ch[i];
+            uint32_t clr = (val >> c->shift) & 0xFU;
+            if (clr & DMA_IFCR_CGIF1) {
+                clr = 0xFU;
+            }
+            if (clr != 0) {
+                dma->ISR &= ~(clr << c->shift);
+                if ((dma->ISR >> c->shift) & 0xEU) {
+                    dma->ISR |= DMA_ISR_GIF1 << c->shift;
+                } else {
+                    dma->ISR &= ~(DMA_ISR_GIF1 << c->shift);
+                }
+                dma_update_irq(c);
+            }
+        }
+        dma->IFCR = 0;
+        return;
+    }
+
+    dma_chan_t *c = dma_channel_at(dma, off);
+    if (c == NULL) {
+        return;
+    }
+    switch ((off - OFF_CH_FIRST) % CH_STRIDE) {
+    case CH_CCR:
+        if ((val & DMA_CCR_EN) && !(old & DMA_CCR_EN)) {
+            c->total = (uint16_t)c->regs->CNDTR;
+            c->index = 0;
+            c->par = c->regs->CPAR;
+            c->mar = c->regs->CMAR;
+        }
+        dma_update_irq(c);
+        dma_kick();
+        break;
+    case CH_CNDTR:
+        /* 通道使能时 CNDTR 只读 */
+        if (c->regs->CCR & DMA_CCR_EN) {
+            c->regs->CNDTR = old;
+        } else {
+            c->regs->CNDTR = val & 0xFFFFU;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void dma1_reset(void) { dma_reset_block(DMA1); }
+static void dma2_reset(void) { dma_reset_block(DMA2); }
+static void dma1_write(uint32_t off, uint32_t val, uint32_t old) {
+    dma_write_block(DMA1, off, val, old);
+}
+static void dma2_write(uint32_t off, uint32_t val, uint32_t old) {
+    dma_write_block(DMA2, off, val, old);
+}
+
+static const sim_periph_t s_dma1_model = {
+    .name = "DMA1",
+    .base = DMA1_BASE,
+    .size = 0x400,
+    .reset = dma1_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = dma1_write,
+};
+
+static const sim_periph_t s_dma2_model = {
+    .name = "DMA2",
+    .base = DMA2_BASE,
+    .size = 0x400,
+    .reset = dma2_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = dma2_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_dma_init(void) {
+    for (int i = 0; i < SIM_DMA_CHANNELS; i++) {
+        dma_chan_t *c = &s_ch[i];
+        int n = (i < 7) ? i : i - 7;
+
+        memset(c, 0, sizeof(*c));
+        c->dma = (i < 7) ? DMA1 : DMA2;
+        c->regs = (DMA_Channel_TypeDef *)((uintptr_t)c->dma + OFF_CH_FIRST +
+                                          (uint32_t)n * CH_STRIDE);
+        c->shift = (uint8_t)(4 * n);
+        if (i < 7) {
+            c->irqn = (uint8_t)(DMA1_Channel1_IRQn + n);
+        } else if (n < 3) {
+            c->irqn = (uint8_t)(DMA2_Channel1_IRQn + n);
+        } else {
+            c->irqn = DMA2_Channel4_5_IRQn;
+        }
+    }
+    sim_event_init(&s_engine, dma_engine, NULL);
+    sim_register(&s_dma1_model);
+    sim_register(&s_dma2_model);
+}
+
+/**
+ * @brief  外设 DMA 请求电平
+ * @param  ch: 通道编号（SIM_DMA_CH）
+ * @param  source: SIM_DMA_SRC_* 请求源位
+ * @param  level: 1 有请求，0 撤销
+ */
+void sim_dma_request(int ch, uint32_t source, int level) {
+    dma_chan_t *c = &s_ch[ch];
+
+    if (level) {
+        c->request |= source;
+        dma_kick();
+    } else {
+        c->request &= ~source;
+    }
+}
+
+/**
+ * @brief  单次 DMA 请求（定时器更新等边沿事件）
+ */
+void sim_dma_pulse(int ch) {
+    s_ch[ch].pulse = 1;
+    dma_kick();
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,102 @@
+/**
+ * @file    sim_exti.c
+ * @brief   EXTI 外部中断 / 事件控制器模型
+ * @date    2026-10-18
+ *
+ * @note    - 线 0~15 的输入来自 AFIO_EXTICR 选择的端口，sim_gpio_input
+ *            改变电平时检测边沿；线 16~18（PVD、RTC 闹钟、USB 唤醒）不建模；
+ *          - RTSR / FTSR 选中的边沿置 PR，PR 写 1 清除；
+ *          - SWIER 由 0 写 1 且 IMR 使能时置 PR；
+ *          - 中断线是 PR & IMR 的电平：线 0~4 各自一个中断，5~9 和 10~15
+ *            分别共用 EXTI9_5 / EXTI15_10。AFIO 寄存器没有副作用，不需要模型。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_IMR 0x00U
+#define OFF_EMR 0x04U
+#define OFF_RTSR 0x08U
+#define OFF_FTSR 0x0CU
+#define OFF_SWIER 0x10U
+#define OFF_PR 0x14U
+
+#define EXTI_LINES 0x7FFFFU
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  根据 PR & IMR 更新各中断线
+ */
+static void exti_update_irq(void) {
+    uint32_t active = EXTI->PR & EXTI->IMR;
+
+    sim_irq_level(EXTI0_IRQn, (active & 0x0001U) != 0);
+    sim_irq_level(EXTI1_IRQn, (active & 0x0002U) != 0);
+    sim_irq_level(EXTI2_IRQn, (active & 0x0004U) != 0);
+    sim_irq_level(EXTI3_IRQn, (active & 0x0008U) != 0);
+    sim_irq_level(EXTI4_IRQn, (active & 0x0010U) != 0);
+    sim_irq_level(EXTI9_5_IRQn, (active & 0x03E0U) != 0);
+    sim_irq_level(EXTI15_10_IRQn, (active & 0xFC00U) != 0);
+}
+
+static void exti_reset(void) {
+    memset((void *)EXTI, 0, 0x400);
+}
+
+static void exti_write(uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case OFF_SWIER:
+        EXTI->PR |= (val & ~old) & EXTI->IMR & EXTI_LINES;
+        EXTI->SWIER = val & EXTI_LINES;
+        break;
+    case OFF_PR:
+        /* 写 1 清除，同时清除对应的 SWIER 位 */
+        EXTI->PR = old & ~val;
+        EXTI->SWIER &= ~val;
+        break;
+    default:
+        break;
+    }
+    exti_update_irq();
+}
+
+static const sim_periph_t s_exti_model = {
+    .name = "EXTI",
+    .base = EXTI_BASE,
+    .size = 0x400,
+    .reset = exti_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = exti_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_exti_init(void) {
+    sim_register(&s_exti_model);
+}
+
+/**
+ * @brief  端口 port 的引脚 pin 电平变为 level
+ */
+void sim_exti_edge(int port, int pin, int level) {
+    uint32_t bit = 1UL << pin;
+    uint32_t sel = (AFIO->EXTICR[pin >> 2] >> ((pin & 3) * 4)) & 0xFU;
+    uint32_t trig = level ? EXTI->RTSR : EXTI->FTSR;
+
+    if (sel != (uint32_t)port || (trig & bit) == 0) {
+        return;
+    }
+    /* PR 只在中断使能时置位；EMR 的事件输出（唤醒 WFE）在仿真中没有效果 */
+    if (EXTI->IMR & bit) {
+        EXTI->PR |= bit;
+        exti_update_irq();
+    }
+}
+
+/************************ END OF FILE *****************************************/
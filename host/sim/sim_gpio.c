@@ -0,0 +1,256 @@
+/**
+ * @file    sim_gpio.c
+ * @brief   GPIOA~GPIOG 模型
+ * @date    2026-10-18
+ *
+ * @note    - BSRR / BRR 写入后作用到 ODR，读回为 0；
+ *          - IDR：输出引脚读 ODR，输入引脚读外部驱动电平，
+ *            未驱动时上下拉输入读 ODR 对应位，浮空输入读 0；
+ *          - 外部器件（如 Flash 片选）通过 sim_gpio_watch 监视输出变化；
+ *          - sim_gpio_input 改变的输入电平送到 EXTI 模型做边沿检测。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_CRL 0x00U
+#define OFF_CRH 0x04U
+#define OFF_IDR 0x08U
+#define OFF_ODR 0x0CU
+#define OFF_BSRR 0x10U
+#define OFF_BRR 0x14U
+
+#define GPIO_PORT_SIZE 0x400U
+#define GPIO_MAX_WATCH 8
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    int port;
+    int pin;
+    sim_gpio_cb_t cb;
+} gpio_watch_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint16_t s_ext_level[SIM_GPIO_PORTS];  /* 外部驱动电平 */
+static uint16_t s_ext_driven[SIM_GPIO_PORTS]; /* 被外部驱动的引脚 */
+static uint16_t s_out_level[SIM_GPIO_PORTS];  /* 上次通知的输出电平 */
+static gpio_watch_t s_watch[GPIO_MAX_WATCH];
+static int s_watch_count = 0;
+
+static sim_periph_t s_gpio_model[SIM_GPIO_PORTS];
+static const char *const s_names[SIM_GPIO_PORTS] = {
+    "GPIOA", "GPIOB", "GPIOC", "GPIOD", "GPIOE", "GPIOF", "GPIOG",
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline GPIO_TypeDef *gpio_port(int port) {
+    return (GPIO_TypeDef *)(uintptr_t)(GPIOA_BASE + (uint32_t)port * GPIO_PORT_SIZE);
+}
+
+/**
+ * @brief  配置为输出（MODE != 0）的引脚掩码
+ */
+static uint16_t gpio_output_mask(const GPIO_TypeDef *g) {
+    uint16_t mask = 0;
+
+    for (int pin = 0; pin < 16; pin++) {
+        uint32_t cr = (pin < 8) ? g->CRL : g->CRH;
+        if ((cr >> ((pin & 7) * 4)) & 0x3U) {
+            mask |= (uint16_t)(1U << pin);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief  上下拉输入（MODE = 0, CNF = 10）的引脚掩码
+ */
+static uint16_t gpio_pull_mask(const GPIO_TypeDef *g) {
+    uint16_t mask = 0;
+
+    for (int pin = 0; pin < 16; pin++) {
+        uint32_t cr = (pin < 8) ? g->CRL : g->CRH;
+        if (((cr >> ((pin & 7) * 4)) & 0xFU) == 0x8U) {
+            mask |= (uint16_t)(1U << pin);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief  输出电平变化时通知监视者
+ */
+static void gpio_notify(int port) {
+    GPIO_TypeDef *g = gpio_port(port);
+    uint16_t out = (uint16_t)(g->ODR & gpio_output_mask(g));
+    uint16_t changed = out ^ s_out_level[port];
+
+    if (changed == 0) {
+        return;
+    }
+    s_out_level[port] = out;
+    for (int i = 0; i < s_watch_count; i++) {
+        if (s_watch[i].port == port && (changed & (1U << s_watch[i].pin))) {
+            s_watch[i].cb(port, s_watch[i].pin, (out >> s_watch[i].pin) & 1);
+        }
+    }
+}
+
+static void gpio_reset_port(int port) {
+    GPIO_TypeDef *g = gpio_port(port);
+
+    memset(g, 0, GPIO_PORT_SIZE);
+    g->CRL = 0x44444444U;
+    g->CRH = 0x44444444U;
+    s_out_level[port] = 0;
+}
+
+static void gpio_read_port(int port, uint32_t off) {
+    GPIO_TypeDef *g = gpio_port(port);
+
+    if (off == OFF_IDR) {
+        uint16_t out = gpio_output_mask(g);
+        uint16_t pull = gpio_pull_mask(g) & (uint16_t)~s_ext_driven[port];
+        uint16_t idr = (uint16_t)(g->ODR & (out | pull));
+
+        idr |= s_ext_level[port] & s_ext_driven[port] & (uint16_t)~out;
+        g->IDR = idr;
+    }
+}
+
+static void gpio_write_port(int port, uint32_t off, uint32_t val, uint32_t old) {
+    GPIO_TypeDef *g = gpio_port(port);
+
+    switch (off) {
+    case OFF_IDR:
+        g->IDR = old;
+        break;
+    case OFF_ODR:
+        g->ODR = val & 0xFFFFU;
+        break;
+    case OFF_BSRR:
+        /* 同时置位和复位时置位优先 */
+        g->ODR = ((g->ODR & ~(val >> 16)) | val) & 0xFFFFU;
+        g->BSRR = 0;
+        break;
+    case OFF_BRR:
+        g->ODR &= ~val & 0xFFFFU;
+        g->BRR = 0;
+        break;
+    default:
+        break;
+    }
+    gpio_notify(port);
+}
+
+/* 每个端口一组回调 */
+#define GPIO_PORT_FUNCS(n)                                                     \
+    static void gpio_reset_##n(void) { gpio_reset_port(n); }                   \
+    static void gpio_read_##n(uint32_t off) { gpio_read_port(n, off); }        \
+    static void gpio_write_##n(uint32_t off, uint32_t val, uint32_t old) {     \
+        gpio_write_port(n, off, val, old);                                     \
+    }
+
+GPIO_PORT_FUNCS(0)
+GPIO_PORT_FUNCS(1)
+GPIO_PORT_FUNCS(2)
+GPIO_PORT_FUNCS(3)
+GPIO_PORT_FUNCS(4)
+GPIO_PORT_FUNCS(5)
+GPIO_PORT_FUNCS(6)
+
+static void (*const s_reset_fn[SIM_GPIO_PORTS])(void) = {
+    gpio_reset_0, gpio_reset_1, gpio_reset_2, gpio_reset_3,
+    gpio_reset_4, gpio_reset_5, gpio_reset_6,
+};
+static void (*const s_read_fn[SIM_GPIO_PORTS])(uint32_t) = {
+    gpio_read_0, gpio_read_1, gpio_read_2, gpio_read_3,
+    gpio_read_4, gpio_read_5, gpio_read_6,
+};
+static void (*const s_write_fn[SIM_GPIO_PORTS])(uint32_t, uint32_t, uint32_t) = {
+    gpio_write_0, gpio_write_1, gpio_write_2, gpio_write_3,
+    gpio_write_4, gpio_write_5, gpio_write_6,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_gpio_init(void) {
+    for (int port = 0; port < SIM_GPIO_PORTS; port++) {
+        s_gpio_model[port].name = s_names[port];
+        s_gpio_model[port].base = GPIOA_BASE + (uint32_t)port * GPIO_PORT_SIZE;
+        s_gpio_model[port].size = GPIO_PORT_SIZE;
+        s_gpio_model[port].reset = s_reset_fn[port];
+        s_gpio_model[port].read = s_read_fn[port];
+        s_gpio_model[port].read_done = NULL;
+        s_gpio_model[port].write = s_write_fn[port];
+        sim_register(&s_gpio_model[port]);
+    }
+}
+
+/**
+ * @brief  监视一个引脚的输出电平
+ */
+void sim_gpio_watch(int port, int pin, sim_gpio_cb_t cb) {
+    if (s_watch_count >= GPIO_MAX_WATCH) {
+        sim_fatal("too many GPIO watchers");
+    }
+    s_watch[s_watch_count].port = port;
+    s_watch[s_watch_count].pin = pin;
+    s_watch[s_watch_count].cb = cb;
+    s_watch_count++;
+}
+
+/**
+ * @brief  输入引脚当前的电平（外部驱动、上下拉或浮空）
+ */
+static int gpio_input_level(int port, int pin) {
+    GPIO_TypeDef *g = gpio_port(port);
+    uint16_t bit = (uint16_t)(1U << pin);
+
+    if (s_ext_driven[port] & bit) {
+        return (s_ext_level[port] & bit) != 0;
+    }
+    return (gpio_pull_mask(g) & g->ODR & bit) != 0;
+}
+
+/**
+ * @brief  外部驱动一个输入引脚，level < 0 表示释放（恢复上下拉 / 浮空）
+ * @note   电平变化送到 EXTI 做边沿检测
+ */
+void sim_gpio_input(int port, int pin, int level) {
+    uint16_t bit = (uint16_t)(1U << pin);
+    int before = gpio_input_level(port, pin);
+    int after;
+
+    if (level < 0) {
+        s_ext_driven[port] &= (uint16_t)~bit;
+    } else {
+        s_ext_driven[port] |= bit;
+        if (level) {
+            s_ext_level[port] |= bit;
+        } else {
+            s_ext_level[port] &= (uint16_t)~bit;
+        }
+    }
+
+    after = gpio_input_level(port, pin);
+    if (after != before) {
+        sim_exti_edge(port, pin, after);
+    }
+}
+
+/**
+ * @brief  引脚当前的输出电平
+ */
+int sim_gpio_output(int port, int pin) {
+    return (s_out_level[port] >> pin) & 1;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,366 @@
+/**
+ * @file    sim_i2c.c
+ * @brief   I2C2 主机模式模型
+ * @date    2026-10-18
+ *
+ * @note    - SCL 周期按 CCR 计算（标准模式 2×CCR 个 PCLK1 周期，
+ *            PCLK1 = 36 MHz），每个字节连同应答位共 9 个 SCL 周期；
+ *          - START 置位 SB；SB 置位时写 DR 进入地址阶段，从机应答后置 ADDR，
+ *            否则置 AF。ADDR 由“读 SR1 再读 SR2”清除；
+ *          - 发送：移位寄存器空闲时写 DR 立即开始发送，字节结束且 DR 为空时
+ *            置 BTF；传输过程中请求的 START / STOP 在当前字节结束后执行；
+ *          - 接收：ADDR 清除后开始接收，DR 和移位寄存器都满时置 BTF 并暂停，
+ *            应答位在字节结束时按 ACK 决定；POS = 1 时按上一个字节结束时的
+ *            ACK 决定。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_CR1 0x00U
+#define OFF_CR2 0x04U
+#define OFF_DR 0x10U
+#define OFF_SR1 0x14U
+#define OFF_SR2 0x18U
+
+/** SR1 中软件写 0 清除的位 */
+#define SR1_RC_W0 (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR | \
+                   I2C_SR1_PECERR | I2C_SR1_TIMEOUT | I2C_SR1_SMBALERT)
+
+/* Private types -------------------------------------------------------------*/
+
+typedef enum {
+    XFER_NONE = 0,
+    XFER_ADDR,
+    XFER_TX,
+    XFER_RX,
+} i2c_xfer_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static const sim_i2c_slave_t *s_slave = NULL;
+static sim_event_t s_byte_ev;
+
+static i2c_xfer_t s_xfer;       /* 正在进行的字节传输 */
+static uint8_t s_shift;         /* 地址 / 发送字节 */
+static uint8_t s_tx_dr;         /* DR 中等待发送的字节 */
+static uint8_t s_tx_full;
+static uint8_t s_rx_dr;         /* DR 中已接收的字节 */
+static uint8_t s_rx_shift;      /* 移位寄存器中已接收的字节 */
+static uint8_t s_rx_shift_full;
+static uint8_t s_rx_shift_ack;
+static uint8_t s_pos_ack;
+static uint8_t s_addr_sr1;      /* ADDR 清除序列：已读 SR1 */
+static uint8_t s_slave_active;
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint64_t i2c_byte_cycles(void) {
+    uint32_t ccr = I2C2->CCR & I2C_CCR_CCR;
+    uint32_t pclk_per_bit;
+
+    if (ccr == 0) {
+        ccr = 180;
+    }
+    if (!(I2C2->CCR & I2C_CCR_FS)) {
+        pclk_per_bit = 2U * ccr;
+    } else if (!(I2C2->CCR & I2C_CCR_DUTY)) {
+        pclk_per_bit = 3U * ccr;
+    } else {
+        pclk_per_bit = 25U * ccr;
+    }
+    /* CPU 72 MHz = 2 × PCLK1 */
+    return 9ULL * 2ULL * pclk_per_bit;
+}
+
+static void i2c_update(void) {
+    uint32_t sr1 = I2C2->SR1;
+    uint32_t cr2 = I2C2->CR2;
+    int ev = 0;
+    int er;
+
+    if (cr2 & I2C_CR2_ITEVTEN) {
+        ev = (sr1 & (I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF | I2C_SR1_STOPF)) != 0;
+        if (cr2 & I2C_CR2_ITBUFEN) {
+            ev |= (sr1 & (I2C_SR1_TXE | I2C_SR1_RXNE)) != 0;
+        }
+    }
+    er = (cr2 & I2C_CR2_ITERREN) &&
+         (sr1 & (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR));
+    sim_irq_level(I2C2_EV_IRQn, ev);
+    sim_irq_level(I2C2_ER_IRQn, er);
+
+    sim_dma_request(SIM_DMA_CH(1, 4), SIM_DMA_SRC_I2C2_TX,
+                    (cr2 & I2C_CR2_DMAEN) && (sr1 & I2C_SR1_TXE));
+    sim_dma_request(SIM_DMA_CH(1, 5), SIM_DMA_SRC_I2C2_RX,
+                    (cr2 & I2C_CR2_DMAEN) && (sr1 & I2C_SR1_RXNE));
+}
+
+static void i2c_begin(i2c_xfer_t xfer) {
+    s_xfer = xfer;
+    sim_event_after(&s_byte_ev, i2c_byte_cycles());
+}
+
+static void i2c_do_start(void) {
+    I2C2->CR1 &= ~I2C_CR1_START;
+    I2C2->SR1 &= ~(I2C_SR1_TXE | I2C_SR1_BTF | I2C_SR1_ADDR);
+    I2C2->SR1 |= I2C_SR1_SB;
+    I2C2->SR2 = (I2C2->SR2 & ~I2C_SR2_TRA) | I2C_SR2_MSL | I2C_SR2_BUSY;
+    s_tx_full = 0;
+    s_rx_shift_full = 0;
+    s_pos_ack = 1;
+}
+
+static void i2c_do_stop(void) {
+    sim_event_cancel(&s_byte_ev);
+    s_xfer = XFER_NONE;
+    s_tx_full = 0;
+    /* 已收到的 DR / 移位寄存器数据在 STOP 之后仍可读出 */
+    I2C2->CR1 &= ~I2C_CR1_STOP;
+    I2C2->SR1 &= ~(I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF | I2C_SR1_TXE);
+    I2C2->SR2 &= ~(I2C_SR2_MSL | I2C_SR2_BUSY | I2C_SR2_TRA);
+    if (s_slave_active && s_slave != NULL && s_slave->stop != NULL) {
+        s_slave->stop();
+    }
+    s_slave_active = 0;
+}
+
+/**
+ * @brief  字节结束后执行挂起的 START / STOP
+ * @retval 1 已执行
+ */
+static int i2c_deferred(void) {
+    if (I2C2->CR1 & I2C_CR1_STOP) {
+        i2c_do_stop();
+        return 1;
+    }
+    if (I2C2->CR1 & I2C_CR1_START) {
+        i2c_do_start();
+        return 1;
+    }
+    return 0;
+}
+
+static void i2c_addr_done(void) {
+    uint8_t addr7 = s_shift >> 1;
+    int read = s_shift & 1U;
+    int ack = 0;
+
+    if (s_slave != NULL && s_slave->addr == addr7) {
+        ack = s_slave->start(read);
+    }
+    s_slave_active = (uint8_t)ack;
+    if (ack) {
+        I2C2->SR1 |= I2C_SR1_ADDR;
+        if (read) {
+            I2C2->SR2 &= ~I2C_SR2_TRA;
+        } else {
+            I2C2->SR2 |= I2C_SR2_TRA;
+        }
+    } else {
+        I2C2->SR1 |= I2C_SR1_AF;
+    }
+    (void)i2c_deferred();
+}
+
+static void i2c_tx_done(void) {
+    int ack = s_slave_active && s_slave->write(s_shift);
+
+    if (!ack) {
+        I2C2->SR1 |= I2C_SR1_AF;
+    }
+    if (i2c_deferred() || !ack) {
+        return;
+    }
+    if (s_tx_full) {
+        s_tx_full = 0;
+        s_shift = s_tx_dr;
+        I2C2->SR1 |= I2C_SR1_TXE;
+        i2c_begin(XFER_TX);
+    } else {
+        I2C2->SR1 |= I2C_SR1_BTF;
+    }
+}
+
+static void i2c_rx_done(void) {
+    uint8_t byte = s_slave_active ? s_slave->read() : 0xFFU;
+    int ack;
+    int more;
+
+    if (I2C2->CR1 & I2C_CR1_POS) {
+        ack = s_pos_ack;
+        s_pos_ack = (I2C2->CR1 & I2C_CR1_ACK) != 0;
+    } else {
+        ack = (I2C2->CR1 & I2C_CR1_ACK) != 0;
+    }
+
+    if (!(I2C2->SR1 & I2C_SR1_RXNE)) {
+        s_rx_dr = byte;
+        I2C2->SR1 |= I2C_SR1_RXNE;
+        more = ack;
+    } else {
+        s_rx_shift = byte;
+        s_rx_shift_full = 1;
+        s_rx_shift_ack = (uint8_t)ack;
+        I2C2->SR1 |= I2C_SR1_BTF;
+        more = 0;
+    }
+    if (!i2c_deferred() && more) {
+        i2c_begin(XFER_RX);
+    }
+}
+
+static void i2c_byte_done(sim_event_t *ev) {
+    i2c_xfer_t xfer = s_xfer;
+
+    (void)ev;
+    s_xfer = XFER_NONE;
+    switch (xfer) {
+    case XFER_ADDR:
+        i2c_addr_done();
+        break;
+    case XFER_TX:
+        i2c_tx_done();
+        break;
+    case XFER_RX:
+        i2c_rx_done();
+        break;
+    default:
+        break;
+    }
+    i2c_update();
+}
+
+static void i2c_reset(void) {
+    sim_event_cancel(&s_byte_ev);
+    if (s_slave_active && s_slave != NULL && s_slave->stop != NULL) {
+        s_slave->stop();
+    }
+    memset((void *)I2C2, 0, 0x400);
+    I2C2->TRISE = 0x0002U;
+    s_xfer = XFER_NONE;
+    s_tx_full = 0;
+    s_rx_shift_full = 0;
+    s_addr_sr1 = 0;
+    s_slave_active = 0;
+    s_pos_ack = 1;
+}
+
+static void i2c_read(uint32_t off) {
+    if (off == OFF_DR) {
+        I2C2->DR = s_rx_dr;
+    }
+}
+
+static void i2c_read_done(uint32_t off) {
+    if (off == OFF_SR1) {
+        s_addr_sr1 = (I2C2->SR1 & I2C_SR1_ADDR) != 0;
+    } else if (off == OFF_SR2 && s_addr_sr1) {
+        s_addr_sr1 = 0;
+        I2C2->SR1 &= ~I2C_SR1_ADDR;
+        if (I2C2->SR2 & I2C_SR2_TRA) {
+            I2C2->SR1 |= I2C_SR1_TXE;
+        } else if (s_xfer == XFER_NONE) {
+            i2c_begin(XFER_RX);
+        }
+    } else if (off == OFF_DR && (I2C2->SR1 & I2C_SR1_RXNE)) {
+        if (s_rx_shift_full) {
+            s_rx_shift_full = 0;
+            s_rx_dr = s_rx_shift;
+            I2C2->SR1 &= ~I2C_SR1_BTF;
+            if (s_rx_shift_ack && (I2C2->SR2 & I2C_SR2_MSL) && s_xfer == XFER_NONE) {
+                i2c_begin(XFER_RX);
+            }
+        } else {
+            I2C2->SR1 &= ~I2C_SR1_RXNE;
+        }
+    } else {
+        return;
+    }
+    i2c_update();
+}
+
+static void i2c_write(uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case OFF_CR1:
+        if (val & I2C_CR1_SWRST) {
+            i2c_reset();
+            I2C2->CR1 = I2C_CR1_SWRST;
+            break;
+        }
+        if (!(val & I2C_CR1_PE)) {
+            if (old & I2C_CR1_PE) {
+                i2c_do_stop();
+                s_rx_shift_full = 0;
+                I2C2->SR1 = 0;
+                I2C2->SR2 = 0;
+            }
+            /* PE = 0 时 START / STOP / ACK 由硬件清零 */
+            I2C2->CR1 = val & ~(I2C_CR1_START | I2C_CR1_STOP | I2C_CR1_ACK);
+            break;
+        }
+        if (s_xfer == XFER_NONE) {
+            (void)i2c_deferred();
+        }
+        break;
+    case OFF_DR:
+        val &= 0xFFU;
+        if (I2C2->SR1 & I2C_SR1_SB) {
+            I2C2->SR1 &= ~I2C_SR1_SB;
+            s_shift = (uint8_t)val;
+            i2c_begin(XFER_ADDR);
+        } else if ((I2C2->SR2 & (I2C_SR2_MSL | I2C_SR2_TRA)) == (I2C_SR2_MSL | I2C_SR2_TRA) &&
+                   !(I2C2->SR1 & (I2C_SR1_ADDR | I2C_SR1_AF))) {
+            I2C2->SR1 &= ~I2C_SR1_BTF;
+            if (s_xfer == XFER_NONE && !s_tx_full) {
+                s_shift = (uint8_t)val;
+                I2C2->SR1 |= I2C_SR1_TXE;
+                i2c_begin(XFER_TX);
+            } else {
+                s_tx_dr = (uint8_t)val;
+                s_tx_full = 1;
+                I2C2->SR1 &= ~I2C_SR1_TXE;
+            }
+        }
+        break;
+    case OFF_SR1:
+        I2C2->SR1 = old & ~(~val & SR1_RC_W0);
+        break;
+    case OFF_SR2:
+        I2C2->SR2 = old;
+        break;
+    default:
+        break;
+    }
+    i2c_update();
+}
+
+static const sim_periph_t s_i2c2_model = {
+    .name = "I2C2",
+    .base = I2C2_BASE,
+    .size = 0x400,
+    .reset = i2c_reset,
+    .read = i2c_read,
+    .read_done = i2c_read_done,
+    .write = i2c_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_i2c_init(void) {
+    sim_event_init(&s_byte_ev, i2c_byte_done, NULL);
+    sim_register(&s_i2c2_model);
+}
+
+/**
+ * @brief  在 I2C2 总线上挂接一个从设备
+ */
+void sim_i2c2_attach(const sim_i2c_slave_t *slave) {
+    s_slave = slave;
+}
+
+/************************ END OF FILE *****************************************/
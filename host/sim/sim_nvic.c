@@ -0,0 +1,589 @@
+/**
+ * @file    sim_nvic.c
+ * @brief   Cortex-M3 内核模型：NVIC、SCB、SysTick、DWT 周期计数和 PRIMASK
+ * @date    2026-10-18
+ *
+ * @note    - 中断在访问钩子里同步调用处理函数，嵌套时直接在当前 C 栈上递归；
+ *          - 外设中断线是电平信号：线有效且未处于活动状态时视为挂起，
+ *            处理函数清除标志后模型拉低中断线；
+ *          - 只有组优先级严格更高的异常才能抢占，PRIMASK 屏蔽全部可配置
+ *            优先级的异常。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define SCS_BASE_ADDR 0xE000E000UL
+#define DWT_BASE_ADDR 0xE0001000UL
+
+/* SCS 内的偏移 */
+#define OFF_STK_CTRL 0x010U
+#define OFF_STK_LOAD 0x014U
+#define OFF_STK_VAL 0x018U
+#define OFF_STK_CALIB 0x01CU
+#define OFF_ISER 0x100U
+#define OFF_ICER 0x180U
+#define OFF_ISPR 0x200U
+#define OFF_ICPR 0x280U
+#define OFF_IABR 0x300U
+#define OFF_IP 0x400U
+#define OFF_IP_END 0x4F0U
+#define OFF_CPUID 0xD00U
+#define OFF_ICSR 0xD04U
+#define OFF_AIRCR 0xD0CU
+#define OFF_SHP 0xD18U
+#define OFF_SHP_END 0xD24U
+#define OFF_DEMCR 0xDFCU
+#define OFF_STIR 0xF00U
+
+/** 异常编号（向量号） */
+#define EXC_NMI 2
+#define EXC_HARDFAULT 3
+#define EXC_SVCALL 11
+#define EXC_PENDSV 14
+#define EXC_SYSTICK 15
+#define EXC_IRQ0 16
+
+#define THREAD_PRIORITY 0x100
+
+/* Private variables ---------------------------------------------------------*/
+
+extern void (*const sim_vectors[EXC_IRQ0 + SIM_IRQ_COUNT])(void);
+
+volatile int sim_irq_dirty = 0;
+
+static uint64_t s_enabled;     /* 外部中断使能 */
+static uint64_t s_pending;     /* 外部中断挂起位 */
+static uint64_t s_line;        /* 外设中断线电平 */
+static uint64_t s_active;      /* 外部中断活动位 */
+static uint32_t s_sys_pending; /* 系统异常挂起位（按向量号） */
+static uint32_t s_sys_active;
+
+static uint32_t s_primask = 0;
+static uint32_t s_faultmask = 0;
+static uint32_t s_basepri = 0;
+static uint32_t s_event_flag = 0;
+
+/* 活动异常栈 */
+static int s_stack_exc[EXC_IRQ0 + SIM_IRQ_COUNT];
+static int s_stack_prio[EXC_IRQ0 + SIM_IRQ_COUNT];
+static int s_depth = 0;
+
+/* SysTick */
+static sim_event_t s_systick_ev;
+static sim_time_t s_systick_start;
+static uint32_t s_systick_period;
+
+/* DWT */
+static sim_time_t s_cyccnt_base;
+static uint32_t s_cyccnt_frozen;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline volatile uint32_t *scs(uint32_t off) {
+    return (volatile uint32_t *)(uintptr_t)(SCS_BASE_ADDR + off);
+}
+
+/**
+ * @brief  异常的 8 位优先级
+ */
+static int exc_priority(int exc) {
+    if (exc == EXC_NMI) {
+        return -2;
+    }
+    if (exc == EXC_HARDFAULT) {
+        return -1;
+    }
+    if (exc >= EXC_IRQ0) {
+        return NVIC->IP[exc - EXC_IRQ0];
+    }
+    return SCB->SHP[exc - 4];
+}
+
+/**
+ * @brief  组优先级（抢占优先级）
+ */
+static int group_priority(int prio) {
+    uint32_t prigroup = (SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) >>
+                        SCB_AIRCR_PRIGROUP_Pos;
+
+    if (prio < 0) {
+        return prio;
+    }
+    return prio & (int)(0xFFU << (prigroup + 1U)) & 0xFF;
+}
+
+/**
+ * @brief  当前执行优先级
+ */
+static int exec_priority(void) {
+    int prio = (s_depth > 0) ? s_stack_prio[s_depth - 1] : THREAD_PRIORITY;
+
+    if (s_basepri != 0 && group_priority((int)s_basepri) < prio) {
+        prio = group_priority((int)s_basepri);
+    }
+    if (s_primask != 0 && prio > 0) {
+        prio = 0;
+    }
+    if (s_faultmask != 0 && prio > -1) {
+        prio = -1;
+    }
+    return prio;
+}
+
+/**
+ * @brief  优先级最高的挂起异常
+ * @param  prio: 输出其 8 位优先级
+ * @retval 向量号，没有返回 0
+ */
+static int highest_pending(int *prio) {
+    uint64_t ext = (s_pending | s_line) & s_enabled & ~s_active;
+    int best = 0;
+    int best_prio = 0x200;
+
+    for (int exc = 2; exc < EXC_IRQ0; exc++) {
+        if ((s_sys_pending & (1UL << exc)) && !(s_sys_active & (1UL << exc))) {
+            int p = exc_priority(exc);
+            if (p < best_prio) {
+                best = exc;
+                best_prio = p;
+            }
+        }
+    }
+    while (ext != 0) {
+        int irq = __builtin_ctzll(ext);
+        int p = exc_priority(EXC_IRQ0 + irq);
+
+        ext &= ext - 1;
+        if (p < best_prio) {
+            best = EXC_IRQ0 + irq;
+            best_prio = p;
+        }
+    }
+    *prio = best_prio;
+    return best;
+}
+
+/**
+ * @brief  进入异常并执行处理函数
+ */
+static void take_exception(int exc, int prio) {
+    void (*handler)(void) = sim_vectors[exc];
+
+    if (exc >= EXC_IRQ0) {
+        s_pending &= ~(1ULL << (exc - EXC_IRQ0));
+        s_active |= 1ULL << (exc - EXC_IRQ0);
+    } else {
+        s_sys_pending &= ~(1UL << exc);
+        s_sys_active |= 1UL << exc;
+    }
+    s_stack_exc[s_depth] = exc;
+    s_stack_prio[s_depth] = group_priority(prio);
+    s_depth++;
+    s_event_flag = 1;
+
+    sim_charge(SIM_CYCLES_EXC);
+    handler();
+    sim_sync();
+    sim_charge(SIM_CYCLES_EXC);
+
+    s_depth--;
+    if (exc >= EXC_IRQ0) {
+        s_active &= ~(1ULL << (exc - EXC_IRQ0));
+    } else {
+        s_sys_active &= ~(1UL << exc);
+    }
+    sim_irq_dirty = 1;
+}
+
+/* SysTick -------------------------------------------------------------------*/
+
+static uint32_t systick_period(void) {
+    uint32_t period = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;
+
+    if ((SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk) == 0) {
+        period *= 8U;
+    }
+    return period;
+}
+
+/**
+ * @brief  从 VAL 的当前值开始计数（VAL 为 0 时下一个时钟重装 LOAD）
+ */
+static void systick_restart(void) {
+    uint32_t load = SysTick->LOAD & SysTick_LOAD_RELOAD_Msk;
+    uint32_t val = SysTick->VAL & SysTick_LOAD_RELOAD_Msk;
+    uint32_t done = (val == 0 || val > load) ? 0 : load - val;
+
+    s_systick_period = systick_period();
+    if ((SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk) == 0) {
+        done *= 8U;
+    }
+    s_systick_start = sim_now() - done;
+    if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) && SysTick->LOAD != 0) {
+        sim_event_at(&s_systick_ev, s_systick_start + s_systick_period);
+    } else {
+        sim_event_cancel(&s_systick_ev);
+    }
+}
+
+static void systick_expire(sim_event_t *ev) {
+    (void)ev;
+    SysTick->CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+    if (SysTick->CTRL & SysTick_CTRL_TICKINT_Msk) {
+        s_sys_pending |= 1UL << EXC_SYSTICK;
+        sim_irq_dirty = 1;
+    }
+    /* 计到 0 后重装 LOAD，新的 LOAD 从这里开始生效 */
+    s_systick_start = ev->when;
+    s_systick_period = systick_period();
+    if (SysTick->LOAD != 0) {
+        sim_event_at(&s_systick_ev, s_systick_start + s_systick_period);
+    }
+}
+
+static uint32_t systick_value(void) {
+    uint32_t elapsed;
+
+    if (!(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) || s_systick_period == 0) {
+        return SysTick->VAL;
+    }
+    elapsed = (uint32_t)((sim_now() - s_systick_start) % s_systick_period);
+    if ((SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk) == 0) {
+        elapsed /= 8U;
+    }
+    return (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) - elapsed;
+}
+
+/* SCS 寄存器模型 -------------------------------------------------------------*/
+
+static void scs_reset(void) {
+    memset((void *)(uintptr_t)SCS_BASE_ADDR, 0, 0x1000);
+    *(volatile uint32_t *)&SCB->CPUID = 0x411FC231U;
+    SCB->AIRCR = 0xFA050000U;
+    *(volatile uint32_t *)&SysTick->CALIB = 0x00002328U;
+    s_enabled = s_pending = s_line = s_active = 0;
+    s_sys_pending = s_sys_active = 0;
+    s_primask = s_faultmask = s_basepri = 0;
+    s_depth = 0;
+    sim_event_cancel(&s_systick_ev);
+}
+
+static void scs_read(uint32_t off) {
+    if (off == OFF_STK_VAL) {
+        SysTick->VAL = systick_value();
+    } else if (off >= OFF_ISER && off < OFF_ISER + 8) {
+        *scs(off) = (uint32_t)(s_enabled >> ((off - OFF_ISER) * 8));
+    } else if (off >= OFF_ICER && off < OFF_ICER + 8) {
+        *scs(off) = (uint32_t)(s_enabled >> ((off - OFF_ICER) * 8));
+    } else if (off >= OFF_ISPR && off < OFF_ISPR + 8) {
+        *scs(off) = (uint32_t)((s_pending | (s_line & ~s_active)) >>
+                               ((off - OFF_ISPR) * 8));
+    } else if (off >= OFF_ICPR && off < OFF_ICPR + 8) {
+        *scs(off) = (uint32_t)((s_pending | (s_line & ~s_active)) >>
+                               ((off - OFF_ICPR) * 8));
+    } else if (off >= OFF_IABR && off < OFF_IABR + 8) {
+        *scs(off) = (uint32_t)(s_active >> ((off - OFF_IABR) * 8));
+    } else if (off == OFF_ICSR) {
+        int prio;
+        uint32_t icsr = 0;
+        int pend = highest_pending(&prio);
+
+        if (s_depth > 0) {
+            icsr |= (uint32_t)s_stack_exc[s_depth - 1];
+        }
+        icsr |= (uint32_t)pend << SCB_ICSR_VECTPENDING_Pos;
+        if ((s_pending | s_line) & s_enabled) {
+            icsr |= SCB_ICSR_ISRPENDING_Msk;
+        }
+        if (s_sys_pending & (1UL << EXC_PENDSV)) {
+            icsr |= SCB_ICSR_PENDSVSET_Msk;
+        }
+        if (s_sys_pending & (1UL << EXC_SYSTICK)) {
+            icsr |= SCB_ICSR_PENDSTSET_Msk;
+        }
+        SCB->ICSR = icsr;
+    }
+}
+
+static void scs_read_done(uint32_t off) {
+    if (off == OFF_STK_CTRL) {
+        SysTick->CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+    }
+}
+
+static void scs_write(uint32_t off, uint32_t val, uint32_t old) {
+    if (off == OFF_STK_CTRL) {
+        uint32_t cur;
+
+        /* 停止时计数值保持，重新使能后从保持的值继续 */
+        SysTick->CTRL = old;
+        cur = systick_value();
+        SysTick->CTRL = (val & ~SysTick_CTRL_COUNTFLAG_Msk) |
+                        (old & SysTick_CTRL_COUNTFLAG_Msk);
+        if ((val ^ old) & (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_CLKSOURCE_Msk)) {
+            SysTick->VAL = cur;
+            systick_restart();
+        }
+    } else if (off == OFF_STK_VAL) {
+        /* 写任意值清零计数器和 COUNTFLAG */
+        SysTick->VAL = 0;
+        SysTick->CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+        systick_restart();
+    } else if (off == OFF_STK_CALIB || off == OFF_CPUID) {
+        *scs(off) = old;
+    } else if (off >= OFF_ISER && off < OFF_ISER + 8) {
+        s_enabled |= (uint64_t)val << ((off - OFF_ISER) * 8);
+        sim_irq_dirty = 1;
+    } else if (off >= OFF_ICER && off < OFF_ICER + 8) {
+        s_enabled &= ~((uint64_t)val << ((off - OFF_ICER) * 8));
+    } else if (off >= OFF_ISPR && off < OFF_ISPR + 8) {
+        s_pending |= (uint64_t)val << ((off - OFF_ISPR) * 8);
+        sim_irq_dirty = 1;
+    } else if (off >= OFF_ICPR && off < OFF_ICPR + 8) {
+        s_pending &= ~((uint64_t)val << ((off - OFF_ICPR) * 8));
+    } else if ((off >= OFF_IP && off < OFF_IP_END) ||
+               (off >= OFF_SHP && off < OFF_SHP_END)) {
+        /* 只实现高 4 位 */
+        *scs(off) = val & 0xF0F0F0F0U;
+        sim_irq_dirty = 1;
+    } else if (off == OFF_ICSR) {
+        if (val & SCB_ICSR_PENDSVSET_Msk) {
+            s_sys_pending |= 1UL << EXC_PENDSV;
+        }
+        if (val & SCB_ICSR_PENDSVCLR_Msk) {
+            s_sys_pending &= ~(1UL << EXC_PENDSV);
+        }
+        if (val & SCB_ICSR_PENDSTSET_Msk) {
+            s_sys_pending |= 1UL << EXC_SYSTICK;
+        }
+        if (val & SCB_ICSR_PENDSTCLR_Msk) {
+            s_sys_pending &= ~(1UL << EXC_SYSTICK);
+        }
+        if (val & SCB_ICSR_NMIPENDSET_Msk) {
+            s_sys_pending |= 1UL << EXC_NMI;
+        }
+        SCB->ICSR = 0;
+        sim_irq_dirty = 1;
+    } else if (off == OFF_AIRCR) {
+        if ((val >> 16) != 0x05FAU) {
+            SCB->AIRCR = old;
+            return;
+        }
+        if (val & SCB_AIRCR_SYSRESETREQ_Msk) {
+            fflush(stdout);
+            sim_fatal("system reset requested (AIRCR.SYSRESETREQ)");
+        }
+        SCB->AIRCR = 0xFA050000U | (val & SCB_AIRCR_PRIGROUP_Msk);
+        sim_irq_dirty = 1;
+    } else if (off == OFF_STIR) {
+        sim_irq_pend((int)(val & 0x1FFU));
+        *scs(off) = 0;
+    }
+}
+
+static const sim_periph_t s_scs_model = {
+    .name = "SCS",
+    .base = SCS_BASE_ADDR,
+    .size = 0x1000,
+    .reset = scs_reset,
+    .read = scs_read,
+    .read_done = scs_read_done,
+    .write = scs_write,
+};
+
+/* DWT -----------------------------------------------------------------------*/
+
+static int dwt_running(void) {
+    return (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) &&
+           (CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk);
+}
+
+static void dwt_reset(void) {
+    memset((void *)(uintptr_t)DWT_BASE_ADDR, 0, 0x1000);
+    DWT->CTRL = 0x40000000U; /* NUMCOMP = 4 */
+    s_cyccnt_frozen = 0;
+    s_cyccnt_base = sim_now();
+}
+
+static void dwt_read(uint32_t off) {
+    if (off == 0x004U) {
+        DWT->CYCCNT = dwt_running() ? (uint32_t)(sim_now() - s_cyccnt_base)
+                                    : s_cyccnt_frozen;
+    }
+}
+
+static void dwt_write(uint32_t off, uint32_t val, uint32_t old) {
+    if (off == 0x004U) {
+        s_cyccnt_frozen = val;
+        s_cyccnt_base = sim_now() - val;
+    } else if (off == 0x000U) {
+        if ((val ^ old) & DWT_CTRL_CYCCNTENA_Msk) {
+            if (val & DWT_CTRL_CYCCNTENA_Msk) {
+                s_cyccnt_base = sim_now() - s_cyccnt_frozen;
+            } else {
+                s_cyccnt_frozen = (uint32_t)(sim_now() - s_cyccnt_base);
+            }
+        }
+    }
+}
+
+static const sim_periph_t s_dwt_model = {
+    .name = "DWT",
+    .base = DWT_BASE_ADDR,
+    .size = 0x1000,
+    .reset = dwt_reset,
+    .read = dwt_read,
+    .read_done = NULL,
+    .write = dwt_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_nvic_init(void) {
+    sim_event_init(&s_systick_ev, systick_expire, NULL);
+    sim_register(&s_scs_model);
+    sim_register(&s_dwt_model);
+}
+
+/**
+ * @brief  设置外设中断线电平
+ */
+void sim_irq_level(int irqn, int level) {
+    uint64_t bit = 1ULL << irqn;
+
+    if (level) {
+        if (!(s_line & bit)) {
+            s_line |= bit;
+            sim_irq_dirty = 1;
+        }
+    } else {
+        s_line &= ~bit;
+    }
+}
+
+/**
+ * @brief  置位中断挂起（脉冲型中断）
+ */
+void sim_irq_pend(int irqn) {
+    s_pending |= 1ULL << irqn;
+    sim_irq_dirty = 1;
+}
+
+/**
+ * @brief  是否有挂起的异常足以唤醒 WFI（不考虑 PRIMASK）
+ */
+int sim_irq_deliverable(void) {
+    int prio;
+    int exc = highest_pending(&prio);
+    int cur = (s_depth > 0) ? s_stack_prio[s_depth - 1] : THREAD_PRIORITY;
+
+    return exc != 0 && group_priority(prio) < cur;
+}
+
+/**
+ * @brief  处理所有可以抢占当前执行优先级的异常
+ */
+void sim_irq_check(void) {
+    for (;;) {
+        int prio;
+        int exc;
+
+        sim_irq_dirty = 0;
+        exc = highest_pending(&prio);
+        if (exc == 0 || group_priority(prio) >= exec_priority()) {
+            return;
+        }
+        take_exception(exc, prio);
+    }
+}
+
+/* CPU 指令接口（cmsis_host.h 调用） -----------------------------------------*/
+
+void sim_cpu_enable_irq(void) {
+    sim_advance(1);
+    s_primask = 0;
+    sim_irq_check();
+}
+
+void sim_cpu_disable_irq(void) {
+    sim_advance(1);
+    s_primask = 1;
+}
+
+uint32_t sim_cpu_get_primask(void) {
+    sim_advance(1);
+    return s_primask;
+}
+
+void sim_cpu_set_primask(uint32_t primask) {
+    sim_advance(1);
+    s_primask = primask & 1U;
+    if (s_primask == 0) {
+        sim_irq_check();
+    }
+}
+
+uint32_t sim_cpu_get_basepri(void) {
+    sim_advance(1);
+    return s_basepri;
+}
+
+void sim_cpu_set_basepri(uint32_t basepri) {
+    sim_advance(1);
+    s_basepri = basepri & 0xF0U;
+    sim_irq_check();
+}
+
+uint32_t sim_cpu_get_faultmask(void) {
+    sim_advance(1);
+    return s_faultmask;
+}
+
+void sim_cpu_set_faultmask(uint32_t faultmask) {
+    sim_advance(1);
+    s_faultmask = faultmask & 1U;
+    if (s_faultmask == 0) {
+        sim_irq_check();
+    }
+}
+
+uint32_t sim_cpu_get_ipsr(void) {
+    sim_advance(1);
+    return (s_depth > 0) ? (uint32_t)s_stack_exc[s_depth - 1] : 0U;
+}
+
+void sim_cpu_nop(void) {
+    sim_advance(1);
+}
+
+void sim_cpu_wfi(void) {
+    sim_advance(1);
+    sim_idle();
+}
+
+void sim_cpu_wfe(void) {
+    sim_advance(1);
+    if (s_event_flag) {
+        s_event_flag = 0;
+        return;
+    }
+    sim_idle();
+    s_event_flag = 0;
+}
+
+void sim_cpu_sev(void) {
+    sim_advance(1);
+    s_event_flag = 1;
+}
+
+void sim_cpu_bkpt(uint32_t value) {
+    sim_fatal("BKPT #%lu", (unsigned long)value);
+}
+
+/************************ END OF FILE *****************************************/
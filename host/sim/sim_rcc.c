@@ -0,0 +1,207 @@
+/**
+ * @file    sim_rcc.c
+ * @brief   RCC 与 FLASH 接口模型
+ * @date    2026-10-18
+ *
+ * @note    - 时钟源打开后立即就绪，SW 立即反映到 SWS。虚拟时钟固定按 72 MHz
+ *            计时，与实际配置的分频无关。FLASH_ACR.LATENCY 记入
+ *            sim_flash_wait，每个基本块入口按它计入 Flash 取指等待；
+ *          - Flash 编程 / 擦除：复位后 CR.LOCK 置位，KEYR 依次写入两个密钥
+ *            解锁；PER + STRT 把 AR 所在的 2KB 页填成 0xFF，MER + STRT 擦除
+ *            整个 Flash，SR.BSY 保持典型擦除时间后置 EOP；PG 置位时开始一次
+ *            半字编程的计时（数据本身由固件直接写入映射的 Flash 区，不检查
+ *            目标是否已擦除）。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_CR 0x00U
+#define OFF_CFGR 0x04U
+#define OFF_BDCR 0x20U
+#define OFF_CSR 0x24U
+
+#define FLASH_OFF_ACR 0x00U
+#define FLASH_OFF_KEYR 0x04U
+#define FLASH_OFF_SR 0x0CU
+#define FLASH_OFF_CR 0x10U
+
+#define FLASH_MEM_BASE 0x08000000UL
+#define FLASH_MEM_SIZE 0x00080000UL
+#define FLASH_PAGE 0x800UL
+
+/** 典型时间（CPU 周期） */
+#define FLASH_T_PROG (SIM_CPU_HZ / 1000000UL * 52UL) /* 半字编程 52 us */
+#define FLASH_T_PAGE (SIM_CPU_HZ / 1000UL * 20UL)    /* 页擦除 20 ms */
+#define FLASH_T_MASS (SIM_CPU_HZ / 1000UL * 40UL)    /* 整片擦除 40 ms */
+
+/** SR 中写 1 清除的位 */
+#define FLASH_SR_W1C (FLASH_SR_EOP | FLASH_SR_WRPRTERR | FLASH_SR_PGERR)
+
+/* Exported variables --------------------------------------------------------*/
+
+uint32_t sim_flash_wait = 0;
+
+/* Private variables ---------------------------------------------------------*/
+
+static sim_event_t s_flash_ev;
+static uint8_t s_flash_keys; /* 已按顺序写入的密钥个数 */
+
+/* Private functions ---------------------------------------------------------*/
+
+static void rcc_reset(void) {
+    memset((void *)RCC, 0, 0x400);
+    RCC->CR = 0x00000083U;
+    RCC->CSR = 0x0C000000U;
+}
+
+static void rcc_write(uint32_t off, uint32_t val, uint32_t old) {
+    (void)old;
+    switch (off) {
+    case OFF_CR: {
+        uint32_t cr = val & ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY);
+        if (val & RCC_CR_HSION) {
+            cr |= RCC_CR_HSIRDY;
+        }
+        if (val & RCC_CR_HSEON) {
+            cr |= RCC_CR_HSERDY;
+        }
+        if (val & RCC_CR_PLLON) {
+            cr |= RCC_CR_PLLRDY;
+        }
+        RCC->CR = cr;
+        break;
+    }
+    case OFF_CFGR:
+        RCC->CFGR = (val & ~RCC_CFGR_SWS) |
+                    ((val & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos);
+        break;
+    case OFF_BDCR:
+        RCC->BDCR = (val & RCC_BDCR_LSEON) ? (val | RCC_BDCR_LSERDY)
+                                           : (val & ~RCC_BDCR_LSERDY);
+        break;
+    case OFF_CSR:
+        RCC->CSR = (val & RCC_CSR_LSION) ? (val | RCC_CSR_LSIRDY)
+                                         : (val & ~RCC_CSR_LSIRDY);
+        break;
+    default:
+        break;
+    }
+}
+
+static const sim_periph_t s_rcc_model = {
+    .name = "RCC",
+    .base = RCC_BASE,
+    .size = 0x400,
+    .reset = rcc_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = rcc_write,
+};
+
+/**
+ * @brief  编程 / 擦除结束
+ */
+static void flash_done(sim_event_t *ev) {
+    (void)ev;
+    FLASH->SR = (FLASH->SR & ~FLASH_SR_BSY) | FLASH_SR_EOP;
+}
+
+/**
+ * @brief  开始一次编程 / 擦除，BSY 保持 cycles 个周期
+ */
+static void flash_busy(uint64_t cycles) {
+    FLASH->SR |= FLASH_SR_BSY;
+    sim_event_after(&s_flash_ev, cycles);
+}
+
+static void flash_control(uint32_t val, uint32_t old) {
+    if (old & FLASH_CR_LOCK) {
+        /* 锁定时只保留 LOCK，其余位写不进去 */
+        FLASH->CR = old;
+        return;
+    }
+    if (FLASH->SR & FLASH_SR_BSY) {
+        FLASH->CR = val & ~FLASH_CR_STRT;
+        return;
+    }
+    if ((val & FLASH_CR_PG) && !(old & FLASH_CR_PG)) {
+        flash_busy(FLASH_T_PROG);
+    }
+    if (val & FLASH_CR_STRT) {
+        if (val & FLASH_CR_MER) {
+            memset((void *)FLASH_MEM_BASE, 0xFF, FLASH_MEM_SIZE);
+            flash_busy(FLASH_T_MASS);
+        } else if (val & FLASH_CR_PER) {
+            uint32_t page = (FLASH->AR - FLASH_MEM_BASE) & ~(FLASH_PAGE - 1U);
+            if (page < FLASH_MEM_SIZE) {
+                memset((void *)(uintptr_t)(FLASH_MEM_BASE + page), 0xFF, FLASH_PAGE);
+            }
+            flash_busy(FLASH_T_PAGE);
+        }
+        FLASH->CR = val & ~FLASH_CR_STRT;
+    }
+}
+
+static void flash_reset(void) {
+    memset((void *)FLASH, 0, 0x400);
+    FLASH->ACR = 0x00000030U;
+    FLASH->CR = FLASH_CR_LOCK;
+    sim_flash_wait = 0;
+    s_flash_keys = 0;
+    sim_event_cancel(&s_flash_ev);
+}
+
+static void flash_write(uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case FLASH_OFF_ACR:
+        /* PRFTBS 跟随 PRFTBE */
+        FLASH->ACR = (val & ~FLASH_ACR_PRFTBS) |
+                     ((val & FLASH_ACR_PRFTBE) ? FLASH_ACR_PRFTBS : 0U);
+        sim_flash_wait = val & FLASH_ACR_LATENCY;
+        break;
+    case FLASH_OFF_KEYR:
+        /* KEY1 之后紧接 KEY2 才解锁 */
+        if (s_flash_keys == 0 && val == FLASH_KEY1) {
+            s_flash_keys = 1;
+        } else if (s_flash_keys == 1 && val == FLASH_KEY2) {
+            s_flash_keys = 0;
+            FLASH->CR &= ~FLASH_CR_LOCK;
+        } else {
+            s_flash_keys = 0;
+        }
+        break;
+    case FLASH_OFF_SR:
+        FLASH->SR = old & ~(val & FLASH_SR_W1C);
+        break;
+    case FLASH_OFF_CR:
+        flash_control(val, old);
+        break;
+    default:
+        break;
+    }
+}
+
+static const sim_periph_t s_flash_model = {
+    .name = "FLASH",
+    .base = FLASH_R_BASE,
+    .size = 0x400,
+    .reset = flash_reset,
+    .read = NULL,
+    .read_done = NULL,
+    .write = flash_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_rcc_init(void) {
+    sim_event_init(&s_flash_ev, flash_done, NULL);
+    sim_register(&s_rcc_model);
+    sim_register(&s_flash_model);
+}
+
+/************************ END OF FILE *****************************************/
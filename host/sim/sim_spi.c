@@ -0,0 +1,219 @@
+/**
+ * @file    sim_spi.c
+ * @brief   SPI1 主机模式模型
+ * @date    2026-10-18
+ *
+ * @note    - 一帧耗时 = 位数 × (2 << BR) 个 CPU 周期（APB2 = 72 MHz）；
+ *          - 移位寄存器空闲时写 DR 直接开始移位，TXE 保持为 1；
+ *            忙时进入发送缓冲区，TXE 清零；
+ *          - 一帧结束时与从设备交换数据，RXNE 未清除时置 OVR，
+ *            OVR 由“读 DR 再读 SR”清除；
+ *          - RXNE / TXE 同时驱动 DMA1 通道 2 / 3 请求和 SPI1 中断线。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_CR1 0x00U
+#define OFF_CR2 0x04U
+#define OFF_SR 0x08U
+#define OFF_DR 0x0CU
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t (*s_slave)(uint8_t byte) = NULL;
+static sim_event_t s_frame_ev;
+
+static uint16_t s_tx_buf;      /* 发送缓冲区 */
+static uint8_t s_tx_full;
+static uint16_t s_shift;       /* 正在移出的帧 */
+static uint8_t s_busy;
+static uint16_t s_rx_data;     /* 接收缓冲区 */
+static uint8_t s_ovr_dr_read;  /* OVR 清除序列：已读 DR */
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint8_t bit_reverse8(uint8_t v) {
+    v = (uint8_t)(((v & 0xF0U) >> 4) | ((v & 0x0FU) << 4));
+    v = (uint8_t)(((v & 0xCCU) >> 2) | ((v & 0x33U) << 2));
+    v = (uint8_t)(((v & 0xAAU) >> 1) | ((v & 0x55U) << 1));
+    return v;
+}
+
+/**
+ * @brief  与从设备交换一个字节（按线上的比特顺序）
+ */
+static uint8_t spi_exchange(uint8_t byte) {
+    int lsb = (SPI1->CR1 & SPI_CR1_LSBFIRST) != 0;
+    uint8_t out = lsb ? bit_reverse8(byte) : byte;
+    uint8_t in = (s_slave != NULL) ? s_slave(out) : 0xFFU;
+
+    return lsb ? bit_reverse8(in) : in;
+}
+
+/**
+ * @brief  根据 SR 更新 DMA 请求和中断线
+ */
+static void spi_update(void) {
+    uint32_t sr = SPI1->SR;
+    uint32_t cr2 = SPI1->CR2;
+    int irq;
+
+    sim_dma_request(SIM_DMA_CH(1, 2), SIM_DMA_SRC_SPI1_RX,
+                    (cr2 & SPI_CR2_RXDMAEN) && (sr & SPI_SR_RXNE));
+    sim_dma_request(SIM_DMA_CH(1, 3), SIM_DMA_SRC_SPI1_TX,
+                    (cr2 & SPI_CR2_TXDMAEN) && (sr & SPI_SR_TXE));
+
+    irq = ((cr2 & SPI_CR2_TXEIE) && (sr & SPI_SR_TXE)) ||
+          ((cr2 & SPI_CR2_RXNEIE) && (sr & SPI_SR_RXNE)) ||
+          ((cr2 & SPI_CR2_ERRIE) && (sr & SPI_SR_OVR));
+    sim_irq_level(SPI1_IRQn, irq);
+}
+
+static uint32_t spi_frame_cycles(void) {
+    uint32_t br = (SPI1->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos;
+    uint32_t bits = (SPI1->CR1 & SPI_CR1_DFF) ? 16U : 8U;
+
+    return bits * (2U << br);
+}
+
+static void spi_start_frame(uint16_t frame) {
+    s_shift = frame;
+    s_busy = 1;
+    SPI1->SR |= SPI_SR_BSY;
+    sim_event_after(&s_frame_ev, spi_frame_cycles());
+}
+
+/**
+ * @brief  发送缓冲区有数据且移位寄存器空闲时开始下一帧
+ */
+static void spi_load(void) {
+    if (!s_busy && s_tx_full && (SPI1->CR1 & SPI_CR1_SPE)) {
+        s_tx_full = 0;
+        SPI1->SR |= SPI_SR_TXE;
+        spi_start_frame(s_tx_buf);
+    }
+}
+
+static void spi_frame_done(sim_event_t *ev) {
+    uint16_t rx;
+
+    (void)ev;
+    if (SPI1->CR1 & SPI_CR1_DFF) {
+        int lsb = (SPI1->CR1 & SPI_CR1_LSBFIRST) != 0;
+        uint8_t first = lsb ? (uint8_t)s_shift : (uint8_t)(s_shift >> 8);
+        uint8_t second = lsb ? (uint8_t)(s_shift >> 8) : (uint8_t)s_shift;
+        uint8_t in1 = spi_exchange(first);
+        uint8_t in2 = spi_exchange(second);
+        rx = lsb ? (uint16_t)(in1 | (in2 << 8)) : (uint16_t)((in1 << 8) | in2);
+    } else {
+        rx = spi_exchange((uint8_t)s_shift);
+    }
+
+    if (SPI1->SR & SPI_SR_RXNE) {
+        SPI1->SR |= SPI_SR_OVR;
+    } else {
+        s_rx_data = rx;
+        SPI1->SR |= SPI_SR_RXNE;
+    }
+    s_busy = 0;
+    SPI1->SR &= ~SPI_SR_BSY;
+    spi_load();
+    spi_update();
+}
+
+static void spi_reset(void) {
+    memset((void *)SPI1, 0, 0x400);
+    SPI1->SR = SPI_SR_TXE;
+    SPI1->CRCPR = 0x0007U;
+    s_tx_full = 0;
+    s_busy = 0;
+    s_rx_data = 0;
+    s_ovr_dr_read = 0;
+    sim_event_cancel(&s_frame_ev);
+}
+
+static void spi_read(uint32_t off) {
+    if (off == OFF_DR) {
+        SPI1->DR = s_rx_data;
+    }
+}
+
+static void spi_read_done(uint32_t off) {
+    if (off == OFF_DR) {
+        s_ovr_dr_read = (SPI1->SR & SPI_SR_OVR) != 0;
+        SPI1->SR &= ~SPI_SR_RXNE;
+        spi_update();
+    } else if (off == OFF_SR && s_ovr_dr_read) {
+        s_ovr_dr_read = 0;
+        SPI1->SR &= ~SPI_SR_OVR;
+        spi_update();
+    }
+}
+
+static void spi_write(uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case OFF_CR1:
+        if (!(val & SPI_CR1_SPE) && (old & SPI_CR1_SPE)) {
+            /* 关闭 SPI 不中断当前帧，但丢弃缓冲区 */
+            s_tx_full = 0;
+            SPI1->SR |= SPI_SR_TXE;
+        }
+        spi_load();
+        spi_update();
+        break;
+    case OFF_CR2:
+        spi_update();
+        break;
+    case OFF_SR:
+        /* 只有 CRCERR 可写 0 清除 */
+        SPI1->SR = old & ~(~val & SPI_SR_CRCERR);
+        spi_update();
+        break;
+    case OFF_DR: {
+        uint16_t frame = (uint16_t)((SPI1->CR1 & SPI_CR1_DFF) ? (val & 0xFFFFU)
+                                                               : (val & 0xFFU));
+        if (!s_busy && !s_tx_full && (SPI1->CR1 & SPI_CR1_SPE)) {
+            spi_start_frame(frame);
+        } else {
+            s_tx_buf = frame;
+            s_tx_full = 1;
+            SPI1->SR &= ~SPI_SR_TXE;
+        }
+        spi_update();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static const sim_periph_t s_spi1_model = {
+    .name = "SPI1",
+    .base = SPI1_BASE,
+    .size = 0x400,
+    .reset = spi_reset,
+    .read = spi_read,
+    .read_done = spi_read_done,
+    .write = spi_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_spi_init(void) {
+    sim_event_init(&s_frame_ev, spi_frame_done, NULL);
+    sim_register(&s_spi1_model);
+}
+
+/**
+ * @brief  连接 SPI1 从设备，xfer 收到 MOSI 字节并返回 MISO 字节
+ */
+void sim_spi1_attach(uint8_t (*xfer)(uint8_t byte)) {
+    s_slave = xfer;
+}
+
+/************************ END OF FILE *****************************************/
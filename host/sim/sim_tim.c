@@ -0,0 +1,416 @@
+/**
+ * @file    sim_tim.c
+ * @brief   基本定时器 TIM6 / TIM7 与通用定时器 TIM2（PWM 输出）/ TIM3 模型
+ * @date    2026-10-18
+ *
+ * @note    - 计数时钟 72 MHz（APB1 分频后倍频），只建模向上计数；
+ *          - CNT 按需由虚拟时间推算，只在更新事件处安排一个仿真事件；
+ *          - PSC 总是在更新事件时生效，ARR 在 ARPE = 1 时同样缓冲；
+ *          - 预分频计数器只在更新事件时清零，CEN 启停和写 CNT 都保持它；
+ *          - 更新事件置 UIF（rc_w0），UIE 触发中断，UDE 向 DMA2 通道 3 / 4
+ *            发出一次请求；OPM 下更新后清除 CEN；
+ *          - TIM2 另外建模 4 个 PWM 输出比较通道：OCxPE = 1 时 CCRx 在更新
+ *            事件装入影子寄存器；每个周期结束时把 CCxE 使能通道的有效电平
+ *            计数（PWM 模式 1 为 min(CCR, ARR + 1)，模式 2 为其余部分）记入
+ *            日志，测试用 sim_tim2_pwm_log 取出；CCDS = 1 时 CCxDE 随更新
+ *            事件向对应 DMA1 通道发出请求。比较匹配时刻的 CCxIF、
+ *            CCDS = 0 的请求和输入捕获不建模；
+ *          - CR2.MMS = 010 时更新事件作为 TRGO 输出：TIM3_TRGO 送到 ADC 的
+ *            外部触发（sim_adc_trigger），TIM6 / TIM7 / TIM2_TRGO 送到 DAC
+ *            的触发（sim_dac_trigger）；TIM3 不建模比较通道。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_CR1 0x00U
+#define OFF_CR2 0x04U
+#define OFF_DIER 0x0CU
+#define OFF_SR 0x10U
+#define OFF_EGR 0x14U
+#define OFF_CNT 0x24U
+#define OFF_PSC 0x28U
+#define OFF_ARR 0x2CU
+#define OFF_CCR1 0x34U
+
+#define TIM_CHANNELS 4
+#define PWM_LOG_LEN 256U
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief  PWM 周期日志（环形，满时覆盖最旧的）
+ */
+typedef struct {
+    uint16_t duty[PWM_LOG_LEN];
+    uint32_t head;
+    uint32_t count;
+} pwm_log_t;
+
+typedef struct {
+    TIM_TypeDef *regs;
+    int irqn;
+    int dma_ch;
+    int channels;           /* 输出比较通道数（基本定时器为 0） */
+    int cc_dma[TIM_CHANNELS];
+    uint16_t ccr[TIM_CHANNELS]; /* 影子比较寄存器 */
+    pwm_log_t *log;
+    int trgo;               /* TRGO 对应的 ADC EXTSEL 编号，-1 为未连接 */
+    int dac_tsel;           /* TRGO 对应的 DAC TSEL 编号，-1 为未连接 */
+    sim_event_t ev;
+    uint32_t psc;           /* 生效的预分频 */
+    uint32_t arr;           /* 生效的自动重装值 */
+    sim_time_t start;       /* CNT = 0 的时刻 */
+    uint32_t phase;         /* 停止时预分频计数器的值 */
+    int running;
+} sim_tim_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static sim_tim_t s_tim[4];
+static pwm_log_t s_tim2_log[TIM_CHANNELS];
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint32_t tim_cnt(const sim_tim_t *t) {
+    if (!t->running) {
+        return t->regs->CNT & 0xFFFFU;
+    }
+    return (uint32_t)((sim_now() - t->start) / (t->psc + 1U)) & 0xFFFFU;
+}
+
+/**
+ * @brief  预分频计数器当前值（停止时保持）
+ */
+static uint32_t tim_phase(const sim_tim_t *t) {
+    if (!t->running) {
+        return t->phase;
+    }
+    return (uint32_t)((sim_now() - t->start) % (t->psc + 1U));
+}
+
+static void tim_schedule(sim_tim_t *t) {
+    if (!t->running || t->arr == 0U) {
+        sim_event_cancel(&t->ev);
+        return;
+    }
+    sim_event_at(&t->ev, t->start + (uint64_t)(t->psc + 1U) * (t->arr + 1U));
+}
+
+static volatile uint32_t *tim_ccr(sim_tim_t *t, int ch) {
+    return &t->regs->CCR1 + ch;
+}
+
+/**
+ * @brief  通道 ch 的 OCxM / OCxPE 字段（CCMR 中每通道 8 位）
+ */
+static uint32_t tim_ccmr(const sim_tim_t *t, int ch) {
+    uint32_t ccmr = (ch < 2) ? t->regs->CCMR1 : t->regs->CCMR2;
+    return (ccmr >> ((ch & 1) * 8)) & 0xFFU;
+}
+
+/**
+ * @brief  通道 ch 当前生效的比较值
+ */
+static uint32_t tim_compare(sim_tim_t *t, int ch) {
+    return (tim_ccmr(t, ch) & TIM_CCMR1_OC1PE) ? t->ccr[ch] : (*tim_ccr(t, ch) & 0xFFFFU);
+}
+
+/**
+ * @brief  一个周期结束：记录各使能通道的有效电平计数
+ */
+static void tim_log_period(sim_tim_t *t) {
+    uint32_t period = t->arr + 1U;
+
+    for (int ch = 0; ch < t->channels; ch++) {
+        uint32_t mode = (tim_ccmr(t, ch) & TIM_CCMR1_OC1M) >> TIM_CCMR1_OC1M_Pos;
+        uint32_t active, cmp;
+        pwm_log_t *log = &t->log[ch];
+
+        if (!(t->regs->CCER & (TIM_CCER_CC1E << (ch * 4))) || (mode != 6U && mode != 7U)) {
+            continue;
+        }
+        cmp = tim_compare(t, ch);
+        active = (cmp < period) ? cmp : period;
+        if (mode == 7U) {
+            active = period - active;
+        }
+        log->duty[log->head] = (uint16_t)active;
+        log->head = (log->head + 1U) % PWM_LOG_LEN;
+        if (log->count < PWM_LOG_LEN) {
+            log->count++;
+        }
+    }
+}
+
+static void tim_update_irq(sim_tim_t *t) {
+    sim_irq_level(t->irqn, (t->regs->DIER & TIM_DIER_UIE) && (t->regs->SR & TIM_SR_UIF));
+}
+
+/**
+ * @brief  更新事件：装载缓冲寄存器，计数器归零
+ * @param  flag: 是否置 UIF / 发出 DMA 请求
+ */
+static void tim_update(sim_tim_t *t, sim_time_t when, int flag) {
+    t->psc = t->regs->PSC & 0xFFFFU;
+    t->arr = t->regs->ARR & 0xFFFFU;
+    t->start = when;
+    t->phase = 0;
+    for (int ch = 0; ch < t->channels; ch++) {
+        t->ccr[ch] = (uint16_t)*tim_ccr(t, ch);
+    }
+    if (flag) {
+        t->regs->SR |= TIM_SR_UIF;
+        if (t->regs->DIER & TIM_DIER_UDE) {
+            sim_dma_pulse(t->dma_ch);
+        }
+        if ((t->regs->CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_1) {
+            if (t->trgo >= 0) {
+                sim_adc_trigger(t->trgo);
+            }
+            if (t->dac_tsel >= 0) {
+                sim_dac_trigger(t->dac_tsel, when);
+            }
+        }
+        if (t->regs->CR2 & TIM_CR2_CCDS) {
+            for (int ch = 0; ch < t->channels; ch++) {
+                if (t->regs->DIER & (TIM_DIER_CC1DE << ch)) {
+                    sim_dma_pulse(t->cc_dma[ch]);
+                }
+            }
+        }
+    }
+    tim_update_irq(t);
+}
+
+static void tim_overflow(sim_event_t *ev) {
+    sim_tim_t *t = ev->arg;
+
+    tim_log_period(t);
+    if (t->regs->CR1 & TIM_CR1_UDIS) {
+        /* 禁止更新：计数器照样回零，缓冲寄存器不装载 */
+        t->start = ev->when;
+    } else {
+        tim_update(t, ev->when, 1);
+    }
+    if (t->regs->CR1 & TIM_CR1_OPM) {
+        t->regs->CR1 &= ~TIM_CR1_CEN;
+        t->running = 0;
+        t->regs->CNT = 0;
+    }
+    tim_schedule(t);
+}
+
+static void tim_reset_one(sim_tim_t *t) {
+    memset(t->regs, 0, 0x400);
+    sim_event_cancel(&t->ev);
+    t->psc = 0;
+    t->arr = 0xFFFFU;
+    t->running = 0;
+    t->start = 0;
+    t->phase = 0;
+    memset(t->ccr, 0, sizeof(t->ccr));
+}
+
+static void tim_reset(void) {
+    tim_reset_one(&s_tim[0]);
+    tim_reset_one(&s_tim[1]);
+    s_tim[0].regs->ARR = 0xFFFFU;
+    s_tim[1].regs->ARR = 0xFFFFU;
+}
+
+static void tim_read(sim_tim_t *t, uint32_t off) {
+    if (off == OFF_CNT) {
+        t->regs->CNT = tim_cnt(t);
+    }
+}
+
+static void tim_write(sim_tim_t *t, uint32_t off, uint32_t val, uint32_t old) {
+    switch (off) {
+    case OFF_CR1:
+        if ((val & TIM_CR1_CEN) && !t->running) {
+            t->running = 1;
+            t->start = sim_now() - (uint64_t)(t->regs->CNT & 0xFFFFU) * (t->psc + 1U) -
+                       t->phase;
+        } else if (!(val & TIM_CR1_CEN) && t->running) {
+            t->regs->CNT = tim_cnt(t);
+            t->phase = tim_phase(t);
+            t->running = 0;
+        }
+        tim_schedule(t);
+        break;
+    case OFF_SR:
+        t->regs->SR = old & val & (TIM_SR_UIF | TIM_SR_CC1IF | TIM_SR_CC2IF |
+                                   TIM_SR_CC3IF | TIM_SR_CC4IF);
+        break;
+    case OFF_EGR:
+        if (val & TIM_EGR_UG) {
+            tim_update(t, sim_now(), !(t->regs->CR1 & TIM_CR1_URS));
+            t->regs->CNT = 0;
+            tim_schedule(t);
+        }
+        t->regs->EGR = 0;
+        break;
+    case OFF_CNT:
+        /* 写 CNT 不影响预分频计数器 */
+        t->start = sim_now() - (uint64_t)(val & 0xFFFFU) * (t->psc + 1U) - tim_phase(t);
+        tim_schedule(t);
+        break;
+    case OFF_ARR:
+        if (!(t->regs->CR1 & TIM_CR1_ARPE)) {
+            t->arr = val & 0xFFFFU;
+            tim_schedule(t);
+        }
+        break;
+    default:
+        break;
+    }
+    tim_update_irq(t);
+}
+
+static void tim2_reset(void) {
+    tim_reset_one(&s_tim[2]);
+    s_tim[2].regs->ARR = 0xFFFFU;
+    memset(s_tim2_log, 0, sizeof(s_tim2_log));
+}
+
+static void tim2_read(uint32_t off) {
+    tim_read(&s_tim[2], off);
+}
+
+static void tim2_write(uint32_t off, uint32_t val, uint32_t old) {
+    tim_write(&s_tim[2], off, val, old);
+}
+
+static void tim3_reset(void) {
+    tim_reset_one(&s_tim[3]);
+    s_tim[3].regs->ARR = 0xFFFFU;
+}
+
+static void tim3_read(uint32_t off) {
+    tim_read(&s_tim[3], off);
+}
+
+static void tim3_write(uint32_t off, uint32_t val, uint32_t old) {
+    tim_write(&s_tim[3], off, val, old);
+}
+
+static void tim6_read(uint32_t off) {
+    tim_read(&s_tim[0], off);
+}
+
+static void tim7_read(uint32_t off) {
+    tim_read(&s_tim[1], off);
+}
+
+static void tim6_write(uint32_t off, uint32_t val, uint32_t old) {
+    tim_write(&s_tim[0], off, val, old);
+}
+
+static void tim7_write(uint32_t off, uint32_t val, uint32_t old) {
+    tim_write(&s_tim[1], off, val, old);
+}
+
+static const sim_periph_t s_tim2_model = {
+    .name = "TIM2",
+    .base = TIM2_BASE,
+    .size = 0x400,
+    .reset = tim2_reset,
+    .read = tim2_read,
+    .read_done = NULL,
+    .write = tim2_write,
+};
+
+static const sim_periph_t s_tim3_model = {
+    .name = "TIM3",
+    .base = TIM3_BASE,
+    .size = 0x400,
+    .reset = tim3_reset,
+    .read = tim3_read,
+    .read_done = NULL,
+    .write = tim3_write,
+};
+
+static const sim_periph_t s_tim6_model = {
+    .name = "TIM6",
+    .base = TIM6_BASE,
+    .size = 0x400,
+    .reset = tim_reset,
+    .read = tim6_read,
+    .read_done = NULL,
+    .write = tim6_write,
+};
+
+static const sim_periph_t s_tim7_model = {
+    .name = "TIM7",
+    .base = TIM7_BASE,
+    .size = 0x400,
+    .reset = NULL,
+    .read = tim7_read,
+    .read_done = NULL,
+    .write = tim7_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_tim_init(void) {
+    s_tim[2].regs = TIM2;
+    s_tim[2].irqn = TIM2_IRQn;
+    s_tim[2].dma_ch = SIM_DMA_CH(1, 2);
+    s_tim[2].channels = TIM_CHANNELS;
+    s_tim[2].cc_dma[0] = SIM_DMA_CH(1, 5);
+    s_tim[2].cc_dma[1] = SIM_DMA_CH(1, 7);
+    s_tim[2].cc_dma[2] = SIM_DMA_CH(1, 1);
+    s_tim[2].cc_dma[3] = SIM_DMA_CH(1, 7);
+    s_tim[2].log = s_tim2_log;
+    s_tim[2].trgo = -1;
+    s_tim[2].dac_tsel = 4;
+    s_tim[3].regs = TIM3;
+    s_tim[3].irqn = TIM3_IRQn;
+    s_tim[3].dma_ch = SIM_DMA_CH(1, 3);
+    s_tim[3].trgo = 4; /* ADC12 EXTSEL = 100 */
+    s_tim[3].dac_tsel = -1;
+    s_tim[0].regs = TIM6;
+    s_tim[0].irqn = TIM6_IRQn;
+    s_tim[0].dma_ch = SIM_DMA_CH(2, 3);
+    s_tim[1].regs = TIM7;
+    s_tim[1].irqn = TIM7_IRQn;
+    s_tim[1].dma_ch = SIM_DMA_CH(2, 4);
+    s_tim[0].trgo = -1;
+    s_tim[1].trgo = -1;
+    s_tim[0].dac_tsel = 0; /* DAC TSEL = 000 */
+    s_tim[1].dac_tsel = 2; /* DAC TSEL = 010 */
+    sim_event_init(&s_tim[0].ev, tim_overflow, &s_tim[0]);
+    sim_event_init(&s_tim[1].ev, tim_overflow, &s_tim[1]);
+    sim_event_init(&s_tim[2].ev, tim_overflow, &s_tim[2]);
+    sim_event_init(&s_tim[3].ev, tim_overflow, &s_tim[3]);
+    sim_register(&s_tim2_model);
+    sim_register(&s_tim3_model);
+    sim_register(&s_tim6_model);
+    sim_register(&s_tim7_model);
+}
+
+/**
+ * @brief  取出 TIM2 通道 ch（1~4）记录的各周期有效电平计数，从最旧的开始
+ * @retval 取出的个数
+ */
+int sim_tim2_pwm_log(int ch, uint16_t *duty, int max) {
+    pwm_log_t *log;
+    int n = 0;
+
+    if (ch < 1 || ch > TIM_CHANNELS) {
+        return 0;
+    }
+    log = &s_tim2_log[ch - 1];
+    while (n < max && log->count > 0U) {
+        duty[n++] = log->duty[(log->head + PWM_LOG_LEN - log->count) % PWM_LOG_LEN];
+        log->count--;
+    }
+    return n;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,353 @@
+/**
+ * @file    sim_uploader.c
+ * @brief   串口升级上位机模型（接在 USART1 上，滑动窗口发送镜像并计时）
+ * @date    2026-10-18
+ *
+ * @note    - 按引导程序的帧格式独立实现（CRC 逐位计算，不用固件的代码）：
+ *            START 之后等 READY，然后连续发送 DATA，未确认的块最多
+ *            window 个（取与设备窗口的较小值）；window = 1 即停等协议；
+ *          - 累计 ACK 推进窗口；NAK 从设备期望的块起重发；超过
+ *            UP_RTO 没有进展则从最早未确认的块起全部重发（Go-Back-N）；
+ *          - 全部确认后发 END，收到 DONE 结束会话并断开，USART1 恢复回显；
+ *          - 可以让某一块第一次发送时载荷损坏一个字节（CRC 不变），
+ *            检验重传；
+ *          - 可以在收到 READY 后再发一次 START，模拟实际上位机
+ *            （tools/uploader）等待复位时重发的 START 与 READY 交错；
+ *          - 记录 START 发出到 READY、最后一个 ACK、DONE 的时间（CPU
+ *            周期），即端到端升级时间。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define UP_SYNC_HOST 0xA5U
+#define UP_SYNC_DEV 0x5AU
+#define UP_START 0x01U
+#define UP_DATA 0x02U
+#define UP_END 0x03U
+#define UP_READY 0x81U
+#define UP_ACK 0x82U
+#define UP_NAK 0x83U
+#define UP_DONE 0x84U
+
+#define UP_CHUNK 256U
+#define UP_MAX_WINDOW 8U
+#define UP_NONE 0xFFFFFFFFUL
+
+/** 超时（CPU 周期）：确认、START / END 重发；连续超时次数上限 */
+#define UP_RTO (SIM_CPU_HZ / 1000UL * 30UL)
+#define UP_START_TIMEOUT (SIM_CPU_HZ * 3UL)
+#define UP_END_TIMEOUT (SIM_CPU_HZ * 10UL)
+#define UP_RETRIES 5U
+
+/* Private types -------------------------------------------------------------*/
+
+typedef enum {
+    UP_IDLE = 0,
+    UP_WAIT_READY,
+    UP_STREAM,
+    UP_WAIT_DONE,
+    UP_FINISHED,
+} up_phase_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static sim_event_t s_timer;
+static up_phase_t s_phase = UP_IDLE;
+static const uint8_t *s_image;
+static uint32_t s_size;
+static uint32_t s_chunks;
+static uint32_t s_window;
+static uint32_t s_base;    /* 最早未确认的块 */
+static uint32_t s_next;    /* 下一个要发的块 */
+static uint32_t s_high;    /* 发出过的最大块号 + 1 */
+static uint32_t s_corrupt; /* 第一次发送时损坏的块 */
+static int s_repeat_start; /* 收到 READY 后再发一次 START */
+static uint32_t s_resent;
+static uint32_t s_timeouts;
+static int s_status;
+static sim_time_t s_t_start, s_t_ready, s_t_streamed, s_t_done;
+
+static uint8_t s_rx[6];
+static uint32_t s_rx_len;
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint16_t up_crc16(const uint8_t *p, size_t n) {
+    uint16_t crc = 0xFFFFU;
+
+    while (n--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief  CRC-32/MPEG-2，按小端 32 位字输入，末尾不足一字补 0（同 STM32 CRC 单元）
+ */
+static uint32_t up_crc32(const uint8_t *p, uint32_t n) {
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t off = 0; off < n; off += 4U) {
+        uint32_t word = 0;
+        for (uint32_t i = 0; i < 4U && off + i < n; i++) {
+            word |= (uint32_t)p[off + i] << (8U * i);
+        }
+        crc ^= word;
+        for (int b = 0; b < 32; b++) {
+            crc = (crc & 0x80000000UL) ? (crc << 1) ^ 0x04C11DB7UL : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void up_frame(uint8_t type, uint8_t seq, const uint8_t *payload, uint32_t len,
+                     int corrupt) {
+    uint8_t buf[UP_CHUNK + 7U];
+    uint16_t crc;
+
+    buf[0] = UP_SYNC_HOST;
+    buf[1] = type;
+    buf[2] = seq;
+    buf[3] = (uint8_t)len;
+    buf[4] = (uint8_t)(len >> 8);
+    if (len != 0U) {
+        memcpy(&buf[5], payload, len);
+    }
+    crc = up_crc16(&buf[1], 4U + len);
+    buf[5 + len] = (uint8_t)crc;
+    buf[6 + len] = (uint8_t)(crc >> 8);
+    if (corrupt && len != 0U) {
+        buf[5 + len / 2U] ^= 0x5AU;
+    }
+    sim_usart1_inject(buf, 7U + len);
+}
+
+static void up_send_start(void) {
+    uint8_t p[8];
+    uint32_t crc = up_crc32(s_image, s_size);
+
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(s_size >> (8 * i));
+        p[4 + i] = (uint8_t)(crc >> (8 * i));
+    }
+    up_frame(UP_START, 0, p, sizeof(p), 0);
+    sim_event_after(&s_timer, UP_START_TIMEOUT);
+}
+
+static void up_send_end(void) {
+    up_frame(UP_END, 0, NULL, 0, 0);
+    sim_event_after(&s_timer, UP_END_TIMEOUT);
+}
+
+/**
+ * @brief  窗口内还没发的块全部发出
+ */
+static void up_fill(void) {
+    while (s_next < s_chunks && s_next < s_base + s_window) {
+        uint32_t off = s_next * UP_CHUNK;
+        uint32_t len = (s_size - off < UP_CHUNK) ? s_size - off : UP_CHUNK;
+        int corrupt = (s_next == s_corrupt);
+
+        if (corrupt) {
+            s_corrupt = UP_NONE;
+        }
+        if (s_next < s_high) {
+            s_resent++;
+        } else {
+            s_high = s_next + 1U;
+        }
+        up_frame(UP_DATA, (uint8_t)s_next, s_image + off, len, corrupt);
+        s_next++;
+    }
+}
+
+static void up_finish(int status) {
+    s_status = status;
+    s_phase = UP_FINISHED;
+    s_t_done = sim_now();
+    sim_event_cancel(&s_timer);
+    sim_usart1_attach(NULL);
+}
+
+static void up_timeout(sim_event_t *ev) {
+    (void)ev;
+    if (++s_timeouts > UP_RETRIES) {
+        up_finish(-2);
+        return;
+    }
+    switch (s_phase) {
+    case UP_WAIT_READY:
+        up_send_start();
+        break;
+    case UP_STREAM:
+        s_next = s_base;
+        up_fill();
+        sim_event_after(&s_timer, UP_RTO);
+        break;
+    case UP_WAIT_DONE:
+        up_send_end();
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief  处理一个设备帧
+ */
+static void up_on_frame(uint8_t type, uint8_t seq, uint8_t status) {
+    uint32_t n;
+
+    switch (type) {
+    case UP_READY:
+        if (s_phase != UP_WAIT_READY) {
+            break;
+        }
+        if (status != 0U) {
+            up_finish(status);
+            break;
+        }
+        s_t_ready = sim_now();
+        if (seq != 0U && seq < s_window) {
+            s_window = seq;
+        }
+        s_timeouts = 0;
+        s_phase = UP_STREAM;
+        if (s_repeat_start) {
+            s_repeat_start = 0;
+            up_send_start();
+        }
+        up_fill();
+        sim_event_after(&s_timer, UP_RTO);
+        break;
+    case UP_ACK:
+        if (s_phase != UP_STREAM) {
+            break;
+        }
+        n = s_base + (uint8_t)(seq - (uint8_t)s_base);
+        if (n <= s_base || n > s_high) {
+            break;
+        }
+        s_base = n;
+        if (s_next < s_base) {
+            s_next = s_base;
+        }
+        s_timeouts = 0;
+        if (s_base == s_chunks) {
+            s_t_streamed = sim_now();
+            s_phase = UP_WAIT_DONE;
+            up_send_end();
+        } else {
+            up_fill();
+            sim_event_after(&s_timer, UP_RTO);
+        }
+        break;
+    case UP_NAK:
+        if (s_phase != UP_STREAM) {
+            break;
+        }
+        n = s_base + (uint8_t)(seq - (uint8_t)s_base);
+        if (n < s_next) {
+            s_next = n;
+            up_fill();
+            sim_event_after(&s_timer, UP_RTO);
+        }
+        break;
+    case UP_DONE:
+        if (s_phase != UP_IDLE && s_phase != UP_FINISHED) {
+            up_finish(status);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief  USART1 TX 上的一个字节
+ */
+static void up_rx(uint8_t byte) {
+    if (s_rx_len == 0U && byte != UP_SYNC_DEV) {
+        return;
+    }
+    s_rx[s_rx_len++] = byte;
+    if (s_rx_len < sizeof(s_rx)) {
+        return;
+    }
+    s_rx_len = 0;
+    if (up_crc16(&s_rx[1], 3U) == (uint16_t)(s_rx[4] | (s_rx[5] << 8))) {
+        up_on_frame(s_rx[1], s_rx[2], s_rx[3]);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief  开始一次升级：连接 USART1 并发出 START
+ * @param  window: 未确认块数上限（1 ~ 8），实际取与设备窗口的较小值
+ * @param  corrupt_chunk: 第一次发送时损坏的块号，0xFFFFFFFF 表示不损坏
+ */
+void sim_uploader_start(const uint8_t *image, uint32_t size, uint32_t window,
+                        uint32_t corrupt_chunk) {
+    sim_event_init(&s_timer, up_timeout, NULL);
+    s_image = image;
+    s_size = size;
+    s_chunks = (size + UP_CHUNK - 1U) / UP_CHUNK;
+    s_window = (window == 0U) ? 1U : (window > UP_MAX_WINDOW ? UP_MAX_WINDOW : window);
+    s_base = 0;
+    s_next = 0;
+    s_high = 0;
+    s_corrupt = corrupt_chunk;
+    s_resent = 0;
+    s_timeouts = 0;
+    s_status = -1;
+    s_rx_len = 0;
+    s_t_ready = s_t_streamed = s_t_done = 0;
+    s_phase = UP_WAIT_READY;
+    sim_usart1_attach(up_rx);
+    s_t_start = sim_now();
+    up_send_start();
+}
+
+/**
+ * @brief  下一次会话收到 READY 后再发一次相同的 START（只生效一次）
+ */
+void sim_uploader_repeat_start(void) {
+    s_repeat_start = 1;
+}
+
+/**
+ * @brief  升级结果
+ * @param  ready / streamed / done: START 发出到 READY、最后一个 ACK、DONE 的
+ *         CPU 周期数，可为 NULL
+ * @param  resent: 重发的块数，可为 NULL
+ * @retval -1 进行中，-2 多次超时放弃，否则为 DONE 的 status（0 成功）
+ */
+int sim_uploader_result(uint64_t *ready, uint64_t *streamed, uint64_t *done, uint32_t *resent) {
+    if (s_phase != UP_FINISHED) {
+        return -1;
+    }
+    if (ready != NULL) {
+        *ready = s_t_ready ? s_t_ready - s_t_start : 0;
+    }
+    if (streamed != NULL) {
+        *streamed = s_t_streamed ? s_t_streamed - s_t_start : 0;
+    }
+    if (done != NULL) {
+        *done = s_t_done - s_t_start;
+    }
+    if (resent != NULL) {
+        *resent = s_resent;
+    }
+    return s_status;
+}
+
+/************************ END OF FILE *****************************************/
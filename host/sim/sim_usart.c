@@ -0,0 +1,293 @@
+/**
+ * @file    sim_usart.c
+ * @brief   USART1 模型
+ * @date    2026-10-18
+ *
+ * @note    - 一位的时间 = BRR 个 PCLK2 周期（72 MHz），一帧按 10 位计算；
+ *          - 发送：DR 与移位寄存器双缓冲，移出的字节可回显到主机终端
+ *            （初始化时的 stdout），打开回环后同时送入接收端
+ *            （相当于 TX / RX 短接）；连接了外部设备（sim_usart1_attach）
+ *            时字节交给设备，不再回显；
+ *          - 接收：RXNE 未清除时新字节丢失并置 ORE；最后一个字节之后
+ *            线路空闲一帧置 IDLE（回环时下一个字节的起始位取消空闲），
+ *            IDLE / ORE 由“读 SR 再读 DR”清除；
+ *          - TXE / RXNE 驱动 DMA1 通道 4 / 5 请求和 USART1 中断线。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define OFF_SR 0x00U
+#define OFF_DR 0x04U
+#define OFF_CR1 0x0CU
+#define OFF_CR3 0x14U
+
+#define USART_RX_QUEUE 8192U
+
+/** 读 SR 再读 DR 清除的标志 */
+#define SR_SEQ_CLEAR (USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE | USART_SR_IDLE)
+/** 写 0 清除的标志 */
+#define SR_RC_W0 (USART_SR_RXNE | USART_SR_TC | USART_SR_LBD | USART_SR_CTS)
+
+/* Private variables ---------------------------------------------------------*/
+
+static sim_event_t s_tx_ev;
+static sim_event_t s_rx_ev;
+static sim_event_t s_idle_ev;
+
+static uint8_t s_tx_hold;
+static uint8_t s_tx_full;
+static uint8_t s_tx_shift;
+static uint8_t s_tx_busy;
+static uint8_t s_rx_dr;
+static uint8_t s_rx_since_idle;
+static uint8_t s_sr_read;
+
+static int s_loopback = 0;
+static int s_echo = 1;
+static FILE *s_console;
+static void (*s_peer)(uint8_t byte);
+
+static uint8_t s_rx_queue[USART_RX_QUEUE];
+static size_t s_rx_head = 0;
+static size_t s_rx_tail = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint64_t usart_frame_cycles(void) {
+    uint32_t brr = USART1->BRR & 0xFFFFU;
+
+    if (brr == 0) {
+        brr = 625U;
+    }
+    return 10ULL * brr;
+}
+
+static void usart_update(void) {
+    uint32_t sr = USART1->SR;
+    uint32_t cr1 = USART1->CR1;
+    uint32_t cr3 = USART1->CR3;
+    int irq;
+
+    irq = ((cr1 & USART_CR1_TXEIE) && (sr & USART_SR_TXE)) ||
+          ((cr1 & USART_CR1_TCIE) && (sr & USART_SR_TC)) ||
+          ((cr1 & USART_CR1_RXNEIE) && (sr & (USART_SR_RXNE | USART_SR_ORE))) ||
+          ((cr1 & USART_CR1_IDLEIE) && (sr & USART_SR_IDLE)) ||
+          ((cr1 & USART_CR1_PEIE) && (sr & USART_SR_PE));
+    sim_irq_level(USART1_IRQn, irq);
+
+    sim_dma_request(SIM_DMA_CH(1, 4), SIM_DMA_SRC_USART1_TX,
+                    (cr3 & USART_CR3_DMAT) && (sr & USART_SR_TXE));
+    sim_dma_request(SIM_DMA_CH(1, 5), SIM_DMA_SRC_USART1_RX,
+                    (cr3 & USART_CR3_DMAR) && (sr & USART_SR_RXNE));
+}
+
+/**
+ * @brief  接收端收到一个完整字节
+ */
+static void usart_rx_byte(uint8_t byte) {
+    uint32_t need = USART_CR1_UE | USART_CR1_RE;
+
+    if ((USART1->CR1 & need) != need) {
+        return;
+    }
+    if (USART1->SR & USART_SR_RXNE) {
+        USART1->SR |= USART_SR_ORE;
+    } else {
+        s_rx_dr = byte;
+        USART1->SR |= USART_SR_RXNE;
+    }
+    s_rx_since_idle = 1;
+    sim_event_after(&s_idle_ev, usart_frame_cycles());
+    usart_update();
+}
+
+static void usart_idle(sim_event_t *ev) {
+    (void)ev;
+    if (s_rx_since_idle) {
+        s_rx_since_idle = 0;
+        USART1->SR |= USART_SR_IDLE;
+        usart_update();
+    }
+}
+
+/**
+ * @brief  注入队列中的下一个字节到达
+ */
+static void usart_rx_next(sim_event_t *ev) {
+    (void)ev;
+    if (s_rx_head == s_rx_tail) {
+        return;
+    }
+    usart_rx_byte(s_rx_queue[s_rx_tail]);
+    s_rx_tail = (s_rx_tail + 1U) % USART_RX_QUEUE;
+    if (s_rx_head != s_rx_tail) {
+        sim_event_after(&s_rx_ev, usart_frame_cycles());
+    }
+}
+
+static void usart_tx_start(uint8_t byte) {
+    s_tx_shift = byte;
+    s_tx_busy = 1;
+    USART1->SR &= ~USART_SR_TC;
+    if (s_loopback) {
+        /* 起始位同时出现在 RX 上，线路不再空闲 */
+        sim_event_cancel(&s_idle_ev);
+    }
+    sim_event_after(&s_tx_ev, usart_frame_cycles());
+}
+
+static void usart_tx_done(sim_event_t *ev) {
+    (void)ev;
+    s_tx_busy = 0;
+    if (s_peer != NULL) {
+        s_peer(s_tx_shift);
+    } else if (s_echo) {
+        fputc(s_tx_shift, s_console);
+    }
+    if (s_loopback) {
+        usart_rx_byte(s_tx_shift);
+    }
+    if (s_tx_full) {
+        s_tx_full = 0;
+        USART1->SR |= USART_SR_TXE;
+        usart_tx_start(s_tx_hold);
+    } else {
+        USART1->SR |= USART_SR_TC;
+    }
+    usart_update();
+}
+
+static void usart_reset(void) {
+    memset((void *)USART1, 0, 0x400);
+    USART1->SR = USART_SR_TXE | USART_SR_TC;
+    s_tx_full = 0;
+    s_tx_busy = 0;
+    s_rx_since_idle = 0;
+    s_sr_read = 0;
+    sim_event_cancel(&s_tx_ev);
+    sim_event_cancel(&s_idle_ev);
+}
+
+static void usart_read(uint32_t off) {
+    if (off == OFF_DR) {
+        USART1->DR = s_rx_dr;
+    }
+}
+
+static void usart_read_done(uint32_t off) {
+    if (off == OFF_SR) {
+        s_sr_read = 1;
+        return;
+    }
+    if (off == OFF_DR) {
+        if (s_sr_read) {
+            USART1->SR &= ~SR_SEQ_CLEAR;
+        }
+        s_sr_read = 0;
+        USART1->SR &= ~USART_SR_RXNE;
+        usart_update();
+    }
+}
+
+static void usart_write(uint32_t off, uint32_t val, uint32_t old) {
+    s_sr_read = 0;
+    switch (off) {
+    case OFF_SR:
+        USART1->SR = old & ~(~val & SR_RC_W0);
+        break;
+    case OFF_DR: {
+        uint32_t need = USART_CR1_UE | USART_CR1_TE;
+        if ((USART1->CR1 & need) != need) {
+            break;
+        }
+        USART1->SR &= ~USART_SR_TC;
+        if (!s_tx_busy) {
+            usart_tx_start((uint8_t)val);
+        } else {
+            s_tx_hold = (uint8_t)val;
+            s_tx_full = 1;
+            USART1->SR &= ~USART_SR_TXE;
+        }
+        break;
+    }
+    case OFF_CR1:
+        if (!(val & USART_CR1_UE) && (old & USART_CR1_UE)) {
+            sim_event_cancel(&s_tx_ev);
+            s_tx_busy = 0;
+            s_tx_full = 0;
+            USART1->SR |= USART_SR_TXE | USART_SR_TC;
+        }
+        break;
+    default:
+        break;
+    }
+    usart_update();
+}
+
+static const sim_periph_t s_usart1_model = {
+    .name = "USART1",
+    .base = USART1_BASE,
+    .size = 0x400,
+    .reset = usart_reset,
+    .read = usart_read,
+    .read_done = usart_read_done,
+    .write = usart_write,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_usart_init(void) {
+    s_console = stdout;
+    sim_event_init(&s_tx_ev, usart_tx_done, NULL);
+    sim_event_init(&s_rx_ev, usart_rx_next, NULL);
+    sim_event_init(&s_idle_ev, usart_idle, NULL);
+    sim_register(&s_usart1_model);
+}
+
+/**
+ * @brief  TX 与 RX 短接
+ */
+void sim_usart1_loopback(int on) {
+    s_loopback = on;
+}
+
+/**
+ * @brief  外部设备按波特率连续发来一串字节
+ */
+void sim_usart1_inject(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        size_t next = (s_rx_head + 1U) % USART_RX_QUEUE;
+        if (next == s_rx_tail) {
+            sim_fatal("USART1 inject queue full");
+        }
+        s_rx_queue[s_rx_head] = data[i];
+        s_rx_head = next;
+    }
+    if (!s_rx_ev.armed && s_rx_head != s_rx_tail) {
+        sim_event_after(&s_rx_ev, usart_frame_cycles());
+    }
+}
+
+/**
+ * @brief  在 TX 上连接外部设备（NULL 断开，恢复回显）
+ * @param  rx: 设备每收到一个完整字节调用一次（事件上下文），可在其中
+ *             调用 sim_usart1_inject 应答
+ */
+void sim_usart1_attach(void (*rx)(uint8_t byte)) {
+    s_peer = rx;
+}
+
+/**
+ * @brief  发送的字节是否打印到主机终端
+ */
+void sim_usart1_echo(int on) {
+    s_echo = on;
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,177 @@
+/**
+ * @file    sim_vectors.c
+ * @brief   主机构建的中断向量表
+ * @date    2026-10-18
+ *
+ * @note    顺序与 startup_stm32f103xe.s 相同。固件没有实现的处理函数弱别名到
+ *          sim_default_handler，进入时报告异常号后退出，对应真实硬件上
+ *          Default_Handler 的死循环。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+static void sim_default_handler(void) {
+    sim_fatal("unhandled exception %lu", (unsigned long)__get_IPSR());
+}
+
+/* Weak handler declarations -------------------------------------------------*/
+
+#define SIM_WEAK_HANDLER(name) \
+    void name(void) __attribute__((weak, alias("sim_default_handler")))
+
+SIM_WEAK_HANDLER(NMI_Handler);
+SIM_WEAK_HANDLER(HardFault_Handler);
+SIM_WEAK_HANDLER(MemManage_Handler);
+SIM_WEAK_HANDLER(BusFault_Handler);
+SIM_WEAK_HANDLER(UsageFault_Handler);
+SIM_WEAK_HANDLER(SVC_Handler);
+SIM_WEAK_HANDLER(DebugMon_Handler);
+SIM_WEAK_HANDLER(PendSV_Handler);
+SIM_WEAK_HANDLER(SysTick_Handler);
+SIM_WEAK_HANDLER(WWDG_IRQHandler);
+SIM_WEAK_HANDLER(PVD_IRQHandler);
+SIM_WEAK_HANDLER(TAMPER_IRQHandler);
+SIM_WEAK_HANDLER(RTC_IRQHandler);
+SIM_WEAK_HANDLER(FLASH_IRQHandler);
+SIM_WEAK_HANDLER(RCC_IRQHandler);
+SIM_WEAK_HANDLER(EXTI0_IRQHandler);
+SIM_WEAK_HANDLER(EXTI1_IRQHandler);
+SIM_WEAK_HANDLER(EXTI2_IRQHandler);
+SIM_WEAK_HANDLER(EXTI3_IRQHandler);
+SIM_WEAK_HANDLER(EXTI4_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel1_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel2_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel3_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel4_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel5_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel6_IRQHandler);
+SIM_WEAK_HANDLER(DMA1_Channel7_IRQHandler);
+SIM_WEAK_HANDLER(ADC1_2_IRQHandler);
+SIM_WEAK_HANDLER(USB_HP_CAN1_TX_IRQHandler);
+SIM_WEAK_HANDLER(USB_LP_CAN1_RX0_IRQHandler);
+SIM_WEAK_HANDLER(CAN1_RX1_IRQHandler);
+SIM_WEAK_HANDLER(CAN1_SCE_IRQHandler);
+SIM_WEAK_HANDLER(EXTI9_5_IRQHandler);
+SIM_WEAK_HANDLER(TIM1_BRK_IRQHandler);
+SIM_WEAK_HANDLER(TIM1_UP_IRQHandler);
+SIM_WEAK_HANDLER(TIM1_TRG_COM_IRQHandler);
+SIM_WEAK_HANDLER(TIM1_CC_IRQHandler);
+SIM_WEAK_HANDLER(TIM2_IRQHandler);
+SIM_WEAK_HANDLER(TIM3_IRQHandler);
+SIM_WEAK_HANDLER(TIM4_IRQHandler);
+SIM_WEAK_HANDLER(I2C1_EV_IRQHandler);
+SIM_WEAK_HANDLER(I2C1_ER_IRQHandler);
+SIM_WEAK_HANDLER(I2C2_EV_IRQHandler);
+SIM_WEAK_HANDLER(I2C2_ER_IRQHandler);
+SIM_WEAK_HANDLER(SPI1_IRQHandler);
+SIM_WEAK_HANDLER(SPI2_IRQHandler);
+SIM_WEAK_HANDLER(USART1_IRQHandler);
+SIM_WEAK_HANDLER(USART2_IRQHandler);
+SIM_WEAK_HANDLER(USART3_IRQHandler);
+SIM_WEAK_HANDLER(EXTI15_10_IRQHandler);
+SIM_WEAK_HANDLER(RTC_Alarm_IRQHandler);
+SIM_WEAK_HANDLER(USBWakeUp_IRQHandler);
+SIM_WEAK_HANDLER(TIM8_BRK_IRQHandler);
+SIM_WEAK_HANDLER(TIM8_UP_IRQHandler);
+SIM_WEAK_HANDLER(TIM8_TRG_COM_IRQHandler);
+SIM_WEAK_HANDLER(TIM8_CC_IRQHandler);
+SIM_WEAK_HANDLER(ADC3_IRQHandler);
+SIM_WEAK_HANDLER(FSMC_IRQHandler);
+SIM_WEAK_HANDLER(SDIO_IRQHandler);
+SIM_WEAK_HANDLER(TIM5_IRQHandler);
+SIM_WEAK_HANDLER(SPI3_IRQHandler);
+SIM_WEAK_HANDLER(UART4_IRQHandler);
+SIM_WEAK_HANDLER(UART5_IRQHandler);
+SIM_WEAK_HANDLER(TIM6_IRQHandler);
+SIM_WEAK_HANDLER(TIM7_IRQHandler);
+SIM_WEAK_HANDLER(DMA2_Channel1_IRQHandler);
+SIM_WEAK_HANDLER(DMA2_Channel2_IRQHandler);
+SIM_WEAK_HANDLER(DMA2_Channel3_IRQHandler);
+SIM_WEAK_HANDLER(DMA2_Channel4_5_IRQHandler);
+
+/* Vector table --------------------------------------------------------------*/
+
+/** 以异常号为下标，0 / 1（SP 初值、复位）和保留项为 NULL */
+void (*const sim_vectors[16 + SIM_IRQ_COUNT])(void) = {
+    NULL,
+    NULL,
+    NMI_Handler,
+    HardFault_Handler,
+    MemManage_Handler,
+    BusFault_Handler,
+    UsageFault_Handler,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    SVC_Handler,
+    DebugMon_Handler,
+    NULL,
+    PendSV_Handler,
+    SysTick_Handler,
+    WWDG_IRQHandler,
+    PVD_IRQHandler,
+    TAMPER_IRQHandler,
+    RTC_IRQHandler,
+    FLASH_IRQHandler,
+    RCC_IRQHandler,
+    EXTI0_IRQHandler,
+    EXTI1_IRQHandler,
+    EXTI2_IRQHandler,
+    EXTI3_IRQHandler,
+    EXTI4_IRQHandler,
+    DMA1_Channel1_IRQHandler,
+    DMA1_Channel2_IRQHandler,
+    DMA1_Channel3_IRQHandler,
+    DMA1_Channel4_IRQHandler,
+    DMA1_Channel5_IRQHandler,
+    DMA1_Channel6_IRQHandler,
+    DMA1_Channel7_IRQHandler,
+    ADC1_2_IRQHandler,
+    USB_HP_CAN1_TX_IRQHandler,
+    USB_LP_CAN1_RX0_IRQHandler,
+    CAN1_RX1_IRQHandler,
+    CAN1_SCE_IRQHandler,
+    EXTI9_5_IRQHandler,
+    TIM1_BRK_IRQHandler,
+    TIM1_UP_IRQHandler,
+    TIM1_TRG_COM_IRQHandler,
+    TIM1_CC_IRQHandler,
+    TIM2_IRQHandler,
+    TIM3_IRQHandler,
+    TIM4_IRQHandler,
+    I2C1_EV_IRQHandler,
+    I2C1_ER_IRQHandler,
+    I2C2_EV_IRQHandler,
+    I2C2_ER_IRQHandler,
+    SPI1_IRQHandler,
+    SPI2_IRQHandler,
+    USART1_IRQHandler,
+    USART2_IRQHandler,
+    USART3_IRQHandler,
+    EXTI15_10_IRQHandler,
+    RTC_Alarm_IRQHandler,
+    USBWakeUp_IRQHandler,
+    TIM8_BRK_IRQHandler,
+    TIM8_UP_IRQHandler,
+    TIM8_TRG_COM_IRQHandler,
+    TIM8_CC_IRQHandler,
+    ADC3_IRQHandler,
+    FSMC_IRQHandler,
+    SDIO_IRQHandler,
+    TIM5_IRQHandler,
+    SPI3_IRQHandler,
+    UART4_IRQHandler,
+    UART5_IRQHandler,
+    TIM6_IRQHandler,
+    TIM7_IRQHandler,
+    DMA2_Channel1_IRQHandler,
+    DMA2_Channel2_IRQHandler,
+    DMA2_Channel3_IRQHandler,
+    DMA2_Channel4_5_IRQHandler,
+};
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,100 @@
+/**
+ * @file    sim_w24c02.c
+ * @brief   W24C02 I2C EEPROM 模型（I2C2，地址 0xA0 / 0xA1）
+ * @date    2026-10-18
+ *
+ * @note    - 256 字节，页大小 16 字节，页内写地址回绕；
+ *          - 数据在 STOP 时写入，之后 5 ms 写周期内不应答任何地址；
+ *          - 读地址指针自动递增，整个存储区回绕。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define W24_SIZE 256U
+#define W24_PAGE 16U
+#define W24_T_WR (SIM_CPU_HZ / 1000UL * 5UL) /* 5 ms */
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t s_mem[W24_SIZE];
+static uint8_t s_buf[W24_PAGE];
+static uint8_t s_buf_used[W24_PAGE];
+static uint8_t s_ptr;
+static uint8_t s_page;          /* 本次页写的页基址 */
+static int s_expect_word = 0;
+static int s_data_count = 0;
+static int s_busy = 0;
+static sim_event_t s_wr_ev;
+
+/* Private functions ---------------------------------------------------------*/
+
+static void w24_write_done(sim_event_t *ev) {
+    (void)ev;
+    s_busy = 0;
+}
+
+static int w24_start(int read) {
+    if (s_busy) {
+        return 0;
+    }
+    /* 重复起始：放弃还未提交的写数据 */
+    s_data_count = 0;
+    memset(s_buf_used, 0, sizeof(s_buf_used));
+    s_expect_word = !read;
+    return 1;
+}
+
+static int w24_write(uint8_t byte) {
+    if (s_expect_word) {
+        s_expect_word = 0;
+        s_ptr = byte;
+        s_page = byte & (uint8_t)~(W24_PAGE - 1U);
+        return 1;
+    }
+    s_buf[s_ptr & (W24_PAGE - 1U)] = byte;
+    s_buf_used[s_ptr & (W24_PAGE - 1U)] = 1;
+    s_ptr = (uint8_t)(s_page | ((s_ptr + 1U) & (W24_PAGE - 1U)));
+    s_data_count++;
+    return 1;
+}
+
+static uint8_t w24_read(void) {
+    return s_mem[s_ptr++];
+}
+
+static void w24_stop(void) {
+    if (s_data_count > 0) {
+        for (uint32_t i = 0; i < W24_PAGE; i++) {
+            if (s_buf_used[i]) {
+                s_mem[s_page + i] = s_buf[i];
+            }
+        }
+        s_data_count = 0;
+        s_busy = 1;
+        sim_event_after(&s_wr_ev, W24_T_WR);
+    }
+    s_expect_word = 0;
+}
+
+static const sim_i2c_slave_t s_w24c02 = {
+    .addr = 0x50,
+    .start = w24_start,
+    .write = w24_write,
+    .read = w24_read,
+    .stop = w24_stop,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_w24c02_init(void) {
+    memset(s_mem, 0xFF, sizeof(s_mem));
+    sim_event_init(&s_wr_ev, w24_write_done, NULL);
+    sim_i2c2_attach(&s_w24c02);
+}
+
+/************************ END OF FILE *****************************************/
@@ -0,0 +1,222 @@
+/**
+ * @file    sim_w25q32.c
+ * @brief   W25Q32 SPI Flash 模型（SPI1，片选 PC13）
+ * @date    2026-10-18
+ *
+ * @note    - 4MB 存储区初始为 0xFF，编程只能把 1 写成 0；
+ *          - 页编程数据在页内回绕，片选拉高时才写入存储区；
+ *          - 编程 / 擦除期间 SR1.BUSY 置位，持续时间取数据手册典型值；
+ *            忙时除读状态寄存器外的指令被忽略；
+ *          - 掉电后除 0xAB 外的指令都被忽略。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sim.h"
+
+#include <string.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define W25_SIZE (4UL * 1024UL * 1024UL)
+#define W25_PAGE 256U
+
+#define W25_SR1_BUSY 0x01U
+#define W25_SR1_WEL 0x02U
+
+/** 典型时间（CPU 周期） */
+#define W25_T_PP (SIM_CPU_HZ / 1000000UL * 700UL)     /* 0.7 ms */
+#define W25_T_SE (SIM_CPU_HZ / 1000UL * 45UL)         /* 45 ms */
+#define W25_T_BE32 (SIM_CPU_HZ / 1000UL * 120UL)      /* 120 ms */
+#define W25_T_BE64 (SIM_CPU_HZ / 1000UL * 150UL)      /* 150 ms */
+#define W25_T_CE (SIM_CPU_HZ * 10UL)                  /* 10 s */
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t s_mem[W25_SIZE];
+static uint8_t s_page[W25_PAGE];
+static uint8_t s_page_used[W25_PAGE];
+
+static const uint8_t s_uid[8] = {0xD2, 0x65, 0x38, 0x21, 0x47, 0x1B, 0x0C, 0x29};
+
+static int s_selected = 0;
+static uint8_t s_cmd;
+static uint32_t s_count;      /* 本次片选内收到的字节数（含指令） */
+static uint32_t s_addr;
+static uint8_t s_sr1 = 0;
+static int s_power_down = 0;
+static int s_program_any = 0;
+static sim_event_t s_busy_ev;
+
+/* Private functions ---------------------------------------------------------*/
+
+static void w25_busy_done(sim_event_t *ev) {
+    (void)ev;
+    s_sr1 &= (uint8_t)~(W25_SR1_BUSY | W25_SR1_WEL);
+}
+
+static void w25_start_busy(uint64_t cycles) {
+    s_sr1 |= W25_SR1_BUSY;
+    sim_event_after(&s_busy_ev, cycles);
+}
+
+/**
+ * @brief  片选拉高：执行编程 / 擦除类指令
+ */
+static void w25_finish(void) {
+    uint32_t size = 0;
+    uint64_t t = 0;
+
+    if (s_count == 0 || s_power_down || (s_sr1 & W25_SR1_BUSY)) {
+        return;
+    }
+    switch (s_cmd) {
+    case 0x06:
+        s_sr1 |= W25_SR1_WEL;
+        return;
+    case 0x04:
+        s_sr1 &= (uint8_t)~W25_SR1_WEL;
+        return;
+    case 0xB9:
+        s_power_down = 1;
+        return;
+    case 0x02:
+        if ((s_sr1 & W25_SR1_WEL) && s_count > 4 && s_program_any) {
+            uint32_t page = s_addr & ~(uint32_t)(W25_PAGE - 1U);
+            for (uint32_t i = 0; i < W25_PAGE; i++) {
+                if (s_page_used[i]) {
+                    s_mem[page + i] &= s_page[i];
+                }
+            }
+            w25_start_busy(W25_T_PP);
+        }
+        return;
+    case 0x20:
+        size = 4096U;
+        t = W25_T_SE;
+        break;
+    case 0x52:
+        size = 32768U;
+        t = W25_T_BE32;
+        break;
+    case 0xD8:
+        size = 65536U;
+        t = W25_T_BE64;
+        break;
+    case 0xC7:
+    case 0x60:
+        if ((s_sr1 & W25_SR1_WEL) && s_count == 1) {
+            memset(s_mem, 0xFF, sizeof(s_mem));
+            w25_start_busy(W25_T_CE);
+        }
+        return;
+    default:
+        return;
+    }
+    /* 扇区 / 块擦除需要正好 1 字节指令 + 3 字节地址 */
+    if ((s_sr1 & W25_SR1_WEL) && s_count == 4) {
+        memset(&s_mem[s_addr & ~(size - 1U)], 0xFF, size);
+        w25_start_busy(t);
+    }
+}
+
+static void w25_cs(int port, int pin, int level) {
+    (void)port;
+    (void)pin;
+    if (level) {
+        if (s_selected) {
+            w25_finish();
+        }
+        s_selected = 0;
+    } else {
+        s_selected = 1;
+        s_count = 0;
+        s_addr = 0;
+        s_program_any = 0;
+        memset(s_page_used, 0, sizeof(s_page_used));
+    }
+}
+
+/**
+ * @brief  一个字节的全双工交换
+ */
+static uint8_t w25_xfer(uint8_t in) {
+    uint32_t n;
+    uint8_t out = 0xFF;
+
+    if (!s_selected) {
+        return 0xFF;
+    }
+    n = s_count++;
+    if (n == 0) {
+        s_cmd = in;
+        if (s_cmd == 0xAB) {
+            s_power_down = 0;
+        }
+        return 0xFF;
+    }
+    if (s_power_down && s_cmd != 0xAB) {
+        return 0xFF;
+    }
+    if ((s_sr1 & W25_SR1_BUSY) && s_cmd != 0x05) {
+        return 0xFF;
+    }
+
+    switch (s_cmd) {
+    case 0x05:
+        out = s_sr1;
+        break;
+    case 0x9F: {
+        static const uint8_t id[3] = {0xEF, 0x40, 0x16};
+        out = (n <= 3) ? id[n - 1] : 0xFF;
+        break;
+    }
+    case 0x4B:
+        /* 4 个空字节后输出 64 位唯一 ID */
+        out = (n >= 5 && n <= 12) ? s_uid[n - 5] : 0xFF;
+        break;
+    case 0xAB:
+        /* 3 个空字节后输出器件 ID */
+        out = (n >= 4) ? 0x15 : 0xFF;
+        break;
+    case 0x03:
+        if (n <= 3) {
+            s_addr = (s_addr << 8) | in;
+        } else {
+            out = s_mem[s_addr & (W25_SIZE - 1U)];
+            s_addr = (s_addr + 1U) & (W25_SIZE - 1U);
+        }
+        break;
+    case 0x02:
+        if (n <= 3) {
+            s_addr = (s_addr << 8) | in;
+        } else {
+            uint32_t col = (s_addr + (n - 4U)) & (W25_PAGE - 1U);
+            s_page[col] = in;
+            s_page_used[col] = 1;
+            s_program_any = 1;
+            s_addr &= W25_SIZE - 1U;
+        }
+        break;
+    case 0x20:
+    case 0x52:
+    case 0xD8:
+        if (n <= 3) {
+            s_addr = ((s_addr << 8) | in) & (W25_SIZE - 1U);
+        }
+        break;
+    default:
+        break;
+    }
+    return out;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+void sim_w25q32_init(void) {
+    memset(s_mem, 0xFF, sizeof(s_mem));
+    sim_event_init(&s_busy_ev, w25_busy_done, NULL);
+    sim_gpio_watch(SIM_GPIOC, 13, w25_cs);
+    sim_spi1_attach(w25_xfer);
+}
+
+/************************ END OF FILE *****************************************/
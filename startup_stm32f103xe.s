@@ -96,6 +96,21 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint heap and stack (from _end up to the current SP) with the
+   RAM_PAINT_PATTERN of ram_monitor.h, for high-water-mark measurement */
+  ldr r2, =_end
+  mov r4, sp
+  ldr r3, =0xA5A5A5A5
+  b LoopPaintRam
+
+PaintRam:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintRam:
+  cmp r2, r4
+  bcc PaintRam
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
@@ -0,0 +1,597 @@
+/**
+ * @file    stm32_upload.c
+ * @brief   串口升级上位机（PC 端，POSIX 串口，对接 boot.c 引导程序）
+ * @date    2026-10-18
+ *
+ * @note    用法：stm32_upload [-b 波特率] [-w 窗口] [-t 秒] <串口> <镜像.bin>
+ *          - 镜像是用 STM32F103XX_APP.ld 链接的应用的裸二进制
+ *            （objcopy -O binary），发送前检查向量表在应用区内；
+ *          - 先运行本程序再复位板子：引导程序复位后只等 BOOT_WAIT_MS，
+ *            所以等待 READY 期间每 UP_START_PERIOD_MS 重发一次 START，
+ *            最多 -t 秒（含擦除暂存区的时间）；擦除期间和 READY 之后
+ *            重复的 START 设备不会重新擦除；
+ *          - 之后的流程与仿真模型 host/sim/sim_uploader.c 相同：未确认的块
+ *            最多 window 个（取与设备窗口的较小值），累计 ACK 推进窗口，
+ *            NAK 从设备期望的块起重发，超过 UP_RTO_MS 没有进展则从最早
+ *            未确认的块起全部重发（Go-Back-N）；全部确认后发 END，DONE
+ *            在安装完成后才回来；
+ *          - 帧格式和常量与 boot.c / boot.h 一致，这里单独定义，不依赖
+ *            固件头文件。
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Private macro definitions -------------------------------------------------*/
+
+#define UP_SYNC_HOST 0xA5U
+#define UP_SYNC_DEV 0x5AU
+#define UP_START 0x01U
+#define UP_DATA 0x02U
+#define UP_END 0x03U
+#define UP_READY 0x81U
+#define UP_ACK 0x82U
+#define UP_NAK 0x83U
+#define UP_DONE 0x84U
+
+#define UP_CHUNK 256U
+#define UP_MAX_WINDOW 8U
+
+/** boot.h：BOOT_BAUD、应用区、SRAM 范围（检查镜像的向量表） */
+#define UP_DEFAULT_BAUD 921600UL
+#define UP_APP_BASE 0x08008000UL
+#define UP_FLASH_END 0x08080000UL
+#define UP_APP_MAX_SIZE (UP_FLASH_END - UP_APP_BASE)
+#define UP_SRAM_BASE 0x20000000UL
+#define UP_SRAM_END (UP_SRAM_BASE + 0x10000UL)
+
+/** 超时（毫秒）：START 重发周期、确认、END 等 DONE；连续超时次数上限 */
+#define UP_START_PERIOD_MS 100U
+#define UP_DEFAULT_WAIT_S 30U
+#define UP_RTO_MS 200U
+#define UP_END_TIMEOUT_MS 10000U
+#define UP_RETRIES 5U
+
+/* Private variables ---------------------------------------------------------*/
+
+static int s_fd = -1;
+static uint8_t *s_image;
+static uint32_t s_size;
+static uint32_t s_chunks;
+static uint32_t s_window;
+static uint32_t s_base; /* 最早未确认的块 */
+static uint32_t s_next; /* 下一个要发的块 */
+static uint32_t s_high; /* 发出过的最大块号 + 1 */
+static uint32_t s_resent;
+
+static uint8_t s_in[256]; /* 串口读到、还没解析的字节 */
+static size_t s_in_len;
+static size_t s_in_pos;
+static uint8_t s_rx[6];
+static uint32_t s_rx_len;
+
+/** DONE / READY 的 status（boot.h BOOT_ST_xxx） */
+static const char *const s_status_name[] = {
+    "ok",
+    "image size is 0 or larger than the application area",
+    "W25Q32 or internal flash operation failed",
+    "CRC mismatch",
+    "END before all chunks were received",
+    "session timeout on the device",
+    "running program is not a bootloader linked below the application area",
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint16_t up_crc16(const uint8_t *p, size_t n) {
+    uint16_t crc = 0xFFFFU;
+
+    while (n--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief  CRC-32/MPEG-2，按小端 32 位字输入，末尾不足一字补 0（同 STM32 CRC 单元）
+ */
+static uint32_t up_crc32(const uint8_t *p, uint32_t n) {
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t off = 0; off < n; off += 4U) {
+        uint32_t word = 0;
+        for (uint32_t i = 0; i < 4U && off + i < n; i++) {
+            word |= (uint32_t)p[off + i] << (8U * i);
+        }
+        crc ^= word;
+        for (int b = 0; b < 32; b++) {
+            crc = (crc & 0x80000000UL) ? (crc << 1) ^ 0x04C11DB7UL : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint32_t up_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static uint64_t up_now_ms(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U;
+}
+
+static const char *up_status_name(uint8_t status) {
+    if (status < sizeof(s_status_name) / sizeof(s_status_name[0])) {
+        return s_status_name[status];
+    }
+    return "unknown status";
+}
+
+/**
+ * @brief  波特率 -> termios 常量，不支持时返回 0
+ */
+static speed_t up_speed(unsigned long baud) {
+    switch (baud) {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+#ifdef B460800
+    case 460800:
+        return B460800;
+#endif
+#ifdef B921600
+    case 921600:
+        return B921600;
+#endif
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief  打开串口：原始模式 8N1，无流控，读不阻塞（用 poll 等待）
+ */
+static int up_open(const char *port, unsigned long baud) {
+    struct termios tio;
+    speed_t speed = up_speed(baud);
+
+    if (speed == 0) {
+        fprintf(stderr, "unsupported baud rate %lu\n", baud);
+        return -1;
+    }
+    s_fd = open(port, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (s_fd < 0) {
+        fprintf(stderr, "%s: %s\n", port, strerror(errno));
+        return -1;
+    }
+    if (tcgetattr(s_fd, &tio) != 0) {
+        fprintf(stderr, "%s: %s\n", port, strerror(errno));
+        close(s_fd);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(tcflag_t)(CSTOPB | PARENB);
+#ifdef CRTSCTS
+    tio.c_cflag &= ~(tcflag_t)CRTSCTS;
+#endif
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(s_fd, TCSANOW, &tio) != 0) {
+        fprintf(stderr, "%s: %s\n", port, strerror(errno));
+        close(s_fd);
+        return -1;
+    }
+    tcflush(s_fd, TCIOFLUSH);
+    return 0;
+}
+
+/**
+ * @brief  写完 n 个字节（串口驱动缓冲区满时等待）
+ */
+static int up_write(const uint8_t *p, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(s_fd, p, n);
+
+        if (w < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                struct pollfd pfd = {.fd = s_fd, .events = POLLOUT};
+                poll(&pfd, 1, 100);
+                continue;
+            }
+            fprintf(stderr, "write: %s\n", strerror(errno));
+            return -1;
+        }
+        p += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+static int up_frame(uint8_t type, uint8_t seq, const uint8_t *payload, uint32_t len) {
+    uint8_t buf[UP_CHUNK + 7U];
+    uint16_t crc;
+
+    buf[0] = UP_SYNC_HOST;
+    buf[1] = type;
+    buf[2] = seq;
+    buf[3] = (uint8_t)len;
+    buf[4] = (uint8_t)(len >> 8);
+    if (len != 0U) {
+        memcpy(&buf[5], payload, len);
+    }
+    crc = up_crc16(&buf[1], 4U + len);
+    buf[5 + len] = (uint8_t)crc;
+    buf[6 + len] = (uint8_t)(crc >> 8);
+    return up_write(buf, 7U + len);
+}
+
+static int up_send_start(void) {
+    uint8_t p[8];
+    uint32_t crc = up_crc32(s_image, s_size);
+
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(s_size >> (8 * i));
+        p[4 + i] = (uint8_t)(crc >> (8 * i));
+    }
+    return up_frame(UP_START, 0, p, sizeof(p));
+}
+
+/**
+ * @brief  窗口内还没发的块全部发出
+ */
+static int up_fill(void) {
+    while (s_next < s_chunks && s_next < s_base + s_window) {
+        uint32_t off = s_next * UP_CHUNK;
+        uint32_t len = (s_size - off < UP_CHUNK) ? s_size - off : UP_CHUNK;
+
+        if (s_next < s_high) {
+            s_resent++;
+        } else {
+            s_high = s_next + 1U;
+        }
+        if (up_frame(UP_DATA, (uint8_t)s_next, s_image + off, len) != 0) {
+            return -1;
+        }
+        s_next++;
+    }
+    return 0;
+}
+
+/**
+ * @brief  等一个校验正确的设备帧
+ * @retval 1 收到，0 超时，-1 串口错误
+ * @note   一次 read 可能带来多帧，没解析的字节留在 s_in 里给下一次调用
+ */
+static int up_read_frame(uint32_t timeout_ms, uint8_t *type, uint8_t *seq, uint8_t *status) {
+    uint64_t deadline = up_now_ms() + timeout_ms;
+
+    for (;;) {
+        while (s_in_pos < s_in_len) {
+            uint8_t byte = s_in[s_in_pos++];
+
+            if (s_rx_len == 0U && byte != UP_SYNC_DEV) {
+                continue;
+            }
+            s_rx[s_rx_len++] = byte;
+            if (s_rx_len < sizeof(s_rx)) {
+                continue;
+            }
+            s_rx_len = 0;
+            if (up_crc16(&s_rx[1], 3U) == (uint16_t)(s_rx[4] | (s_rx[5] << 8))) {
+                *type = s_rx[1];
+                *seq = s_rx[2];
+                *status = s_rx[3];
+                return 1;
+            }
+        }
+
+        uint64_t now = up_now_ms();
+        struct pollfd pfd = {.fd = s_fd, .events = POLLIN};
+        ssize_t n;
+
+        if (now >= deadline) {
+            return 0;
+        }
+        if (poll(&pfd, 1, (int)(deadline - now)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "poll: %s\n", strerror(errno));
+            return -1;
+        }
+        n = read(s_fd, s_in, sizeof(s_in));
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "read: %s\n", strerror(errno));
+            return -1;
+        }
+        s_in_len = (size_t)n;
+        s_in_pos = 0;
+    }
+}
+
+/**
+ * @brief  读入镜像并检查向量表（栈顶在 SRAM 内，复位向量在应用区内）
+ */
+static int up_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    long len;
+    uint32_t sp, pc;
+
+    if (f == NULL) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    if (fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) < 0 || fseek(f, 0, SEEK_SET) != 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        fclose(f);
+        return -1;
+    }
+    if (len < 8 || (unsigned long)len > UP_APP_MAX_SIZE) {
+        fprintf(stderr, "%s: size %ld, expected 8 .. %lu bytes\n", path, len,
+                (unsigned long)UP_APP_MAX_SIZE);
+        fclose(f);
+        return -1;
+    }
+    s_size = (uint32_t)len;
+    s_image = malloc(s_size);
+    if (s_image == NULL || fread(s_image, 1, s_size, f) != s_size) {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+
+    sp = up_le32(s_image);
+    pc = up_le32(s_image + 4);
+    if (sp <= UP_SRAM_BASE || sp > UP_SRAM_END || (sp & 3U) != 0U || (pc & 1U) == 0U ||
+        pc <= UP_APP_BASE || pc >= UP_FLASH_END) {
+        fprintf(stderr,
+                "%s: vector table SP 0x%08lX, reset 0x%08lX is not an application "
+                "linked at 0x%08lX (STM32F103XX_APP.ld)\n",
+                path, (unsigned long)sp, (unsigned long)pc, (unsigned long)UP_APP_BASE);
+        return -1;
+    }
+    s_chunks = (s_size + UP_CHUNK - 1U) / UP_CHUNK;
+    return 0;
+}
+
+/**
+ * @brief  反复发 START，直到 READY
+ * @retval 0 成功，-1 失败
+ */
+static int up_connect(uint32_t wait_s) {
+    uint64_t deadline = up_now_ms() + (uint64_t)wait_s * 1000U;
+    uint8_t type, seq, status;
+
+    fprintf(stderr, "waiting for the bootloader on reset (%u s) ...\n", (unsigned)wait_s);
+    while (up_now_ms() < deadline) {
+        int r;
+
+        if (up_send_start() != 0) {
+            return -1;
+        }
+        r = up_read_frame(UP_START_PERIOD_MS, &type, &seq, &status);
+        if (r < 0) {
+            return -1;
+        }
+        if (r == 0 || type != UP_READY) {
+            continue;
+        }
+        if (status != 0U) {
+            fprintf(stderr, "device refused the image: %s\n", up_status_name(status));
+            return -1;
+        }
+        if (seq != 0U && seq < s_window) {
+            s_window = seq;
+        }
+        return 0;
+    }
+    fprintf(stderr, "no READY from the device\n");
+    return -1;
+}
+
+/**
+ * @brief  发送全部块直到都被确认
+ * @retval 0 成功，-1 失败
+ */
+static int up_stream(void) {
+    uint32_t timeouts = 0;
+    uint8_t type, seq, status;
+
+    s_base = 0;
+    s_next = 0;
+    s_high = 0;
+    s_resent = 0;
+    while (s_base < s_chunks) {
+        uint32_t n;
+        int r;
+
+        if (up_fill() != 0) {
+            return -1;
+        }
+        r = up_read_frame(UP_RTO_MS, &type, &seq, &status);
+        if (r < 0) {
+            return -1;
+        }
+        if (r == 0) {
+            if (++timeouts > UP_RETRIES) {
+                fprintf(stderr, "\nno acknowledgement, giving up at chunk %lu\n",
+                        (unsigned long)s_base);
+                return -1;
+            }
+            s_next = s_base;
+            continue;
+        }
+        switch (type) {
+        case UP_ACK:
+            n = s_base + (uint8_t)(seq - (uint8_t)s_base);
+            if (n <= s_base || n > s_high) {
+                break;
+            }
+            s_base = n;
+            if (s_next < s_base) {
+                s_next = s_base;
+            }
+            timeouts = 0;
+            fprintf(stderr, "\r  %lu / %lu chunks", (unsigned long)s_base,
+                    (unsigned long)s_chunks);
+            break;
+        case UP_NAK:
+            n = s_base + (uint8_t)(seq - (uint8_t)s_base);
+            if (n < s_next) {
+                s_next = n;
+            }
+            break;
+        case UP_DONE:
+            fprintf(stderr, "\ndevice ended the session: %s\n", up_status_name(status));
+            return -1;
+        default:
+            /* 重复的 READY */
+            break;
+        }
+    }
+    fprintf(stderr, "\n");
+    return 0;
+}
+
+/**
+ * @brief  END，等安装完成后的 DONE
+ * @retval DONE 的 status，-1 失败
+ */
+static int up_finish(void) {
+    uint8_t type, seq, status;
+
+    for (uint32_t i = 0; i <= UP_RETRIES; i++) {
+        uint64_t deadline;
+
+        if (up_frame(UP_END, 0, NULL, 0) != 0) {
+            return -1;
+        }
+        deadline = up_now_ms() + UP_END_TIMEOUT_MS;
+        while (up_now_ms() < deadline) {
+            int r = up_read_frame((uint32_t)(deadline - up_now_ms()), &type, &seq, &status);
+
+            if (r < 0) {
+                return -1;
+            }
+            if (r > 0 && type == UP_DONE) {
+                return status;
+            }
+        }
+    }
+    fprintf(stderr, "no DONE from the device\n");
+    return -1;
+}
+
+static void up_usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [-b baud] [-w window] [-t seconds] <serial port> <image.bin>\n"
+            "  -b  baud rate (default %lu, BOOT_BAUD)\n"
+            "  -w  unacknowledged chunks in flight, 1 .. %u (default %u)\n"
+            "  -t  how long to wait for the bootloader after reset (default %u s)\n"
+            "Start the uploader first, then reset the board.\n",
+            argv0, (unsigned long)UP_DEFAULT_BAUD, UP_MAX_WINDOW, UP_MAX_WINDOW,
+            UP_DEFAULT_WAIT_S);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+    unsigned long baud = UP_DEFAULT_BAUD;
+    uint32_t wait_s = UP_DEFAULT_WAIT_S;
+    uint64_t t_start, t_ready, t_streamed, t_done;
+    int opt, status;
+
+    s_window = UP_MAX_WINDOW;
+    while ((opt = getopt(argc, argv, "b:w:t:h")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            s_window = (uint32_t)strtoul(optarg, NULL, 0);
+            if (s_window == 0U || s_window > UP_MAX_WINDOW) {
+                up_usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 't':
+            wait_s = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            up_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (argc - optind != 2) {
+        up_usage(argv[0]);
+        return 2;
+    }
+    if (up_load(argv[optind + 1]) != 0 || up_open(argv[optind], baud) != 0) {
+        return 1;
+    }
+
+    t_start = up_now_ms();
+    if (up_connect(wait_s) != 0) {
+        return 1;
+    }
+    t_ready = up_now_ms();
+    fprintf(stderr, "READY after %lu ms, window %lu, %lu bytes in %lu chunks\n",
+            (unsigned long)(t_ready - t_start), (unsigned long)s_window,
+            (unsigned long)s_size, (unsigned long)s_chunks);
+
+    if (up_stream() != 0) {
+        return 1;
+    }
+    t_streamed = up_now_ms();
+    status = up_finish();
+    t_done = up_now_ms();
+    close(s_fd);
+    if (status != 0) {
+        if (status > 0) {
+            fprintf(stderr, "upgrade failed: %s\n", up_status_name((uint8_t)status));
+        }
+        return 1;
+    }
+
+    printf("upgrade done: %lu bytes, transfer %lu ms (%lu KB/s, %lu chunks resent), "
+           "install %lu ms\n",
+           (unsigned long)s_size, (unsigned long)(t_streamed - t_ready),
+           (unsigned long)(t_streamed > t_ready ? s_size / (t_streamed - t_ready) : 0),
+           (unsigned long)s_resent, (unsigned long)(t_done - t_streamed));
+    return 0;
+}
+
+/************************ END OF FILE *****************************************/